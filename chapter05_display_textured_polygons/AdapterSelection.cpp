@@ -0,0 +1,121 @@
+#include "AdapterSelection.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	constexpr uint32_t kCacheMagic = 0x43504441; // "ADPC"
+	constexpr uint32_t kCacheVersion = 1;
+
+	template <typename T>
+	void WriteValue(std::ofstream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	template <typename T>
+	bool ReadValue(std::ifstream& stream, T& value)
+	{
+		return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+	}
+}
+
+uint64_t ScoreAdapter(const AdapterCapabilities& capabilities)
+{
+	// 20bit̓rfI(MB)BʂقǗDx
+	const uint64_t videoMemoryMegabytes =
+		(std::min)(capabilities.dedicatedVideoMemory >> 20, static_cast<uint64_t>((1 << 20) - 1));
+	uint64_t score = capabilities.featureLevel & 0xffff;
+	score = (score << 8) | (capabilities.shaderModel & 0xff);
+	score = (score << 4) | (capabilities.resourceBindingTier & 0xf);
+	score = (score << 20) | videoMemoryMegabytes;
+	return score;
+}
+
+int SelectBestAdapter(const std::vector<AdapterCapabilities>& candidates, const AdapterPolicy& policy)
+{
+	int bestIndex = -1;
+	uint64_t bestScore = 0;
+	for (size_t i = 0; i < candidates.size(); ++i) {
+		const AdapterCapabilities& candidate = candidates[i];
+		if (candidate.isSoftware && !policy.allowSoftware) {
+			continue;
+		}
+		if (!policy.requiredDescription.empty() &&
+			candidate.description.find(policy.requiredDescription) == std::wstring::npos) {
+			continue;
+		}
+		const uint64_t score = ScoreAdapter(candidate);
+		if (bestIndex < 0 || score > bestScore) {
+			bestIndex = static_cast<int>(i);
+			bestScore = score;
+		}
+	}
+	return bestIndex;
+}
+
+bool SaveAdapterCache(const char* path, const AdapterCapabilities& capabilities)
+{
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	if (!stream) {
+		return false;
+	}
+	WriteValue(stream, kCacheMagic);
+	WriteValue(stream, kCacheVersion);
+	WriteValue(stream, capabilities.luid);
+	WriteValue(stream, capabilities.vendorId);
+	WriteValue(stream, capabilities.deviceId);
+	WriteValue(stream, capabilities.dedicatedVideoMemory);
+	WriteValue(stream, capabilities.featureLevel);
+	WriteValue(stream, capabilities.resourceBindingTier);
+	WriteValue(stream, capabilities.shaderModel);
+	WriteValue(stream, static_cast<uint8_t>(capabilities.isSoftware));
+	WriteValue(stream, static_cast<uint32_t>(capabilities.description.size()));
+	stream.write(
+		reinterpret_cast<const char*>(capabilities.description.data()),
+		capabilities.description.size() * sizeof(wchar_t)
+	);
+	return static_cast<bool>(stream);
+}
+
+bool LoadAdapterCache(const char* path, AdapterCapabilities& capabilities)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream) {
+		return false;
+	}
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	if (!ReadValue(stream, magic) || magic != kCacheMagic ||
+		!ReadValue(stream, version) || version != kCacheVersion) {
+		return false;
+	}
+
+	AdapterCapabilities loaded;
+	uint8_t isSoftware = 0;
+	uint32_t descriptionLength = 0;
+	if (!ReadValue(stream, loaded.luid) ||
+		!ReadValue(stream, loaded.vendorId) ||
+		!ReadValue(stream, loaded.deviceId) ||
+		!ReadValue(stream, loaded.dedicatedVideoMemory) ||
+		!ReadValue(stream, loaded.featureLevel) ||
+		!ReadValue(stream, loaded.resourceBindingTier) ||
+		!ReadValue(stream, loaded.shaderModel) ||
+		!ReadValue(stream, isSoftware) ||
+		!ReadValue(stream, descriptionLength) ||
+		descriptionLength > 1024) {
+		return false;
+	}
+	loaded.isSoftware = isSoftware != 0;
+	loaded.description.resize(descriptionLength);
+	if (!stream.read(reinterpret_cast<char*>(&loaded.description[0]), descriptionLength * sizeof(wchar_t))) {
+		return false;
+	}
+
+	capabilities = loaded;
+	return true;
+}
+}
+}
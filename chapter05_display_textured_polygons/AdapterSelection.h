@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+// A_v^[Ƃɒׂ\Bl D3D_FEATURE_LEVEL Ȃǂ̒萔̂܂ܓ
+struct AdapterCapabilities
+{
+	uint64_t luid = 0;
+	uint32_t vendorId = 0;
+	uint32_t deviceId = 0;
+	uint64_t dedicatedVideoMemory = 0;
+	uint32_t featureLevel = 0;
+	uint32_t resourceBindingTier = 0;
+	uint32_t shaderModel = 0;
+	bool isSoftware = false;
+	std::wstring description;
+};
+
+// A_v^[Ȉ㏑ݒ
+struct AdapterPolicy
+{
+	// łȂΐɂ̕܂ރA_v^[ɂ
+	std::wstring requiredDescription;
+	// WARP Ȃǂ̃\tgEFAA_v^[ɂ邩
+	bool allowSoftware = false;
+};
+
+// @\x > VF[_[f > \[XoCfBOeBA > prfI ̗D揇Ŕrłl
+uint64_t ScoreAdapter(const AdapterCapabilities& capabilities);
+// 𖞂ōłXRA̍A_v^[̓YBȂ -1
+int SelectBestAdapter(const std::vector<AdapterCapabilities>& candidates, const AdapterPolicy& policy);
+
+// I񂾃A_v^[ƒׂ\ۑāA̋NŒגɍςނ悤ɂ
+bool SaveAdapterCache(const char* path, const AdapterCapabilities& capabilities);
+bool LoadAdapterCache(const char* path, AdapterCapabilities& capabilities);
+}
+}
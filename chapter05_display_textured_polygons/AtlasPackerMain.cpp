@@ -0,0 +1,168 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "TextureAtlas.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// D3D12  2D eNX`̍ő̕ƍ(D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+	constexpr uint32_t kMaxAtlasSize = 16384;
+	constexpr uint32_t kMinAtlasSize = 64;
+	constexpr uint32_t kDefaultPadding = 4;
+
+	struct Options
+	{
+		std::string inputPath;
+		std::string outputPath;
+		// 0 Ȃ肫ԏ2ׂ̂ɂ
+		uint32_t atlasSize = 0;
+		uint32_t padding = kDefaultPadding;
+	};
+
+	// l߂摜1(͂1s)
+	struct AtlasEntry
+	{
+		std::string name;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	void PrintUsage()
+	{
+		printf(
+			"usage: atlas_packer [--size <pixels>] [--padding <pixels>] <input> <output>\n"
+			"  <input>    one image per line: <name> <width> <height> (lines starting with # are skipped)\n"
+			"  <output>   one region per line: <name> <x> <y> <width> <height> <u0> <v0> <u1> <v1>\n"
+			"  --size     width and height of the atlas (default: the smallest power of two that fits)\n"
+			"  --padding  gutter around each image (default: %u)\n",
+			kDefaultPadding
+		);
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		std::vector<std::string> paths;
+		for (int i = 1; i < argc; ++i) {
+			const char* name = argv[i];
+			if (strcmp(name, "--help") == 0) {
+				return false;
+			}
+			if (strcmp(name, "--size") == 0 || strcmp(name, "--padding") == 0) {
+				if (i + 1 >= argc) {
+					return false;
+				}
+				const uint32_t value = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+				(strcmp(name, "--size") == 0 ? options.atlasSize : options.padding) = value;
+				continue;
+			}
+			paths.push_back(name);
+		}
+		if (paths.size() != 2 || options.atlasSize > kMaxAtlasSize) {
+			return false;
+		}
+		options.inputPath = paths[0];
+		options.outputPath = paths[1];
+		return true;
+	}
+
+	bool ReadEntries(const std::string& path, std::vector<AtlasEntry>& entries)
+	{
+		std::ifstream input(path);
+		if (!input) {
+			printf("Failed to read %s\n", path.c_str());
+			return false;
+		}
+		std::string line;
+		for (int lineNumber = 1; std::getline(input, line); ++lineNumber) {
+			if (line.empty() || line[0] == '#') {
+				continue;
+			}
+			std::istringstream fields(line);
+			AtlasEntry entry;
+			if (!(fields >> entry.name >> entry.width >> entry.height) || entry.width == 0 || entry.height == 0) {
+				printf("%s(%d) : expected <name> <width> <height>\n", path.c_str(), lineNumber);
+				return false;
+			}
+			entries.push_back(entry);
+		}
+		return true;
+	}
+
+	// 傫܂ĂȂ΁A2ׂ̂ōLȂ肫܂Ŏ
+	bool Pack(
+		const Options& options,
+		const std::vector<std::pair<uint32_t, uint32_t>>& sizes,
+		uint32_t& atlasSize,
+		std::vector<AtlasRegion>& regions,
+		float& occupancy
+	) {
+		atlasSize = options.atlasSize != 0 ? options.atlasSize : kMinAtlasSize;
+		while (true) {
+			TextureAtlas atlas(atlasSize, atlasSize, options.padding);
+			if (atlas.InsertBatch(sizes, regions)) {
+				occupancy = atlas.Occupancy();
+				return true;
+			}
+			if (options.atlasSize != 0 || atlasSize >= kMaxAtlasSize) {
+				return false;
+			}
+			atlasSize *= 2;
+		}
+	}
+
+	bool WriteRegions(const std::string& path, uint32_t atlasSize, const std::vector<AtlasEntry>& entries, const std::vector<AtlasRegion>& regions)
+	{
+		std::ofstream output(path);
+		output << "# atlas " << atlasSize << " " << atlasSize << "\n";
+		for (size_t i = 0; i < entries.size(); ++i) {
+			const AtlasRegion& region = regions[i];
+			output << entries[i].name << " " << region.x << " " << region.y << " " << region.width << " " << region.height
+				<< " " << region.u0 << " " << region.v0 << " " << region.u1 << " " << region.v1 << "\n";
+		}
+		if (!output) {
+			printf("Failed to write %s\n", path.c_str());
+			return false;
+		}
+		return true;
+	}
+}
+
+// 摜̑傫̈ꗗAgX̔zurhɌ߂ĂB
+// s TextureAtlas::InsertBatch ŋl߂̂ƓzuɂȂ
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return -1;
+	}
+
+	std::vector<AtlasEntry> entries;
+	if (!ReadEntries(options.inputPath, entries)) {
+		return -1;
+	}
+	std::vector<std::pair<uint32_t, uint32_t>> sizes;
+	for (const AtlasEntry& entry : entries) {
+		sizes.emplace_back(entry.width, entry.height);
+	}
+
+	uint32_t atlasSize = 0;
+	std::vector<AtlasRegion> regions;
+	float occupancy = 0.0f;
+	if (!Pack(options, sizes, atlasSize, regions, occupancy)) {
+		printf("%zu images do not fit in a %ux%u atlas\n", entries.size(), atlasSize, atlasSize);
+		return 1;
+	}
+	if (!WriteRegions(options.outputPath, atlasSize, entries, regions)) {
+		return -1;
+	}
+	printf("Packed %zu images into %ux%u (occupancy %.1f%%)\n", entries.size(), atlasSize, atlasSize, occupancy * 100.0f);
+	return 0;
+}
@@ -1,6 +1,13 @@
 #include "BasicShaderHeader.hlsli"
+#include "TileStreaming.hlsli"
 
 float4 BasicPS(Output input) : SV_Target
 {
     return float4(tex.Sample(samplerState, input.uv));
 }
+
+// eNX`^CœǂݍނƂB^CtB[hobNɏ
+float4 StreamedPS(Output input) : SV_Target
+{
+    return SampleStreamed(input.uv);
+}
@@ -1,9 +1,9 @@
 #include "BasicShaderHeader.hlsli"
 
-Output BasicVS(float4 pos : POSITION, float2 uv : TEXCOORD)
+Output BasicVS(float3 pos : POSITION, float2 uv : TEXCOORD)
 {
     Output output;
-    output.svpos = pos;
+    output.svpos = float4(pos, 1.0f);
     output.uv = uv;
     return output;
 }
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// body ̖߂lɑāAȂ悤ɂ
+	volatile uint64_t g_benchmarkSink = 0;
+
+	double RunIterations(const std::function<uint64_t()>& body, uint64_t iterations, uint64_t& bytes)
+	{
+		using Clock = std::chrono::steady_clock;
+		uint64_t sink = 0;
+		const Clock::time_point start = Clock::now();
+		for (uint64_t i = 0; i < iterations; ++i) {
+			sink += body();
+		}
+		const Clock::duration elapsed = Clock::now() - start;
+		g_benchmarkSink = g_benchmarkSink + sink;
+		bytes = sink;
+		return std::chrono::duration<double, std::nano>(elapsed).count();
+	}
+
+	// "key": ̒̈ʒuBȂ npos
+	size_t FindValue(const std::string& json, size_t begin, size_t end, const char* key)
+	{
+		const std::string quoted = std::string("\"") + key + "\"";
+		const size_t found = json.find(quoted, begin);
+		if (found == std::string::npos || found >= end) {
+			return std::string::npos;
+		}
+		const size_t colon = json.find(':', found + quoted.size());
+		return colon == std::string::npos || colon >= end ? std::string::npos : colon + 1;
+	}
+
+	bool ReadNumber(const std::string& json, size_t begin, size_t end, const char* key, double& value)
+	{
+		const size_t position = FindValue(json, begin, end, key);
+		if (position == std::string::npos) {
+			return false;
+		}
+		char* parsedEnd = nullptr;
+		value = std::strtod(json.c_str() + position, &parsedEnd);
+		return parsedEnd != json.c_str() + position;
+	}
+
+	bool ReadString(const std::string& json, size_t begin, size_t end, const char* key, std::string& value)
+	{
+		const size_t position = FindValue(json, begin, end, key);
+		if (position == std::string::npos) {
+			return false;
+		}
+		const size_t open = json.find('"', position);
+		const size_t close = open == std::string::npos ? std::string::npos : json.find('"', open + 1);
+		if (close == std::string::npos || close >= end) {
+			return false;
+		}
+		value = json.substr(open + 1, close - open - 1);
+		return true;
+	}
+}
+
+void BenchmarkSuite::Add(const std::string& name, std::function<uint64_t()> body)
+{
+	m_cases.push_back({ name, std::move(body), false });
+}
+
+void BenchmarkSuite::AddItems(const std::string& name, std::function<uint64_t()> body)
+{
+	m_cases.push_back({ name, std::move(body), true });
+}
+
+std::vector<BenchmarkResult> BenchmarkSuite::Run(
+	const std::string& filter,
+	double sampleMilliseconds,
+	int sampleCount
+) const {
+	const double sampleNanoseconds = sampleMilliseconds * 1.0e6;
+	std::vector<BenchmarkResult> results;
+	for (const Case& benchmark : m_cases) {
+		if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+			continue;
+		}
+
+		// 1Tv\ȒɂȂ܂ŉ񐔂𑝂₷(ŏ1̓EH[Abv˂)
+		uint64_t bytes = 0;
+		uint64_t iterations = 1;
+		double elapsed = RunIterations(benchmark.body, iterations, bytes);
+		while (elapsed < sampleNanoseconds && iterations < (1ull << 40)) {
+			const double scale = elapsed > 0.0 ? sampleNanoseconds / elapsed : 10.0;
+			iterations = (std::max)(iterations + 1, static_cast<uint64_t>(iterations * (std::min)(scale * 1.2, 10.0)));
+			elapsed = RunIterations(benchmark.body, iterations, bytes);
+		}
+
+		std::vector<double> perIteration;
+		for (int sample = 0; sample < sampleCount; ++sample) {
+			perIteration.push_back(RunIterations(benchmark.body, iterations, bytes) / iterations);
+		}
+		std::sort(perIteration.begin(), perIteration.end());
+
+		BenchmarkResult result;
+		result.name = benchmark.name;
+		result.iterations = iterations;
+		result.medianNanoseconds = perIteration[perIteration.size() / 2];
+		result.minNanoseconds = perIteration.front();
+		const double perIterationCount = static_cast<double>(bytes) / iterations;
+		const double perSecond = result.medianNanoseconds > 0.0 ? perIterationCount * 1.0e9 / result.medianNanoseconds : 0.0;
+		if (benchmark.countsItems) {
+			result.itemsPerSecond = perSecond;
+		} else {
+			result.bytesPerSecond = perSecond;
+		}
+		results.push_back(result);
+	}
+	return results;
+}
+
+std::string BenchmarkResultsToJson(const std::vector<BenchmarkResult>& results)
+{
+	std::string json = "{\n  \"benchmarks\": [\n";
+	char line[512];
+	for (size_t i = 0; i < results.size(); ++i) {
+		const BenchmarkResult& result = results[i];
+		std::snprintf(
+			line,
+			sizeof(line),
+			"    {\"name\": \"%s\", \"iterations\": %llu, \"median_ns\": %.3f, \"min_ns\": %.3f, \"bytes_per_second\": %.1f, \"items_per_second\": %.1f}%s\n",
+			result.name.c_str(),
+			static_cast<unsigned long long>(result.iterations),
+			result.medianNanoseconds,
+			result.minNanoseconds,
+			result.bytesPerSecond,
+			result.itemsPerSecond,
+			i + 1 < results.size() ? "," : ""
+		);
+		json += line;
+	}
+	return json + "  ]\n}\n";
+}
+
+bool ParseBenchmarkJson(const std::string& json, std::vector<BenchmarkResult>& results)
+{
+	const size_t array = FindValue(json, 0, json.size(), "benchmarks");
+	if (array == std::string::npos) {
+		return false;
+	}
+	std::vector<BenchmarkResult> parsed;
+	size_t position = json.find('[', array);
+	while (position != std::string::npos) {
+		const size_t begin = json.find('{', position);
+		if (begin == std::string::npos) {
+			break;
+		}
+		const size_t end = json.find('}', begin);
+		if (end == std::string::npos) {
+			return false;
+		}
+		BenchmarkResult result;
+		double iterations = 0.0;
+		if (!ReadString(json, begin, end, "name", result.name) ||
+			!ReadNumber(json, begin, end, "iterations", iterations) ||
+			!ReadNumber(json, begin, end, "median_ns", result.medianNanoseconds) ||
+			!ReadNumber(json, begin, end, "min_ns", result.minNanoseconds) ||
+			!ReadNumber(json, begin, end, "bytes_per_second", result.bytesPerSecond)) {
+			return false;
+		}
+		// ̃X[vbg͌ォ瑫̂ŁAÂʂɂ͂Ȃ
+		ReadNumber(json, begin, end, "items_per_second", result.itemsPerSecond);
+		result.iterations = static_cast<uint64_t>(iterations);
+		parsed.push_back(result);
+		position = end + 1;
+	}
+	results = std::move(parsed);
+	return true;
+}
+
+std::vector<BenchmarkComparison> CompareWithBaseline(
+	const std::vector<BenchmarkResult>& current,
+	const std::vector<BenchmarkResult>& baseline,
+	double tolerance
+) {
+	std::vector<BenchmarkComparison> comparisons;
+	for (const BenchmarkResult& result : current) {
+		const auto found = std::find_if(
+			baseline.begin(),
+			baseline.end(),
+			[&result](const BenchmarkResult& base) { return base.name == result.name; }
+		);
+		if (found == baseline.end() || found->medianNanoseconds <= 0.0) {
+			continue;
+		}
+		const double ratio = result.medianNanoseconds / found->medianNanoseconds;
+		comparisons.push_back({
+			result.name,
+			found->medianNanoseconds,
+			result.medianNanoseconds,
+			ratio,
+			ratio > 1.0 + tolerance
+		});
+	}
+	return comparisons;
+}
+
+std::string FormatBenchmarkResults(const std::vector<BenchmarkResult>& results)
+{
+	std::string text;
+	char line[256];
+	for (const BenchmarkResult& result : results) {
+		const bool countsItems = result.itemsPerSecond > 0.0;
+		std::snprintf(
+			line,
+			sizeof(line),
+			"%-40s %14.1f ns (min %14.1f) %10.1f %s\n",
+			result.name.c_str(),
+			result.medianNanoseconds,
+			result.minNanoseconds,
+			countsItems ? result.itemsPerSecond / 1.0e6 : result.bytesPerSecond / (1024.0 * 1024.0),
+			countsItems ? "items/us" : "MB/s"
+		);
+		text += line;
+	}
+	return text;
+}
+
+std::string FormatBenchmarkComparisons(const std::vector<BenchmarkComparison>& comparisons)
+{
+	std::string text;
+	char line[256];
+	for (const BenchmarkComparison& comparison : comparisons) {
+		std::snprintf(
+			line,
+			sizeof(line),
+			"%-40s %14.1f -> %14.1f ns (%+6.1f%%)%s\n",
+			comparison.name.c_str(),
+			comparison.baselineNanoseconds,
+			comparison.currentNanoseconds,
+			(comparison.ratio - 1.0) * 100.0,
+			comparison.regressed ? " REGRESSED" : ""
+		);
+		text += line;
+	}
+	return text;
+}
+}
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+struct BenchmarkResult
+{
+	std::string name;
+	// 1Tv̌JԂ
+	uint64_t iterations = 0;
+	// 1񂠂̎(Tv̒lƍŏl)
+	double medianNanoseconds = 0.0;
+	double minNanoseconds = 0.0;
+	// 1ŏoCg狁߂X[vbgBoCgԂȂP[X 0
+	double bytesPerSecond = 0.0;
+	// AddItems ̃P[XŁA1ŏ狁߂X[vbgBȊO 0
+	double itemsPerSecond = 0.0;
+};
+
+// OťvP[XW߂ďɑBD3D12 ɈˑȂ̂ Windows ȊOł
+class BenchmarkSuite
+{
+public:
+	// body 1񕪂̏ŁAoCgԂ(Ȃ 0)B
+	// ߂l͍œKŏƏȂ悤Ɏg
+	void Add(const std::string& name, std::function<uint64_t()> body);
+	// body 1񕪂̏ŁA(JOŔ肵 AABB ̐Ȃ)ԂBʂ1}CNb̐(items/us)ŏo
+	void AddItems(const std::string& name, std::function<uint64_t()> body);
+
+	// eP[XA1Tv sampleMilliseconds ȏɂȂ񐔂ɍ킹Ă sampleCount 񑪂B
+	// filter łȂΖOɂ܂ރP[X
+	std::vector<BenchmarkResult> Run(
+		const std::string& filter = std::string(),
+		double sampleMilliseconds = 20.0,
+		int sampleCount = 7
+	) const;
+
+private:
+	struct Case
+	{
+		std::string name;
+		std::function<uint64_t()> body;
+		bool countsItems;
+	};
+	std::vector<Case> m_cases;
+};
+
+// {"benchmarks": [{"name": ..., "iterations": ..., "median_ns": ..., "min_ns": ..., "bytes_per_second": ..., "items_per_second": ...}, ...]}
+std::string BenchmarkResultsToJson(const std::vector<BenchmarkResult>& results);
+// BenchmarkResultsToJson ŏ̂ǂ(ȊO JSON ͑z肵Ȃ)
+bool ParseBenchmarkJson(const std::string& json, std::vector<BenchmarkResult>& results);
+
+struct BenchmarkComparison
+{
+	std::string name;
+	double baselineNanoseconds;
+	double currentNanoseconds;
+	// current / baselineB1 傫ΒxȂĂ
+	double ratio;
+	bool regressed;
+};
+
+// lŔׁAbaseline  tolerance(0.1 Ȃ 10%)𒴂Ēx̂ regressed ɂB
+// baseline ɂȂP[Xׂ͔Ȃ
+std::vector<BenchmarkComparison> CompareWithBaseline(
+	const std::vector<BenchmarkResult>& current,
+	const std::vector<BenchmarkResult>& baseline,
+	double tolerance
+);
+std::string FormatBenchmarkResults(const std::vector<BenchmarkResult>& results);
+std::string FormatBenchmarkComparisons(const std::vector<BenchmarkComparison>& comparisons);
+}
+}
@@ -0,0 +1,147 @@
+#ifdef _WIN32
+#include <Windows.h>
+#endif // _WIN32
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "HotPathBenchmarks.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	constexpr char kDefaultResultsPath[] = "benchmark_results.json";
+#ifdef YUXX_SOURCE_DIR
+	constexpr char kDefaultImagePath[] = YUXX_SOURCE_DIR "/img/͌̋C.jpg";
+	constexpr char kDefaultPngPath[] = YUXX_SOURCE_DIR "/img/be_logo.png";
+#else
+	constexpr char kDefaultImagePath[] = "img/͌̋C.jpg";
+	constexpr char kDefaultPngPath[] = "img/be_logo.png";
+#endif // YUXX_SOURCE_DIR
+	// baseline ̒l炱̊𒴂ĒxȂ玸sɂ
+	constexpr double kDefaultTolerance = 0.1;
+
+	struct Options
+	{
+		std::string filter;
+		std::string baselinePath;
+		std::string outputPath = kDefaultResultsPath;
+		std::string imagePath = kDefaultImagePath;
+		std::string pngPath = kDefaultPngPath;
+		double tolerance = kDefaultTolerance;
+	};
+
+	void PrintUsage()
+	{
+		printf(
+			"usage: hot_path_benchmarks [--filter <text>] [--baseline <json>] [--output <json>]\n"
+			"                           [--image <path>] [--png <path>] [--tolerance <ratio>]\n"
+			"  --filter     measure only the cases whose name contains <text> (e.g. draw_sort/)\n"
+			"  --baseline   compare medians with a previous result and exit with 1 on regressions\n"
+			"  --output     where to write the results (default: %s)\n"
+			"  --image      JPEG used by the decode cases\n"
+			"  --png        PNG used by the decode cases\n"
+			"  --tolerance  allowed slowdown against the baseline (default: %.2f)\n",
+			kDefaultResultsPath,
+			kDefaultTolerance
+		);
+	}
+
+	// lIvVȂ̂ŁAOƒl̑gœǂ
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i) {
+			const char* name = argv[i];
+			if (strcmp(name, "--help") == 0 || i + 1 >= argc) {
+				return false;
+			}
+			const char* value = argv[++i];
+			if (strcmp(name, "--filter") == 0) {
+				options.filter = value;
+			} else if (strcmp(name, "--baseline") == 0) {
+				options.baselinePath = value;
+			} else if (strcmp(name, "--output") == 0) {
+				options.outputPath = value;
+			} else if (strcmp(name, "--image") == 0) {
+				options.imagePath = value;
+			} else if (strcmp(name, "--png") == 0) {
+				options.pngPath = value;
+			} else if (strcmp(name, "--tolerance") == 0) {
+				options.tolerance = std::atof(value);
+			} else {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ReadBaseline(const std::string& path, std::vector<BenchmarkResult>& baseline)
+	{
+		std::ifstream input(path, std::ios::binary);
+		std::stringstream json;
+		json << input.rdbuf();
+		return input && ParseBenchmarkJson(json.str(), baseline);
+	}
+
+	// zbgpX𑪂Čʂ JSON ɏB--baseline nƂ́AxȂP[X 1 Ԃ
+	int RunBenchmarks(const Options& options)
+	{
+		std::vector<BenchmarkResult> baseline;
+		if (!options.baselinePath.empty() && !ReadBaseline(options.baselinePath, baseline)) {
+			printf("Failed to read baseline %s\n", options.baselinePath.c_str());
+			return -1;
+		}
+
+		BenchmarkSuite suite;
+		AddHotPathBenchmarks(suite, options.imagePath, options.pngPath);
+		const std::vector<BenchmarkResult> results = suite.Run(options.filter);
+		printf("%s", FormatBenchmarkResults(results).c_str());
+
+		std::ofstream output(options.outputPath, std::ios::binary);
+		output << BenchmarkResultsToJson(results);
+		if (!output) {
+			printf("Failed to write %s\n", options.outputPath.c_str());
+			return -1;
+		}
+
+		if (options.baselinePath.empty()) {
+			return 0;
+		}
+		const std::vector<BenchmarkComparison> comparisons = CompareWithBaseline(results, baseline, options.tolerance);
+		printf("%s", FormatBenchmarkComparisons(comparisons).c_str());
+		for (const BenchmarkComparison& comparison : comparisons) {
+			if (comparison.regressed) {
+				return 1;
+			}
+		}
+		return 0;
+	}
+}
+
+// EBhEȂR\[̃vOȂ̂ŁAʂ͕Wo͂ɂo
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return -1;
+	}
+
+#ifdef _WIN32
+	// 摜fR[h̃P[X WIC g
+	if (FAILED(CoInitializeEx(nullptr, COINIT_MULTITHREADED))) {
+		return -1;
+	}
+#endif // _WIN32
+	const int result = RunBenchmarks(options);
+#ifdef _WIN32
+	CoUninitialize();
+#endif // _WIN32
+	return result;
+}
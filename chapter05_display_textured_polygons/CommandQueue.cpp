@@ -0,0 +1,168 @@
+#include "CommandQueue.h"
+
+#include "Helpers.h"
+
+using Microsoft::WRL::ComPtr;
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+CommandQueue::~CommandQueue()
+{
+	// GPU gĂAP[^[ɉȂ悤
+	if (m_queue) {
+		Flush();
+	}
+}
+
+bool CommandQueue::Initialize(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type)
+{
+	m_device = device;
+	m_type = type;
+
+	D3D12_COMMAND_QUEUE_DESC commandQueueDesc{};
+	commandQueueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	commandQueueDesc.NodeMask = 0;
+	commandQueueDesc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+	commandQueueDesc.Type = type;
+	HRESULT result = device->CreateCommandQueue(&commandQueueDesc, IID_PPV_ARGS(m_queue.ReleaseAndGetAddressOf()));
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommandQueue Error (type %d): 0x%x\n", type, result);
+		return false;
+	}
+
+	result = device->CreateFence(m_lastSignaledValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(m_fence.ReleaseAndGetAddressOf()));
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateFence Error (type %d): 0x%x\n", type, result);
+		return false;
+	}
+	return true;
+}
+
+bool CommandQueue::BeginCommandList(ComPtr<ID3D12GraphicsCommandList>& commandList)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// IAP[^[Ύg܂킷
+	ComPtr<ID3D12CommandAllocator> allocator;
+	if (!m_allocators.empty() && m_fence->GetCompletedValue() >= m_allocators.front().fenceValue) {
+		allocator = m_allocators.front().allocator;
+		m_allocators.pop_front();
+		HRESULT result = allocator->Reset();
+		if (FAILED(result)) {
+			DebugOutputFormatString("Command allocator reset Error : 0x%x\n", result);
+			return false;
+		}
+	} else {
+		HRESULT result = m_device->CreateCommandAllocator(m_type, IID_PPV_ARGS(allocator.GetAddressOf()));
+		if (FAILED(result)) {
+			DebugOutputFormatString("CreateCommandAllocator Error : 0x%x\n", result);
+			return false;
+		}
+	}
+
+	if (!m_freeCommandLists.empty()) {
+		commandList = m_freeCommandLists.back();
+		m_freeCommandLists.pop_back();
+		HRESULT result = commandList->Reset(allocator.Get(), nullptr);
+		if (FAILED(result)) {
+			DebugOutputFormatString("Command list reset Error : 0x%x\n", result);
+			return false;
+		}
+	} else {
+		HRESULT result = m_device->CreateCommandList(
+			0,
+			m_type,
+			allocator.Get(),
+			nullptr,
+			IID_PPV_ARGS(commandList.ReleaseAndGetAddressOf())
+		);
+		if (FAILED(result)) {
+			DebugOutputFormatString("CreateCommandList Error : 0x%x\n", result);
+			return false;
+		}
+	}
+
+	m_recordingAllocators[commandList.Get()] = allocator;
+	return true;
+}
+
+UINT64 CommandQueue::Submit(ID3D12GraphicsCommandList* commandList)
+{
+	HRESULT result = commandList->Close();
+	if (FAILED(result)) {
+		DebugOutputFormatString("Command list close Error : 0x%x\n", result);
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	ID3D12CommandList* commandLists[] = { commandList };
+	m_queue->ExecuteCommandLists(1, commandLists);
+	const UINT64 fenceValue = SignalLocked();
+
+	const auto recording = m_recordingAllocators.find(commandList);
+	if (recording != m_recordingAllocators.end()) {
+		m_allocators.push_back({ recording->second, fenceValue });
+		m_recordingAllocators.erase(recording);
+	}
+	m_freeCommandLists.push_back(commandList);
+	return fenceValue;
+}
+
+UINT64 CommandQueue::Signal()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return SignalLocked();
+}
+
+UINT64 CommandQueue::SignalLocked()
+{
+	m_queue->Signal(m_fence.Get(), ++m_lastSignaledValue);
+	return m_lastSignaledValue;
+}
+
+void CommandQueue::WaitForQueue(const CommandQueue& other, UINT64 fenceValue)
+{
+	// ςłΐςޕKvȂ
+	if (other.IsComplete(fenceValue)) {
+		return;
+	}
+	m_queue->Wait(other.m_fence.Get(), fenceValue);
+}
+
+bool CommandQueue::IsComplete(UINT64 fenceValue) const
+{
+	return m_fence->GetCompletedValue() >= fenceValue;
+}
+
+void CommandQueue::WaitForFenceValue(UINT64 fenceValue) const
+{
+	if (IsComplete(fenceValue)) {
+		return;
+	}
+	auto event = CreateEvent(nullptr, false, false, nullptr);
+	m_fence->SetEventOnCompletion(fenceValue, event);
+	WaitForSingleObject(event, INFINITE);
+	CloseHandle(event);
+}
+
+void CommandQueue::Flush()
+{
+	WaitForFenceValue(Signal());
+}
+
+bool CommandQueueManager::Initialize(ID3D12Device* device)
+{
+	return m_direct.Initialize(device, D3D12_COMMAND_LIST_TYPE_DIRECT) &&
+		m_compute.Initialize(device, D3D12_COMMAND_LIST_TYPE_COMPUTE) &&
+		m_copy.Initialize(device, D3D12_COMMAND_LIST_TYPE_COPY);
+}
+
+void CommandQueueManager::FlushAll()
+{
+	m_direct.Flush();
+	m_compute.Flush();
+	m_copy.Flush();
+}
+}
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl.h>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+// ނƂ̃R}hL[ƁÃL[p̃AP[^[ER}hXg̃v[
+class CommandQueue
+{
+public:
+	CommandQueue() = default;
+	~CommandQueue();
+	CommandQueue(const CommandQueue&) = delete;
+	CommandQueue& operator=(const CommandQueue&) = delete;
+
+	bool Initialize(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type);
+
+	ID3D12CommandQueue* Get() const { return m_queue.Get(); }
+	D3D12_COMMAND_LIST_TYPE Type() const { return m_type; }
+
+	// v[R}hXgoċL^n߂BXbhĂł悢
+	bool BeginCommandList(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>& commandList);
+	// ĎsB߂l͂̎sIƂ\tFXl(sȂ0)
+	UINT64 Submit(ID3D12GraphicsCommandList* commandList);
+	// ݂܂łɐς񂾃R}hIƂ\tFXl
+	UINT64 Signal();
+
+	// ȍ~̃L[ɐςރR}h́AGPU  other  fenceValue ɒB܂ő҂
+	void WaitForQueue(const CommandQueue& other, UINT64 fenceValue);
+	bool IsComplete(UINT64 fenceValue) const;
+	// CPU Ŋ҂
+	void WaitForFenceValue(UINT64 fenceValue) const;
+	void Flush();
+
+private:
+	struct InFlightAllocator
+	{
+		Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator;
+		UINT64 fenceValue;
+	};
+
+	Microsoft::WRL::ComPtr<ID3D12Device> m_device;
+	D3D12_COMMAND_LIST_TYPE m_type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue> m_queue;
+	Microsoft::WRL::ComPtr<ID3D12Fence> m_fence;
+	UINT64 m_lastSignaledValue = 0;
+
+	std::mutex m_mutex;
+	// sɕł̂ŁA擪IĂȂΌIĂȂ
+	std::deque<InFlightAllocator> m_allocators;
+	// sɏoR}hXg͂ Reset Ďg܂킹
+	std::vector<Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>> m_freeCommandLists;
+	// L^̃R}hXggĂAP[^[
+	std::map<ID3D12GraphicsCommandList*, Microsoft::WRL::ComPtr<ID3D12CommandAllocator>> m_recordingAllocators;
+
+	UINT64 SignalLocked();
+};
+
+// `ERs[gERs[3̃L[܂Ƃ߂
+class CommandQueueManager
+{
+public:
+	bool Initialize(ID3D12Device* device);
+
+	CommandQueue& Direct() { return m_direct; }
+	CommandQueue& Compute() { return m_compute; }
+	CommandQueue& Copy() { return m_copy; }
+
+	void FlushAll();
+
+private:
+	CommandQueue m_direct;
+	CommandQueue m_compute;
+	CommandQueue m_copy;
+};
+}
+}
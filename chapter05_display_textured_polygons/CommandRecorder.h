@@ -0,0 +1,124 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+// `̋L^ɎgĂяo܂Ƃ߂C^[tF[XB
+// D3D12 ̌^gȂ̂ŁALv`̓ǂݏ D3D12 ̂Ȃł̍ĐɂgB
+// IuWFNg̓|C^[ł͂ȂĂяo߂ԍŎw(Lv`ĐĂԍɂȂ)
+using RecorderObjectId = uint32_t;
+constexpr RecorderObjectId kInvalidRecorderObject = 0;
+
+// DXGI_FORMAT  D3D12_PRIMITIVE_TOPOLOGY Ȃǂ͒l̂܂ uint32_t Ŏ
+struct RecorderViewport
+{
+	float topLeftX;
+	float topLeftY;
+	float width;
+	float height;
+	float minDepth;
+	float maxDepth;
+};
+
+struct RecorderRect
+{
+	int32_t left;
+	int32_t top;
+	int32_t right;
+	int32_t bottom;
+};
+
+struct RecorderTextureDescription
+{
+	uint32_t width;
+	uint32_t height;
+	uint32_t format;
+};
+
+struct RecorderInputElement
+{
+	std::string semanticName;
+	uint32_t semanticIndex;
+	uint32_t format;
+};
+
+// pCvC̕`ւ̏d˕
+enum RecorderBlendMode : uint32_t {
+	// ㏑
+	kBlendOpaque,
+	// Zς݃At@ŏd˂(src + dst * (1 - src.a))
+	kBlendPremultipliedAlpha,
+	// F͏Ȃ([x̃vpX)
+	kBlendColorWriteDisabled,
+};
+
+// pCvC̐[x̎gB[x reversed-Z(OقǑ傫A0 ŃNA)
+enum RecorderDepthMode : uint32_t {
+	kDepthDisabled,
+	// Oɂ̂`A[x
+	kDepthWrite,
+	// ׂ邾ŏ܂Ȃ(vpX̂Ƃ̖{`Ɣ)BvpXƓ[xʂ
+	kDepthTestOnly,
+};
+
+// DirectXManager::SetupGraphicsPipeline ̂ApCvCƂɕςƂ낾
+struct RecorderPipelineDescription
+{
+	RecorderObjectId rootSignature = kInvalidRecorderObject;
+	std::vector<uint8_t> vertexShader;
+	std::vector<uint8_t> pixelShader;
+	std::vector<RecorderInputElement> inputLayout;
+	uint32_t renderTargetFormat = 0;
+	uint32_t primitiveTopologyType = 0;
+	uint32_t blendMode = kBlendOpaque;
+	// [xgȂƂ DXGI_FORMAT_UNKNOWN(0)
+	uint32_t depthStencilFormat = 0;
+	uint32_t depthMode = kDepthDisabled;
+};
+
+class CommandRecorder
+{
+public:
+	virtual ~CommandRecorder() = default;
+
+	// ---- IuWFNg̍쐬ƃAbv[hBԍ22ڂ͉Ȃ ----
+
+	virtual bool CreateBuffer(RecorderObjectId id, uint64_t size) = 0;
+	// VF[_[ǂރeNX`Br[ꏏɍ
+	virtual bool CreateTexture(RecorderObjectId id, const RecorderTextureDescription& description) = 0;
+	// obt@[Ȃ擪AeNX`Ȃ1s rowPitch oCgŕׂŜ
+	virtual bool UploadResource(RecorderObjectId id, const void* data, size_t size, uint32_t rowPitch) = 0;
+	// D3D12SerializeRootSignature ̌
+	virtual bool CreateRootSignature(RecorderObjectId id, const void* serialized, size_t size) = 0;
+	virtual bool CreatePipelineState(RecorderObjectId id, const RecorderPipelineDescription& description) = 0;
+
+	// ---- `̋L^ ----
+
+	// `ݒ肷B`͎ƂɌ܂Ă
+	virtual void BeginFrame() = 0;
+	virtual void ClearRenderTarget(const float color[4]) = 0;
+	// [xobt@[ȂΉȂ
+	virtual void ClearDepth(float depth) = 0;
+	virtual void SetPipelineState(RecorderObjectId pipelineState) = 0;
+	virtual void SetGraphicsRootSignature(RecorderObjectId rootSignature) = 0;
+	virtual void SetViewport(const RecorderViewport& viewport) = 0;
+	virtual void SetScissorRect(const RecorderRect& rect) = 0;
+	// eNX` SRV 1ufBXNv^e[uݒ肷
+	virtual void SetGraphicsRootTexture(uint32_t rootParameterIndex, RecorderObjectId texture) = 0;
+	virtual void SetPrimitiveTopology(uint32_t topology) = 0;
+	virtual void SetVertexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t stride) = 0;
+	virtual void SetIndexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t format) = 0;
+	virtual void DrawIndexedInstanced(
+		uint32_t indexCountPerInstance,
+		uint32_t instanceCount,
+		uint32_t startIndexLocation,
+		int32_t baseVertexLocation,
+		uint32_t startInstanceLocation
+	) = 0;
+	virtual void EndFrame() = 0;
+};
+}
+}
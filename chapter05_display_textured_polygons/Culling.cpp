@@ -0,0 +1,440 @@
+#include "Culling.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define YUXX_CULLING_SSE
+#endif
+
+// AVX2 ͎s CPU 𒲂ׂĂgBGCC / Clang ł͊֐Ƃɖ߃Zbg
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define YUXX_CULLING_AVX2
+#ifdef _MSC_VER
+#include <intrin.h>
+#define YUXX_TARGET_AVX2
+#else
+#define YUXX_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif // _MSC_VER
+#endif
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	Float3 CenterAt(const AabbSoA& aabbs, size_t i)
+	{
+		return { aabbs.centerX[i], aabbs.centerY[i], aabbs.centerZ[i] };
+	}
+
+	Float3 ExtentAt(const AabbSoA& aabbs, size_t i)
+	{
+		return { aabbs.extentX[i], aabbs.extentY[i], aabbs.extentZ[i] };
+	}
+
+	// [̓XJ[Ŕ肷
+	bool IsInsideFrustum(const Frustum& frustum, const Float3& center, const Float3& extent)
+	{
+		for (const auto& plane : frustum.planes) {
+			const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			const float radius =
+				std::fabs(plane.x) * extent.x + std::fabs(plane.y) * extent.y + std::fabs(plane.z) * extent.z;
+			if (distance + radius < 0.0f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// mask ̃rbgĂ(ɓĂ)[̂AՕĂȂ̂
+	size_t AppendVisibleLanes(
+		const Frustum& frustum,
+		const AabbSoA& aabbs,
+		size_t first,
+		int mask,
+		const OcclusionBuffer* occlusionBuffer,
+		uint32_t* visibleIndices,
+		size_t visibleCount
+	) {
+		for (; mask != 0; mask &= mask - 1) {
+			int lane = 0;
+			while ((mask & (1 << lane)) == 0) {
+				++lane;
+			}
+			const size_t index = first + lane;
+			if (occlusionBuffer != nullptr &&
+				occlusionBuffer->IsOccluded(frustum, CenterAt(aabbs, index), ExtentAt(aabbs, index))) {
+				continue;
+			}
+			visibleIndices[visibleCount++] = static_cast<uint32_t>(index);
+		}
+		return visibleCount;
+	}
+
+#ifdef YUXX_CULLING_AVX2
+	bool CpuSupportsAvx2()
+	{
+#ifdef _MSC_VER
+		int registers[4];
+		__cpuid(registers, 0);
+		if (registers[0] < 7) {
+			return false;
+		}
+		// FMA(ecx bit 12)AOS  YMM ۑ(ecx bit 27  XCR0  bit 1, 2)AAVX2(leaf 7  ebx bit 5)
+		__cpuid(registers, 1);
+		const bool fma = (registers[2] & (1 << 12)) != 0;
+		const bool osxsave = (registers[2] & (1 << 27)) != 0;
+		if (!fma || !osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+			return false;
+		}
+		__cpuidex(registers, 7, 0);
+		return (registers[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif // _MSC_VER
+	}
+
+	// 8܂Ƃ߂Ĕ肵A肵I i ɐi߂
+	YUXX_TARGET_AVX2 size_t CullAabbsAvx2(
+		const Frustum& frustum,
+		const AabbSoA& aabbs,
+		uint32_t* visibleIndices,
+		const OcclusionBuffer* occlusionBuffer,
+		size_t& i
+	) {
+		const size_t count = aabbs.Size();
+		size_t visibleCount = 0;
+		__m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+		__m256 absX[6], absY[6], absZ[6];
+		const __m256 signMask = _mm256_set1_ps(-0.0f);
+		for (int p = 0; p < 6; ++p) {
+			const Float4& plane = frustum.planes[p];
+			planeX[p] = _mm256_set1_ps(plane.x);
+			planeY[p] = _mm256_set1_ps(plane.y);
+			planeZ[p] = _mm256_set1_ps(plane.z);
+			planeW[p] = _mm256_set1_ps(plane.w);
+			absX[p] = _mm256_andnot_ps(signMask, planeX[p]);
+			absY[p] = _mm256_andnot_ps(signMask, planeY[p]);
+			absZ[p] = _mm256_andnot_ps(signMask, planeZ[p]);
+		}
+
+		for (; i + 8 <= count; i += 8) {
+			const __m256 cx = _mm256_loadu_ps(&aabbs.centerX[i]);
+			const __m256 cy = _mm256_loadu_ps(&aabbs.centerY[i]);
+			const __m256 cz = _mm256_loadu_ps(&aabbs.centerZ[i]);
+			const __m256 ex = _mm256_loadu_ps(&aabbs.extentX[i]);
+			const __m256 ey = _mm256_loadu_ps(&aabbs.extentY[i]);
+			const __m256 ez = _mm256_loadu_ps(&aabbs.extentZ[i]);
+
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (int p = 0; p < 6; ++p) {
+				// distance + radius = (cEn + w) + (eE|n|)
+				__m256 sum = _mm256_fmadd_ps(cx, planeX[p], planeW[p]);
+				sum = _mm256_fmadd_ps(cy, planeY[p], sum);
+				sum = _mm256_fmadd_ps(cz, planeZ[p], sum);
+				sum = _mm256_fmadd_ps(ex, absX[p], sum);
+				sum = _mm256_fmadd_ps(ey, absY[p], sum);
+				sum = _mm256_fmadd_ps(ez, absZ[p], sum);
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(sum, _mm256_setzero_ps(), _CMP_GE_OQ));
+			}
+			visibleCount = AppendVisibleLanes(
+				frustum,
+				aabbs,
+				i,
+				_mm256_movemask_ps(inside),
+				occlusionBuffer,
+				visibleIndices,
+				visibleCount
+			);
+		}
+		return visibleCount;
+	}
+#endif // YUXX_CULLING_AVX2
+}
+
+void AabbSoA::Add(const Float3& center, const Float3& extent)
+{
+	centerX.push_back(center.x);
+	centerY.push_back(center.y);
+	centerZ.push_back(center.z);
+	extentX.push_back(extent.x);
+	extentY.push_back(extent.y);
+	extentZ.push_back(extent.z);
+}
+
+void AabbSoA::Clear()
+{
+	centerX.clear();
+	centerY.clear();
+	centerZ.clear();
+	extentX.clear();
+	extentY.clear();
+	extentZ.clear();
+}
+
+Frustum Frustum::FromViewProjection(const Float4x4& viewProjection)
+{
+	// sxNg`Ȃ̂ŁAeʂ͍s̗̘aƍɂȂ
+	const auto column = [&](int index) {
+		return Float4{
+			viewProjection.m[0][index],
+			viewProjection.m[1][index],
+			viewProjection.m[2][index],
+			viewProjection.m[3][index],
+		};
+	};
+	const auto add = [](const Float4& a, const Float4& b) { return Float4{ a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w }; };
+	const auto subtract = [](const Float4& a, const Float4& b) { return Float4{ a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w }; };
+	const Float4 planes[6] = {
+		// 
+		add(column(3), column(0)),
+		// E
+		subtract(column(3), column(0)),
+		// 
+		add(column(3), column(1)),
+		// 
+		subtract(column(3), column(1)),
+		// O(D3D  0 <= z)
+		column(2),
+		// 
+		subtract(column(3), column(2)),
+	};
+
+	Frustum frustum{};
+	for (int i = 0; i < 6; ++i) {
+		// @PʒɂāAw ̂܂܋ɂȂ悤ɂ
+		const Float4& plane = planes[i];
+		const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+		frustum.planes[i] = { plane.x * scale, plane.y * scale, plane.z * scale, plane.w * scale };
+	}
+	frustum.viewProjection = viewProjection;
+	return frustum;
+}
+
+OcclusionBuffer::OcclusionBuffer(unsigned int width, unsigned int height, bool reversedZ)
+	: m_width(width), m_height(height), m_reversedZ(reversedZ), m_depth(width * height)
+{
+	Clear();
+}
+
+void OcclusionBuffer::Clear()
+{
+	// ԉ(reversedZ ł 0 ̕𔽓])
+	std::fill(m_depth.begin(), m_depth.end(), m_reversedZ ? 0.0f : 1.0f);
+}
+
+bool OcclusionBuffer::ProjectAabb(
+	const Frustum& frustum,
+	const Float3& center,
+	const Float3& extent,
+	bool inner,
+	ScreenRect& rect
+) const
+{
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	rect.minDepth = FLT_MAX;
+	rect.maxDepth = -FLT_MAX;
+	for (int corner = 0; corner < 8; ++corner) {
+		const Float3 position = {
+			center.x + ((corner & 1) ? extent.x : -extent.x),
+			center.y + ((corner & 2) ? extent.y : -extent.y),
+			center.z + ((corner & 4) ? extent.z : -extent.z),
+		};
+		const Float4 clip = TransformPoint(position, frustum.viewProjection);
+		// J̌ɂꍇ͔肵Ȃ
+		if (clip.w <= 0.0f) {
+			return false;
+		}
+		const float x = clip.x / clip.w;
+		const float y = clip.y / clip.w;
+		const float depth = m_reversedZ ? -clip.z / clip.w : clip.z / clip.w;
+		minX = (std::min)(minX, x);
+		maxX = (std::max)(maxX, x);
+		minY = (std::min)(minY, y);
+		maxY = (std::max)(maxY, y);
+		rect.minDepth = (std::min)(rect.minDepth, depth);
+		rect.maxDepth = (std::max)(rect.maxDepth, depth);
+	}
+
+	// NDC obt@[̃sNZW(y ͉)Bʂ̊O͐؂l߂
+	const float left = (std::max)((minX * 0.5f + 0.5f) * m_width, 0.0f);
+	const float right = (std::min)((maxX * 0.5f + 0.5f) * m_width, static_cast<float>(m_width));
+	const float top = (std::max)((0.5f - maxY * 0.5f) * m_height, 0.0f);
+	const float bottom = (std::min)((0.5f - minY * 0.5f) * m_height, static_cast<float>(m_height));
+	if (inner) {
+		rect.left = static_cast<int>(std::ceil(left));
+		rect.right = static_cast<int>(std::floor(right));
+		rect.top = static_cast<int>(std::ceil(top));
+		rect.bottom = static_cast<int>(std::floor(bottom));
+	} else {
+		rect.left = static_cast<int>(std::floor(left));
+		rect.right = static_cast<int>(std::ceil(right));
+		rect.top = static_cast<int>(std::floor(top));
+		rect.bottom = static_cast<int>(std::ceil(bottom));
+	}
+	return rect.left < rect.right && rect.top < rect.bottom;
+}
+
+void OcclusionBuffer::RasterizeOccluder(const Frustum& frustum, const Float3& center, const Float3& extent)
+{
+	// Oڋ`ĂƂ݂ȂA[̃sNZ͓hȂ(Ă邾̃sNZBȂ)
+	ScreenRect rect;
+	if (!ProjectAabb(frustum, center, extent, true, rect)) {
+		return;
+	}
+	for (int y = rect.top; y < rect.bottom; ++y) {
+		float* row = &m_depth[y * m_width];
+		for (int x = rect.left; x < rect.right; ++x) {
+			row[x] = (std::min)(row[x], rect.maxDepth);
+		}
+	}
+}
+
+bool OcclusionBuffer::IsOccluded(const Frustum& frustum, const Float3& center, const Float3& extent) const
+{
+	ScreenRect rect;
+	if (!ProjectAabb(frustum, center, extent, false, rect)) {
+		return false;
+	}
+	for (int y = rect.top; y < rect.bottom; ++y) {
+		const float* row = &m_depth[y * m_width];
+		for (int x = rect.left; x < rect.right; ++x) {
+			// 1sNZłO([x܂)ɂΌĂ
+			if (rect.minDepth <= row[x]) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+size_t OcclusionBuffer::CullFrontToBack(const Frustum& frustum, const AabbSoA& aabbs, uint32_t* indices, size_t count)
+{
+	size_t keptCount = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t index = indices[i];
+		const Float3 center = CenterAt(aabbs, index);
+		const Float3 extent = ExtentAt(aabbs, index);
+		// gɉBȂ悤A肵Ă珑
+		if (IsOccluded(frustum, center, extent)) {
+			continue;
+		}
+		RasterizeOccluder(frustum, center, extent);
+		indices[keptCount++] = index;
+	}
+	return keptCount;
+}
+
+bool IsCullingInstructionSetSupported(CullingInstructionSet instructionSet)
+{
+	switch (instructionSet) {
+	case CullingInstructionSet::Auto:
+	case CullingInstructionSet::Scalar:
+		return true;
+	case CullingInstructionSet::Sse2:
+#ifdef YUXX_CULLING_SSE
+		return true;
+#else
+		return false;
+#endif // YUXX_CULLING_SSE
+	case CullingInstructionSet::Avx2:
+#ifdef YUXX_CULLING_AVX2
+	{
+		static const bool supported = CpuSupportsAvx2();
+		return supported;
+	}
+#else
+		return false;
+#endif // YUXX_CULLING_AVX2
+	}
+	return false;
+}
+
+size_t CullAabbs(
+	const Frustum& frustum,
+	const AabbSoA& aabbs,
+	uint32_t* visibleIndices,
+	const OcclusionBuffer* occlusionBuffer,
+	CullingInstructionSet instructionSet
+) {
+	if (instructionSet == CullingInstructionSet::Auto) {
+		instructionSet = IsCullingInstructionSetSupported(CullingInstructionSet::Avx2) ? CullingInstructionSet::Avx2 : CullingInstructionSet::Sse2;
+	}
+	const size_t count = aabbs.Size();
+	size_t visibleCount = 0;
+	size_t i = 0;
+
+#ifdef YUXX_CULLING_AVX2
+	if (instructionSet == CullingInstructionSet::Avx2 && IsCullingInstructionSetSupported(CullingInstructionSet::Avx2)) {
+		visibleCount = CullAabbsAvx2(frustum, aabbs, visibleIndices, occlusionBuffer, i);
+	}
+#endif // YUXX_CULLING_AVX2
+
+#ifdef YUXX_CULLING_SSE
+	// eʂ̐4[ɕĂ
+	__m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+	__m128 absX[6], absY[6], absZ[6];
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	for (int p = 0; p < 6; ++p) {
+		const Float4& plane = frustum.planes[p];
+		planeX[p] = _mm_set1_ps(plane.x);
+		planeY[p] = _mm_set1_ps(plane.y);
+		planeZ[p] = _mm_set1_ps(plane.z);
+		planeW[p] = _mm_set1_ps(plane.w);
+		absX[p] = _mm_andnot_ps(signMask, planeX[p]);
+		absY[p] = _mm_andnot_ps(signMask, planeY[p]);
+		absZ[p] = _mm_andnot_ps(signMask, planeZ[p]);
+	}
+
+	// 4܂Ƃ߂Ĕ(AVX2 Ŕ肵c)
+	for (; instructionSet != CullingInstructionSet::Scalar && i + 4 <= count; i += 4) {
+		const __m128 cx = _mm_loadu_ps(&aabbs.centerX[i]);
+		const __m128 cy = _mm_loadu_ps(&aabbs.centerY[i]);
+		const __m128 cz = _mm_loadu_ps(&aabbs.centerZ[i]);
+		const __m128 ex = _mm_loadu_ps(&aabbs.extentX[i]);
+		const __m128 ey = _mm_loadu_ps(&aabbs.extentY[i]);
+		const __m128 ez = _mm_loadu_ps(&aabbs.extentZ[i]);
+
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int p = 0; p < 6; ++p) {
+			const __m128 distance = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(cx, planeX[p]), _mm_mul_ps(cy, planeY[p])),
+				_mm_add_ps(_mm_mul_ps(cz, planeZ[p]), planeW[p])
+			);
+			const __m128 radius = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(ex, absX[p]), _mm_mul_ps(ey, absY[p])),
+				_mm_mul_ps(ez, absZ[p])
+			);
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+		}
+		visibleCount = AppendVisibleLanes(
+			frustum,
+			aabbs,
+			i,
+			_mm_movemask_ps(inside),
+			occlusionBuffer,
+			visibleIndices,
+			visibleCount
+		);
+	}
+#endif // YUXX_CULLING_SSE
+
+	for (; i < count; ++i) {
+		const Float3 center = CenterAt(aabbs, i);
+		const Float3 extent = ExtentAt(aabbs, i);
+		if (!IsInsideFrustum(frustum, center, extent)) {
+			continue;
+		}
+		if (occlusionBuffer != nullptr && occlusionBuffer->IsOccluded(frustum, center, extent)) {
+			continue;
+		}
+		visibleIndices[visibleCount++] = static_cast<uint32_t>(i);
+	}
+
+	return visibleCount;
+}
+}
+}
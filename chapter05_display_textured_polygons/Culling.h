@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "VectorMath.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// SIMD ł܂Ƃ߂Ĕł悤AƂɋl߂ĕׂ AABB Q
+struct AabbSoA
+{
+	std::vector<float> centerX, centerY, centerZ;
+	std::vector<float> extentX, extentY, extentZ;
+
+	void Add(const Float3& center, const Float3& extent);
+	void Clear();
+	size_t Size() const { return centerX.size(); }
+};
+
+// (ʂ͓ɂȂ)
+struct Frustum
+{
+	Float4 planes[6];
+	Float4x4 viewProjection;
+
+	static Frustum FromViewProjection(const Float4x4& viewProjection);
+};
+
+// IN[WJOp̒𑜓x\tgEFA[xobt@[B
+// Օ͉ʂɐ΂(`Ălp`̂悤Ȃ)z肵AOڋ`̓ɓsNZh
+class OcclusionBuffer
+{
+public:
+	// reversedZ Ȃ[x͎OقǑ傫(DirectXManager ̐[xobt@[Ɠ)
+	OcclusionBuffer(unsigned int width, unsigned int height, bool reversedZ = false);
+
+	void Clear();
+	// Օ AABB ށB̐[xœĥŕێIȔɂȂ
+	void RasterizeOccluder(const Frustum& frustum, const Float3& center, const Float3& extent);
+	// AABB SɎՕĂ true
+	bool IsOccluded(const Frustum& frustum, const Float3& center, const Float3& extent) const;
+	// O珇ɕ indices(count )ɔ肵AÔ̂ɉBĂȂ̂擪ɋl߂ĎcB
+	// ĉ͂̂܂܎ՕƂďށB߂l͎c
+	size_t CullFrontToBack(const Frustum& frustum, const AabbSoA& aabbs, uint32_t* indices, size_t count);
+
+private:
+	struct ScreenRect
+	{
+		int left, top, right, bottom;
+		// قǑ傫Ȃ悤ɒ[x(reversedZ Ȃ畄𔽓])
+		float minDepth, maxDepth;
+	};
+
+	unsigned int m_width;
+	unsigned int m_height;
+	bool m_reversedZ;
+	std::vector<float> m_depth;
+
+	// inner ȂA`ɊSɓsNZɂ(ՕhƂ)B
+	// łȂ΁AłsNZׂĊ܂߂(肷Ƃ)
+	bool ProjectAabb(
+		const Frustum& frustum,
+		const Float3& center,
+		const Float3& extent,
+		bool inner,
+		ScreenRect& rect
+	) const;
+};
+
+// CullAabbs Ŏg߃ZbgBAuto Ȃ CPU ΉĂ邤ňԕ̍L
+enum class CullingInstructionSet {
+	Auto,
+	Scalar,
+	Sse2,
+	Avx2,
+};
+
+//  CPU ƃrh instructionSet g邩
+bool IsCullingInstructionSetSupported(CullingInstructionSet instructionSet);
+
+// (ƔCӂŃIN[Wobt@[) AABB QJOA
+// Ă̂̃CfbNX visibleIndices ɋl߂ďށB
+// visibleIndices  aabbs.Size() ̗̈悪KvB߂l͏񂾌
+size_t CullAabbs(
+	const Frustum& frustum,
+	const AabbSoA& aabbs,
+	uint32_t* visibleIndices,
+	const OcclusionBuffer* occlusionBuffer = nullptr,
+	CullingInstructionSet instructionSet = CullingInstructionSet::Auto
+);
+}
+}
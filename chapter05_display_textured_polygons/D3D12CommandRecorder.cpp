@@ -0,0 +1,439 @@
+#include "D3D12CommandRecorder.h"
+
+#include <cstring>
+#include <d3dx12.h>
+
+#include "Helpers.h"
+#include "TextureCopy.h"
+
+using Microsoft::WRL::ComPtr;
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+D3D12_BLEND_DESC MakeBlendDesc(uint32_t blendMode)
+{
+	D3D12_BLEND_DESC blendDesc = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
+	if (blendMode == kBlendPremultipliedAlpha) {
+		// F͕`O a |Ă̂ŁA` (1 - a) |đ
+		D3D12_RENDER_TARGET_BLEND_DESC& renderTarget = blendDesc.RenderTarget[0];
+		renderTarget.BlendEnable = true;
+		renderTarget.SrcBlend = D3D12_BLEND_ONE;
+		renderTarget.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+		renderTarget.BlendOp = D3D12_BLEND_OP_ADD;
+		renderTarget.SrcBlendAlpha = D3D12_BLEND_ONE;
+		renderTarget.DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+		renderTarget.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	} else if (blendMode == kBlendColorWriteDisabled) {
+		blendDesc.RenderTarget[0].RenderTargetWriteMask = 0;
+	}
+	return blendDesc;
+}
+
+D3D12_DEPTH_STENCIL_DESC MakeDepthStencilDesc(uint32_t depthMode)
+{
+	D3D12_DEPTH_STENCIL_DESC depthStencilDesc = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+	switch (depthMode)
+	{
+	case kDepthWrite:
+		depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_GREATER;
+		break;
+
+	case kDepthTestOnly:
+		depthStencilDesc.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
+		depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_GREATER_EQUAL;
+		break;
+
+	default:
+		depthStencilDesc.DepthEnable = false;
+		break;
+	}
+	return depthStencilDesc;
+}
+
+bool D3D12CommandRecorder::Initialize(ID3D12Device* device, UINT maxTextureCount)
+{
+	m_device = device;
+	m_descriptors.Reset(maxTextureCount);
+	if (maxTextureCount == 0) {
+		return true;
+	}
+
+	D3D12_DESCRIPTOR_HEAP_DESC heapDesc{};
+	heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+	heapDesc.NumDescriptors = maxTextureCount;
+	heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+	HRESULT result = m_device->CreateDescriptorHeap(
+		&heapDesc,
+		IID_PPV_ARGS(m_descriptorHeap.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateDescriptorHeap Error (for recorder): 0x%x\n", result);
+		return false;
+	}
+	m_descriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	return true;
+}
+
+void D3D12CommandRecorder::RegisterBuffer(RecorderObjectId id, ID3D12Resource* buffer)
+{
+	m_buffers[id] = buffer;
+	m_registered.insert(id);
+}
+
+void D3D12CommandRecorder::RegisterTexture(
+	RecorderObjectId id,
+	ID3D12Resource* texture,
+	ID3D12DescriptorHeap* heap,
+	D3D12_GPU_DESCRIPTOR_HANDLE srv
+) {
+	m_textures[id] = { texture, heap, srv };
+	m_registered.insert(id);
+}
+
+void D3D12CommandRecorder::RegisterRootSignature(RecorderObjectId id, ID3D12RootSignature* rootSignature)
+{
+	m_rootSignatures[id] = rootSignature;
+	m_registered.insert(id);
+}
+
+void D3D12CommandRecorder::RegisterPipelineState(RecorderObjectId id, ID3D12PipelineState* pipelineState)
+{
+	m_pipelineStates[id] = pipelineState;
+	m_registered.insert(id);
+}
+
+bool D3D12CommandRecorder::CreateCommittedBuffer(
+	D3D12_HEAP_TYPE heapType,
+	uint64_t size,
+	ComPtr<ID3D12Resource>& buffer
+) const {
+	const CD3DX12_HEAP_PROPERTIES heapProperties(heapType);
+	const CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	HRESULT result = m_device->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(buffer.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommittedResource Error (for recorder buffer): 0x%x\n", result);
+		return false;
+	}
+	return true;
+}
+
+bool D3D12CommandRecorder::CreateBuffer(RecorderObjectId id, uint64_t size)
+{
+	if (m_registered.count(id) != 0) {
+		return true;
+	}
+	// _ECfbNX DirectXManager ƓAbv[hq[vɒuAMap ŏ
+	return CreateCommittedBuffer(D3D12_HEAP_TYPE_UPLOAD, size, m_buffers[id]);
+}
+
+bool D3D12CommandRecorder::CreateTexture(RecorderObjectId id, const RecorderTextureDescription& description)
+{
+	if (m_registered.count(id) != 0) {
+		return true;
+	}
+	const uint32_t descriptorIndex = m_descriptors.Allocate();
+	if (descriptorIndex == DescriptorAllocator::kInvalidIndex) {
+		DebugOutputFormatString("Recorder texture heap is full.\n");
+		return false;
+	}
+
+	const DXGI_FORMAT format = static_cast<DXGI_FORMAT>(description.format);
+	const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	const CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Tex2D(
+		format,
+		description.width,
+		description.height,
+		1,
+		1
+	);
+	Texture texture{};
+	HRESULT result = m_device->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDesc,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(texture.resource.GetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommittedResource Error (for recorder texture): 0x%x\n", result);
+		m_descriptors.Free(descriptorIndex);
+		return false;
+	}
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Format = format;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Texture2D.MipLevels = 1;
+	const CD3DX12_CPU_DESCRIPTOR_HANDLE cpuHandle(
+		m_descriptorHeap->GetCPUDescriptorHandleForHeapStart(),
+		descriptorIndex,
+		m_descriptorSize
+	);
+	m_device->CreateShaderResourceView(texture.resource.Get(), &srvDesc, cpuHandle);
+
+	texture.heap = m_descriptorHeap;
+	texture.srv = CD3DX12_GPU_DESCRIPTOR_HANDLE(
+		m_descriptorHeap->GetGPUDescriptorHandleForHeapStart(),
+		descriptorIndex,
+		m_descriptorSize
+	);
+	m_textures[id] = texture;
+	return true;
+}
+
+bool D3D12CommandRecorder::UploadResource(RecorderObjectId id, const void* data, size_t size, uint32_t rowPitch)
+{
+	if (m_registered.count(id) != 0) {
+		return true;
+	}
+
+	const auto buffer = m_buffers.find(id);
+	if (buffer != m_buffers.end()) {
+		if (size > buffer->second->GetDesc().Width) {
+			DebugOutputFormatString("Recorder upload is larger than the buffer.\n");
+			return false;
+		}
+		void* map = nullptr;
+		HRESULT result = buffer->second->Map(0, nullptr, &map);
+		if (FAILED(result)) {
+			DebugOutputFormatString("Recorder buffer map Error : 0x%x\n", result);
+			return false;
+		}
+		std::memcpy(map, data, size);
+		buffer->second->Unmap(0, nullptr);
+		return true;
+	}
+
+	const auto texture = m_textures.find(id);
+	if (texture == m_textures.end()) {
+		DebugOutputFormatString("Recorder upload to unknown object : %u\n", id);
+		return false;
+	}
+
+	const D3D12_RESOURCE_DESC resourceDesc = texture->second.resource->GetDesc();
+	D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint{};
+	UINT rowCount = 0;
+	UINT64 rowSize = 0;
+	UINT64 uploadSize = 0;
+	m_device->GetCopyableFootprints(&resourceDesc, 0, 1, 0, &footprint, &rowCount, &rowSize, &uploadSize);
+	if (rowPitch < rowSize || size < static_cast<size_t>(rowPitch) * rowCount) {
+		DebugOutputFormatString("Recorder texture upload is too small.\n");
+		return false;
+	}
+
+	ComPtr<ID3D12Resource> uploadBuffer;
+	if (!CreateCommittedBuffer(D3D12_HEAP_TYPE_UPLOAD, uploadSize, uploadBuffer)) {
+		return false;
+	}
+	uint8_t* map = nullptr;
+	HRESULT result = uploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&map));
+	if (FAILED(result)) {
+		DebugOutputFormatString("Recorder upload buffer map Error : 0x%x\n", result);
+		return false;
+	}
+	// Lv`̍ssb`tbgvg̍ssb`ɋlߑւ
+	CopyRows(
+		map + footprint.Offset,
+		footprint.Footprint.RowPitch,
+		static_cast<const uint8_t*>(data),
+		rowPitch,
+		static_cast<size_t>(rowSize),
+		rowCount
+	);
+	uploadBuffer->Unmap(0, nullptr);
+
+	const CD3DX12_TEXTURE_COPY_LOCATION destination(texture->second.resource.Get(), 0);
+	const CD3DX12_TEXTURE_COPY_LOCATION sourceLocation(uploadBuffer.Get(), footprint);
+	m_commandList->CopyTextureRegion(&destination, 0, 0, 0, &sourceLocation, nullptr);
+	const CD3DX12_RESOURCE_BARRIER barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+		texture->second.resource.Get(),
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
+	);
+	m_commandList->ResourceBarrier(1, &barrier);
+	m_uploadBuffers.push_back(uploadBuffer);
+	return true;
+}
+
+bool D3D12CommandRecorder::CreateRootSignature(RecorderObjectId id, const void* serialized, size_t size)
+{
+	if (m_registered.count(id) != 0) {
+		return true;
+	}
+	HRESULT result = m_device->CreateRootSignature(
+		0,
+		serialized,
+		size,
+		IID_PPV_ARGS(m_rootSignatures[id].ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateRootSignature Error (for recorder): 0x%x\n", result);
+		return false;
+	}
+	return true;
+}
+
+bool D3D12CommandRecorder::CreatePipelineState(RecorderObjectId id, const RecorderPipelineDescription& description)
+{
+	if (m_registered.count(id) != 0) {
+		return true;
+	}
+	const auto rootSignature = m_rootSignatures.find(description.rootSignature);
+	if (rootSignature == m_rootSignatures.end()) {
+		DebugOutputFormatString("Recorder pipeline uses unknown root signature : %u\n", description.rootSignature);
+		return false;
+	}
+
+	std::vector<D3D12_INPUT_ELEMENT_DESC> inputLayout;
+	for (const RecorderInputElement& element : description.inputLayout) {
+		inputLayout.push_back({
+			element.semanticName.c_str(),
+			element.semanticIndex,
+			static_cast<DXGI_FORMAT>(element.format),
+			0,
+			D3D12_APPEND_ALIGNED_ELEMENT,
+			D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
+			0
+		});
+	}
+
+	// Œ̐ݒ DirectXManager::SetupGraphicsPipeline Ɠ
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc{};
+	pipelineDesc.pRootSignature = rootSignature->second.Get();
+	pipelineDesc.VS.pShaderBytecode = description.vertexShader.data();
+	pipelineDesc.VS.BytecodeLength = description.vertexShader.size();
+	pipelineDesc.PS.pShaderBytecode = description.pixelShader.data();
+	pipelineDesc.PS.BytecodeLength = description.pixelShader.size();
+	pipelineDesc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	pipelineDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	pipelineDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	pipelineDesc.BlendState = MakeBlendDesc(description.blendMode);
+	pipelineDesc.DepthStencilState = MakeDepthStencilDesc(description.depthMode);
+	pipelineDesc.DSVFormat = static_cast<DXGI_FORMAT>(description.depthStencilFormat);
+	pipelineDesc.InputLayout.pInputElementDescs = inputLayout.data();
+	pipelineDesc.InputLayout.NumElements = static_cast<UINT>(inputLayout.size());
+	pipelineDesc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+	pipelineDesc.PrimitiveTopologyType = static_cast<D3D12_PRIMITIVE_TOPOLOGY_TYPE>(description.primitiveTopologyType);
+	pipelineDesc.NumRenderTargets = 1;
+	pipelineDesc.RTVFormats[0] = static_cast<DXGI_FORMAT>(description.renderTargetFormat);
+	pipelineDesc.SampleDesc.Count = 1;
+
+	HRESULT result = m_device->CreateGraphicsPipelineState(
+		&pipelineDesc,
+		IID_PPV_ARGS(m_pipelineStates[id].ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateGraphicsPipelineState Error (for recorder): 0x%x\n", result);
+		return false;
+	}
+	return true;
+}
+
+void D3D12CommandRecorder::BeginFrame()
+{
+	m_currentHeap = nullptr;
+	m_commandList->OMSetRenderTargets(1, &m_renderTarget, true, m_depthStencil.ptr != 0 ? &m_depthStencil : nullptr);
+}
+
+void D3D12CommandRecorder::ClearRenderTarget(const float color[4])
+{
+	m_commandList->ClearRenderTargetView(m_renderTarget, color, 0, nullptr);
+}
+
+void D3D12CommandRecorder::ClearDepth(float depth)
+{
+	if (m_depthStencil.ptr != 0) {
+		m_commandList->ClearDepthStencilView(m_depthStencil, D3D12_CLEAR_FLAG_DEPTH, depth, 0, 0, nullptr);
+	}
+}
+
+void D3D12CommandRecorder::SetPipelineState(RecorderObjectId pipelineState)
+{
+	m_commandList->SetPipelineState(m_pipelineStates[pipelineState].Get());
+}
+
+void D3D12CommandRecorder::SetGraphicsRootSignature(RecorderObjectId rootSignature)
+{
+	m_commandList->SetGraphicsRootSignature(m_rootSignatures[rootSignature].Get());
+}
+
+void D3D12CommandRecorder::SetViewport(const RecorderViewport& viewport)
+{
+	const D3D12_VIEWPORT d3d12Viewport = {
+		viewport.topLeftX,
+		viewport.topLeftY,
+		viewport.width,
+		viewport.height,
+		viewport.minDepth,
+		viewport.maxDepth
+	};
+	m_commandList->RSSetViewports(1, &d3d12Viewport);
+}
+
+void D3D12CommandRecorder::SetScissorRect(const RecorderRect& rect)
+{
+	const D3D12_RECT d3d12Rect = { rect.left, rect.top, rect.right, rect.bottom };
+	m_commandList->RSSetScissorRects(1, &d3d12Rect);
+}
+
+void D3D12CommandRecorder::SetGraphicsRootTexture(uint32_t rootParameterIndex, RecorderObjectId texture)
+{
+	const Texture& found = m_textures[texture];
+	if (found.heap.Get() != m_currentHeap) {
+		ID3D12DescriptorHeap* heaps[] = { found.heap.Get() };
+		m_commandList->SetDescriptorHeaps(1, heaps);
+		m_currentHeap = found.heap.Get();
+	}
+	m_commandList->SetGraphicsRootDescriptorTable(rootParameterIndex, found.srv);
+}
+
+void D3D12CommandRecorder::SetPrimitiveTopology(uint32_t topology)
+{
+	m_commandList->IASetPrimitiveTopology(static_cast<D3D12_PRIMITIVE_TOPOLOGY>(topology));
+}
+
+void D3D12CommandRecorder::SetVertexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t stride)
+{
+	D3D12_VERTEX_BUFFER_VIEW view{};
+	view.BufferLocation = m_buffers[buffer]->GetGPUVirtualAddress();
+	view.SizeInBytes = size;
+	view.StrideInBytes = stride;
+	m_commandList->IASetVertexBuffers(0, 1, &view);
+}
+
+void D3D12CommandRecorder::SetIndexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t format)
+{
+	D3D12_INDEX_BUFFER_VIEW view{};
+	view.BufferLocation = m_buffers[buffer]->GetGPUVirtualAddress();
+	view.SizeInBytes = size;
+	view.Format = static_cast<DXGI_FORMAT>(format);
+	m_commandList->IASetIndexBuffer(&view);
+}
+
+void D3D12CommandRecorder::DrawIndexedInstanced(
+	uint32_t indexCountPerInstance,
+	uint32_t instanceCount,
+	uint32_t startIndexLocation,
+	int32_t baseVertexLocation,
+	uint32_t startInstanceLocation
+) {
+	m_commandList->DrawIndexedInstanced(
+		indexCountPerInstance,
+		instanceCount,
+		startIndexLocation,
+		baseVertexLocation,
+		startInstanceLocation
+	);
+}
+}
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl.h>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "CommandRecorder.h"
+#include "DescriptorAllocator.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// RecorderBlendMode ̏d˕ɂ BlendStateBDirectXManager ̃pCvCƃLv`̍Đœ̂g
+D3D12_BLEND_DESC MakeBlendDesc(uint32_t blendMode);
+// RecorderDepthMode ̎gɂ DepthStencilState(reversed-Z Ȃ̂Ŕr GREATER )
+D3D12_DEPTH_STENCIL_DESC MakeDepthStencilDesc(uint32_t depthMode);
+
+// CommandRecorder ̌Ăяo D3D12 ̃R}hXgɋL^B
+// DirectXManager ōIuWFNg Register* ŔԍtēnB͍쐬ς݁EAbv[hς݂ƂĈA
+// ԍ Create*  UploadResource ͉Ȃ(Lv`Ȃ`悵ĂdɍȂ)B
+// Lv`̍Đł Initialize Ă Create* ō
+class D3D12CommandRecorder : public CommandRecorder
+{
+public:
+	// Create* gƂKvBmaxTextureCount  CreateTexture ō SRV ̐
+	bool Initialize(ID3D12Device* device, UINT maxTextureCount);
+	void SetCommandList(ID3D12GraphicsCommandList* commandList) { m_commandList = commandList; }
+	// BeginFrame Őݒ肷`
+	void SetRenderTarget(D3D12_CPU_DESCRIPTOR_HANDLE renderTarget) { m_renderTarget = renderTarget; }
+	// BeginFrame Őݒ肷[xobt@[Bptr  0 Ȃ[xobt@[Ȃŕ`
+	void SetDepthStencil(D3D12_CPU_DESCRIPTOR_HANDLE depthStencil) { m_depthStencil = depthStencil; }
+
+	void RegisterBuffer(RecorderObjectId id, ID3D12Resource* buffer);
+	// srv  heap(VF[_[猩q[v)̒̈ʒu
+	void RegisterTexture(
+		RecorderObjectId id,
+		ID3D12Resource* texture,
+		ID3D12DescriptorHeap* heap,
+		D3D12_GPU_DESCRIPTOR_HANDLE srv
+	);
+	void RegisterRootSignature(RecorderObjectId id, ID3D12RootSignature* rootSignature);
+	void RegisterPipelineState(RecorderObjectId id, ID3D12PipelineState* pipelineState);
+
+	bool CreateBuffer(RecorderObjectId id, uint64_t size) override;
+	bool CreateTexture(RecorderObjectId id, const RecorderTextureDescription& description) override;
+	// eNX`ւ̃Rs[̓R}hXgɋL^̂ŁA`OɌĂԂ
+	bool UploadResource(RecorderObjectId id, const void* data, size_t size, uint32_t rowPitch) override;
+	bool CreateRootSignature(RecorderObjectId id, const void* serialized, size_t size) override;
+	bool CreatePipelineState(RecorderObjectId id, const RecorderPipelineDescription& description) override;
+
+	void BeginFrame() override;
+	void ClearRenderTarget(const float color[4]) override;
+	void ClearDepth(float depth) override;
+	void SetPipelineState(RecorderObjectId pipelineState) override;
+	void SetGraphicsRootSignature(RecorderObjectId rootSignature) override;
+	void SetViewport(const RecorderViewport& viewport) override;
+	void SetScissorRect(const RecorderRect& rect) override;
+	void SetGraphicsRootTexture(uint32_t rootParameterIndex, RecorderObjectId texture) override;
+	void SetPrimitiveTopology(uint32_t topology) override;
+	void SetVertexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t stride) override;
+	void SetIndexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t format) override;
+	void DrawIndexedInstanced(
+		uint32_t indexCountPerInstance,
+		uint32_t instanceCount,
+		uint32_t startIndexLocation,
+		int32_t baseVertexLocation,
+		uint32_t startInstanceLocation
+	) override;
+	// R}hXg̂͌Ăяo
+	void EndFrame() override {}
+
+private:
+	struct Texture
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> heap;
+		D3D12_GPU_DESCRIPTOR_HANDLE srv;
+	};
+
+	Microsoft::WRL::ComPtr<ID3D12Device> m_device;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> m_commandList;
+	D3D12_CPU_DESCRIPTOR_HANDLE m_renderTarget{};
+	D3D12_CPU_DESCRIPTOR_HANDLE m_depthStencil{};
+
+	std::map<RecorderObjectId, Microsoft::WRL::ComPtr<ID3D12Resource>> m_buffers;
+	std::map<RecorderObjectId, Texture> m_textures;
+	std::map<RecorderObjectId, Microsoft::WRL::ComPtr<ID3D12RootSignature>> m_rootSignatures;
+	std::map<RecorderObjectId, Microsoft::WRL::ComPtr<ID3D12PipelineState>> m_pipelineStates;
+	// Register* œnꂽ
+	std::set<RecorderObjectId> m_registered;
+
+	// CreateTexture ō SRV ׂq[v
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_descriptorHeap;
+	UINT m_descriptorSize = 0;
+	DescriptorAllocator m_descriptors;
+	// ݒ蒆̃q[vBςƂ SetDescriptorHeaps Ă
+	ID3D12DescriptorHeap* m_currentHeap = nullptr;
+	// eNX`ւ̃Rs[I܂ŎcĂԃobt@[(ĐI܂Ŏ)
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> m_uploadBuffers;
+
+	bool CreateCommittedBuffer(
+		D3D12_HEAP_TYPE heapType,
+		uint64_t size,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& buffer
+	) const;
+};
+}
+}
@@ -0,0 +1,80 @@
+#include "DescriptorAllocator.h"
+
+#include <iterator>
+
+namespace yuxx {
+namespace DirectX12 {
+DescriptorAllocator::DescriptorAllocator(uint32_t capacity)
+{
+	Reset(capacity);
+}
+
+void DescriptorAllocator::Reset(uint32_t capacity)
+{
+	m_capacity = capacity;
+	m_freeCount = 0;
+	m_freeByFirst.clear();
+	m_freeBySize.clear();
+	if (capacity > 0) {
+		AddFreeRange(0, capacity);
+	}
+}
+
+uint32_t DescriptorAllocator::Allocate(uint32_t count)
+{
+	if (count == 0) {
+		return kInvalidIndex;
+	}
+	const auto fit = m_freeBySize.lower_bound(std::make_pair(count, 0u));
+	if (fit == m_freeBySize.end()) {
+		return kInvalidIndex;
+	}
+	const uint32_t first = fit->second;
+	const uint32_t rangeCount = fit->first;
+	RemoveFreeRange(m_freeByFirst.find(first));
+	// c͌둤̋󂫂ƂĖ߂
+	if (rangeCount > count) {
+		AddFreeRange(first + count, rangeCount - count);
+	}
+	return first;
+}
+
+void DescriptorAllocator::Free(uint32_t first, uint32_t count)
+{
+	if (count == 0) {
+		return;
+	}
+	uint32_t joinedFirst = first;
+	uint32_t joinedCount = count;
+	// first ɂŏ̋󂫂ƁA1Ő
+	const auto next = m_freeByFirst.lower_bound(first);
+	if (next != m_freeByFirst.begin()) {
+		const auto previous = std::prev(next);
+		if (previous->first + previous->second == first) {
+			joinedFirst = previous->first;
+			joinedCount += previous->second;
+			RemoveFreeRange(previous);
+		}
+	}
+	if (next != m_freeByFirst.end() && first + count == next->first) {
+		joinedCount += next->second;
+		RemoveFreeRange(next);
+	}
+	AddFreeRange(joinedFirst, joinedCount);
+}
+
+void DescriptorAllocator::AddFreeRange(uint32_t first, uint32_t count)
+{
+	m_freeByFirst.emplace(first, count);
+	m_freeBySize.emplace(count, first);
+	m_freeCount += count;
+}
+
+void DescriptorAllocator::RemoveFreeRange(std::map<uint32_t, uint32_t>::iterator range)
+{
+	m_freeCount -= range->second;
+	m_freeBySize.erase(std::make_pair(range->second, range->first));
+	m_freeByFirst.erase(range);
+}
+}
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace yuxx {
+namespace DirectX12 {
+// fBXNv^q[v̒̈ʒu(擪̔ԍ)zBD3D12 ɂ͈ˑȂ
+// (q[v̍쐬ƁAԍnh߂̂͌Ăяo)B
+// A count A܂钆ōł(傫Ȃ擪ɋ߂)؂oB
+// Free Ŗ߂ׂ͈͂͗̋󂫂ƂȂBǂ󂫂̐ log ōς
+class DescriptorAllocator
+{
+public:
+	static constexpr uint32_t kInvalidIndex = 0xFFFFFFFF;
+
+	explicit DescriptorAllocator(uint32_t capacity = 0);
+
+	// 蒼Bẑׂ͂ċ󂫂ɖ߂
+	void Reset(uint32_t capacity);
+	// A count ̐擪̔ԍB󂫂Ȃ kInvalidIndex
+	uint32_t Allocate(uint32_t count = 1);
+	// Allocate Ŏ󂯎͈͂߂
+	void Free(uint32_t first, uint32_t count = 1);
+
+	uint32_t Capacity() const { return m_capacity; }
+	uint32_t FreeCount() const { return m_freeCount; }
+	// 󂫂ɕĂ邩
+	size_t FreeRangeCount() const { return m_freeByFirst.size(); }
+
+private:
+	uint32_t m_capacity = 0;
+	uint32_t m_freeCount = 0;
+	// 󂫂͈̔͂擪̔ԍ(first  count)ƁA傫̏ɕׂ(count, first)B
+	// ׂ荇󂫂͂ȂĂ
+	std::map<uint32_t, uint32_t> m_freeByFirst;
+	std::set<std::pair<uint32_t, uint32_t>> m_freeBySize;
+
+	void AddFreeRange(uint32_t first, uint32_t count);
+	void RemoveFreeRange(std::map<uint32_t, uint32_t>::iterator range);
+};
+}
+}
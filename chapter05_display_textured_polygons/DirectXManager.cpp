@@ -1,124 +1,291 @@
 #include "DirectXManager.h"
 
+#include <algorithm>
+#include <cstring>
 #include <d3d12sdklayers.h>
 #include <d3dcompiler.h>
 #include <tchar.h>
 #include <iostream>
+#include <memory>
+#include <vector>
 #include <d3dx12.h>
 
+#include "FrameCapture.h"
 #include "Helpers.h"
-
-#pragma comment(lib, "d3d12.lib")
-#pragma comment(lib, "dxgi.lib")
-#pragma comment(lib, "d3dcompiler.lib")
-#pragma comment(lib, "DirectXTex.lib")
+#include "NullCommandRecorder.h"
+#include "PostProcess.h"
+#include "RootSignatureBuilder.h"
+#include "ShaderBindings.h"
+#include "ShaderCache.h"
+#include "StartupTaskGraph.h"
+#include "TextureConversion.h"
+#include "TileStreaming.h"
 
 using namespace yuxx::Debug;
 using namespace DirectX;
 
 namespace yuxx {
 namespace DirectX12 {
-LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam)
-{
-	DirectXManager* self = nullptr;
-	if (msg == WM_NCCREATE) {
-		CREATESTRUCT* pcs = reinterpret_cast<CREATESTRUCT*>(lparam);
-		self = static_cast<DirectXManager*>(pcs->lpCreateParams);
-		SetWindowLongPtr(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(self));
+namespace {
+	constexpr wchar_t kVertexShaderPath[] = L"BasicVertexShader.hlsl";
+	constexpr wchar_t kPixelShaderPath[] = L"BasicPixelShader.hlsl";
+	constexpr wchar_t kPostProcessShaderPath[] = L"PostProcess.hlsl";
+	constexpr wchar_t kTextureConversionShaderPath[] = L"TextureConversion.hlsl";
+	constexpr char kAdapterCachePath[] = "adapter_cache.bin";
+	constexpr wchar_t kTexturePath[] = L"img/͌̋C.jpg";
+	// constexpr wchar_t kTexturePath[] = L"img/eBt@.jpg";
+	// ̎lp`ɓ\(At@̂ PNG)
+	constexpr wchar_t kTransparentTexturePath[] = L"img/be_logo.png";
+
+	// D3DCompileFromFile ɓntOBLbṼL[ɂ܂߂
+	constexpr UINT kShaderCompileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+
+	// m_recorder ƃLv`ŃIuWFNgwԍ
+	enum RecorderObject : RecorderObjectId {
+		kRecorderVertexBuffer = 1,
+		kRecorderIndexBuffer,
+		kRecorderTexture,
+		kRecorderRootSignature,
+		kRecorderPipelineState,
+		kRecorderTransparentTexture,
+		kRecorderTransparentPipelineState,
+		kRecorderDepthPrePassPipelineState,
+	};
+	// m_textureDescriptionHeap ̒̔̃eNX` SRV ̈ʒu(^CœǂݍނƂ͎gȂ)
+	constexpr UINT kTransparentTextureDescriptor = 1;
+	constexpr UINT kTextureDescriptorCount = 2;
+	// lp`1̒_̐ƁAkDemoSceneVertices ̐擪牽s
+	constexpr INT kQuadVertexCount = 4;
+	constexpr INT kDemoSceneOpaqueQuadCount = 2;
+
+	// IN[WJÕ\tgEFA[xobt@[̑傫
+	constexpr unsigned int kOcclusionBufferWidth = 256;
+	constexpr unsigned int kOcclusionBufferHeight = 144;
+
+	// reversed-Z ł͉ق 0 ɋ߂Â̂ŁAfloat ̐x܂Ŏc
+	constexpr DXGI_FORMAT kDepthFormat = DXGI_FORMAT_D32_FLOAT;
+	// reversed-Z ̈ԉ
+	constexpr float kDepthClearValue = 0.0f;
+
+	// AABB ̒ŚAˉeƂ̐[x
+	float ProjectedDepth(const AabbSoA& bounds, uint32_t index, const Float4x4& viewProjection)
+	{
+		const Float4 center = TransformPoint(
+			{ bounds.centerX[index], bounds.centerY[index], bounds.centerZ[index] },
+			viewProjection
+		);
+		return center.z / center.w;
 	}
-	switch (msg)
+
+	// Lv`ɂ̓t@C RGBA e8bit ŃfR[ĥ̂ŁAtH[}bgɍ킹
+	DXGI_FORMAT CaptureFormat(DXGI_FORMAT textureFormat)
 	{
-	case WM_DESTROY:
-		PostQuitMessage(0);
-		return 0;
+		return textureFormat == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ? textureFormat : DXGI_FORMAT_R8G8B8A8_UNORM;
+	}
+	// a |Ƃ CPU ւ܂Ƃ߂ăfR[hs
+	constexpr uint32_t kPremultiplyStripRows = 32;
 
-	default:
-		return DefWindowProc(hwnd, msg, wparam, lparam);
+	// image  destination  rowPitch ԊuŃfR[hARGB  a |B
+	// destination ̓}bvAbv[hobt@[(CgRoC)Ȃ̂ŁAǂݕԂƔɒxB
+	// s CPU ̍Ɨ̈ɃfR[hĊ|ĂAނɂ
+	bool DecodePremultiplied(const ImageSource& image, uint8_t* destination, size_t rowPitch)
+	{
+		// OpenTexture  R8G8B8A8(_SRGB) R16G16B16A16 ɂ̂ŁAǂ RGBA ̕т̂܂ a |
+		const auto premultiplyPixels = image.Format() == DXGI_FORMAT_R16G16B16A16_UNORM ? PremultiplyRgba16 : PremultiplyRgba8;
+		const size_t rowSize = static_cast<size_t>(image.Width()) * image.BytesPerPixel();
+		std::vector<uint8_t> strip(rowSize * (std::min)(kPremultiplyStripRows, image.Height()));
+		for (uint32_t y = 0; y < image.Height(); y += kPremultiplyStripRows) {
+			const uint32_t rows = (std::min)(kPremultiplyStripRows, image.Height() - y);
+			if (!image.CopyPixels(0, y, image.Width(), rows, strip.data(), rowSize, strip.size())) {
+				return false;
+			}
+			premultiplyPixels(strip.data(), image.Width(), rows, rowSize);
+			for (uint32_t row = 0; row < rows; ++row) {
+				std::memcpy(destination + (y + row) * rowPitch, strip.data() + row * rowSize, rowSize);
+			}
+		}
+		return true;
 	}
+
+	constexpr char kFrameCapturePath[] = "frame.capture";
+	// ̃t[Ƃ GPU Ԃƃt[A[i̎gpʂo͂
+	constexpr uint64_t kFrameStatsInterval = 300;
+	// eNX`^CœǂݍނƂ̃Xbg(64KB x 1024 = 64MB)ƁA1t[œǂݍސ
+	constexpr TileStreamer::Settings kTileStreamingSettings = { 1024, 16 };
+
+	// zbg[hŊĎAZbg
+	enum HotReloadAsset : HotReloader::AssetId {
+		kVertexShaderAsset,
+		kPixelShaderAsset,
+		kTextureAsset,
+		kTransparentTextureAsset,
+	};
 }
 
-DirectXManager::DirectXManager() = default;
+DirectXManager::DirectXManager() :
+	m_occlusionBuffer(kOcclusionBufferWidth, kOcclusionBufferHeight, true)
+{
+}
 
 DirectXManager::~DirectXManager()
 {
-	UnregisterClass(m_windowClass.lpszClassName, m_windowClass.hInstance);
+	StopRenderThread();
+	// Note: ς񂾃t[ GPU ɎcĂ邤ɁA^[QbgobNobt@[Ȃ悤ɂB
+	// L[͕`ERs[gERs[̏ɍ̂ŁARs[̃L[ΑS
+	if (m_queues.Copy().Get() != nullptr) {
+		m_queues.FlushAll();
+	}
 }
 
-bool DirectXManager::Initialize(HINSTANCE hInstance, int width, int height)
+void DirectXManager::EnableTextureStreaming()
 {
-#ifdef _DEBUG
-	if (! DirectXManager::EnableDebugLayer()) {
-		return false;
-	}
-#endif // _DEBUG
-	if (!MakeWindow(hInstance, width, height)) {
-		return false;
-	}
+	m_textureStreaming = true;
+}
 
-#ifdef _DEBUG
-	const UINT factoryFlag = DXGI_CREATE_FACTORY_DEBUG;
-#else
-	const UINT factoryFlag = 0;
-#endif
+void DirectXManager::EnableGpuTextureConversion(uint32_t flags)
+{
+	m_gpuTextureConversion = true;
+	m_textureConversionFlags = flags;
+}
 
-	HRESULT result = CreateDXGIFactory2(factoryFlag, IID_PPV_ARGS(m_dxgiFactory.GetAddressOf()));
-	if (FAILED(result)) {
-		DebugOutputFormatString("CreateDXGIFactory2 Error : 0x%x\n", result);
-		return false;
-	}
-	if (!SelectAdapter()) {
-		DebugOutputFormatString("No suitable adapter found.\n");
-		return false;
-	}
-	if (!InitDirect3DDevice()) {
-		DebugOutputFormatString("InitDirect3DDevice failed.\n");
-		return false;
-	}
-	if (!InitCommandAllocatorAndCommandQueue()) {
-		DebugOutputFormatString("InitCommandAllocatorAndCommandQueue failed.\n");
-		return false;
-	}
-	if (!InitSwapChain()) {
-		DebugOutputFormatString("InitSwapChain failed.\n");
-		return false;
-	}
-	if (!InitRTV()) {
-		DebugOutputFormatString("InitRTV failed.\n");
-		return false;
-	}
-	if (!InitFence()) {
-		DebugOutputFormatString("InitFence failed.\n");
-		return false;
-	}
+void DirectXManager::EnableDepthPrePass()
+{
+	m_depthPrePass = true;
+}
 
-	if (!SetupVertexBuffer()) {
-		DebugOutputFormatString("SetupVertexBuffer failed.\n");
-		return false;
-	}
+void DirectXManager::EnableOcclusionCulling()
+{
+	m_occlusionCulling = true;
+}
 
-	if (!SetupShaders()) {
-		DebugOutputFormatString("SetupShaders failed.\n");
-		return false;
-	}
+void DirectXManager::EnableGpuDrivenRendering()
+{
+	m_gpuDrivenRendering = true;
+}
 
-	if (!SetupGraphicsPipeline()) {
-		DebugOutputFormatString("SetupGraphicsPipeline failed.\n");
-		return false;
+void DirectXManager::EnableDemoScene()
+{
+	m_vertices = kDemoSceneVertices;
+	m_vertexCount = _countof(kDemoSceneVertices);
+	m_opaqueQuadCount = kDemoSceneOpaqueQuadCount;
+}
+
+void DirectXManager::EnableFrameTimeRecording(const std::string& path)
+{
+	// {𓮂ƋL^𑜓xŕςĂ܂̂ŁAS𑜓xő
+	m_dynamicResolution = false;
+	m_frameTimeTrace.open(path, std::ios::trunc);
+	if (!m_frameTimeTrace) {
+		DebugOutputFormatString("Frame time trace open failed : %s\n", path.c_str());
+		return;
 	}
+	m_frameTimeTrace << "# S𑜓x({ 1)ł1t[ GPU (~b)\n";
+}
+
+bool DirectXManager::Initialize(HINSTANCE hInstance, int width, int height)
+{
+	// ˑ֌ŴȂXebv(VF[_[̃RpCƃfoCX쐬Ȃ)͕ɐi߂
+	StartupTaskGraph startup;
 
-	SetupViewportAndScissor(width, height);
+	// EBhEƃXbv`F[̓bZ[W󂯎Xbhō
+	const auto window = startup.Add("MakeWindow", [&]() {
+		return m_window.Create(hInstance, _T("DirectX12eXg"), width, height, this);
+	}, {}, true);
 
-	if (!LoadTexture()) {
-		DebugOutputFormatString("LoadTexture failed.\n");
-		return false;
+	const auto factory = startup.Add("CreateDXGIFactory2", [&]() {
+#ifdef _DEBUG
+		if (!DirectXManager::EnableDebugLayer()) {
+			return false;
+		}
+		const UINT factoryFlag = DXGI_CREATE_FACTORY_DEBUG;
+#else
+		const UINT factoryFlag = 0;
+#endif
+		HRESULT result = CreateDXGIFactory2(factoryFlag, IID_PPV_ARGS(m_dxgiFactory.GetAddressOf()));
+		if (FAILED(result)) {
+			DebugOutputFormatString("CreateDXGIFactory2 Error : 0x%x\n", result);
+			return false;
+		}
+		return true;
+	});
+	const auto adapter = startup.Add("SelectAdapter", [&]() {
+		if (!SelectAdapter()) {
+			DebugOutputFormatString("No suitable adapter found.\n");
+			return false;
+		}
+		return true;
+	}, { factory });
+	const auto device = startup.Add("InitDirect3DDevice", [&]() {
+		return InitDirect3DDevice();
+	}, { adapter });
+	const auto commandQueue = startup.Add("InitCommandAllocatorAndCommandQueue", [&]() {
+		return InitCommandAllocatorAndCommandQueue();
+	}, { device });
+	startup.Add("InitGpuTimer", [&]() {
+		return m_gpuTimer.Initialize(m_device.Get(), m_queues.Direct().Get(), kFramesInFlight);
+	}, { commandQueue });
+	const auto swapChain = startup.Add("InitSwapChain", [&]() {
+		return InitSwapChain();
+	}, { window, commandQueue }, true);
+	const auto rtv = startup.Add("InitRTV", [&]() {
+		return InitRTV();
+	}, { swapChain });
+	// [xobt@[̓obNobt@[̑傫Ă
+	startup.Add("CreateDepthBuffer", [&]() {
+		return CreateDepthBuffer(m_backBufferWidth, m_backBufferHeight);
+	}, { rtv });
+	// ԃeNX`̓obNobt@[Ɠ傫ɂ̂ŃXbv`F[҂
+	startup.Add("SetupPostProcess", [&]() {
+		return SetupPostProcess();
+	}, { swapChain });
+	const auto vertexBuffer = startup.Add("SetupVertexBuffer", [&]() {
+		if (!SetupVertexBuffer()) {
+			return false;
+		}
+		SetupDrawItems();
+		return true;
+	}, { device });
+
+	// VF[_[̃RpC̓foCXȂĂł
+	const auto shaders = startup.Add("SetupShaders", [&]() {
+		return SetupShaders();
+	});
+	startup.Add("SetupGraphicsPipeline", [&]() {
+		return SetupGraphicsPipeline();
+	}, { device, shaders });
+
+	if (m_gpuDrivenRendering) {
+		startup.Add("SetupIndirectDraw", [&]() {
+			return SetupIndirectDraw();
+		}, { device, vertexBuffer });
 	}
 
-	if (!MakeShaderResourceView()) {
-		DebugOutputFormatString("MakeShaderResourceView failed.\n");
+	// eNX`̓Xbv`F[҂ɓǂݍ߂B
+	// [J[Xbh CoInitializeEx ĂȂAmain  MTA Ă̂ WIC g
+	// GPU ŕϊƂ́Aϊ̃pCvCłĂǂݍ
+	const auto textureConverter = startup.Add("SetupTextureConverter", [&]() {
+		return !m_gpuTextureConversion || SetupTextureConverter();
+	}, { device });
+	const auto texture = startup.Add("LoadTexture", [&]() {
+		return LoadTexture();
+	}, { commandQueue, textureConverter });
+	startup.Add("MakeShaderResourceView", [&]() {
+		return MakeShaderResourceView();
+	}, { texture });
+
+	const bool succeeded = startup.Run(m_jobSystem);
+	startup.Report();
+	if (!succeeded) {
 		return false;
 	}
 
-	ShowWindow(m_hwnd, SW_SHOW);
+	m_recorder.SetCommandList(m_commandList.Get());
+	RegisterRecorderObjects();
+
+	SetupHotReload();
+
+	m_resizeDebouncer.Reset(m_backBufferWidth, m_backBufferHeight);
+	m_window.Show();
 
 	return true;
 }
@@ -137,38 +304,66 @@ bool DirectXManager::EnableDebugLayer()
 	return true;
 }
 
-bool DirectXManager::MakeWindow(HINSTANCE hInstance, int width, int height)
+bool DirectXManager::ProbeAdapter(IDXGIAdapter1* adapter, AdapterCapabilities& capabilities)
 {
-	DebugOutputFormatString("Show m_windowClass test.\n");
-	// WNDCLASSEX m_windowClass{};
-
-	m_windowClass.cbSize = sizeof(WNDCLASSEX);
-	m_windowClass.lpfnWndProc = WindowProcedure;
-	m_windowClass.lpszClassName = _T("DX12Sample");
-	m_windowClass.hInstance = hInstance;
-
-	RegisterClassEx(&m_windowClass);
-
-	m_windowRect = { 0, 0, width, height };
+	DXGI_ADAPTER_DESC1 adapterDesc{};
+	HRESULT result = adapter->GetDesc1(&adapterDesc);
+	if (FAILED(result)) {
+		DebugOutputFormatString("GetDesc1 Error : 0x%x\n", result);
+		return false;
+	}
+	capabilities.luid =
+		(static_cast<uint64_t>(adapterDesc.AdapterLuid.HighPart) << 32) | adapterDesc.AdapterLuid.LowPart;
+	capabilities.vendorId = adapterDesc.VendorId;
+	capabilities.deviceId = adapterDesc.DeviceId;
+	capabilities.dedicatedVideoMemory = adapterDesc.DedicatedVideoMemory;
+	capabilities.isSoftware = (adapterDesc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE) != 0;
+	capabilities.description = adapterDesc.Description;
+
+	// ׂ邽߂̈ꎞIȃfoCX
+	ComPtr<ID3D12Device> device;
+	result = D3D12CreateDevice(adapter, D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(device.GetAddressOf()));
+	if (FAILED(result)) {
+		return false;
+	}
 
-	AdjustWindowRect(&m_windowRect, WS_OVERLAPPEDWINDOW, false);
+	const D3D_FEATURE_LEVEL featureLevels[] = {
+		D3D_FEATURE_LEVEL_12_2,
+		D3D_FEATURE_LEVEL_12_1,
+		D3D_FEATURE_LEVEL_12_0,
+		D3D_FEATURE_LEVEL_11_1,
+		D3D_FEATURE_LEVEL_11_0
+	};
+	D3D12_FEATURE_DATA_FEATURE_LEVELS featureLevelData{};
+	featureLevelData.NumFeatureLevels = _countof(featureLevels);
+	featureLevelData.pFeatureLevelsRequested = featureLevels;
+	capabilities.featureLevel = SUCCEEDED(device->CheckFeatureSupport(
+		D3D12_FEATURE_FEATURE_LEVELS,
+		&featureLevelData,
+		sizeof(featureLevelData)
+	)) ? featureLevelData.MaxSupportedFeatureLevel : D3D_FEATURE_LEVEL_11_0;
+
+	D3D12_FEATURE_DATA_D3D12_OPTIONS options{};
+	if (SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options)))) {
+		capabilities.resourceBindingTier = options.ResourceBindingTier;
+	}
 
-	m_hwnd = CreateWindow(
-		m_windowClass.lpszClassName,
-		_T("DirectX12eXg"),
-		WS_OVERLAPPEDWINDOW,
-		CW_USEDEFAULT,
-		CW_USEDEFAULT,
-		m_windowRect.right - m_windowRect.left,
-		m_windowRect.bottom - m_windowRect.top,
-		nullptr,
-		nullptr,
-		hInstance,
-		this
-	);
-	if (!m_hwnd) {
-		DebugOutputFormatString("CreateWindow Error : 0x%x\n", GetLastError());
-		return false;
+	// ^CmȂVF[_[fw肷ƎŝŁA珇Ɏ
+	const D3D_SHADER_MODEL shaderModels[] = {
+		D3D_SHADER_MODEL_6_5,
+		D3D_SHADER_MODEL_6_4,
+		D3D_SHADER_MODEL_6_3,
+		D3D_SHADER_MODEL_6_2,
+		D3D_SHADER_MODEL_6_1,
+		D3D_SHADER_MODEL_6_0,
+		D3D_SHADER_MODEL_5_1
+	};
+	for (const auto shaderModel : shaderModels) {
+		D3D12_FEATURE_DATA_SHADER_MODEL shaderModelData{ shaderModel };
+		if (SUCCEEDED(device->CheckFeatureSupport(D3D12_FEATURE_SHADER_MODEL, &shaderModelData, sizeof(shaderModelData)))) {
+			capabilities.shaderModel = shaderModelData.HighestShaderModel;
+			break;
+		}
 	}
 
 	return true;
@@ -176,27 +371,82 @@ bool DirectXManager::MakeWindow(HINSTANCE hInstance, int width, int height)
 
 bool DirectXManager::SelectAdapter()
 {
-	// ComPtr<IDXGIAdapter> currentAdaptor;
-	for (int i = 0; m_dxgiFactory->EnumAdapters(i, m_adapter.ReleaseAndGetAddressOf()) != DXGI_ERROR_NOT_FOUND; ++i) {
-		DXGI_ADAPTER_DESC adapterDesc{};
-		m_adapter->GetDesc(&adapterDesc);
-		std::wstring desc = adapterDesc.Description;
-		if (desc.find(L"NVIDIA") != std::string::npos)
-		{
-			DebugOutputFormatString("NVIDIA Video card found!\n");
+	// ϐ DX12_ADAPTER ɐ̈ꕔƂ̃A_v^[ł
+	AdapterPolicy policy;
+	wchar_t requiredDescription[128] = {};
+	if (GetEnvironmentVariableW(L"DX12_ADAPTER", requiredDescription, _countof(requiredDescription)) > 0) {
+		policy.requiredDescription = requiredDescription;
+		// IɎw肳ꂽȂ WARP 
+		policy.allowSoftware = true;
+	}
+
+	// OI񂾃A_v^[܂}ĂΒגɎg
+	AdapterCapabilities cached;
+	if (policy.requiredDescription.empty() && LoadAdapterCache(kAdapterCachePath, cached)) {
+		LUID luid{};
+		luid.LowPart = static_cast<DWORD>(cached.luid & 0xffffffff);
+		luid.HighPart = static_cast<LONG>(cached.luid >> 32);
+		ComPtr<IDXGIAdapter1> adapter;
+		DXGI_ADAPTER_DESC1 adapterDesc{};
+		// LUID ͍ċNŕς邱Ƃ̂ŁA GPU ǂm߂
+		if (SUCCEEDED(m_dxgiFactory->EnumAdapterByLuid(luid, IID_PPV_ARGS(adapter.GetAddressOf()))) &&
+			SUCCEEDED(adapter->GetDesc1(&adapterDesc)) &&
+			adapterDesc.VendorId == cached.vendorId &&
+			adapterDesc.DeviceId == cached.deviceId) {
+			m_adapter = adapter;
+			m_adapterCapabilities = cached;
+			DebugOutputFormatString("Adapter (cached): %ls\n", cached.description.c_str());
 			return true;
 		}
-		if (desc.find(L"AMD") != std::string::npos)
-		{
-			DebugOutputFormatString("AMD Video card found!\n");
-			return true;
+	}
+
+	std::vector<ComPtr<IDXGIAdapter1>> adapters;
+	std::vector<AdapterCapabilities> candidates;
+	ComPtr<IDXGIAdapter1> adapter;
+	for (UINT i = 0; m_dxgiFactory->EnumAdapters1(i, adapter.ReleaseAndGetAddressOf()) != DXGI_ERROR_NOT_FOUND; ++i) {
+		AdapterCapabilities capabilities;
+		if (!ProbeAdapter(adapter.Get(), capabilities)) {
+			continue;
 		}
+		DebugOutputFormatString(
+			"Adapter %u: %ls  VRAM %llu MB  FL 0x%x  SM 0x%x  Tier %u\n",
+			i,
+			capabilities.description.c_str(),
+			capabilities.dedicatedVideoMemory >> 20,
+			capabilities.featureLevel,
+			capabilities.shaderModel,
+			capabilities.resourceBindingTier
+		);
+		adapters.push_back(adapter);
+		candidates.push_back(capabilities);
 	}
-	return false;
+
+	const int best = SelectBestAdapter(candidates, policy);
+	if (best < 0) {
+		return false;
+	}
+	m_adapter = adapters[best];
+	m_adapterCapabilities = candidates[best];
+	DebugOutputFormatString("Adapter selected: %ls\n", m_adapterCapabilities.description.c_str());
+
+	if (policy.requiredDescription.empty()) {
+		SaveAdapterCache(kAdapterCachePath, m_adapterCapabilities);
+	}
+	return true;
 }
 
 bool DirectXManager::InitDirect3DDevice()
 {
+	// ׂĂ΂̋@\xō
+	if (m_adapterCapabilities.featureLevel != 0) {
+		const auto featureLevel = static_cast<D3D_FEATURE_LEVEL>(m_adapterCapabilities.featureLevel);
+		if (SUCCEEDED(D3D12CreateDevice(m_adapter.Get(), featureLevel, IID_PPV_ARGS(m_device.ReleaseAndGetAddressOf())))) {
+			m_feature_level = featureLevel;
+			DebugOutputFormatString("Feature level: 0x%x\n", featureLevel);
+			return true;
+		}
+	}
+
 	D3D_FEATURE_LEVEL featureLevels[] = {
 		D3D_FEATURE_LEVEL_12_2,
 		D3D_FEATURE_LEVEL_12_1,
@@ -205,7 +455,7 @@ bool DirectXManager::InitDirect3DDevice()
 		D3D_FEATURE_LEVEL_11_0
 	};
 	for (const auto fl : featureLevels) {
-		if (SUCCEEDED(D3D12CreateDevice(m_adapter.Get(), fl, IID_PPV_ARGS(m_device.GetAddressOf())))) {
+		if (SUCCEEDED(D3D12CreateDevice(m_adapter.Get(), fl, IID_PPV_ARGS(m_device.ReleaseAndGetAddressOf())))) {
 			m_feature_level = fl;
 			DebugOutputFormatString("Feature level: 0x%x\n", fl);
 			return true;
@@ -217,18 +467,26 @@ bool DirectXManager::InitDirect3DDevice()
 
 bool DirectXManager::InitCommandAllocatorAndCommandQueue()
 {
-	auto result = m_device->CreateCommandAllocator(
-		D3D12_COMMAND_LIST_TYPE_DIRECT,
-		IID_PPV_ARGS(m_commandAllocator.GetAddressOf())
-	);
-	if (FAILED(result)) {
-		DebugOutputFormatString("CreateCommandAllocator Error : 0x%x\n", result);
+	// `ERs[gERs[̃L[
+	if (!m_queues.Initialize(m_device.Get())) {
 		return false;
 	}
-	result = m_device->CreateCommandList(
+
+	// t[̕`p(`L[ɐς)BAP[^[̓XbgƂɎ
+	for (FrameSlot& slot : m_frameSlots) {
+		const auto result = m_device->CreateCommandAllocator(
+			D3D12_COMMAND_LIST_TYPE_DIRECT,
+			IID_PPV_ARGS(slot.commandAllocator.ReleaseAndGetAddressOf())
+		);
+		if (FAILED(result)) {
+			DebugOutputFormatString("CreateCommandAllocator Error : 0x%x\n", result);
+			return false;
+		}
+	}
+	auto result = m_device->CreateCommandList(
 		0,
 		D3D12_COMMAND_LIST_TYPE_DIRECT,
-		m_commandAllocator.Get(),
+		m_frameSlots[0].commandAllocator.Get(),
 		nullptr,
 		IID_PPV_ARGS(m_commandList.GetAddressOf())
 	);
@@ -236,16 +494,10 @@ bool DirectXManager::InitCommandAllocatorAndCommandQueue()
 		DebugOutputFormatString("CreateCommandList Error : 0x%x\n", result);
 		return false;
 	}
-
-	D3D12_COMMAND_QUEUE_DESC commandQueueDesc{};
-
-	commandQueueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
-	commandQueueDesc.NodeMask = 0;
-	commandQueueDesc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
-	commandQueueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
-	result = m_device->CreateCommandQueue(&commandQueueDesc, IID_PPV_ARGS(m_commandQueue.GetAddressOf()));
+	// Note: JԂōBRender() ̓ŃXbg̃AP[^[ŊĴŕĂ
+	result = m_commandList->Close();
 	if (FAILED(result)) {
-		DebugOutputFormatString("InitCommandAllocatorAndCommandQueue Error : 0x%x\n", result);
+		DebugOutputFormatString("Command list close Error : 0x%x\n", result);
 		return false;
 	}
 
@@ -255,14 +507,14 @@ bool DirectXManager::InitCommandAllocatorAndCommandQueue()
 bool DirectXManager::InitSwapChain()
 {
 	DXGI_SWAP_CHAIN_DESC1 swapchainDesc{};
-	swapchainDesc.Width = m_windowRect.right - m_windowRect.left;
-	swapchainDesc.Height = m_windowRect.bottom - m_windowRect.top;
+	swapchainDesc.Width = m_window.ClientWidth();
+	swapchainDesc.Height = m_window.ClientHeight();
 	swapchainDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
 	swapchainDesc.Stereo = false;
 	swapchainDesc.SampleDesc.Count = 1;
 	swapchainDesc.SampleDesc.Quality = 0;
 	swapchainDesc.BufferUsage = DXGI_USAGE_BACK_BUFFER;
-	swapchainDesc.BufferCount = 2;
+	swapchainDesc.BufferCount = kFramesInFlight;
 
 	// note: obNobt@͐Lяk݉\
 	swapchainDesc.Scaling = DXGI_SCALING_STRETCH;
@@ -273,12 +525,12 @@ bool DirectXManager::InitSwapChain()
 	// note: At@[h̎w͓ɂȂ
 	swapchainDesc.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
 
-	// note: m_windowClass <-> fullscreen ؂ւ\
+	// note: EBhE <-> fullscreen ؂ւ\
 	swapchainDesc.Flags = DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH;
 
 	auto result = m_dxgiFactory->CreateSwapChainForHwnd(
-		m_commandQueue.Get(),
-		m_hwnd,
+		m_queues.Direct().Get(),
+		m_window.Handle(),
 		&swapchainDesc,
 		nullptr,
 		nullptr,
@@ -297,7 +549,8 @@ bool DirectXManager::InitRTV()
 	D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc{};
 	rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
 	rtvHeapDesc.NodeMask = 0;
-	rtvHeapDesc.NumDescriptors = 2;
+	// obNobt@[11(InitSwapChain  BufferCount Ɠ)
+	rtvHeapDesc.NumDescriptors = kFramesInFlight;
 	rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
 	HRESULT result = m_device->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(m_rtvHeap.GetAddressOf()));
 	if (FAILED(result)) {
@@ -305,12 +558,23 @@ bool DirectXManager::InitRTV()
 		return false;
 	}
 
+	return CreateBackBufferViews();
+}
+
+bool DirectXManager::CreateBackBufferViews()
+{
 	DXGI_SWAP_CHAIN_DESC swapChainDesc{};
-	result = m_swapChain->GetDesc(&swapChainDesc);
+	HRESULT result = m_swapChain->GetDesc(&swapChainDesc);
 	if (FAILED(result)) {
 		DebugOutputFormatString("GetDesc Error : 0x%x\n", result);
 		return false;
 	}
+	if (swapChainDesc.BufferCount > m_rtvHeap->GetDesc().NumDescriptors) {
+		DebugOutputFormatString("CreateBackBufferViews: %u back buffers do not fit in the RTV heap.\n", swapChainDesc.BufferCount);
+		return false;
+	}
+	m_backBufferWidth = swapChainDesc.BufferDesc.Width;
+	m_backBufferHeight = swapChainDesc.BufferDesc.Height;
 	m_backBuffers.resize(swapChainDesc.BufferCount);
 	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
 
@@ -333,17 +597,97 @@ bool DirectXManager::InitRTV()
 	return true;
 }
 
-bool DirectXManager::InitFence()
+bool DirectXManager::CreateDepthBuffer(UINT width, UINT height)
 {
-	auto result = m_device->CreateFence(m_fenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(m_fence.GetAddressOf()));
+	if (m_dsvHeap == nullptr) {
+		D3D12_DESCRIPTOR_HEAP_DESC dsvHeapDesc{};
+		dsvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
+		dsvHeapDesc.NumDescriptors = 1;
+		dsvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+		HRESULT result = m_device->CreateDescriptorHeap(&dsvHeapDesc, IID_PPV_ARGS(m_dsvHeap.GetAddressOf()));
+		if (FAILED(result)) {
+			DebugOutputFormatString("CreateDescriptorHeap Error (for depth): 0x%x\n", result);
+			return false;
+		}
+	}
+
+	//  DEPTH_WRITE ̂܂܎gBNAlƓlnĂƑNAł
+	const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	const CD3DX12_RESOURCE_DESC resourceDescription = CD3DX12_RESOURCE_DESC::Tex2D(
+		kDepthFormat,
+		width,
+		height,
+		1,
+		1,
+		1,
+		0,
+		D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL | D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE
+	);
+	const CD3DX12_CLEAR_VALUE clearValue(kDepthFormat, kDepthClearValue, 0);
+	HRESULT result = m_device->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDescription,
+		D3D12_RESOURCE_STATE_DEPTH_WRITE,
+		&clearValue,
+		IID_PPV_ARGS(m_depthBuffer.ReleaseAndGetAddressOf())
+	);
 	if (FAILED(result)) {
-		DebugOutputFormatString("CreateFence Error : 0x%x\n", result);
+		DebugOutputFormatString("CreateCommittedResource Error (for depth): 0x%x\n", result);
+		return false;
+	}
+
+	D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc{};
+	dsvDesc.Format = kDepthFormat;
+	dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+	m_device->CreateDepthStencilView(m_depthBuffer.Get(), &dsvDesc, m_dsvHeap->GetCPUDescriptorHandleForHeapStart());
+	return true;
+}
+
+bool DirectXManager::ResizeSwapChain(UINT width, UINT height)
+{
+	if (!RebuildSizeDependentTargets(*this, width, height)) {
 		return false;
 	}
+	// 傫ς GPU Ԃς̂ŁA{ߒ
+	m_resolutionController.Reset();
+
+	DebugOutputFormatString("Resized swap chain : %u x %u\n", width, height);
+	return true;
+}
+
+bool DirectXManager::FlushFrames()
+{
+	// Note: Present ҂Ăt[́A蒼Ȏ傫̃obNobt@[ɏoĂ܂
+	return m_framePipeline.Flush();
+}
 
+void DirectXManager::ReleaseBackBuffers()
+{
+	m_backBuffers.clear();
+}
+
+bool DirectXManager::ResizeBuffers(uint32_t width, uint32_t height)
+{
+	const HRESULT result = m_swapChain->ResizeBuffers(
+		0,
+		width,
+		height,
+		DXGI_FORMAT_UNKNOWN,
+		DXGI_SWAP_CHAIN_FLAG_ALLOW_MODE_SWITCH
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("ResizeBuffers Error : 0x%x\n", result);
+		return false;
+	}
 	return true;
 }
 
+bool DirectXManager::ResizeRenderTargets(uint32_t width, uint32_t height)
+{
+	return m_postProcess.Resize(width, height) && CreateDepthBuffer(width, height);
+}
+
 bool DirectXManager::SetupVertexBuffer()
 {
 	D3D12_HEAP_PROPERTIES heapProperties{};
@@ -355,7 +699,7 @@ bool DirectXManager::SetupVertexBuffer()
 	D3D12_RESOURCE_DESC resourceDescription{};
 
 	resourceDescription.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-	resourceDescription.Width = sizeof(kVertices); // _񂪓邾̃TCY
+	resourceDescription.Width = m_vertexCount * sizeof(Vertex); // _񂪓邾̃TCY
 	resourceDescription.Height = 1;
 	resourceDescription.DepthOrArraySize = 1;
 	resourceDescription.MipLevels = 1;
@@ -393,23 +737,19 @@ bool DirectXManager::SetupVertexBuffer()
 		return false;
 	}
 
-	return true;
-}
-
-bool DirectXManager::SetupShaders()
-{
+	// obt@[ɒ_f[^Rs[
 	Vertex* verticesMap = nullptr;
-	HRESULT result = m_vertexBuffer->Map(0, nullptr, reinterpret_cast<void**>(&verticesMap));
+	result = m_vertexBuffer->Map(0, nullptr, reinterpret_cast<void**>(&verticesMap));
 	if (FAILED(result)) {
 		DebugOutputFormatString("Vertex buffer map Error : 0x%x\n", result);
 		return false;
 	}
-	std::copy(std::begin(kVertices), std::end(kVertices), verticesMap);
+	std::copy(m_vertices, m_vertices + m_vertexCount, verticesMap);
 	m_vertexBuffer->Unmap(0, nullptr);
 
 	m_vertexBufferView.BufferLocation = m_vertexBuffer->GetGPUVirtualAddress();
-	m_vertexBufferView.SizeInBytes = sizeof(kVertices);
-	m_vertexBufferView.StrideInBytes = sizeof(kVertices[0]);
+	m_vertexBufferView.SizeInBytes = m_vertexCount * sizeof(Vertex);
+	m_vertexBufferView.StrideInBytes = sizeof(Vertex);
 
 	// obt@[ɃCfbNXf[^obt@[ɃRs[
 	unsigned short* indicesMap = nullptr;
@@ -425,60 +765,135 @@ bool DirectXManager::SetupShaders()
 	m_indexBufferView.Format = DXGI_FORMAT_R16_UINT;
 	m_indexBufferView.SizeInBytes = sizeof(kIndices);
 
-	ComPtr<ID3D10Blob> errorBlob;
-	result = D3DCompileFromFile(
-		L"BasicVertexShader.hlsl",
-		nullptr,
-		D3D_COMPILE_STANDARD_FILE_INCLUDE,
-		"BasicVS",
-		"vs_5_0",
-		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION,
-		0,
-		m_vsBlob.ReleaseAndGetAddressOf(),
-		errorBlob.ReleaseAndGetAddressOf()
-	);
-	if (FAILED(result)) {
-		if (result == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND)) {
-			DebugOutputFormatString("Vertex Shader File not found.\n");
-			return false;
+	return true;
+}
+
+void DirectXManager::SetupDrawItems()
+{
+	// lp`|S1BEnableDemoScene ȂsȎlp`|S2ƁAȎlp`|S3
+	m_drawItems.clear();
+	m_drawBounds.Clear();
+	const INT opaqueVertexCount = m_opaqueQuadCount * kQuadVertexCount;
+	for (INT baseVertex = 0; baseVertex < opaqueVertexCount; baseVertex += kQuadVertexCount) {
+		AddQuadDrawItem(baseVertex, kRecorderPipelineState, kRecorderTexture, m_drawItems, m_drawBounds);
+	}
+
+	m_transparentDrawItems.clear();
+	m_transparentBounds.Clear();
+	for (INT baseVertex = opaqueVertexCount; baseVertex < static_cast<INT>(m_vertexCount); baseVertex += kQuadVertexCount) {
+		AddQuadDrawItem(
+			baseVertex,
+			kRecorderTransparentPipelineState,
+			kRecorderTransparentTexture,
+			m_transparentDrawItems,
+			m_transparentBounds
+		);
+	}
+}
+
+void DirectXManager::AddQuadDrawItem(
+	INT baseVertex,
+	RecorderObjectId pipelineState,
+	RecorderObjectId texture,
+	std::vector<DrawItem>& drawItems,
+	AabbSoA& bounds
+) const {
+	drawItems.push_back({ _countof(kIndices), 0, baseVertex, pipelineState, texture });
+
+	// _ AABB ߂
+	const Vertex* vertices = m_vertices + baseVertex;
+	XMFLOAT3 minPosition = vertices[0].position;
+	XMFLOAT3 maxPosition = vertices[0].position;
+	for (INT i = 0; i < kQuadVertexCount; ++i) {
+		const Vertex& vertex = vertices[i];
+		minPosition.x = (std::min)(minPosition.x, vertex.position.x);
+		minPosition.y = (std::min)(minPosition.y, vertex.position.y);
+		minPosition.z = (std::min)(minPosition.z, vertex.position.z);
+		maxPosition.x = (std::max)(maxPosition.x, vertex.position.x);
+		maxPosition.y = (std::max)(maxPosition.y, vertex.position.y);
+		maxPosition.z = (std::max)(maxPosition.z, vertex.position.z);
+	}
+	bounds.Add(
+		{
+			(minPosition.x + maxPosition.x) * 0.5f,
+			(minPosition.y + maxPosition.y) * 0.5f,
+			(minPosition.z + maxPosition.z) * 0.5f
+		},
+		{
+			(maxPosition.x - minPosition.x) * 0.5f,
+			(maxPosition.y - minPosition.y) * 0.5f,
+			(maxPosition.z - minPosition.z) * 0.5f
 		}
-		if (errorBlob == nullptr) {
-			DebugOutputFormatString("D3DCompileFromFile Vertex Shader Error : 0x%08x\n", result);
-			return false;
+	);
+}
+
+size_t DirectXManager::CullOccludedDraws(
+	uint32_t* drawIndices,
+	size_t count,
+	const Float4x4& viewProjection,
+	DrawSortKey* sortKeys,
+	DrawSortKey* sortScratch
+) {
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t drawIndex = drawIndices[i];
+		sortKeys[i] = MakeDrawSortKey(FrontToBackOrder(ProjectedDepth(m_drawBounds, drawIndex, viewProjection)), drawIndex);
+	}
+	RadixSortDrawKeys(sortKeys, sortScratch, count);
+	for (size_t i = 0; i < count; ++i) {
+		drawIndices[i] = DrawSortKeyIndex(sortKeys[i]);
+	}
+	m_occlusionBuffer.Clear();
+	return m_occlusionBuffer.CullFrontToBack(m_frustum, m_drawBounds, drawIndices, count);
+}
+
+void DirectXManager::FillFramePacket(FramePacket& packet)
+{
+	packet.frameIndex = m_submittedFrameCount++;
+	// _VF[_[͍WϊȂ̂ŁAr[EvWFNV͒Pʍs
+	packet.viewProjection = IdentityMatrix();
+
+	m_resizeDebouncer.Update(ResizeDebouncer::Clock::now());
+	packet.width = m_resizeDebouncer.Width();
+	packet.height = m_resizeDebouncer.Height();
+}
+
+bool DirectXManager::CompileShader(
+	const wchar_t* path,
+	const char* entryPoint,
+	const char* target,
+	ComPtr<ID3D10Blob>& blob,
+	ShaderReflectionData* reflection
+) {
+	// Õ\[XȂAÕoCgR[hƃtNVʂg
+	uint64_t cacheKey = 0;
+	const bool hasCacheKey = ComputeShaderCacheKey(path, entryPoint, target, kShaderCompileFlags, cacheKey);
+	ShaderReflectionData parsed;
+	if (hasCacheKey && LoadCachedShader(path, entryPoint, cacheKey, blob, parsed)) {
+		if (reflection != nullptr) {
+			*reflection = std::move(parsed);
 		}
-		std::string errorMessage;
-		errorMessage.resize(errorBlob->GetBufferSize());
-		std::copy_n(
-			static_cast<const char*>(errorBlob->GetBufferPointer()),
-			errorBlob->GetBufferSize(),
-			errorMessage.begin()
-		);
-		errorMessage += "\n";
-		DebugOutputFormatString(
-			"D3DCompileFromFile Vertex Shader Error : %s\n",
-			errorMessage.c_str()
-		);
-		return false;
+		return true;
 	}
 
-	result = D3DCompileFromFile(
-		L"BasicPixelShader.hlsl",
+	ComPtr<ID3D10Blob> errorBlob;
+	HRESULT result = D3DCompileFromFile(
+		path,
 		nullptr,
 		D3D_COMPILE_STANDARD_FILE_INCLUDE,
-		"BasicPS",
-		"ps_5_0",
-		D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION,
+		entryPoint,
+		target,
+		kShaderCompileFlags,
 		0,
-		m_psBlob.GetAddressOf(),
+		blob.ReleaseAndGetAddressOf(),
 		errorBlob.ReleaseAndGetAddressOf()
 	);
 	if (FAILED(result)) {
 		if (result == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND)) {
-			DebugOutputFormatString("Pixel Shader File not found.\n");
+			DebugOutputFormatString("Shader File not found : %ls\n", path);
 			return false;
 		}
 		if (errorBlob == nullptr) {
-			DebugOutputFormatString("D3DCompileFromFile Pixel Shader Error : 0x%08x\n", result);
+			DebugOutputFormatString("D3DCompileFromFile Error (%ls) : 0x%08x\n", path, result);
 			return false;
 		}
 		std::string errorMessage;
@@ -490,43 +905,90 @@ bool DirectXManager::SetupShaders()
 		);
 		errorMessage += "\n";
 		DebugOutputFormatString(
-			"D3DCompileFromFile Pixel Shader Error : %s\n",
+			"D3DCompileFromFile Error (%ls) : %s\n",
+			path,
 			errorMessage.c_str()
 		);
 		return false;
 	}
+
+	if (!ParseDxbc(blob->GetBufferPointer(), blob->GetBufferSize(), parsed)) {
+		DebugOutputFormatString("Shader reflection failed (%ls)\n", path);
+		return false;
+	}
+	if (hasCacheKey) {
+		StoreCachedShader(path, entryPoint, cacheKey, blob.Get(), parsed);
+	}
+	if (reflection != nullptr) {
+		*reflection = std::move(parsed);
+	}
 	return true;
 }
 
-bool DirectXManager::SetupGraphicsPipeline()
+const char* DirectXManager::PixelShaderEntryPoint() const
 {
-	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-		{ // W
-			"POSITION",
-			0,
-			DXGI_FORMAT_R32G32B32_FLOAT,
-			0,
-			D3D12_APPEND_ALIGNED_ELEMENT,
-			D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
-			0
-		},
-		{ // uv
-			"TEXCOORD",
-			0,
-			DXGI_FORMAT_R32G32_FLOAT,
-			0,
-			D3D12_APPEND_ALIGNED_ELEMENT,
-			D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
-			0
-		},
-	};
-
-	D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsPipeline{};
+	return m_textureStreaming ? "StreamedPS" : "BasicPS";
+}
 
-	graphicsPipeline.VS.pShaderBytecode = m_vsBlob->GetBufferPointer();
-	graphicsPipeline.VS.BytecodeLength = m_vsBlob->GetBufferSize();
-	graphicsPipeline.PS.pShaderBytecode = m_psBlob->GetBufferPointer();
-	graphicsPipeline.PS.BytecodeLength = m_psBlob->GetBufferSize();
+bool DirectXManager::SetupShaders()
+{
+	if (!CompileShader(kVertexShaderPath, "BasicVS", "vs_5_0", m_vsBlob, &m_vsReflection)) {
+		return false;
+	}
+	if (!CompileShader(kPixelShaderPath, PixelShaderEntryPoint(), "ps_5_0", m_psBlob, &m_psReflection)) {
+		return false;
+	}
+	return true;
+}
+
+bool DirectXManager::SetupPostProcess()
+{
+	PostProcessShaders shaders;
+	for (int pass = 0; pass < kPostProcessPassCount; ++pass) {
+		if (!CompileShader(
+				kPostProcessShaderPath,
+				PostProcessEntryPoint(static_cast<PostProcessPass>(pass)),
+				"cs_5_0",
+				shaders[pass]
+			)) {
+			return false;
+		}
+	}
+	if (!m_postProcess.Initialize(m_device.Get(), shaders, kFramesInFlight)) {
+		return false;
+	}
+
+	DXGI_SWAP_CHAIN_DESC1 swapChainDesc{};
+	HRESULT result = m_swapChain->GetDesc1(&swapChainDesc);
+	if (FAILED(result)) {
+		DebugOutputFormatString("GetDesc1 Error : 0x%x\n", result);
+		return false;
+	}
+	return m_postProcess.Resize(swapChainDesc.Width, swapChainDesc.Height);
+}
+
+bool DirectXManager::SetupTextureConverter()
+{
+	ComPtr<ID3D10Blob> convertShader;
+	ComPtr<ID3D10Blob> downsampleShader;
+	if (!CompileShader(kTextureConversionShaderPath, "ConvertCS", "cs_5_0", convertShader) ||
+		!CompileShader(kTextureConversionShaderPath, "DownsampleCS", "cs_5_0", downsampleShader)) {
+		return false;
+	}
+	return m_textureConverter.Initialize(m_device.Get(), m_rootSignatures, convertShader.Get(), downsampleShader.Get());
+}
+
+bool DirectXManager::SetupGraphicsPipeline()
+{
+	// _VF[_[̓̓VOl`BVertex ̃o[ƓE^ɂȂĂ
+	const std::vector<D3D12_INPUT_ELEMENT_DESC> inputLayout = MakeInputLayout(m_vsReflection);
+
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC graphicsPipeline{};
+
+	graphicsPipeline.VS.pShaderBytecode = m_vsBlob->GetBufferPointer();
+	graphicsPipeline.VS.BytecodeLength = m_vsBlob->GetBufferSize();
+	graphicsPipeline.PS.pShaderBytecode = m_psBlob->GetBufferPointer();
+	graphicsPipeline.PS.BytecodeLength = m_psBlob->GetBufferSize();
 
 	// ftHg̃Tv}XN\萔(0xffffffff)
 	graphicsPipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
@@ -551,8 +1013,8 @@ bool DirectXManager::SetupGraphicsPipeline()
 
 	graphicsPipeline.BlendState.RenderTarget[0] = renderTargetBlendDesc;
 
-	graphicsPipeline.InputLayout.pInputElementDescs = inputLayout;
-	graphicsPipeline.InputLayout.NumElements = _countof(inputLayout);
+	graphicsPipeline.InputLayout.pInputElementDescs = inputLayout.data();
+	graphicsPipeline.InputLayout.NumElements = static_cast<UINT>(inputLayout.size());
 
 	// gCAOXgbṽJbgȂ
 	graphicsPipeline.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
@@ -561,125 +1023,293 @@ bool DirectXManager::SetupGraphicsPipeline()
 	graphicsPipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
 
 	graphicsPipeline.NumRenderTargets = 1;
-	// 0`1 ɐKꂽ RGBA
-	graphicsPipeline.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
+	//  HDR ^[Qbgɕ`Ă|XgvZXŃobNobt@[ɏo
+	graphicsPipeline.RTVFormats[0] = PostProcessChain::kHdrFormat;
 
 	// TvO1sNZɂ1
 	graphicsPipeline.SampleDesc.Count = 1;
 	// NIeB͍Œ
 	graphicsPipeline.SampleDesc.Quality = 0;
 
+	// reversed-Z ŎOcBvpXŐ[xƂׂ͔邾ɂ
+	graphicsPipeline.DepthStencilState = MakeDepthStencilDesc(m_depthPrePass ? kDepthTestOnly : kDepthWrite);
+	graphicsPipeline.DSVFormat = kDepthFormat;
 
-	D3D12_DESCRIPTOR_RANGE descriptorRange{};
-	// ʂ̓eNX`
-	descriptorRange.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
-	// eNX`P
-	descriptorRange.NumDescriptors = 1;
-	// 0ŃXbg
-	descriptorRange.BaseShaderRegister = 0;
-	descriptorRange.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
-
-	D3D12_ROOT_PARAMETER rootParameter{};
-	rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-	// sNZVF[_[猩悤ɂ
-	rootParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-	// fBXNv^W̃AhX
-	rootParameter.DescriptorTable.pDescriptorRanges = &descriptorRange;
-	// fBXNv^W
-	rootParameter.DescriptorTable.NumDescriptorRanges = 1;
-
-	D3D12_STATIC_SAMPLER_DESC samplerDesc{};
-
-	// `
-	samplerDesc.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
-	// // ԂȂ(jAXglCo[@: ŋߖT)
-	// samplerDesc.Filter = D3D12_FILTER_MIN_MAG_MIP_POINT;
-	// ̌JԂ
-	samplerDesc.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
-	// čJԂ
-	samplerDesc.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
-	// šJԂ
-	samplerDesc.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
-	// TvOȂ
-	samplerDesc.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
-	// {[_[J[͎gȂ̂œ
-	samplerDesc.BorderColor = D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK;
-	// ~bv}bvŏl
-	samplerDesc.MinLOD = 0.0f;
-	// ~bv}bvől
-	samplerDesc.MaxLOD = D3D12_FLOAT32_MAX;
-	// sNZVF[_[猩
-	samplerDesc.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-
-	D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc{};
-
-	rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
-
-	rootSignatureDesc.pParameters = &rootParameter;
-	rootSignatureDesc.NumParameters = 1;
-	rootSignatureDesc.pStaticSamplers = &samplerDesc;
-	rootSignatureDesc.NumStaticSamplers = 1;
-
-	ComPtr<ID3DBlob> rootSignatureBlob;
-	ComPtr<ID3D10Blob> errorBlob;
-	HRESULT result = D3D12SerializeRootSignature(
-		// [gVOl`ݒ
-		&rootSignatureDesc,
-		// [gVOl`o[W
-		D3D_ROOT_SIGNATURE_VERSION_1_0,
-		// VF[_[ƂƓ
-		rootSignatureBlob.ReleaseAndGetAddressOf(),
-		// G[
-		errorBlob.ReleaseAndGetAddressOf()
+	// ̃VF[_[g\[XgݗĂB
+	// Tv[Ⴄ2ނɂȂALq̓LbVԂ̂ŁA蒼ĂȂ
+	ReflectedRootSignature reflectedRootSignature;
+	reflectedRootSignature.Build(
+		{
+			{ &m_vsReflection, D3D12_SHADER_VISIBILITY_VERTEX },
+			{ &m_psReflection, D3D12_SHADER_VISIBILITY_PIXEL },
+		},
+		D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT,
+		// ԂȂ(jAXglCo[@: ŋߖT)`
+		m_pointSampling ? D3D12_FILTER_MIN_MAG_MIP_POINT : D3D12_FILTER_MIN_MAG_MIP_LINEAR,
+		D3D12_TEXTURE_ADDRESS_MODE_WRAP
+	);
+	// BasicShaderHeader.hlsli  tex
+	const int textureParameterIndex = reflectedRootSignature.ParameterIndex("tex");
+	if (textureParameterIndex < 0) {
+		DebugOutputFormatString("Root parameter not found : tex\n");
+		return false;
+	}
+	// TileStreaming.hlsli  tileIndirection  tileFeedback
+	const int tileIndirectionParameterIndex = reflectedRootSignature.ParameterIndex("tileIndirection");
+	const int tileFeedbackParameterIndex = reflectedRootSignature.ParameterIndex("tileFeedback");
+	if (m_textureStreaming && (tileIndirectionParameterIndex < 0 || tileFeedbackParameterIndex < 0)) {
+		DebugOutputFormatString("Root parameter not found : tileIndirection / tileFeedback\n");
+		return false;
+	}
+	const ComPtr<ID3D12RootSignature> rootSignature = reflectedRootSignature.GetOrCreate(m_device.Get(), m_rootSignatures);
+	if (rootSignature == nullptr) {
+		return false;
+	}
+#ifdef _DEBUG
+	// BasicShaderHeader.hlsli ̐錾ƌׂ悤ɏoĂ
+	DebugOutputFormatString("%s", reflectedRootSignature.GenerateHlslRegisters().c_str());
+#endif
+
+	graphicsPipeline.pRootSignature = rootSignature.Get();
+
+	// 蒼ɎsĂÕpCvCg悤AĂ獷ւ
+	ComPtr<ID3D12PipelineState> pipelineState;
+	HRESULT result = m_device->CreateGraphicsPipelineState(
+		&graphicsPipeline,
+		IID_PPV_ARGS(pipelineState.GetAddressOf())
 	);
 	if (FAILED(result)) {
-		if (errorBlob == nullptr) {
-			DebugOutputFormatString("D3D12SerializeRootSignature Error : 0x%x\n", result);
+		DebugOutputFormatString("CreateGraphicsPipelineState Error : 0x%x\n", result);
+		return false;
+	}
+
+	// p͏d˕ƁA[x܂ȂƂ낾Ⴄ
+	graphicsPipeline.BlendState = MakeBlendDesc(kBlendPremultipliedAlpha);
+	graphicsPipeline.DepthStencilState = MakeDepthStencilDesc(kDepthTestOnly);
+	ComPtr<ID3D12PipelineState> transparentPipelineState;
+	result = m_device->CreateGraphicsPipelineState(
+		&graphicsPipeline,
+		IID_PPV_ARGS(transparentPipelineState.GetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateGraphicsPipelineState Error (for transparent): 0x%x\n", result);
+		return false;
+	}
+
+	// vpXp͐[xBsNZVF[_[ʂȂ
+	ComPtr<ID3D12PipelineState> depthPrePassPipelineState;
+	if (m_depthPrePass) {
+		graphicsPipeline.PS = {};
+		graphicsPipeline.BlendState = MakeBlendDesc(kBlendColorWriteDisabled);
+		graphicsPipeline.DepthStencilState = MakeDepthStencilDesc(kDepthWrite);
+		result = m_device->CreateGraphicsPipelineState(
+			&graphicsPipeline,
+			IID_PPV_ARGS(depthPrePassPipelineState.GetAddressOf())
+		);
+		if (FAILED(result)) {
+			DebugOutputFormatString("CreateGraphicsPipelineState Error (for depth pre-pass): 0x%x\n", result);
 			return false;
 		}
-		std::string errorMessage;
-		errorMessage.resize(errorBlob->GetBufferSize());
-		std::copy_n(
-			static_cast<const char*>(errorBlob->GetBufferPointer()),
-			errorBlob->GetBufferSize(),
-			errorMessage.begin()
-		);
-		errorMessage += "\n";
-		DebugOutputFormatString(
-			"D3D12SerializeRootSignature Error : 0x%x\n",
-			errorMessage.c_str()
-		);
-		return false;
 	}
+	m_pipelineState = pipelineState;
+	m_transparentPipelineState = transparentPipelineState;
+	m_depthPrePassPipelineState = depthPrePassPipelineState;
+	m_rootSignature = rootSignature;
+	m_textureParameterIndex = static_cast<UINT>(textureParameterIndex);
+	m_tileIndirectionParameterIndex = static_cast<UINT>(tileIndirectionParameterIndex);
+	m_tileFeedbackParameterIndex = static_cast<UINT>(tileFeedbackParameterIndex);
 
-	result = m_device->CreateRootSignature(
-		// nodeMaskB0ł悢
-		0,
-		// VF[_[̎Ɠl
-		rootSignatureBlob->GetBufferPointer(),
-		// VF[_[̎Ɠl
-		rootSignatureBlob->GetBufferSize(),
-		IID_PPV_ARGS(m_rootSignature.ReleaseAndGetAddressOf())
+	return true;
+}
+
+bool DirectXManager::CreateBuffer(
+	D3D12_HEAP_TYPE heapType,
+	UINT64 size,
+	D3D12_RESOURCE_FLAGS flags,
+	D3D12_RESOURCE_STATES initialState,
+	ComPtr<ID3D12Resource>& buffer
+) const
+{
+	const CD3DX12_HEAP_PROPERTIES heapProperties(heapType);
+	const CD3DX12_RESOURCE_DESC resourceDescription = CD3DX12_RESOURCE_DESC::Buffer(size, flags);
+	HRESULT result = m_device->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDescription,
+		initialState,
+		nullptr,
+		IID_PPV_ARGS(buffer.ReleaseAndGetAddressOf())
 	);
 	if (FAILED(result)) {
-		DebugOutputFormatString("CreateRootSignature Error : 0x%x\n", result);
+		DebugOutputFormatString("CreateCommittedResource Error (for buffer): 0x%x\n", result);
 		return false;
 	}
+	return true;
+}
 
-	graphicsPipeline.pRootSignature = m_rootSignature.Get();
+bool DirectXManager::SetupIndirectDraw()
+{
+	if (!CompileShader(L"IndirectCull.hlsl", "CullCS", "cs_5_0", m_cullCsBlob)) {
+		return false;
+	}
 
-	result = m_device->CreateGraphicsPipelineState(
-		&graphicsPipeline,
-		IID_PPV_ARGS(m_pipelineState.ReleaseAndGetAddressOf())
+	// obt@[ׂ͂ă[gɒڒûŃfBXNv^q[v͕sv
+	m_cullRootSignature = m_rootSignatures.GetOrCreate(m_device.Get(), kCullRootSignature);
+	if (m_cullRootSignature == nullptr) {
+		return false;
+	}
+
+	D3D12_COMPUTE_PIPELINE_STATE_DESC computePipeline{};
+	computePipeline.pRootSignature = m_cullRootSignature.Get();
+	computePipeline.CS.pShaderBytecode = m_cullCsBlob->GetBufferPointer();
+	computePipeline.CS.BytecodeLength = m_cullCsBlob->GetBufferSize();
+	HRESULT result = m_device->CreateComputePipelineState(
+		&computePipeline,
+		IID_PPV_ARGS(m_cullPipelineState.ReleaseAndGetAddressOf())
 	);
 	if (FAILED(result)) {
-		DebugOutputFormatString("CreateGraphicsPipelineState Error : 0x%x\n", result);
+		DebugOutputFormatString("CreateComputePipelineState Error (for cull): 0x%x\n", result);
+		return false;
+	}
+
+	D3D12_COMMAND_SIGNATURE_DESC commandSignatureDesc{};
+	D3D12_INDIRECT_ARGUMENT_DESC argumentDesc{};
+	SetupDrawIndexedCommandSignature(commandSignatureDesc, argumentDesc);
+	// `ς܂Ȃ̂Ń[gVOl`͕sv
+	result = m_device->CreateCommandSignature(
+		&commandSignatureDesc,
+		nullptr,
+		IID_PPV_ARGS(m_commandSignature.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommandSignature Error : 0x%x\n", result);
+		return false;
+	}
+
+	const size_t drawCount = m_drawItems.size();
+
+	// AABB ƕ`͏Ȃ̂ŃAbv[hq[vɒu܂ܓǂ܂
+	if (!CreateBuffer(
+			D3D12_HEAP_TYPE_UPLOAD,
+			sizeof(PackedAabb) * drawCount,
+			D3D12_RESOURCE_FLAG_NONE,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			m_drawBoundsBuffer
+		)) {
+		return false;
+	}
+	PackedAabb* boundsMap = nullptr;
+	result = m_drawBoundsBuffer->Map(0, nullptr, reinterpret_cast<void**>(&boundsMap));
+	if (FAILED(result)) {
+		DebugOutputFormatString("Bounds buffer map Error : 0x%x\n", result);
+		return false;
+	}
+	PackAabbs(m_drawBounds, boundsMap);
+	m_drawBoundsBuffer->Unmap(0, nullptr);
+
+	if (!CreateBuffer(
+			D3D12_HEAP_TYPE_UPLOAD,
+			sizeof(DrawIndexedArguments) * drawCount,
+			D3D12_RESOURCE_FLAG_NONE,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			m_drawArgumentsBuffer
+		)) {
+		return false;
+	}
+	DrawIndexedArguments* argumentsMap = nullptr;
+	result = m_drawArgumentsBuffer->Map(0, nullptr, reinterpret_cast<void**>(&argumentsMap));
+	if (FAILED(result)) {
+		DebugOutputFormatString("Draw arguments buffer map Error : 0x%x\n", result);
+		return false;
+	}
+	for (size_t i = 0; i < drawCount; ++i) {
+		argumentsMap[i] = { m_drawItems[i].indexCount, 1, m_drawItems[i].startIndex, m_drawItems[i].baseVertex, 0 };
+	}
+	m_drawArgumentsBuffer->Unmap(0, nullptr);
+
+	// t[̊Jn_ł  = UAVA = Rs[ ̏ԂɂĂ
+	if (!CreateBuffer(
+			D3D12_HEAP_TYPE_DEFAULT,
+			sizeof(D3D12_DRAW_INDEXED_ARGUMENTS) * drawCount,
+			D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+			D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			m_visibleArgumentsBuffer
+		)) {
+		return false;
+	}
+	if (!CreateBuffer(
+			D3D12_HEAP_TYPE_DEFAULT,
+			sizeof(UINT),
+			D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS,
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			m_visibleCountBuffer
+		)) {
+		return false;
+	}
+
+	// 𖈃t[0ɖ߂߂̃Rs[
+	if (!CreateBuffer(
+			D3D12_HEAP_TYPE_UPLOAD,
+			sizeof(UINT),
+			D3D12_RESOURCE_FLAG_NONE,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			m_zeroCountBuffer
+		)) {
+		return false;
+	}
+	UINT* zeroMap = nullptr;
+	result = m_zeroCountBuffer->Map(0, nullptr, reinterpret_cast<void**>(&zeroMap));
+	if (FAILED(result)) {
+		DebugOutputFormatString("Zero count buffer map Error : 0x%x\n", result);
 		return false;
 	}
+	*zeroMap = 0;
+	m_zeroCountBuffer->Unmap(0, nullptr);
 
 	return true;
 }
 
+void DirectXManager::RecordGpuCulling()
+{
+	const UINT drawCount = static_cast<UINT>(m_drawItems.size());
+
+	// 0NA
+	m_commandList->CopyBufferRegion(m_visibleCountBuffer.Get(), 0, m_zeroCountBuffer.Get(), 0, sizeof(UINT));
+	const auto countToUav = CD3DX12_RESOURCE_BARRIER::Transition(
+		m_visibleCountBuffer.Get(),
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS
+	);
+	m_commandList->ResourceBarrier(1, &countToUav);
+
+	m_commandList->SetComputeRootSignature(m_cullRootSignature.Get());
+	m_commandList->SetPipelineState(m_cullPipelineState.Get());
+
+	const CullConstants constants = MakeCullConstants(m_frustum, drawCount);
+	m_commandList->SetComputeRoot32BitConstants(0, sizeof(CullConstants) / sizeof(uint32_t), &constants, 0);
+	m_commandList->SetComputeRootShaderResourceView(1, m_drawBoundsBuffer->GetGPUVirtualAddress());
+	m_commandList->SetComputeRootShaderResourceView(2, m_drawArgumentsBuffer->GetGPUVirtualAddress());
+	m_commandList->SetComputeRootUnorderedAccessView(3, m_visibleArgumentsBuffer->GetGPUVirtualAddress());
+	m_commandList->SetComputeRootUnorderedAccessView(4, m_visibleCountBuffer->GetGPUVirtualAddress());
+
+	m_commandList->Dispatch(CullThreadGroupCount(drawCount), 1, 1);
+
+	// ExecuteIndirect ǂ߂悤ɂ
+	const D3D12_RESOURCE_BARRIER toIndirect[] = {
+		CD3DX12_RESOURCE_BARRIER::Transition(
+			m_visibleArgumentsBuffer.Get(),
+			D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT
+		),
+		CD3DX12_RESOURCE_BARRIER::Transition(
+			m_visibleCountBuffer.Get(),
+			D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT
+		),
+	};
+	m_commandList->ResourceBarrier(_countof(toIndirect), toIndirect);
+}
+
 void DirectXManager::SetupViewportAndScissor(unsigned int windowWidth, unsigned int windowHeight)
 {
 	// o͐̕(sNZ)
@@ -705,50 +1335,10 @@ void DirectXManager::SetupViewportAndScissor(unsigned int windowWidth, unsigned
 	m_scissorRect.bottom = m_scissorRect.top + windowHeight;
 }
 
-void DirectXManager::SetupUploadHeap(
-	D3D12_HEAP_PROPERTIES& uploadHeapProperties,
-	D3D12_RESOURCE_DESC& uploadResourceDescription,
-	const Image* image
-) {
-	// }bv\ɂ邽߁AUPLOAD ɂ
-	uploadHeapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
-
-	// Abv[hpɎgp邱ƑOȂ̂ UNKNOWN ł悢
-	uploadHeapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-	uploadHeapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-
-	// PA_v^[̂0
-	uploadHeapProperties.CreationNodeMask = 0;
-	uploadHeapProperties.VisibleNodeMask = 0;
-
-
-	// PȂf[^̉Ȃ̂ UNKNOWN
-	uploadResourceDescription.Format = DXGI_FORMAT_UNKNOWN;
-	// PȂobt@[ƂĎw
-	uploadResourceDescription.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-
-	// f[^TCY
-	uploadResourceDescription.Width =
-		AlignedSize(image->slicePitch, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT) * image->height;
-	uploadResourceDescription.Height = 1;
-	uploadResourceDescription.DepthOrArraySize = 1;
-	uploadResourceDescription.MipLevels = 1;
-
-	// Af[^
-	uploadResourceDescription.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-	// ɃtOȂ
-	uploadResourceDescription.Flags = D3D12_RESOURCE_FLAG_NONE;
-
-	uploadResourceDescription.SampleDesc = {
-		// ʏeNX`Ȃ̂ŃA`GCAVO͂Ȃ
-		1,
-		0
-	};
-}
-
 void DirectXManager::SetupTextureHeap(
 	D3D12_HEAP_PROPERTIES& textureHeapProperties,
-	D3D12_RESOURCE_DESC& resourceDescription
+	D3D12_RESOURCE_DESC& resourceDescription,
+	const ImageSource& image
 ) {
 	// eNX`p
 	textureHeapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
@@ -760,112 +1350,101 @@ void DirectXManager::SetupTextureHeap(
 	textureHeapProperties.VisibleNodeMask = 0;
 
 	// RGBA tH[}bg
-	resourceDescription.Format = m_metadata.format;
+	resourceDescription.Format = image.Format();
 	// 
-	resourceDescription.Width = m_metadata.width;
+	resourceDescription.Width = image.Width();
 	// 
-	resourceDescription.Height = m_metadata.height;
-	resourceDescription.DepthOrArraySize = m_metadata.arraySize;
+	resourceDescription.Height = image.Height();
+	resourceDescription.DepthOrArraySize = 1;
 	resourceDescription.SampleDesc = {
 		// ʏ̃eNX`Ȃ̂ŃA`GCAVO͎gȂ
 		1,
 		// NIeB͍Œ
 		0
 	};
-	resourceDescription.MipLevels = m_metadata.mipLevels;
-	resourceDescription.Dimension = static_cast<D3D12_RESOURCE_DIMENSION>(m_metadata.dimension);
+	resourceDescription.MipLevels = 1;
+	resourceDescription.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
 	// CAEg͌肵Ȃ
 	resourceDescription.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
 	// ɃtOȂ
 	resourceDescription.Flags = D3D12_RESOURCE_FLAG_NONE;
 }
 
-size_t DirectXManager::AlignedSize(size_t size, size_t alignment)
-{
-	return size + alignment - size % alignment;
-}
-
 void DirectXManager::SetupTextureBufferLocation(
 	D3D12_TEXTURE_COPY_LOCATION& srcLocation,
 	D3D12_TEXTURE_COPY_LOCATION& dstLocation,
 	ID3D12Resource* uploadBuffer,
-	const TexMetadata& metadata,
-	const Image* image
-) const
-{
+	ID3D12Resource* texture,
+	const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& footprint
+) {
 	// Rs[(Abv[h)ݒ
 	srcLocation.pResource = uploadBuffer;
 	// tbgvgw
 	srcLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-	srcLocation.PlacedFootprint.Offset = 0;
-	srcLocation.PlacedFootprint.Footprint.Width = metadata.width;
-	srcLocation.PlacedFootprint.Footprint.Height = metadata.height;
-	srcLocation.PlacedFootprint.Footprint.Depth = metadata.depth;
-	srcLocation.PlacedFootprint.Footprint.RowPitch =
-		AlignedSize(image->rowPitch, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
-	srcLocation.PlacedFootprint.Footprint.Format = image->format;
+	srcLocation.PlacedFootprint = footprint;
 
 	// Rs[ݒ
-	dstLocation.pResource = m_textureBuffer.Get();
+	dstLocation.pResource = texture;
 	dstLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
 	dstLocation.SubresourceIndex = 0;
 }
 
-void DirectXManager::SetupTextureResourceBarrier(D3D12_RESOURCE_BARRIER& textureResourceBarrier) const
-{
-	textureResourceBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-	textureResourceBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-	textureResourceBarrier.Transition.pResource = m_textureBuffer.Get();
-	textureResourceBarrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-	textureResourceBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-	textureResourceBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-}
-
 bool DirectXManager::LoadTexture()
 {
-	// WIC eNX`̃[h
-	ScratchImage scratchImage{};
-
-	HRESULT result = LoadFromWICFile(
-		L"img/͌̋C.jpg",
-		// L"img/eBt@.jpg",
-		WIC_FLAGS_NONE,
-		&m_metadata,
-		scratchImage
-	);
-	if (FAILED(result)) {
-		DebugOutputFormatString("LoadFromWICFile Error : 0x%x\n", result);
+	// JPEG ̋t DCT ƐFϊ̓[J[ɕ
+	if (!m_imageDecoder.Initialize(&m_jobSystem)) {
 		return false;
 	}
-	// f[^o
-	auto image = scratchImage.GetImage(0, 0, 0);
-
-	// ԃobt@[ƂẴAbv[hq[vݒ
-	D3D12_HEAP_PROPERTIES uploadHeapProperties{};
-	D3D12_RESOURCE_DESC uploadResourceDescription{};
-	SetupUploadHeap(uploadHeapProperties, uploadResourceDescription, image);
 
-	// ԃobt@[쐬
-	ComPtr<ID3D12Resource> uploadBuffer;
-	result = m_device->CreateCommittedResource(
-		&uploadHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&uploadResourceDescription,
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(uploadBuffer.ReleaseAndGetAddressOf())
+	// ^CœǂݍނƂ͂ł͉Abv[hA`Ō^C Render œǂݍށB
+	// ̎lp`͕`Ȃ̂ŁÃeNX`ǂݍ܂Ȃ
+	if (m_textureStreaming) {
+		if (!m_tiledTexture.Initialize(m_device.Get(), m_imageDecoder, kTexturePath, kTileStreamingSettings)) {
+			return false;
+		}
+		m_textureBuffer = m_tiledTexture.Resource();
+		return true;
+	}
+	if (!UploadTexture(kTexturePath, false, m_textureBuffer, m_textureFormat, m_textureMipCount)) {
+		return false;
+	}
+	// L[ɑĐςނ̂ŁA`L[͌̃̕tFX҂Ă΂悢
+	return UploadTexture(
+		kTransparentTexturePath,
+		true,
+		m_transparentTexture,
+		m_transparentTextureFormat,
+		m_transparentTextureMipCount
 	);
-	if (FAILED(result)) {
-		DebugOutputFormatString("CreateCommittedResource Error (for upload texture): 0x%x\n", result);
+}
+
+bool DirectXManager::UploadTexture(
+	const wchar_t* path,
+	bool premultiply,
+	ComPtr<ID3D12Resource>& texture,
+	DXGI_FORMAT& format,
+	UINT& mipCount
+) {
+	if (m_gpuTextureConversion) {
+		const uint32_t flags = premultiply ? m_textureConversionFlags | kConvertPremultiply : m_textureConversionFlags;
+		return ConvertTextureOnGpu(path, flags, texture, format, mipCount);
+	}
+
+	// wb_[ǂށBfR[h̓Abv[hobt@[ɒڍsB
+	// tH[}bg sRGB ̎w 16bit ̉摜Ȃ炻ɍ킹(ȑO DirectXTex  LoadFromWICFile Ɠ)
+	ImageSource image;
+	if (!m_imageDecoder.OpenTexture(path, image)) {
 		return false;
 	}
+	format = image.Format();
+	mipCount = 1;
 
 	// eNX`̂߂̃q[vݒ
 	D3D12_HEAP_PROPERTIES textureHeapProperties{};
 	D3D12_RESOURCE_DESC resourceDescription{};
-	SetupTextureHeap(textureHeapProperties, resourceDescription);
+	SetupTextureHeap(textureHeapProperties, resourceDescription, image);
 
-	result = m_device->CreateCommittedResource(
+	HRESULT result = m_device->CreateCommittedResource(
 		&textureHeapProperties,
 		// ɎwȂ
 		D3D12_HEAP_FLAG_NONE,
@@ -873,14 +1452,30 @@ bool DirectXManager::LoadTexture()
 		// Rs[
 		D3D12_RESOURCE_STATE_COPY_DEST,
 		nullptr,
-		IID_PPV_ARGS(m_textureBuffer.ReleaseAndGetAddressOf())
+		IID_PPV_ARGS(texture.ReleaseAndGetAddressOf())
 	);
 	if (FAILED(result)) {
 		DebugOutputFormatString("CreateCommittedResource Error (for texture): 0x%x\n", result);
 		return false;
 	}
 
-	// image->pixels Ɠ^ɂ
+	// Abv[hobt@[ł̔zu(ssb`̃ACg)₢킹
+	D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint{};
+	UINT64 uploadSize = 0;
+	m_device->GetCopyableFootprints(&resourceDescription, 0, 1, 0, &footprint, nullptr, nullptr, &uploadSize);
+
+	// ԃobt@[쐬
+	ComPtr<ID3D12Resource> uploadBuffer;
+	if (!CreateBuffer(
+			D3D12_HEAP_TYPE_UPLOAD,
+			uploadSize,
+			D3D12_RESOURCE_FLAG_NONE,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			uploadBuffer
+		)) {
+		return false;
+	}
+
 	uint8_t* mapForImage = nullptr;
 	result = uploadBuffer->Map(
 		0,
@@ -891,20 +1486,29 @@ bool DirectXManager::LoadTexture()
 		DebugOutputFormatString("Upload buffer map Error : 0x%x\n", result);
 		return false;
 	}
-	// sb`CRs[
-	uint8_t* sourceAddress = image->pixels;
-	size_t rowPitch = AlignedSize(image->rowPitch, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
-	for (size_t y = 0; y < image->height; ++y) {
-		std::copy_n(
-			sourceAddress,
-			rowPitch,
-			mapForImage
+	// tbgvg̍ssb`ł̂܂܃fR[ĥŁA摜ɏ̂1񂾂B
+	// a |Ƃ́ACgRoC̃Abv[hobt@[ǂݕԂȂ悤 CPU Ŋ|Ă珑
+	const bool decoded = premultiply ?
+		DecodePremultiplied(
+			image,
+			mapForImage + footprint.Offset,
+			footprint.Footprint.RowPitch
+		) :
+		image.CopyPixels(
+			mapForImage + footprint.Offset,
+			footprint.Footprint.RowPitch,
+			static_cast<size_t>(uploadSize - footprint.Offset)
 		);
-		// 1sƂ̂܂킹
-		sourceAddress += image->rowPitch;
-		mapForImage += rowPitch;
-	}
 	uploadBuffer->Unmap(0, nullptr);
+	if (!decoded) {
+		return false;
+	}
+	DebugOutputFormatString(
+		"Texture decoded into upload buffer : %u x %u, %llu bytes\n",
+		image.Width(),
+		image.Height(),
+		uploadSize
+	);
 
 	D3D12_TEXTURE_COPY_LOCATION srcLocation{};
 	D3D12_TEXTURE_COPY_LOCATION dstLocation{};
@@ -912,11 +1516,16 @@ bool DirectXManager::LoadTexture()
 		srcLocation,
 		dstLocation,
 		uploadBuffer.Get(),
-		m_metadata,
-		image
+		texture.Get(),
+		footprint
 	);
 
-	m_commandList->CopyTextureRegion(
+	// Rs[̓Rs[L[ōsA`L[Ƃ͕sĐi߂
+	ComPtr<ID3D12GraphicsCommandList> copyCommandList;
+	if (!m_queues.Copy().BeginCommandList(copyCommandList)) {
+		return false;
+	}
+	copyCommandList->CopyTextureRegion(
 		&dstLocation,
 		0,
 		0,
@@ -924,41 +1533,58 @@ bool DirectXManager::LoadTexture()
 		&srcLocation,
 		nullptr
 	);
-
-	D3D12_RESOURCE_BARRIER textureResourceBarrier = {};
-	SetupTextureResourceBarrier(textureResourceBarrier);
-
-	m_commandList->ResourceBarrier(1, &textureResourceBarrier);
-	result = m_commandList->Close();
-	if (FAILED(result)) {
-		DebugOutputFormatString("Command list close Error : 0x%x\n", result);
+	// Rs[L[ł PIXEL_SHADER_RESOURCE ւ̑JڂłȂB
+	// Rs[L[Ŏg\[X͊ COMMON ɖ߂A`L[ŎgƂɈÖقɏîŃoA͕sv
+	const UINT64 uploadFenceValue = m_queues.Copy().Submit(copyCommandList.Get());
+	if (uploadFenceValue == 0) {
 		return false;
 	}
 
-	// R}hXgs
-	ID3D12CommandList* commandLists[] = { m_commandList.Get() };
-	m_commandQueue->ExecuteCommandLists(1, commandLists);
-	
-	m_commandQueue->Signal(m_fence.Get(), ++m_fenceValue);
-	if (m_fence->GetCompletedValue() != m_fenceValue) {
-		auto event = CreateEvent(nullptr, false, false, nullptr);
-		m_fence->SetEventOnCompletion(m_fenceValue, event);
-		WaitForSingleObject(event, INFINITE);
-		CloseHandle(event);
-	}
+	// `L[͂̒l܂ GPU ő҂Bԃobt@[̓Rs[I܂ŎcĂ
+	m_textureUploadFenceValue = uploadFenceValue;
+	m_pendingUploads.push_back({ uploadBuffer, &m_queues.Copy(), uploadFenceValue });
 
+	return true;
+}
 
-	result = m_commandAllocator->Reset();
-	if (FAILED(result)) {
-		DebugOutputFormatString("Command allocator reset Error : 0x%x\n", result);
+bool DirectXManager::ConvertTextureOnGpu(
+	const wchar_t* path,
+	uint32_t flags,
+	ComPtr<ID3D12Resource>& texture,
+	DXGI_FORMAT& format,
+	UINT& mipCount
+) {
+	// ̉f̕т̂܂܊JBJPEG Ȃ RGBA ɂϊ GPU ɉ
+	ImageSource image;
+	if (!m_imageDecoder.OpenRaw(path, image)) {
 		return false;
 	}
-	result = m_commandList->Reset(m_commandAllocator.Get(), nullptr);
-	if (FAILED(result)) {
-		DebugOutputFormatString("Command list reset Error : 0x%x\n", result);
+
+	CommandQueue& computeQueue = m_queues.Compute();
+	ComPtr<ID3D12GraphicsCommandList> computeCommandList;
+	if (!computeQueue.BeginCommandList(computeCommandList)) {
+		return false;
+	}
+	ComPtr<ID3D12Resource> uploadBuffer;
+	const bool converted = m_textureConverter.Convert(
+		image,
+		flags,
+		computeCommandList.Get(),
+		texture,
+		uploadBuffer
+	);
+	// ŝ͉ςޑOȂ̂ŁÂ܂܎săR}hXgv[ɕԂ
+	const UINT64 conversionFenceValue = computeQueue.Submit(computeCommandList.Get());
+	if (!converted || conversionFenceValue == 0) {
 		return false;
 	}
 
+	const D3D12_RESOURCE_DESC textureDescription = texture->GetDesc();
+	format = textureDescription.Format;
+	mipCount = textureDescription.MipLevels;
+	// `L[͂̒l܂ GPU ő҂
+	m_textureConversionFenceValue = conversionFenceValue;
+	m_pendingUploads.push_back({ uploadBuffer, &computeQueue, conversionFenceValue });
 	return true;
 }
 
@@ -972,8 +1598,8 @@ bool DirectXManager::MakeShaderResourceView()
 	// }XN 0
 	textureHeapDesc.NodeMask = 0;
 
-	// r[͍̂Ƃ1
-	textureHeapDesc.NumDescriptors = 1;
+	// eNX`Ɣ̃eNX`2(^CœǂݍނƂ̓eNX`ƊԐڎQƃe[uƃtB[hobN)
+	textureHeapDesc.NumDescriptors = m_textureStreaming ? TiledTexture::kDescriptorCount : kTextureDescriptorCount;
 
 	// VF[_[\[Xr[p
 	textureHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
@@ -988,113 +1614,771 @@ bool DirectXManager::MakeShaderResourceView()
 		return false;
 	}
 
+	if (m_textureStreaming) {
+		m_tiledTexture.CreateViews(
+			m_textureDescriptionHeap->GetCPUDescriptorHandleForHeapStart(),
+			m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV)
+		);
+		return true;
+	}
+
+	D3D12_CPU_DESCRIPTOR_HANDLE handle = m_textureDescriptionHeap->GetCPUDescriptorHandleForHeapStart();
+	CreateTextureView(m_textureBuffer.Get(), m_textureFormat, m_textureMipCount, handle);
+	handle.ptr += kTransparentTextureDescriptor *
+		m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	CreateTextureView(m_transparentTexture.Get(), m_transparentTextureFormat, m_transparentTextureMipCount, handle);
+
+	return true;
+}
+
+void DirectXManager::CreateTextureView(
+	ID3D12Resource* texture,
+	DXGI_FORMAT format,
+	UINT mipCount,
+	D3D12_CPU_DESCRIPTOR_HANDLE handle
+) const
+{
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
 
-	srvDesc.Format = m_metadata.format;
+	srvDesc.Format = format;
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	// 2D eNX`
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-	// ~bv}bv͎gpȂ̂1
-	srvDesc.Texture2D.MipLevels = 1;
+	// GPU ŕϊƂ̓~bvׂĎg
+	srvDesc.Texture2D.MipLevels = mipCount;
+
+	m_device->CreateShaderResourceView(texture, &srvDesc, handle);
+}
+
+void DirectXManager::SetupHotReload()
+{
+	// ĎłȂĂ`ɂ͉eȂ̂Ŏs͖
+	m_hotReloader.AddWatchDirectory(L".");
+	m_hotReloader.AddWatchDirectory(L"img");
+	m_hotReloader.RegisterAsset(kVertexShaderAsset, kVertexShaderPath, true);
+	m_hotReloader.RegisterAsset(kPixelShaderAsset, kPixelShaderPath, true);
+	m_hotReloader.RegisterAsset(kTextureAsset, kTexturePath, false);
+	m_hotReloader.RegisterAsset(kTransparentTextureAsset, kTransparentTexturePath, false);
+}
+
+void DirectXManager::ApplyHotReload()
+{
+	const auto changedAssets = m_hotReloader.Poll(HotReloader::Clock::now());
+	if (changedAssets.empty()) {
+		return;
+	}
+
+	// Note: Õt[ GPU œĂ̂ŁAPSO  SRV ւOɏÎ҂
+	if (!m_framePipeline.Flush()) {
+		DebugOutputFormatString("Hot reload skipped: frame flush failed.\n");
+		return;
+	}
 
-	m_device->CreateShaderResourceView(
+	const bool vertexShaderChanged = changedAssets.count(kVertexShaderAsset) != 0;
+	const bool pixelShaderChanged = changedAssets.count(kPixelShaderAsset) != 0;
+	if (vertexShaderChanged || pixelShaderChanged) {
+		DebugOutputFormatString("Reloading shaders.\n");
+		// ςRpCBsÔ̂g
+		ComPtr<ID3D10Blob> vsBlob = m_vsBlob;
+		ComPtr<ID3D10Blob> psBlob = m_psBlob;
+		ShaderReflectionData vsReflection = m_vsReflection;
+		ShaderReflectionData psReflection = m_psReflection;
+		bool compiled = true;
+		if (vertexShaderChanged) {
+			compiled = CompileShader(kVertexShaderPath, "BasicVS", "vs_5_0", vsBlob, &vsReflection) && compiled;
+		}
+		if (pixelShaderChanged) {
+			compiled = CompileShader(kPixelShaderPath, PixelShaderEntryPoint(), "ps_5_0", psBlob, &psReflection) && compiled;
+		}
+		if (compiled) {
+			std::swap(m_vsBlob, vsBlob);
+			std::swap(m_psBlob, psBlob);
+			std::swap(m_vsReflection, vsReflection);
+			std::swap(m_psReflection, psReflection);
+			if (!SetupGraphicsPipeline()) {
+				DebugOutputFormatString("Pipeline reload failed.\n");
+				std::swap(m_vsBlob, vsBlob);
+				std::swap(m_psBlob, psBlob);
+				std::swap(m_vsReflection, vsReflection);
+				std::swap(m_psReflection, psReflection);
+			}
+		}
+	}
+
+	// ǂ炪ςĂǂݍݒ
+	if (changedAssets.count(kTextureAsset) != 0 || changedAssets.count(kTransparentTextureAsset) != 0) {
+		DebugOutputFormatString("Reloading texture.\n");
+		if (!LoadTexture() || !MakeShaderResourceView()) {
+			DebugOutputFormatString("Texture reload failed.\n");
+		}
+	}
+
+	// 蒼̂ɔԍt
+	RegisterRecorderObjects();
+}
+
+void DirectXManager::RegisterRecorderObjects()
+{
+	m_recorder.RegisterBuffer(kRecorderVertexBuffer, m_vertexBuffer.Get());
+	m_recorder.RegisterBuffer(kRecorderIndexBuffer, m_indexBuffer.Get());
+	m_recorder.RegisterTexture(
+		kRecorderTexture,
 		m_textureBuffer.Get(),
-		&srvDesc,
-		m_textureDescriptionHeap->GetCPUDescriptorHandleForHeapStart()
+		m_textureDescriptionHeap.Get(),
+		m_textureDescriptionHeap->GetGPUDescriptorHandleForHeapStart()
 	);
+	m_recorder.RegisterRootSignature(kRecorderRootSignature, m_rootSignature.Get());
+	m_recorder.RegisterPipelineState(kRecorderPipelineState, m_pipelineState.Get());
+	m_recorder.RegisterPipelineState(kRecorderTransparentPipelineState, m_transparentPipelineState.Get());
+	if (m_depthPrePass) {
+		m_recorder.RegisterPipelineState(kRecorderDepthPrePassPipelineState, m_depthPrePassPipelineState.Get());
+	}
+	// ^CœǂݍނƂ͔̂̂`Ȃ
+	if (!m_textureStreaming) {
+		D3D12_GPU_DESCRIPTOR_HANDLE transparentTextureSrv = m_textureDescriptionHeap->GetGPUDescriptorHandleForHeapStart();
+		transparentTextureSrv.ptr += kTransparentTextureDescriptor *
+			m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		m_recorder.RegisterTexture(
+			kRecorderTransparentTexture,
+			m_transparentTexture.Get(),
+			m_textureDescriptionHeap.Get(),
+			transparentTextureSrv
+		);
+	}
+}
+
+bool DirectXManager::WriteCaptureObjects(CommandRecorder& capture)
+{
+	const size_t vertexBufferSize = m_vertexCount * sizeof(Vertex);
+	bool succeeded = capture.CreateBuffer(kRecorderVertexBuffer, vertexBufferSize);
+	succeeded = capture.UploadResource(kRecorderVertexBuffer, m_vertices, vertexBufferSize, 0) && succeeded;
+	succeeded = capture.CreateBuffer(kRecorderIndexBuffer, sizeof(kIndices)) && succeeded;
+	succeeded = capture.UploadResource(kRecorderIndexBuffer, kIndices, sizeof(kIndices), 0) && succeeded;
+
+	// eNX`̒g GPU ɂȂ̂ŁAt@CfR[h
+	DecodedImage image;
+	if (!m_imageDecoder.Decode(kTexturePath, 1, image)) {
+		return false;
+	}
+	succeeded = capture.CreateTexture(kRecorderTexture, { image.width, image.height, static_cast<uint32_t>(CaptureFormat(m_textureFormat)) }) && succeeded;
+	succeeded = capture.UploadResource(
+		kRecorderTexture,
+		image.pixels.data(),
+		image.pixels.size(),
+		static_cast<uint32_t>(image.rowPitch)
+	) && succeeded;
+
+	DecodedImage transparentImage;
+	if (!m_imageDecoder.Decode(kTransparentTexturePath, 1, transparentImage)) {
+		return false;
+	}
+	PremultiplyRgba8(transparentImage.pixels.data(), transparentImage.width, transparentImage.height, transparentImage.rowPitch);
+	succeeded = capture.CreateTexture(
+		kRecorderTransparentTexture,
+		{ transparentImage.width, transparentImage.height, static_cast<uint32_t>(CaptureFormat(m_transparentTextureFormat)) }
+	) && succeeded;
+	succeeded = capture.UploadResource(
+		kRecorderTransparentTexture,
+		transparentImage.pixels.data(),
+		transparentImage.pixels.size(),
+		static_cast<uint32_t>(transparentImage.rowPitch)
+	) && succeeded;
+
+	const ComPtr<ID3DBlob> serializedRootSignature = m_rootSignatures.SerializedBlob(m_rootSignature.Get());
+	if (serializedRootSignature == nullptr) {
+		return false;
+	}
+	succeeded = capture.CreateRootSignature(
+		kRecorderRootSignature,
+		serializedRootSignature->GetBufferPointer(),
+		serializedRootSignature->GetBufferSize()
+	) && succeeded;
+
+	RecorderPipelineDescription pipeline;
+	pipeline.rootSignature = kRecorderRootSignature;
+	const uint8_t* vertexShader = static_cast<const uint8_t*>(m_vsBlob->GetBufferPointer());
+	pipeline.vertexShader.assign(vertexShader, vertexShader + m_vsBlob->GetBufferSize());
+	const uint8_t* pixelShader = static_cast<const uint8_t*>(m_psBlob->GetBufferPointer());
+	pipeline.pixelShader.assign(pixelShader, pixelShader + m_psBlob->GetBufferSize());
+	for (const D3D12_INPUT_ELEMENT_DESC& element : MakeInputLayout(m_vsReflection)) {
+		pipeline.inputLayout.push_back({ element.SemanticName, element.SemanticIndex, static_cast<uint32_t>(element.Format) });
+	}
+	pipeline.renderTargetFormat = PostProcessChain::kHdrFormat;
+	pipeline.primitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	pipeline.depthStencilFormat = kDepthFormat;
+	pipeline.depthMode = m_depthPrePass ? kDepthTestOnly : kDepthWrite;
+	succeeded = capture.CreatePipelineState(kRecorderPipelineState, pipeline) && succeeded;
+
+	pipeline.blendMode = kBlendPremultipliedAlpha;
+	pipeline.depthMode = kDepthTestOnly;
+	succeeded = capture.CreatePipelineState(kRecorderTransparentPipelineState, pipeline) && succeeded;
+
+	if (m_depthPrePass) {
+		pipeline.pixelShader.clear();
+		pipeline.blendMode = kBlendColorWriteDisabled;
+		pipeline.depthMode = kDepthWrite;
+		succeeded = capture.CreatePipelineState(kRecorderDepthPrePassPipelineState, pipeline) && succeeded;
+	}
+	return succeeded;
+}
+
+void DirectXManager::RequestFrameCapture(const std::string& path)
+{
+	// ^C̓ǂݍ݂̓Lv`Ɋ܂߂Ȃ
+	if (m_textureStreaming) {
+		DebugOutputFormatString("Frame capture is not supported with texture streaming.\n");
+		return;
+	}
+	// Lv`ɂ CPU ŃfR[heNX`̂ŁAGPU ŕϊ`ƍȂ
+	if (m_gpuTextureConversion) {
+		DebugOutputFormatString("Frame capture is not supported with GPU texture conversion.\n");
+		return;
+	}
+	m_capturePath = path;
+}
+
+bool DirectXManager::ReplayFrameCapture(const std::string& path)
+{
+	std::vector<uint8_t> capture;
+	if (!LoadCapture(path, capture)) {
+		DebugOutputFormatString("Capture not found : %s\n", path.c_str());
+		return false;
+	}
+
+	// ς񂾃t[Î҂Ă΁AXbg 0  HDR ^[Qbg؂Ă悢
+	if (!m_framePipeline.Flush()) {
+		return false;
+	}
+	ComPtr<ID3D12GraphicsCommandList> commandList;
+	CommandQueue& directQueue = m_queues.Direct();
+	if (!directQueue.BeginCommandList(commandList)) {
+		return false;
+	}
+	m_postProcess.BeginRendering(commandList.Get(), 0);
+	// Đp̃IuWFNg͂̊֐𔲂Ɖ
+	D3D12CommandRecorder replay;
+	if (!replay.Initialize(m_device.Get(), 16)) {
+		return false;
+	}
+	replay.SetCommandList(commandList.Get());
+	replay.SetRenderTarget(m_postProcess.HdrRenderTargetView(0));
+	replay.SetDepthStencil(m_dsvHeap->GetCPUDescriptorHandleForHeapStart());
+
+	ReplayReport report;
+	const bool replayed = ReplayCapture(capture, replay, report);
+	const UINT64 fenceValue = directQueue.Submit(commandList.Get());
+	if (fenceValue == 0) {
+		return false;
+	}
+	directQueue.WaitForFenceValue(fenceValue);
+	if (!replayed) {
+		DebugOutputFormatString("Capture replay failed : %s\n", path.c_str());
+		return false;
+	}
+	DebugOutputFormatString("Replayed %s\n%s", path.c_str(), FormatReplayReport(report).c_str());
 
+	// Lv` GPU ȂōĐƁAhCo[L^̎Ԃ
+	NullCommandRecorder nullRecorder(true);
+	if (ReplayCapture(capture, nullRecorder, report)) {
+		DebugOutputFormatString("Replayed %s (null)\n%s", path.c_str(), FormatReplayReport(report).c_str());
+	}
+	nullRecorder.Finish();
+	for (const std::string& error : nullRecorder.Errors()) {
+		DebugOutputFormatString("Capture validation : %s\n", error.c_str());
+	}
 	return true;
 }
 
-bool DirectXManager::Render()
+void DirectXManager::RunRecorderBenchmark() const
 {
-	const UINT backBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
+	for (uint32_t drawCount = 1000; drawCount <= 1000000; drawCount *= 10) {
+		const NullRecorderBenchmarkResult result = RunNullRecorderBenchmark(drawCount, false);
+		DebugOutputFormatString("%s", FormatNullRecorderBenchmark(result).c_str());
+	}
+}
 
-	// Note: oAݒ
-	D3D12_RESOURCE_BARRIER barrier{};
-	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-	barrier.Transition = {
-		m_backBuffers[backBufferIndex].Get(),
-		0,
-		D3D12_RESOURCE_STATE_PRESENT,
-		D3D12_RESOURCE_STATE_RENDER_TARGET
-	};
-	m_commandList->ResourceBarrier(1, &barrier);
+void DirectXManager::OnKeyDown(unsigned int virtualKey)
+{
+	// F9 ŋL^̃x`}[NAF11 Ŏ̃t[Lv`AF12 łĐ
+	RenderCommand command;
+	switch (virtualKey)
+	{
+	case VK_F9:
+		command.type = RenderCommand::kRunRecorderBenchmark;
+		break;
 
-	// Note: _[^[Qbg̐ݒ
-	D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
-	rtvHandle.ptr += backBufferIndex * m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
-	m_commandList->OMSetRenderTargets(1, &rtvHandle, true, nullptr);
+	case VK_F11:
+		command.type = RenderCommand::kCaptureFrame;
+		break;
 
-	// Note: ʂNA
-	float clearColor[] = { 1.0f, 1.0f, 0.0f, 1.0f };
-	m_commandList->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
+	case VK_F12:
+		command.type = RenderCommand::kReplayCapture;
+		break;
 
-	m_commandList->SetPipelineState(m_pipelineState.Get());
+	default:
+		return;
+	}
 
-	m_commandList->SetGraphicsRootSignature(m_rootSignature.Get());
-	m_commandList->RSSetViewports(1, &m_viewport);
-	m_commandList->RSSetScissorRects(1, &m_scissorRect);
+	// `Xbh΁AD3D ̃IuWFNgɐG鏈͂ōs
+	if (!m_renderThread.IsRunning()) {
+		ExecuteRenderCommand(command);
+	} else if (!m_renderThread.PostCommand(command)) {
+		DebugOutputFormatString("Render command queue is full.\n");
+	}
+}
 
-	ID3D12DescriptorHeap* heaps[] = { m_textureDescriptionHeap.Get() };
-	m_commandList->SetDescriptorHeaps(1, heaps);
-	m_commandList->SetGraphicsRootDescriptorTable(
-		// [gp[^[CfbNX
-		0,
-		// q[vAhX
-		m_textureDescriptionHeap->GetGPUDescriptorHandleForHeapStart()
+void DirectXManager::OnResize(unsigned int width, unsigned int height, bool sizing)
+{
+	// ۂɍ蒼̂́A傫t[pPbgŎ󂯎`摤
+	m_resizeDebouncer.OnResize(width, height, sizing, ResizeDebouncer::Clock::now());
+}
+
+void DirectXManager::ExecuteRenderCommand(const RenderCommand& command)
+{
+	switch (command.type)
+	{
+	case RenderCommand::kCaptureFrame:
+		RequestFrameCapture(kFrameCapturePath);
+		break;
+
+	case RenderCommand::kReplayCapture:
+		ReplayFrameCapture(kFrameCapturePath);
+		break;
+
+	case RenderCommand::kRunRecorderBenchmark:
+		RunRecorderBenchmark();
+		break;
+	}
+}
+
+void DirectXManager::StartRenderThread()
+{
+	m_renderThread.Start(
+		[this](const FramePacket& packet) { return Render(packet); },
+		[this](const RenderCommand& command) { ExecuteRenderCommand(command); }
 	);
+}
 
-	m_commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+void DirectXManager::StopRenderThread()
+{
+	m_renderThread.Stop();
+}
 
-	m_commandList->IASetVertexBuffers(0, 1, &m_vertexBufferView);
+bool DirectXManager::Update()
+{
+	if (!m_renderThread.IsRunning()) {
+		FramePacket packet;
+		FillFramePacket(packet);
+		return Render(packet);
+	}
+	if (m_renderThread.Failed()) {
+		return false;
+	}
 
-	m_commandList->IASetIndexBuffer(&m_indexBufferView);
+	// `Xbh2ƂĂԂ́A͂󂯕tȂ󂭂̂҂
+	FramePacket* packet = m_renderThread.BeginFramePacket();
+	if (packet == nullptr) {
+		WaitWindowMessage(1);
+		return true;
+	}
+	FillFramePacket(*packet);
+	m_renderThread.SubmitFramePacket(packet);
+	return true;
+}
 
-	m_commandList->DrawIndexedInstanced(6, 1, 0, 0, 0);
+void DirectXManager::RecordSortedDraws(
+	CommandRecorder& recorder,
+	const std::vector<DrawItem>& drawItems,
+	const DrawSortKey* keys,
+	size_t count,
+	UINT textureParameterIndex,
+	RecorderObjectId& pipelineState,
+	RecorderObjectId& texture
+) {
+	for (size_t i = 0; i < count; ++i) {
+		const DrawItem& drawItem = drawItems[DrawSortKeyIndex(keys[i])];
+		// [gVOl`͂ǂ̃pCvCȂ̂ŁAݒ肵̂̓pCvCƃeNX`
+		if (drawItem.pipelineState != pipelineState) {
+			pipelineState = drawItem.pipelineState;
+			recorder.SetPipelineState(pipelineState);
+		}
+		if (drawItem.texture != texture) {
+			texture = drawItem.texture;
+			recorder.SetGraphicsRootTexture(textureParameterIndex, texture);
+		}
+		recorder.DrawIndexedInstanced(drawItem.indexCount, 1, drawItem.startIndex, drawItem.baseVertex, 0);
+	}
+}
 
+void DirectXManager::ReleaseCompletedUploads()
+{
+	m_pendingUploads.erase(
+		std::remove_if(
+			m_pendingUploads.begin(),
+			m_pendingUploads.end(),
+			[](const PendingUpload& upload) { return upload.queue->IsComplete(upload.fenceValue); }
+		),
+		m_pendingUploads.end()
+	);
+}
 
-	// Note: oA
-	std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
-	m_commandList->ResourceBarrier(1, &barrier);
+bool DirectXManager::Render(const FramePacket& packet)
+{
+	ApplyHotReload();
+	ReleaseCompletedUploads();
 
-	// Note: R}hXgtI
-	HRESULT result = m_commandList->Close();
-	if (FAILED(result)) {
-		DebugOutputFormatString("Command list close Error : 0x%x\n", result);
-		return false;
+	if (packet.width != m_backBufferWidth || packet.height != m_backBufferHeight) {
+		if (!ResizeSwapChain(packet.width, packet.height)) {
+			return false;
+		}
 	}
 
-	// Note: R}hXgs
-	ID3D12CommandList* commandLists[] = { m_commandList.Get() };
-	m_commandQueue->ExecuteCommandLists(1, commandLists);
-	// Note: GPU ҂
-	m_commandQueue->Signal(m_fence.Get(), ++m_fenceValue);
+	m_frustum = Frustum::FromViewProjection(packet.viewProjection);
+
+	// Note: ̃t[̃XbgOɎgt[ GPU ŏI܂ő҂
+	bool slotReused = false;
+	const uint32_t slot = m_framePipeline.BeginFrame(slotReused);
+	FrameSlot& frameSlot = m_frameSlots[slot];
 
-	if (m_fence->GetCompletedValue() != m_fenceValue) {
-		auto event = CreateEvent(nullptr, false, false, nullptr);
-		m_fence->SetEventOnCompletion(m_fenceValue, event);
-		WaitForSingleObject(event, INFINITE);
-		CloseHandle(event);
+	// It[ GPU (framesInFlight t[Ô)Ŕ{ߒ
+	double gpuMilliseconds = 0.0;
+	if (slotReused) {
+		gpuMilliseconds = m_gpuTimer.ReadMilliseconds(slot);
+		if (m_dynamicResolution) {
+			m_resolutionController.Update(gpuMilliseconds);
+		}
+		if (m_frameTimeTrace.is_open()) {
+			m_frameTimeTrace << gpuMilliseconds << '\n';
+		}
 	}
 
-	// Note: NA
-	result = m_commandAllocator->Reset();
+	// Note: Xbg̃AP[^[ŃR}hXgJ
+	HRESULT result = frameSlot.commandAllocator->Reset();
 	if (FAILED(result)) {
 		DebugOutputFormatString("Command allocator reset Error : 0x%x\n", result);
 		return false;
 	}
-	result = m_commandList->Reset(m_commandAllocator.Get(), nullptr);
+	result = m_commandList->Reset(frameSlot.commandAllocator.Get(), nullptr);
 	if (FAILED(result)) {
 		DebugOutputFormatString("Command list reset Error : 0x%x\n", result);
 		return false;
 	}
 
+	// Note: Õt[Ō^CA`Ƀ}bvďށB
+	// Abv[hpEǂݖ߂p̃obt@[1gȂ̂ŁAgÕt[̕`҂
+	if (m_textureStreaming) {
+		m_framePipeline.WaitForDirectQueue();
+		if (!m_tiledTexture.Update(m_queues.Direct().Get(), m_commandList.Get(), packet.frameIndex)) {
+			// r܂ŋL^Rs[͐ς܂Ɏ̂ĂBJ܂܂Ǝ Reset s
+			m_commandList->Close();
+			return false;
+		}
+	}
+
+	// Note: GPU Ԃ猈߂{ŁAHDR ^[Qbg̍ゾɕ`
+	const float renderScale = m_dynamicResolution ? m_resolutionController.Scale() : 1.0f;
+	uint32_t renderWidth = 0;
+	uint32_t renderHeight = 0;
+	ScaledRenderSize(m_postProcess.Width(), m_postProcess.Height(), renderScale, renderWidth, renderHeight);
+	SetupViewportAndScissor(renderWidth, renderHeight);
+
+	m_gpuTimer.Begin(m_commandList.Get(), slot);
+
+	// Note: Lv`t[́AL^Ăяot@Cɂ
+	CommandRecorder* recorder = &m_recorder;
+	std::unique_ptr<CaptureRecorder> capture;
+	if (!m_capturePath.empty()) {
+		capture.reset(new CaptureRecorder(&m_recorder));
+		if (!WriteCaptureObjects(*capture)) {
+			DebugOutputFormatString("Frame capture failed.\n");
+			capture.reset();
+			m_capturePath.clear();
+		} else {
+			recorder = capture.get();
+		}
+	}
+	// ExecuteIndirect ̓Lv`łȂ̂ŁALv`t[ CPU ŃJO`L^
+	const bool gpuDrivenRendering = m_gpuDrivenRendering && capture == nullptr;
+
+	// Note: _[^[Qbg̐ݒ(Oɂ̃Xbgŕ` HDR ^[Qbg̓|XgvZX̓͂ɂȂĂ)
+	m_postProcess.BeginRendering(m_commandList.Get(), slot);
+	m_recorder.SetRenderTarget(m_postProcess.HdrRenderTargetView(slot));
+	m_recorder.SetDepthStencil(m_dsvHeap->GetCPUDescriptorHandleForHeapStart());
+	recorder->BeginFrame();
+
+	// Note: ʂNA
+	const float clearColor[] = { 1.0f, 1.0f, 0.0f, 1.0f };
+	recorder->ClearRenderTarget(clearColor);
+	recorder->ClearDepth(kDepthClearValue);
+
+	if (gpuDrivenRendering) {
+		RecordGpuCulling();
+	}
+
+	// `̓rŐ؂ւ̂ŁAݒ肵Ă̂oĂ
+	RecorderObjectId pipelineState = kRecorderPipelineState;
+	RecorderObjectId texture = kRecorderTexture;
+	recorder->SetPipelineState(pipelineState);
+
+	recorder->SetGraphicsRootSignature(kRecorderRootSignature);
+	recorder->SetViewport({
+		m_viewport.TopLeftX,
+		m_viewport.TopLeftY,
+		m_viewport.Width,
+		m_viewport.Height,
+		m_viewport.MinDepth,
+		m_viewport.MaxDepth
+	});
+	recorder->SetScissorRect({ m_scissorRect.left, m_scissorRect.top, m_scissorRect.right, m_scissorRect.bottom });
+
+	// [gp[^[CfbNX̓tNV
+	recorder->SetGraphicsRootTexture(m_textureParameterIndex, texture);
+	if (m_textureStreaming) {
+		// q[v̑ɒuĂBLv`Ȃ̂Œڐݒ肷
+		const UINT descriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+		D3D12_GPU_DESCRIPTOR_HANDLE handle = m_textureDescriptionHeap->GetGPUDescriptorHandleForHeapStart();
+		handle.ptr += descriptorSize;
+		m_commandList->SetGraphicsRootDescriptorTable(m_tileIndirectionParameterIndex, handle);
+		handle.ptr += descriptorSize;
+		m_commandList->SetGraphicsRootDescriptorTable(m_tileFeedbackParameterIndex, handle);
+	}
+
+	recorder->SetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	recorder->SetVertexBuffer(kRecorderVertexBuffer, m_vertexBufferView.SizeInBytes, m_vertexBufferView.StrideInBytes);
+
+	recorder->SetIndexBuffer(kRecorderIndexBuffer, m_indexBufferView.SizeInBytes, m_indexBufferView.Format);
+
+	const Float4x4& viewProjection = packet.viewProjection;
+	if (gpuDrivenRendering) {
+		// GPU ŃJOʂ̂܂ܕ`悷(בւ͂Ȃ)BvpXł͓Ő[xɕ`
+		const auto executeCulledDraws = [this]() {
+			m_commandList->ExecuteIndirect(
+				m_commandSignature.Get(),
+				static_cast<UINT>(m_drawItems.size()),
+				m_visibleArgumentsBuffer.Get(),
+				0,
+				m_visibleCountBuffer.Get(),
+				0
+			);
+		};
+		if (m_depthPrePass) {
+			recorder->SetPipelineState(kRecorderDepthPrePassPipelineState);
+			executeCulledDraws();
+			recorder->SetPipelineState(pipelineState);
+		}
+		executeCulledDraws();
+
+		// ̃t[̊Jn̏Ԃɖ߂
+		const D3D12_RESOURCE_BARRIER fromIndirect[] = {
+			CD3DX12_RESOURCE_BARRIER::Transition(
+				m_visibleArgumentsBuffer.Get(),
+				D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,
+				D3D12_RESOURCE_STATE_UNORDERED_ACCESS
+			),
+			CD3DX12_RESOURCE_BARRIER::Transition(
+				m_visibleCountBuffer.Get(),
+				D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT,
+				D3D12_RESOURCE_STATE_COPY_DEST
+			),
+		};
+		m_commandList->ResourceBarrier(_countof(fromIndirect), fromIndirect);
+	} else {
+		// Ă̂ApCvCƃeNX`̂܂Ƃ߁A̒ł͎O`悷
+		uint32_t* visibleDrawIndices = m_frameArena.AllocateArray<uint32_t>(m_drawBounds.Size());
+		size_t visibleCount = CullAabbs(m_frustum, m_drawBounds, visibleDrawIndices);
+		DrawSortKey* sortKeys = m_frameArena.AllocateArray<DrawSortKey>(visibleCount);
+		DrawSortKey* sortScratch = m_frameArena.AllocateArray<DrawSortKey>(visibleCount);
+		if (m_occlusionCulling) {
+			visibleCount = CullOccludedDraws(visibleDrawIndices, visibleCount, viewProjection, sortKeys, sortScratch);
+		}
+		for (size_t i = 0; i < visibleCount; ++i) {
+			const uint32_t drawIndex = visibleDrawIndices[i];
+			const DrawItem& drawItem = m_drawItems[drawIndex];
+			const float depth = ProjectedDepth(m_drawBounds, drawIndex, viewProjection);
+			sortKeys[i] = MakeDrawSortKey(OpaqueDrawOrder(drawItem.pipelineState, drawItem.texture, depth), drawIndex);
+		}
+		RadixSortDrawKeys(sortKeys, sortScratch, visibleCount);
+		if (m_depthPrePass) {
+			// [xȂ̂ŃeNX`͐؂ւȂ
+			recorder->SetPipelineState(kRecorderDepthPrePassPipelineState);
+			for (size_t i = 0; i < visibleCount; ++i) {
+				const DrawItem& drawItem = m_drawItems[DrawSortKeyIndex(sortKeys[i])];
+				recorder->DrawIndexedInstanced(drawItem.indexCount, 1, drawItem.startIndex, drawItem.baseVertex, 0);
+			}
+			recorder->SetPipelineState(pipelineState);
+		}
+		RecordSortedDraws(
+			*recorder,
+			m_drawItems,
+			sortKeys,
+			visibleCount,
+			m_textureParameterIndex,
+			pipelineState,
+			texture
+		);
+	}
+
+	// Note: ͕̂̂sׂĕ`ƂɁA珇ɏd˂(^CœǂݍނƂ͕`Ȃ)B
+	// s CPU ŃJOt[́ÂƂh[xŉBꂽ̂̂Ă
+	if (!m_textureStreaming) {
+		const OcclusionBuffer* occlusionBuffer = m_occlusionCulling && !gpuDrivenRendering ? &m_occlusionBuffer : nullptr;
+		uint32_t* visibleDrawIndices = m_frameArena.AllocateArray<uint32_t>(m_transparentBounds.Size());
+		const size_t visibleCount = CullAabbs(m_frustum, m_transparentBounds, visibleDrawIndices, occlusionBuffer);
+		DrawSortKey* sortKeys = m_frameArena.AllocateArray<DrawSortKey>(visibleCount);
+		DrawSortKey* sortScratch = m_frameArena.AllocateArray<DrawSortKey>(visibleCount);
+		for (size_t i = 0; i < visibleCount; ++i) {
+			const uint32_t drawIndex = visibleDrawIndices[i];
+			const float depth = ProjectedDepth(m_transparentBounds, drawIndex, viewProjection);
+			sortKeys[i] = MakeDrawSortKey(BackToFrontOrder(depth), drawIndex);
+		}
+		RadixSortDrawKeys(sortKeys, sortScratch, visibleCount);
+		RecordSortedDraws(
+			*recorder,
+			m_transparentDrawItems,
+			sortKeys,
+			visibleCount,
+			m_textureParameterIndex,
+			pipelineState,
+			texture
+		);
+	}
+	recorder->EndFrame();
+
+	if (m_textureStreaming) {
+		m_tiledTexture.ResolveFeedback(m_commandList.Get());
+	}
+
+	if (capture != nullptr) {
+		if (capture->Save(m_capturePath)) {
+			DebugOutputFormatString("Frame captured : %s (%zu bytes)\n", m_capturePath.c_str(), capture->Bytes().size());
+		} else {
+			DebugOutputFormatString("Frame capture write failed : %s\n", m_capturePath.c_str());
+		}
+		m_capturePath.clear();
+	}
+
+	// Note: |XgvZX̓Rs[gL[ŁÃt[̕`悪IĂs
+	m_postProcess.EndRendering(m_commandList.Get(), slot);
+	frameSlot.postProcessSettings = m_postProcessSettings;
+	frameSlot.renderWidth = renderWidth;
+	frameSlot.renderHeight = renderHeight;
+
+	m_gpuTimer.End(m_commandList.Get(), slot);
+
+	// Note: R}hXgtI
+	result = m_commandList->Close();
+	if (FAILED(result)) {
+		DebugOutputFormatString("Command list close Error : 0x%x\n", result);
+		// sXg͊JĂÂ܂ܕԂɂĂB
+		// J܂܂ƁAfXgN^[ ReplayFrameCapture ł Reset s
+		m_commandList->Reset(frameSlot.commandAllocator.Get(), nullptr);
+		m_commandList->Close();
+		m_frameArena.Reset();
+		return false;
+	}
+
+	// Note: `ς݁A1Õt[ Present Ãt[̃|XgvZXςށBGPU ̊͑҂Ȃ
+	if (!m_framePipeline.EndFrame()) {
+		m_frameArena.Reset();
+		return false;
+	}
+
+	// Note: t[Ɋmۂ̂͋L^ɂg CPU ̃f[^Ȃ̂ŁAςݏÎĂ
+	m_frameArena.Reset();
+
+	if (packet.frameIndex % kFrameStatsInterval == 0) {
+		const FrameArena::Stats& arenaStats = m_frameArena.LastFrameStats();
+		DebugOutputFormatString(
+			"frame %llu : gpu %.2f ms, arena %llu allocations %llu bytes (%zu chunks, %zu bytes reserved)\n",
+			static_cast<unsigned long long>(packet.frameIndex),
+			gpuMilliseconds,
+			static_cast<unsigned long long>(arenaStats.allocationCount),
+			static_cast<unsigned long long>(arenaStats.allocatedBytes),
+			arenaStats.chunkCount,
+			arenaStats.reservedBytes
+		);
+		if (m_textureStreaming) {
+			const TileStreamer::Stats& tileStats = m_tiledTexture.Streamer().LastStats();
+			DebugOutputFormatString(
+				"tiles : %u requested, %u resident, %u uploaded, %u evicted\n",
+				tileStats.requestedTiles,
+				tileStats.residentTiles,
+				tileStats.uploadedTiles,
+				tileStats.evictedTiles
+			);
+		}
+	}
+
+	return true;
+}
+
+uint64_t DirectXManager::SubmitGraphics(uint32_t)
+{
+	// Note: eNX`̃Rs[(GPU ŕϊƂ͕ϊ)IĂ`悷
+	CommandQueue& directQueue = m_queues.Direct();
+	directQueue.WaitForQueue(m_queues.Copy(), m_textureUploadFenceValue);
+	directQueue.WaitForQueue(m_queues.Compute(), m_textureConversionFenceValue);
+
+	ID3D12CommandList* commandLists[] = { m_commandList.Get() };
+	directQueue.Get()->ExecuteCommandLists(1, commandLists);
+	return directQueue.Signal();
+}
+
+uint64_t DirectXManager::SubmitPostProcess(uint32_t slot)
+{
+	CommandQueue& computeQueue = m_queues.Compute();
+	ComPtr<ID3D12GraphicsCommandList> commandList;
+	if (!computeQueue.BeginCommandList(commandList)) {
+		return 0;
+	}
+	const FrameSlot& frameSlot = m_frameSlots[slot];
+	m_postProcess.Record(
+		commandList.Get(),
+		slot,
+		frameSlot.postProcessSettings,
+		frameSlot.renderWidth,
+		frameSlot.renderHeight
+	);
+	return computeQueue.Submit(commandList.Get());
+}
+
+uint64_t DirectXManager::SubmitPresent(uint32_t slot)
+{
+	// Note: Xbv`F[͕`L[ō̂ŁAobNobt@[ւ̃Rs[ Present `L[ōs
+	CommandQueue& directQueue = m_queues.Direct();
+	ComPtr<ID3D12GraphicsCommandList> commandList;
+	if (!directQueue.BeginCommandList(commandList)) {
+		return 0;
+	}
+	const UINT backBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
+	m_postProcess.RecordCopyToOutput(commandList.Get(), slot, m_backBuffers[backBufferIndex].Get());
+	if (directQueue.Submit(commandList.Get()) == 0) {
+		return 0;
+	}
+
 	// Note: Flip
 	m_swapChain->Present(1, 0);
+	return directQueue.Signal();
+}
 
-	return true;
+void DirectXManager::WaitOnGpu(GpuQueueType queue, GpuQueueType signalingQueue, uint64_t fenceValue)
+{
+	FrameQueue(queue).WaitForQueue(FrameQueue(signalingQueue), fenceValue);
+}
+
+void DirectXManager::WaitOnCpu(GpuQueueType queue, uint64_t fenceValue)
+{
+	// ܂ςłȂ΁AL[ȂĂĂ΂
+	if (fenceValue == 0) {
+		return;
+	}
+	FrameQueue(queue).WaitForFenceValue(fenceValue);
+}
+
+CommandQueue& DirectXManager::FrameQueue(GpuQueueType queue)
+{
+	return queue == GpuQueueType::Compute ? m_queues.Compute() : m_queues.Direct();
 }
 }
 }
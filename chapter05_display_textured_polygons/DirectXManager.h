@@ -1,14 +1,42 @@
 #pragma once
 #include <d3d12.h>
-#include <DirectXTex.h>
+#include <DirectXMath.h>
 #include <dxgi1_6.h>
 #include <wrl.h>
+#include <array>
+#include <fstream>
+#include <string>
+
+#include "AdapterSelection.h"
+#include "CommandQueue.h"
+#include "Culling.h"
+#include "D3D12CommandRecorder.h"
+#include "DrawSorting.h"
+#include "DxbcReflection.h"
+#include "DynamicResolution.h"
+#include "FrameArena.h"
+#include "FramePipeline.h"
+#include "GpuTimer.h"
+#include "HotReload.h"
+#include "ImageDecoder.h"
+#include "IndirectDraw.h"
+#include "JobSystem.h"
+#include "PostProcess.h"
+#include "RenderThread.h"
+#include "ResizeDebouncer.h"
+#include "RootSignatureBuilder.h"
+#include "SwapChainResize.h"
+#include "TextureConverter.h"
+#include "TiledTexture.h"
+#include "Win32Window.h"
 
 using Microsoft::WRL::ComPtr;
 
 namespace yuxx {
 namespace DirectX12 {
-class DirectXManager
+// t[ FramePipeline ŕ`L[ƃRs[gL[(|XgvZX)ɕĐςށB̂߂ FrameQueues B
+// EBhȆ傫ςƂ̍蒼 RebuildSizeDependentTargets ɔCÂ߂ SwapChainTargets 
+class DirectXManager : public Win32Window::EventHandler, private FrameQueues, private SwapChainTargets
 {
 public:
 	struct Vertex {
@@ -21,91 +49,365 @@ public:
 		unsigned char R, G, B, A;
 	};
 
+	// 1 DrawIndexedInstanced ŕ`P
+	struct DrawItem
+	{
+		UINT indexCount;
+		UINT startIndex;
+		INT baseVertex;
+		// `Ƃɐݒ肷(m_recorder ̔ԍ)B̂Ƃ͐ݒ肵Ȃ
+		RecorderObjectId pipelineState;
+		RecorderObjectId texture;
+	};
+
 	DirectXManager();
 	~DirectXManager();
+	// eNX`\񃊃\[XɒuA^CǂݍށBInitialize ̑OɌĂ
+	void EnableTextureStreaming();
+	// eNX`̉f̂܂܃Abv[hA`̕ϊƃ~bv̍쐬Rs[gL[ōsB
+	// flags  TextureConversionFlag ̑gݍ킹BInitialize ̑OɌĂ
+	void EnableGpuTextureConversion(uint32_t flags);
+	// sȂ̂̐[xɕ`A{`ł͌ĂʂsNZVF[_[ʂ悤ɂBInitialize ̑OɌĂ
+	void EnableDepthPrePass();
+	// CPU ŃJOƂɁAO̕sȂ̂ɉBꂽ̂`ȂBInitialize ̑OɌĂ
+	void EnableOcclusionCulling();
+	// sȂ̂̃JORs[gVF[_[ōsAĉ ExecuteIndirect ŕ`BInitialize ̑OɌĂ
+	void EnableGpuDrivenRendering();
+	// `[gA̎lp`1̑ɁAsȎlp`2ƔȎlp`3d˂V[`BInitialize ̑OɌĂ
+	void EnableDemoScene();
+	// I𑜓x؂At[ GPU Ԃ path ɏo(DynamicResolution ̃eXgɎgL^)BInitialize ̑OɌĂ
+	void EnableFrameTimeRecording(const std::string& path);
 	bool Initialize(HINSTANCE hInstance, int width, int height);
-	bool Render();
+	// ȍ~̕`p̃XbhōsBUpdate ̓t[pPbgnɂȂ
+	void StartRenderThread();
+	// `Ăr̃t[IĂ`Xbh~߂
+	void StopRenderThread();
+	// C[v疈ĂԁB`XbhȂ΂̏ŕ`悷B
+	// `Ɏs(`XbhŎsĂ)falseBC[v𔲂
+	bool Update();
+	bool Render(const FramePacket& packet);
+
+	// ̃t[̕`(IuWFNg̍쐬EAbv[h܂) path ɏo
+	void RequestFrameCapture(const std::string& path);
+	// path ̃Lv` D3D12 ōĐAĂяoƂ CPU Ԃo͂
+	bool ReplayFrameCapture(const std::string& path);
+	// GPU gȂL^ɍV[L^āAL^ɂ CPU Ԃo͂
+	void RunRecorderBenchmark() const;
+
+	void OnKeyDown(unsigned int virtualKey) override;
+	void OnResize(unsigned int width, unsigned int height, bool sizing) override;
+	void ExecuteRenderCommand(const RenderCommand& command);
 
 private:
+	//  GPU ɐςރt[̐(FramePipeline ̃Xbg̐)BobNobt@[
+	static constexpr UINT kFramesInFlight = 3;
+
+	// lp`|S1Bz  reversed-Z ̐[xŁAOقǑ傫
 	static constexpr Vertex kVertices[] = {
-		{{-0.4f, -0.7f, 0.0f}, {0.0f, 1.0f}},
-		{{-0.4f,  0.7f, 0.0f}, {0.0f, 0.0f}},
-		{{ 0.4f, -0.7f, 0.0f}, {1.0f, 1.0f}},
-		{{ 0.4f,  0.7f, 0.0f}, {1.0f, 0.0f}},
+		{{-0.4f, -0.7f, 0.2f}, {0.0f, 1.0f}},
+		{{-0.4f,  0.7f, 0.2f}, {0.0f, 0.0f}},
+		{{ 0.4f, -0.7f, 0.2f}, {1.0f, 1.0f}},
+		{{ 0.4f,  0.7f, 0.2f}, {1.0f, 0.0f}},
 	};
+	// EnableDemoScene ŕ`V[Blp`Ƃ4_B
+	// 擪2sȎlp`(珇)ŁAc͂̎Oɏd˂锼̎lp`(O珇)B
+	// ǂ`Ƃ͋tɕׂĂ(s͐[xeXĝŐ`邪AdȂsNZVF[_[ʂɓ)
+	static constexpr Vertex kDemoSceneVertices[] = {
+		{{-0.4f, -0.7f, 0.2f}, {0.0f, 1.0f}},
+		{{-0.4f,  0.7f, 0.2f}, {0.0f, 0.0f}},
+		{{ 0.4f, -0.7f, 0.2f}, {1.0f, 1.0f}},
+		{{ 0.4f,  0.7f, 0.2f}, {1.0f, 0.0f}},
+
+		{{-0.7f, -0.4f, 0.3f}, {0.0f, 1.0f}},
+		{{-0.7f,  0.2f, 0.3f}, {0.0f, 0.0f}},
+		{{-0.1f, -0.4f, 0.3f}, {1.0f, 1.0f}},
+		{{-0.1f,  0.2f, 0.3f}, {1.0f, 0.0f}},
+
+		{{-0.5f, -0.1f, 0.8f}, {0.0f, 1.0f}},
+		{{-0.5f,  0.5f, 0.8f}, {0.0f, 0.0f}},
+		{{ 0.1f, -0.1f, 0.8f}, {1.0f, 1.0f}},
+		{{ 0.1f,  0.5f, 0.8f}, {1.0f, 0.0f}},
+
+		{{-0.3f, -0.3f, 0.6f}, {0.0f, 1.0f}},
+		{{-0.3f,  0.3f, 0.6f}, {0.0f, 0.0f}},
+		{{ 0.3f, -0.3f, 0.6f}, {1.0f, 1.0f}},
+		{{ 0.3f,  0.3f, 0.6f}, {1.0f, 0.0f}},
+
+		{{-0.1f, -0.5f, 0.4f}, {0.0f, 1.0f}},
+		{{-0.1f,  0.1f, 0.4f}, {0.0f, 0.0f}},
+		{{ 0.5f, -0.5f, 0.4f}, {1.0f, 1.0f}},
+		{{ 0.5f,  0.1f, 0.4f}, {1.0f, 0.0f}},
+	};
+	// ǂ̎lp` baseVertex 炵Ďg
 	static constexpr unsigned short kIndices[] = {
 		0, 1, 2,
 		2, 1, 3,
 	};
 
-	WNDCLASSEX m_windowClass = {};
-	HWND m_hwnd = nullptr;
-	RECT m_windowRect = { 0, 0, 320, 240 };
+	Win32Window m_window;
 
 	ComPtr<ID3D12Device> m_device;
 	ComPtr<IDXGIFactory6> m_dxgiFactory;
 	ComPtr<IDXGISwapChain4> m_swapChain;
 	ComPtr<IDXGIAdapter> m_adapter;
+	AdapterCapabilities m_adapterCapabilities;
 	D3D_FEATURE_LEVEL m_feature_level = D3D_FEATURE_LEVEL_11_0;
-	ComPtr<ID3D12CommandAllocator> m_commandAllocator;
+	// t[̕`p(`L[ɐς)BL^IƕAt[̓ł̃Xbg̃AP[^[ŊJ
 	ComPtr<ID3D12GraphicsCommandList> m_commandList;
-	ComPtr<ID3D12CommandQueue> m_commandQueue;
+	CommandQueueManager m_queues;
+	// XbgƂ̂́B̃XbgOɎgt[ GPU ŏI܂Ŏg񂳂Ȃ
+	struct FrameSlot
+	{
+		ComPtr<ID3D12CommandAllocator> commandAllocator;
+		// Rs[gL[Ń|XgvZXL^ƂɎg
+		PostProcessSettings postProcessSettings;
+		UINT renderWidth = 0;
+		UINT renderHeight = 0;
+	};
+	std::array<FrameSlot, kFramesInFlight> m_frameSlots;
+	FramePipeline m_framePipeline{ *this, kFramesInFlight };
 	ComPtr<ID3D12DescriptorHeap> m_rtvHeap;
+	// HDR ^[QbgƓ傫̐[xobt@[
+	ComPtr<ID3D12DescriptorHeap> m_dsvHeap;
+	ComPtr<ID3D12Resource> m_depthBuffer;
 	std::vector<ComPtr<ID3D12Resource>> m_backBuffers;
-	ComPtr<ID3D12Fence> m_fence;
-	UINT64 m_fenceValue = 0;
+	UINT m_backBufferWidth = 0;
+	UINT m_backBufferHeight = 0;
 
 	ComPtr<ID3D12Resource> m_vertexBuffer;
 	D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView{};
 	ComPtr<ID3D12Resource> m_indexBuffer;
 	D3D12_INDEX_BUFFER_VIEW m_indexBufferView{};
 
+	// `lp`̒_(kVertices  kDemoSceneVertices)ƁA擪牽s
+	const Vertex* m_vertices = kVertices;
+	UINT m_vertexCount = _countof(kVertices);
+	INT m_opaqueQuadCount = 1;
+	// sȂ́BGPU ŃJOƂ͂ꂾ ExecuteIndirect ŕ`
+	std::vector<DrawItem> m_drawItems;
+	AabbSoA m_drawBounds;
+	// Ȃ́Bsׂĕ`ƂɁACPU ŃJOĉ珇ɏd˂
+	std::vector<DrawItem> m_transparentDrawItems;
+	AabbSoA m_transparentBounds;
+	Frustum m_frustum{};
+	// true Ȃ王ŎcsȂ̂O m_occlusionBuffer ɓhABꂽ̂̂Ă
+	bool m_occlusionCulling = false;
+	OcclusionBuffer m_occlusionBuffer;
+	// 1t[̊Ԃg CPU ̃f[^BR}hXgɋL^ÎĂ
+	FrameArena m_frameArena;
+
+	// true Ȃ GPU ŃJO ExecuteIndirect ŕ`悷
+	bool m_gpuDrivenRendering = false;
+	ComPtr<ID3D10Blob> m_cullCsBlob;
+	ComPtr<ID3D12RootSignature> m_cullRootSignature;
+	ComPtr<ID3D12PipelineState> m_cullPipelineState;
+	ComPtr<ID3D12CommandSignature> m_commandSignature;
+	ComPtr<ID3D12Resource> m_drawBoundsBuffer;
+	ComPtr<ID3D12Resource> m_drawArgumentsBuffer;
+	ComPtr<ID3D12Resource> m_visibleArgumentsBuffer;
+	ComPtr<ID3D12Resource> m_visibleCountBuffer;
+	ComPtr<ID3D12Resource> m_zeroCountBuffer;
+
 	ComPtr<ID3D10Blob> m_vsBlob;
 	ComPtr<ID3D10Blob> m_psBlob;
+	// ̓CAEgƃ[gVOl`͂
+	ShaderReflectionData m_vsReflection;
+	ShaderReflectionData m_psReflection;
 
+	RootSignatureCache m_rootSignatures;
+	// true ȂeNX`Ԃɓǂ
+	bool m_pointSampling = false;
 	ComPtr<ID3D12RootSignature> m_rootSignature;
+	// m_rootSignature ŃeNX`̃e[uuԍ
+	UINT m_textureParameterIndex = 0;
 	ComPtr<ID3D12PipelineState> m_pipelineState;
+	// m_pipelineState ƓVF[_[ŁAZς݃At@ŏd˂
+	ComPtr<ID3D12PipelineState> m_transparentPipelineState;
+	// true ȂsȂ̂ m_depthPrePassPipelineState(_VF[_[)Őɕ`
+	bool m_depthPrePass = false;
+	ComPtr<ID3D12PipelineState> m_depthPrePassPipelineState;
+
+	PostProcessChain m_postProcess;
+	PostProcessSettings m_postProcessSettings;
+
+	// true Ȃ GPU Ԃɍ킹 HDR ^[Qbgɕ`͈͂k߂
+	bool m_dynamicResolution = true;
+	GpuTimer m_gpuTimer;
+	DynamicResolutionController m_resolutionController;
+	// JĂ GPU Ԃ1s
+	std::ofstream m_frameTimeTrace;
+
+	// CpX̕`͂ʂċL^
+	D3D12CommandRecorder m_recorder;
+	// łȂΎ̃t[Lv`
+	std::string m_capturePath;
 
 	D3D12_VIEWPORT m_viewport = {};
 	D3D12_RECT m_scissorRect = {};
 
-	DirectX::TexMetadata m_metadata{};
+	// ƃfR[h̃WusBXbh(main)CXbhɂȂ
+	JobSystem m_jobSystem;
+
+	RenderThread m_renderThread;
+	// ̓Xbhōt[pPbg̐
+	uint64_t m_submittedFrameCount = 0;
+	// EBhȆ傫̕ω܂Ƃ߂āAt[pPbgɍڂ傫߂(̓Xbh)
+	ResizeDebouncer m_resizeDebouncer;
+	ImageDecoder m_imageDecoder;
+	DXGI_FORMAT m_textureFormat = DXGI_FORMAT_UNKNOWN;
+
+	// ԃobt@[ǂރL[(Rs[Rs[g)ł̏I܂ŐĂ
+	struct PendingUpload
+	{
+		ComPtr<ID3D12Resource> buffer;
+		CommandQueue* queue;
+		UINT64 fenceValue;
+	};
+	std::vector<PendingUpload> m_pendingUploads;
+	UINT64 m_textureUploadFenceValue = 0;
+	UINT64 m_textureConversionFenceValue = 0;
+	UINT m_textureMipCount = 1;
+
+	// true ȂeNX` m_textureConverter ŕϊ
+	bool m_gpuTextureConversion = false;
+	uint32_t m_textureConversionFlags = 0;
+	TextureConverter m_textureConverter;
+
+	HotReloader m_hotReloader;
 
 	ComPtr<ID3D12Resource> m_textureBuffer;
 	ComPtr<ID3D12DescriptorHeap> m_textureDescriptionHeap;
+	// ̎lp`ɓ\BǂݍނƂɏZς݃At@ɂĂ
+	ComPtr<ID3D12Resource> m_transparentTexture;
+	DXGI_FORMAT m_transparentTextureFormat = DXGI_FORMAT_UNKNOWN;
+	UINT m_transparentTextureMipCount = 1;
+
+	// true ȂeNX` m_tiledTexture œǂݍ݁AStreamedPS ŕ`
+	bool m_textureStreaming = false;
+	TiledTexture m_tiledTexture;
+	// m_rootSignature ŊԐڎQƃe[uƃtB[hobÑe[uuԍ
+	UINT m_tileIndirectionParameterIndex = 0;
+	UINT m_tileFeedbackParameterIndex = 0;
 
-	bool MakeWindow(HINSTANCE hInstance, int width, int height);
+	static bool ProbeAdapter(IDXGIAdapter1* adapter, AdapterCapabilities& capabilities);
 	bool SelectAdapter();
 	bool InitDirect3DDevice();
 	bool InitCommandAllocatorAndCommandQueue();
 	bool InitSwapChain();
 	bool InitRTV();
-	bool InitFence();
+	bool CreateDepthBuffer(UINT width, UINT height);
+	// GPU ̊҂ĂAobNobt@[Ɖʂ̑傫ō̂蒼
+	bool ResizeSwapChain(UINT width, UINT height);
+
+	// SwapChainTargets
+	bool FlushFrames() override;
+	void ReleaseBackBuffers() override;
+	bool ResizeBuffers(uint32_t width, uint32_t height) override;
+	bool CreateBackBufferViews() override;
+	bool ResizeRenderTargets(uint32_t width, uint32_t height) override;
+
+	// FrameQueues
+	uint64_t SubmitGraphics(uint32_t slot) override;
+	uint64_t SubmitPostProcess(uint32_t slot) override;
+	uint64_t SubmitPresent(uint32_t slot) override;
+	void WaitOnGpu(GpuQueueType queue, GpuQueueType signalingQueue, uint64_t fenceValue) override;
+	void WaitOnCpu(GpuQueueType queue, uint64_t fenceValue) override;
+	CommandQueue& FrameQueue(GpuQueueType queue);
 
 	bool SetupVertexBuffer();
+	void SetupDrawItems();
+	// m_vertices  baseVertex ̎lp``Pʂ AABB 𑫂
+	void AddQuadDrawItem(
+		INT baseVertex,
+		RecorderObjectId pipelineState,
+		RecorderObjectId texture,
+		std::vector<DrawItem>& drawItems,
+		AabbSoA& bounds
+	) const;
+	// ŎcsȂ drawIndices(count )OׁABĂȂ̂擪ɎcB
+	// sortKeys  sortScratch  count ̍Ɨ̈B߂l͎c
+	size_t CullOccludedDraws(
+		uint32_t* drawIndices,
+		size_t count,
+		const Float4x4& viewProjection,
+		DrawSortKey* sortKeys,
+		DrawSortKey* sortScratch
+	);
+	void FillFramePacket(FramePacket& packet);
+	static bool CompileShader(
+		const wchar_t* path,
+		const char* entryPoint,
+		const char* target,
+		ComPtr<ID3D10Blob>& blob,
+		ShaderReflectionData* reflection = nullptr
+	);
+	const char* PixelShaderEntryPoint() const;
 	bool SetupShaders();
+	bool SetupPostProcess();
 	bool SetupGraphicsPipeline();
+	bool CreateBuffer(
+		D3D12_HEAP_TYPE heapType,
+		UINT64 size,
+		D3D12_RESOURCE_FLAGS flags,
+		D3D12_RESOURCE_STATES initialState,
+		ComPtr<ID3D12Resource>& buffer
+	) const;
+	bool SetupIndirectDraw();
+	void RecordGpuCulling();
 	void SetupViewportAndScissor(unsigned int windowWidth, unsigned int windowHeight);
-	static void SetupUploadHeap(
-		D3D12_HEAP_PROPERTIES& uploadHeapProperties,
-		D3D12_RESOURCE_DESC& uploadResourceDescription,
-		const DirectX::Image* image
-	);
-	void SetupTextureHeap(
+	static void SetupTextureHeap(
 		D3D12_HEAP_PROPERTIES& textureHeapProperties,
-		D3D12_RESOURCE_DESC& resourceDescription
+		D3D12_RESOURCE_DESC& resourceDescription,
+		const ImageSource& image
 	);
-	static size_t AlignedSize(size_t size, size_t alignment);
-	void SetupTextureBufferLocation(
+	static void SetupTextureBufferLocation(
 		D3D12_TEXTURE_COPY_LOCATION& srcLocation,
 		D3D12_TEXTURE_COPY_LOCATION& dstLocation,
 		ID3D12Resource* uploadBuffer,
-		const DirectX::TexMetadata& metadata,
-		const DirectX::Image* image
-	) const;
-	void SetupTextureResourceBarrier(D3D12_RESOURCE_BARRIER& textureResourceBarrier) const;
+		ID3D12Resource* texture,
+		const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& footprint
+	);
+	bool SetupTextureConverter();
 	bool LoadTexture();
+	// path  texture ɓǂݍށBpremultiply Ȃ RGB  a |Ă
+	bool UploadTexture(
+		const wchar_t* path,
+		bool premultiply,
+		ComPtr<ID3D12Resource>& texture,
+		DXGI_FORMAT& format,
+		UINT& mipCount
+	);
+	bool ConvertTextureOnGpu(
+		const wchar_t* path,
+		uint32_t flags,
+		ComPtr<ID3D12Resource>& texture,
+		DXGI_FORMAT& format,
+		UINT& mipCount
+	);
+	void ReleaseCompletedUploads();
 	bool MakeShaderResourceView();
+	void CreateTextureView(
+		ID3D12Resource* texture,
+		DXGI_FORMAT format,
+		UINT mipCount,
+		D3D12_CPU_DESCRIPTOR_HANDLE handle
+	) const;
+	// keys ̏ɕ`BpipelineState  texture ͍ݒ肳Ă̂ŁAς珑
+	static void RecordSortedDraws(
+		CommandRecorder& recorder,
+		const std::vector<DrawItem>& drawItems,
+		const DrawSortKey* keys,
+		size_t count,
+		UINT textureParameterIndex,
+		RecorderObjectId& pipelineState,
+		RecorderObjectId& texture
+	);
+
+	void RegisterRecorderObjects();
+	bool WriteCaptureObjects(CommandRecorder& capture);
+
+	void SetupHotReload();
+	void ApplyHotReload();
 
 	static bool EnableDebugLayer();
 };
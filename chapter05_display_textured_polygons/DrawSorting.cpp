@@ -0,0 +1,138 @@
+#include "DrawSorting.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	constexpr int kRadixBits = 8;
+	constexpr size_t kRadixSize = 1 << kRadixBits;
+	//  32bit ׂ̂4
+	constexpr int kRadixDigitCount = 4;
+	// 菭ȂΕɕׂ(Wuςނق)
+	constexpr size_t kParallelSortThreshold = 1 << 15;
+	// Ԃ̐̏
+	constexpr size_t kMaxSortChunks = 64;
+
+	using Histogram = std::array<size_t, kRadixSize>;
+
+	inline size_t Digit(DrawSortKey key, int digit)
+	{
+		return static_cast<size_t>(key >> (32 + digit * kRadixBits)) & (kRadixSize - 1);
+	}
+
+	// グAݐ̐擪ʒuɒu
+	void ToOffsets(Histogram& histogram)
+	{
+		size_t offset = 0;
+		for (size_t& count : histogram) {
+			const size_t bucketCount = count;
+			count = offset;
+			offset += bucketCount;
+		}
+	}
+}
+
+uint32_t DepthSortBits(float depth)
+{
+	uint32_t bits = 0;
+	std::memcpy(&bits, &depth, sizeof(bits));
+	// ̒l͕rbg𗧂Ăĕ̒lɁA̒l͑Srbg𔽓]đ召tɂ
+	return (bits & 0x80000000u) != 0 ? ~bits : bits | 0x80000000u;
+}
+
+void RadixSortDrawKeys(DrawSortKey* keys, DrawSortKey* scratch, size_t count)
+{
+	if (count < 2) {
+		return;
+	}
+
+	// 4̃qXgO1̑Ő
+	Histogram histograms[kRadixDigitCount] = {};
+	for (size_t i = 0; i < count; ++i) {
+		for (int digit = 0; digit < kRadixDigitCount; ++digit) {
+			++histograms[digit][Digit(keys[i], digit)];
+		}
+	}
+
+	DrawSortKey* source = keys;
+	DrawSortKey* destination = scratch;
+	for (int digit = 0; digit < kRadixDigitCount; ++digit) {
+		Histogram& histogram = histograms[digit];
+		// ǂ̃L[łľ͕тςȂ
+		if (histogram[Digit(source[0], digit)] == count) {
+			continue;
+		}
+		ToOffsets(histogram);
+		for (size_t i = 0; i < count; ++i) {
+			destination[histogram[Digit(source[i], digit)]++] = source[i];
+		}
+		std::swap(source, destination);
+	}
+	if (source != keys) {
+		std::memcpy(keys, source, count * sizeof(DrawSortKey));
+	}
+}
+
+void ParallelRadixSortDrawKeys(DrawSortKey* keys, DrawSortKey* scratch, size_t count, JobSystem& jobSystem)
+{
+	const size_t chunkCount = (std::min)(static_cast<size_t>(jobSystem.WorkerCount()) + 1, kMaxSortChunks);
+	if (count < kParallelSortThreshold || chunkCount < 2) {
+		RadixSortDrawKeys(keys, scratch, count);
+		return;
+	}
+	const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+	// ԂƂ̃qXgOBôƂ͋ԂƂ݈̏ʒuɂȂ
+	std::vector<Histogram> chunkHistograms(chunkCount);
+	DrawSortKey* source = keys;
+	DrawSortKey* destination = scratch;
+	for (int digit = 0; digit < kRadixDigitCount; ++digit) {
+		jobSystem.ParallelFor(chunkCount, 1, [&](size_t beginChunk, size_t endChunk) {
+			for (size_t chunk = beginChunk; chunk < endChunk; ++chunk) {
+				Histogram& histogram = chunkHistograms[chunk];
+				histogram.fill(0);
+				const size_t end = (std::min)((chunk + 1) * chunkSize, count);
+				for (size_t i = chunk * chunkSize; i < end; ++i) {
+					++histogram[Digit(source[i], digit)];
+				}
+			}
+		});
+
+		// l̒ł͑ŐԂقǑOɒûŁAlƂɋԂ̏ňʒuU
+		size_t offset = 0;
+		size_t largestBucket = 0;
+		for (size_t bucket = 0; bucket < kRadixSize; ++bucket) {
+			const size_t bucketStart = offset;
+			for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+				const size_t chunkBucketCount = chunkHistograms[chunk][bucket];
+				chunkHistograms[chunk][bucket] = offset;
+				offset += chunkBucketCount;
+			}
+			largestBucket = (std::max)(largestBucket, offset - bucketStart);
+		}
+		// ǂ̃L[łľ͕тςȂ
+		if (largestBucket == count) {
+			continue;
+		}
+
+		jobSystem.ParallelFor(chunkCount, 1, [&](size_t beginChunk, size_t endChunk) {
+			for (size_t chunk = beginChunk; chunk < endChunk; ++chunk) {
+				Histogram& offsets = chunkHistograms[chunk];
+				const size_t end = (std::min)((chunk + 1) * chunkSize, count);
+				for (size_t i = chunk * chunkSize; i < end; ++i) {
+					destination[offsets[Digit(source[i], digit)]++] = source[i];
+				}
+			}
+		});
+		std::swap(source, destination);
+	}
+	if (source != keys) {
+		std::memcpy(keys, source, count * sizeof(DrawSortKey));
+	}
+}
+}
+}
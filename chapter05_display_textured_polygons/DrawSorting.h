@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "JobSystem.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// `Pʂבւ邽߂̃L[B 32bit ɕׂA 32bit ɕ`Pʂ̔ԍl߂B
+// בւ͏ 32bit ōsÂ̂͐ς񂾏̂܂܎c
+using DrawSortKey = uint64_t;
+
+inline DrawSortKey MakeDrawSortKey(uint32_t order, uint32_t drawIndex)
+{
+	return (static_cast<DrawSortKey>(order) << 32) | drawIndex;
+}
+inline uint32_t DrawSortKeyOrder(DrawSortKey key) { return static_cast<uint32_t>(key >> 32); }
+inline uint32_t DrawSortKeyIndex(DrawSortKey key) { return static_cast<uint32_t>(key); }
+
+// float ̑召ƕȂ̑召v悤ɕבւrbg(̒l)
+uint32_t DepthSortBits(float depth);
+// [x reversed-Z(OقǑ傫)B
+// OցB͂̏ɏd˂
+inline uint32_t BackToFrontOrder(float depth) { return DepthSortBits(depth); }
+// O牜ցBs͂̏ɕ`ƁÂ̂[xeXgŃsNZVF[_[̑OɎ̂Ă
+inline uint32_t FrontToBackOrder(float depth) { return ~DepthSortBits(depth); }
+// s̓pCvC(8bit)AeNX`(8bit)̏ł܂Ƃ߁AԂ؂ւ񐔂炷B
+//  16bit ͓Ԃ̒̕тɋ󂯂Ă
+inline uint32_t OpaqueStateOrder(uint32_t pipeline, uint32_t texture)
+{
+	return ((pipeline & 0xFF) << 24) | ((texture & 0xFF) << 16);
+}
+// OpaqueStateOrder ̉ 16bit ɁAFrontToBackOrder ̏ 16bit l߂B
+// Ԃ̒ł͎O`B 16bit ͕EwȄ 7bit ŁAlɂȂ邲ƂɓiB
+// reversed-Z ł͉ق 0 ɋ߂Â̂ŁA0  1 ϓɋ؂艜܂ōׂ
+inline uint32_t OpaqueDrawOrder(uint32_t pipeline, uint32_t texture, float depth)
+{
+	return OpaqueStateOrder(pipeline, texture) | (FrontToBackOrder(depth) >> 16);
+}
+
+//  32bit  8bit 4 LSD \[gŕׂ()B
+// ǂ̃L[łľ͔΂̂ŁA̕قǑBscratch  count ̍Ɨ̈
+void RadixSortDrawKeys(DrawSortKey* keys, DrawSortKey* scratch, size_t count);
+// בւAƂ̐グƏoԂɕ jobSystem ŕɍsB
+// ȂƂ RadixSortDrawKeys Ɠ1Xbhŕׂ
+void ParallelRadixSortDrawKeys(DrawSortKey* keys, DrawSortKey* scratch, size_t count, JobSystem& jobSystem);
+}
+}
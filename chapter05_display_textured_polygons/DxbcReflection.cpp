@@ -0,0 +1,370 @@
+#include "DxbcReflection.h"
+
+#include <cstring>
+#include <utility>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	constexpr uint32_t MakeFourCc(char a, char b, char c, char d)
+	{
+		return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+			(static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) |
+			(static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16) |
+			(static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24);
+	}
+
+	constexpr uint32_t kDxbcFourCc = MakeFourCc('D', 'X', 'B', 'C');
+	constexpr uint32_t kInputSignatureFourCc = MakeFourCc('I', 'S', 'G', 'N');
+	constexpr uint32_t kResourceDefinitionFourCc = MakeFourCc('R', 'D', 'E', 'F');
+	constexpr uint32_t kRootSignatureFourCc = MakeFourCc('R', 'T', 'S', '0');
+	// magic, checksum[16], version, size, chunk count
+	constexpr size_t kContainerHeaderSize = 32;
+	// type, visibility, payload offset
+	constexpr size_t kRootParameterSize = 12;
+	constexpr size_t kSignatureElementSize = 24;
+	// VF[_[f 5.1  space  id ɕt
+	constexpr size_t kBindingSize = 32;
+	constexpr size_t kBindingSize51 = 40;
+
+	constexpr uint32_t kCacheMagic = MakeFourCc('R', 'F', 'L', 'C');
+	constexpr uint32_t kCacheVersion = 1;
+
+	// ͈͂m߂Ȃǂ
+	class ByteReader
+	{
+	public:
+		ByteReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+		template <typename T>
+		bool Read(size_t offset, T& value) const
+		{
+			if (offset > m_size || m_size - offset < sizeof(T)) {
+				return false;
+			}
+			std::memcpy(&value, m_data + offset, sizeof(T));
+			return true;
+		}
+
+		// offset I[0܂ł𕶎Ƃēǂ
+		bool ReadString(size_t offset, std::string& value) const
+		{
+			if (offset >= m_size) {
+				return false;
+			}
+			const void* end = std::memchr(m_data + offset, 0, m_size - offset);
+			if (end == nullptr) {
+				return false;
+			}
+			value.assign(reinterpret_cast<const char*>(m_data + offset), static_cast<const uint8_t*>(end) - (m_data + offset));
+			return true;
+		}
+
+		ByteReader Sub(size_t offset, size_t size) const { return ByteReader(m_data + offset, size); }
+		size_t Size() const { return m_size; }
+
+	private:
+		const uint8_t* m_data;
+		size_t m_size;
+	};
+
+	// index Ԗڂ̃`NBRei[Ɏ܂ĂȂ false
+	bool ReadChunk(const ByteReader& container, uint32_t index, uint32_t& fourCc, ByteReader& chunk)
+	{
+		uint32_t chunkOffset = 0;
+		uint32_t chunkSize = 0;
+		if (!container.Read(kContainerHeaderSize + index * sizeof(uint32_t), chunkOffset) ||
+			!container.Read(chunkOffset, fourCc) ||
+			!container.Read(chunkOffset + 4, chunkSize)) {
+			return false;
+		}
+		const size_t dataOffset = static_cast<size_t>(chunkOffset) + 8;
+		if (dataOffset > container.Size() || container.Size() - dataOffset < chunkSize) {
+			return false;
+		}
+		chunk = container.Sub(dataOffset, chunkSize);
+		return true;
+	}
+
+	// ISGN ͂ȂĂ悢̂ŁATOɂׂẴ`NĂȂƂm߂Ă
+	bool ValidateChunks(const ByteReader& container, uint32_t& chunkCount)
+	{
+		if (!container.Read(28, chunkCount)) {
+			return false;
+		}
+		for (uint32_t i = 0; i < chunkCount; ++i) {
+			uint32_t fourCc = 0;
+			ByteReader chunk(nullptr, 0);
+			if (!ReadChunk(container, i, fourCc, chunk)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ValidateContainer(const ByteReader& container, uint32_t& chunkCount)
+	{
+		uint32_t magic = 0;
+		uint32_t containerSize = 0;
+		if (!container.Read(0, magic) || magic != kDxbcFourCc || !container.Read(24, containerSize)) {
+			return false;
+		}
+		// rŐ؂ꂽt@C
+		if (containerSize > container.Size()) {
+			return false;
+		}
+		return ValidateChunks(container, chunkCount);
+	}
+
+	bool FindChunk(const ByteReader& container, uint32_t chunkCount, uint32_t fourCc, ByteReader& chunk)
+	{
+		for (uint32_t i = 0; i < chunkCount; ++i) {
+			uint32_t chunkFourCc = 0;
+			if (ReadChunk(container, i, chunkFourCc, chunk) && chunkFourCc == fourCc) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ParseInputSignature(const ByteReader& chunk, std::vector<ShaderInputElement>& inputs)
+	{
+		uint32_t elementCount = 0;
+		uint32_t elementOffset = 0;
+		if (!chunk.Read(0, elementCount) || !chunk.Read(4, elementOffset) ||
+			elementCount > chunk.Size() / kSignatureElementSize) {
+			return false;
+		}
+		inputs.resize(elementCount);
+		for (uint32_t i = 0; i < elementCount; ++i) {
+			const size_t offset = elementOffset + i * kSignatureElementSize;
+			ShaderInputElement& input = inputs[i];
+			uint32_t nameOffset = 0;
+			if (!chunk.Read(offset, nameOffset) ||
+				!chunk.Read(offset + 4, input.semanticIndex) ||
+				!chunk.Read(offset + 8, input.systemValue) ||
+				!chunk.Read(offset + 12, input.componentType) ||
+				!chunk.Read(offset + 16, input.registerIndex) ||
+				!chunk.Read(offset + 20, input.mask) ||
+				!chunk.ReadString(nameOffset, input.semanticName)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool ParseResourceDefinition(const ByteReader& chunk, std::vector<ShaderResourceBinding>& bindings)
+	{
+		uint32_t bindingCount = 0;
+		uint32_t bindingOffset = 0;
+		uint8_t minorVersion = 0;
+		uint8_t majorVersion = 0;
+		if (!chunk.Read(8, bindingCount) ||
+			!chunk.Read(12, bindingOffset) ||
+			!chunk.Read(16, minorVersion) ||
+			!chunk.Read(17, majorVersion)) {
+			return false;
+		}
+		const bool hasSpace = majorVersion > 5 || (majorVersion == 5 && minorVersion >= 1);
+		const size_t bindingSize = hasSpace ? kBindingSize51 : kBindingSize;
+		if (bindingCount > chunk.Size() / bindingSize) {
+			return false;
+		}
+
+		bindings.resize(bindingCount);
+		for (uint32_t i = 0; i < bindingCount; ++i) {
+			const size_t offset = bindingOffset + i * bindingSize;
+			ShaderResourceBinding& binding = bindings[i];
+			uint32_t nameOffset = 0;
+			uint32_t type = 0;
+			if (!chunk.Read(offset, nameOffset) ||
+				!chunk.Read(offset + 4, type) ||
+				!chunk.Read(offset + 20, binding.bindPoint) ||
+				!chunk.Read(offset + 24, binding.bindCount) ||
+				!chunk.ReadString(nameOffset, binding.name)) {
+				return false;
+			}
+			binding.type = static_cast<ShaderInputType>(type);
+			binding.space = 0;
+			if (hasSpace && !chunk.Read(offset + 32, binding.space)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename T>
+	void Append(std::vector<uint8_t>& bytes, const T& value)
+	{
+		const size_t offset = bytes.size();
+		bytes.resize(offset + sizeof(T));
+		std::memcpy(bytes.data() + offset, &value, sizeof(T));
+	}
+
+	void AppendString(std::vector<uint8_t>& bytes, const std::string& value)
+	{
+		Append(bytes, static_cast<uint32_t>(value.size()));
+		bytes.insert(bytes.end(), value.begin(), value.end());
+	}
+
+	// 擪珇ɓǂ
+	class StreamReader
+	{
+	public:
+		explicit StreamReader(const std::vector<uint8_t>& bytes) : m_reader(bytes.data(), bytes.size()) {}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			if (!m_reader.Read(m_offset, value)) {
+				return false;
+			}
+			m_offset += sizeof(T);
+			return true;
+		}
+
+		bool ReadString(std::string& value)
+		{
+			uint32_t length = 0;
+			if (!Read(length) || m_reader.Size() - m_offset < length) {
+				return false;
+			}
+			value.resize(length);
+			for (uint32_t i = 0; i < length; ++i) {
+				Read(value[i]);
+			}
+			return true;
+		}
+
+	private:
+		ByteReader m_reader;
+		size_t m_offset = 0;
+	};
+}
+
+bool ParseDxbc(const void* data, size_t size, ShaderReflectionData& reflection)
+{
+	const ByteReader container(static_cast<const uint8_t*>(data), size);
+	uint32_t chunkCount = 0;
+	if (!ValidateContainer(container, chunkCount)) {
+		return false;
+	}
+
+	ShaderReflectionData parsed;
+	ByteReader chunk(nullptr, 0);
+	// sNZVF[_[Ȃǂɂ ISGN ͂(O̒i̓)
+	if (FindChunk(container, chunkCount, kInputSignatureFourCc, chunk) && !ParseInputSignature(chunk, parsed.inputs)) {
+		return false;
+	}
+	if (!FindChunk(container, chunkCount, kResourceDefinitionFourCc, chunk) ||
+		!ParseResourceDefinition(chunk, parsed.bindings)) {
+		return false;
+	}
+	reflection = std::move(parsed);
+	return true;
+}
+
+bool ParseRootSignatureParameters(const void* data, size_t size, std::vector<uint32_t>& parameterTypes)
+{
+	const ByteReader container(static_cast<const uint8_t*>(data), size);
+	uint32_t chunkCount = 0;
+	ByteReader chunk(nullptr, 0);
+	if (!ValidateContainer(container, chunkCount) || !FindChunk(container, chunkCount, kRootSignatureFourCc, chunk)) {
+		return false;
+	}
+
+	// version, parameter count, parameter offset, sampler count, sampler offset, flagsB
+	// p[^[̒g(e[ũWȂ)͓ǂ܂Ȃ
+	uint32_t parameterCount = 0;
+	uint32_t parameterOffset = 0;
+	if (!chunk.Read(4, parameterCount) || !chunk.Read(8, parameterOffset) ||
+		parameterCount > chunk.Size() / kRootParameterSize) {
+		return false;
+	}
+	std::vector<uint32_t> types(parameterCount);
+	for (uint32_t i = 0; i < parameterCount; ++i) {
+		if (!chunk.Read(static_cast<size_t>(parameterOffset) + i * kRootParameterSize, types[i])) {
+			return false;
+		}
+	}
+	parameterTypes = std::move(types);
+	return true;
+}
+
+std::vector<uint8_t> SerializeReflection(const ShaderReflectionData& reflection, uint64_t key)
+{
+	std::vector<uint8_t> bytes;
+	Append(bytes, kCacheMagic);
+	Append(bytes, kCacheVersion);
+	Append(bytes, key);
+	Append(bytes, static_cast<uint32_t>(reflection.inputs.size()));
+	for (const ShaderInputElement& input : reflection.inputs) {
+		AppendString(bytes, input.semanticName);
+		Append(bytes, input.semanticIndex);
+		Append(bytes, input.systemValue);
+		Append(bytes, input.componentType);
+		Append(bytes, input.registerIndex);
+		Append(bytes, input.mask);
+	}
+	Append(bytes, static_cast<uint32_t>(reflection.bindings.size()));
+	for (const ShaderResourceBinding& binding : reflection.bindings) {
+		AppendString(bytes, binding.name);
+		Append(bytes, static_cast<uint32_t>(binding.type));
+		Append(bytes, binding.bindPoint);
+		Append(bytes, binding.bindCount);
+		Append(bytes, binding.space);
+	}
+	return bytes;
+}
+
+bool DeserializeReflection(const std::vector<uint8_t>& bytes, uint64_t key, ShaderReflectionData& reflection)
+{
+	StreamReader reader(bytes);
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint64_t storedKey = 0;
+	if (!reader.Read(magic) || magic != kCacheMagic ||
+		!reader.Read(version) || version != kCacheVersion ||
+		!reader.Read(storedKey) || storedKey != key) {
+		return false;
+	}
+
+	ShaderReflectionData loaded;
+	uint32_t inputCount = 0;
+	if (!reader.Read(inputCount)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < inputCount; ++i) {
+		ShaderInputElement input;
+		if (!reader.ReadString(input.semanticName) ||
+			!reader.Read(input.semanticIndex) ||
+			!reader.Read(input.systemValue) ||
+			!reader.Read(input.componentType) ||
+			!reader.Read(input.registerIndex) ||
+			!reader.Read(input.mask)) {
+			return false;
+		}
+		loaded.inputs.push_back(std::move(input));
+	}
+	uint32_t bindingCount = 0;
+	if (!reader.Read(bindingCount)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < bindingCount; ++i) {
+		ShaderResourceBinding binding;
+		uint32_t type = 0;
+		if (!reader.ReadString(binding.name) ||
+			!reader.Read(type) ||
+			!reader.Read(binding.bindPoint) ||
+			!reader.Read(binding.bindCount) ||
+			!reader.Read(binding.space)) {
+			return false;
+		}
+		binding.type = static_cast<ShaderInputType>(type);
+		loaded.bindings.push_back(std::move(binding));
+	}
+	reflection = std::move(loaded);
+	return true;
+}
+}
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+// DXBC Rei[(fxc o͂oCgR[h)̓VOl`ƃ\[X̊蓖ĂǂށB
+// D3DReflect gȂ̂ Windows ȊOł
+
+// ̓VOl`(ISGN)1vf
+struct ShaderInputElement
+{
+	std::string semanticName;
+	uint32_t semanticIndex = 0;
+	// 0 Ȃӂ̓́BSV_VertexID Ȃǂ 0 ȊO
+	uint32_t systemValue = 0;
+	// D3D_REGISTER_COMPONENT_TYPE (1: uint, 2: int, 3: float)
+	uint32_t componentType = 0;
+	uint32_t registerIndex = 0;
+	// gĂ鐬 (xyzw = bit 0..3)
+	uint8_t mask = 0;
+};
+
+// D3D_SHADER_INPUT_TYPE Ɠl
+enum class ShaderInputType : uint32_t {
+	ConstantBuffer = 0,
+	TextureBuffer = 1,
+	Texture = 2,
+	Sampler = 3,
+	RWTyped = 4,
+	Structured = 5,
+	RWStructured = 6,
+	ByteAddress = 7,
+	RWByteAddress = 8,
+	AppendStructured = 9,
+	ConsumeStructured = 10,
+	RWStructuredWithCounter = 11,
+};
+
+// \[X`(RDEF)1̊蓖
+struct ShaderResourceBinding
+{
+	std::string name;
+	ShaderInputType type = ShaderInputType::ConstantBuffer;
+	uint32_t bindPoint = 0;
+	uint32_t bindCount = 1;
+	uint32_t space = 0;
+};
+
+struct ShaderReflectionData
+{
+	std::vector<ShaderInputElement> inputs;
+	std::vector<ShaderResourceBinding> bindings;
+};
+
+// ꂽf[^ DXIL(ISGN/RDEF Ȃ)Ȃ false
+bool ParseDxbc(const void* data, size_t size, ShaderReflectionData& reflection);
+
+// D3D12SerializeRootSignature ̌(RTS0  DXBC Rei[)A[gp[^[̎
+// (D3D12_ROOT_PARAMETER_TYPE)ɓǂށBꂽf[^Ȃ false
+bool ParseRootSignatureParameters(const void* data, size_t size, std::vector<uint32_t>& parameterTypes);
+
+// LbVɏo߂̌`Bkey ͌ĂяoŌ߂l(\[X̃nbVȂ)
+std::vector<uint8_t> SerializeReflection(const ShaderReflectionData& reflection, uint64_t key);
+// key vȂ false
+bool DeserializeReflection(const std::vector<uint8_t>& bytes, uint64_t key, ShaderReflectionData& reflection);
+}
+}
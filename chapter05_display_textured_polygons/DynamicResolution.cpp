@@ -0,0 +1,95 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace yuxx {
+namespace DirectX12 {
+DynamicResolutionController::DynamicResolutionController(const Settings& settings)
+	: m_settings(settings)
+{
+	Reset();
+}
+
+void DynamicResolutionController::Reset()
+{
+	m_scale = m_settings.maxScale;
+	m_smoothedMilliseconds = 0.0;
+	m_previousError = 0.0;
+	m_previousPreviousError = 0.0;
+	m_sampleCount = 0;
+}
+
+float DynamicResolutionController::Update(double gpuMilliseconds)
+{
+	if (gpuMilliseconds <= 0.0) {
+		return m_scale;
+	}
+	m_smoothedMilliseconds = m_sampleCount == 0
+		? gpuMilliseconds
+		: m_smoothedMilliseconds + (gpuMilliseconds - m_smoothedMilliseconds) * m_settings.smoothing;
+
+	// Ȃ]T({グ)
+	double error = (m_settings.targetMilliseconds - m_smoothedMilliseconds) / m_settings.targetMilliseconds;
+	if (std::abs(error) < m_settings.deadBand) {
+		error = 0.0;
+	}
+
+	// x`Ȃ̂Őϕɍς݁A{㉺ɒtĂϕ܂Ȃ
+	double step = m_settings.integralGain * error;
+	if (m_sampleCount > 0) {
+		step += m_settings.proportionalGain * (error - m_previousError);
+	}
+	if (m_sampleCount > 1) {
+		step += m_settings.derivativeGain * (error - 2.0 * m_previousError + m_previousPreviousError);
+	}
+	step = (std::min)((std::max)(step, -m_settings.maxStep), m_settings.maxStep);
+
+	m_scale = static_cast<float>(
+		(std::min)((std::max)(m_scale + step, static_cast<double>(m_settings.minScale)), static_cast<double>(m_settings.maxScale))
+	);
+	m_previousPreviousError = m_previousError;
+	m_previousError = error;
+	++m_sampleCount;
+	return m_scale;
+}
+
+bool ReadFrameTimeTrace(std::istream& stream, std::vector<double>& milliseconds)
+{
+	milliseconds.clear();
+	std::string line;
+	while (std::getline(stream, line)) {
+		const size_t comment = line.find('#');
+		if (comment != std::string::npos) {
+			line.erase(comment);
+		}
+		std::istringstream fields(line);
+		double value = 0.0;
+		if (!(fields >> value)) {
+			// sƃRg̍s͔΂AȊO͉ꂽL^ƂĈ
+			if (line.find_first_not_of(" \t\r") != std::string::npos) {
+				return false;
+			}
+			continue;
+		}
+		std::string rest;
+		if (fields >> rest || value < 0.0) {
+			return false;
+		}
+		milliseconds.push_back(value);
+	}
+	return !milliseconds.empty();
+}
+
+bool LoadFrameTimeTrace(const std::string& path, std::vector<double>& milliseconds)
+{
+	std::ifstream stream(path);
+	if (!stream) {
+		return false;
+	}
+	return ReadFrameTimeTrace(stream, milliseconds);
+}
+}
+}
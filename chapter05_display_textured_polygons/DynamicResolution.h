@@ -0,0 +1,53 @@
+#pragma once
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+// GPU ̃t[Ԃ`𑜓x̔{(cꂼɊ|)߂
+class DynamicResolutionController
+{
+public:
+	struct Settings
+	{
+		// ̎ԂɎ܂悤ɔ{𓮂B60Hz ŏ]Tl
+		double targetMilliseconds = 15.0;
+		float minScale = 0.5f;
+		float maxScale = 1.0f;
+		// x` PID ̌WB덷͖ڕWԂƂ̔ŁAo͔͂{̕ω
+		double proportionalGain = 0.15;
+		double integralGain = 0.05;
+		double derivativeGain = 0.02;
+		// vl̂΂}wړς̏d(1 Ȃ畽Ȃ)
+		double smoothing = 0.3;
+		// 덷̔䗦Ɏ܂ĂƂ͓Ȃ(h)
+		double deadBand = 0.03;
+		// 1t[œʂ̏
+		double maxStep = 0.05;
+	};
+
+	DynamicResolutionController() = default;
+	explicit DynamicResolutionController(const Settings& settings);
+
+	// 1t[ GPU ԂnÃt[̔{Ԃ
+	float Update(double gpuMilliseconds);
+	float Scale() const { return m_scale; }
+	double SmoothedMilliseconds() const { return m_smoothedMilliseconds; }
+	void Reset();
+
+private:
+	Settings m_settings;
+	float m_scale = 1.0f;
+	double m_smoothedMilliseconds = 0.0;
+	double m_previousError = 0.0;
+	double m_previousPreviousError = 0.0;
+	int m_sampleCount = 0;
+};
+
+// GPU Ԃ̋L^B1s1t[̃~bA# s܂ł̓RgɂB
+// I𑜓x؂({ 1 )L^̂AeXgŔ{ɉďk߂ȂRg[[ɗ
+bool ReadFrameTimeTrace(std::istream& stream, std::vector<double>& milliseconds);
+bool LoadFrameTimeTrace(const std::string& path, std::vector<double>& milliseconds);
+}
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace yuxx {
+namespace DirectX12 {
+// t@C̃pXBWindows ł̓ChAȊOł UTF-8 ̕
+#ifdef _WIN32
+using PathChar = wchar_t;
+#else
+using PathChar = char;
+#endif // _WIN32
+using PathString = std::basic_string<PathChar>;
+
+// t@C̍ŏIXVBׂ邾Ȃ̂ŒPʂ͎(Win32  FILETIME  100nsALinux  ns)
+using FileTimestamp = uint64_t;
+
+// fBNg̃t@C̕ύX OS ʒmĂ炤B
+// Win32FileWatcher.cpp(FindFirstChangeNotification) InotifyFileWatcher.cpp(inotify)̂ǂ炩rh
+class FileWatcher
+{
+public:
+	virtual ~FileWatcher() = default;
+
+	// TufBNg͌Ȃ
+	virtual bool AddWatchDirectory(const PathString& directory) = 0;
+	// OĂłʒmĂ true ԂB҂Ȃ
+	virtual bool ConsumeNotifications() = 0;
+};
+
+std::unique_ptr<FileWatcher> CreateFileWatcher();
+
+// fBXÑt@C̍ŏIXVBt@CȂ false
+bool GetFileLastWriteTime(const PathString& path, FileTimestamp& timestamp);
+}
+}
@@ -0,0 +1,122 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// A[iƂ̔ԍB0 ͂ǂ̃A[iwȂ
+	std::atomic<uint64_t> g_nextArenaId{ 1 };
+}
+
+thread_local FrameArena::ThreadCursor FrameArena::t_cursors[FrameArena::kThreadCursorSlots];
+
+FrameArena::FrameArena(size_t chunkSize) :
+	m_id(g_nextArenaId.fetch_add(1)),
+	m_chunkSize(chunkSize)
+{
+}
+
+FrameArena::~FrameArena()
+{
+	for (const Chunk& chunk : m_usedChunks) {
+		::operator delete(chunk.memory);
+	}
+	for (const Chunk& chunk : m_freeChunks) {
+		::operator delete(chunk.memory);
+	}
+}
+
+FrameArena::Chunk FrameArena::TakeChunk(size_t size)
+{
+	// ʏ̑傫̃`N͎g񂷁B傫̂͂̂Ǌmۂ
+	if (size <= m_chunkSize) {
+		if (!m_freeChunks.empty()) {
+			const Chunk chunk = m_freeChunks.back();
+			m_freeChunks.pop_back();
+			return chunk;
+		}
+		size = m_chunkSize;
+	}
+	return { static_cast<uint8_t*>(::operator new(size)), size };
+}
+
+void* FrameArena::AllocateSlow(ThreadCursor& cursor, size_t size, size_t alignment)
+{
+	const uint64_t generation = m_generation.load(std::memory_order_relaxed);
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	// ̃Xbh̐ŏ߂ĊmۂȂAubN蓖Ă
+	if (cursor.arenaId != m_id || cursor.generation != generation) {
+		if (m_blockCount == m_blocks.size()) {
+			m_blocks.emplace_back(new ThreadBlock());
+		}
+		ThreadBlock* block = m_blocks[m_blockCount++].get();
+		*block = ThreadBlock();
+		cursor = { m_id, generation, block };
+	}
+	ThreadBlock& block = *cursor.block;
+
+	// `N 1/4 𒴂mۂ͐p̃`NɒuÃ`N̎ĉ͎ĂȂ
+	const size_t paddedSize = size + alignment - 1;
+	if (paddedSize > m_chunkSize / 4) {
+		const Chunk chunk = TakeChunk(paddedSize);
+		m_usedChunks.push_back(chunk);
+		uint8_t* aligned = AlignUp(chunk.memory, alignment);
+		++block.allocationCount;
+		block.allocatedBytes += size;
+#ifdef _DEBUG
+		std::memset(aligned, 0xCD, size);
+#endif // _DEBUG
+		return aligned;
+	}
+
+	const Chunk chunk = TakeChunk(m_chunkSize);
+	m_usedChunks.push_back(chunk);
+	block.current = chunk.memory;
+	block.end = chunk.memory + chunk.size;
+
+	uint8_t* aligned = AlignUp(block.current, alignment);
+	block.current = aligned + size;
+	++block.allocationCount;
+	block.allocatedBytes += size;
+#ifdef _DEBUG
+	std::memset(aligned, 0xCD, size);
+#endif // _DEBUG
+	return aligned;
+}
+
+void FrameArena::Reset()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	Stats stats;
+	for (size_t i = 0; i < m_blockCount; ++i) {
+		stats.allocationCount += m_blocks[i]->allocationCount;
+		stats.allocatedBytes += m_blocks[i]->allocatedBytes;
+	}
+	stats.chunkCount = m_usedChunks.size();
+	for (const Chunk& chunk : m_usedChunks) {
+		stats.reservedBytes += chunk.size;
+	}
+	m_lastFrameStats = stats;
+
+	for (const Chunk& chunk : m_usedChunks) {
+#ifdef _DEBUG
+		// ̂Ă̈ǂ񂾂炷킩悤ɂ
+		std::memset(chunk.memory, 0xDD, chunk.size);
+#endif // _DEBUG
+		if (chunk.size == m_chunkSize) {
+			m_freeChunks.push_back(chunk);
+		} else {
+			::operator delete(chunk.memory);
+		}
+	}
+	m_usedChunks.clear();
+	m_blockCount = 0;
+	m_generation.fetch_add(1, std::memory_order_relaxed);
+}
+}
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+// 1t[̊Ԃg CPU ̃f[^(`惊Xgבւ̃L[Ȃ)؂oA[iB
+// XbhƂɃ`NĐ擪l߂ĂȂ̂ŁAbNȂB
+// Reset ł܂Ƃ߂Ď̂ĂB_DEBUG ł͊mۂ̈ 0xCDÂĂ̈ 0xDD Ŗ߂
+class FrameArena
+{
+public:
+	struct Stats
+	{
+		uint64_t allocationCount = 0;
+		uint64_t allocatedBytes = 0;
+		// mۂĂ`N̐ƍvTCY(傫ȊmۂŕʂɎ̂܂)
+		size_t chunkCount = 0;
+		size_t reservedBytes = 0;
+	};
+
+	explicit FrameArena(size_t chunkSize = 256 * 1024);
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+	~FrameArena();
+
+	// ǂ̃XbhłĂׂBReset ܂ł͗L
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+	template <typename T>
+	T* AllocateArray(size_t count)
+	{
+		return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	// mۂׂ̂Ď̂ĂB̃Xbh Allocate ĂȂƂ
+	// (t[̃tFX҂IƂȂ)ɌĂ
+	void Reset();
+
+	// O Reset ܂ł1t[̏Wv
+	const Stats& LastFrameStats() const { return m_lastFrameStats; }
+
+private:
+	// 1Xbhl߂Ă`N
+	struct ThreadBlock
+	{
+		uint8_t* current = nullptr;
+		uint8_t* end = nullptr;
+		uint64_t allocationCount = 0;
+		uint64_t allocatedBytes = 0;
+	};
+	// XbhƂɁAǂ̃A[îǂ̐̃ubNgĂ邩
+	struct ThreadCursor
+	{
+		uint64_t arenaId = 0;
+		uint64_t generation = 0;
+		ThreadBlock* block = nullptr;
+	};
+	struct Chunk
+	{
+		uint8_t* memory;
+		size_t size;
+	};
+
+	// XbhœɎgA[i̐𒴂ƁAւ邽тɃ`N蒼
+	static constexpr size_t kThreadCursorSlots = 4;
+	static thread_local ThreadCursor t_cursors[kThreadCursorSlots];
+
+	const uint64_t m_id;
+	const size_t m_chunkSize;
+	// Reset ̂тɐi߂BẪJ[\͎gȂ
+	std::atomic<uint64_t> m_generation{ 1 };
+
+	std::mutex m_mutex;
+	// ̐ŎgĂubN(m_blockCount )ƁAg񂷂߂ɎcĂ
+	std::vector<std::unique_ptr<ThreadBlock>> m_blocks;
+	size_t m_blockCount = 0;
+	std::vector<Chunk> m_usedChunks;
+	std::vector<Chunk> m_freeChunks;
+	Stats m_lastFrameStats;
+
+	void* AllocateSlow(ThreadCursor& cursor, size_t size, size_t alignment);
+	Chunk TakeChunk(size_t size);
+	static uint8_t* AlignUp(uint8_t* pointer, size_t alignment);
+};
+
+inline uint8_t* FrameArena::AlignUp(uint8_t* pointer, size_t alignment)
+{
+	const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+	return reinterpret_cast<uint8_t*>((address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1));
+}
+
+inline void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	ThreadCursor& cursor = t_cursors[m_id % kThreadCursorSlots];
+	if (cursor.arenaId == m_id && cursor.generation == m_generation.load(std::memory_order_relaxed)) {
+		ThreadBlock& block = *cursor.block;
+		uint8_t* aligned = AlignUp(block.current, alignment);
+		if (aligned <= block.end && static_cast<size_t>(block.end - aligned) >= size) {
+			block.current = aligned + size;
+			++block.allocationCount;
+			block.allocatedBytes += size;
+#ifdef _DEBUG
+			std::memset(aligned, 0xCD, size);
+#endif // _DEBUG
+			return aligned;
+		}
+	}
+	return AllocateSlow(cursor, size, alignment);
+}
+
+// FrameArena mۂ STL ̃AP[^[B͉AReset ł܂Ƃ߂Ď̂ĂB
+// std::vector L΂ƌÂ̈̓t[̏I܂ŎĉŁA reserve Ă
+template <typename T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	explicit FrameAllocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U>& other) noexcept : m_arena(other.Arena()) {}
+
+	T* allocate(size_t count)
+	{
+		return m_arena->AllocateArray<T>(count);
+	}
+	void deallocate(T*, size_t) noexcept {}
+
+	FrameArena* Arena() const { return m_arena; }
+
+private:
+	FrameArena* m_arena;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T>& left, const FrameAllocator<U>& right)
+{
+	return left.Arena() == right.Arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T>& left, const FrameAllocator<U>& right)
+{
+	return !(left == right);
+}
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
+}
@@ -0,0 +1,665 @@
+#include "FrameCapture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	constexpr uint32_t kCaptureMagic = 0x50414346; // 'FCAP'
+	constexpr uint32_t kCaptureVersion = 3;
+	//  1byte + g̒ 4byte
+	constexpr size_t kCommandHeaderSize = 5;
+
+	// 1̌Ăяo̒g擪͈͂m߂Ȃǂ
+	class PayloadReader
+	{
+	public:
+		PayloadReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+		template <typename T>
+		bool Read(T& value)
+		{
+			if (m_size - m_offset < sizeof(T)) {
+				return false;
+			}
+			std::memcpy(&value, m_data + m_offset, sizeof(T));
+			m_offset += sizeof(T);
+			return true;
+		}
+
+		// (uint32_t)t̃oCgBRs[ɒw
+		bool ReadBytes(const uint8_t*& data, uint32_t& size)
+		{
+			if (!Read(size) || m_size - m_offset < size) {
+				return false;
+			}
+			data = m_data + m_offset;
+			m_offset += size;
+			return true;
+		}
+
+		bool ReadVector(std::vector<uint8_t>& bytes)
+		{
+			const uint8_t* data = nullptr;
+			uint32_t size = 0;
+			if (!ReadBytes(data, size)) {
+				return false;
+			}
+			bytes.assign(data, data + size);
+			return true;
+		}
+
+		bool ReadString(std::string& value)
+		{
+			const uint8_t* data = nullptr;
+			uint32_t size = 0;
+			if (!ReadBytes(data, size)) {
+				return false;
+			}
+			value.assign(reinterpret_cast<const char*>(data), size);
+			return true;
+		}
+
+		bool AtEnd() const { return m_offset == m_size; }
+
+	private:
+		const uint8_t* m_data;
+		size_t m_size;
+		size_t m_offset = 0;
+	};
+
+	// 1̌Ăяoǂ recorder ɓnBnĂԂ̎Ԃ elapsed ɕԂ
+	bool ReplayCommand(
+		CaptureCommand command,
+		PayloadReader& reader,
+		CommandRecorder& recorder,
+		std::chrono::steady_clock::duration& elapsed
+	) {
+		using Clock = std::chrono::steady_clock;
+		Clock::time_point start;
+		bool succeeded = true;
+
+		switch (command) {
+		case CaptureCommand::CreateBuffer: {
+			RecorderObjectId id = 0;
+			uint64_t size = 0;
+			if (!reader.Read(id) || !reader.Read(size)) {
+				return false;
+			}
+			start = Clock::now();
+			succeeded = recorder.CreateBuffer(id, size);
+			break;
+		}
+		case CaptureCommand::CreateTexture: {
+			RecorderObjectId id = 0;
+			RecorderTextureDescription description{};
+			if (!reader.Read(id) || !reader.Read(description)) {
+				return false;
+			}
+			start = Clock::now();
+			succeeded = recorder.CreateTexture(id, description);
+			break;
+		}
+		case CaptureCommand::UploadResource: {
+			RecorderObjectId id = 0;
+			uint32_t rowPitch = 0;
+			const uint8_t* data = nullptr;
+			uint32_t size = 0;
+			if (!reader.Read(id) || !reader.Read(rowPitch) || !reader.ReadBytes(data, size)) {
+				return false;
+			}
+			start = Clock::now();
+			succeeded = recorder.UploadResource(id, data, size, rowPitch);
+			break;
+		}
+		case CaptureCommand::CreateRootSignature: {
+			RecorderObjectId id = 0;
+			const uint8_t* data = nullptr;
+			uint32_t size = 0;
+			if (!reader.Read(id) || !reader.ReadBytes(data, size)) {
+				return false;
+			}
+			start = Clock::now();
+			succeeded = recorder.CreateRootSignature(id, data, size);
+			break;
+		}
+		case CaptureCommand::CreatePipelineState: {
+			RecorderObjectId id = 0;
+			RecorderPipelineDescription description;
+			uint32_t elementCount = 0;
+			if (!reader.Read(id) ||
+				!reader.Read(description.rootSignature) ||
+				!reader.ReadVector(description.vertexShader) ||
+				!reader.ReadVector(description.pixelShader) ||
+				!reader.Read(description.renderTargetFormat) ||
+				!reader.Read(description.primitiveTopologyType) ||
+				!reader.Read(description.blendMode) ||
+				!reader.Read(description.depthStencilFormat) ||
+				!reader.Read(description.depthMode) ||
+				!reader.Read(elementCount)) {
+				return false;
+			}
+			for (uint32_t i = 0; i < elementCount; ++i) {
+				RecorderInputElement element;
+				if (!reader.ReadString(element.semanticName) ||
+					!reader.Read(element.semanticIndex) ||
+					!reader.Read(element.format)) {
+					return false;
+				}
+				description.inputLayout.push_back(std::move(element));
+			}
+			start = Clock::now();
+			succeeded = recorder.CreatePipelineState(id, description);
+			break;
+		}
+		case CaptureCommand::BeginFrame:
+			start = Clock::now();
+			recorder.BeginFrame();
+			break;
+		case CaptureCommand::ClearRenderTarget: {
+			float color[4] = {};
+			if (!reader.Read(color)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.ClearRenderTarget(color);
+			break;
+		}
+		case CaptureCommand::ClearDepth: {
+			float depth = 0.0f;
+			if (!reader.Read(depth)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.ClearDepth(depth);
+			break;
+		}
+		case CaptureCommand::SetPipelineState: {
+			RecorderObjectId id = 0;
+			if (!reader.Read(id)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.SetPipelineState(id);
+			break;
+		}
+		case CaptureCommand::SetGraphicsRootSignature: {
+			RecorderObjectId id = 0;
+			if (!reader.Read(id)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.SetGraphicsRootSignature(id);
+			break;
+		}
+		case CaptureCommand::SetViewport: {
+			RecorderViewport viewport{};
+			if (!reader.Read(viewport)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.SetViewport(viewport);
+			break;
+		}
+		case CaptureCommand::SetScissorRect: {
+			RecorderRect rect{};
+			if (!reader.Read(rect)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.SetScissorRect(rect);
+			break;
+		}
+		case CaptureCommand::SetGraphicsRootTexture: {
+			uint32_t rootParameterIndex = 0;
+			RecorderObjectId texture = 0;
+			if (!reader.Read(rootParameterIndex) || !reader.Read(texture)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.SetGraphicsRootTexture(rootParameterIndex, texture);
+			break;
+		}
+		case CaptureCommand::SetPrimitiveTopology: {
+			uint32_t topology = 0;
+			if (!reader.Read(topology)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.SetPrimitiveTopology(topology);
+			break;
+		}
+		case CaptureCommand::SetVertexBuffer: {
+			RecorderObjectId buffer = 0;
+			uint32_t size = 0;
+			uint32_t stride = 0;
+			if (!reader.Read(buffer) || !reader.Read(size) || !reader.Read(stride)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.SetVertexBuffer(buffer, size, stride);
+			break;
+		}
+		case CaptureCommand::SetIndexBuffer: {
+			RecorderObjectId buffer = 0;
+			uint32_t size = 0;
+			uint32_t format = 0;
+			if (!reader.Read(buffer) || !reader.Read(size) || !reader.Read(format)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.SetIndexBuffer(buffer, size, format);
+			break;
+		}
+		case CaptureCommand::DrawIndexedInstanced: {
+			uint32_t indexCountPerInstance = 0;
+			uint32_t instanceCount = 0;
+			uint32_t startIndexLocation = 0;
+			int32_t baseVertexLocation = 0;
+			uint32_t startInstanceLocation = 0;
+			if (!reader.Read(indexCountPerInstance) ||
+				!reader.Read(instanceCount) ||
+				!reader.Read(startIndexLocation) ||
+				!reader.Read(baseVertexLocation) ||
+				!reader.Read(startInstanceLocation)) {
+				return false;
+			}
+			start = Clock::now();
+			recorder.DrawIndexedInstanced(
+				indexCountPerInstance,
+				instanceCount,
+				startIndexLocation,
+				baseVertexLocation,
+				startInstanceLocation
+			);
+			break;
+		}
+		case CaptureCommand::EndFrame:
+			start = Clock::now();
+			recorder.EndFrame();
+			break;
+		default:
+			return false;
+		}
+
+		elapsed = Clock::now() - start;
+		return succeeded && reader.AtEnd();
+	}
+}
+
+const char* CaptureCommandName(CaptureCommand command)
+{
+	static const char* const kNames[] = {
+		"CreateBuffer",
+		"CreateTexture",
+		"UploadResource",
+		"CreateRootSignature",
+		"CreatePipelineState",
+		"BeginFrame",
+		"ClearRenderTarget",
+		"ClearDepth",
+		"SetPipelineState",
+		"SetGraphicsRootSignature",
+		"SetViewport",
+		"SetScissorRect",
+		"SetGraphicsRootTexture",
+		"SetPrimitiveTopology",
+		"SetVertexBuffer",
+		"SetIndexBuffer",
+		"DrawIndexedInstanced",
+		"EndFrame",
+	};
+	static_assert(
+		sizeof(kNames) / sizeof(kNames[0]) == static_cast<size_t>(CaptureCommand::Count),
+		"Every capture command needs a name."
+	);
+	const size_t index = static_cast<size_t>(command);
+	return index < static_cast<size_t>(CaptureCommand::Count) ? kNames[index] : "Unknown";
+}
+
+CaptureRecorder::CaptureRecorder(CommandRecorder* inner) : m_inner(inner)
+{
+	Write(kCaptureMagic);
+	Write(kCaptureVersion);
+}
+
+bool CaptureRecorder::Save(const std::string& path) const
+{
+	std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+	stream.write(reinterpret_cast<const char*>(m_bytes.data()), m_bytes.size());
+	return static_cast<bool>(stream);
+}
+
+size_t CaptureRecorder::BeginCommand(CaptureCommand command)
+{
+	const size_t start = m_bytes.size();
+	Write(static_cast<uint8_t>(command));
+	Write(uint32_t{ 0 });
+	return start;
+}
+
+void CaptureRecorder::EndCommand(size_t start)
+{
+	const uint32_t payloadSize = static_cast<uint32_t>(m_bytes.size() - start - kCommandHeaderSize);
+	std::memcpy(m_bytes.data() + start + 1, &payloadSize, sizeof(payloadSize));
+}
+
+// insert őƁARXgN^[ł̍ŏ̏( m_bytes) GCC ͈͊Oւ memcpy ƌȂ(-Wstringop-overflow)̂ŁA
+// 傫LĂʂ
+void CaptureRecorder::Append(const void* data, size_t size)
+{
+	if (size == 0) {
+		return;
+	}
+	const size_t offset = m_bytes.size();
+	m_bytes.resize(offset + size);
+	std::memcpy(m_bytes.data() + offset, data, size);
+}
+
+template <typename T>
+void CaptureRecorder::Write(const T& value)
+{
+	Append(&value, sizeof(T));
+}
+
+void CaptureRecorder::WriteBytes(const void* data, size_t size)
+{
+	Write(static_cast<uint32_t>(size));
+	Append(data, size);
+}
+
+bool CaptureRecorder::CreateBuffer(RecorderObjectId id, uint64_t size)
+{
+	const size_t start = BeginCommand(CaptureCommand::CreateBuffer);
+	Write(id);
+	Write(size);
+	EndCommand(start);
+	return m_inner == nullptr || m_inner->CreateBuffer(id, size);
+}
+
+bool CaptureRecorder::CreateTexture(RecorderObjectId id, const RecorderTextureDescription& description)
+{
+	const size_t start = BeginCommand(CaptureCommand::CreateTexture);
+	Write(id);
+	Write(description);
+	EndCommand(start);
+	return m_inner == nullptr || m_inner->CreateTexture(id, description);
+}
+
+bool CaptureRecorder::UploadResource(RecorderObjectId id, const void* data, size_t size, uint32_t rowPitch)
+{
+	const size_t start = BeginCommand(CaptureCommand::UploadResource);
+	Write(id);
+	Write(rowPitch);
+	WriteBytes(data, size);
+	EndCommand(start);
+	return m_inner == nullptr || m_inner->UploadResource(id, data, size, rowPitch);
+}
+
+bool CaptureRecorder::CreateRootSignature(RecorderObjectId id, const void* serialized, size_t size)
+{
+	const size_t start = BeginCommand(CaptureCommand::CreateRootSignature);
+	Write(id);
+	WriteBytes(serialized, size);
+	EndCommand(start);
+	return m_inner == nullptr || m_inner->CreateRootSignature(id, serialized, size);
+}
+
+bool CaptureRecorder::CreatePipelineState(RecorderObjectId id, const RecorderPipelineDescription& description)
+{
+	const size_t start = BeginCommand(CaptureCommand::CreatePipelineState);
+	Write(id);
+	Write(description.rootSignature);
+	WriteBytes(description.vertexShader.data(), description.vertexShader.size());
+	WriteBytes(description.pixelShader.data(), description.pixelShader.size());
+	Write(description.renderTargetFormat);
+	Write(description.primitiveTopologyType);
+	Write(description.blendMode);
+	Write(description.depthStencilFormat);
+	Write(description.depthMode);
+	Write(static_cast<uint32_t>(description.inputLayout.size()));
+	for (const RecorderInputElement& element : description.inputLayout) {
+		WriteBytes(element.semanticName.data(), element.semanticName.size());
+		Write(element.semanticIndex);
+		Write(element.format);
+	}
+	EndCommand(start);
+	return m_inner == nullptr || m_inner->CreatePipelineState(id, description);
+}
+
+void CaptureRecorder::BeginFrame()
+{
+	EndCommand(BeginCommand(CaptureCommand::BeginFrame));
+	if (m_inner != nullptr) {
+		m_inner->BeginFrame();
+	}
+}
+
+void CaptureRecorder::ClearRenderTarget(const float color[4])
+{
+	const size_t start = BeginCommand(CaptureCommand::ClearRenderTarget);
+	for (int i = 0; i < 4; ++i) {
+		Write(color[i]);
+	}
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->ClearRenderTarget(color);
+	}
+}
+
+void CaptureRecorder::ClearDepth(float depth)
+{
+	const size_t start = BeginCommand(CaptureCommand::ClearDepth);
+	Write(depth);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->ClearDepth(depth);
+	}
+}
+
+void CaptureRecorder::SetPipelineState(RecorderObjectId pipelineState)
+{
+	const size_t start = BeginCommand(CaptureCommand::SetPipelineState);
+	Write(pipelineState);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->SetPipelineState(pipelineState);
+	}
+}
+
+void CaptureRecorder::SetGraphicsRootSignature(RecorderObjectId rootSignature)
+{
+	const size_t start = BeginCommand(CaptureCommand::SetGraphicsRootSignature);
+	Write(rootSignature);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->SetGraphicsRootSignature(rootSignature);
+	}
+}
+
+void CaptureRecorder::SetViewport(const RecorderViewport& viewport)
+{
+	const size_t start = BeginCommand(CaptureCommand::SetViewport);
+	Write(viewport);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->SetViewport(viewport);
+	}
+}
+
+void CaptureRecorder::SetScissorRect(const RecorderRect& rect)
+{
+	const size_t start = BeginCommand(CaptureCommand::SetScissorRect);
+	Write(rect);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->SetScissorRect(rect);
+	}
+}
+
+void CaptureRecorder::SetGraphicsRootTexture(uint32_t rootParameterIndex, RecorderObjectId texture)
+{
+	const size_t start = BeginCommand(CaptureCommand::SetGraphicsRootTexture);
+	Write(rootParameterIndex);
+	Write(texture);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->SetGraphicsRootTexture(rootParameterIndex, texture);
+	}
+}
+
+void CaptureRecorder::SetPrimitiveTopology(uint32_t topology)
+{
+	const size_t start = BeginCommand(CaptureCommand::SetPrimitiveTopology);
+	Write(topology);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->SetPrimitiveTopology(topology);
+	}
+}
+
+void CaptureRecorder::SetVertexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t stride)
+{
+	const size_t start = BeginCommand(CaptureCommand::SetVertexBuffer);
+	Write(buffer);
+	Write(size);
+	Write(stride);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->SetVertexBuffer(buffer, size, stride);
+	}
+}
+
+void CaptureRecorder::SetIndexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t format)
+{
+	const size_t start = BeginCommand(CaptureCommand::SetIndexBuffer);
+	Write(buffer);
+	Write(size);
+	Write(format);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->SetIndexBuffer(buffer, size, format);
+	}
+}
+
+void CaptureRecorder::DrawIndexedInstanced(
+	uint32_t indexCountPerInstance,
+	uint32_t instanceCount,
+	uint32_t startIndexLocation,
+	int32_t baseVertexLocation,
+	uint32_t startInstanceLocation
+) {
+	const size_t start = BeginCommand(CaptureCommand::DrawIndexedInstanced);
+	Write(indexCountPerInstance);
+	Write(instanceCount);
+	Write(startIndexLocation);
+	Write(baseVertexLocation);
+	Write(startInstanceLocation);
+	EndCommand(start);
+	if (m_inner != nullptr) {
+		m_inner->DrawIndexedInstanced(
+			indexCountPerInstance,
+			instanceCount,
+			startIndexLocation,
+			baseVertexLocation,
+			startInstanceLocation
+		);
+	}
+}
+
+void CaptureRecorder::EndFrame()
+{
+	EndCommand(BeginCommand(CaptureCommand::EndFrame));
+	if (m_inner != nullptr) {
+		m_inner->EndFrame();
+	}
+}
+
+bool LoadCapture(const std::string& path, std::vector<uint8_t>& bytes)
+{
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream) {
+		return false;
+	}
+	bytes.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	return true;
+}
+
+bool ReplayCapture(const std::vector<uint8_t>& bytes, CommandRecorder& recorder, ReplayReport& report)
+{
+	report = ReplayReport();
+
+	PayloadReader header(bytes.data(), bytes.size());
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	if (!header.Read(magic) || magic != kCaptureMagic || !header.Read(version) || version != kCaptureVersion) {
+		return false;
+	}
+
+	size_t offset = sizeof(kCaptureMagic) + sizeof(kCaptureVersion);
+	while (offset < bytes.size()) {
+		PayloadReader commandHeader(bytes.data() + offset, bytes.size() - offset);
+		uint8_t command = 0;
+		uint32_t payloadSize = 0;
+		if (!commandHeader.Read(command) || !commandHeader.Read(payloadSize) ||
+			bytes.size() - offset - kCommandHeaderSize < payloadSize) {
+			return false;
+		}
+		PayloadReader payload(bytes.data() + offset + kCommandHeaderSize, payloadSize);
+
+		std::chrono::steady_clock::duration elapsed{};
+		if (!ReplayCommand(static_cast<CaptureCommand>(command), payload, recorder, elapsed)) {
+			return false;
+		}
+
+		const double microseconds = std::chrono::duration<double, std::micro>(elapsed).count();
+		ReplayReport::CallStats& stats = report.calls[command];
+		++stats.count;
+		stats.totalMicroseconds += microseconds;
+		stats.maxMicroseconds = (std::max)(stats.maxMicroseconds, microseconds);
+		++report.commandCount;
+		report.totalMicroseconds += microseconds;
+
+		offset += kCommandHeaderSize + payloadSize;
+	}
+	return true;
+}
+
+std::string FormatReplayReport(const ReplayReport& report)
+{
+	std::string text;
+	char line[128];
+	for (size_t i = 0; i < report.calls.size(); ++i) {
+		const ReplayReport::CallStats& stats = report.calls[i];
+		if (stats.count == 0) {
+			continue;
+		}
+		std::snprintf(
+			line,
+			sizeof(line),
+			"%-26s %8llu calls %10.1f us (avg %7.2f, max %7.2f)\n",
+			CaptureCommandName(static_cast<CaptureCommand>(i)),
+			static_cast<unsigned long long>(stats.count),
+			stats.totalMicroseconds,
+			stats.totalMicroseconds / stats.count,
+			stats.maxMicroseconds
+		);
+		text += line;
+	}
+	std::snprintf(
+		line,
+		sizeof(line),
+		"%-26s %8llu calls %10.1f us\n",
+		"Total",
+		static_cast<unsigned long long>(report.commandCount),
+		report.totalMicroseconds
+	);
+	return text + line;
+}
+}
+}
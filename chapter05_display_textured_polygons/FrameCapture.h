@@ -0,0 +1,106 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CommandRecorder.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// Lv`t@CɏĂяo̎ށBCommandRecorder ̃\bh11
+enum class CaptureCommand : uint8_t {
+	CreateBuffer,
+	CreateTexture,
+	UploadResource,
+	CreateRootSignature,
+	CreatePipelineState,
+	BeginFrame,
+	ClearRenderTarget,
+	ClearDepth,
+	SetPipelineState,
+	SetGraphicsRootSignature,
+	SetViewport,
+	SetScissorRect,
+	SetGraphicsRootTexture,
+	SetPrimitiveTopology,
+	SetVertexBuffer,
+	SetIndexBuffer,
+	DrawIndexedInstanced,
+	EndFrame,
+	Count,
+};
+const char* CaptureCommandName(CaptureCommand command);
+
+// 󂯎ĂяoLv`ɏȂ inner ɓnBinner  nullptr Ȃ珑B
+// `̓wb_[('FCAP', o[W)̂Ƃ [ 1byte][g̒ 4byte][g] ׂ́B
+// l̓gGfBÂ܂܏̂ŁAĂяo͓oCgɂȂ
+class CaptureRecorder : public CommandRecorder
+{
+public:
+	explicit CaptureRecorder(CommandRecorder* inner);
+
+	const std::vector<uint8_t>& Bytes() const { return m_bytes; }
+	bool Save(const std::string& path) const;
+
+	bool CreateBuffer(RecorderObjectId id, uint64_t size) override;
+	bool CreateTexture(RecorderObjectId id, const RecorderTextureDescription& description) override;
+	bool UploadResource(RecorderObjectId id, const void* data, size_t size, uint32_t rowPitch) override;
+	bool CreateRootSignature(RecorderObjectId id, const void* serialized, size_t size) override;
+	bool CreatePipelineState(RecorderObjectId id, const RecorderPipelineDescription& description) override;
+
+	void BeginFrame() override;
+	void ClearRenderTarget(const float color[4]) override;
+	void ClearDepth(float depth) override;
+	void SetPipelineState(RecorderObjectId pipelineState) override;
+	void SetGraphicsRootSignature(RecorderObjectId rootSignature) override;
+	void SetViewport(const RecorderViewport& viewport) override;
+	void SetScissorRect(const RecorderRect& rect) override;
+	void SetGraphicsRootTexture(uint32_t rootParameterIndex, RecorderObjectId texture) override;
+	void SetPrimitiveTopology(uint32_t topology) override;
+	void SetVertexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t stride) override;
+	void SetIndexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t format) override;
+	void DrawIndexedInstanced(
+		uint32_t indexCountPerInstance,
+		uint32_t instanceCount,
+		uint32_t startIndexLocation,
+		int32_t baseVertexLocation,
+		uint32_t startInstanceLocation
+	) override;
+	void EndFrame() override;
+
+private:
+	CommandRecorder* m_inner;
+	std::vector<uint8_t> m_bytes;
+
+	// g̒ EndCommand Ŗ߂
+	size_t BeginCommand(CaptureCommand command);
+	void EndCommand(size_t start);
+	void Append(const void* data, size_t size);
+	template <typename T>
+	void Write(const T& value);
+	void WriteBytes(const void* data, size_t size);
+};
+
+bool LoadCapture(const std::string& path, std::vector<uint8_t>& bytes);
+
+// Ăяo̎ނƂ CPU (Đ̃\bh̒ŎgԂŁAǂݏo͊܂܂Ȃ)
+struct ReplayReport
+{
+	struct CallStats
+	{
+		uint64_t count = 0;
+		double totalMicroseconds = 0.0;
+		double maxMicroseconds = 0.0;
+	};
+	std::array<CallStats, static_cast<size_t>(CaptureCommand::Count)> calls;
+	uint64_t commandCount = 0;
+	double totalMicroseconds = 0.0;
+};
+
+// Lv`̌Ăяo recorder ɓnBĂ쐬Ɏs肵 false
+bool ReplayCapture(const std::vector<uint8_t>& bytes, CommandRecorder& recorder, ReplayReport& report);
+// 1s1ނA񐔁EvEρEőׂ
+std::string FormatReplayReport(const ReplayReport& report);
+}
+}
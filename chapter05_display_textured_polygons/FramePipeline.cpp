@@ -0,0 +1,82 @@
+#include "FramePipeline.h"
+
+#include <algorithm>
+
+namespace yuxx {
+namespace DirectX12 {
+FramePipeline::FramePipeline(FrameQueues& queues, uint32_t framesInFlight)
+	: m_queues(queues), m_slots((std::max)(framesInFlight, 2u))
+{
+}
+
+uint32_t FramePipeline::BeginFrame(bool& reused)
+{
+	m_currentSlot = static_cast<uint32_t>(m_frameCount % m_slots.size());
+	const Slot& slot = m_slots[m_currentSlot];
+	reused = slot.used;
+	if (slot.used) {
+		// Present ͕`̂Ƃɐςł̂ŁA҂ĂΕ`IĂ
+		m_queues.WaitOnCpu(GpuQueueType::Direct, (std::max)(slot.graphicsFence, slot.presentFence));
+		m_queues.WaitOnCpu(GpuQueueType::Compute, slot.postProcessFence);
+	}
+	return m_currentSlot;
+}
+
+bool FramePipeline::EndFrame()
+{
+	Slot& slot = m_slots[m_currentSlot];
+	slot.graphicsFence = m_queues.SubmitGraphics(m_currentSlot);
+	if (slot.graphicsFence == 0) {
+		return false;
+	}
+	m_lastDirectFence = slot.graphicsFence;
+	slot.used = true;
+	++m_frameCount;
+
+	// 1Õt[̃|XgvZX́Ãt[̕`ƏdȂēĂB
+	// `ɐςł΁APresent ̑Ȏ҂ŕ`L[~܂Ă`͑҂Ȃ
+	if (!PresentPending()) {
+		return false;
+	}
+
+	m_queues.WaitOnGpu(GpuQueueType::Compute, GpuQueueType::Direct, slot.graphicsFence);
+	slot.postProcessFence = m_queues.SubmitPostProcess(m_currentSlot);
+	if (slot.postProcessFence == 0) {
+		return false;
+	}
+	m_lastComputeFence = slot.postProcessFence;
+	m_pendingPresentSlot = static_cast<int>(m_currentSlot);
+	return true;
+}
+
+bool FramePipeline::Flush()
+{
+	const bool presented = PresentPending();
+	m_queues.WaitOnCpu(GpuQueueType::Direct, m_lastDirectFence);
+	m_queues.WaitOnCpu(GpuQueueType::Compute, m_lastComputeFence);
+	return presented;
+}
+
+void FramePipeline::WaitForDirectQueue()
+{
+	m_queues.WaitOnCpu(GpuQueueType::Direct, m_lastDirectFence);
+}
+
+bool FramePipeline::PresentPending()
+{
+	if (m_pendingPresentSlot < 0) {
+		return true;
+	}
+	const uint32_t slotIndex = static_cast<uint32_t>(m_pendingPresentSlot);
+	Slot& pending = m_slots[slotIndex];
+	m_pendingPresentSlot = -1;
+	m_queues.WaitOnGpu(GpuQueueType::Direct, GpuQueueType::Compute, pending.postProcessFence);
+	pending.presentFence = m_queues.SubmitPresent(slotIndex);
+	if (pending.presentFence == 0) {
+		return false;
+	}
+	m_lastDirectFence = pending.presentFence;
+	return true;
+}
+}
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+enum class GpuQueueType {
+	Direct,
+	Compute,
+};
+
+// FramePipeline t[ςސBDirectXManager(D3D12 ̃L[) QueueTimelineSimulator(eXg)B
+// Submit* ̖߂ĺAς񂾏IƂ\̃L[̃tFXl(sȂ 0)
+class FrameQueues
+{
+public:
+	virtual ~FrameQueues() = default;
+
+	// slot  HDR ^[QbgɋL^``L[ɐς
+	virtual uint64_t SubmitGraphics(uint32_t slot) = 0;
+	// slot  HDR ^[Qbg͂ɂ|XgvZXRs[gL[ɐς
+	virtual uint64_t SubmitPostProcess(uint32_t slot) = 0;
+	// slot ̃|XgvZX̏o͂obNobt@[Ɏʂ Present (`L[)
+	virtual uint64_t SubmitPresent(uint32_t slot) = 0;
+	// ȍ~ queue ɐςޏ́AGPU  signalingQueue  fenceValue ɒB܂ő҂
+	virtual void WaitOnGpu(GpuQueueType queue, GpuQueueType signalingQueue, uint64_t fenceValue) = 0;
+	// queue  fenceValue ɒB܂ CPU ő҂
+	virtual void WaitOnCpu(GpuQueueType queue, uint64_t fenceValue) = 0;
+};
+
+// `L[ł̕`ƃRs[gL[ł̃|XgvZXd˂ăt[i߂B
+// t[ N ̃|XgvZX̓t[ N + 1 ̕`ƕœAt[ N  Present ̓t[ N + 1 ̕`ς񂾂Ƃɍs(1t[x)B
+// HDR ^[QbgR}hAP[^[Ȃǃt[Ƃ̂̂ framesInFlight g(Xbg)pӂĂA
+// Xbgg񂷑OɁÃXbgOɎgt[ Present ܂ŏÎ CPU ő҂
+class FramePipeline
+{
+public:
+	// framesInFlight  2 ȏɂ(Present ҂ĂԂɁÃt[ʂ̃Xbgɕ`)B
+	// Present 1t[xĐςނ̂ŁA2 ƃXbgg񂷂ƂɒOɐς Present ҂ƂɂȂA
+	// CPU ̋L^ GPU قƂǏdȂȂBd˂Ȃ 3 ɂ
+	FramePipeline(FrameQueues& queues, uint32_t framesInFlight);
+
+	uint32_t FramesInFlight() const { return static_cast<uint32_t>(m_slots.size()); }
+
+	// ̃t[ŎgXbgBOɂ̃Xbggt[ GPU ŏI܂ő҂ĂԂB
+	// reused ́AIt[̃Xbgɂ(GPU ԂȂǂǂݖ߂Ă悢)B
+	// L^ɎsƂȂǁAEndFrame ɂxĂԂƓXbgԂ
+	uint32_t BeginFrame(bool& reused);
+	// BeginFrame ̃Xbg̕`ς݁A1Õt[ Present Ãt[̃|XgvZXς
+	bool EndFrame();
+	// ҂Ă Present ς݁A܂łɐς񂾂ׂ̂ďI܂ CPU ő҂B
+	// Xbv`F[̍蒼At[܂Ŏg\[XւOɌĂ
+	bool Flush();
+	// `L[ɐς񂾂̂I܂ CPU ő҂(Present ͐ς܂Ȃ)B
+	// 1gȂ`L[Ŏg(^C̃Abv[hpobt@[Ȃ)OɌĂ
+	void WaitForDirectQueue();
+
+private:
+	struct Slot
+	{
+		uint64_t graphicsFence = 0;
+		uint64_t postProcessFence = 0;
+		uint64_t presentFence = 0;
+		bool used = false;
+	};
+
+	FrameQueues& m_queues;
+	std::vector<Slot> m_slots;
+	// EndFrame ܂Ői񂾃t[̐
+	uint64_t m_frameCount = 0;
+	uint32_t m_currentSlot = 0;
+	// Present ҂ĂXbgBȂ -1
+	int m_pendingPresentSlot = -1;
+	uint64_t m_lastDirectFence = 0;
+	uint64_t m_lastComputeFence = 0;
+
+	bool PresentPending();
+};
+}
+}
@@ -0,0 +1,91 @@
+#include "GpuTimer.h"
+
+#include <d3dx12.h>
+
+#include "Helpers.h"
+
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// t[ƂɎn߂ƏI2
+	constexpr UINT kTimestampCount = 2;
+}
+
+bool GpuTimer::Initialize(ID3D12Device* device, ID3D12CommandQueue* queue, UINT frameCount)
+{
+	HRESULT result = queue->GetTimestampFrequency(&m_frequency);
+	if (FAILED(result)) {
+		DebugOutputFormatString("GetTimestampFrequency Error : 0x%x\n", result);
+		return false;
+	}
+
+	D3D12_QUERY_HEAP_DESC queryHeapDesc{};
+	queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+	queryHeapDesc.Count = kTimestampCount * frameCount;
+	result = device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(m_queryHeap.ReleaseAndGetAddressOf()));
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateQueryHeap Error : 0x%x\n", result);
+		return false;
+	}
+
+	const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_READBACK);
+	const CD3DX12_RESOURCE_DESC resourceDescription = CD3DX12_RESOURCE_DESC::Buffer(sizeof(UINT64) * kTimestampCount * frameCount);
+	result = device->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDescription,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(m_readbackBuffer.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommittedResource Error (for timestamp): 0x%x\n", result);
+		return false;
+	}
+	return true;
+}
+
+void GpuTimer::Begin(ID3D12GraphicsCommandList* commandList, UINT frame)
+{
+	commandList->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, frame * kTimestampCount);
+}
+
+void GpuTimer::End(ID3D12GraphicsCommandList* commandList, UINT frame)
+{
+	const UINT first = frame * kTimestampCount;
+	commandList->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, first + 1);
+	commandList->ResolveQueryData(
+		m_queryHeap.Get(),
+		D3D12_QUERY_TYPE_TIMESTAMP,
+		first,
+		kTimestampCount,
+		m_readbackBuffer.Get(),
+		sizeof(UINT64) * first
+	);
+}
+
+double GpuTimer::ReadMilliseconds(UINT frame) const
+{
+	const SIZE_T offset = sizeof(UINT64) * frame * kTimestampCount;
+	const D3D12_RANGE readRange = { offset, offset + sizeof(UINT64) * kTimestampCount };
+	UINT8* mapped = nullptr;
+	HRESULT result = m_readbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped));
+	if (FAILED(result)) {
+		DebugOutputFormatString("Timestamp buffer map Error : 0x%x\n", result);
+		return 0.0;
+	}
+	const UINT64* timestamps = reinterpret_cast<const UINT64*>(mapped + offset);
+	const UINT64 begin = timestamps[0];
+	const UINT64 end = timestamps[1];
+	const D3D12_RANGE writeRange = { 0, 0 };
+	m_readbackBuffer->Unmap(0, &writeRange);
+
+	if (end <= begin || m_frequency == 0) {
+		return 0.0;
+	}
+	return static_cast<double>(end - begin) * 1000.0 / static_cast<double>(m_frequency);
+}
+}
+}
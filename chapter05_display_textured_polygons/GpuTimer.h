@@ -0,0 +1,26 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl.h>
+
+namespace yuxx {
+namespace DirectX12 {
+// R}hXg̎n߂ƏIɃ^CX^vÅԂ GPU ԂǂށB
+//  GPU ɐςރt[̐(frameCount)^CX^vƓǂݖ߂
+class GpuTimer
+{
+public:
+	bool Initialize(ID3D12Device* device, ID3D12CommandQueue* queue, UINT frameCount);
+
+	void Begin(ID3D12GraphicsCommandList* commandList, UINT frame);
+	// Ĩ^CX^vAǂݖ߂pobt@[ɉ
+	void End(ID3D12GraphicsCommandList* commandList, UINT frame);
+	// frame  End ς񂾃R}hXg̊҂ĂĂԂ
+	double ReadMilliseconds(UINT frame) const;
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12QueryHeap> m_queryHeap;
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_readbackBuffer;
+	UINT64 m_frequency = 0;
+};
+}
+}
@@ -0,0 +1,977 @@
+#include "HotPathBenchmarks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Culling.h"
+#include "DescriptorAllocator.h"
+#include "DrawSorting.h"
+#include "FrameArena.h"
+#include "FrameCapture.h"
+#include "ImageCodec.h"
+#include "JobSystem.h"
+#include "NullCommandRecorder.h"
+#include "PostProcessReference.h"
+#include "RenderThread.h"
+#include "SpscQueue.h"
+#include "StartupTaskGraph.h"
+#include "TextureAtlas.h"
+#include "TextureConversion.h"
+#include "TextureCopy.h"
+#include "TileStreaming.h"
+#include "UploadRing.h"
+
+#ifdef _WIN32
+#include "ImageDecoder.h"
+#endif // _WIN32
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+	constexpr size_t kFootprintPitchAlignment = 256;
+	constexpr uint32_t kBytesPerPixel = 4;
+	size_t AlignPitch(size_t rowSize)
+	{
+		return (rowSize + kFootprintPitchAlignment - 1) / kFootprintPitchAlignment * kFootprintPitchAlignment;
+	}
+
+	// 摜̍sAbv[hobt@[̃tbgvgɋlߑւB
+	// width  64 ̔{Ȃssb`v1 memcpy ɂȂ
+	void AddCopyRows(BenchmarkSuite& suite, const char* name, uint32_t width, uint32_t height)
+	{
+		const size_t rowSize = static_cast<size_t>(width) * kBytesPerPixel;
+		const size_t footprintPitch = AlignPitch(rowSize);
+		auto source = std::make_shared<std::vector<uint8_t>>(rowSize * height, static_cast<uint8_t>(0x5a));
+		auto destination = std::make_shared<std::vector<uint8_t>>(footprintPitch * height);
+		suite.Add(name, [=]() {
+			CopyRows(destination->data(), footprintPitch, source->data(), rowSize, rowSize, height);
+			return static_cast<uint64_t>(rowSize) * height;
+		});
+	}
+
+	void AddTextureAtlas(BenchmarkSuite& suite)
+	{
+		constexpr uint32_t kAtlasSize = 4096;
+		constexpr uint32_t kPadding = 4;
+
+		// 16`128 sNZ̑傫̉摜 512 l߂
+		auto sizes = std::make_shared<std::vector<std::pair<uint32_t, uint32_t>>>();
+		std::mt19937 random(1);
+		std::uniform_int_distribution<uint32_t> size(16, 128);
+		for (int i = 0; i < 512; ++i) {
+			sizes->emplace_back(size(random), size(random));
+		}
+		suite.Add("atlas/insert_batch_512", [sizes]() {
+			TextureAtlas atlas(kAtlasSize, kAtlasSize, kPadding);
+			std::vector<AtlasRegion> regions;
+			atlas.InsertBatch(*sizes, regions);
+			return static_cast<uint64_t>(0);
+		});
+
+		// 8`64 sNZ̑傫̉摜 10000  8192 x 8192 ɋl߂Bʂ1}CNbɋl߂
+		constexpr uint32_t kLargeAtlasSize = 8192;
+		auto manySizes = std::make_shared<std::vector<std::pair<uint32_t, uint32_t>>>();
+		std::uniform_int_distribution<uint32_t> smallSize(8, 64);
+		for (int i = 0; i < 10000; ++i) {
+			manySizes->emplace_back(smallSize(random), smallSize(random));
+		}
+		suite.AddItems("atlas/insert_10000", [manySizes]() {
+			TextureAtlas atlas(kLargeAtlasSize, kLargeAtlasSize, kPadding);
+			std::vector<AtlasRegion> regions;
+			// 肫Ȃ 0 ԂAʂ 0 items/us ɂȂĂ킩悤ɂ
+			return atlas.InsertBatch(*manySizes, regions) ? static_cast<uint64_t>(regions.size()) : static_cast<uint64_t>(0);
+		});
+
+		// 256x256 ̉摜1AK^[tŃAgXɏ
+		constexpr uint32_t kImageSize = 256;
+		constexpr uint32_t kBlitAtlasSize = 512;
+		const size_t imagePitch = kImageSize * kBytesPerPixel;
+		const size_t atlasPitch = kBlitAtlasSize * kBytesPerPixel;
+		auto image = std::make_shared<std::vector<uint8_t>>(imagePitch * kImageSize, static_cast<uint8_t>(0x7f));
+		auto atlasPixels = std::make_shared<std::vector<uint8_t>>(atlasPitch * kBlitAtlasSize);
+		AtlasRegion region;
+		TextureAtlas atlas(kBlitAtlasSize, kBlitAtlasSize, kPadding);
+		atlas.Insert(kImageSize, kImageSize, region);
+		suite.Add("atlas/blit_with_gutter_256", [=]() {
+			BlitWithGutter(
+				atlasPixels->data(),
+				atlasPitch,
+				kBlitAtlasSize,
+				kBlitAtlasSize,
+				image->data(),
+				imagePitch,
+				region,
+				kPadding
+			);
+			return static_cast<uint64_t>(imagePitch) * kImageSize;
+		});
+	}
+
+	void AddCulling(BenchmarkSuite& suite)
+	{
+		constexpr size_t kAabbCount = 16384;
+
+		// J̑OɎU΂ AABB A悻ɓzuŕׂ
+		auto aabbs = std::make_shared<AabbSoA>();
+		std::mt19937 random(2);
+		std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+		std::uniform_real_distribution<float> extent(0.1f, 2.0f);
+		for (size_t i = 0; i < kAabbCount; ++i) {
+			aabbs->Add({ position(random), position(random), position(random) }, { extent(random), extent(random), extent(random) });
+		}
+		const Float4x4 viewProjection = MultiplyMatrix(
+			LookAtMatrixLH({ 0.0f, 0.0f, -60.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }),
+			PerspectiveFovMatrixLH(kPiDiv4, 16.0f / 9.0f, 1.0f, 100.0f)
+		);
+		const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+		auto visible = std::make_shared<std::vector<uint32_t>>(kAabbCount);
+
+		// 肵 AABB ̐Ԃ̂ŁAʂ1}CNbɃJOɂȂ
+		const struct
+		{
+			const char* name;
+			CullingInstructionSet instructionSet;
+		} paths[] = {
+			{ "culling/cull_aabbs_16k_scalar", CullingInstructionSet::Scalar },
+			{ "culling/cull_aabbs_16k_sse2", CullingInstructionSet::Sse2 },
+			{ "culling/cull_aabbs_16k_avx2", CullingInstructionSet::Avx2 },
+		};
+		for (const auto& path : paths) {
+			if (!IsCullingInstructionSetSupported(path.instructionSet)) {
+				continue;
+			}
+			const CullingInstructionSet instructionSet = path.instructionSet;
+			suite.AddItems(path.name, [=]() {
+				CullAabbs(frustum, *aabbs, visible->data(), nullptr, instructionSet);
+				return static_cast<uint64_t>(aabbs->Size());
+			});
+		}
+
+		// Oɉʂ 1/4 قǂ̔ 64 uẢ AABB IN[Wobt@[ł肷
+		auto occluders = std::make_shared<AabbSoA>();
+		std::uniform_real_distribution<float> occluderPosition(-12.0f, 12.0f);
+		for (int i = 0; i < 64; ++i) {
+			occluders->Add({ occluderPosition(random), occluderPosition(random), -40.0f }, { 4.0f, 4.0f, 0.0f });
+		}
+		const auto rasterizeOccluders = [occluders, frustum](OcclusionBuffer& buffer) {
+			buffer.Clear();
+			for (size_t i = 0; i < occluders->Size(); ++i) {
+				buffer.RasterizeOccluder(
+					frustum,
+					{ occluders->centerX[i], occluders->centerY[i], occluders->centerZ[i] },
+					{ occluders->extentX[i], occluders->extentY[i], occluders->extentZ[i] }
+				);
+			}
+		};
+		auto occlusionBuffer = std::make_shared<OcclusionBuffer>(256, 144);
+		rasterizeOccluders(*occlusionBuffer);
+		auto scratchBuffer = std::make_shared<OcclusionBuffer>(256, 144);
+		suite.AddItems("culling/rasterize_occluders_64", [=]() {
+			rasterizeOccluders(*scratchBuffer);
+			return static_cast<uint64_t>(occluders->Size());
+		});
+		suite.AddItems("culling/cull_aabbs_occluded_16k", [=]() {
+			CullAabbs(frustum, *aabbs, visible->data(), occlusionBuffer.get());
+			return static_cast<uint64_t>(aabbs->Size());
+		});
+	}
+
+	// 1t[ɕ`ςđB`搔ɔႵȂȂƂ(LbVɎ܂ȂȂȂ)
+	void AddCommandRecording(BenchmarkSuite& suite)
+	{
+		const struct
+		{
+			const char* suffix;
+			uint32_t drawCount;
+		} sizes[] = {
+			{ "1k", 1000 },
+			{ "10k", 10000 },
+			{ "100k", 100000 },
+			{ "1m", 1000000 },
+		};
+		for (const auto& size : sizes) {
+			const uint32_t drawCount = size.drawCount;
+			const std::string suffix = size.suffix;
+			suite.Add("submit/null_record_" + suffix, [drawCount]() {
+				return RunNullRecorderBenchmark(drawCount, false).bytes;
+			});
+			suite.Add("submit/null_record_validated_" + suffix, [drawCount]() {
+				return RunNullRecorderBenchmark(drawCount, true).bytes;
+			});
+
+			// t[Lv`ĂAǂݖ߂ Null ɗ
+			CaptureRecorder capture(nullptr);
+			CreateSyntheticScene(capture);
+			RecordSyntheticFrame(capture, drawCount);
+			auto bytes = std::make_shared<std::vector<uint8_t>>(capture.Bytes());
+			suite.Add("submit/capture_replay_" + suffix, [bytes]() {
+				NullCommandRecorder recorder;
+				ReplayReport report;
+				ReplayCapture(*bytes, recorder, report);
+				return static_cast<uint64_t>(bytes->size());
+			});
+		}
+	}
+
+	// 11t[ƂāAAbv[hp̃O؂oBGPU  2 t[xďÎƂ Retire 
+	void AddUploadRing(BenchmarkSuite& suite)
+	{
+		// D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT
+		constexpr uint64_t kConstantAlignment = 256;
+		constexpr uint64_t kFramesInFlight = 2;
+		struct RingState
+		{
+			explicit RingState(uint64_t capacity) : ring(capacity) {}
+			UploadRing ring;
+			uint64_t fenceValue = 0;
+		};
+		const auto endFrame = [](RingState& state) {
+			++state.fenceValue;
+			state.ring.EndFrame(state.fenceValue);
+			if (state.fenceValue > kFramesInFlight) {
+				state.ring.Retire(state.fenceValue - kFramesInFlight);
+			}
+		};
+
+		// _eNX`̏ȍXV̂悤ɁA傫̂΂΂Ȃ 10k (1t[ 20MB ق)
+		auto sizes = std::make_shared<std::vector<uint32_t>>();
+		std::mt19937 random(5);
+		std::uniform_int_distribution<uint32_t> size(64, 4096);
+		for (int i = 0; i < 10000; ++i) {
+			sizes->push_back(size(random));
+		}
+		auto mixed = std::make_shared<RingState>(96ull << 20);
+		suite.AddItems("upload_ring/allocate_mixed_10k", [sizes, mixed, endFrame]() {
+			uint64_t allocated = 0;
+			for (const uint32_t allocationSize : *sizes) {
+				allocated += mixed->ring.Allocate(allocationSize, kConstantAlignment) != UploadRing::kInvalidOffset ? 1 : 0;
+			}
+			endFrame(*mixed);
+			return allocated;
+		});
+
+		// `悲Ƃ̒萔obt@[(256 oCg) 64k 
+		auto constants = std::make_shared<RingState>(64ull << 20);
+		suite.AddItems("upload_ring/allocate_constants_64k", [constants, endFrame]() {
+			uint64_t allocated = 0;
+			for (int i = 0; i < 65536; ++i) {
+				allocated += constants->ring.Allocate(kConstantAlignment, kConstantAlignment) != UploadRing::kInvalidOffset ? 1 : 0;
+			}
+			endFrame(*constants);
+			return allocated;
+		});
+	}
+
+	void AddDescriptorAllocation(BenchmarkSuite& suite)
+	{
+		// 1 10k A΂΂̏ɖ߂(߂тɗׂƂȂ)
+		constexpr uint32_t kSingleCount = 10000;
+		auto order = std::make_shared<std::vector<uint32_t>>(kSingleCount);
+		std::iota(order->begin(), order->end(), 0u);
+		std::mt19937 random(6);
+		std::shuffle(order->begin(), order->end(), random);
+		auto singles = std::make_shared<DescriptorAllocator>(16384);
+		auto indices = std::make_shared<std::vector<uint32_t>>(kSingleCount);
+		suite.AddItems("descriptor/allocate_free_single_10k", [order, singles, indices]() {
+			for (uint32_t i = 0; i < kSingleCount; ++i) {
+				(*indices)[i] = singles->Allocate();
+			}
+			for (const uint32_t i : *order) {
+				singles->Free((*indices)[i]);
+			}
+			return static_cast<uint64_t>(kSingleCount);
+		});
+
+		// 1`4 ̋󂫂Ǝgp1݂ɕ񂾃q[v(64k )A1`4 ͈̔͂ 1k Ė߂B
+		// 擪󂫂T̂ŁA󂫂̐Ԃ
+		constexpr uint32_t kHeapSize = 65536;
+		auto fragmented = std::make_shared<DescriptorAllocator>(kHeapSize);
+		fragmented->Allocate(kHeapSize);
+		std::uniform_int_distribution<uint32_t> holeSize(1, 4);
+		for (uint32_t first = 0; first < kHeapSize;) {
+			const uint32_t count = (std::min)(holeSize(random), kHeapSize - first);
+			fragmented->Free(first, count);
+			first += count + 1;
+		}
+		auto rangeCounts = std::make_shared<std::vector<uint32_t>>();
+		for (int i = 0; i < 1000; ++i) {
+			rangeCounts->push_back(holeSize(random));
+		}
+		auto ranges = std::make_shared<std::vector<uint32_t>>(rangeCounts->size());
+		suite.AddItems("descriptor/allocate_fragmented_ranges_1k", [fragmented, rangeCounts, ranges]() {
+			uint64_t allocated = 0;
+			for (size_t i = 0; i < rangeCounts->size(); ++i) {
+				(*ranges)[i] = fragmented->Allocate((*rangeCounts)[i]);
+				allocated += (*ranges)[i] != DescriptorAllocator::kInvalidIndex ? 1 : 0;
+			}
+			for (size_t i = 0; i < rangeCounts->size(); ++i) {
+				if ((*ranges)[i] != DescriptorAllocator::kInvalidIndex) {
+					fragmented->Free((*ranges)[i], (*rangeCounts)[i]);
+				}
+			}
+			return allocated;
+		});
+	}
+
+	long ForkJoinSum(JobSystem& jobSystem, int depth)
+	{
+		if (depth == 0) {
+			return 1;
+		}
+		long left = 0;
+		JobCounter counter;
+		jobSystem.Run([&]() { left = ForkJoinSum(jobSystem, depth - 1); }, &counter);
+		const long right = ForkJoinSum(jobSystem, depth - 1);
+		jobSystem.Wait(counter);
+		return left + right;
+	}
+
+	void AddJobSystem(BenchmarkSuite& suite, const std::shared_ptr<JobSystem>& jobSystem)
+	{
+		constexpr size_t kElementCount = 1 << 20;
+
+		auto values = std::make_shared<std::vector<float>>(kElementCount, 1.0f);
+		// 1M vf 4096 ɕď
+		suite.Add("jobs/parallel_for_1m", [jobSystem, values]() {
+			jobSystem->ParallelFor(values->size(), 4096, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) {
+					(*values)[i] = (*values)[i] * 0.5f + 1.0f;
+				}
+			});
+			return static_cast<uint64_t>(values->size() * sizeof(float));
+		});
+		// 2^12 ̗t܂2JԂAWu̒҂
+		suite.Add("jobs/nested_fork_join_4k", [jobSystem]() {
+			ForkJoinSum(*jobSystem, 12);
+			return static_cast<uint64_t>(0);
+		});
+		// ĝȂ 1024 ̃Wuςő҂(ςށEށE邾̃RXg)
+		suite.Add("jobs/empty_jobs_1k", [jobSystem]() {
+			JobCounter counter;
+			for (int i = 0; i < 1024; ++i) {
+				jobSystem->Run([]() {}, &counter);
+			}
+			jobSystem->Wait(counter);
+			return static_cast<uint64_t>(0);
+		});
+	}
+
+	// [J[̐ςē𑪂BWuVXê͖ŁAXbh̋NƏI܂
+	void AddJobScaling(BenchmarkSuite& suite)
+	{
+		constexpr size_t kElementCount = 1 << 22;
+		const unsigned int maxWorkerCount = (std::max)(std::thread::hardware_concurrency(), 2u);
+
+		auto values = std::make_shared<std::vector<float>>(kElementCount, 1.0f);
+		for (unsigned int workerCount = 1; workerCount <= maxWorkerCount; workerCount *= 2) {
+			JobSystem::Options options;
+			options.workerCount = workerCount;
+			const std::string suffix = "_workers_" + std::to_string(workerCount);
+
+			// vfƂɏdvZA₷
+			suite.Add("jobs/scaling_parallel_for_4m" + suffix, [options, values]() {
+				JobSystem jobSystem(options);
+				jobSystem.ParallelFor(values->size(), 16384, [&](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; ++i) {
+						const float value = (*values)[i];
+						(*values)[i] = std::sqrt(value * value + 1.0f) * 0.5f;
+					}
+				});
+				return static_cast<uint64_t>(values->size() * sizeof(float));
+			});
+			// 2^14 ̗t܂2JԂBׂWu𓐂ݍRXg
+			suite.Add("jobs/scaling_nested_fork_join_16k" + suffix, [options]() {
+				JobSystem jobSystem(options);
+				ForkJoinSum(jobSystem, 14);
+				return static_cast<uint64_t>(0);
+			});
+		}
+	}
+
+	// ʂ̃Xbh 64k ̒ln܂ŁBL[قǖtƋő҂񐔂
+	template <size_t Capacity>
+	void AddSpscHandoff(BenchmarkSuite& suite)
+	{
+		suite.Add("threads/spsc_handoff_64k_capacity_" + std::to_string(Capacity), []() {
+			constexpr uint64_t kValueCount = 1 << 16;
+			auto queue = std::make_shared<SpscQueue<uint64_t, Capacity>>();
+			uint64_t sum = 0;
+			std::thread consumer([&]() {
+				uint64_t value = 0;
+				for (uint64_t received = 0; received < kValueCount;) {
+					if (queue->TryPop(value)) {
+						sum += value;
+						++received;
+					} else {
+						std::this_thread::yield();
+					}
+				}
+			});
+			for (uint64_t i = 0; i < kValueCount;) {
+				if (queue->TryPush(i)) {
+					++i;
+				} else {
+					std::this_thread::yield();
+				}
+			}
+			consumer.join();
+			return static_cast<uint64_t>(sum == kValueCount * (kValueCount - 1) / 2 ? kValueCount * sizeof(uint64_t) : 0);
+		});
+	}
+
+	void AddThreadHandoff(BenchmarkSuite& suite)
+	{
+		AddSpscHandoff<16>(suite);
+		AddSpscHandoff<256>(suite);
+		AddSpscHandoff<4096>(suite);
+
+		// ĝȂ` 1000 t[̃pPbgn(pPbg̎󂯓ñRXg)
+		suite.Add("threads/frame_packet_handoff_1k", []() {
+			constexpr uint64_t kFrameCount = 1000;
+			RenderThread renderThread;
+			renderThread.Start([](const FramePacket&) { return true; }, [](const RenderCommand&) {});
+			for (uint64_t frame = 0; frame < kFrameCount;) {
+				FramePacket* packet = renderThread.BeginFramePacket();
+				if (packet == nullptr) {
+					std::this_thread::yield();
+					continue;
+				}
+				packet->frameIndex = frame++;
+				renderThread.SubmitFramePacket(packet);
+			}
+			while (renderThread.RenderedFrameCount() < kFrameCount) {
+				std::this_thread::yield();
+			}
+			renderThread.Stop();
+			return static_cast<uint64_t>(kFrameCount * sizeof(FramePacket));
+		});
+	}
+
+	// 1t[Ŋmۂ鏬ȗ̈̑傫(`pPbgoAzz肵 16`256 oCg)
+	std::shared_ptr<std::vector<uint32_t>> MakeFrameAllocationSizes()
+	{
+		constexpr size_t kAllocationCount = 10000;
+		auto sizes = std::make_shared<std::vector<uint32_t>>();
+		std::mt19937 random(3);
+		std::uniform_int_distribution<uint32_t> size(16, 256);
+		for (size_t i = 0; i < kAllocationCount; ++i) {
+			sizes->push_back(size(random));
+		}
+		return sizes;
+	}
+
+	void AddFrameAllocation(BenchmarkSuite& suite)
+	{
+		auto sizes = MakeFrameAllocationSizes();
+		auto pointers = std::make_shared<std::vector<void*>>(sizes->size());
+
+		// mۂĐ擪ɏ݁At[̏Iɂ܂Ƃ߂ĉ
+		suite.Add("memory/frame_arena_10k", [sizes]() {
+			static FrameArena arena;
+			uint64_t bytes = 0;
+			for (const uint32_t size : *sizes) {
+				static_cast<uint8_t*>(arena.Allocate(size, 16))[0] = 1;
+				bytes += size;
+			}
+			arena.Reset();
+			return bytes;
+		});
+		suite.Add("memory/malloc_10k", [sizes, pointers]() {
+			uint64_t bytes = 0;
+			for (size_t i = 0; i < sizes->size(); ++i) {
+				(*pointers)[i] = std::malloc((*sizes)[i]);
+				static_cast<uint8_t*>((*pointers)[i])[0] = 1;
+				bytes += (*sizes)[i];
+			}
+			for (void* pointer : *pointers) {
+				std::free(pointer);
+			}
+			return bytes;
+		});
+		suite.Add("memory/new_10k", [sizes, pointers]() {
+			uint64_t bytes = 0;
+			for (size_t i = 0; i < sizes->size(); ++i) {
+				uint8_t* pointer = new uint8_t[(*sizes)[i]];
+				pointer[0] = 1;
+				(*pointers)[i] = pointer;
+				bytes += (*sizes)[i];
+			}
+			for (void* pointer : *pointers) {
+				delete[] static_cast<uint8_t*>(pointer);
+			}
+			return bytes;
+		});
+
+		// `惊Xĝ悤ɁA傫̂킩Ȃz1t[ŐL΂Ă
+		suite.Add("memory/frame_vector_push_10k", []() {
+			static FrameArena arena;
+			{
+				FrameVector<uint64_t> values{ FrameAllocator<uint64_t>(arena) };
+				for (uint64_t i = 0; i < 10000; ++i) {
+					values.push_back(i);
+				}
+			}
+			arena.Reset();
+			return static_cast<uint64_t>(10000 * sizeof(uint64_t));
+		});
+		suite.Add("memory/std_vector_push_10k", []() {
+			std::vector<uint64_t> values;
+			for (uint64_t i = 0; i < 10000; ++i) {
+				values.push_back(i);
+			}
+			return static_cast<uint64_t>(values.size() * sizeof(uint64_t));
+		});
+	}
+
+	// 8 ̃Wuꂼ1t[(10k )mۂBA[i̓t[̏I Reset B
+	// [J[̐ςāAXbhƂ̃`NƃO[oȃq[v̐Lѕׂ
+	void AddFrameAllocationScaling(BenchmarkSuite& suite)
+	{
+		constexpr size_t kJobCount = 8;
+		auto sizes = MakeFrameAllocationSizes();
+		const uint64_t bytesPerJob = std::accumulate(sizes->begin(), sizes->end(), static_cast<uint64_t>(0));
+		const unsigned int maxWorkerCount = (std::max)(std::thread::hardware_concurrency(), 2u);
+
+		for (unsigned int workerCount = 1; workerCount <= maxWorkerCount; workerCount *= 2) {
+			JobSystem::Options options;
+			options.workerCount = workerCount;
+			auto jobSystem = std::make_shared<JobSystem>(options);
+			auto arena = std::make_shared<FrameArena>();
+			auto pointers = std::make_shared<std::vector<void*>>(kJobCount * sizes->size());
+			const std::string suffix = "_workers_" + std::to_string(workerCount);
+
+			suite.Add("memory/frame_arena_mt_80k" + suffix, [jobSystem, arena, sizes, bytesPerJob]() {
+				jobSystem->ParallelFor(kJobCount, 1, [&](size_t, size_t) {
+					for (const uint32_t size : *sizes) {
+						static_cast<uint8_t*>(arena->Allocate(size, 16))[0] = 1;
+					}
+				});
+				arena->Reset();
+				return bytesPerJob * kJobCount;
+			});
+			suite.Add("memory/malloc_mt_80k" + suffix, [jobSystem, sizes, pointers, bytesPerJob]() {
+				jobSystem->ParallelFor(kJobCount, 1, [&](size_t begin, size_t end) {
+					for (size_t job = begin; job < end; ++job) {
+						void** jobPointers = pointers->data() + job * sizes->size();
+						for (size_t i = 0; i < sizes->size(); ++i) {
+							jobPointers[i] = std::malloc((*sizes)[i]);
+							static_cast<uint8_t*>(jobPointers[i])[0] = 1;
+						}
+					}
+				});
+				// t[̏Iɂ܂Ƃ߂ĉ
+				jobSystem->ParallelFor(kJobCount, 1, [&](size_t begin, size_t end) {
+					for (size_t i = begin * sizes->size(); i < end * sizes->size(); ++i) {
+						std::free((*pointers)[i]);
+					}
+				});
+				return bytesPerJob * kJobCount;
+			});
+		}
+	}
+
+	// 32768 x 32768 ̉摜 128 x 128 ̃^CœǂޏꍇBtB[hobN 256 x 256 Z
+	constexpr uint32_t kStreamingImageSize = 32768;
+	constexpr uint32_t kStreamingTileSize = 128;
+	constexpr uint32_t kStreamingMipCount = 8;
+
+	// ΂߂Ɍʂ̂悤ɁA(centerX, centerY) ̋߂قǍׂ~bvvtB[hobN
+	void FillStreamingFeedback(const TileLayout& layout, uint32_t centerX, uint32_t centerY, std::vector<uint32_t>& feedback)
+	{
+		const uint32_t cellsX = layout.TilesX(0);
+		const uint32_t cellsY = layout.TilesY(0);
+		feedback.assign(static_cast<size_t>(cellsX) * cellsY, kNoTileFeedback);
+		for (uint32_t y = 0; y < cellsY; ++y) {
+			for (uint32_t x = 0; x < cellsX; ++x) {
+				const uint32_t dx = x > centerX ? x - centerX : centerX - x;
+				const uint32_t dy = y > centerY ? y - centerY : centerY - y;
+				const uint32_t distance = (std::max)(dx, dy);
+				// S 16 ZƂ1e~bvɂȂA96 ZO͌ĂȂ
+				if (distance < 96) {
+					feedback[static_cast<size_t>(y) * cellsX + x] = distance / 16;
+				}
+			}
+		}
+	}
+
+	void AddTileStreaming(BenchmarkSuite& suite)
+	{
+		const TileLayout layout(
+			kStreamingImageSize,
+			kStreamingImageSize,
+			kStreamingTileSize,
+			kStreamingTileSize,
+			kStreamingMipCount
+		);
+		auto feedback = std::make_shared<std::vector<uint32_t>>();
+		FillStreamingFeedback(layout, layout.TilesX(0) / 2, layout.TilesY(0) / 2, *feedback);
+
+		auto aggregator = std::make_shared<TileFeedbackAggregator>(layout);
+		auto requests = std::make_shared<std::vector<TileRequest>>();
+		suite.Add("streaming/feedback_aggregate_256x256", [aggregator, feedback, requests]() {
+			aggregator->Aggregate(feedback->data(), *requests);
+			return static_cast<uint64_t>(feedback->size() * sizeof(uint32_t));
+		});
+
+		// 4096 ނ̃^C 1024 Xbgŉ񂷁B256 񂲂ƂɎ̃t[ɂ
+		auto keys = std::make_shared<std::vector<TileKey>>();
+		std::mt19937 random(4);
+		std::uniform_int_distribution<uint32_t> coordinate(0, 63);
+		for (int i = 0; i < 65536; ++i) {
+			keys->push_back(MakeTileKey(0, coordinate(random), coordinate(random)));
+		}
+		suite.Add("streaming/tile_cache_lru_64k", [keys]() {
+			TileCache cache(1024);
+			uint64_t frame = 1;
+			for (size_t i = 0; i < keys->size(); ++i) {
+				if (i % 256 == 0) {
+					++frame;
+				}
+				const uint32_t slot = cache.Find((*keys)[i]);
+				if (slot != TileCache::kInvalidSlot) {
+					cache.Touch(slot, frame);
+				} else {
+					bool evicted = false;
+					TileKey evictedKey = 0;
+					cache.Allocate((*keys)[i], frame, evicted, evictedKey);
+				}
+			}
+			return static_cast<uint64_t>(keys->size() * sizeof(TileKey));
+		});
+
+		// Ăꏊ𖈃t[AǂoƊԐڎQƃe[u̍XV܂߂đ
+		TileStreamer::Settings settings;
+		settings.slotCount = 1024;
+		settings.maxUploadsPerFrame = 64;
+		auto streamer = std::make_shared<TileStreamer>(layout, settings);
+		auto frame = std::make_shared<uint64_t>(0);
+		auto panFeedback = std::make_shared<std::vector<uint32_t>>();
+		auto updates = std::make_shared<std::vector<TileUpdate>>();
+		suite.Add("streaming/streamer_update_pan", [layout, streamer, frame, panFeedback, updates]() {
+			const uint32_t step = static_cast<uint32_t>(++*frame % 128);
+			FillStreamingFeedback(layout, 64 + step, 128, *panFeedback);
+			streamer->Update(panFeedback->data(), *frame, *updates);
+			return static_cast<uint64_t>(panFeedback->size() * sizeof(uint32_t));
+		});
+	}
+
+	// GPU ̕ϊƓ˂킹 CPU ł̑BJPEG Ɠ BGR 3oCg 1024x1024 ϊ
+	void AddTextureConversion(BenchmarkSuite& suite)
+	{
+		constexpr uint32_t kConversionSize = 1024;
+		const TextureConversionConstants constants = MakeTextureConversionConstants(
+			kConversionSize,
+			kConversionSize,
+			kSourceBgr8,
+			kConvertLinearize | kConvertPremultiply
+		);
+		auto source = std::make_shared<std::vector<uint8_t>>(
+			SourceBufferSize(kConversionSize, kConversionSize, kSourceBgr8)
+		);
+		std::mt19937 random(5);
+		for (uint8_t& value : *source) {
+			value = static_cast<uint8_t>(random());
+		}
+		auto mips = std::make_shared<std::vector<ConvertedImage>>(1);
+		suite.Add("texture/convert_bgr8_reference_1024x1024", [source, constants, mips]() {
+			ConvertTextureReference(source->data(), constants, (*mips)[0]);
+			return static_cast<uint64_t>(constants.sourceRowPitch) * constants.height;
+		});
+		suite.Add("texture/generate_mips_reference_1024x1024", [mips]() {
+			GenerateMipsReference(*mips);
+			return static_cast<uint64_t>((*mips)[0].pixels.size() * sizeof(float));
+		});
+	}
+
+	// GPU ̃|XgvZXƓ˂킹 CPU ł̑Bu[̒ȋ͔傫œ
+	void AddPostProcess(BenchmarkSuite& suite)
+	{
+		constexpr uint32_t kWidth = 640;
+		constexpr uint32_t kHeight = 360;
+		auto hdr = std::make_shared<PostProcessImage>();
+		hdr->width = kWidth;
+		hdr->height = kHeight;
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> value(0.0f, 4.0f);
+		for (size_t i = 0; i < static_cast<size_t>(kWidth) * kHeight; ++i) {
+			hdr->pixels.push_back({ value(random), value(random), value(random), 1.0f });
+		}
+		const PostProcessSettings settings;
+		const PostProcessConstants constants = MakePostProcessConstants(kWidth, kHeight, settings, 0, 1.0f, 1.0f);
+		const PostProcessConstants bloomConstants =
+			MakePostProcessConstants(BloomTargetSize(kWidth), BloomTargetSize(kHeight), settings, 0, 1.0f, 1.0f);
+		auto bloom = std::make_shared<PostProcessImage>();
+		BloomExtractReference(*hdr, bloomConstants, *bloom);
+		auto output = std::make_shared<PostProcessImage>();
+		const uint64_t hdrBytes = static_cast<uint64_t>(hdr->pixels.size() * sizeof(Float4));
+
+		suite.Add("postprocess/bloom_extract_reference_640x360", [hdr, bloomConstants, output, hdrBytes]() {
+			BloomExtractReference(*hdr, bloomConstants, *output);
+			return hdrBytes;
+		});
+		suite.Add("postprocess/blur_reference_320x180", [bloom, bloomConstants, output]() {
+			BlurReference(*bloom, bloomConstants, *output);
+			return static_cast<uint64_t>(bloom->pixels.size() * sizeof(Float4));
+		});
+		suite.Add("postprocess/tonemap_reference_640x360", [hdr, bloom, constants, output, hdrBytes]() {
+			TonemapReference(*hdr, *bloom, constants, *output);
+			return hdrBytes;
+		});
+		suite.Add("postprocess/full_chain_reference_640x360", [hdr, settings, output, hdrBytes]() {
+			RunPostProcessReference(*hdr, settings, kWidth, kHeight, *output);
+			return hdrBytes;
+		});
+	}
+
+	// DirectXManager::Initialize ̃XebvȂɌ܂Ԃ̂ɒúB
+	// Ԃ͎茳̋N|[ĝ悻̔Bˑ֌W Initialize ƓɂĂ
+	enum StubbedStartupStep {
+		kStubMakeWindow,
+		kStubCreateFactory,
+		kStubSelectAdapter,
+		kStubInitDevice,
+		kStubInitCommandQueue,
+		kStubInitGpuTimer,
+		kStubInitSwapChain,
+		kStubInitRtv,
+		kStubCreateDepthBuffer,
+		kStubSetupPostProcess,
+		kStubSetupVertexBuffer,
+		kStubSetupShaders,
+		kStubSetupGraphicsPipeline,
+		kStubSetupTextureConverter,
+		kStubLoadTexture,
+		kStubMakeShaderResourceView,
+		kStubbedStartupStepCount
+	};
+	constexpr const char* kStubbedStartupStepNames[kStubbedStartupStepCount] = {
+		"MakeWindow", "CreateDXGIFactory2", "SelectAdapter", "InitDirect3DDevice",
+		"InitCommandAllocatorAndCommandQueue", "InitGpuTimer", "InitSwapChain", "InitRTV",
+		"CreateDepthBuffer", "SetupPostProcess", "SetupVertexBuffer", "SetupShaders",
+		"SetupGraphicsPipeline", "SetupTextureConverter", "LoadTexture", "MakeShaderResourceView",
+	};
+	constexpr int kStubbedStartupStepMicroseconds[kStubbedStartupStepCount] = {
+		3000, 1000, 1000, 8000, 500, 200, 3000, 200, 300, 500, 300, 12000, 2000, 200, 10000, 100,
+	};
+
+	void RunStubbedStartupStep(StubbedStartupStep step)
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(kStubbedStartupStepMicroseconds[step]));
+	}
+
+	void AddStubbedStartupSteps(StartupTaskGraph& startup)
+	{
+		const auto add = [&](StubbedStartupStep step, std::initializer_list<StartupTaskGraph::TaskId> dependencies, bool mainThreadOnly) {
+			return startup.Add(kStubbedStartupStepNames[step], [step]() {
+				RunStubbedStartupStep(step);
+				return true;
+			}, dependencies, mainThreadOnly);
+		};
+		const auto window = add(kStubMakeWindow, {}, true);
+		const auto factory = add(kStubCreateFactory, {}, false);
+		const auto adapter = add(kStubSelectAdapter, { factory }, false);
+		const auto device = add(kStubInitDevice, { adapter }, false);
+		const auto commandQueue = add(kStubInitCommandQueue, { device }, false);
+		add(kStubInitGpuTimer, { commandQueue }, false);
+		const auto swapChain = add(kStubInitSwapChain, { window, commandQueue }, true);
+		const auto rtv = add(kStubInitRtv, { swapChain }, false);
+		add(kStubCreateDepthBuffer, { rtv }, false);
+		add(kStubSetupPostProcess, { swapChain }, false);
+		add(kStubSetupVertexBuffer, { device }, false);
+		const auto shaders = add(kStubSetupShaders, {}, false);
+		add(kStubSetupGraphicsPipeline, { device, shaders }, false);
+		const auto textureConverter = add(kStubSetupTextureConverter, { device }, false);
+		const auto texture = add(kStubLoadTexture, { commandQueue, textureConverter }, false);
+		add(kStubMakeShaderResourceView, { texture }, false);
+	}
+
+	// ÑXebvɎsꍇƁA^XNOtŕɎsꍇ̕ǎvԁB
+	// Xebv͖邾Ȃ̂ŁARAȂĂd˂(ۂ̃VF[_[̃RpCfR[h̓RA荇)B
+	// WuVXê͖ŁAXbh̋NƏI܂
+	void AddStartup(BenchmarkSuite& suite)
+	{
+		suite.Add("startup/stubbed_serial", []() {
+			for (int step = 0; step < kStubbedStartupStepCount; ++step) {
+				RunStubbedStartupStep(static_cast<StubbedStartupStep>(step));
+			}
+			return static_cast<uint64_t>(0);
+		});
+		for (unsigned int workerCount = 1; workerCount <= 4; workerCount *= 2) {
+			JobSystem::Options options;
+			options.workerCount = workerCount;
+			suite.Add("startup/stubbed_task_graph_workers_" + std::to_string(workerCount), [options]() {
+				JobSystem jobSystem(options);
+				StartupTaskGraph startup;
+				AddStubbedStartupSteps(startup);
+				startup.Run(jobSystem);
+				return static_cast<uint64_t>(0);
+			});
+		}
+	}
+
+	// `Pʂ̕בւB񓯂тɖ߂Ăׂ̂ŁA߂Rs[ԂɊ܂
+	void AddDrawSorting(BenchmarkSuite& suite, const std::shared_ptr<JobSystem>& jobSystem)
+	{
+		constexpr size_t kTransparentCount = 1 << 16;
+		constexpr size_t kLargeCount = 1 << 20;
+
+		// : ΂΂̐[xO
+		std::mt19937 random(6);
+		std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+		auto transparentSource = std::make_shared<std::vector<DrawSortKey>>(kTransparentCount);
+		for (size_t i = 0; i < kTransparentCount; ++i) {
+			(*transparentSource)[i] = MakeDrawSortKey(BackToFrontOrder(depth(random)), static_cast<uint32_t>(i));
+		}
+		auto transparentKeys = std::make_shared<std::vector<DrawSortKey>>(kTransparentCount);
+		auto transparentScratch = std::make_shared<std::vector<DrawSortKey>>(kTransparentCount);
+		suite.Add("draw_sort/back_to_front_radix_64k", [transparentSource, transparentKeys, transparentScratch]() {
+			*transparentKeys = *transparentSource;
+			RadixSortDrawKeys(transparentKeys->data(), transparentScratch->data(), transparentKeys->size());
+			return static_cast<uint64_t>(transparentKeys->size() * sizeof(DrawSortKey));
+		});
+
+		// s: pCvC 4  x eNX` 64 B2͓lȂ̂Ŕ΂
+		auto opaqueSource = std::make_shared<std::vector<DrawSortKey>>(kTransparentCount);
+		for (size_t i = 0; i < kTransparentCount; ++i) {
+			(*opaqueSource)[i] = MakeDrawSortKey(OpaqueStateOrder(random() % 4, random() % 64), static_cast<uint32_t>(i));
+		}
+		suite.Add("draw_sort/opaque_state_radix_64k", [opaqueSource, transparentKeys, transparentScratch]() {
+			*transparentKeys = *opaqueSource;
+			RadixSortDrawKeys(transparentKeys->data(), transparentScratch->data(), transparentKeys->size());
+			return static_cast<uint64_t>(transparentKeys->size() * sizeof(DrawSortKey));
+		});
+
+		// s: Ԃł܂Ƃ߁A̒OBL[l߂ƂƕׂƂ𕪂đ
+		struct OpaqueDraw
+		{
+			uint32_t pipeline;
+			uint32_t texture;
+			float depth;
+		};
+		auto opaqueDraws = std::make_shared<std::vector<OpaqueDraw>>(kTransparentCount);
+		for (OpaqueDraw& draw : *opaqueDraws) {
+			draw = { static_cast<uint32_t>(random() % 4), static_cast<uint32_t>(random() % 64), depth(random) };
+		}
+		auto frontToBackSource = std::make_shared<std::vector<DrawSortKey>>(kTransparentCount);
+		const auto packFrontToBackKeys = [opaqueDraws, frontToBackSource]() {
+			for (size_t i = 0; i < opaqueDraws->size(); ++i) {
+				const OpaqueDraw& draw = (*opaqueDraws)[i];
+				(*frontToBackSource)[i] =
+					MakeDrawSortKey(OpaqueDrawOrder(draw.pipeline, draw.texture, draw.depth), static_cast<uint32_t>(i));
+			}
+			return static_cast<uint64_t>(opaqueDraws->size() * sizeof(OpaqueDraw));
+		};
+		// ׂق𑪂Ƃ̂߂ɐɋl߂Ă
+		packFrontToBackKeys();
+		suite.Add("draw_sort/pack_front_to_back_keys_64k", packFrontToBackKeys);
+		suite.Add("draw_sort/front_to_back_radix_64k", [frontToBackSource, transparentKeys, transparentScratch]() {
+			*transparentKeys = *frontToBackSource;
+			RadixSortDrawKeys(transparentKeys->data(), transparentScratch->data(), transparentKeys->size());
+			return static_cast<uint64_t>(transparentKeys->size() * sizeof(DrawSortKey));
+		});
+
+		// 1M 1Xbh̊\[gAWuVXeŕ̊\[gAstd::sort Ŕׂ
+		auto largeSource = std::make_shared<std::vector<DrawSortKey>>(kLargeCount);
+		for (size_t i = 0; i < kLargeCount; ++i) {
+			(*largeSource)[i] = MakeDrawSortKey(BackToFrontOrder(depth(random)), static_cast<uint32_t>(i));
+		}
+		auto largeKeys = std::make_shared<std::vector<DrawSortKey>>(kLargeCount);
+		auto largeScratch = std::make_shared<std::vector<DrawSortKey>>(kLargeCount);
+		suite.Add("draw_sort/radix_1m", [largeSource, largeKeys, largeScratch]() {
+			*largeKeys = *largeSource;
+			RadixSortDrawKeys(largeKeys->data(), largeScratch->data(), largeKeys->size());
+			return static_cast<uint64_t>(largeKeys->size() * sizeof(DrawSortKey));
+		});
+		suite.Add("draw_sort/parallel_radix_1m", [largeSource, largeKeys, largeScratch, jobSystem]() {
+			*largeKeys = *largeSource;
+			ParallelRadixSortDrawKeys(largeKeys->data(), largeScratch->data(), largeKeys->size(), *jobSystem);
+			return static_cast<uint64_t>(largeKeys->size() * sizeof(DrawSortKey));
+		});
+		// rpB 32bit ͌̕т̔ԍȂ̂ŁAL[ŜŕׂΈɕׂ̂ƓɂȂ
+		suite.Add("draw_sort/std_sort_1m", [largeSource, largeKeys]() {
+			*largeKeys = *largeSource;
+			std::sort(largeKeys->begin(), largeKeys->end());
+			return static_cast<uint64_t>(largeKeys->size() * sizeof(DrawSortKey));
+		});
+	}
+
+	// ÕfR[_[BjobSystem  nullptr Ȃ1XbhŁAr̊ɂȂB
+	// ԂoCg̓fR[hf̑傫Ȃ̂ŁAMB/s ͏o͂̑Al1̎
+	void AddImageCodec(BenchmarkSuite& suite, const std::string& name, const std::string& path, std::shared_ptr<JobSystem> jobSystem)
+	{
+		auto data = std::make_shared<std::vector<uint8_t>>();
+		ImageInfo info;
+		if (path.empty() || !ReadFileBytes(path, *data) || !ReadImageInfo(data->data(), data->size(), info)) {
+			return;
+		}
+		auto image = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(info.width) * info.height * kBytesPerPixel);
+		const size_t rowPitch = static_cast<size_t>(info.width) * kBytesPerPixel;
+		suite.Add(name, [data, image, rowPitch, jobSystem]() {
+			if (!DecodeImage(data->data(), data->size(), image->data(), rowPitch, image->size(), jobSystem.get())) {
+				return static_cast<uint64_t>(0);
+			}
+			return static_cast<uint64_t>(image->size());
+		});
+	}
+
+#ifdef _WIN32
+	void AddImageDecode(BenchmarkSuite& suite, const std::string& imagePath)
+	{
+		auto decoder = std::make_shared<ImageDecoder>();
+		if (imagePath.empty() || !decoder->Initialize()) {
+			return;
+		}
+		// R}hC̕ ANSI R[hy[W
+		std::wstring path(MultiByteToWideChar(CP_ACP, 0, imagePath.c_str(), -1, nullptr, 0), L'\0');
+		MultiByteToWideChar(CP_ACP, 0, imagePath.c_str(), -1, &path[0], static_cast<int>(path.size()));
+		path.pop_back();
+		suite.Add("texture/decode_image", [decoder, path]() {
+			DecodedImage image;
+			if (!decoder->Decode(path.c_str(), kFootprintPitchAlignment, image)) {
+				return static_cast<uint64_t>(0);
+			}
+			return static_cast<uint64_t>(image.pixels.size());
+		});
+	}
+#endif // _WIN32
+}
+
+void AddHotPathBenchmarks(BenchmarkSuite& suite, const std::string& imagePath, const std::string& pngPath)
+{
+	// XbhCXbhɂȂ̂ŁAWuVXe1Ďg
+	auto jobSystem = std::make_shared<JobSystem>();
+#ifdef _WIN32
+	AddImageDecode(suite, imagePath);
+#endif // _WIN32
+	AddImageCodec(suite, "image_codec/jpeg_single_thread", imagePath, nullptr);
+	AddImageCodec(suite, "image_codec/jpeg_job_system", imagePath, jobSystem);
+	AddImageCodec(suite, "image_codec/png", pngPath, nullptr);
+	AddCopyRows(suite, "texture/copy_rows_repack_1000x1000", 1000, 1000);
+	AddCopyRows(suite, "texture/copy_rows_aligned_1024x1024", 1024, 1024);
+	AddTextureAtlas(suite);
+	AddCulling(suite);
+	AddCommandRecording(suite);
+	AddUploadRing(suite);
+	AddDescriptorAllocation(suite);
+	AddJobSystem(suite, jobSystem);
+	AddJobScaling(suite);
+	AddThreadHandoff(suite);
+	AddFrameAllocation(suite);
+	AddFrameAllocationScaling(suite);
+	AddTileStreaming(suite);
+	AddTextureConversion(suite);
+	AddPostProcess(suite);
+	AddDrawSorting(suite, jobSystem);
+	AddStartup(suite);
+}
+}
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <string>
+
+#include "Benchmark.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// eNX`ǂݍ݁EAbv[hE`L^̃zbgpX suite ɓo^B
+// O "<>/<e>" ŁABenchmarkSuite::Run  filter ɕނn΂ꂾB
+// imagePath(JPEG) pngPath ͉摜fR[h̃P[XɎg
+void AddHotPathBenchmarks(BenchmarkSuite& suite, const std::string& imagePath, const std::string& pngPath);
+}
+}
@@ -0,0 +1,202 @@
+#include "HotReload.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace yuxx {
+namespace DirectX12 {
+bool DiskFileSource::GetLastWriteTime(const PathString& path, FileTimestamp& timestamp) const
+{
+	return GetFileLastWriteTime(path, timestamp);
+}
+
+bool DiskFileSource::ReadText(const PathString& path, std::string& text) const
+{
+	std::ifstream stream(path);
+	if (!stream) {
+		return false;
+	}
+	std::ostringstream contents;
+	contents << stream.rdbuf();
+	text = contents.str();
+	return true;
+}
+
+void DependencyTracker::RegisterAsset(AssetId id, const PathString& rootPath, bool followIncludes, const FileSource& files)
+{
+	UntrackAsset(id);
+	m_assets[id] = { rootPath, followIncludes };
+	TrackFile(id, rootPath, followIncludes, files);
+}
+
+std::set<DependencyTracker::AssetId> DependencyTracker::CollectChanges(const FileSource& files, bool allFiles)
+{
+	std::set<AssetId> changedAssets;
+	const auto checkFile = [&](const PathString& path, WatchedFile& file) {
+		FileTimestamp lastWriteTime = 0;
+		if (!files.GetLastWriteTime(path, lastWriteTime)) {
+			// ۑrňꎞIɏĂ邱ƂBʒm͂󂯎Ă܂̂ŁA͒ʒmȂĂג
+			// (ƂƂȂt@ĆAłƂɒʒm)
+			if (file.lastWriteTime != 0) {
+				m_pendingFiles.insert(path);
+			}
+			return;
+		}
+		m_pendingFiles.erase(path);
+		if (lastWriteTime != file.lastWriteTime) {
+			changedAssets.insert(file.dependents.begin(), file.dependents.end());
+		}
+	};
+
+	if (allFiles) {
+		for (auto& file : m_files) {
+			checkFile(file.first, file.second);
+		}
+	} else {
+		const std::set<PathString> pendingFiles = m_pendingFiles;
+		for (const PathString& path : pendingFiles) {
+			const auto file = m_files.find(path);
+			if (file == m_files.end()) {
+				m_pendingFiles.erase(path);
+				continue;
+			}
+			checkFile(file->first, file->second);
+		}
+	}
+
+	// #include Ă邩Ȃ̂ňˑ֌W蒼(ŐVȂ)
+	for (const AssetId id : changedAssets) {
+		UntrackAsset(id);
+		const Asset& asset = m_assets[id];
+		TrackFile(id, asset.rootPath, asset.followIncludes, files);
+	}
+	return changedAssets;
+}
+
+std::set<DependencyTracker::AssetId> DependencyTracker::Dependents(const PathString& path) const
+{
+	const auto file = m_files.find(path);
+	return file == m_files.end() ? std::set<AssetId>() : file->second.dependents;
+}
+
+void DependencyTracker::TrackFile(AssetId id, const PathString& path, bool followIncludes, const FileSource& files)
+{
+	auto& file = m_files[path];
+	if (!file.dependents.insert(id).second) {
+		// z include ΍
+		return;
+	}
+	// ܂Ȃt@C(ꂩ #include Ȃ)͎ 0 ̂܂܂ɂāAłƂɕύXƂďE
+	if (!files.GetLastWriteTime(path, file.lastWriteTime)) {
+		file.lastWriteTime = 0;
+	}
+
+	if (!followIncludes) {
+		return;
+	}
+	for (const auto& include : ParseIncludes(path, files)) {
+		TrackFile(id, include, followIncludes, files);
+	}
+}
+
+void DependencyTracker::UntrackAsset(AssetId id)
+{
+	for (auto it = m_files.begin(); it != m_files.end();) {
+		it->second.dependents.erase(id);
+		if (it->second.dependents.empty()) {
+			m_pendingFiles.erase(it->first);
+			it = m_files.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+std::vector<PathString> DependencyTracker::ParseIncludes(const PathString& path, const FileSource& files)
+{
+	std::vector<PathString> includes;
+	std::string text;
+	if (!files.ReadText(path, text)) {
+		return includes;
+	}
+
+	// #include "..." ͎荞ޑ̃t@C̑΃pX
+	const std::string separators = "/\\";
+	const size_t separator = path.find_last_of(PathString(separators.begin(), separators.end()));
+	const PathString directory = separator == PathString::npos ? PathString() : path.substr(0, separator + 1);
+
+	const std::string directive = "#include";
+	std::istringstream stream(text);
+	std::string line;
+	while (std::getline(stream, line)) {
+		const size_t directivePosition = line.find(directive);
+		if (directivePosition == std::string::npos) {
+			continue;
+		}
+		const size_t open = line.find('"', directivePosition + directive.size());
+		const size_t close = open == std::string::npos ? std::string::npos : line.find('"', open + 1);
+		if (close == std::string::npos) {
+			continue;
+		}
+		// t@C ASCII ݂̂z
+		const std::string name = line.substr(open + 1, close - open - 1);
+		includes.push_back(directory + PathString(name.begin(), name.end()));
+	}
+	return includes;
+}
+
+ReloadScheduler::ReloadScheduler(Clock::duration settleTime) : m_settleTime(settleTime)
+{
+}
+
+void ReloadScheduler::OnChanged(const std::set<AssetId>& assets, Clock::time_point now)
+{
+	for (const AssetId id : assets) {
+		m_pending[id] = now;
+	}
+}
+
+std::set<ReloadScheduler::AssetId> ReloadScheduler::Update(Clock::time_point now)
+{
+	std::set<AssetId> readyAssets;
+	for (auto it = m_pending.begin(); it != m_pending.end();) {
+		if (now - it->second >= m_settleTime) {
+			readyAssets.insert(it->first);
+			it = m_pending.erase(it);
+		} else {
+			++it;
+		}
+	}
+	return readyAssets;
+}
+
+HotReloader::HotReloader() : m_watcher(CreateFileWatcher()), m_files(&m_diskFiles)
+{
+}
+
+HotReloader::HotReloader(std::unique_ptr<FileWatcher> watcher, const FileSource& files, Clock::duration settleTime)
+	: m_watcher(std::move(watcher)), m_files(&files), m_scheduler(settleTime)
+{
+}
+
+bool HotReloader::AddWatchDirectory(const PathString& directory)
+{
+	return m_watcher && m_watcher->AddWatchDirectory(directory);
+}
+
+void HotReloader::RegisterAsset(AssetId id, const PathString& rootPath, bool followIncludes)
+{
+	m_tracker.RegisterAsset(id, rootPath, followIncludes, *m_files);
+}
+
+std::set<HotReloader::AssetId> HotReloader::Poll(Clock::time_point now)
+{
+	// ʒmĂȂ΁AOm߂Ȃt@C𒲂ׂ(҂Ȃ)
+	const bool notified = m_watcher && m_watcher->ConsumeNotifications();
+	if (notified || m_tracker.HasPendingFiles()) {
+		m_scheduler.OnChanged(m_tracker.CollectChanges(*m_files, notified), now);
+	}
+	return m_scheduler.Update(now);
+}
+}
+}
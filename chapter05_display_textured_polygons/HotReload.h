@@ -0,0 +1,121 @@
+#pragma once
+#include <chrono>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "FileWatcher.h"
+
+namespace yuxx {
+namespace DirectX12 {
+using HotReloadAssetId = int;
+
+// Ďt@C̓ǂݕBeXgł̓̃t@Cɍւ
+class FileSource
+{
+public:
+	virtual ~FileSource() = default;
+
+	// t@CȂ false
+	virtual bool GetLastWriteTime(const PathString& path, FileTimestamp& timestamp) const = 0;
+	virtual bool ReadText(const PathString& path, std::string& text) const = 0;
+};
+
+// fBXÑt@C
+class DiskFileSource : public FileSource
+{
+public:
+	bool GetLastWriteTime(const PathString& path, FileTimestamp& timestamp) const override;
+	bool ReadText(const PathString& path, std::string& text) const override;
+};
+
+// AZbgˑt@C(VF[_[Ȃ #include "..." ǂ)ƁA̍ŏIXVoĂ
+class DependencyTracker
+{
+public:
+	using AssetId = HotReloadAssetId;
+
+	// rootPath( followIncludes Ȃ #include )ς id Ԃ悤ɂ
+	void RegisterAsset(AssetId id, const PathString& rootPath, bool followIncludes, const FileSource& files);
+	// ςt@CɈˑAZbgԂÄˑ֌W蒼(#include Ă邩Ȃ)B
+	// allFiles  false ȂAO񎞍Ȃt@C𒲂ג
+	std::set<AssetId> CollectChanges(const FileSource& files, bool allFiles);
+
+	// ۑ̓rňꎞIɏĂȂǂŁAꂸɕύXm߂ĂȂt@C
+	bool HasPendingFiles() const { return !m_pendingFiles.empty(); }
+	// path ɈˑĂAZbg
+	std::set<AssetId> Dependents(const PathString& path) const;
+
+private:
+	struct WatchedFile
+	{
+		FileTimestamp lastWriteTime = 0;
+		std::set<AssetId> dependents;
+	};
+	struct Asset
+	{
+		PathString rootPath;
+		bool followIncludes;
+	};
+
+	std::map<PathString, WatchedFile> m_files;
+	std::map<AssetId, Asset> m_assets;
+	std::set<PathString> m_pendingFiles;
+
+	void TrackFile(AssetId id, const PathString& path, bool followIncludes, const FileSource& files);
+	void UntrackAsset(AssetId id);
+	static std::vector<PathString> ParseIncludes(const PathString& path, const FileSource& files);
+};
+
+// ύX̒ʒm܂Ƃ߂BGfB^[1̕ۑŉx(ꎞt@Cւ݂̏ƒuȂ)̂ŁA
+// AZbgƂɍŌ̕ύX settleTime Ă蒼
+class ReloadScheduler
+{
+public:
+	using AssetId = HotReloadAssetId;
+	using Clock = std::chrono::steady_clock;
+
+	explicit ReloadScheduler(Clock::duration settleTime = std::chrono::milliseconds(100));
+
+	void OnChanged(const std::set<AssetId>& assets, Clock::time_point now);
+	// 蒼Ă悢AZbgԂA҂O
+	std::set<AssetId> Update(Clock::time_point now);
+
+	bool HasPendingAssets() const { return !m_pending.empty(); }
+
+private:
+	Clock::duration m_settleTime;
+	// ŌɕύX󂯎
+	std::map<AssetId, Clock::time_point> m_pending;
+};
+
+// t@C̕ύXĎāA蒼KvȃAZbg
+class HotReloader
+{
+public:
+	using AssetId = HotReloadAssetId;
+	using Clock = ReloadScheduler::Clock;
+
+	// OS ̒ʒm(CreateFileWatcher)ƃfBXÑt@Cg
+	HotReloader();
+	// files  HotReloader 蒷Ă邱
+	HotReloader(std::unique_ptr<FileWatcher> watcher, const FileSource& files, Clock::duration settleTime);
+	HotReloader(const HotReloader&) = delete;
+	HotReloader& operator=(const HotReloader&) = delete;
+
+	bool AddWatchDirectory(const PathString& directory);
+	void RegisterAsset(AssetId id, const PathString& rootPath, bool followIncludes);
+	// ύXāÂ settleTime ̊ԗĂAZbgԂBGPU gĂȂt[EŌĂԂ
+	std::set<AssetId> Poll(Clock::time_point now);
+
+private:
+	DiskFileSource m_diskFiles;
+	std::unique_ptr<FileWatcher> m_watcher;
+	const FileSource* m_files;
+	DependencyTracker m_tracker;
+	ReloadScheduler m_scheduler;
+};
+}
+}
@@ -0,0 +1,296 @@
+#include "ImageCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "Helpers.h"
+#include "JpegDecoder.h"
+#include "PngDecoder.h"
+
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	constexpr size_t kBytesPerPixel = 4;
+
+	ImageFileType DetectFileType(const uint8_t* data, size_t size)
+	{
+		static const uint8_t kPngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		if (size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
+			return ImageFileType::Jpeg;
+		}
+		if (size >= 8 && std::memcmp(data, kPngSignature, 8) == 0) {
+			return ImageFileType::Png;
+		}
+		return ImageFileType::Unknown;
+	}
+
+	uint32_t ReadBigEndian32(const uint8_t* data)
+	{
+		return (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+	}
+
+	// IDAT O sRGB `NA2.2 ̃K}(gAMA ̒l 45455)邩
+	bool IsSrgbPng(const uint8_t* data, size_t size)
+	{
+		constexpr uint32_t kSrgbGamma = 45455;
+		for (size_t offset = 8; offset + 12 <= size;) {
+			const uint32_t length = ReadBigEndian32(data + offset);
+			const uint8_t* type = data + offset + 4;
+			if (length > size - offset - 12 || std::memcmp(type, "IDAT", 4) == 0) {
+				return false;
+			}
+			if (std::memcmp(type, "sRGB", 4) == 0) {
+				return true;
+			}
+			if (std::memcmp(type, "gAMA", 4) == 0 && length >= 4) {
+				return ReadBigEndian32(data + offset + 8) == kSrgbGamma;
+			}
+			offset += 12 + length;
+		}
+		return false;
+	}
+
+	// EXIF(TIFF `)̒lBoCg̓wb_[ II / MM Ō܂
+	class ExifReader
+	{
+	public:
+		ExifReader(const uint8_t* data, size_t size) : m_data(data), m_size(size)
+		{
+			m_littleEndian = size >= 2 && data[0] == 'I' && data[1] == 'I';
+		}
+
+		bool Read16(size_t offset, uint32_t& value) const
+		{
+			if (offset + 2 > m_size) {
+				return false;
+			}
+			value = m_littleEndian ? m_data[offset] | (m_data[offset + 1] << 8) : (m_data[offset] << 8) | m_data[offset + 1];
+			return true;
+		}
+
+		bool Read32(size_t offset, uint32_t& value) const
+		{
+			uint32_t low = 0;
+			uint32_t high = 0;
+			if (!Read16(offset, m_littleEndian ? low : high) || !Read16(offset + 2, m_littleEndian ? high : low)) {
+				return false;
+			}
+			value = (high << 16) | low;
+			return true;
+		}
+
+		// IFD  tag ̒l(SHORT  LONG)T
+		bool FindTag(uint32_t ifdOffset, uint32_t tag, uint32_t& value) const
+		{
+			uint32_t entryCount = 0;
+			if (!Read16(ifdOffset, entryCount)) {
+				return false;
+			}
+			for (uint32_t i = 0; i < entryCount; ++i) {
+				const size_t entry = ifdOffset + 2 + static_cast<size_t>(i) * 12;
+				uint32_t entryTag = 0;
+				uint32_t type = 0;
+				if (!Read16(entry, entryTag) || !Read16(entry + 2, type)) {
+					return false;
+				}
+				if (entryTag != tag) {
+					continue;
+				}
+				constexpr uint32_t kTypeShort = 3;
+				return type == kTypeShort ? Read16(entry + 8, value) : Read32(entry + 8, value);
+			}
+			return false;
+		}
+
+	private:
+		const uint8_t* m_data;
+		size_t m_size;
+		bool m_littleEndian;
+	};
+
+	// APP1  EXIF ŁAExif IFD  ColorSpace(0xA001) 1(sRGB)
+	bool IsSrgbJpeg(const uint8_t* data, size_t size)
+	{
+		constexpr uint32_t kExifIfdTag = 0x8769;
+		constexpr uint32_t kColorSpaceTag = 0xA001;
+		constexpr uint8_t kExifHeader[6] = { 'E', 'x', 'i', 'f', 0, 0 };
+		// SOI ̌̃}[J[Aŏ̃XL̑O܂ŏɌ
+		for (size_t offset = 2; offset + 4 <= size;) {
+			if (data[offset] != 0xFF) {
+				return false;
+			}
+			const uint8_t marker = data[offset + 1];
+			const size_t length = (data[offset + 2] << 8) | data[offset + 3];
+			if (marker == 0xDA || length < 2 || offset + 2 + length > size) {
+				return false;
+			}
+			const uint8_t* segment = data + offset + 4;
+			const size_t segmentSize = length - 2;
+			if (marker == 0xE1 && segmentSize > sizeof(kExifHeader) && std::memcmp(segment, kExifHeader, sizeof(kExifHeader)) == 0) {
+				const ExifReader exif(segment + sizeof(kExifHeader), segmentSize - sizeof(kExifHeader));
+				uint32_t ifd0 = 0;
+				uint32_t exifIfd = 0;
+				uint32_t colorSpace = 0;
+				return exif.Read32(4, ifd0) &&
+					exif.FindTag(ifd0, kExifIfdTag, exifIfd) &&
+					exif.FindTag(exifIfd, kColorSpaceTag, colorSpace) &&
+					colorSpace == 1;
+			}
+			offset += 2 + length;
+		}
+		return false;
+	}
+
+	// k1(܂1s)ɏdȂ錳͈̔͂ƁȀd
+	struct AreaWeights
+	{
+		std::vector<uint32_t> first;
+		std::vector<uint32_t> count;
+		std::vector<float> weights;
+		std::vector<size_t> offsets;
+	};
+
+	void ComputeAreaWeights(uint32_t sourceSize, uint32_t size, AreaWeights& area)
+	{
+		const double scale = static_cast<double>(sourceSize) / size;
+		area.first.resize(size);
+		area.count.resize(size);
+		area.offsets.resize(size);
+		area.weights.clear();
+		for (uint32_t i = 0; i < size; ++i) {
+			const double begin = i * scale;
+			const double end = (i + 1) * scale;
+			const uint32_t first = static_cast<uint32_t>(begin);
+			const uint32_t last = (std::min)(static_cast<uint32_t>(std::ceil(end)), sourceSize);
+			area.first[i] = first;
+			area.count[i] = last - first;
+			area.offsets[i] = area.weights.size();
+			for (uint32_t s = first; s < last; ++s) {
+				const double overlap = (std::min)(end, s + 1.0) - (std::max)(begin, static_cast<double>(s));
+				area.weights.push_back(static_cast<float>(overlap / scale));
+			}
+		}
+	}
+}
+
+bool ReadImageInfo(const uint8_t* data, size_t size, ImageInfo& info)
+{
+	info.type = DetectFileType(data, size);
+	info.bitDepth = 8;
+	info.srgb = HasSrgbColorSpace(data, size);
+	switch (info.type) {
+	case ImageFileType::Jpeg:
+		return ReadJpegInfo(data, size, info.width, info.height);
+	case ImageFileType::Png:
+		return ReadPngInfo(data, size, info.width, info.height, info.bitDepth);
+	default:
+		return false;
+	}
+}
+
+bool HasSrgbColorSpace(const uint8_t* data, size_t size)
+{
+	switch (DetectFileType(data, size)) {
+	case ImageFileType::Jpeg:
+		return IsSrgbJpeg(data, size);
+	case ImageFileType::Png:
+		return IsSrgbPng(data, size);
+	default:
+		return false;
+	}
+}
+
+bool DecodeImage(
+	const uint8_t* data,
+	size_t size,
+	uint8_t* destination,
+	size_t rowPitch,
+	size_t destinationSize,
+	JobSystem* jobSystem
+)
+{
+	switch (DetectFileType(data, size)) {
+	case ImageFileType::Jpeg:
+		return DecodeJpeg(data, size, destination, rowPitch, destinationSize, jobSystem);
+	case ImageFileType::Png:
+		return DecodePng(data, size, destination, rowPitch, destinationSize);
+	default:
+		DebugOutputFormatString("DecodeImage : unknown file type.\n");
+		return false;
+	}
+}
+
+bool DecodeImage(const uint8_t* data, size_t size, size_t pitchAlignment, DecodedImage& image, JobSystem* jobSystem)
+{
+	ImageInfo info;
+	if (!ReadImageInfo(data, size, info)) {
+		return false;
+	}
+	const size_t tightPitch = static_cast<size_t>(info.width) * kBytesPerPixel;
+	image.width = info.width;
+	image.height = info.height;
+	image.rowPitch = (tightPitch + pitchAlignment - 1) / pitchAlignment * pitchAlignment;
+	image.pixels.resize(image.rowPitch * image.height);
+	return DecodeImage(data, size, image.pixels.data(), image.rowPitch, image.pixels.size(), jobSystem);
+}
+
+bool ReadFileBytes(const std::string& path, std::vector<uint8_t>& data)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file) {
+		DebugOutputFormatString("ReadFileBytes : cannot open %s\n", path.c_str());
+		return false;
+	}
+	data.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), data.size()));
+}
+
+void ScaleRgba8(const DecodedImage& source, uint32_t width, uint32_t height, DecodedImage& scaled)
+{
+	scaled.width = width;
+	scaled.height = height;
+	scaled.rowPitch = static_cast<size_t>(width) * kBytesPerPixel;
+	scaled.pixels.assign(scaled.rowPitch * height, 0);
+
+	AreaWeights columns;
+	AreaWeights rows;
+	ComputeAreaWeights(source.width, width, columns);
+	ComputeAreaWeights(source.height, height, rows);
+
+	// ɉk߂Ăck߂
+	std::vector<float> horizontal(static_cast<size_t>(width) * kBytesPerPixel * source.height);
+	for (uint32_t y = 0; y < source.height; ++y) {
+		const uint8_t* sourceRow = source.pixels.data() + y * source.rowPitch;
+		float* out = horizontal.data() + static_cast<size_t>(y) * width * kBytesPerPixel;
+		for (uint32_t x = 0; x < width; ++x) {
+			float sums[kBytesPerPixel] = {};
+			const float* weights = columns.weights.data() + columns.offsets[x];
+			for (uint32_t i = 0; i < columns.count[x]; ++i) {
+				const uint8_t* pixel = sourceRow + (columns.first[x] + i) * kBytesPerPixel;
+				for (size_t c = 0; c < kBytesPerPixel; ++c) {
+					sums[c] += pixel[c] * weights[i];
+				}
+			}
+			std::copy(sums, sums + kBytesPerPixel, out + x * kBytesPerPixel);
+		}
+	}
+	const size_t horizontalPitch = static_cast<size_t>(width) * kBytesPerPixel;
+	for (uint32_t y = 0; y < height; ++y) {
+		uint8_t* out = scaled.pixels.data() + y * scaled.rowPitch;
+		const float* weights = rows.weights.data() + rows.offsets[y];
+		for (size_t x = 0; x < horizontalPitch; ++x) {
+			float sum = 0.0f;
+			for (uint32_t i = 0; i < rows.count[y]; ++i) {
+				sum += horizontal[(rows.first[y] + i) * horizontalPitch + x] * weights[i];
+			}
+			out[x] = static_cast<uint8_t>((std::min)(sum + 0.5f, 255.0f));
+		}
+	}
+}
+}
+}
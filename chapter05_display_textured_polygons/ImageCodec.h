@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+class JobSystem;
+
+// ssb`𑵂ăfR[h摜(RGBA e8bit)
+struct DecodedImage
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	size_t rowPitch = 0;
+	std::vector<uint8_t> pixels;
+};
+
+enum class ImageFileType {
+	Unknown,
+	Jpeg,
+	Png,
+};
+
+struct ImageInfo
+{
+	ImageFileType type = ImageFileType::Unknown;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	// t@C1`l̃rbg(16bit  PNG Ȃ 16)BfR[hʂ͂ǂ 8bit
+	uint32_t bitDepth = 8;
+	// sRGB ƖĂ(HasSrgbColorSpace)
+	bool srgb = false;
+};
+
+// ÕfR[_[(JpegDecoder / PngDecoder)̓BWIC  D3D12 gȂ̂ Windows ȊOłB
+// o͂͂ǂ̌`ł RGBA e8bit
+
+// wb_[ǂށBÕfR[_[ΉĂȂ`(vObVu JPEG Ȃ)Ȃ false
+bool ReadImageInfo(const uint8_t* data, size_t size, ImageInfo& info);
+// destination 1s rowPitch oCgԊuŃfR[hB
+// jobSystem n JPEG ̃fR[ḧꕔ[J[ɕ
+bool DecodeImage(
+	const uint8_t* data,
+	size_t size,
+	uint8_t* destination,
+	size_t rowPitch,
+	size_t destinationSize,
+	JobSystem* jobSystem = nullptr
+);
+// ssb` pitchAlignment ̔{ɑăfR[h
+bool DecodeImage(const uint8_t* data, size_t size, size_t pitchAlignment, DecodedImage& image, JobSystem* jobSystem = nullptr);
+
+// DirectXTex  LoadFromWICFile(WIC_FLAGS_NONE)ƓAPNG  sRGB `N gAMA  1/2.2A
+// JPEG  EXIF  ColorSpace  1 ̂Ƃ sRGB Ƃ݂ȂBwb_[Ȃ̂ŁAÕfR[_[œǂ߂Ȃ摜ɂg
+bool HasSrgbColorSpace(const uint8_t* data, size_t size);
+
+bool ReadFileBytes(const std::string& path, std::vector<uint8_t>& data);
+
+// width x height ɏkBk1sNZɏdȂ錳̃sNZʐςŏdݕtĕς
+void ScaleRgba8(const DecodedImage& source, uint32_t width, uint32_t height, DecodedImage& scaled);
+}
+}
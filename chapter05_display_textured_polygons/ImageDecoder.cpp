@@ -0,0 +1,429 @@
+#include "ImageDecoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+
+#include "Helpers.h"
+
+using Microsoft::WRL::ComPtr;
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+// ÕfR[_[œǂމ摜Bt@C̒gĂAǂݏoꂽƂɃfR[h
+class PortableImage
+{
+public:
+	std::vector<uint8_t> fileData;
+	JobSystem* jobSystem = nullptr;
+	// ImageDecoder::Scale ōƂ̌̉摜
+	std::shared_ptr<const PortableImage> parent;
+	uint32_t width = 0;
+	uint32_t height = 0;
+
+	// Ŝ1񂾂fR[h(k)ĎĂB͈͂ǂݏoƂƏkƂɎg
+	const DecodedImage* Decoded() const
+	{
+		std::call_once(m_decodeOnce, [this]() {
+			if (!parent) {
+				m_decodeSucceeded = DecodeImage(fileData.data(), fileData.size(), 1, m_decoded, jobSystem);
+				return;
+			}
+			const DecodedImage* source = parent->Decoded();
+			if (source) {
+				ScaleRgba8(*source, width, height, m_decoded);
+				m_decodeSucceeded = true;
+			}
+		});
+		return m_decodeSucceeded ? &m_decoded : nullptr;
+	}
+
+	bool CopyPixels(uint32_t x, uint32_t y, uint32_t copyWidth, uint32_t copyHeight, uint8_t* destination, size_t rowPitch) const
+	{
+		const DecodedImage* decoded = Decoded();
+		if (!decoded) {
+			return false;
+		}
+		for (uint32_t row = 0; row < copyHeight; ++row) {
+			std::memcpy(
+				destination + row * rowPitch,
+				decoded->pixels.data() + (y + row) * decoded->rowPitch + x * ImageSource::kBytesPerPixel,
+				copyWidth * ImageSource::kBytesPerPixel
+			);
+		}
+		return true;
+	}
+
+private:
+	mutable std::once_flag m_decodeOnce;
+	mutable DecodedImage m_decoded;
+	mutable bool m_decodeSucceeded = false;
+};
+
+bool ImageSource::CopyPixels(uint8_t* destination, size_t rowPitch, size_t destinationSize) const
+{
+	if (rowPitch < static_cast<size_t>(m_width) * BytesPerPixel() ||
+		destinationSize < rowPitch * (m_height - 1) + m_width * BytesPerPixel()) {
+		DebugOutputFormatString("ImageSource::CopyPixels destination is too small.\n");
+		return false;
+	}
+	if (m_portable) {
+		// kĂȂΏݐ֒ڃfR[h
+		if (!m_portable->parent) {
+			const std::vector<uint8_t>& fileData = m_portable->fileData;
+			return DecodeImage(fileData.data(), fileData.size(), destination, rowPitch, destinationSize, m_portable->jobSystem);
+		}
+		return m_portable->CopyPixels(0, 0, m_width, m_height, destination, rowPitch);
+	}
+	HRESULT result = m_source->CopyPixels(
+		// S
+		nullptr,
+		static_cast<UINT>(rowPitch),
+		static_cast<UINT>(destinationSize),
+		destination
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("IWICBitmapSource::CopyPixels Error : 0x%x\n", result);
+		return false;
+	}
+	return true;
+}
+
+bool ImageSource::CopyPixels(
+	uint32_t x,
+	uint32_t y,
+	uint32_t width,
+	uint32_t height,
+	uint8_t* destination,
+	size_t rowPitch,
+	size_t destinationSize
+) const {
+	if (x + width > m_width || y + height > m_height ||
+		rowPitch < static_cast<size_t>(width) * BytesPerPixel() ||
+		destinationSize < rowPitch * (height - 1) + width * BytesPerPixel()) {
+		DebugOutputFormatString("ImageSource::CopyPixels rectangle is out of range.\n");
+		return false;
+	}
+	if (m_portable) {
+		return m_portable->CopyPixels(x, y, width, height, destination, rowPitch);
+	}
+	const WICRect rect = {
+		static_cast<INT>(x),
+		static_cast<INT>(y),
+		static_cast<INT>(width),
+		static_cast<INT>(height)
+	};
+	HRESULT result = m_source->CopyPixels(
+		&rect,
+		static_cast<UINT>(rowPitch),
+		static_cast<UINT>(destinationSize),
+		destination
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("IWICBitmapSource::CopyPixels Error : 0x%x\n", result);
+		return false;
+	}
+	return true;
+}
+
+bool ImageDecoder::Initialize(JobSystem* jobSystem)
+{
+	m_jobSystem = jobSystem;
+	if (m_factory) {
+		return true;
+	}
+	HRESULT result = CoCreateInstance(
+		CLSID_WICImagingFactory,
+		nullptr,
+		CLSCTX_INPROC_SERVER,
+		IID_PPV_ARGS(m_factory.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CoCreateInstance Error (for WIC): 0x%x\n", result);
+		return false;
+	}
+	return true;
+}
+
+bool ImageDecoder::OpenPortable(const wchar_t* path, ImageSource& source, ImageInfo& info) const
+{
+	info = ImageInfo();
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return false;
+	}
+	auto image = std::make_shared<PortableImage>();
+	image->fileData.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	if (!file.read(reinterpret_cast<char*>(image->fileData.data()), image->fileData.size())) {
+		return false;
+	}
+
+	if (!ReadImageInfo(image->fileData.data(), image->fileData.size(), info)) {
+		return false;
+	}
+	image->jobSystem = m_jobSystem;
+	image->width = info.width;
+	image->height = info.height;
+
+	source.m_portable = image;
+	source.m_source.Reset();
+	source.m_width = info.width;
+	source.m_height = info.height;
+	source.m_format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	source.m_sourceFormat = kSourceRgba8;
+	return true;
+}
+
+bool ImageDecoder::OpenFrame(const wchar_t* path, ComPtr<IWICBitmapFrameDecode>& frame) const
+{
+	ComPtr<IWICBitmapDecoder> decoder;
+	HRESULT result = m_factory->CreateDecoderFromFilename(
+		path,
+		nullptr,
+		GENERIC_READ,
+		WICDecodeMetadataCacheOnDemand,
+		decoder.GetAddressOf()
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateDecoderFromFilename Error : 0x%x\n", result);
+		return false;
+	}
+
+	result = decoder->GetFrame(0, frame.ReleaseAndGetAddressOf());
+	if (FAILED(result)) {
+		DebugOutputFormatString("IWICBitmapDecoder::GetFrame Error : 0x%x\n", result);
+		return false;
+	}
+	return true;
+}
+
+bool ImageDecoder::IsHighPrecision(IWICBitmapFrameDecode* frame) const
+{
+	WICPixelFormatGUID pixelFormat{};
+	ComPtr<IWICComponentInfo> componentInfo;
+	ComPtr<IWICPixelFormatInfo2> pixelFormatInfo;
+	UINT bitsPerPixel = 0;
+	UINT channelCount = 0;
+	if (FAILED(frame->GetPixelFormat(&pixelFormat)) ||
+		FAILED(m_factory->CreateComponentInfo(pixelFormat, componentInfo.GetAddressOf())) ||
+		FAILED(componentInfo.As(&pixelFormatInfo)) ||
+		FAILED(pixelFormatInfo->GetBitsPerPixel(&bitsPerPixel)) ||
+		FAILED(pixelFormatInfo->GetChannelCount(&channelCount)) ||
+		channelCount == 0) {
+		// Ȃ 8bit Ƃēǂ
+		return false;
+	}
+	return bitsPerPixel / channelCount >= 16;
+}
+
+bool ImageDecoder::Convert(
+	IWICBitmapFrameDecode* frame,
+	REFWICPixelFormatGUID pixelFormat,
+	DXGI_FORMAT format,
+	ImageSource& source
+) const {
+	// ̌`Ɋւ炸 pixelFormat ɕϊĎo
+	ComPtr<IWICFormatConverter> converter;
+	HRESULT result = m_factory->CreateFormatConverter(converter.GetAddressOf());
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateFormatConverter Error : 0x%x\n", result);
+		return false;
+	}
+	result = converter->Initialize(
+		frame,
+		pixelFormat,
+		WICBitmapDitherTypeNone,
+		nullptr,
+		0.0,
+		WICBitmapPaletteTypeCustom
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("IWICFormatConverter::Initialize Error : 0x%x\n", result);
+		return false;
+	}
+
+	UINT width = 0;
+	UINT height = 0;
+	result = converter->GetSize(&width, &height);
+	if (FAILED(result)) {
+		DebugOutputFormatString("IWICBitmapSource::GetSize Error : 0x%x\n", result);
+		return false;
+	}
+
+	source.m_portable.reset();
+	source.m_source = converter;
+	source.m_width = width;
+	source.m_height = height;
+	source.m_format = format;
+	source.m_sourceFormat = kSourceRgba8;
+	return true;
+}
+
+bool ImageDecoder::Open(const wchar_t* path, ImageSource& source) const
+{
+	ImageInfo info;
+	if (OpenPortable(path, source, info)) {
+		return true;
+	}
+	ComPtr<IWICBitmapFrameDecode> frame;
+	if (!OpenFrame(path, frame)) {
+		return false;
+	}
+	return Convert(frame.Get(), GUID_WICPixelFormat32bppRGBA, DXGI_FORMAT_R8G8B8A8_UNORM, source);
+}
+
+bool ImageDecoder::OpenTexture(const wchar_t* path, ImageSource& source) const
+{
+	ImageInfo info;
+	if (OpenPortable(path, source, info) && info.bitDepth <= 8) {
+		source.m_format = info.srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+		return true;
+	}
+	ComPtr<IWICBitmapFrameDecode> frame;
+	if (!OpenFrame(path, frame)) {
+		return false;
+	}
+	// R16G16B16A16 ɂ _SRGB Ȃ̂ŁA16bit ̉摜 sRGB ł UNORM ̂܂
+	if (IsHighPrecision(frame.Get())) {
+		return Convert(frame.Get(), GUID_WICPixelFormat64bppRGBA, DXGI_FORMAT_R16G16B16A16_UNORM, source);
+	}
+	return Convert(
+		frame.Get(),
+		GUID_WICPixelFormat32bppRGBA,
+		info.srgb ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM,
+		source
+	);
+}
+
+bool ImageDecoder::OpenRaw(const wchar_t* path, ImageSource& source) const
+{
+	ImageInfo info;
+	if (OpenPortable(path, source, info)) {
+		return true;
+	}
+	ComPtr<IWICBitmapFrameDecode> frame;
+	if (!OpenFrame(path, frame)) {
+		return false;
+	}
+
+	WICPixelFormatGUID pixelFormat{};
+	HRESULT result = frame->GetPixelFormat(&pixelFormat);
+	if (FAILED(result)) {
+		DebugOutputFormatString("IWICBitmapFrameDecode::GetPixelFormat Error : 0x%x\n", result);
+		return false;
+	}
+
+	// JPEG  24bppBGRAPNG  24bppBGR / 32bppBGRA ŃfR[h邱Ƃ
+	struct RawFormat
+	{
+		const GUID* pixelFormat;
+		TextureSourceFormat sourceFormat;
+	};
+	const RawFormat rawFormats[] = {
+		{ &GUID_WICPixelFormat24bppRGB, kSourceRgb8 },
+		{ &GUID_WICPixelFormat24bppBGR, kSourceBgr8 },
+		{ &GUID_WICPixelFormat32bppRGBA, kSourceRgba8 },
+		{ &GUID_WICPixelFormat32bppBGRA, kSourceBgra8 },
+	};
+	for (const RawFormat& rawFormat : rawFormats) {
+		if (!IsEqualGUID(pixelFormat, *rawFormat.pixelFormat)) {
+			continue;
+		}
+		UINT width = 0;
+		UINT height = 0;
+		result = frame->GetSize(&width, &height);
+		if (FAILED(result)) {
+			DebugOutputFormatString("IWICBitmapSource::GetSize Error : 0x%x\n", result);
+			return false;
+		}
+		source.m_portable.reset();
+		source.m_source = frame;
+		source.m_width = width;
+		source.m_height = height;
+		source.m_format = DXGI_FORMAT_R8G8B8A8_UNORM;
+		source.m_sourceFormat = rawFormat.sourceFormat;
+		return true;
+	}
+	return Convert(frame.Get(), GUID_WICPixelFormat32bppRGBA, DXGI_FORMAT_R8G8B8A8_UNORM, source);
+}
+
+bool ImageDecoder::Scale(const ImageSource& source, uint32_t width, uint32_t height, ImageSource& scaled) const
+{
+	if (source.m_portable) {
+		// ̉摜1fR[ĥʐϕςŏk
+		auto image = std::make_shared<PortableImage>();
+		image->parent = source.m_portable;
+		image->width = width;
+		image->height = height;
+		scaled.m_portable = image;
+		scaled.m_source.Reset();
+		scaled.m_width = width;
+		scaled.m_height = height;
+		scaled.m_format = source.m_format;
+		scaled.m_sourceFormat = source.m_sourceFormat;
+		return true;
+	}
+	ComPtr<IWICBitmapScaler> scaler;
+	HRESULT result = m_factory->CreateBitmapScaler(scaler.GetAddressOf());
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateBitmapScaler Error : 0x%x\n", result);
+		return false;
+	}
+	// ~bv̂ŁAkł܂Ԃ̏oɂ Fant ɂ
+	result = scaler->Initialize(source.m_source.Get(), width, height, WICBitmapInterpolationModeFant);
+	if (FAILED(result)) {
+		DebugOutputFormatString("IWICBitmapScaler::Initialize Error : 0x%x\n", result);
+		return false;
+	}
+
+	scaled.m_portable.reset();
+	scaled.m_source = scaler;
+	scaled.m_width = width;
+	scaled.m_height = height;
+	scaled.m_format = source.m_format;
+	scaled.m_sourceFormat = source.m_sourceFormat;
+	return true;
+}
+
+bool ImageDecoder::Decode(const wchar_t* path, size_t pitchAlignment, DecodedImage& image) const
+{
+	ImageSource source;
+	if (!Open(path, source)) {
+		return false;
+	}
+
+	const size_t tightPitch = static_cast<size_t>(source.Width()) * ImageSource::kBytesPerPixel;
+	image.width = source.Width();
+	image.height = source.Height();
+	image.rowPitch = (tightPitch + pitchAlignment - 1) / pitchAlignment * pitchAlignment;
+	image.pixels.resize(image.rowPitch * image.height);
+	return source.CopyPixels(image.pixels.data(), image.rowPitch, image.pixels.size());
+}
+
+bool ImageDecoder::DecodeParallel(
+	const std::vector<std::wstring>& paths,
+	size_t pitchAlignment,
+	std::vector<DecodedImage>& images,
+	JobSystem& jobSystem
+) const
+{
+	images.resize(paths.size());
+	std::atomic<bool> succeeded(true);
+
+	// ÕfR[_[̓XbhƂɏԂB
+	// WIC  COM Amain  MTA Ă̂Ń[J[ CoInitializeEx ȂĂg
+	jobSystem.ParallelFor(paths.size(), 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			if (!Decode(paths[i].c_str(), pitchAlignment, images[i])) {
+				succeeded = false;
+			}
+		}
+	});
+	return succeeded;
+}
+}
+}
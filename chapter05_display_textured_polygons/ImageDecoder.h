@@ -0,0 +1,109 @@
+#pragma once
+#include <Windows.h>
+#include <dxgiformat.h>
+#include <wincodec.h>
+#include <wrl.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ImageCodec.h"
+#include "JobSystem.h"
+#include "TextureConversion.h"
+
+namespace yuxx {
+namespace DirectX12 {
+class PortableImage;
+
+// Jł܂fR[hĂȂ摜1B
+// WIC ÕfR[_[ CopyPixels Ă񂾎_ŃfR[ĥŁAݐn1ōς
+class ImageSource
+{
+public:
+	// Open ŊJƂ̏o͂ RGBA e8bit
+	static constexpr uint32_t kBytesPerPixel = 4;
+
+	uint32_t Width() const { return m_width; }
+	uint32_t Height() const { return m_height; }
+	// CopyPixels œǂݏof̃tH[}bgBOpenTexture ŊJƂ _SRGB  R16G16B16A16 ɂȂ
+	DXGI_FORMAT Format() const { return m_format; }
+	// OpenRaw ŊJƂ͌̉f̕(Open Ȃ kSourceRgba8)
+	TextureSourceFormat SourceFormat() const { return m_sourceFormat; }
+	uint32_t BytesPerPixel() const
+	{
+		return m_format == DXGI_FORMAT_R16G16B16A16_UNORM ? 8 : SourceBytesPerPixel(m_sourceFormat);
+	}
+
+	// destination 1s rowPitch oCgԊuŃfR[h
+	bool CopyPixels(uint8_t* destination, size_t rowPitch, size_t destinationSize) const;
+	// (x, y)  width x height ͈̔͂fR[hB^CœǂݍނƂɎg
+	bool CopyPixels(
+		uint32_t x,
+		uint32_t y,
+		uint32_t width,
+		uint32_t height,
+		uint8_t* destination,
+		size_t rowPitch,
+		size_t destinationSize
+	) const;
+
+private:
+	friend class ImageDecoder;
+
+	// ÕfR[_[œǂ߂摜 m_portableAȊO WIC  m_source œǂ
+	std::shared_ptr<const PortableImage> m_portable;
+	Microsoft::WRL::ComPtr<IWICBitmapSource> m_source;
+	uint32_t m_width = 0;
+	uint32_t m_height = 0;
+	DXGI_FORMAT m_format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	TextureSourceFormat m_sourceFormat = kSourceRgba8;
+};
+
+// PNG / JPEG ÕfR[_[(ImageCodec.h)œǂށB
+// ÕfR[_[ΉĂȂ`(vObVu JPEG  TIFF Ȃ) WIC œǂ
+class ImageDecoder
+{
+public:
+	// jobSystem nƁAJPEG ̃fR[ḧꕔ[J[ɕ
+	bool Initialize(JobSystem* jobSystem = nullptr);
+
+	bool Open(const wchar_t* path, ImageSource& source) const;
+	// eNX`ɂ̂܂܃Abv[h邽߂ɊJBDirectXTex  LoadFromWICFile ƓA
+	// sRGB Ɩꂽ摜 R8G8B8A8_UNORM_SRGBA1`l 16bit ȏ̉摜 R16G16B16A16_UNORM ɂB
+	// 16bit ̉摜͎ÕfR[_[ 8bit ɂĂ܂̂ WIC œǂ
+	bool OpenTexture(const wchar_t* path, ImageSource& source) const;
+	// ̉f̕т TextureSourceFormat ̂ǂꂩȂϊɊJ(בւ GPU ōs)B
+	// ȊǑ`(pbg 16bit Ȃ) Open Ɠ RGBA e8bit ɕϊB
+	// ÕfR[_[œǂ߂摜͏ kSourceRgba8
+	bool OpenRaw(const wchar_t* path, ImageSource& source) const;
+	// source  width x height ɏkēǂށBfR[h scaled ǂݏoƂɍs
+	bool Scale(const ImageSource& source, uint32_t width, uint32_t height, ImageSource& scaled) const;
+	// ssb` pitchAlignment ̔{ɑăfR[h
+	bool Decode(const wchar_t* path, size_t pitchAlignment, DecodedImage& image) const;
+	// ̉摜 jobSystem ̃[J[ɕăfR[h
+	bool DecodeParallel(
+		const std::vector<std::wstring>& paths,
+		size_t pitchAlignment,
+		std::vector<DecodedImage>& images,
+		JobSystem& jobSystem
+	) const;
+
+private:
+	Microsoft::WRL::ComPtr<IWICImagingFactory> m_factory;
+	JobSystem* m_jobSystem = nullptr;
+
+	// path ǂŎÕfR[_[ŊJBǂ߂Ȃ`Ȃ false ŁAinfo.srgb ͖߂
+	bool OpenPortable(const wchar_t* path, ImageSource& source, ImageInfo& info) const;
+	bool OpenFrame(const wchar_t* path, Microsoft::WRL::ComPtr<IWICBitmapFrameDecode>& frame) const;
+	// 1`l 16bit ȏ̉ftH[}bg
+	bool IsHighPrecision(IWICBitmapFrameDecode* frame) const;
+	bool Convert(
+		IWICBitmapFrameDecode* frame,
+		REFWICPixelFormatGUID pixelFormat,
+		DXGI_FORMAT format,
+		ImageSource& source
+	) const;
+};
+}
+}
@@ -0,0 +1,47 @@
+#include "IndirectArguments.h"
+
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+void PackAabbs(const AabbSoA& aabbs, PackedAabb* packedAabbs)
+{
+	for (size_t i = 0; i < aabbs.Size(); ++i) {
+		packedAabbs[i] = {
+			{ aabbs.centerX[i], aabbs.centerY[i], aabbs.centerZ[i] },
+			{ aabbs.extentX[i], aabbs.extentY[i], aabbs.extentZ[i] }
+		};
+	}
+}
+
+CullConstants MakeCullConstants(const Frustum& frustum, uint32_t drawCount)
+{
+	CullConstants constants{};
+	for (int i = 0; i < 6; ++i) {
+		constants.planes[i] = frustum.planes[i];
+	}
+	constants.drawCount = drawCount;
+	return constants;
+}
+
+uint32_t CullThreadGroupCount(uint32_t drawCount)
+{
+	return (drawCount + kCullThreadGroupSize - 1) / kCullThreadGroupSize;
+}
+
+uint32_t CullDrawArguments(
+	const Frustum& frustum,
+	const AabbSoA& aabbs,
+	const DrawIndexedArguments* drawArguments,
+	DrawIndexedArguments* visibleArguments
+) {
+	// SIMD ł FMA ĝŁAE肬̂̂ GPU ƐHႤƂ
+	std::vector<uint32_t> visibleIndices(aabbs.Size());
+	const size_t visibleCount = CullAabbs(frustum, aabbs, visibleIndices.data(), nullptr, CullingInstructionSet::Scalar);
+	for (size_t i = 0; i < visibleCount; ++i) {
+		visibleArguments[i] = drawArguments[visibleIndices[i]];
+	}
+	return static_cast<uint32_t>(visibleCount);
+}
+}
+}
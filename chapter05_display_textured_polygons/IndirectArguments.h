@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+
+#include "Culling.h"
+
+// GPU JO(IndirectCull.hlsl)ɓnf[^̋lߕƁA CPU ŁB
+// D3D12 ɂ͈ˑȂ̂ŁAD3D12 ̂ȂłeXgł
+namespace yuxx {
+namespace DirectX12 {
+// IndirectCull.hlsl  Aabb ƓCAEg
+struct PackedAabb
+{
+	float center[3];
+	float extent[3];
+};
+
+// IndirectCull.hlsl  CullConstants ƓCAEg([g萔œn)
+struct CullConstants
+{
+	Float4 planes[6];
+	uint32_t drawCount;
+};
+
+// IndirectCull.hlsl  DrawIndexedArgumentsAD3D12_DRAW_INDEXED_ARGUMENTS ƓCAEg
+struct DrawIndexedArguments
+{
+	uint32_t indexCountPerInstance;
+	uint32_t instanceCount;
+	uint32_t startIndexLocation;
+	int32_t baseVertexLocation;
+	uint32_t startInstanceLocation;
+};
+
+// IndirectCull.hlsl  numthreads ƍ킹
+constexpr uint32_t kCullThreadGroupSize = 64;
+
+void PackAabbs(const AabbSoA& aabbs, PackedAabb* packedAabbs);
+CullConstants MakeCullConstants(const Frustum& frustum, uint32_t drawCount);
+// drawCount 𔻒肷̂ Dispatch XbhO[v̐
+uint32_t CullThreadGroupCount(uint32_t drawCount);
+
+// CullCS  CPU ŁBGPU Ɠ(XJ[)Ŕ肷B
+// GPU ̓Ag~bNɋl߂̂ŕя͈vȂ(rƂ͕בւ邱)
+uint32_t CullDrawArguments(
+	const Frustum& frustum,
+	const AabbSoA& aabbs,
+	const DrawIndexedArguments* drawArguments,
+	DrawIndexedArguments* visibleArguments
+);
+}
+}
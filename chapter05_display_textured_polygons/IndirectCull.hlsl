@@ -0,0 +1,58 @@
+// IndirectArguments.h  PackedAabb ƓCAEg
+struct Aabb
+{
+    float3 center;
+    float3 extent;
+};
+
+// IndirectArguments.h  DrawIndexedArgumentsAD3D12_DRAW_INDEXED_ARGUMENTS ƓCAEg
+struct DrawIndexedArguments
+{
+    uint indexCountPerInstance;
+    uint instanceCount;
+    uint startIndexLocation;
+    int baseVertexLocation;
+    uint startInstanceLocation;
+};
+
+// [g萔œn(IndirectArguments.h  CullConstants)
+cbuffer CullConstants : register(b0)
+{
+    // 6()
+    float4 planes[6];
+    uint drawCount;
+};
+
+// `PʂƂ AABB
+StructuredBuffer<Aabb> bounds : register(t0);
+// `PʂƂ̕`
+StructuredBuffer<DrawIndexedArguments> drawArguments : register(t1);
+// Ă̂̕`l߂ď
+RWStructuredBuffer<DrawIndexedArguments> visibleArguments : register(u0);
+// 񂾌(ExecuteIndirect ̃JEgobt@[)
+RWByteAddressBuffer visibleCount : register(u1);
+
+[numthreads(64, 1, 1)]
+void CullCS(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    uint index = dispatchThreadId.x;
+    if (index >= drawCount)
+    {
+        return;
+    }
+
+    Aabb aabb = bounds[index];
+    for (uint i = 0; i < 6; ++i)
+    {
+        float distance = dot(planes[i].xyz, aabb.center) + planes[i].w;
+        float radius = dot(abs(planes[i].xyz), aabb.extent);
+        if (distance + radius < 0.0f)
+        {
+            return;
+        }
+    }
+
+    uint slot;
+    visibleCount.InterlockedAdd(0, 1, slot);
+    visibleArguments[slot] = drawArguments[index];
+}
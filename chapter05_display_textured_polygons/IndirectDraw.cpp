@@ -0,0 +1,19 @@
+#include "IndirectDraw.h"
+
+namespace yuxx {
+namespace DirectX12 {
+void SetupDrawIndexedCommandSignature(
+	D3D12_COMMAND_SIGNATURE_DESC& commandSignatureDesc,
+	D3D12_INDIRECT_ARGUMENT_DESC& argumentDesc
+) {
+	argumentDesc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+	//  D3D12_DRAW_INDEXED_ARGUMENTS ԂȂׂ
+	commandSignatureDesc.ByteStride = sizeof(D3D12_DRAW_INDEXED_ARGUMENTS);
+	commandSignatureDesc.NumArgumentDescs = 1;
+	commandSignatureDesc.pArgumentDescs = &argumentDesc;
+	// PA_v^[̂0
+	commandSignatureDesc.NodeMask = 0;
+}
+}
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <d3d12.h>
+#include <cstddef>
+
+#include "IndirectArguments.h"
+#include "RootSignatureBuilder.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// ` CPU ŋl߂̂̂܂ ExecuteIndirect ɓn
+static_assert(sizeof(DrawIndexedArguments) == sizeof(D3D12_DRAW_INDEXED_ARGUMENTS), "DrawIndexedArguments layout mismatch");
+static_assert(offsetof(DrawIndexedArguments, baseVertexLocation) == offsetof(D3D12_DRAW_INDEXED_ARGUMENTS, BaseVertexLocation), "DrawIndexedArguments layout mismatch");
+static_assert(offsetof(DrawIndexedArguments, startInstanceLocation) == offsetof(D3D12_DRAW_INDEXED_ARGUMENTS, StartInstanceLocation), "DrawIndexedArguments layout mismatch");
+
+// IndirectCull.hlsl ̃WX^[
+constexpr auto kCullRootSignature = MakeRootSignatureDescription(
+	D3D12_ROOT_SIGNATURE_FLAG_NONE,
+	RootParameters(
+		RootConstants("CullConstants", "cull", 0, sizeof(CullConstants) / sizeof(uint32_t)),
+		RootDescriptor(D3D12_ROOT_PARAMETER_TYPE_SRV, "StructuredBuffer<Aabb>", "bounds", 0),
+		RootDescriptor(D3D12_ROOT_PARAMETER_TYPE_SRV, "StructuredBuffer<DrawIndexedArguments>", "drawArguments", 1),
+		RootDescriptor(D3D12_ROOT_PARAMETER_TYPE_UAV, "RWStructuredBuffer<DrawIndexedArguments>", "visibleArguments", 0),
+		RootDescriptor(D3D12_ROOT_PARAMETER_TYPE_UAV, "RWByteAddressBuffer", "visibleCount", 1)
+	),
+	StaticSamplers()
+);
+
+// DrawIndexedInstanced ςރR}hVOl`̐ݒ
+void SetupDrawIndexedCommandSignature(
+	D3D12_COMMAND_SIGNATURE_DESC& commandSignatureDesc,
+	D3D12_INDIRECT_ARGUMENT_DESC& argumentDesc
+);
+}
+}
@@ -0,0 +1,82 @@
+#include "FileWatcher.h"
+
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "Helpers.h"
+
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	class InotifyFileWatcher : public FileWatcher
+	{
+	public:
+		InotifyFileWatcher() : m_descriptor(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+		{
+			if (m_descriptor < 0) {
+				DebugOutputFormatString("inotify_init1 Error : %s\n", std::strerror(errno));
+			}
+		}
+
+		~InotifyFileWatcher() override
+		{
+			if (m_descriptor >= 0) {
+				close(m_descriptor);
+			}
+		}
+
+		bool AddWatchDirectory(const PathString& directory) override
+		{
+			if (m_descriptor < 0) {
+				return false;
+			}
+			// ݂̂قAꎞt@C̒u(MOVED_TO)ƍ蒼(CREATE)E
+			const uint32_t mask = IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_ATTRIB;
+			if (inotify_add_watch(m_descriptor, directory.c_str(), mask) < 0) {
+				DebugOutputFormatString("inotify_add_watch Error : %s\n", std::strerror(errno));
+				return false;
+			}
+			return true;
+		}
+
+		bool ConsumeNotifications() override
+		{
+			if (m_descriptor < 0) {
+				return false;
+			}
+			// ǂ̃t@C͌A܂ĂCxgǂݎ̂Ă( HotReloader ׂ)
+			alignas(inotify_event) char buffer[4096];
+			bool notified = false;
+			while (read(m_descriptor, buffer, sizeof(buffer)) > 0) {
+				notified = true;
+			}
+			return notified;
+		}
+
+	private:
+		int m_descriptor;
+	};
+}
+
+std::unique_ptr<FileWatcher> CreateFileWatcher()
+{
+	return std::unique_ptr<FileWatcher>(new InotifyFileWatcher());
+}
+
+bool GetFileLastWriteTime(const PathString& path, FileTimestamp& timestamp)
+{
+	struct stat status;
+	if (stat(path.c_str(), &status) != 0) {
+		return false;
+	}
+	timestamp = static_cast<FileTimestamp>(status.st_mtim.tv_sec) * 1000000000u + static_cast<FileTimestamp>(status.st_mtim.tv_nsec);
+	return true;
+}
+}
+}
@@ -0,0 +1,313 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif // _WIN32
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// ̃Xbhǂ̃WuVXẻԖڂ
+	thread_local const JobSystem* t_jobSystem = nullptr;
+	thread_local int t_threadIndex = -1;
+
+	void PinThreadToCore(std::thread::native_handle_type thread, unsigned int core)
+	{
+#ifdef _WIN32
+		SetThreadAffinityMask(thread, static_cast<DWORD_PTR>(1) << (core % (sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(core % CPU_SETSIZE, &set);
+		pthread_setaffinity_np(thread, sizeof(set), &set);
+#else
+		(void)thread;
+		(void)core;
+#endif // _WIN32
+	}
+
+	std::thread::native_handle_type CurrentThreadHandle()
+	{
+#ifdef _WIN32
+		return GetCurrentThread();
+#elif defined(__linux__)
+		return pthread_self();
+#else
+		return std::thread::native_handle_type();
+#endif // _WIN32
+	}
+}
+
+JobSystem::JobSystem() : JobSystem(Options())
+{
+}
+
+JobSystem::JobSystem(const Options& options)
+{
+	Start(options);
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sleepMutex);
+		m_stopping = true;
+	}
+	m_sleepCondition.notify_all();
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+
+	// sꂸɎcWûĂ
+	for (auto& deque : m_deques) {
+		while (JobEntry* entry = deque->Steal()) {
+			delete entry;
+		}
+	}
+	for (JobEntry* entry : m_sharedJobs) {
+		delete entry;
+	}
+	for (JobEntry* entry : m_mainThreadJobs) {
+		delete entry;
+	}
+	if (t_jobSystem == this) {
+		t_jobSystem = m_previousJobSystem;
+		t_threadIndex = m_previousThreadIndex;
+	}
+}
+
+void JobSystem::Start(const Options& options)
+{
+	unsigned int workerCount = options.workerCount;
+	if (workerCount == 0) {
+		const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	m_mainThreadId = std::this_thread::get_id();
+	m_previousJobSystem = t_jobSystem;
+	m_previousThreadIndex = t_threadIndex;
+	t_jobSystem = this;
+	t_threadIndex = 0;
+	for (unsigned int i = 0; i <= workerCount; ++i) {
+		m_deques.emplace_back(new WorkStealingDeque<JobEntry>(kDequeCapacity));
+	}
+
+	if (options.pinThreads) {
+		PinThreadToCore(CurrentThreadHandle(), 0);
+	}
+	for (unsigned int i = 0; i < workerCount; ++i) {
+		m_workers.emplace_back(&JobSystem::WorkerLoop, this, static_cast<int>(i + 1));
+		if (options.pinThreads) {
+			PinThreadToCore(m_workers.back().native_handle(), i + 1);
+		}
+	}
+}
+
+int JobSystem::CurrentThreadIndex() const
+{
+	return t_jobSystem == this ? t_threadIndex : -1;
+}
+
+void JobSystem::Run(Job job, JobCounter* counter)
+{
+	if (counter != nullptr) {
+		counter->m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+	Enqueue(new JobEntry{ std::move(job), counter });
+}
+
+void JobSystem::RunOnMainThread(Job job, JobCounter* counter)
+{
+	if (counter != nullptr) {
+		counter->m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+	EnqueueMainThread(new JobEntry{ std::move(job), counter });
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, Job job, JobCounter* counter, bool mainThread)
+{
+	// ҂ĂԂ counter  0 ɂȂȂ悤AŐĂ
+	if (counter != nullptr) {
+		counter->m_count.fetch_add(1, std::memory_order_relaxed);
+	}
+	{
+		std::lock_guard<std::mutex> lock(dependency.m_mutex);
+		if (dependency.m_count.load(std::memory_order_acquire) != 0) {
+			dependency.m_continuations.push_back({ std::move(job), counter, mainThread });
+			return;
+		}
+	}
+	JobEntry* entry = new JobEntry{ std::move(job), counter };
+	if (mainThread) {
+		EnqueueMainThread(entry);
+	} else {
+		Enqueue(entry);
+	}
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body)
+{
+	grainSize = (std::max)(grainSize, static_cast<size_t>(1));
+	JobCounter counter;
+	// ŏ͈̔͂͌ĂяoŎs
+	for (size_t begin = grainSize; begin < count; begin += grainSize) {
+		const size_t end = (std::min)(begin + grainSize, count);
+		Run([&body, begin, end]() { body(begin, end); }, &counter);
+	}
+	if (count > 0) {
+		body(0, (std::min)(grainSize, count));
+	}
+	Wait(counter);
+}
+
+void JobSystem::Enqueue(JobEntry* entry)
+{
+	const int threadIndex = CurrentThreadIndex();
+	if (threadIndex < 0 || !m_deques[threadIndex]->Push(entry)) {
+		std::lock_guard<std::mutex> lock(m_sharedMutex);
+		m_sharedJobs.push_back(entry);
+	}
+
+	m_queuedJobs.fetch_add(1, std::memory_order_seq_cst);
+	if (m_sleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+		// ɓr̃[J[ʒm肱ڂȂ悤AbNʂĂN
+		{
+			std::lock_guard<std::mutex> lock(m_sleepMutex);
+		}
+		m_sleepCondition.notify_one();
+	}
+}
+
+void JobSystem::EnqueueMainThread(JobEntry* entry)
+{
+	std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+	m_mainThreadJobs.push_back(entry);
+}
+
+JobSystem::JobEntry* JobSystem::FindJob(int threadIndex)
+{
+	JobEntry* entry = nullptr;
+	if (threadIndex >= 0) {
+		entry = m_deques[threadIndex]->Pop();
+	}
+	if (entry == nullptr) {
+		std::lock_guard<std::mutex> lock(m_sharedMutex);
+		if (!m_sharedJobs.empty()) {
+			entry = m_sharedJobs.front();
+			m_sharedJobs.pop_front();
+		}
+	}
+	// ̎̃Xbh珇ɓ݂ɍs
+	const size_t dequeCount = m_deques.size();
+	const size_t first = threadIndex >= 0 ? static_cast<size_t>(threadIndex) + 1 : 0;
+	for (size_t i = 0; entry == nullptr && i < dequeCount; ++i) {
+		const size_t victim = (first + i) % dequeCount;
+		if (static_cast<int>(victim) != threadIndex) {
+			entry = m_deques[victim]->Steal();
+		}
+	}
+	if (entry != nullptr) {
+		m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+	}
+	return entry;
+}
+
+bool JobSystem::RunMainThreadJob()
+{
+	JobEntry* entry = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+		if (m_mainThreadJobs.empty()) {
+			return false;
+		}
+		entry = m_mainThreadJobs.front();
+		m_mainThreadJobs.pop_front();
+	}
+	Execute(entry);
+	return true;
+}
+
+void JobSystem::RunMainThreadJobs()
+{
+	while (RunMainThreadJob()) {
+	}
+}
+
+void JobSystem::Execute(JobEntry* entry)
+{
+	entry->job();
+	JobCounter* counter = entry->counter;
+	delete entry;
+	Finish(counter);
+}
+
+void JobSystem::Finish(JobCounter* counter)
+{
+	if (counter == nullptr) {
+		return;
+	}
+	counter->m_finishing.fetch_add(1, std::memory_order_seq_cst);
+	if (counter->m_count.fetch_sub(1, std::memory_order_seq_cst) == 1) {
+		std::vector<JobCounter::Continuation> continuations;
+		{
+			std::lock_guard<std::mutex> lock(counter->m_mutex);
+			continuations.swap(counter->m_continuations);
+		}
+		for (JobCounter::Continuation& continuation : continuations) {
+			JobEntry* entry = new JobEntry{ std::move(continuation.job), continuation.counter };
+			if (continuation.mainThread) {
+				EnqueueMainThread(entry);
+			} else {
+				Enqueue(entry);
+			}
+		}
+	}
+	// ȍ~ counter ɂ͐GȂ
+	counter->m_finishing.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+	const int threadIndex = CurrentThreadIndex();
+	const bool isMainThread = threadIndex == 0;
+	while (!counter.IsDone()) {
+		if (isMainThread && RunMainThreadJob()) {
+			continue;
+		}
+		if (JobEntry* entry = FindJob(threadIndex)) {
+			Execute(entry);
+			continue;
+		}
+		std::this_thread::yield();
+	}
+}
+
+void JobSystem::WorkerLoop(int threadIndex)
+{
+	t_jobSystem = this;
+	t_threadIndex = threadIndex;
+	while (true) {
+		if (JobEntry* entry = FindJob(threadIndex)) {
+			Execute(entry);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_sleepMutex);
+		m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+		m_sleepCondition.wait(lock, [this]() {
+			return m_stopping.load() || m_queuedJobs.load(std::memory_order_seq_cst) > 0;
+		});
+		m_sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+		if (m_stopping.load()) {
+			return;
+		}
+	}
+}
+}
+}
@@ -0,0 +1,209 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+class JobSystem;
+
+using Job = std::function<void()>;
+
+// s̃Wu̐BRun ɓnƁAWuς񂾎_őďI_ŌB
+// 0 ɂȂƂ RunAfter œo^Wuςނ̂ŁAˑ֌WɂgB
+// jOɕK JobSystem::Wait ő҂
+class JobCounter
+{
+public:
+	JobCounter() = default;
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	bool IsDone() const
+	{
+		return m_count.load(std::memory_order_seq_cst) == 0 && m_finishing.load(std::memory_order_seq_cst) == 0;
+	}
+
+private:
+	friend class JobSystem;
+
+	struct Continuation
+	{
+		Job job;
+		JobCounter* counter;
+		bool mainThread;
+	};
+
+	std::atomic<uint32_t> m_count{ 0 };
+	// Ō̃Wu RunAfter ̃WuςݏI܂ 0 ɂȂȂB
+	// Wait ߂ɃJE^[jĂAIGȂ悤ɂ
+	std::atomic<uint32_t> m_finishing{ 0 };
+	std::mutex m_mutex;
+	std::vector<Continuation> m_continuations;
+};
+
+// Chase-Lev ̃[NXeB[O[L[B
+// ̃Xbh Push / Pop ÃXbh Steal ŔΑ
+template <typename T>
+class WorkStealingDeque
+{
+public:
+	// capacity  2 ׂ̂
+	explicit WorkStealingDeque(size_t capacity);
+
+	// ςȂ false
+	bool Push(T* item);
+	T* Pop();
+	T* Steal();
+
+private:
+	std::atomic<int64_t> m_top{ 0 };
+	std::atomic<int64_t> m_bottom{ 0 };
+	size_t m_mask;
+	std::unique_ptr<std::atomic<T*>[]> m_buffer;
+};
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t capacity) :
+	m_mask(capacity - 1),
+	m_buffer(new std::atomic<T*>[capacity])
+{
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::Push(T* item)
+{
+	const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+	const int64_t top = m_top.load(std::memory_order_acquire);
+	if (bottom - top > static_cast<int64_t>(m_mask)) {
+		return false;
+	}
+	m_buffer[bottom & m_mask].store(item, std::memory_order_relaxed);
+	// Steal  bottom  acquire œǂ߂ item ̒g
+	m_bottom.store(bottom + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T>
+T* WorkStealingDeque<T>::Pop()
+{
+	const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	m_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = m_top.load(std::memory_order_relaxed);
+	if (top > bottom) {
+		// 󂾂
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	T* item = m_buffer[bottom & m_mask].load(std::memory_order_relaxed);
+	if (top == bottom) {
+		// Ō1 Steal Ǝ荇ɂȂ
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			item = nullptr;
+		}
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return item;
+}
+
+template <typename T>
+T* WorkStealingDeque<T>::Steal()
+{
+	int64_t top = m_top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+	if (top >= bottom) {
+		return nullptr;
+	}
+	T* item = m_buffer[top & m_mask].load(std::memory_order_relaxed);
+	if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return nullptr;
+	}
+	return item;
+}
+
+// [J[XbhƂ̃[NXeB[OL[ŃWusB
+// XbhCXbhƂĈARunOnMainThread ̃Wu͂łsB
+// Xbhŕʂ̃WuVXeĔjƁA܂ł̂̂CXbhɖ߂
+class JobSystem
+{
+public:
+	struct Options
+	{
+		// 0 ȂRA - 1(CXbh̕)
+		unsigned int workerCount = 0;
+		// [J[ i RA i + 1 ɌŒ肷(CXbh̓RA 0 ɌŒ肷)
+		bool pinThreads = false;
+	};
+
+	JobSystem();
+	explicit JobSystem(const Options& options);
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+	~JobSystem();
+
+	void Run(Job job, JobCounter* counter = nullptr);
+	// CXbh Wait  RunMainThreadJobs Ă񂾂ƂɎs(EBhE D3D ̃L[Ȃ)
+	void RunOnMainThread(Job job, JobCounter* counter = nullptr);
+	// dependency  0 ɂȂĂ job ςށBł 0 Ȃ炷ɐς
+	void RunAfter(JobCounter& dependency, Job job, JobCounter* counter = nullptr, bool mainThread = false);
+	// [0, count)  grainSize ɕ body(begin, end) ɌĂсAI܂ő҂
+	void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+	// counter  0 ɂȂ܂ŁA҂ĂԂWus(Wu̒Ăł悢)
+	void Wait(JobCounter& counter);
+	// CXbhŁA܂Ă RunOnMainThread ̃Wus
+	void RunMainThreadJobs();
+
+	unsigned int WorkerCount() const { return static_cast<unsigned int>(m_workers.size()); }
+	// 0 CXbhA1 ȍ~[J[B̃WuVXẽXbhłȂ -1
+	int CurrentThreadIndex() const;
+
+private:
+	struct JobEntry
+	{
+		Job job;
+		JobCounter* counter;
+	};
+	// eXbh̃L[̑傫Bӂꂽ狤LL[ɓ
+	static constexpr size_t kDequeCapacity = 4096;
+
+	std::thread::id m_mainThreadId;
+	// Oɂ̃XbhĂWuVXeBjƂɖ߂
+	const JobSystem* m_previousJobSystem = nullptr;
+	int m_previousThreadIndex = -1;
+	std::vector<std::unique_ptr<WorkStealingDeque<JobEntry>>> m_deques;
+	std::vector<std::thread> m_workers;
+
+	// [J[ȊÕXbhς܂ꂽWuƁAL[炠ӂꂽWu
+	std::mutex m_sharedMutex;
+	std::deque<JobEntry*> m_sharedJobs;
+	std::mutex m_mainThreadMutex;
+	std::deque<JobEntry*> m_mainThreadJobs;
+
+	// Ă郏[J[N߂̏
+	std::mutex m_sleepMutex;
+	std::condition_variable m_sleepCondition;
+	std::atomic<int64_t> m_queuedJobs{ 0 };
+	std::atomic<unsigned int> m_sleepingWorkers{ 0 };
+	std::atomic<bool> m_stopping{ false };
+
+	void Start(const Options& options);
+	void Enqueue(JobEntry* entry);
+	void EnqueueMainThread(JobEntry* entry);
+	JobEntry* FindJob(int threadIndex);
+	bool RunMainThreadJob();
+	void Execute(JobEntry* entry);
+	void Finish(JobCounter* counter);
+	void WorkerLoop(int threadIndex);
+};
+}
+}
@@ -0,0 +1,982 @@
+#include "JpegDecoder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "Helpers.h"
+#include "JobSystem.h"
+
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	constexpr int kBlockSize = 64;
+	constexpr size_t kRgbaBytesPerPixel = 4;
+	constexpr int kMaxComponents = 3;
+
+	// WOUO k Ԗڂ̌W 8x8 ̂ǂɂ邩
+	constexpr uint8_t kZigzagToNatural[kBlockSize] = {
+		0, 1, 8, 16, 9, 2, 3, 10,
+		17, 24, 32, 25, 18, 11, 4, 5,
+		12, 19, 26, 33, 40, 48, 41, 34,
+		27, 20, 13, 6, 7, 14, 21, 28,
+		35, 42, 49, 56, 57, 50, 43, 36,
+		29, 22, 15, 23, 30, 37, 44, 51,
+		58, 59, 52, 45, 38, 31, 39, 46,
+		53, 60, 61, 54, 47, 55, 62, 63,
+	};
+
+	enum Marker : uint8_t {
+		kMarkerSof0 = 0xC0,
+		kMarkerSof1 = 0xC1,
+		kMarkerDht = 0xC4,
+		kMarkerRst0 = 0xD0,
+		kMarkerRst7 = 0xD7,
+		kMarkerSoi = 0xD8,
+		kMarkerEoi = 0xD9,
+		kMarkerSos = 0xDA,
+		kMarkerDqt = 0xDB,
+		kMarkerDri = 0xDD,
+		kMarkerApp0 = 0xE0,
+		kMarkerApp14 = 0xEE,
+	};
+
+	uint16_t ReadBigEndian16(const uint8_t* data)
+	{
+		return static_cast<uint16_t>((data[0] << 8) | data[1]);
+	}
+
+	// 擪 kFastBits rbgŌ܂镄͕\1ŕ
+	constexpr int kFastBits = 9;
+
+	struct HuffmanTable
+	{
+		// ( << 8) | lB0 Ȃ璷Ȃ̂1rbgׂ
+		uint16_t fast[1 << kFastBits];
+		uint8_t values[256];
+		// Ƃ̍ő̕(Ȃ -1)ƁA̒̍ŏ̒l̈ʒu - ŏ̕
+		int32_t maxCode[17];
+		int32_t valueOffset[17];
+		bool defined = false;
+	};
+
+	bool BuildHuffmanTable(const uint8_t* counts, const uint8_t* values, size_t valueCount, HuffmanTable& table)
+	{
+		std::memset(table.fast, 0, sizeof(table.fast));
+		std::memcpy(table.values, values, valueCount);
+		int32_t code = 0;
+		int32_t index = 0;
+		for (int length = 1; length <= 16; ++length) {
+			table.valueOffset[length] = index - code;
+			for (int i = 0; i < counts[length - 1]; ++i) {
+				if (length <= kFastBits) {
+					// ̃rbgłĂ̕ɂȂ
+					const int shift = kFastBits - length;
+					for (int suffix = 0; suffix < (1 << shift); ++suffix) {
+						table.fast[(code << shift) | suffix] = static_cast<uint16_t>((length << 8) | values[index]);
+					}
+				}
+				++code;
+				++index;
+			}
+			table.maxCode[length] = counts[length - 1] != 0 ? code - 1 : -1;
+			// ȂȂ(S 1 ̕o)\͉Ă
+			if (code > (1 << length)) {
+				return false;
+			}
+			code <<= 1;
+		}
+		table.defined = true;
+		return true;
+	}
+
+	// Ggs[ꂽf[^ǂށB0xFF 0x00  0xFF Ƃēǂ݁A
+	// ق̃}[J[ɓȍ~ 0 ǂ񂾂Ƃɂ
+	class BitReader
+	{
+	public:
+		BitReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+		uint32_t Peek(int count)
+		{
+			Fill();
+			return m_buffer >> (32 - count);
+		}
+
+		void Skip(int count)
+		{
+			m_buffer <<= count;
+			m_bitCount -= count;
+		}
+
+		uint32_t Read(int count)
+		{
+			const uint32_t bits = Peek(count);
+			Skip(count);
+			return bits;
+		}
+
+		// l͈̔͂̔ԍ size ƑrbgAt̒lɖ߂
+		int32_t ReceiveExtend(int size)
+		{
+			if (size == 0) {
+				return 0;
+			}
+			const int32_t bits = static_cast<int32_t>(Read(size));
+			return bits < (1 << (size - 1)) ? bits - (1 << size) + 1 : bits;
+		}
+
+		// Ă -1
+		int Decode(const HuffmanTable& table)
+		{
+			const uint16_t fast = table.fast[Peek(kFastBits)];
+			if (fast != 0) {
+				Skip(fast >> 8);
+				return fast & 0xFF;
+			}
+			const uint32_t bits = Peek(16);
+			for (int length = kFastBits + 1; length <= 16; ++length) {
+				const int32_t code = static_cast<int32_t>(bits >> (16 - length));
+				if (code <= table.maxCode[length]) {
+					Skip(length);
+					return table.values[table.valueOffset[length] + code];
+				}
+			}
+			return -1;
+		}
+
+	private:
+		const uint8_t* m_data;
+		size_t m_size;
+		size_t m_position = 0;
+		uint32_t m_buffer = 0;
+		int m_bitCount = 0;
+
+		void Fill()
+		{
+			while (m_bitCount <= 24) {
+				uint32_t byte = 0;
+				if (m_position < m_size) {
+					byte = m_data[m_position++];
+					if (byte == 0xFF) {
+						// Ԃ̏I̓}[J[̎OȂ̂ŁAɗ̂͋lߕ 0x00 
+						++m_position;
+					}
+				}
+				m_buffer |= byte << (24 - m_bitCount);
+				m_bitCount += 8;
+			}
+		}
+	};
+
+	struct Component
+	{
+		uint8_t id;
+		int horizontalSampling;
+		int verticalSampling;
+		int quantizationTable;
+		// kꂽƂ̑傫ƁAMCU ̒[܂Ŋ܂߂ubN
+		uint32_t width;
+		uint32_t height;
+		uint32_t blocksPerLine;
+		uint32_t blocksPerColumn;
+		std::vector<int16_t> coefficients;
+		// t DCT Ƃ̉fB1s blocksPerLine * 8 oCg
+		std::vector<uint8_t> plane;
+	};
+
+	// 1̃XLɊ܂܂鐬ƁAgnt}\
+	struct ScanComponent
+	{
+		Component* component;
+		const HuffmanTable* dcTable;
+		const HuffmanTable* acTable;
+	};
+
+	class JpegDecoder
+	{
+	public:
+		JpegDecoder(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+		// SOF ܂œǂő傫𒲂ׂ
+		bool ReadHeader();
+		bool Decode(uint8_t* destination, size_t rowPitch, JobSystem* jobSystem);
+
+		uint32_t Width() const { return m_width; }
+		uint32_t Height() const { return m_height; }
+
+	private:
+		const uint8_t* m_data;
+		size_t m_size;
+		size_t m_position = 0;
+
+		uint32_t m_width = 0;
+		uint32_t m_height = 0;
+		int m_maxHorizontalSampling = 1;
+		int m_maxVerticalSampling = 1;
+		uint32_t m_mcusPerLine = 0;
+		uint32_t m_mcusPerColumn = 0;
+		std::vector<Component> m_components;
+		uint16_t m_quantizationTables[4][kBlockSize] = {};
+		HuffmanTable m_dcTables[4];
+		HuffmanTable m_acTables[4];
+		uint32_t m_restartInterval = 0;
+		bool m_sawJfif = false;
+		bool m_sawAdobe = false;
+		uint8_t m_adobeTransform = 0;
+
+		// ̃}[J[Ƃ̃ZOg(2oCǧ)BSOIEEOIERST ̃ZOg͋
+		bool NextMarker(uint8_t& marker, const uint8_t*& segment, size_t& segmentSize);
+		bool ParseFrame(const uint8_t* segment, size_t size);
+		bool ParseQuantizationTables(const uint8_t* segment, size_t size);
+		bool ParseHuffmanTables(const uint8_t* segment, size_t size);
+		bool DecodeScan(const uint8_t* segment, size_t size, JobSystem* jobSystem);
+		bool DecodeInterval(
+			const std::vector<ScanComponent>& scanComponents,
+			const uint8_t* data,
+			size_t size,
+			uint32_t firstMcu,
+			uint32_t mcuCount
+		);
+		void InverseDctRows(uint32_t firstMcuRow, uint32_t lastMcuRow);
+		void ConvertRows(uint32_t firstRow, uint32_t lastRow, uint8_t* destination, size_t rowPitch) const;
+		bool IsRgb() const;
+	};
+
+	bool JpegDecoder::NextMarker(uint8_t& marker, const uint8_t*& segment, size_t& segmentSize)
+	{
+		// }[J[̑Oɗ] 0xFF łĂ悢
+		while (m_position < m_size && m_data[m_position] != 0xFF) {
+			++m_position;
+		}
+		while (m_position < m_size && m_data[m_position] == 0xFF) {
+			++m_position;
+		}
+		if (m_position >= m_size) {
+			return false;
+		}
+		marker = m_data[m_position++];
+		segment = m_data + m_position;
+		segmentSize = 0;
+		if (marker == kMarkerSoi || marker == kMarkerEoi || (marker >= kMarkerRst0 && marker <= kMarkerRst7)) {
+			return true;
+		}
+		if (m_position + 2 > m_size) {
+			return false;
+		}
+		const size_t length = ReadBigEndian16(m_data + m_position);
+		if (length < 2 || m_position + length > m_size) {
+			return false;
+		}
+		segment = m_data + m_position + 2;
+		segmentSize = length - 2;
+		m_position += length;
+		return true;
+	}
+
+	bool JpegDecoder::ReadHeader()
+	{
+		if (m_size < 4 || m_data[0] != 0xFF || m_data[1] != kMarkerSoi) {
+			return false;
+		}
+		m_position = 2;
+		uint8_t marker = 0;
+		const uint8_t* segment = nullptr;
+		size_t segmentSize = 0;
+		while (NextMarker(marker, segment, segmentSize)) {
+			switch (marker) {
+			case kMarkerSof0:
+			case kMarkerSof1:
+				return ParseFrame(segment, segmentSize);
+			case kMarkerDqt:
+				if (!ParseQuantizationTables(segment, segmentSize)) {
+					return false;
+				}
+				break;
+			case kMarkerDht:
+				if (!ParseHuffmanTables(segment, segmentSize)) {
+					return false;
+				}
+				break;
+			case kMarkerDri:
+				if (segmentSize < 2) {
+					return false;
+				}
+				m_restartInterval = ReadBigEndian16(segment);
+				break;
+			case kMarkerApp0:
+				m_sawJfif |= segmentSize >= 5 && std::memcmp(segment, "JFIF", 5) == 0;
+				break;
+			case kMarkerApp14:
+				if (segmentSize >= 12 && std::memcmp(segment, "Adobe", 5) == 0) {
+					m_sawAdobe = true;
+					m_adobeTransform = segment[11];
+				}
+				break;
+			default:
+				// ق SOF(vObVuEXXEZp)͓ǂ܂Ȃ
+				if (marker >= 0xC2 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+					DebugOutputFormatString("JpegDecoder : SOF 0x%x is not supported.\n", marker);
+					return false;
+				}
+				if (marker == kMarkerSos || marker == kMarkerEoi) {
+					return false;
+				}
+				break;
+			}
+		}
+		return false;
+	}
+
+	bool JpegDecoder::ParseFrame(const uint8_t* segment, size_t size)
+	{
+		if (size < 6 || segment[0] != 8) {
+			DebugOutputFormatString("JpegDecoder : only 8-bit samples are supported.\n");
+			return false;
+		}
+		m_height = ReadBigEndian16(segment + 1);
+		m_width = ReadBigEndian16(segment + 3);
+		const int componentCount = segment[5];
+		// CMYK(4)͓ǂ܂Ȃ
+		if (m_width == 0 || m_height == 0 || (componentCount != 1 && componentCount != 3) ||
+			size < 6 + static_cast<size_t>(componentCount) * 3) {
+			return false;
+		}
+
+		m_components.resize(componentCount);
+		for (int i = 0; i < componentCount; ++i) {
+			Component& component = m_components[i];
+			const uint8_t* field = segment + 6 + i * 3;
+			component.id = field[0];
+			component.horizontalSampling = field[1] >> 4;
+			component.verticalSampling = field[1] & 0x0F;
+			component.quantizationTable = field[2];
+			if (component.horizontalSampling < 1 || component.horizontalSampling > 4 ||
+				component.verticalSampling < 1 || component.verticalSampling > 4 ||
+				component.quantizationTable > 3) {
+				return false;
+			}
+			m_maxHorizontalSampling = (std::max)(m_maxHorizontalSampling, component.horizontalSampling);
+			m_maxVerticalSampling = (std::max)(m_maxVerticalSampling, component.verticalSampling);
+		}
+
+		const uint32_t mcuWidth = 8 * m_maxHorizontalSampling;
+		const uint32_t mcuHeight = 8 * m_maxVerticalSampling;
+		m_mcusPerLine = (m_width + mcuWidth - 1) / mcuWidth;
+		m_mcusPerColumn = (m_height + mcuHeight - 1) / mcuHeight;
+		for (Component& component : m_components) {
+			component.width = (m_width * component.horizontalSampling + m_maxHorizontalSampling - 1) / m_maxHorizontalSampling;
+			component.height = (m_height * component.verticalSampling + m_maxVerticalSampling - 1) / m_maxVerticalSampling;
+			component.blocksPerLine = m_mcusPerLine * component.horizontalSampling;
+			component.blocksPerColumn = m_mcusPerColumn * component.verticalSampling;
+		}
+		return true;
+	}
+
+	bool JpegDecoder::ParseQuantizationTables(const uint8_t* segment, size_t size)
+	{
+		size_t offset = 0;
+		while (offset < size) {
+			const int precision = segment[offset] >> 4;
+			const int index = segment[offset] & 0x0F;
+			const size_t tableSize = precision == 0 ? kBlockSize : kBlockSize * 2;
+			if (index > 3 || precision > 1 || offset + 1 + tableSize > size) {
+				return false;
+			}
+			const uint8_t* values = segment + offset + 1;
+			for (int k = 0; k < kBlockSize; ++k) {
+				m_quantizationTables[index][kZigzagToNatural[k]] = precision == 0 ? values[k] : ReadBigEndian16(values + k * 2);
+			}
+			offset += 1 + tableSize;
+		}
+		return true;
+	}
+
+	bool JpegDecoder::ParseHuffmanTables(const uint8_t* segment, size_t size)
+	{
+		size_t offset = 0;
+		while (offset < size) {
+			if (offset + 17 > size) {
+				return false;
+			}
+			const int tableClass = segment[offset] >> 4;
+			const int index = segment[offset] & 0x0F;
+			const uint8_t* counts = segment + offset + 1;
+			size_t valueCount = 0;
+			for (int i = 0; i < 16; ++i) {
+				valueCount += counts[i];
+			}
+			if (tableClass > 1 || index > 3 || valueCount > 256 || offset + 17 + valueCount > size) {
+				return false;
+			}
+			HuffmanTable& table = tableClass == 0 ? m_dcTables[index] : m_acTables[index];
+			if (!BuildHuffmanTable(counts, segment + offset + 17, valueCount, table)) {
+				return false;
+			}
+			offset += 17 + valueCount;
+		}
+		return true;
+	}
+
+	bool JpegDecoder::DecodeInterval(
+		const std::vector<ScanComponent>& scanComponents,
+		const uint8_t* data,
+		size_t size,
+		uint32_t firstMcu,
+		uint32_t mcuCount
+	) {
+		BitReader reader(data, size);
+		int32_t dcPredictions[kMaxComponents] = {};
+		// 1̃XĹAMCU ̒[܂߂̑傫̃ubNɕׂ
+		const bool interleaved = scanComponents.size() > 1;
+		const uint32_t mcusPerLine = interleaved ? m_mcusPerLine : (scanComponents[0].component->width + 7) / 8;
+
+		for (uint32_t mcu = firstMcu; mcu < firstMcu + mcuCount; ++mcu) {
+			const uint32_t mcuX = mcu % mcusPerLine;
+			const uint32_t mcuY = mcu / mcusPerLine;
+			for (size_t c = 0; c < scanComponents.size(); ++c) {
+				const ScanComponent& scanComponent = scanComponents[c];
+				Component& component = *scanComponent.component;
+				const int blocksX = interleaved ? component.horizontalSampling : 1;
+				const int blocksY = interleaved ? component.verticalSampling : 1;
+				for (int by = 0; by < blocksY; ++by) {
+					for (int bx = 0; bx < blocksX; ++bx) {
+						const uint32_t blockX = mcuX * blocksX + bx;
+						const uint32_t blockY = mcuY * blocksY + by;
+						int16_t* block = component.coefficients.data() +
+							(static_cast<size_t>(blockY) * component.blocksPerLine + blockX) * kBlockSize;
+
+						const int dcSize = reader.Decode(*scanComponent.dcTable);
+						if (dcSize < 0 || dcSize > 11) {
+							return false;
+						}
+						dcPredictions[c] += reader.ReceiveExtend(dcSize);
+						block[0] = static_cast<int16_t>(dcPredictions[c]);
+						for (int k = 1; k < kBlockSize;) {
+							const int runSize = reader.Decode(*scanComponent.acTable);
+							if (runSize < 0) {
+								return false;
+							}
+							const int run = runSize >> 4;
+							const int acSize = runSize & 0x0F;
+							if (acSize == 0) {
+								// EOB  16 0
+								if (run != 15) {
+									break;
+								}
+								k += 16;
+								continue;
+							}
+							k += run;
+							if (k >= kBlockSize) {
+								return false;
+							}
+							block[kZigzagToNatural[k]] = static_cast<int16_t>(reader.ReceiveExtend(acSize));
+							++k;
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	bool JpegDecoder::DecodeScan(const uint8_t* segment, size_t size, JobSystem* jobSystem)
+	{
+		if (size < 1) {
+			return false;
+		}
+		const size_t componentCount = segment[0];
+		if (componentCount < 1 || componentCount > m_components.size() || size < 1 + componentCount * 2 + 3) {
+			return false;
+		}
+		std::vector<ScanComponent> scanComponents;
+		for (size_t i = 0; i < componentCount; ++i) {
+			const uint8_t id = segment[1 + i * 2];
+			const int dcIndex = segment[2 + i * 2] >> 4;
+			const int acIndex = segment[2 + i * 2] & 0x0F;
+			auto component = std::find_if(m_components.begin(), m_components.end(), [id](const Component& c) { return c.id == id; });
+			if (component == m_components.end() || dcIndex > 3 || acIndex > 3 ||
+				!m_dcTables[dcIndex].defined || !m_acTables[acIndex].defined) {
+				return false;
+			}
+			scanComponents.push_back({ &*component, &m_dcTables[dcIndex], &m_acTables[acIndex] });
+		}
+
+		const uint32_t mcuCount = componentCount > 1 ?
+			m_mcusPerLine * m_mcusPerColumn :
+			((scanComponents[0].component->width + 7) / 8) * ((scanComponents[0].component->height + 7) / 8);
+
+		// Ggs[ꂽf[^AX^[g}[J[ŋԂɕB
+		// Ԃǂ DC ̗\܂߂ēƗĂ̂ŁAʁX̃Xbhŕł
+		struct Interval
+		{
+			size_t begin;
+			size_t end;
+		};
+		std::vector<Interval> intervals;
+		size_t begin = m_position;
+		size_t position = m_position;
+		while (true) {
+			const uint8_t* found = static_cast<const uint8_t*>(std::memchr(m_data + position, 0xFF, m_size - position));
+			if (found == nullptr || found + 1 >= m_data + m_size) {
+				return false;
+			}
+			position = found - m_data;
+			if (m_data[position + 1] == 0x00) {
+				position += 2;
+				continue;
+			}
+			// }[J[̑Oɂ͋lߕ 0xFF ł邱Ƃ
+			const size_t markerBegin = position;
+			while (position + 1 < m_size && m_data[position + 1] == 0xFF) {
+				++position;
+			}
+			if (position + 1 >= m_size) {
+				return false;
+			}
+			const uint8_t next = m_data[position + 1];
+			intervals.push_back({ begin, markerBegin });
+			if (next < kMarkerRst0 || next > kMarkerRst7) {
+				break;
+			}
+			position += 2;
+			begin = position;
+		}
+		m_position = position;
+
+		const uint32_t expectedIntervals = m_restartInterval == 0 ? 1 : (mcuCount + m_restartInterval - 1) / m_restartInterval;
+		if (intervals.size() != expectedIntervals) {
+			DebugOutputFormatString("JpegDecoder : expected %u restart intervals but found %zu.\n", expectedIntervals, intervals.size());
+			return false;
+		}
+		const uint32_t mcusPerInterval = m_restartInterval == 0 ? mcuCount : m_restartInterval;
+		const auto decodeInterval = [&](size_t i) {
+			const uint32_t firstMcu = static_cast<uint32_t>(i) * mcusPerInterval;
+			return DecodeInterval(
+				scanComponents,
+				m_data + intervals[i].begin,
+				intervals[i].end - intervals[i].begin,
+				firstMcu,
+				(std::min)(mcusPerInterval, mcuCount - firstMcu)
+			);
+		};
+
+		if (jobSystem == nullptr || intervals.size() == 1) {
+			for (size_t i = 0; i < intervals.size(); ++i) {
+				if (!decodeInterval(i)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		std::atomic<bool> succeeded(true);
+		jobSystem->ParallelFor(intervals.size(), 1, [&](size_t first, size_t last) {
+			for (size_t i = first; i < last; ++i) {
+				if (!decodeInterval(i)) {
+					succeeded = false;
+				}
+			}
+		});
+		return succeeded;
+	}
+
+	// libjpeg  jidctint.c(JDCT_ISLOW)Ɠ̋t DCTB
+	// 13bit ̌Œ菬_ŁA1pX()̌ʂ 2bit ]Ɏ
+	constexpr int kConstBits = 13;
+	constexpr int kPass1Bits = 2;
+	constexpr int32_t kFix0_298631336 = 2446;
+	constexpr int32_t kFix0_390180644 = 3196;
+	constexpr int32_t kFix0_541196100 = 4433;
+	constexpr int32_t kFix0_765366865 = 6270;
+	constexpr int32_t kFix0_899976223 = 7373;
+	constexpr int32_t kFix1_175875602 = 9633;
+	constexpr int32_t kFix1_501321110 = 12299;
+	constexpr int32_t kFix1_847759065 = 15137;
+	constexpr int32_t kFix1_961570560 = 16069;
+	constexpr int32_t kFix2_053119869 = 16819;
+	constexpr int32_t kFix2_562915447 = 20995;
+	constexpr int32_t kFix3_072711026 = 25172;
+
+	int32_t Descale(int64_t value, int bits)
+	{
+		return static_cast<int32_t>((value + (int64_t(1) << (bits - 1))) >> bits);
+	}
+
+	uint8_t ClampToByte(int32_t value)
+	{
+		return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+	}
+
+	// Ԗ(0, 2, 4, 6)ƊԖ(1, 3, 5, 7)̓͂A8_̏o͂̑OE㔼B
+	// ꂽf[^łťӂꂪNȂ悤 64bit ŌvZ
+	struct IdctOutputs
+	{
+		int64_t tmp10, tmp11, tmp12, tmp13;
+		int64_t tmp0, tmp1, tmp2, tmp3;
+	};
+
+	IdctOutputs Idct8(int64_t in0, int64_t in1, int64_t in2, int64_t in3, int64_t in4, int64_t in5, int64_t in6, int64_t in7)
+	{
+		IdctOutputs out;
+		// 
+		int64_t z2 = in2;
+		int64_t z3 = in6;
+		int64_t z1 = (z2 + z3) * kFix0_541196100;
+		int64_t tmp2 = z1 + z3 * -kFix1_847759065;
+		int64_t tmp3 = z1 + z2 * kFix0_765366865;
+		int64_t tmp0 = (in0 + in4) * (1 << kConstBits);
+		int64_t tmp1 = (in0 - in4) * (1 << kConstBits);
+		out.tmp10 = tmp0 + tmp3;
+		out.tmp13 = tmp0 - tmp3;
+		out.tmp11 = tmp1 + tmp2;
+		out.tmp12 = tmp1 - tmp2;
+
+		// 
+		tmp0 = in7;
+		tmp1 = in5;
+		tmp2 = in3;
+		tmp3 = in1;
+		z1 = tmp0 + tmp3;
+		z2 = tmp1 + tmp2;
+		z3 = tmp0 + tmp2;
+		int64_t z4 = tmp1 + tmp3;
+		const int64_t z5 = (z3 + z4) * kFix1_175875602;
+		tmp0 *= kFix0_298631336;
+		tmp1 *= kFix2_053119869;
+		tmp2 *= kFix3_072711026;
+		tmp3 *= kFix1_501321110;
+		z1 *= -kFix0_899976223;
+		z2 *= -kFix2_562915447;
+		z3 *= -kFix1_961570560;
+		z4 *= -kFix0_390180644;
+		z3 += z5;
+		z4 += z5;
+		out.tmp0 = tmp0 + z1 + z3;
+		out.tmp1 = tmp1 + z2 + z4;
+		out.tmp2 = tmp2 + z2 + z3;
+		out.tmp3 = tmp3 + z1 + z4;
+		return out;
+	}
+
+	void InverseDct(const int16_t* coefficients, const uint16_t* quantization, uint8_t* output, size_t outputPitch)
+	{
+		int32_t workspace[kBlockSize];
+		// 1pX: 񂲂
+		for (int x = 0; x < 8; ++x) {
+			const auto in = [&](int y) { return static_cast<int64_t>(coefficients[y * 8 + x]) * quantization[y * 8 + x]; };
+			int32_t* column = workspace + x;
+			if (coefficients[8 + x] == 0 && coefficients[16 + x] == 0 && coefficients[24 + x] == 0 && coefficients[32 + x] == 0 &&
+				coefficients[40 + x] == 0 && coefficients[48 + x] == 0 && coefficients[56 + x] == 0) {
+				// AC S 0 Ȃ͓lɂȂ
+				const int32_t dc = static_cast<int32_t>(in(0) * (1 << kPass1Bits));
+				for (int y = 0; y < 8; ++y) {
+					column[y * 8] = dc;
+				}
+				continue;
+			}
+			const IdctOutputs o = Idct8(in(0), in(1), in(2), in(3), in(4), in(5), in(6), in(7));
+			constexpr int kBits = kConstBits - kPass1Bits;
+			column[0] = Descale(o.tmp10 + o.tmp3, kBits);
+			column[56] = Descale(o.tmp10 - o.tmp3, kBits);
+			column[8] = Descale(o.tmp11 + o.tmp2, kBits);
+			column[48] = Descale(o.tmp11 - o.tmp2, kBits);
+			column[16] = Descale(o.tmp12 + o.tmp1, kBits);
+			column[40] = Descale(o.tmp12 - o.tmp1, kBits);
+			column[24] = Descale(o.tmp13 + o.tmp0, kBits);
+			column[32] = Descale(o.tmp13 - o.tmp0, kBits);
+		}
+
+		// 2pX: sƁB128 𑫂 0`255 Ɏ߂
+		for (int y = 0; y < 8; ++y) {
+			const int32_t* row = workspace + y * 8;
+			uint8_t* out = output + y * outputPitch;
+			constexpr int kBits = kConstBits + kPass1Bits + 3;
+			if (row[1] == 0 && row[2] == 0 && row[3] == 0 && row[4] == 0 && row[5] == 0 && row[6] == 0 && row[7] == 0) {
+				const uint8_t value = ClampToByte(Descale(row[0], kPass1Bits + 3) + 128);
+				std::memset(out, value, 8);
+				continue;
+			}
+			const IdctOutputs o = Idct8(row[0], row[1], row[2], row[3], row[4], row[5], row[6], row[7]);
+			out[0] = ClampToByte(Descale(o.tmp10 + o.tmp3, kBits) + 128);
+			out[7] = ClampToByte(Descale(o.tmp10 - o.tmp3, kBits) + 128);
+			out[1] = ClampToByte(Descale(o.tmp11 + o.tmp2, kBits) + 128);
+			out[6] = ClampToByte(Descale(o.tmp11 - o.tmp2, kBits) + 128);
+			out[2] = ClampToByte(Descale(o.tmp12 + o.tmp1, kBits) + 128);
+			out[5] = ClampToByte(Descale(o.tmp12 - o.tmp1, kBits) + 128);
+			out[3] = ClampToByte(Descale(o.tmp13 + o.tmp0, kBits) + 128);
+			out[4] = ClampToByte(Descale(o.tmp13 - o.tmp0, kBits) + 128);
+		}
+	}
+
+	void JpegDecoder::InverseDctRows(uint32_t firstMcuRow, uint32_t lastMcuRow)
+	{
+		for (Component& component : m_components) {
+			const uint16_t* quantization = m_quantizationTables[component.quantizationTable];
+			const size_t planePitch = static_cast<size_t>(component.blocksPerLine) * 8;
+			for (uint32_t blockY = firstMcuRow * component.verticalSampling; blockY < lastMcuRow * component.verticalSampling; ++blockY) {
+				for (uint32_t blockX = 0; blockX < component.blocksPerLine; ++blockX) {
+					const size_t block = static_cast<size_t>(blockY) * component.blocksPerLine + blockX;
+					InverseDct(
+						component.coefficients.data() + block * kBlockSize,
+						quantization,
+						component.plane.data() + blockY * 8 * planePitch + blockX * 8,
+						planePitch
+					);
+				}
+			}
+		}
+	}
+
+	// kꂽ1sA摜̕ɈL΂Boutput ɂ width + 1 oCgƂB
+	//  2{Ec 1{ / 2{Ɖ 1{Ec 2{ libjpeg  fancy upsampling(ׂƂ 3:1 ̐`)A
+	// ȊO͓lׂBsums ͐̍̕̕Ɨ̈
+	void UpsampleRow(
+		const Component& component,
+		int horizontalScale,
+		int verticalScale,
+		uint32_t y,
+		uint32_t width,
+		int32_t* sums,
+		uint8_t* output
+	) {
+		const size_t planePitch = static_cast<size_t>(component.blocksPerLine) * 8;
+		const uint32_t sourceY = y / verticalScale;
+		const uint8_t* row = component.plane.data() + sourceY * planePitch;
+		const uint32_t sourceWidth = component.width;
+
+		if (horizontalScale == 1 && verticalScale == 1) {
+			std::memcpy(output, row, width);
+			return;
+		}
+		// 㔼̍s1A̍s1̍s 3:1 ōB摜̒[̍s͌JԂ
+		const auto neighborRow = [&]() {
+			const int64_t neighborY = y % 2 == 0 ? static_cast<int64_t>(sourceY) - 1 : static_cast<int64_t>(sourceY) + 1;
+			const uint32_t clampedY = static_cast<uint32_t>((std::min)((std::max)(neighborY, int64_t(0)), int64_t(component.height - 1)));
+			return component.plane.data() + clampedY * planePitch;
+		};
+		if (horizontalScale == 1 && verticalScale == 2) {
+			const uint8_t* neighbor = neighborRow();
+			const int32_t bias = y % 2 == 0 ? 1 : 2;
+			for (uint32_t x = 0; x < width; ++x) {
+				output[x] = static_cast<uint8_t>((row[x] * 3 + neighbor[x] + bias) >> 2);
+			}
+			return;
+		}
+		// libjpeg ƓA 2 ȉȂԂȂ
+		if (horizontalScale != 2 || verticalScale > 2 || sourceWidth <= 2) {
+			for (uint32_t x = 0; x < width; ++x) {
+				output[x] = row[x / horizontalScale];
+			}
+			return;
+		}
+
+		if (verticalScale == 2) {
+			const uint8_t* neighbor = neighborRow();
+			for (uint32_t x = 0; x < sourceWidth; ++x) {
+				sums[x] = row[x] * 3 + neighbor[x];
+			}
+		} else {
+			for (uint32_t x = 0; x < sourceWidth; ++x) {
+				sums[x] = row[x];
+			}
+		}
+
+		// cɍƂ͘a 4{ɂȂĂ̂ŁAۂ߂ƃVtgς
+		const bool vertical = verticalScale == 2;
+		const int shift = vertical ? 4 : 2;
+		const int32_t evenBias = vertical ? 8 : 1;
+		const int32_t oddBias = vertical ? 7 : 2;
+		const uint32_t last = sourceWidth - 1;
+		output[0] = static_cast<uint8_t>(vertical ? (sums[0] * 4 + evenBias) >> shift : sums[0]);
+		output[1] = static_cast<uint8_t>((sums[0] * 3 + sums[1] + oddBias) >> shift);
+		for (uint32_t x = 1; x < last; ++x) {
+			output[x * 2] = static_cast<uint8_t>((sums[x] * 3 + sums[x - 1] + evenBias) >> shift);
+			output[x * 2 + 1] = static_cast<uint8_t>((sums[x] * 3 + sums[x + 1] + oddBias) >> shift);
+		}
+		output[last * 2] = static_cast<uint8_t>((sums[last] * 3 + sums[last - 1] + evenBias) >> shift);
+		output[last * 2 + 1] = static_cast<uint8_t>(vertical ? (sums[last] * 4 + oddBias) >> shift : sums[last]);
+	}
+
+	// libjpeg  jdcolor.c Ɠ 16bit Œ菬_ YCbCr  RGB
+	constexpr int kColorScaleBits = 16;
+	constexpr int32_t kColorHalf = 1 << (kColorScaleBits - 1);
+
+	constexpr int32_t FixColor(double value)
+	{
+		return static_cast<int32_t>(value * (1 << kColorScaleBits) + 0.5);
+	}
+
+	void JpegDecoder::ConvertRows(uint32_t firstRow, uint32_t lastRow, uint8_t* destination, size_t rowPitch) const
+	{
+		const size_t componentCount = m_components.size();
+		// Ƃ1sBL΂1oCg͂ݏoƂ
+		const size_t rowStride = static_cast<size_t>(m_width) + 1;
+		std::vector<uint8_t> rows(rowStride * componentCount);
+		std::vector<int32_t> sums(m_width);
+		const bool rgb = IsRgb();
+		for (uint32_t y = firstRow; y < lastRow; ++y) {
+			for (size_t c = 0; c < componentCount; ++c) {
+				const Component& component = m_components[c];
+				UpsampleRow(
+					component,
+					m_maxHorizontalSampling / component.horizontalSampling,
+					m_maxVerticalSampling / component.verticalSampling,
+					y,
+					m_width,
+					sums.data(),
+					rows.data() + c * rowStride
+				);
+			}
+
+			uint8_t* out = destination + y * rowPitch;
+			if (componentCount == 1) {
+				for (uint32_t x = 0; x < m_width; ++x) {
+					out[x * 4 + 0] = out[x * 4 + 1] = out[x * 4 + 2] = rows[x];
+					out[x * 4 + 3] = 255;
+				}
+				continue;
+			}
+			const uint8_t* c0 = rows.data();
+			const uint8_t* c1 = c0 + rowStride;
+			const uint8_t* c2 = c1 + rowStride;
+			if (rgb) {
+				for (uint32_t x = 0; x < m_width; ++x) {
+					out[x * 4 + 0] = c0[x];
+					out[x * 4 + 1] = c1[x];
+					out[x * 4 + 2] = c2[x];
+					out[x * 4 + 3] = 255;
+				}
+				continue;
+			}
+			for (uint32_t x = 0; x < m_width; ++x) {
+				const int32_t luma = c0[x];
+				const int32_t cb = c1[x] - 128;
+				const int32_t cr = c2[x] - 128;
+				const int32_t red = luma + ((FixColor(1.40200) * cr + kColorHalf) >> kColorScaleBits);
+				const int32_t green = luma + ((-FixColor(0.34414) * cb + kColorHalf - FixColor(0.71414) * cr) >> kColorScaleBits);
+				const int32_t blue = luma + ((FixColor(1.77200) * cb + kColorHalf) >> kColorScaleBits);
+				out[x * 4 + 0] = ClampToByte(red);
+				out[x * 4 + 1] = ClampToByte(green);
+				out[x * 4 + 2] = ClampToByte(blue);
+				out[x * 4 + 3] = 255;
+			}
+		}
+	}
+
+	// libjpeg ƓAJFIF Ȃ YCbCrAAdobe ̃}[J[΂̎wAȂΐ ID  'R' 'G' 'B' Ȃ RGB
+	bool JpegDecoder::IsRgb() const
+	{
+		if (m_components.size() != 3 || m_sawJfif) {
+			return false;
+		}
+		if (m_sawAdobe) {
+			return m_adobeTransform == 0;
+		}
+		return m_components[0].id == 'R' && m_components[1].id == 'G' && m_components[2].id == 'B';
+	}
+
+	bool JpegDecoder::Decode(uint8_t* destination, size_t rowPitch, JobSystem* jobSystem)
+	{
+		for (Component& component : m_components) {
+			const size_t blockCount = static_cast<size_t>(component.blocksPerLine) * component.blocksPerColumn;
+			component.coefficients.assign(blockCount * kBlockSize, 0);
+			component.plane.resize(blockCount * kBlockSize);
+		}
+
+		// SOF ̌납AXLɕ(x[XCłƂɕʂ̃XLɂȂĂ邱Ƃ)
+		uint8_t marker = 0;
+		const uint8_t* segment = nullptr;
+		size_t segmentSize = 0;
+		bool decodedScan = false;
+		while (NextMarker(marker, segment, segmentSize)) {
+			if (marker == kMarkerEoi) {
+				break;
+			}
+			bool succeeded = true;
+			switch (marker) {
+			case kMarkerSos:
+				succeeded = DecodeScan(segment, segmentSize, jobSystem);
+				decodedScan = true;
+				break;
+			case kMarkerDht:
+				succeeded = ParseHuffmanTables(segment, segmentSize);
+				break;
+			case kMarkerDqt:
+				succeeded = ParseQuantizationTables(segment, segmentSize);
+				break;
+			case kMarkerDri:
+				succeeded = segmentSize >= 2;
+				m_restartInterval = succeeded ? ReadBigEndian16(segment) : 0;
+				break;
+			default:
+				break;
+			}
+			if (!succeeded) {
+				DebugOutputFormatString("JpegDecoder : failed to decode marker 0x%x.\n", marker);
+				return false;
+			}
+		}
+		if (!decodedScan) {
+			return false;
+		}
+
+		//  MCU ̍sƂɓƗĂB
+		// cɏk̈L΂ׂ͗̍sǂނ̂ŁAt DCT SIĂFϊ
+		const uint32_t mcuHeight = 8 * m_maxVerticalSampling;
+		const auto convertRows = [&](size_t first, size_t last) {
+			ConvertRows(
+				static_cast<uint32_t>(first) * mcuHeight,
+				(std::min)(static_cast<uint32_t>(last) * mcuHeight, m_height),
+				destination,
+				rowPitch
+			);
+		};
+		if (jobSystem == nullptr) {
+			InverseDctRows(0, m_mcusPerColumn);
+			convertRows(0, m_mcusPerColumn);
+			return true;
+		}
+		jobSystem->ParallelFor(m_mcusPerColumn, 1, [this](size_t first, size_t last) {
+			InverseDctRows(static_cast<uint32_t>(first), static_cast<uint32_t>(last));
+		});
+		jobSystem->ParallelFor(m_mcusPerColumn, 1, convertRows);
+		return true;
+	}
+}
+
+bool ReadJpegInfo(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height)
+{
+	JpegDecoder decoder(data, size);
+	if (!decoder.ReadHeader()) {
+		return false;
+	}
+	width = decoder.Width();
+	height = decoder.Height();
+	return true;
+}
+
+bool DecodeJpeg(
+	const uint8_t* data,
+	size_t size,
+	uint8_t* destination,
+	size_t rowPitch,
+	size_t destinationSize,
+	JobSystem* jobSystem
+) {
+	JpegDecoder decoder(data, size);
+	if (!decoder.ReadHeader()) {
+		return false;
+	}
+	const size_t rowSize = static_cast<size_t>(decoder.Width()) * kRgbaBytesPerPixel;
+	if (rowPitch < rowSize || destinationSize < rowPitch * (decoder.Height() - 1) + rowSize) {
+		DebugOutputFormatString("DecodeJpeg destination is too small.\n");
+		return false;
+	}
+	return decoder.Decode(destination, rowPitch, jobSystem);
+}
+}
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace yuxx {
+namespace DirectX12 {
+class JobSystem;
+
+// x[XC(nt}E8bit) JPEG ǂށBvObVuZp false Ԃ
+bool ReadJpegInfo(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height);
+
+// RGBA e8bit  destination ɃfR[hBjobSystem nƂ
+// X^[g}[J[΋ԂƂɃnt}ɍsA
+// Ȃ΃nt}1XbhōsĂAt DCT ƐFϊ MCU ̍sƂɕɍs
+bool DecodeJpeg(
+	const uint8_t* data,
+	size_t size,
+	uint8_t* destination,
+	size_t rowPitch,
+	size_t destinationSize,
+	JobSystem* jobSystem = nullptr
+);
+}
+}
@@ -0,0 +1,549 @@
+#include "NullCommandRecorder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "DxbcReflection.h"
+#include "RootSignatureDescription.h"
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// DXGI_FORMAT_R16_UINT, DXGI_FORMAT_R32_UINT
+	constexpr uint32_t kIndexFormatR16Uint = 57;
+	constexpr uint32_t kIndexFormatR32Uint = 42;
+
+	uint32_t IndexSize(uint32_t format)
+	{
+		switch (format) {
+		case kIndexFormatR16Uint:
+			return 2;
+		case kIndexFormatR32Uint:
+			return 4;
+		default:
+			return 0;
+		}
+	}
+}
+
+uint64_t NullCommandRecorder::TotalCalls() const
+{
+	uint64_t calls = 0;
+	for (const CallStats& stats : m_stats) {
+		calls += stats.count;
+	}
+	return calls;
+}
+
+uint64_t NullCommandRecorder::TotalBytes() const
+{
+	uint64_t bytes = 0;
+	for (const CallStats& stats : m_stats) {
+		bytes += stats.bytes;
+	}
+	return bytes;
+}
+
+void NullCommandRecorder::ResetStats()
+{
+	m_stats = {};
+	m_errorCount = 0;
+	m_errors.clear();
+}
+
+void NullCommandRecorder::SetRenderTargetSize(uint32_t width, uint32_t height)
+{
+	m_hasRenderTargetSize = true;
+	m_renderTargetWidth = width;
+	m_renderTargetHeight = height;
+}
+
+void NullCommandRecorder::Finish()
+{
+	if (m_validate && m_inFrame) {
+		Error("Finish: frame was not ended");
+	}
+}
+
+void NullCommandRecorder::Count(CaptureCommand command, uint64_t bytes)
+{
+	CallStats& stats = m_stats[static_cast<size_t>(command)];
+	++stats.count;
+	stats.bytes += bytes;
+}
+
+void NullCommandRecorder::Error(const std::string& message)
+{
+	++m_errorCount;
+	if (m_errors.size() < kMaxStoredErrors) {
+		m_errors.push_back(message);
+	}
+}
+
+bool NullCommandRecorder::CreateObject(RecorderObjectId id, ObjectKind kind, const char* call)
+{
+	if (id == kInvalidRecorderObject) {
+		Error(std::string(call) + ": id 0 is reserved");
+		return false;
+	}
+	const auto inserted = m_objects.emplace(id, kind);
+	// ԍEނł2ڂ͉Ȃ(CommandRecorder ̌܂)
+	if (!inserted.second && inserted.first->second != kind) {
+		Error(std::string(call) + ": id " + std::to_string(id) + " is already used by another kind of object");
+		return false;
+	}
+	return true;
+}
+
+void NullCommandRecorder::RequireObject(RecorderObjectId id, ObjectKind kind, const char* call)
+{
+	const auto found = m_objects.find(id);
+	if (found == m_objects.end() || found->second != kind) {
+		Error(std::string(call) + ": unknown object " + std::to_string(id));
+	}
+}
+
+void NullCommandRecorder::RequireFrame(const char* call)
+{
+	if (!m_inFrame) {
+		Error(std::string(call) + ": called outside BeginFrame/EndFrame");
+	}
+}
+
+bool NullCommandRecorder::CreateBuffer(RecorderObjectId id, uint64_t size)
+{
+	Count(CaptureCommand::CreateBuffer, sizeof(id) + sizeof(size));
+	if (m_validate) {
+		if (!CreateObject(id, kBufferObject, "CreateBuffer")) {
+			return false;
+		}
+		if (size == 0) {
+			Error("CreateBuffer: size is 0");
+			return false;
+		}
+		m_buffers[id] = { size };
+	}
+	return true;
+}
+
+bool NullCommandRecorder::CreateTexture(RecorderObjectId id, const RecorderTextureDescription& description)
+{
+	Count(CaptureCommand::CreateTexture, sizeof(id) + sizeof(description));
+	if (m_validate) {
+		if (!CreateObject(id, kTextureObject, "CreateTexture")) {
+			return false;
+		}
+		if (description.width == 0 || description.height == 0) {
+			Error("CreateTexture: empty texture");
+			return false;
+		}
+	}
+	return true;
+}
+
+bool NullCommandRecorder::UploadResource(RecorderObjectId id, const void* data, size_t size, uint32_t rowPitch)
+{
+	Count(CaptureCommand::UploadResource, sizeof(id) + sizeof(rowPitch) + size);
+	if (m_validate) {
+		const auto found = m_objects.find(id);
+		if (found == m_objects.end() || (found->second != kBufferObject && found->second != kTextureObject)) {
+			Error("UploadResource: unknown resource " + std::to_string(id));
+			return false;
+		}
+		if (data == nullptr && size != 0) {
+			Error("UploadResource: data is null");
+			return false;
+		}
+		const auto buffer = m_buffers.find(id);
+		if (buffer != m_buffers.end() && size > buffer->second.size) {
+			Error("UploadResource: " + std::to_string(size) + " bytes do not fit in buffer " + std::to_string(id));
+			return false;
+		}
+	}
+	return true;
+}
+
+bool NullCommandRecorder::CreateRootSignature(RecorderObjectId id, const void* serialized, size_t size)
+{
+	Count(CaptureCommand::CreateRootSignature, sizeof(id) + size);
+	if (m_validate) {
+		if (!CreateObject(id, kRootSignatureObject, "CreateRootSignature")) {
+			return false;
+		}
+		if (serialized == nullptr || size == 0) {
+			Error("CreateRootSignature: empty blob");
+			return false;
+		}
+		std::vector<uint32_t> parameterTypes;
+		if (!ParseRootSignatureParameters(serialized, size, parameterTypes)) {
+			Error("CreateRootSignature: not a serialized root signature");
+			return false;
+		}
+		m_rootParameterTypes[id] = std::move(parameterTypes);
+	}
+	return true;
+}
+
+bool NullCommandRecorder::CreatePipelineState(RecorderObjectId id, const RecorderPipelineDescription& description)
+{
+	uint64_t bytes = sizeof(id) + sizeof(description.rootSignature) + description.vertexShader.size() +
+		description.pixelShader.size() + sizeof(description.renderTargetFormat) + sizeof(description.primitiveTopologyType) +
+		sizeof(description.blendMode) + sizeof(description.depthStencilFormat) + sizeof(description.depthMode);
+	for (const RecorderInputElement& element : description.inputLayout) {
+		bytes += element.semanticName.size() + sizeof(element.semanticIndex) + sizeof(element.format);
+	}
+	Count(CaptureCommand::CreatePipelineState, bytes);
+	if (m_validate) {
+		if (!CreateObject(id, kPipelineStateObject, "CreatePipelineState")) {
+			return false;
+		}
+		RequireObject(description.rootSignature, kRootSignatureObject, "CreatePipelineState");
+		if (description.vertexShader.empty()) {
+			Error("CreatePipelineState: no vertex shader");
+			return false;
+		}
+		if (description.blendMode > kBlendColorWriteDisabled) {
+			Error("CreatePipelineState: unknown blend mode " + std::to_string(description.blendMode));
+			return false;
+		}
+		if (description.depthMode > kDepthTestOnly) {
+			Error("CreatePipelineState: unknown depth mode " + std::to_string(description.depthMode));
+			return false;
+		}
+		if (description.depthMode != kDepthDisabled && description.depthStencilFormat == 0) {
+			Error("CreatePipelineState: depth is used without a depth format");
+			return false;
+		}
+	}
+	return true;
+}
+
+void NullCommandRecorder::BeginFrame()
+{
+	Count(CaptureCommand::BeginFrame, 0);
+	if (m_validate) {
+		if (m_inFrame) {
+			Error("BeginFrame: previous frame was not ended");
+		}
+		if (m_hasRenderTargetSize && (m_renderTargetWidth == 0 || m_renderTargetHeight == 0)) {
+			Error("BeginFrame: no render target");
+		}
+		// t[܂Őݒ͈pȂ
+		m_inFrame = true;
+		m_pipelineState = kInvalidRecorderObject;
+		m_rootSignature = kInvalidRecorderObject;
+		m_viewportSet = false;
+		m_scissorSet = false;
+		m_topologySet = false;
+		m_vertexBufferSet = false;
+		m_indexCount = 0;
+	}
+}
+
+void NullCommandRecorder::ClearRenderTarget(const float color[4])
+{
+	Count(CaptureCommand::ClearRenderTarget, sizeof(float) * 4);
+	if (m_validate) {
+		RequireFrame("ClearRenderTarget");
+		if (color == nullptr) {
+			Error("ClearRenderTarget: color is null");
+		}
+	}
+}
+
+void NullCommandRecorder::ClearDepth(float depth)
+{
+	Count(CaptureCommand::ClearDepth, sizeof(depth));
+	if (m_validate) {
+		RequireFrame("ClearDepth");
+	}
+}
+
+void NullCommandRecorder::SetPipelineState(RecorderObjectId pipelineState)
+{
+	Count(CaptureCommand::SetPipelineState, sizeof(pipelineState));
+	if (m_validate) {
+		RequireFrame("SetPipelineState");
+		RequireObject(pipelineState, kPipelineStateObject, "SetPipelineState");
+		m_pipelineState = pipelineState;
+	}
+}
+
+void NullCommandRecorder::SetGraphicsRootSignature(RecorderObjectId rootSignature)
+{
+	Count(CaptureCommand::SetGraphicsRootSignature, sizeof(rootSignature));
+	if (m_validate) {
+		RequireFrame("SetGraphicsRootSignature");
+		RequireObject(rootSignature, kRootSignatureObject, "SetGraphicsRootSignature");
+		m_rootSignature = rootSignature;
+	}
+}
+
+void NullCommandRecorder::SetViewport(const RecorderViewport& viewport)
+{
+	Count(CaptureCommand::SetViewport, sizeof(viewport));
+	if (m_validate) {
+		RequireFrame("SetViewport");
+		if (viewport.width <= 0.0f || viewport.height <= 0.0f || viewport.minDepth > viewport.maxDepth) {
+			Error("SetViewport: invalid viewport");
+		}
+		if (m_hasRenderTargetSize && (
+			viewport.topLeftX < 0.0f || viewport.topLeftY < 0.0f ||
+			viewport.topLeftX + viewport.width > m_renderTargetWidth ||
+			viewport.topLeftY + viewport.height > m_renderTargetHeight)) {
+			Error("SetViewport: outside the render target");
+		}
+		m_viewportSet = true;
+	}
+}
+
+void NullCommandRecorder::SetScissorRect(const RecorderRect& rect)
+{
+	Count(CaptureCommand::SetScissorRect, sizeof(rect));
+	if (m_validate) {
+		RequireFrame("SetScissorRect");
+		if (rect.right < rect.left || rect.bottom < rect.top) {
+			Error("SetScissorRect: inverted rectangle");
+		}
+		if (m_hasRenderTargetSize && (
+			rect.left < 0 || rect.top < 0 ||
+			static_cast<int64_t>(rect.right) > m_renderTargetWidth ||
+			static_cast<int64_t>(rect.bottom) > m_renderTargetHeight)) {
+			Error("SetScissorRect: outside the render target");
+		}
+		m_scissorSet = true;
+	}
+}
+
+void NullCommandRecorder::SetGraphicsRootTexture(uint32_t rootParameterIndex, RecorderObjectId texture)
+{
+	Count(CaptureCommand::SetGraphicsRootTexture, sizeof(rootParameterIndex) + sizeof(texture));
+	if (m_validate) {
+		RequireFrame("SetGraphicsRootTexture");
+		RequireObject(texture, kTextureObject, "SetGraphicsRootTexture");
+		const auto parameterTypes = m_rootParameterTypes.find(m_rootSignature);
+		if (parameterTypes == m_rootParameterTypes.end()) {
+			Error("SetGraphicsRootTexture: no root signature");
+		} else if (rootParameterIndex >= parameterTypes->second.size()) {
+			Error("SetGraphicsRootTexture: root parameter " + std::to_string(rootParameterIndex) + " is out of range");
+		} else if (parameterTypes->second[rootParameterIndex] != kRootTable) {
+			Error("SetGraphicsRootTexture: root parameter " + std::to_string(rootParameterIndex) + " is not a descriptor table");
+		}
+	}
+}
+
+void NullCommandRecorder::SetPrimitiveTopology(uint32_t topology)
+{
+	Count(CaptureCommand::SetPrimitiveTopology, sizeof(topology));
+	if (m_validate) {
+		RequireFrame("SetPrimitiveTopology");
+		m_topologySet = topology != 0;
+	}
+}
+
+void NullCommandRecorder::SetVertexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t stride)
+{
+	Count(CaptureCommand::SetVertexBuffer, sizeof(buffer) + sizeof(size) + sizeof(stride));
+	if (m_validate) {
+		RequireFrame("SetVertexBuffer");
+		const auto found = m_buffers.find(buffer);
+		if (found == m_buffers.end()) {
+			Error("SetVertexBuffer: unknown buffer " + std::to_string(buffer));
+		} else if (size > found->second.size || stride == 0) {
+			Error("SetVertexBuffer: view does not fit in buffer " + std::to_string(buffer));
+		}
+		m_vertexBufferSet = true;
+	}
+}
+
+void NullCommandRecorder::SetIndexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t format)
+{
+	Count(CaptureCommand::SetIndexBuffer, sizeof(buffer) + sizeof(size) + sizeof(format));
+	if (m_validate) {
+		RequireFrame("SetIndexBuffer");
+		const auto found = m_buffers.find(buffer);
+		const uint32_t indexSize = IndexSize(format);
+		if (found == m_buffers.end()) {
+			Error("SetIndexBuffer: unknown buffer " + std::to_string(buffer));
+		} else if (size > found->second.size) {
+			Error("SetIndexBuffer: view does not fit in buffer " + std::to_string(buffer));
+		}
+		if (indexSize == 0) {
+			Error("SetIndexBuffer: format must be R16_UINT or R32_UINT");
+			m_indexCount = 0;
+		} else {
+			m_indexCount = size / indexSize;
+		}
+	}
+}
+
+void NullCommandRecorder::DrawIndexedInstanced(
+	uint32_t indexCountPerInstance,
+	uint32_t instanceCount,
+	uint32_t startIndexLocation,
+	int32_t baseVertexLocation,
+	uint32_t startInstanceLocation
+) {
+	Count(
+		CaptureCommand::DrawIndexedInstanced,
+		sizeof(indexCountPerInstance) + sizeof(instanceCount) + sizeof(startIndexLocation) +
+			sizeof(baseVertexLocation) + sizeof(startInstanceLocation)
+	);
+	if (m_validate) {
+		RequireFrame("DrawIndexedInstanced");
+		if (m_pipelineState == kInvalidRecorderObject || m_rootSignature == kInvalidRecorderObject) {
+			Error("DrawIndexedInstanced: pipeline state or root signature is not set");
+		}
+		if (!m_viewportSet || !m_scissorSet || !m_topologySet || !m_vertexBufferSet) {
+			Error("DrawIndexedInstanced: viewport, scissor, topology or vertex buffer is not set");
+		}
+		if (static_cast<uint64_t>(startIndexLocation) + indexCountPerInstance > m_indexCount) {
+			Error("DrawIndexedInstanced: indices run past the index buffer");
+		}
+	}
+}
+
+void NullCommandRecorder::EndFrame()
+{
+	Count(CaptureCommand::EndFrame, 0);
+	if (m_validate) {
+		RequireFrame("EndFrame");
+		m_inFrame = false;
+	}
+}
+
+namespace {
+	// DirectXManager ̎lp`Ɠ傫̃bVApCvC2ށEeNX`2ŕ`
+	enum : RecorderObjectId {
+		kSceneVertexBuffer = 1,
+		kSceneIndexBuffer,
+		kSceneTexture0,
+		kSceneTexture1,
+		kSceneRootSignature,
+		kScenePipelineState0,
+		kScenePipelineState1,
+	};
+	constexpr uint32_t kSceneVertexStride = 20;
+	constexpr uint32_t kSceneVertexBufferSize = kSceneVertexStride * 4;
+	constexpr uint32_t kSceneIndexCount = 6;
+	// ̕`搔ƂɃpCvCEeNX`؂ւ
+	constexpr uint32_t kSceneStateChangeInterval = 64;
+
+	// D3D12SerializeRootSignature Ɠ`́ASRV 1̃e[u[gVOl`B
+	// `FbNT͓ĂȂ̂ D3D12 ɂ͓nȂ
+	std::vector<uint8_t> SyntheticRootSignature()
+	{
+		const uint32_t words[] = {
+			// DXBC Rei[: magic, checksum[4], version, size, chunk count, chunk offset
+			0x43425844, 0, 0, 0, 0, 1, 108, 1, 36,
+			// RTS0 `N: fourcc, size
+			0x30535452, 64,
+			// version, parameter count, parameter offset, sampler count, sampler offset, flags(ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT)
+			1, 1, 24, 0, 64, 1,
+			// p[^[: type, visibility, payload offset
+			kRootTable, kVisibilityPixel, 36,
+			// e[u: range count, range offset
+			1, 44,
+			// W: type, count, register, space, offset(D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND)
+			kRangeSrv, 1, 0, 0, 0xffffffff,
+		};
+		std::vector<uint8_t> bytes(sizeof(words));
+		std::memcpy(bytes.data(), words, sizeof(words));
+		return bytes;
+	}
+}
+
+void CreateSyntheticScene(CommandRecorder& recorder)
+{
+	const std::vector<uint8_t> vertices(kSceneVertexBufferSize);
+	const std::vector<uint8_t> indices(sizeof(uint16_t) * kSceneIndexCount);
+	const std::vector<uint8_t> texels(16 * 16 * 4);
+	const std::vector<uint8_t> rootSignature = SyntheticRootSignature();
+	RecorderPipelineDescription pipeline;
+	pipeline.rootSignature = kSceneRootSignature;
+	pipeline.vertexShader.resize(512);
+	pipeline.pixelShader.resize(512);
+	pipeline.inputLayout = { { "POSITION", 0, 6 }, { "TEXCOORD", 0, 16 } };
+	// DXGI_FORMAT_D32_FLOAT
+	pipeline.depthStencilFormat = 40;
+	pipeline.depthMode = kDepthWrite;
+
+	recorder.CreateBuffer(kSceneVertexBuffer, vertices.size());
+	recorder.UploadResource(kSceneVertexBuffer, vertices.data(), vertices.size(), 0);
+	recorder.CreateBuffer(kSceneIndexBuffer, indices.size());
+	recorder.UploadResource(kSceneIndexBuffer, indices.data(), indices.size(), 0);
+	recorder.CreateTexture(kSceneTexture0, { 16, 16, 28 });
+	recorder.UploadResource(kSceneTexture0, texels.data(), texels.size(), 16 * 4);
+	recorder.CreateTexture(kSceneTexture1, { 16, 16, 28 });
+	recorder.UploadResource(kSceneTexture1, texels.data(), texels.size(), 16 * 4);
+	recorder.CreateRootSignature(kSceneRootSignature, rootSignature.data(), rootSignature.size());
+	recorder.CreatePipelineState(kScenePipelineState0, pipeline);
+	recorder.CreatePipelineState(kScenePipelineState1, pipeline);
+}
+
+void RecordSyntheticFrame(CommandRecorder& recorder, uint32_t drawCount)
+{
+	const float clearColor[] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	recorder.BeginFrame();
+	recorder.ClearRenderTarget(clearColor);
+	recorder.ClearDepth(0.0f);
+	recorder.SetGraphicsRootSignature(kSceneRootSignature);
+	recorder.SetViewport({ 0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f });
+	recorder.SetScissorRect({ 0, 0, 1280, 720 });
+	recorder.SetPrimitiveTopology(4);
+	recorder.SetVertexBuffer(kSceneVertexBuffer, kSceneVertexBufferSize, kSceneVertexStride);
+	recorder.SetIndexBuffer(kSceneIndexBuffer, sizeof(uint16_t) * kSceneIndexCount, kIndexFormatR16Uint);
+	for (uint32_t i = 0; i < drawCount; ++i) {
+		if (i % kSceneStateChangeInterval == 0) {
+			const bool odd = (i / kSceneStateChangeInterval) % 2 != 0;
+			recorder.SetPipelineState(odd ? kScenePipelineState1 : kScenePipelineState0);
+			recorder.SetGraphicsRootTexture(0, odd ? kSceneTexture1 : kSceneTexture0);
+		}
+		recorder.DrawIndexedInstanced(kSceneIndexCount, 1, 0, 0, i);
+	}
+	recorder.EndFrame();
+}
+
+NullRecorderBenchmarkResult RunNullRecorderBenchmark(uint32_t drawCount, bool validate)
+{
+	NullCommandRecorder recorder(validate);
+	CreateSyntheticScene(recorder);
+	// 쐬ɂ͐Ȃ
+	recorder.ResetStats();
+
+	const auto start = std::chrono::steady_clock::now();
+	RecordSyntheticFrame(recorder, drawCount);
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	recorder.Finish();
+
+	NullRecorderBenchmarkResult result;
+	result.drawCount = drawCount;
+	result.milliseconds = std::chrono::duration<double, std::milli>(elapsed).count();
+	result.nanosecondsPerDraw = drawCount > 0
+		? std::chrono::duration<double, std::nano>(elapsed).count() / drawCount
+		: 0.0;
+	result.calls = recorder.TotalCalls();
+	result.bytes = recorder.TotalBytes();
+	result.errors = recorder.ErrorCount();
+	return result;
+}
+
+std::string FormatNullRecorderBenchmark(const NullRecorderBenchmarkResult& result)
+{
+	char line[160];
+	std::snprintf(
+		line,
+		sizeof(line),
+		"%8u draws : %9.3f ms (%7.1f ns/draw), %llu calls, %llu bytes, %llu errors\n",
+		result.drawCount,
+		result.milliseconds,
+		result.nanosecondsPerDraw,
+		static_cast<unsigned long long>(result.calls),
+		static_cast<unsigned long long>(result.bytes),
+		static_cast<unsigned long long>(result.errors)
+	);
+	return line;
+}
+}
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "CommandRecorder.h"
+#include "FrameCapture.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// GPU hCo[g킸ɁAĂяo𐔂邾 CommandRecorderB
+// L^鑤(DirectXManager Ȃ) CPU Ԃ𑪂̂ɎgBD3D12 ̂Ȃł
+class NullCommandRecorder : public CommandRecorder
+{
+public:
+	struct CallStats
+	{
+		uint64_t count = 0;
+		// ƂĎ󂯎oCg(Abv[hVF[_[̒g܂)
+		uint64_t bytes = 0;
+	};
+
+	// validate  true ȂAԍ쐬ς݂E`̑OɕKvȐݒ肪ςł邩Ȃǂm߂
+	explicit NullCommandRecorder(bool validate = false) : m_validate(validate) {}
+
+	const CallStats& Stats(CaptureCommand command) const { return m_stats[static_cast<size_t>(command)]; }
+	uint64_t TotalCalls() const;
+	uint64_t TotalBytes() const;
+	// ̐ƁAŏ̂̓e
+	uint64_t ErrorCount() const { return m_errorCount; }
+	const std::vector<std::string>& Errors() const { return m_errors; }
+	// lB쐬ς݂̃IuWFNg͎c
+	void ResetStats();
+	// `̑傫Bvalidate ȂAr[|[gƃVU[͂ݏoĂȂm߂
+	// (DirectXManager ͂`̓ɕ`̂ŁA͂ݏoĂΌÂ傫̂܂܋L^Ă)B
+	// 0 x 0 ͕`悪Ȃ(Xbv`F[蒼Ăr)Ƃ\ABeginFrame G[ɂ
+	void SetRenderTargetSize(uint32_t width, uint32_t height);
+	// L^̏I(R}hXgs)Bvalidate ȂAEndFrame ŕĂȂt[G[ɂ
+	void Finish();
+
+	bool CreateBuffer(RecorderObjectId id, uint64_t size) override;
+	bool CreateTexture(RecorderObjectId id, const RecorderTextureDescription& description) override;
+	bool UploadResource(RecorderObjectId id, const void* data, size_t size, uint32_t rowPitch) override;
+	bool CreateRootSignature(RecorderObjectId id, const void* serialized, size_t size) override;
+	bool CreatePipelineState(RecorderObjectId id, const RecorderPipelineDescription& description) override;
+
+	void BeginFrame() override;
+	void ClearRenderTarget(const float color[4]) override;
+	void ClearDepth(float depth) override;
+	void SetPipelineState(RecorderObjectId pipelineState) override;
+	void SetGraphicsRootSignature(RecorderObjectId rootSignature) override;
+	void SetViewport(const RecorderViewport& viewport) override;
+	void SetScissorRect(const RecorderRect& rect) override;
+	void SetGraphicsRootTexture(uint32_t rootParameterIndex, RecorderObjectId texture) override;
+	void SetPrimitiveTopology(uint32_t topology) override;
+	void SetVertexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t stride) override;
+	void SetIndexBuffer(RecorderObjectId buffer, uint32_t size, uint32_t format) override;
+	void DrawIndexedInstanced(
+		uint32_t indexCountPerInstance,
+		uint32_t instanceCount,
+		uint32_t startIndexLocation,
+		int32_t baseVertexLocation,
+		uint32_t startInstanceLocation
+	) override;
+	void EndFrame() override;
+
+private:
+	// cĂ̓e̐
+	static constexpr size_t kMaxStoredErrors = 16;
+
+	enum ObjectKind {
+		kBufferObject,
+		kTextureObject,
+		kRootSignatureObject,
+		kPipelineStateObject,
+	};
+	struct Buffer
+	{
+		uint64_t size;
+	};
+
+	bool m_validate;
+	std::array<CallStats, static_cast<size_t>(CaptureCommand::Count)> m_stats;
+	uint64_t m_errorCount = 0;
+	std::vector<std::string> m_errors;
+
+	// ȉ validate ̂Ƃg
+	std::map<RecorderObjectId, ObjectKind> m_objects;
+	std::map<RecorderObjectId, Buffer> m_buffers;
+	// [gVOl`Ƃ̃p[^[̎(D3D12_ROOT_PARAMETER_TYPE)
+	std::map<RecorderObjectId, std::vector<uint32_t>> m_rootParameterTypes;
+	bool m_inFrame = false;
+	RecorderObjectId m_pipelineState = kInvalidRecorderObject;
+	RecorderObjectId m_rootSignature = kInvalidRecorderObject;
+	bool m_viewportSet = false;
+	bool m_scissorSet = false;
+	bool m_topologySet = false;
+	bool m_vertexBufferSet = false;
+	// ݒ蒆̃CfbNXobt@[ɓCfbNX̐
+	uint64_t m_indexCount = 0;
+	// SetRenderTargetSize ĂԂ܂ł͑傫m߂Ȃ
+	bool m_hasRenderTargetSize = false;
+	uint32_t m_renderTargetWidth = 0;
+	uint32_t m_renderTargetHeight = 0;
+
+	void Count(CaptureCommand command, uint64_t bytes);
+	void Error(const std::string& message);
+	bool CreateObject(RecorderObjectId id, ObjectKind kind, const char* call);
+	void RequireObject(RecorderObjectId id, ObjectKind kind, const char* call);
+	void RequireFrame(const char* call);
+};
+
+// 1񕪂̌v
+struct NullRecorderBenchmarkResult
+{
+	uint32_t drawCount = 0;
+	double milliseconds = 0.0;
+	double nanosecondsPerDraw = 0.0;
+	uint64_t calls = 0;
+	uint64_t bytes = 0;
+	uint64_t errors = 0;
+};
+
+// vp̍V[BCreateSyntheticScene Ńobt@[EeNX`EpCvCA
+// RecordSyntheticFrame  drawCount `悷1t[L^B
+// `悲ƂɈςAԊuŃpCvCƃeNX`؂ւ
+void CreateSyntheticScene(CommandRecorder& recorder);
+void RecordSyntheticFrame(CommandRecorder& recorder, uint32_t drawCount);
+
+// V[1t[ NullCommandRecorder ɋL^AL^ɂԂ𑪂
+NullRecorderBenchmarkResult RunNullRecorderBenchmark(uint32_t drawCount, bool validate);
+std::string FormatNullRecorderBenchmark(const NullRecorderBenchmarkResult& result);
+}
+}
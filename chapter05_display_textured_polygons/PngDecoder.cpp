@@ -0,0 +1,686 @@
+#include "PngDecoder.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "Helpers.h"
+
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	constexpr uint8_t kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	constexpr size_t kRgbaBytesPerPixel = 4;
+
+	enum PngColorType : uint8_t {
+		kColorGray = 0,
+		kColorRgb = 2,
+		kColorPalette = 3,
+		kColorGrayAlpha = 4,
+		kColorRgba = 6,
+	};
+
+	uint32_t ReadBigEndian32(const uint8_t* data)
+	{
+		return (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+	}
+
+	// deflate ̕nt}\B
+	// 擪 kFastBits rbgȓ͕̕\1ŁA蒷̂1rbgׂ
+	constexpr int kFastBits = 10;
+	constexpr int kMaxCodeLength = 15;
+
+	struct HuffmanTable
+	{
+		// ( << 9) | lB0 Ȃ璷
+		uint16_t fast[1 << kFastBits];
+		// Ƃ̐ƁȀɕׂl
+		uint16_t counts[kMaxCodeLength + 1];
+		uint16_t symbols[288];
+	};
+
+	uint32_t ReverseBits(uint32_t code, int length)
+	{
+		uint32_t reversed = 0;
+		for (int i = 0; i < length; ++i) {
+			reversed = (reversed << 1) | ((code >> i) & 1);
+		}
+		return reversed;
+	}
+
+	bool BuildHuffmanTable(const uint8_t* lengths, int symbolCount, HuffmanTable& table)
+	{
+		std::memset(table.counts, 0, sizeof(table.counts));
+		for (int i = 0; i < symbolCount; ++i) {
+			++table.counts[lengths[i]];
+		}
+		table.counts[0] = 0;
+
+		// ̐\͉Ă(Ȃ̂͋̕1̂ƂȂǂɋN)
+		int left = 1;
+		for (int length = 1; length <= kMaxCodeLength; ++length) {
+			left = left * 2 - table.counts[length];
+			if (left < 0) {
+				return false;
+			}
+		}
+
+		uint16_t offsets[kMaxCodeLength + 2] = {};
+		for (int length = 1; length <= kMaxCodeLength; ++length) {
+			offsets[length + 1] = offsets[length] + table.counts[length];
+		}
+		uint32_t nextCode[kMaxCodeLength + 1] = {};
+		uint32_t code = 0;
+		for (int length = 1; length <= kMaxCodeLength; ++length) {
+			code = (code + table.counts[length - 1]) << 1;
+			nextCode[length] = code;
+		}
+
+		std::memset(table.fast, 0, sizeof(table.fast));
+		for (int symbol = 0; symbol < symbolCount; ++symbol) {
+			const int length = lengths[symbol];
+			if (length == 0) {
+				continue;
+			}
+			table.symbols[offsets[length]++] = static_cast<uint16_t>(symbol);
+			if (length <= kFastBits) {
+				// rbg͉ʂǂނ̂ŁA𔽓]ʒuɒu
+				const uint32_t reversed = ReverseBits(nextCode[length], length);
+				for (uint32_t fill = reversed; fill < (1u << kFastBits); fill += 1u << length) {
+					table.fast[fill] = static_cast<uint16_t>((length << 9) | symbol);
+				}
+			}
+			++nextCode[length];
+		}
+		return true;
+	}
+
+	// zlib `(RFC 1950 / 1951)̓WJBo͂̑傫 PNG ̃wb_[番̂ŁA𒴂Ă
+	class Inflater
+	{
+	public:
+		Inflater(const uint8_t* data, size_t size, uint8_t* output, size_t outputSize)
+			: m_data(data), m_size(size), m_output(output), m_outputSize(outputSize)
+		{
+		}
+
+		bool Inflate();
+		size_t OutputSize() const { return m_outputPosition; }
+
+	private:
+		const uint8_t* m_data;
+		size_t m_size;
+		size_t m_position = 0;
+		uint64_t m_buffer = 0;
+		int m_bitCount = 0;
+		// ͂̏Izēǂ
+		bool m_overrun = false;
+		uint8_t* m_output;
+		size_t m_outputSize;
+		size_t m_outputPosition = 0;
+
+		void Fill()
+		{
+			while (m_bitCount <= 56) {
+				if (m_position < m_size) {
+					m_buffer |= static_cast<uint64_t>(m_data[m_position++]) << m_bitCount;
+				} else {
+					m_overrun |= m_bitCount == 0;
+				}
+				m_bitCount += 8;
+			}
+		}
+
+		uint32_t Read(int count)
+		{
+			if (m_bitCount < count) {
+				Fill();
+			}
+			const uint32_t bits = static_cast<uint32_t>(m_buffer & ((uint64_t(1) << count) - 1));
+			m_buffer >>= count;
+			m_bitCount -= count;
+			return bits;
+		}
+
+		int Decode(const HuffmanTable& table)
+		{
+			if (m_bitCount < kMaxCodeLength) {
+				Fill();
+			}
+			const uint16_t fast = table.fast[m_buffer & ((1u << kFastBits) - 1)];
+			if (fast != 0) {
+				const int length = fast >> 9;
+				m_buffer >>= length;
+				m_bitCount -= length;
+				return fast & 0x1FF;
+			}
+			// ͐nt}̏1rbgׂ
+			int code = 0;
+			int first = 0;
+			int index = 0;
+			for (int length = 1; length <= kMaxCodeLength; ++length) {
+				code |= static_cast<int>(Read(1));
+				const int count = table.counts[length];
+				if (code - count < first) {
+					return table.symbols[index + (code - first)];
+				}
+				index += count;
+				first = (first + count) << 1;
+				code <<= 1;
+			}
+			return -1;
+		}
+
+		bool InflateStored();
+		bool InflateCodes(const HuffmanTable& literals, const HuffmanTable& distances);
+		bool ReadDynamicTables(HuffmanTable& literals, HuffmanTable& distances);
+	};
+
+	bool Inflater::InflateStored()
+	{
+		// oCgE܂Ŏ̂Ă
+		Read(m_bitCount % 8);
+		const uint32_t length = Read(16);
+		const uint32_t inverted = Read(16);
+		if ((length ^ 0xFFFF) != inverted || m_outputPosition + length > m_outputSize) {
+			return false;
+		}
+		// ܂rbgobt@[ɓĂ镪o
+		uint32_t copied = 0;
+		while (copied < length && m_bitCount >= 8) {
+			m_output[m_outputPosition++] = static_cast<uint8_t>(Read(8));
+			++copied;
+		}
+		const uint32_t remaining = length - copied;
+		if (m_position + remaining > m_size) {
+			return false;
+		}
+		std::memcpy(m_output + m_outputPosition, m_data + m_position, remaining);
+		m_position += remaining;
+		m_outputPosition += remaining;
+		return true;
+	}
+
+	bool Inflater::InflateCodes(const HuffmanTable& literals, const HuffmanTable& distances)
+	{
+		static const uint16_t kLengthBases[29] = {
+			3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+		};
+		static const uint8_t kLengthExtraBits[29] = {
+			0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+		};
+		static const uint16_t kDistanceBases[30] = {
+			1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+			257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+		};
+		static const uint8_t kDistanceExtraBits[30] = {
+			0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+		};
+
+		while (true) {
+			const int symbol = Decode(literals);
+			if (symbol < 0 || m_overrun) {
+				return false;
+			}
+			if (symbol < 256) {
+				if (m_outputPosition >= m_outputSize) {
+					return false;
+				}
+				m_output[m_outputPosition++] = static_cast<uint8_t>(symbol);
+				continue;
+			}
+			if (symbol == 256) {
+				return true;
+			}
+			const int lengthIndex = symbol - 257;
+			if (lengthIndex >= 29) {
+				return false;
+			}
+			const size_t length = kLengthBases[lengthIndex] + Read(kLengthExtraBits[lengthIndex]);
+			const int distanceIndex = Decode(distances);
+			if (distanceIndex < 0 || distanceIndex >= 30) {
+				return false;
+			}
+			const size_t distance = kDistanceBases[distanceIndex] + Read(kDistanceExtraBits[distanceIndex]);
+			if (distance > m_outputPosition || m_outputPosition + length > m_outputSize) {
+				return false;
+			}
+			// dȂĂ邱Ƃ(distance < length ȂJԂɂȂ)̂1oCgʂ
+			uint8_t* out = m_output + m_outputPosition;
+			const uint8_t* from = out - distance;
+			for (size_t i = 0; i < length; ++i) {
+				out[i] = from[i];
+			}
+			m_outputPosition += length;
+		}
+	}
+
+	bool Inflater::ReadDynamicTables(HuffmanTable& literals, HuffmanTable& distances)
+	{
+		static const uint8_t kCodeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+		const int literalCount = static_cast<int>(Read(5)) + 257;
+		const int distanceCount = static_cast<int>(Read(5)) + 1;
+		const int codeLengthCount = static_cast<int>(Read(4)) + 4;
+		if (literalCount > 286 || distanceCount > 30) {
+			return false;
+		}
+
+		uint8_t codeLengthLengths[19] = {};
+		for (int i = 0; i < codeLengthCount; ++i) {
+			codeLengthLengths[kCodeLengthOrder[i]] = static_cast<uint8_t>(Read(3));
+		}
+		HuffmanTable codeLengths;
+		if (!BuildHuffmanTable(codeLengthLengths, 19, codeLengths)) {
+			return false;
+		}
+
+		// E̕Ƌ͑̕ĕł(JԂ͋E܂ł悢)
+		uint8_t lengths[286 + 30] = {};
+		int index = 0;
+		while (index < literalCount + distanceCount) {
+			const int symbol = Decode(codeLengths);
+			if (symbol < 0 || m_overrun) {
+				return false;
+			}
+			if (symbol < 16) {
+				lengths[index++] = static_cast<uint8_t>(symbol);
+				continue;
+			}
+			uint8_t value = 0;
+			int repeat = 0;
+			if (symbol == 16) {
+				if (index == 0) {
+					return false;
+				}
+				value = lengths[index - 1];
+				repeat = 3 + static_cast<int>(Read(2));
+			} else if (symbol == 17) {
+				repeat = 3 + static_cast<int>(Read(3));
+			} else {
+				repeat = 11 + static_cast<int>(Read(7));
+			}
+			if (index + repeat > literalCount + distanceCount) {
+				return false;
+			}
+			std::fill(lengths + index, lengths + index + repeat, value);
+			index += repeat;
+		}
+		// I̕Ȃ΃f[^IȂ
+		if (lengths[256] == 0) {
+			return false;
+		}
+		return BuildHuffmanTable(lengths, literalCount, literals) &&
+			BuildHuffmanTable(lengths + literalCount, distanceCount, distances);
+	}
+
+	bool Inflater::Inflate()
+	{
+		// zlib ̃wb_[: k deflate ŁAvZbg͎gȂ
+		if (m_size < 2 || (m_data[0] & 0x0F) != 8 || ((m_data[0] << 8) | m_data[1]) % 31 != 0 || (m_data[1] & 0x20) != 0) {
+			return false;
+		}
+		m_position = 2;
+
+		bool last = false;
+		while (!last) {
+			last = Read(1) != 0;
+			const uint32_t type = Read(2);
+			bool succeeded = false;
+			if (type == 0) {
+				succeeded = InflateStored();
+			} else if (type == 1) {
+				// Œnt}
+				static HuffmanTable fixedLiterals;
+				static HuffmanTable fixedDistances;
+				static const bool built = []() {
+					uint8_t lengths[288];
+					std::fill(lengths, lengths + 144, static_cast<uint8_t>(8));
+					std::fill(lengths + 144, lengths + 256, static_cast<uint8_t>(9));
+					std::fill(lengths + 256, lengths + 280, static_cast<uint8_t>(7));
+					std::fill(lengths + 280, lengths + 288, static_cast<uint8_t>(8));
+					uint8_t distanceLengths[30];
+					std::fill(distanceLengths, distanceLengths + 30, static_cast<uint8_t>(5));
+					return BuildHuffmanTable(lengths, 288, fixedLiterals) && BuildHuffmanTable(distanceLengths, 30, fixedDistances);
+				}();
+				succeeded = built && InflateCodes(fixedLiterals, fixedDistances);
+			} else if (type == 2) {
+				HuffmanTable literals;
+				HuffmanTable distances;
+				succeeded = ReadDynamicTables(literals, distances) && InflateCodes(literals, distances);
+			}
+			if (!succeeded || m_overrun) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	struct PngHeader
+	{
+		uint32_t width;
+		uint32_t height;
+		uint8_t bitDepth;
+		uint8_t colorType;
+		bool interlaced;
+	};
+
+	int ChannelCount(uint8_t colorType)
+	{
+		switch (colorType) {
+		case kColorGray:
+		case kColorPalette:
+			return 1;
+		case kColorGrayAlpha:
+			return 2;
+		case kColorRgb:
+			return 3;
+		case kColorRgba:
+			return 4;
+		default:
+			return 0;
+		}
+	}
+
+	bool ReadHeader(const uint8_t* data, size_t size, PngHeader& header)
+	{
+		// VOl`͕̒K IHDR
+		if (size < 8 + 8 + 13 || std::memcmp(data, kSignature, 8) != 0 ||
+			ReadBigEndian32(data + 8) != 13 || std::memcmp(data + 12, "IHDR", 4) != 0) {
+			return false;
+		}
+		const uint8_t* ihdr = data + 16;
+		header.width = ReadBigEndian32(ihdr);
+		header.height = ReadBigEndian32(ihdr + 4);
+		header.bitDepth = ihdr[8];
+		header.colorType = ihdr[9];
+		header.interlaced = ihdr[12] == 1;
+		if (header.width == 0 || header.height == 0 || header.width > (1u << 24) || header.height > (1u << 24) ||
+			ihdr[10] != 0 || ihdr[11] != 0 || ihdr[12] > 1) {
+			return false;
+		}
+
+		// F`ƂɎgrbg[x܂Ă
+		const uint8_t depth = header.bitDepth;
+		switch (header.colorType) {
+		case kColorGray:
+			return depth == 1 || depth == 2 || depth == 4 || depth == 8 || depth == 16;
+		case kColorPalette:
+			return depth == 1 || depth == 2 || depth == 4 || depth == 8;
+		case kColorRgb:
+		case kColorGrayAlpha:
+		case kColorRgba:
+			return depth == 8 || depth == 16;
+		default:
+			return false;
+		}
+	}
+
+	uint8_t Paeth(uint8_t a, uint8_t b, uint8_t c)
+	{
+		const int p = a + b - c;
+		const int pa = std::abs(p - a);
+		const int pb = std::abs(p - b);
+		const int pc = std::abs(p - c);
+		if (pa <= pb && pa <= pc) {
+			return a;
+		}
+		return pb <= pc ? b : c;
+	}
+
+	// tB^[߂Bprevious 1̍s(ŏ̍sȂ 0 ̕)
+	bool Unfilter(uint8_t filter, uint8_t* row, const uint8_t* previous, size_t rowSize, size_t bytesPerPixel)
+	{
+		switch (filter) {
+		case 0:
+			return true;
+		case 1:
+			for (size_t i = bytesPerPixel; i < rowSize; ++i) {
+				row[i] = static_cast<uint8_t>(row[i] + row[i - bytesPerPixel]);
+			}
+			return true;
+		case 2:
+			for (size_t i = 0; i < rowSize; ++i) {
+				row[i] = static_cast<uint8_t>(row[i] + previous[i]);
+			}
+			return true;
+		case 3:
+			for (size_t i = 0; i < rowSize; ++i) {
+				const int left = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+				row[i] = static_cast<uint8_t>(row[i] + ((left + previous[i]) >> 1));
+			}
+			return true;
+		case 4:
+			for (size_t i = 0; i < rowSize; ++i) {
+				const uint8_t left = i >= bytesPerPixel ? row[i - bytesPerPixel] : 0;
+				const uint8_t upperLeft = i >= bytesPerPixel ? previous[i - bytesPerPixel] : 0;
+				row[i] = static_cast<uint8_t>(row[i] + Paeth(left, previous[i], upperLeft));
+			}
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// pbgƓߐF(tRNS)
+	struct PngPalette
+	{
+		uint8_t rgba[256][4];
+		size_t size = 0;
+		// ߐF(O[ RGB ̂ƂBl͌̃rbg[x̂܂)
+		bool hasColorKey = false;
+		uint16_t colorKey[3] = {};
+	};
+
+	// tB^[߂1s RGBA e8bit ɂB16bit ͏ 8bit g
+	void ConvertRow(const PngHeader& header, const PngPalette& palette, const uint8_t* row, uint32_t width, uint8_t* out)
+	{
+		const int depth = header.bitDepth;
+		const auto sample = [&](size_t index) -> uint32_t {
+			if (depth == 8) {
+				return row[index];
+			}
+			if (depth == 16) {
+				return (row[index * 2] << 8) | row[index * 2 + 1];
+			}
+			const size_t bit = index * depth;
+			return (row[bit / 8] >> (8 - depth - bit % 8)) & ((1u << depth) - 1);
+		};
+		const auto toByte = [depth](uint32_t value) -> uint8_t {
+			if (depth == 16) {
+				return static_cast<uint8_t>(value >> 8);
+			}
+			// 1, 2, 4bit ̃O[ 0`255 ɈL΂
+			return static_cast<uint8_t>(value * 255 / ((1u << depth) - 1));
+		};
+
+		for (uint32_t x = 0; x < width; ++x) {
+			uint8_t* pixel = out + x * kRgbaBytesPerPixel;
+			switch (header.colorType) {
+			case kColorGray: {
+				const uint32_t gray = sample(x);
+				pixel[0] = pixel[1] = pixel[2] = toByte(gray);
+				pixel[3] = palette.hasColorKey && gray == palette.colorKey[0] ? 0 : 255;
+				break;
+			}
+			case kColorGrayAlpha:
+				pixel[0] = pixel[1] = pixel[2] = toByte(sample(x * 2));
+				pixel[3] = toByte(sample(x * 2 + 1));
+				break;
+			case kColorRgb: {
+				const uint32_t red = sample(x * 3);
+				const uint32_t green = sample(x * 3 + 1);
+				const uint32_t blue = sample(x * 3 + 2);
+				pixel[0] = toByte(red);
+				pixel[1] = toByte(green);
+				pixel[2] = toByte(blue);
+				pixel[3] = palette.hasColorKey &&
+					red == palette.colorKey[0] && green == palette.colorKey[1] && blue == palette.colorKey[2] ? 0 : 255;
+				break;
+			}
+			case kColorRgba:
+				for (int c = 0; c < 4; ++c) {
+					pixel[c] = toByte(sample(x * 4 + c));
+				}
+				break;
+			case kColorPalette: {
+				// pbgɂȂԍ͕s̍ɂ
+				const uint32_t index = sample(x);
+				static const uint8_t kBlack[4] = { 0, 0, 0, 255 };
+				std::memcpy(pixel, index < palette.size ? palette.rgba[index] : kBlack, kRgbaBytesPerPixel);
+				break;
+			}
+			}
+		}
+	}
+
+	// Adam7 ̊epX摜̂ǂ󂯎(C^[[XȂ͑Ŝ1pXƂĈ)
+	struct PngPass
+	{
+		uint32_t xStart, yStart, xStep, yStep;
+	};
+	constexpr PngPass kAdam7Passes[7] = {
+		{ 0, 0, 8, 8 }, { 4, 0, 8, 8 }, { 0, 4, 4, 8 }, { 2, 0, 4, 4 }, { 0, 2, 2, 4 }, { 1, 0, 2, 2 }, { 0, 1, 1, 2 },
+	};
+	constexpr PngPass kSinglePass = { 0, 0, 1, 1 };
+
+	uint32_t PassSize(uint32_t size, uint32_t start, uint32_t step)
+	{
+		return size > start ? (size - start + step - 1) / step : 0;
+	}
+
+	size_t RowSize(const PngHeader& header, uint32_t width)
+	{
+		return (static_cast<size_t>(width) * ChannelCount(header.colorType) * header.bitDepth + 7) / 8;
+	}
+}
+
+bool ReadPngInfo(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, uint32_t& bitDepth)
+{
+	PngHeader header;
+	if (!ReadHeader(data, size, header)) {
+		return false;
+	}
+	width = header.width;
+	height = header.height;
+	bitDepth = header.bitDepth;
+	return true;
+}
+
+bool DecodePng(const uint8_t* data, size_t size, uint8_t* destination, size_t rowPitch, size_t destinationSize)
+{
+	PngHeader header;
+	if (!ReadHeader(data, size, header)) {
+		return false;
+	}
+	const size_t rgbaRowSize = static_cast<size_t>(header.width) * kRgbaBytesPerPixel;
+	if (rowPitch < rgbaRowSize || destinationSize < rowPitch * (header.height - 1) + rgbaRowSize) {
+		DebugOutputFormatString("DecodePng destination is too small.\n");
+		return false;
+	}
+
+	// `Nǂ݁AIDAT ͂ȂĂ
+	PngPalette palette;
+	std::vector<uint8_t> compressed;
+	bool sawEnd = false;
+	for (size_t offset = 8; offset + 12 <= size;) {
+		const uint32_t length = ReadBigEndian32(data + offset);
+		const uint8_t* type = data + offset + 4;
+		const uint8_t* chunk = data + offset + 8;
+		if (length > size - offset - 12) {
+			return false;
+		}
+		if (std::memcmp(type, "IDAT", 4) == 0) {
+			compressed.insert(compressed.end(), chunk, chunk + length);
+		} else if (std::memcmp(type, "PLTE", 4) == 0) {
+			if (length % 3 != 0 || length / 3 > 256) {
+				return false;
+			}
+			palette.size = length / 3;
+			for (size_t i = 0; i < palette.size; ++i) {
+				palette.rgba[i][0] = chunk[i * 3];
+				palette.rgba[i][1] = chunk[i * 3 + 1];
+				palette.rgba[i][2] = chunk[i * 3 + 2];
+				palette.rgba[i][3] = 255;
+			}
+		} else if (std::memcmp(type, "tRNS", 4) == 0) {
+			if (header.colorType == kColorPalette) {
+				for (size_t i = 0; i < (std::min)(static_cast<size_t>(length), palette.size); ++i) {
+					palette.rgba[i][3] = chunk[i];
+				}
+			} else if (header.colorType == kColorGray && length >= 2) {
+				palette.hasColorKey = true;
+				palette.colorKey[0] = static_cast<uint16_t>((chunk[0] << 8) | chunk[1]);
+			} else if (header.colorType == kColorRgb && length >= 6) {
+				palette.hasColorKey = true;
+				for (int c = 0; c < 3; ++c) {
+					palette.colorKey[c] = static_cast<uint16_t>((chunk[c * 2] << 8) | chunk[c * 2 + 1]);
+				}
+			}
+		} else if (std::memcmp(type, "IEND", 4) == 0) {
+			sawEnd = true;
+			break;
+		}
+		offset += 12 + length;
+	}
+	if (!sawEnd || compressed.empty() || (header.colorType == kColorPalette && palette.size == 0)) {
+		DebugOutputFormatString("DecodePng : missing IDAT, PLTE or IEND.\n");
+		return false;
+	}
+
+	// WJƂ̑傫́ApXƂ (tB^[1oCg + 1s) x s
+	const PngPass* passes = header.interlaced ? kAdam7Passes : &kSinglePass;
+	const int passCount = header.interlaced ? 7 : 1;
+	size_t rawSize = 0;
+	for (int p = 0; p < passCount; ++p) {
+		const uint32_t passWidth = PassSize(header.width, passes[p].xStart, passes[p].xStep);
+		const uint32_t passHeight = PassSize(header.height, passes[p].yStart, passes[p].yStep);
+		if (passWidth != 0) {
+			rawSize += (1 + RowSize(header, passWidth)) * passHeight;
+		}
+	}
+	std::vector<uint8_t> raw(rawSize);
+	Inflater inflater(compressed.data(), compressed.size(), raw.data(), raw.size());
+	if (!inflater.Inflate() || inflater.OutputSize() != rawSize) {
+		DebugOutputFormatString("DecodePng : broken image data.\n");
+		return false;
+	}
+
+	// tB^[߂Pʂ́A1sNZ̃oCg(1 oCgȂ 1)
+	const size_t bytesPerPixel = (std::max)(static_cast<size_t>(ChannelCount(header.colorType) * header.bitDepth / 8), size_t(1));
+	std::vector<uint8_t> rgbaRow(rgbaRowSize);
+	uint8_t* row = raw.data();
+	for (int p = 0; p < passCount; ++p) {
+		const PngPass& pass = passes[p];
+		const uint32_t passWidth = PassSize(header.width, pass.xStart, pass.xStep);
+		const uint32_t passHeight = PassSize(header.height, pass.yStart, pass.yStep);
+		if (passWidth == 0) {
+			continue;
+		}
+		const size_t rowSize = RowSize(header, passWidth);
+		const std::vector<uint8_t> zeroRow(rowSize, 0);
+		const uint8_t* previous = zeroRow.data();
+		for (uint32_t y = 0; y < passHeight; ++y) {
+			if (!Unfilter(row[0], row + 1, previous, rowSize, bytesPerPixel)) {
+				return false;
+			}
+			uint8_t* out = destination + (pass.yStart + static_cast<size_t>(y) * pass.yStep) * rowPitch;
+			if (pass.xStep == 1) {
+				ConvertRow(header, palette, row + 1, passWidth, out);
+			} else {
+				ConvertRow(header, palette, row + 1, passWidth, rgbaRow.data());
+				for (uint32_t x = 0; x < passWidth; ++x) {
+					std::memcpy(out + (pass.xStart + static_cast<size_t>(x) * pass.xStep) * kRgbaBytesPerPixel, rgbaRow.data() + x * kRgbaBytesPerPixel, kRgbaBytesPerPixel);
+				}
+			}
+			previous = row + 1;
+			row += 1 + rowSize;
+		}
+	}
+	return true;
+}
+}
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace yuxx {
+namespace DirectX12 {
+// ׂĂ̐F`Erbg[xEC^[[XǂށB16bit ͏ 8bit gB
+// bitDepth 1`l̃rbg(pbgȂԍ̃rbg)
+bool ReadPngInfo(const uint8_t* data, size_t size, uint32_t& width, uint32_t& height, uint32_t& bitDepth);
+
+// RGBA e8bit  destination ɃfR[hBtRNS  a ɔf
+bool DecodePng(const uint8_t* data, size_t size, uint8_t* destination, size_t rowPitch, size_t destinationSize);
+}
+}
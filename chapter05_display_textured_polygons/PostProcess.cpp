@@ -0,0 +1,388 @@
+#include "PostProcess.h"
+
+#include <algorithm>
+#include <d3dx12.h>
+
+#include "Helpers.h"
+
+using Microsoft::WRL::ComPtr;
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// [gp[^[̕
+	enum PostProcessRootParameter {
+		kConstantsParameter,
+		kSourceParameter,
+		kSecondSourceParameter,
+		kDestinationParameter,
+		kRootParameterCount,
+	};
+}
+
+const char* PostProcessEntryPoint(PostProcessPass pass)
+{
+	static const char* const kEntryPoints[kPostProcessPassCount] = {
+		"BloomExtractCS",
+		"BlurCS",
+		"TonemapCS",
+		"FxaaCS",
+		"SharpenCS",
+	};
+	return kEntryPoints[pass];
+}
+
+bool PostProcessChain::Initialize(ID3D12Device* device, const PostProcessShaders& shaders, UINT frameCount)
+{
+	m_device = device;
+	m_frames.resize(frameCount);
+	m_outputs.assign(frameCount, kLdrTarget0);
+
+	D3D12_DESCRIPTOR_RANGE ranges[kRootParameterCount - 1] = {};
+	// t0: O̒ȉo
+	ranges[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+	ranges[0].NumDescriptors = 1;
+	ranges[0].BaseShaderRegister = 0;
+	// t1: u[
+	ranges[1].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+	ranges[1].NumDescriptors = 1;
+	ranges[1].BaseShaderRegister = 1;
+	// u0: ݐ
+	ranges[2].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+	ranges[2].NumDescriptors = 1;
+	ranges[2].BaseShaderRegister = 0;
+
+	D3D12_ROOT_PARAMETER rootParameters[kRootParameterCount] = {};
+	// b0: PostProcessConstants
+	rootParameters[kConstantsParameter].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+	rootParameters[kConstantsParameter].Constants.ShaderRegister = 0;
+	rootParameters[kConstantsParameter].Constants.Num32BitValues = sizeof(PostProcessConstants) / sizeof(uint32_t);
+	// iƂɍւ̂Ńe[u1Ă
+	for (int i = kSourceParameter; i < kRootParameterCount; ++i) {
+		rootParameters[i].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+		rootParameters[i].DescriptorTable.pDescriptorRanges = &ranges[i - kSourceParameter];
+		rootParameters[i].DescriptorTable.NumDescriptorRanges = 1;
+	}
+	for (auto& rootParameter : rootParameters) {
+		rootParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+	}
+
+	// s0: `ԁA[̓Nv
+	D3D12_STATIC_SAMPLER_DESC samplerDesc{};
+	samplerDesc.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+	samplerDesc.AddressU = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+	samplerDesc.AddressV = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+	samplerDesc.AddressW = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+	samplerDesc.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+	samplerDesc.BorderColor = D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK;
+	samplerDesc.MinLOD = 0.0f;
+	samplerDesc.MaxLOD = D3D12_FLOAT32_MAX;
+	samplerDesc.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+	D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc{};
+	rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+	rootSignatureDesc.pParameters = rootParameters;
+	rootSignatureDesc.NumParameters = _countof(rootParameters);
+	rootSignatureDesc.pStaticSamplers = &samplerDesc;
+	rootSignatureDesc.NumStaticSamplers = 1;
+
+	ComPtr<ID3DBlob> rootSignatureBlob;
+	ComPtr<ID3D10Blob> errorBlob;
+	HRESULT result = D3D12SerializeRootSignature(
+		&rootSignatureDesc,
+		D3D_ROOT_SIGNATURE_VERSION_1_0,
+		rootSignatureBlob.ReleaseAndGetAddressOf(),
+		errorBlob.ReleaseAndGetAddressOf()
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("D3D12SerializeRootSignature Error (for post process): 0x%x\n", result);
+		return false;
+	}
+	result = device->CreateRootSignature(
+		0,
+		rootSignatureBlob->GetBufferPointer(),
+		rootSignatureBlob->GetBufferSize(),
+		IID_PPV_ARGS(m_rootSignature.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateRootSignature Error (for post process): 0x%x\n", result);
+		return false;
+	}
+
+	for (int pass = 0; pass < kPostProcessPassCount; ++pass) {
+		D3D12_COMPUTE_PIPELINE_STATE_DESC computePipeline{};
+		computePipeline.pRootSignature = m_rootSignature.Get();
+		computePipeline.CS.pShaderBytecode = shaders[pass]->GetBufferPointer();
+		computePipeline.CS.BytecodeLength = shaders[pass]->GetBufferSize();
+		result = device->CreateComputePipelineState(
+			&computePipeline,
+			IID_PPV_ARGS(m_pipelineStates[pass].ReleaseAndGetAddressOf())
+		);
+		if (FAILED(result)) {
+			DebugOutputFormatString(
+				"CreateComputePipelineState Error (%s): 0x%x\n",
+				PostProcessEntryPoint(static_cast<PostProcessPass>(pass)),
+				result
+			);
+			return false;
+		}
+	}
+
+	D3D12_DESCRIPTOR_HEAP_DESC heapDesc{};
+	heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+	heapDesc.NumDescriptors = frameCount * kTargetCount * 2;
+	heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+	result = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(m_descriptorHeap.ReleaseAndGetAddressOf()));
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateDescriptorHeap Error (for post process): 0x%x\n", result);
+		return false;
+	}
+	m_descriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+	D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc{};
+	rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+	rtvHeapDesc.NumDescriptors = frameCount;
+	rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	result = device->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(m_rtvHeap.ReleaseAndGetAddressOf()));
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateDescriptorHeap Error (for HDR target): 0x%x\n", result);
+		return false;
+	}
+	m_rtvDescriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+	return true;
+}
+
+bool PostProcessChain::Resize(UINT width, UINT height)
+{
+	const UINT bloomWidth = BloomTargetSize(width);
+	const UINT bloomHeight = BloomTargetSize(height);
+	for (UINT frame = 0; frame < m_frames.size(); ++frame) {
+		if (!CreateTarget(frame, kHdrTarget, kHdrFormat, width, height) ||
+			!CreateTarget(frame, kBloomTarget0, kHdrFormat, bloomWidth, bloomHeight) ||
+			!CreateTarget(frame, kBloomTarget1, kHdrFormat, bloomWidth, bloomHeight) ||
+			!CreateTarget(frame, kLdrTarget0, kOutputFormat, width, height) ||
+			!CreateTarget(frame, kLdrTarget1, kOutputFormat, width, height)) {
+			return false;
+		}
+		m_outputs[frame] = kLdrTarget0;
+	}
+	return true;
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE PostProcessChain::HdrRenderTargetView(UINT frame) const
+{
+	D3D12_CPU_DESCRIPTOR_HANDLE handle = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
+	handle.ptr += static_cast<SIZE_T>(frame) * m_rtvDescriptorSize;
+	return handle;
+}
+
+bool PostProcessChain::CreateTarget(UINT frame, TargetIndex index, DXGI_FORMAT format, UINT width, UINT height)
+{
+	Target& target = m_frames[frame][index];
+	// HDR ^[Qbgɂ͕`悵AȊO̓Rs[gVF[_[珑
+	const bool isRenderTarget = index == kHdrTarget;
+	target.state = isRenderTarget ? D3D12_RESOURCE_STATE_RENDER_TARGET : D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+	target.width = width;
+	target.height = height;
+
+	const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	const CD3DX12_RESOURCE_DESC resourceDescription = CD3DX12_RESOURCE_DESC::Tex2D(
+		format,
+		width,
+		height,
+		1,
+		1,
+		1,
+		0,
+		isRenderTarget ? D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET : D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
+	);
+	HRESULT result = m_device->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDescription,
+		target.state,
+		nullptr,
+		IID_PPV_ARGS(target.resource.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString(
+			"CreateCommittedResource Error (for post process target %d of frame %u): 0x%x\n",
+			index,
+			frame,
+			result
+		);
+		return false;
+	}
+
+	D3D12_CPU_DESCRIPTOR_HANDLE handle = m_descriptorHeap->GetCPUDescriptorHandleForHeapStart();
+	handle.ptr += static_cast<SIZE_T>(DescriptorIndex(frame, index)) * m_descriptorSize;
+	m_device->CreateShaderResourceView(target.resource.Get(), nullptr, handle);
+	if (isRenderTarget) {
+		m_device->CreateRenderTargetView(target.resource.Get(), nullptr, HdrRenderTargetView(frame));
+	} else {
+		handle.ptr += m_descriptorSize;
+		m_device->CreateUnorderedAccessView(target.resource.Get(), nullptr, nullptr, handle);
+	}
+	return true;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE PostProcessChain::SrvHandle(UINT frame, TargetIndex index) const
+{
+	D3D12_GPU_DESCRIPTOR_HANDLE handle = m_descriptorHeap->GetGPUDescriptorHandleForHeapStart();
+	handle.ptr += static_cast<UINT64>(DescriptorIndex(frame, index)) * m_descriptorSize;
+	return handle;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE PostProcessChain::UavHandle(UINT frame, TargetIndex index) const
+{
+	D3D12_GPU_DESCRIPTOR_HANDLE handle = SrvHandle(frame, index);
+	handle.ptr += m_descriptorSize;
+	return handle;
+}
+
+void PostProcessChain::Transition(
+	ID3D12GraphicsCommandList* commandList,
+	UINT frame,
+	TargetIndex index,
+	D3D12_RESOURCE_STATES state
+) {
+	Target& target = m_frames[frame][index];
+	if (target.state == state) {
+		return;
+	}
+	const auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(target.resource.Get(), target.state, state);
+	commandList->ResourceBarrier(1, &barrier);
+	target.state = state;
+}
+
+void PostProcessChain::Dispatch(
+	ID3D12GraphicsCommandList* commandList,
+	UINT frame,
+	PostProcessPass pass,
+	TargetIndex source,
+	TargetIndex secondSource,
+	TargetIndex destination,
+	const PostProcessConstants& constants
+) {
+	Transition(commandList, frame, source, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+	Transition(commandList, frame, secondSource, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+	Transition(commandList, frame, destination, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+	commandList->SetPipelineState(m_pipelineStates[pass].Get());
+	commandList->SetComputeRoot32BitConstants(
+		kConstantsParameter,
+		sizeof(PostProcessConstants) / sizeof(uint32_t),
+		&constants,
+		0
+	);
+	commandList->SetComputeRootDescriptorTable(kSourceParameter, SrvHandle(frame, source));
+	commandList->SetComputeRootDescriptorTable(kSecondSourceParameter, SrvHandle(frame, secondSource));
+	commandList->SetComputeRootDescriptorTable(kDestinationParameter, UavHandle(frame, destination));
+	commandList->Dispatch(
+		(constants.outputWidth + kPostProcessThreadGroupSize - 1) / kPostProcessThreadGroupSize,
+		(constants.outputHeight + kPostProcessThreadGroupSize - 1) / kPostProcessThreadGroupSize,
+		1
+	);
+}
+
+void PostProcessChain::BeginRendering(ID3D12GraphicsCommandList* commandList, UINT frame)
+{
+	Transition(commandList, frame, kHdrTarget, D3D12_RESOURCE_STATE_RENDER_TARGET);
+}
+
+void PostProcessChain::EndRendering(ID3D12GraphicsCommandList* commandList, UINT frame)
+{
+	// Note: RENDER_TARGET ̑Jڂ̓Rs[gL[̃R}hXgɂ͐ς߂Ȃ
+	Transition(commandList, frame, kHdrTarget, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+}
+
+void PostProcessChain::Record(
+	ID3D12GraphicsCommandList* commandList,
+	UINT frame,
+	const PostProcessSettings& settings,
+	UINT renderWidth,
+	UINT renderHeight
+) {
+	const TargetSet& targets = m_frames[frame];
+	const UINT width = targets[kHdrTarget].width;
+	const UINT height = targets[kHdrTarget].height;
+	const float renderScaleX = static_cast<float>(renderWidth) / width;
+	const float renderScaleY = static_cast<float>(renderHeight) / height;
+
+	ID3D12DescriptorHeap* heaps[] = { m_descriptorHeap.Get() };
+	commandList->SetDescriptorHeaps(1, heaps);
+	commandList->SetComputeRootSignature(m_rootSignature.Get());
+
+	// u[gȂƂ HDR ̂0ő
+	TargetIndex bloom = kHdrTarget;
+	if (settings.bloom) {
+		const UINT bloomWidth = targets[kBloomTarget0].width;
+		const UINT bloomHeight = targets[kBloomTarget0].height;
+		Dispatch(
+			commandList,
+			frame,
+			kBloomExtractPass,
+			kHdrTarget,
+			kHdrTarget,
+			kBloomTarget0,
+			MakePostProcessConstants(bloomWidth, bloomHeight, settings, 0, renderScaleX, renderScaleY)
+		);
+		Dispatch(
+			commandList,
+			frame,
+			kBlurPass,
+			kBloomTarget0,
+			kBloomTarget0,
+			kBloomTarget1,
+			MakePostProcessConstants(bloomWidth, bloomHeight, settings, 0, renderScaleX, renderScaleY)
+		);
+		Dispatch(
+			commandList,
+			frame,
+			kBlurPass,
+			kBloomTarget1,
+			kBloomTarget1,
+			kBloomTarget0,
+			MakePostProcessConstants(bloomWidth, bloomHeight, settings, 1, renderScaleX, renderScaleY)
+		);
+		bloom = kBloomTarget0;
+	}
+
+	const PostProcessConstants constants =
+		MakePostProcessConstants(width, height, settings, 0, renderScaleX, renderScaleY);
+	TargetIndex current = kLdrTarget0;
+	TargetIndex spare = kLdrTarget1;
+	Dispatch(commandList, frame, kTonemapPass, kHdrTarget, bloom, current, constants);
+	if (settings.fxaa) {
+		Dispatch(commandList, frame, kFxaaPass, current, current, spare, constants);
+		std::swap(current, spare);
+	}
+	if (settings.sharpen) {
+		Dispatch(commandList, frame, kSharpenPass, current, current, spare, constants);
+		std::swap(current, spare);
+	}
+
+	// obNobt@[ UAV ɂłȂ̂ŁAŌ̒ȉo͕͂`L[ŃRs[
+	Transition(commandList, frame, current, D3D12_RESOURCE_STATE_COPY_SOURCE);
+	m_outputs[frame] = current;
+}
+
+void PostProcessChain::RecordCopyToOutput(ID3D12GraphicsCommandList* commandList, UINT frame, ID3D12Resource* output)
+{
+	const auto toCopyDest = CD3DX12_RESOURCE_BARRIER::Transition(
+		output,
+		D3D12_RESOURCE_STATE_PRESENT,
+		D3D12_RESOURCE_STATE_COPY_DEST
+	);
+	commandList->ResourceBarrier(1, &toCopyDest);
+	commandList->CopyResource(output, m_frames[frame][m_outputs[frame]].resource.Get());
+	const auto toPresent = CD3DX12_RESOURCE_BARRIER::Transition(
+		output,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		D3D12_RESOURCE_STATE_PRESENT
+	);
+	commandList->ResourceBarrier(1, &toPresent);
+}
+}
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "PostProcessReference.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// PostProcess.hlsl ̃Gg[|Cg
+enum PostProcessPass {
+	kBloomExtractPass,
+	kBlurPass,
+	kTonemapPass,
+	kFxaaPass,
+	kSharpenPass,
+	kPostProcessPassCount,
+};
+const char* PostProcessEntryPoint(PostProcessPass pass);
+
+using PostProcessShaders = std::array<Microsoft::WRL::ComPtr<ID3D10Blob>, kPostProcessPassCount>;
+
+// PostProcess.hlsl  numthreads ƍ킹
+constexpr UINT kPostProcessThreadGroupSize = 8;
+
+// ` HDR ^[QbgƁAobNobt@[܂ł̃Rs[gVF[_[̘AȂB
+// HDR ^[Qbg̍̈ꕔɕ`ꍇ(I𑜓x)́Ag[}bvŏo͂̑傫Ɋg傷B
+// ԃeNX`̓u[p(̉𑜓x HDR)ƕ\p(LDR)2AiƂɓւĎg܂킷B
+// `L[ HDR ^[Qbgɕ`ARs[gL[Ń|XgvZXA`L[ŏo͂obNobt@[ɎʂB
+// ̊ԂɎ̃t[`悤ɁAeNX`͓ GPU ɐςރt[̐(frameCount)gŎ
+class PostProcessChain
+{
+public:
+	// CPU (PostProcessReference.h)͂2̊ۂ߂ QuantizeToHalf  QuantizeToUnorm8 ōČ
+	static constexpr DXGI_FORMAT kHdrFormat = DXGI_FORMAT_R16G16B16A16_FLOAT;
+	static constexpr DXGI_FORMAT kOutputFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+	bool Initialize(ID3D12Device* device, const PostProcessShaders& shaders, UINT frameCount);
+	// HDR ^[QbgƒԃeNX`蒼Bo͐(obNobt@[)Ɠ傫ɂ邱ƁB
+	// ǂ̑g GPU ŎgĂȂƂɌĂ
+	bool Resize(UINT width, UINT height);
+
+	UINT Width() const { return m_frames[0][kHdrTarget].width; }
+	UINT Height() const { return m_frames[0][kHdrTarget].height; }
+	D3D12_CPU_DESCRIPTOR_HANDLE HdrRenderTargetView(UINT frame) const;
+
+	// `L[̃R}hXgŁAframe  HDR ^[Qbg RENDER_TARGET ɂ
+	void BeginRendering(ID3D12GraphicsCommandList* commandList, UINT frame);
+	// `L[̃R}hXgŁA`I HDR ^[QbgRs[gL[ǂ߂Ԃɂ
+	void EndRendering(ID3D12GraphicsCommandList* commandList, UINT frame);
+	// Rs[gL[̃R}hXgɁAEndRendering  frame  HDR ^[Qbg̑SiL^B
+	// renderWidth, renderHeight  HDR ^[QbgɎۂɕ`傫
+	void Record(
+		ID3D12GraphicsCommandList* commandList,
+		UINT frame,
+		const PostProcessSettings& settings,
+		UINT renderWidth,
+		UINT renderHeight
+	);
+	// `L[̃R}hXgŁARecord  frame ̏o͂ output ɎʂBoutput  PRESENT ̏ԂœnAԂɖ߂
+	void RecordCopyToOutput(ID3D12GraphicsCommandList* commandList, UINT frame, ID3D12Resource* output);
+
+private:
+	enum TargetIndex {
+		kHdrTarget,
+		kBloomTarget0,
+		kBloomTarget1,
+		kLdrTarget0,
+		kLdrTarget1,
+		kTargetCount,
+	};
+
+	// ԃeNX`ƁA܂̏
+	struct Target
+	{
+		Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+		D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+		UINT width = 0;
+		UINT height = 0;
+	};
+
+	using TargetSet = std::array<Target, kTargetCount>;
+
+	Microsoft::WRL::ComPtr<ID3D12Device> m_device;
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> m_rootSignature;
+	std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, kPostProcessPassCount> m_pipelineStates;
+	// gƁE^[QbgƂ SRV, UAV ̏2ׂ
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_descriptorHeap;
+	// gƂ HDR ^[Qbg
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_rtvHeap;
+	UINT m_descriptorSize = 0;
+	UINT m_rtvDescriptorSize = 0;
+	std::vector<TargetSet> m_frames;
+	// gƂɁARecord ōŌ̒i^[Qbg
+	std::vector<TargetIndex> m_outputs;
+
+	bool CreateTarget(UINT frame, TargetIndex index, DXGI_FORMAT format, UINT width, UINT height);
+	UINT DescriptorIndex(UINT frame, TargetIndex index) const { return (frame * kTargetCount + index) * 2; }
+	D3D12_GPU_DESCRIPTOR_HANDLE SrvHandle(UINT frame, TargetIndex index) const;
+	D3D12_GPU_DESCRIPTOR_HANDLE UavHandle(UINT frame, TargetIndex index) const;
+	void Transition(ID3D12GraphicsCommandList* commandList, UINT frame, TargetIndex index, D3D12_RESOURCE_STATES state);
+	void Dispatch(
+		ID3D12GraphicsCommandList* commandList,
+		UINT frame,
+		PostProcessPass pass,
+		TargetIndex source,
+		TargetIndex secondSource,
+		TargetIndex destination,
+		const PostProcessConstants& constants
+	);
+};
+}
+}
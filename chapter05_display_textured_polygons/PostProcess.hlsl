@@ -0,0 +1,176 @@
+// [g萔œn(PostProcess.h  PostProcessConstants)
+cbuffer PostProcessConstants : register(b0)
+{
+    // ݐ̑傫
+    uint2 outputSize;
+    float2 inverseOutputSize;
+    float bloomThreshold;
+    float bloomIntensity;
+    float exposure;
+    float sharpness;
+    // 0: , 1: c
+    uint blurDirection;
+    // HDR ^[Qbĝ`悵͈͂̊(I𑜓x)
+    float2 renderScale;
+};
+
+// O̒ȉo
+Texture2D<float4> source : register(t0);
+// TonemapCS g(ku[)
+Texture2D<float4> bloom : register(t1);
+RWTexture2D<float4> destination : register(u0);
+SamplerState linearClamp : register(s0);
+
+// 5^bṽKEXd(S + Б4)
+static const float kBlurWeights[5] = { 0.2270270270f, 0.1945945946f, 0.1216216216f, 0.0540540541f, 0.0162162162f };
+static const float3 kLumaWeights = float3(0.299f, 0.587f, 0.114f);
+
+// ͈͊O͒[̉fǂ(Load ͔͈͊O0Ԃ)
+float4 LoadClamped(Texture2D<float4> image, int2 position)
+{
+    uint width;
+    uint height;
+    image.GetDimensions(width, height);
+    position = clamp(position, int2(0, 0), int2(width, height) - 1);
+    return image.Load(int3(position, 0));
+}
+
+// `悵͈͂ŜɈL΂ēǂނ߂ uvB͈͂̊OEȂ悤ɒ[Ŏ~߂
+float2 ToRenderedUv(Texture2D<float4> image, float2 uv)
+{
+    uint width;
+    uint height;
+    image.GetDimensions(width, height);
+    return min(uv * renderScale, renderScale - 0.5f / float2(width, height));
+}
+
+float3 LinearToSrgb(float3 color)
+{
+    float3 low = color * 12.92f;
+    float3 high = 1.055f * pow(color, 1.0f / 2.4f) - 0.055f;
+    // SM5 ł͎OZqvfƂɑI
+    return color <= 0.0031308f ? low : high;
+}
+
+// ACES ̃tB~bNJ[űߎ(Krzysztof Narkowicz)
+float3 TonemapAces(float3 color)
+{
+    float3 numerator = color * (2.51f * color + 0.03f);
+    float3 denominator = color * (2.43f * color + 0.59f) + 0.14f;
+    return saturate(numerator / denominator);
+}
+
+// 邢𔼕̉𑜓xɎo
+[numthreads(8, 8, 1)]
+void BloomExtractCS(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    if (any(dispatchThreadId.xy >= outputSize))
+    {
+        return;
+    }
+    // {Ȃ 2x2 f̂傤ǐ^񒆂ǂނ̂ŁA`Ԃ4f̕ςɂȂ
+    float2 uv = (float2(dispatchThreadId.xy) + 0.5f) * inverseOutputSize;
+    float3 color = source.SampleLevel(linearClamp, ToRenderedUv(source, uv), 0.0f).rgb;
+    destination[dispatchThreadId.xy] = float4(max(color - bloomThreshold, 0.0f), 1.0f);
+}
+
+// \ȃKEXڂBƏc2Ă
+[numthreads(8, 8, 1)]
+void BlurCS(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    if (any(dispatchThreadId.xy >= outputSize))
+    {
+        return;
+    }
+    int2 position = int2(dispatchThreadId.xy);
+    int2 step = blurDirection == 0 ? int2(1, 0) : int2(0, 1);
+    float3 sum = LoadClamped(source, position).rgb * kBlurWeights[0];
+    for (int i = 1; i < 5; ++i)
+    {
+        sum += LoadClamped(source, position + step * i).rgb * kBlurWeights[i];
+        sum += LoadClamped(source, position - step * i).rgb * kBlurWeights[i];
+    }
+    destination[dispatchThreadId.xy] = float4(sum, 1.0f);
+}
+
+// `悵͈͂o͂̑傫Ɋg債ȂAHDR Ƀu[𑫂ăg[}bvAsRGB ɂďo
+[numthreads(8, 8, 1)]
+void TonemapCS(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    if (any(dispatchThreadId.xy >= outputSize))
+    {
+        return;
+    }
+    float2 uv = (float2(dispatchThreadId.xy) + 0.5f) * inverseOutputSize;
+    float3 color = source.SampleLevel(linearClamp, ToRenderedUv(source, uv), 0.0f).rgb;
+    // u[͒o̎_ŏo͑ŜɈL΂Ă
+    color += bloom.SampleLevel(linearClamp, uv, 0.0f).rgb * bloomIntensity;
+    color = TonemapAces(color * exposure);
+    destination[dispatchThreadId.xy] = float4(LinearToSrgb(color), 1.0f);
+}
+
+// FXAA(Timothy Lottes ̊ȈՔ)BPx̌zɉ2ǂō
+[numthreads(8, 8, 1)]
+void FxaaCS(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    if (any(dispatchThreadId.xy >= outputSize))
+    {
+        return;
+    }
+    int2 position = int2(dispatchThreadId.xy);
+    float3 colorM = LoadClamped(source, position).rgb;
+    float lumaNW = dot(LoadClamped(source, position + int2(-1, -1)).rgb, kLumaWeights);
+    float lumaNE = dot(LoadClamped(source, position + int2(1, -1)).rgb, kLumaWeights);
+    float lumaSW = dot(LoadClamped(source, position + int2(-1, 1)).rgb, kLumaWeights);
+    float lumaSE = dot(LoadClamped(source, position + int2(1, 1)).rgb, kLumaWeights);
+    float lumaM = dot(colorM, kLumaWeights);
+
+    float lumaMin = min(lumaM, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+    float lumaMax = max(lumaM, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+    // RgXg̒ႢƂ͐GȂ
+    if (lumaMax - lumaMin < max(0.0312f, lumaMax * 0.125f))
+    {
+        destination[dispatchThreadId.xy] = float4(colorM, 1.0f);
+        return;
+    }
+
+    float2 direction;
+    direction.x = -((lumaNW + lumaNE) - (lumaSW + lumaSE));
+    direction.y = (lumaNW + lumaSW) - (lumaNE + lumaSE);
+    float directionReduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * (0.25f * 0.125f), 1.0f / 128.0f);
+    float inverseDirectionMin = 1.0f / (min(abs(direction.x), abs(direction.y)) + directionReduce);
+    direction = clamp(direction * inverseDirectionMin, -8.0f, 8.0f) * inverseOutputSize;
+
+    float2 uv = (float2(position) + 0.5f) * inverseOutputSize;
+    float3 colorA = 0.5f * (
+        source.SampleLevel(linearClamp, uv + direction * (1.0f / 3.0f - 0.5f), 0.0f).rgb +
+        source.SampleLevel(linearClamp, uv + direction * (2.0f / 3.0f - 0.5f), 0.0f).rgb);
+    float3 colorB = colorA * 0.5f + 0.25f * (
+        source.SampleLevel(linearClamp, uv + direction * -0.5f, 0.0f).rgb +
+        source.SampleLevel(linearClamp, uv + direction * 0.5f, 0.0f).rgb);
+    float lumaB = dot(colorB, kLumaWeights);
+    // ܂œǂŔ͈͂Oꂽ߂g
+    float3 color = (lumaB < lumaMin || lumaB > lumaMax) ? colorA : colorB;
+    destination[dispatchThreadId.xy] = float4(color, 1.0f);
+}
+
+// ㉺EƂ̍߂B̍ŏEőŃNvăn[}
+[numthreads(8, 8, 1)]
+void SharpenCS(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    if (any(dispatchThreadId.xy >= outputSize))
+    {
+        return;
+    }
+    int2 position = int2(dispatchThreadId.xy);
+    float3 center = LoadClamped(source, position).rgb;
+    float3 north = LoadClamped(source, position + int2(0, -1)).rgb;
+    float3 south = LoadClamped(source, position + int2(0, 1)).rgb;
+    float3 west = LoadClamped(source, position + int2(-1, 0)).rgb;
+    float3 east = LoadClamped(source, position + int2(1, 0)).rgb;
+
+    float3 neighborMin = min(center, min(min(north, south), min(west, east)));
+    float3 neighborMax = max(center, max(max(north, south), max(west, east)));
+    float3 sharpened = center + sharpness * (center * 4.0f - (north + south + west + east));
+    destination[dispatchThreadId.xy] = float4(clamp(sharpened, neighborMin, neighborMax), 1.0f);
+}
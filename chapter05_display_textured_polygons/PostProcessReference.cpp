@@ -0,0 +1,375 @@
+#include "PostProcessReference.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// PostProcess.hlsl  kBlurWeights
+	constexpr float kBlurWeights[5] = { 0.2270270270f, 0.1945945946f, 0.1216216216f, 0.0540540541f, 0.0162162162f };
+
+	// VF[_[ float4 ̉Z()
+	Float4 Add(const Float4& a, const Float4& b)
+	{
+		return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w };
+	}
+
+	Float4 Subtract(const Float4& a, const Float4& b)
+	{
+		return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w };
+	}
+
+	Float4 Scale(const Float4& a, float scale)
+	{
+		return { a.x * scale, a.y * scale, a.z * scale, a.w * scale };
+	}
+
+	Float4 Lerp(const Float4& a, const Float4& b, float t)
+	{
+		return Add(a, Scale(Subtract(b, a), t));
+	}
+
+	template <typename Function>
+	Float4 Map(const Float4& a, Function function)
+	{
+		return { function(a.x), function(a.y), function(a.z), function(a.w) };
+	}
+
+	Float4 Min(const Float4& a, const Float4& b)
+	{
+		return { (std::min)(a.x, b.x), (std::min)(a.y, b.y), (std::min)(a.z, b.z), (std::min)(a.w, b.w) };
+	}
+
+	Float4 Max(const Float4& a, const Float4& b)
+	{
+		return { (std::max)(a.x, b.x), (std::max)(a.y, b.y), (std::max)(a.z, b.z), (std::max)(a.w, b.w) };
+	}
+
+	Float4 Clamp(const Float4& a, const Float4& low, const Float4& high)
+	{
+		return Min(Max(a, low), high);
+	}
+
+	float Saturate(float value)
+	{
+		return (std::min)((std::max)(value, 0.0f), 1.0f);
+	}
+
+	Float4 LoadClamped(const PostProcessImage& image, int x, int y)
+	{
+		x = (std::min)((std::max)(x, 0), static_cast<int>(image.width) - 1);
+		y = (std::min)((std::max)(y, 0), static_cast<int>(image.height) - 1);
+		return image.pixels[static_cast<size_t>(y) * image.width + x];
+	}
+
+	// `ԁENṽTv[Ɠǂݕ
+	Float4 SampleLinearClamp(const PostProcessImage& image, float u, float v)
+	{
+		const float x = u * image.width - 0.5f;
+		const float y = v * image.height - 0.5f;
+		const float x0 = std::floor(x);
+		const float y0 = std::floor(y);
+		const int ix = static_cast<int>(x0);
+		const int iy = static_cast<int>(y0);
+		const Float4 top = Lerp(LoadClamped(image, ix, iy), LoadClamped(image, ix + 1, iy), x - x0);
+		const Float4 bottom = Lerp(LoadClamped(image, ix, iy + 1), LoadClamped(image, ix + 1, iy + 1), x - x0);
+		return Lerp(top, bottom, y - y0);
+	}
+
+	// PostProcess.hlsl  ToRenderedUv
+	void ToRenderedUv(const PostProcessImage& image, const PostProcessConstants& constants, float& u, float& v)
+	{
+		u = (std::min)(u * constants.renderScaleX, constants.renderScaleX - 0.5f / image.width);
+		v = (std::min)(v * constants.renderScaleY, constants.renderScaleY - 0.5f / image.height);
+	}
+
+	float Luma(const Float4& color)
+	{
+		return color.x * 0.299f + color.y * 0.587f + color.z * 0.114f;
+	}
+
+	float LinearToSrgb(float value)
+	{
+		return value <= 0.0031308f ? value * 12.92f : std::pow(value, 1.0f / 2.4f) * 1.055f - 0.055f;
+	}
+
+	float TonemapAces(float value)
+	{
+		return Saturate((value * (2.51f * value + 0.03f)) / (value * (2.43f * value + 0.59f) + 0.14f));
+	}
+
+	// a  1 ɂď
+	void StorePixel(PostProcessImage& image, uint32_t x, uint32_t y, const Float4& color)
+	{
+		image.pixels[static_cast<size_t>(y) * image.width + x] = { color.x, color.y, color.z, 1.0f };
+	}
+
+	void ResizeImage(PostProcessImage& image, const PostProcessConstants& constants)
+	{
+		image.width = constants.outputWidth;
+		image.height = constants.outputHeight;
+		image.pixels.resize(static_cast<size_t>(image.width) * image.height);
+	}
+
+	// float  half Ɋۂ߂Ė߂(ŋߐڋۂ߁Bhalf ŕ\Ȃ傫͖ɂ)
+	float RoundToHalf(float value)
+	{
+		uint32_t bits = 0;
+		std::memcpy(&bits, &value, sizeof(bits));
+		const uint32_t sign = bits & 0x80000000u;
+		const uint32_t magnitude = bits & 0x7fffffffu;
+		uint32_t rounded = 0;
+		if (magnitude >= 0x7f800000u) {
+			//  NaN ͂̂܂
+			rounded = magnitude;
+		} else if (magnitude >= 0x477ff000u) {
+			// 65520 ȏ half ̍ől𒴂ĖɊۂ܂
+			rounded = 0x7f800000u;
+		} else if (magnitude < 0x38800000u) {
+			// half ̔񐳋K(2^-24 ̔{)
+			const float step = 5.9604644775390625e-8f;
+			float absolute = 0.0f;
+			std::memcpy(&absolute, &magnitude, sizeof(absolute));
+			const float quantized = std::nearbyint(absolute / step) * step;
+			std::memcpy(&rounded, &quantized, sizeof(rounded));
+		} else {
+			// ̉ 13 rbgŋߐڋŗƂ
+			const uint32_t lsb = (magnitude >> 13) & 1u;
+			rounded = (magnitude + 0x0fffu + lsb) & ~0x1fffu;
+		}
+		const uint32_t result = sign | rounded;
+		float output = 0.0f;
+		std::memcpy(&output, &result, sizeof(output));
+		return output;
+	}
+
+	float RoundToUnorm8(float value)
+	{
+		return std::nearbyint(Saturate(value) * 255.0f) / 255.0f;
+	}
+}
+
+PostProcessConstants MakePostProcessConstants(
+	uint32_t outputWidth,
+	uint32_t outputHeight,
+	const PostProcessSettings& settings,
+	uint32_t blurDirection,
+	float renderScaleX,
+	float renderScaleY
+) {
+	PostProcessConstants constants{};
+	constants.outputWidth = outputWidth;
+	constants.outputHeight = outputHeight;
+	constants.inverseOutputWidth = 1.0f / outputWidth;
+	constants.inverseOutputHeight = 1.0f / outputHeight;
+	constants.bloomThreshold = settings.bloomThreshold;
+	constants.bloomIntensity = settings.bloom ? settings.bloomIntensity : 0.0f;
+	constants.exposure = settings.exposure;
+	constants.sharpness = settings.sharpness;
+	constants.blurDirection = blurDirection;
+	constants.renderScaleX = renderScaleX;
+	constants.renderScaleY = renderScaleY;
+	return constants;
+}
+
+uint32_t BloomTargetSize(uint32_t size)
+{
+	return (std::max)((size + 1) / 2, 1u);
+}
+
+void BloomExtractReference(
+	const PostProcessImage& source,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+) {
+	ResizeImage(destination, constants);
+	const Float4 threshold = { constants.bloomThreshold, constants.bloomThreshold, constants.bloomThreshold, constants.bloomThreshold };
+	for (uint32_t y = 0; y < destination.height; ++y) {
+		for (uint32_t x = 0; x < destination.width; ++x) {
+			float u = (x + 0.5f) * constants.inverseOutputWidth;
+			float v = (y + 0.5f) * constants.inverseOutputHeight;
+			ToRenderedUv(source, constants, u, v);
+			const Float4 color = SampleLinearClamp(source, u, v);
+			StorePixel(destination, x, y, Max(Subtract(color, threshold), { 0.0f, 0.0f, 0.0f, 0.0f }));
+		}
+	}
+}
+
+void BlurReference(
+	const PostProcessImage& source,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+) {
+	ResizeImage(destination, constants);
+	const int stepX = constants.blurDirection == 0 ? 1 : 0;
+	const int stepY = constants.blurDirection == 0 ? 0 : 1;
+	for (uint32_t y = 0; y < destination.height; ++y) {
+		for (uint32_t x = 0; x < destination.width; ++x) {
+			const int ix = static_cast<int>(x);
+			const int iy = static_cast<int>(y);
+			Float4 sum = Scale(LoadClamped(source, ix, iy), kBlurWeights[0]);
+			for (int i = 1; i < 5; ++i) {
+				sum = Add(sum, Scale(LoadClamped(source, ix + stepX * i, iy + stepY * i), kBlurWeights[i]));
+				sum = Add(sum, Scale(LoadClamped(source, ix - stepX * i, iy - stepY * i), kBlurWeights[i]));
+			}
+			StorePixel(destination, x, y, sum);
+		}
+	}
+}
+
+void TonemapReference(
+	const PostProcessImage& source,
+	const PostProcessImage& bloom,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+) {
+	ResizeImage(destination, constants);
+	for (uint32_t y = 0; y < destination.height; ++y) {
+		for (uint32_t x = 0; x < destination.width; ++x) {
+			const float u = (x + 0.5f) * constants.inverseOutputWidth;
+			const float v = (y + 0.5f) * constants.inverseOutputHeight;
+			float renderedU = u;
+			float renderedV = v;
+			ToRenderedUv(source, constants, renderedU, renderedV);
+			Float4 color = SampleLinearClamp(source, renderedU, renderedV);
+			const Float4 bloomColor = SampleLinearClamp(bloom, u, v);
+			color = Add(color, Scale(bloomColor, constants.bloomIntensity));
+			color = Map(Scale(color, constants.exposure), TonemapAces);
+			StorePixel(destination, x, y, Map(color, LinearToSrgb));
+		}
+	}
+}
+
+void FxaaReference(
+	const PostProcessImage& source,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+) {
+	ResizeImage(destination, constants);
+	for (uint32_t y = 0; y < destination.height; ++y) {
+		for (uint32_t x = 0; x < destination.width; ++x) {
+			const int ix = static_cast<int>(x);
+			const int iy = static_cast<int>(y);
+			const Float4 colorM = LoadClamped(source, ix, iy);
+			const float lumaNW = Luma(LoadClamped(source, ix - 1, iy - 1));
+			const float lumaNE = Luma(LoadClamped(source, ix + 1, iy - 1));
+			const float lumaSW = Luma(LoadClamped(source, ix - 1, iy + 1));
+			const float lumaSE = Luma(LoadClamped(source, ix + 1, iy + 1));
+			const float lumaM = Luma(colorM);
+
+			const float lumaMin = (std::min)(lumaM, (std::min)((std::min)(lumaNW, lumaNE), (std::min)(lumaSW, lumaSE)));
+			const float lumaMax = (std::max)(lumaM, (std::max)((std::max)(lumaNW, lumaNE), (std::max)(lumaSW, lumaSE)));
+			if (lumaMax - lumaMin < (std::max)(0.0312f, lumaMax * 0.125f)) {
+				StorePixel(destination, x, y, colorM);
+				continue;
+			}
+
+			const float directionX = -((lumaNW + lumaNE) - (lumaSW + lumaSE));
+			const float directionY = (lumaNW + lumaSW) - (lumaNE + lumaSE);
+			const float directionReduce = (std::max)((lumaNW + lumaNE + lumaSW + lumaSE) * (0.25f * 0.125f), 1.0f / 128.0f);
+			const float inverseDirectionMin =
+				1.0f / ((std::min)(std::abs(directionX), std::abs(directionY)) + directionReduce);
+			const float stepU = (std::min)((std::max)(directionX * inverseDirectionMin, -8.0f), 8.0f) * constants.inverseOutputWidth;
+			const float stepV = (std::min)((std::max)(directionY * inverseDirectionMin, -8.0f), 8.0f) * constants.inverseOutputHeight;
+
+			const float u = (x + 0.5f) * constants.inverseOutputWidth;
+			const float v = (y + 0.5f) * constants.inverseOutputHeight;
+			auto sampleAt = [&](float offset) {
+				return SampleLinearClamp(source, stepU * offset + u, stepV * offset + v);
+			};
+			const Float4 colorA = Scale(Add(sampleAt(1.0f / 3.0f - 0.5f), sampleAt(2.0f / 3.0f - 0.5f)), 0.5f);
+			const Float4 colorB = Add(Scale(colorA, 0.5f), Scale(Add(sampleAt(-0.5f), sampleAt(0.5f)), 0.25f));
+			const float lumaB = Luma(colorB);
+			StorePixel(destination, x, y, (lumaB < lumaMin || lumaB > lumaMax) ? colorA : colorB);
+		}
+	}
+}
+
+void SharpenReference(
+	const PostProcessImage& source,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+) {
+	ResizeImage(destination, constants);
+	for (uint32_t y = 0; y < destination.height; ++y) {
+		for (uint32_t x = 0; x < destination.width; ++x) {
+			const int ix = static_cast<int>(x);
+			const int iy = static_cast<int>(y);
+			const Float4 center = LoadClamped(source, ix, iy);
+			const Float4 north = LoadClamped(source, ix, iy - 1);
+			const Float4 south = LoadClamped(source, ix, iy + 1);
+			const Float4 west = LoadClamped(source, ix - 1, iy);
+			const Float4 east = LoadClamped(source, ix + 1, iy);
+
+			const Float4 neighborMin = Min(center, Min(Min(north, south), Min(west, east)));
+			const Float4 neighborMax = Max(center, Max(Max(north, south), Max(west, east)));
+			const Float4 neighborSum = Add(Add(north, south), Add(west, east));
+			const Float4 sharpened = Add(center, Scale(Subtract(Scale(center, 4.0f), neighborSum), constants.sharpness));
+			StorePixel(destination, x, y, Clamp(sharpened, neighborMin, neighborMax));
+		}
+	}
+}
+
+void QuantizeToHalf(PostProcessImage& image)
+{
+	for (Float4& pixel : image.pixels) {
+		pixel = Map(pixel, RoundToHalf);
+	}
+}
+
+void QuantizeToUnorm8(PostProcessImage& image)
+{
+	for (Float4& pixel : image.pixels) {
+		pixel = Map(pixel, RoundToUnorm8);
+	}
+}
+
+void RunPostProcessReference(
+	const PostProcessImage& hdr,
+	const PostProcessSettings& settings,
+	uint32_t renderWidth,
+	uint32_t renderHeight,
+	PostProcessImage& output
+) {
+	const float renderScaleX = static_cast<float>(renderWidth) / hdr.width;
+	const float renderScaleY = static_cast<float>(renderHeight) / hdr.height;
+	PostProcessImage bloom0;
+	PostProcessImage bloom1;
+	const PostProcessImage* bloom = &hdr;
+	if (settings.bloom) {
+		const uint32_t bloomWidth = BloomTargetSize(hdr.width);
+		const uint32_t bloomHeight = BloomTargetSize(hdr.height);
+		const PostProcessConstants horizontal =
+			MakePostProcessConstants(bloomWidth, bloomHeight, settings, 0, renderScaleX, renderScaleY);
+		const PostProcessConstants vertical =
+			MakePostProcessConstants(bloomWidth, bloomHeight, settings, 1, renderScaleX, renderScaleY);
+		BloomExtractReference(hdr, horizontal, bloom0);
+		QuantizeToHalf(bloom0);
+		BlurReference(bloom0, horizontal, bloom1);
+		QuantizeToHalf(bloom1);
+		BlurReference(bloom1, vertical, bloom0);
+		QuantizeToHalf(bloom0);
+		bloom = &bloom0;
+	}
+
+	const PostProcessConstants constants =
+		MakePostProcessConstants(hdr.width, hdr.height, settings, 0, renderScaleX, renderScaleY);
+	PostProcessImage spare;
+	TonemapReference(hdr, *bloom, constants, output);
+	QuantizeToUnorm8(output);
+	if (settings.fxaa) {
+		FxaaReference(output, constants, spare);
+		QuantizeToUnorm8(spare);
+		std::swap(output, spare);
+	}
+	if (settings.sharpen) {
+		SharpenReference(output, constants, spare);
+		QuantizeToUnorm8(spare);
+		std::swap(output, spare);
+	}
+}
+}
+}
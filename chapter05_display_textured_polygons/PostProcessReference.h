@@ -0,0 +1,97 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "VectorMath.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// PostProcess.hlsl  PostProcessConstants ƓCAEg([g萔œn)
+struct PostProcessConstants
+{
+	uint32_t outputWidth;
+	uint32_t outputHeight;
+	float inverseOutputWidth;
+	float inverseOutputHeight;
+	float bloomThreshold;
+	float bloomIntensity;
+	float exposure;
+	float sharpness;
+	uint32_t blurDirection;
+	float renderScaleX;
+	float renderScaleY;
+};
+
+// iƂ̃IEItƃp[^[Bg[}bv HDR \ł`ɂ̂ŏɍs
+struct PostProcessSettings
+{
+	bool bloom = true;
+	float bloomThreshold = 1.0f;
+	float bloomIntensity = 0.5f;
+	float exposure = 1.0f;
+	bool fxaa = true;
+	bool sharpen = true;
+	float sharpness = 0.2f;
+};
+
+PostProcessConstants MakePostProcessConstants(
+	uint32_t outputWidth,
+	uint32_t outputHeight,
+	const PostProcessSettings& settings,
+	uint32_t blurDirection,
+	float renderScaleX,
+	float renderScaleY
+);
+// u[̒ԃeNX`̑傫(ɐ؂グAŏ 1)
+uint32_t BloomTargetSize(uint32_t size);
+
+// ei CPU ŁBGPU ̌ʂƓ˂킹邽߂ɎgBD3D12 ɈˑȂ̂ Windows ȊOłB
+// vZ̏̓VF[_[ƑĂ̂ Load œǂޒi(ڂEV[v)͈vB
+// `Ԃœǂޒi(u[̒oEg[}bvEFXAA) GPU ̃tB^[x̕邱Ƃ
+struct PostProcessImage
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector<Float4> pixels;
+};
+
+void BloomExtractReference(
+	const PostProcessImage& source,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+);
+void BlurReference(
+	const PostProcessImage& source,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+);
+void TonemapReference(
+	const PostProcessImage& source,
+	const PostProcessImage& bloom,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+);
+void FxaaReference(
+	const PostProcessImage& source,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+);
+void SharpenReference(
+	const PostProcessImage& source,
+	const PostProcessConstants& constants,
+	PostProcessImage& destination
+);
+// HDR ̒ԃeNX`(R16G16B16A16_FLOAT)ɏ񂾂Ƃ̊ۂ߂Č
+void QuantizeToHalf(PostProcessImage& image);
+// \p̒ԃeNX`(R8G8B8A8_UNORM)ɏ񂾂Ƃ̊ۂ߂Č
+void QuantizeToUnorm8(PostProcessImage& image);
+// PostProcessChain::Record ƓɑSiʂBhdr ̍ renderWidth x renderHeight `͈͂ƂĈ
+void RunPostProcessReference(
+	const PostProcessImage& hdr,
+	const PostProcessSettings& settings,
+	uint32_t renderWidth,
+	uint32_t renderHeight,
+	PostProcessImage& output
+);
+}
+}
@@ -0,0 +1,90 @@
+#include "QueueTimelineSimulator.h"
+
+#include <algorithm>
+
+namespace yuxx {
+namespace DirectX12 {
+uint64_t QueueTimelineSimulator::SubmitGraphics(uint32_t slot)
+{
+	return Submit(Work::Graphics, GpuQueueType::Direct, slot, m_durations.graphics);
+}
+
+uint64_t QueueTimelineSimulator::SubmitPostProcess(uint32_t slot)
+{
+	return Submit(Work::PostProcess, GpuQueueType::Compute, slot, m_durations.postProcess);
+}
+
+uint64_t QueueTimelineSimulator::SubmitPresent(uint32_t slot)
+{
+	return Submit(Work::Present, GpuQueueType::Direct, slot, m_durations.present);
+}
+
+void QueueTimelineSimulator::WaitOnGpu(GpuQueueType queue, GpuQueueType signalingQueue, uint64_t fenceValue)
+{
+	double time = 0.0;
+	if (!FenceTime(signalingQueue, fenceValue, time)) {
+		++m_invalidWaitCount;
+		return;
+	}
+	// L[͏ɎŝŁAȍ~̏͂̎Oɂ͎n܂Ȃ
+	Queue& waiting = GetQueue(queue);
+	waiting.availableTime = (std::max)(waiting.availableTime, time);
+}
+
+void QueueTimelineSimulator::WaitOnCpu(GpuQueueType queue, uint64_t fenceValue)
+{
+	double time = 0.0;
+	if (!FenceTime(queue, fenceValue, time)) {
+		++m_invalidWaitCount;
+		return;
+	}
+	if (time > m_cpuTime) {
+		m_cpuWaitTime += time - m_cpuTime;
+		m_cpuTime = time;
+	}
+}
+
+const QueueTimelineSimulator::Event* QueueTimelineSimulator::Find(Work work, uint64_t frame) const
+{
+	for (const Event& event : m_events) {
+		if (event.work == work && event.frame == frame) {
+			return &event;
+		}
+	}
+	return nullptr;
+}
+
+uint64_t QueueTimelineSimulator::Submit(Work work, GpuQueueType queueType, uint32_t slot, double duration)
+{
+	Queue& queue = GetQueue(queueType);
+	Event event;
+	event.work = work;
+	event.queue = queueType;
+	event.slot = slot;
+	event.frame = m_workCounts[static_cast<size_t>(work)]++;
+	event.submitTime = m_cpuTime;
+	event.startTime = (std::max)(m_cpuTime, queue.availableTime);
+	event.endTime = event.startTime + duration;
+	queue.availableTime = event.endTime;
+	queue.fenceTimes.push_back(event.endTime);
+	event.fenceValue = queue.fenceTimes.size();
+	m_events.push_back(event);
+	return event.fenceValue;
+}
+
+bool QueueTimelineSimulator::FenceTime(GpuQueueType queue, uint64_t fenceValue, double& time)
+{
+	// 0 ͍ŏBĂ
+	if (fenceValue == 0) {
+		time = 0.0;
+		return true;
+	}
+	const std::vector<double>& fenceTimes = GetQueue(queue).fenceTimes;
+	if (fenceValue > fenceTimes.size()) {
+		return false;
+	}
+	time = fenceTimes[fenceValue - 1];
+	return true;
+}
+}
+}
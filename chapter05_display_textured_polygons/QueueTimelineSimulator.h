@@ -0,0 +1,87 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "FramePipeline.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// FrameQueues AƂ̏vԂœV~[^[B
+// L[͐ς܂ꂽ1AGPU ̑҂ĂsBԂ̒Pʂ̓~b
+class QueueTimelineSimulator : public FrameQueues
+{
+public:
+	enum class Work {
+		Graphics,
+		PostProcess,
+		Present,
+	};
+
+	// ς܂ꂽ1
+	struct Event
+	{
+		Work work;
+		GpuQueueType queue;
+		uint32_t slot;
+		// ς܂ꂽ̒ʂԍ(Work )Bԍ Graphics, PostProcess, Present t[
+		uint64_t frame;
+		uint64_t fenceValue;
+		double submitTime;
+		double startTime;
+		double endTime;
+	};
+
+	struct Durations
+	{
+		double graphics = 10.0;
+		double postProcess = 5.0;
+		double present = 0.5;
+	};
+
+	explicit QueueTimelineSimulator(const Durations& durations) : m_durations(durations) {}
+
+	void SetDurations(const Durations& durations) { m_durations = durations; }
+	// CPU ŋL^ȂǂĂ鎞
+	void AdvanceCpu(double milliseconds) { m_cpuTime += milliseconds; }
+
+	uint64_t SubmitGraphics(uint32_t slot) override;
+	uint64_t SubmitPostProcess(uint32_t slot) override;
+	uint64_t SubmitPresent(uint32_t slot) override;
+	void WaitOnGpu(GpuQueueType queue, GpuQueueType signalingQueue, uint64_t fenceValue) override;
+	void WaitOnCpu(GpuQueueType queue, uint64_t fenceValue) override;
+
+	double CpuTime() const { return m_cpuTime; }
+	// WaitOnCpu  CPU ~܂ĂԂ̍v
+	double CpuWaitTime() const { return m_cpuWaitTime; }
+	// ܂ς܂ĂȂtFXl҂(ۂ GPU Ȃ~܂܂܂ɂȂ)
+	uint32_t InvalidWaitCount() const { return m_invalidWaitCount; }
+	const std::vector<Event>& Events() const { return m_events; }
+	// work  frame Ԗڂ̏BȂ nullptr
+	const Event* Find(Work work, uint64_t frame) const;
+
+private:
+	struct Queue
+	{
+		// ̏n߂鎞(Ȍ̏I GPU ̑҂)
+		double availableTime = 0.0;
+		// fenceTimes[v - 1] tFXl v ɒB鎞
+		std::vector<double> fenceTimes;
+	};
+
+	Durations m_durations;
+	double m_cpuTime = 0.0;
+	double m_cpuWaitTime = 0.0;
+	uint32_t m_invalidWaitCount = 0;
+	std::array<Queue, 2> m_queues;
+	std::array<uint64_t, 3> m_workCounts = {};
+	std::vector<Event> m_events;
+
+	uint64_t Submit(Work work, GpuQueueType queueType, uint32_t slot, double duration);
+	Queue& GetQueue(GpuQueueType queue) { return m_queues[static_cast<size_t>(queue)]; }
+	// tFXlɒB鎞B܂ς܂ĂȂ false
+	bool FenceTime(GpuQueueType queue, uint64_t fenceValue, double& time);
+};
+}
+}
@@ -0,0 +1,102 @@
+#include "RenderThread.h"
+
+#include <chrono>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// pPbgȂƂɁAO yield ő҂
+	constexpr int kSpinCount = 64;
+}
+
+RenderThread::RenderThread()
+{
+	for (FramePacket& packet : m_packets) {
+		m_freePackets.TryPush(&packet);
+	}
+}
+
+RenderThread::~RenderThread()
+{
+	Stop();
+}
+
+void RenderThread::Start(FrameFunction renderFrame, CommandFunction executeCommand)
+{
+	if (m_thread.joinable()) {
+		return;
+	}
+	m_renderFrame = std::move(renderFrame);
+	m_executeCommand = std::move(executeCommand);
+	m_stopping = false;
+	m_failed = false;
+	m_thread = std::thread(&RenderThread::ThreadLoop, this);
+}
+
+void RenderThread::Stop()
+{
+	if (!m_thread.joinable()) {
+		return;
+	}
+	m_stopping = true;
+	m_thread.join();
+
+	// `ȂpPbg߂鑤ɖ߂Av͎̂Ă
+	FramePacket* packet = nullptr;
+	while (m_readyPackets.TryPop(packet)) {
+		m_freePackets.TryPush(packet);
+	}
+	RenderCommand command;
+	while (m_commands.TryPop(command)) {
+	}
+}
+
+bool RenderThread::PostCommand(const RenderCommand& command)
+{
+	return m_commands.TryPush(command);
+}
+
+FramePacket* RenderThread::BeginFramePacket()
+{
+	FramePacket* packet = nullptr;
+	return m_freePackets.TryPop(packet) ? packet : nullptr;
+}
+
+void RenderThread::SubmitFramePacket(FramePacket* packet)
+{
+	// pPbg2Ȃ̂ŁAK
+	m_readyPackets.TryPush(packet);
+}
+
+void RenderThread::ThreadLoop()
+{
+	int idleCount = 0;
+	while (!m_stopping.load(std::memory_order_acquire)) {
+		FramePacket* packet = nullptr;
+		if (!m_readyPackets.TryPop(packet)) {
+			// ̓Xbh1t[܂Őił̂ӂȂ̂ŁAő҂Ƃ͏Ȃ
+			if (++idleCount < kSpinCount) {
+				std::this_thread::yield();
+			} else {
+				std::this_thread::sleep_for(std::chrono::microseconds(500));
+			}
+			continue;
+		}
+		idleCount = 0;
+
+		RenderCommand command;
+		while (m_commands.TryPop(command)) {
+			m_executeCommand(command);
+		}
+		const bool rendered = m_renderFrame(*packet);
+		m_freePackets.TryPush(packet);
+		if (!rendered) {
+			// ̓Xbh Failed ăC[v𔲂AStop ő҂
+			m_failed.store(true, std::memory_order_release);
+			return;
+		}
+		m_renderedFrameCount.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+}
+}
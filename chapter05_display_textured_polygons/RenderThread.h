@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include "SpscQueue.h"
+#include "VectorMath.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// ̓XbhŌ߂āA`Xbhɓn1t[̏
+struct FramePacket
+{
+	uint64_t frameIndex = 0;
+	Float4x4 viewProjection;
+	// `悷傫BXbv`F[ƈႦ΁A`Xbht[̓ō蒼
+	uint32_t width = 0;
+	uint32_t height = 0;
+};
+
+// ̓Xbh`Xbhւ̒P̗v
+struct RenderCommand
+{
+	enum Type : uint8_t {
+		kCaptureFrame,
+		kReplayCapture,
+		kRunRecorderBenchmark,
+	};
+	Type type = kCaptureFrame;
+};
+
+// bZ[WXbhƂ͕ʂ̃Xbhŕ`悷B
+// t[pPbg2g񂵁A̓Xbh͕`撆̃t[1܂łi܂ȂB
+// ͂ǂ SpscQueue ōsAbN͎gȂ
+class RenderThread
+{
+public:
+	// `Ɏs false ԂBȍ~̃pPbg͕`Ȃ
+	using FrameFunction = std::function<bool(const FramePacket&)>;
+	using CommandFunction = std::function<void(const RenderCommand&)>;
+
+	// ςłv̐
+	static constexpr size_t kCommandCapacity = 64;
+	static constexpr size_t kFramePacketCount = 2;
+
+	RenderThread();
+	RenderThread(const RenderThread&) = delete;
+	RenderThread& operator=(const RenderThread&) = delete;
+	~RenderThread();
+
+	// renderFrame  executeCommand ͕`XbhŌĂ΂B
+	// v͂OɑꂽpPbg`Oɂ܂Ƃ߂ď
+	void Start(FrameFunction renderFrame, CommandFunction executeCommand);
+	// `Ăr̃t[IĂXbh~߂BcpPbgƗv͎̂Ă
+	void Stop();
+	bool IsRunning() const { return m_thread.joinable(); }
+
+	// ȉ͓̓XbhĂ
+	// vς݂Ȃ false
+	bool PostCommand(const RenderCommand& command);
+	// ߂pPbgB2Ƃ`XbhĂ nullptr
+	FramePacket* BeginFramePacket();
+	void SubmitFramePacket(FramePacket* packet);
+
+	// `It[̐(ǂ̃Xbhłǂ߂)
+	uint64_t RenderedFrameCount() const { return m_renderedFrameCount.load(std::memory_order_relaxed); }
+	// renderFrame  false Ԃĕ`߂(ǂ̃Xbhłǂ߂)BStart Ŗ߂
+	bool Failed() const { return m_failed.load(std::memory_order_acquire); }
+
+private:
+	FramePacket m_packets[kFramePacketCount];
+	// `Xbh -> ̓Xbh(߂pPbg)
+	SpscQueue<FramePacket*, kFramePacketCount> m_freePackets;
+	// ̓Xbh -> `Xbh(`pPbg)
+	SpscQueue<FramePacket*, kFramePacketCount> m_readyPackets;
+	SpscQueue<RenderCommand, kCommandCapacity> m_commands;
+
+	FrameFunction m_renderFrame;
+	CommandFunction m_executeCommand;
+	std::atomic<bool> m_stopping{ false };
+	std::atomic<bool> m_failed{ false };
+	std::atomic<uint64_t> m_renderedFrameCount{ 0 };
+	std::thread m_thread;
+
+	void ThreadLoop();
+};
+}
+}
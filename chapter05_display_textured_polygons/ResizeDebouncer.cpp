@@ -0,0 +1,52 @@
+#include "ResizeDebouncer.h"
+
+namespace yuxx {
+namespace DirectX12 {
+ResizeDebouncer::ResizeDebouncer(Clock::duration settleTime) :
+	m_settleTime(settleTime)
+{
+}
+
+void ResizeDebouncer::Reset(uint32_t width, uint32_t height)
+{
+	m_width = width;
+	m_height = height;
+	m_hasPending = false;
+	m_sizing = false;
+}
+
+void ResizeDebouncer::OnResize(uint32_t width, uint32_t height, bool sizing, Clock::time_point now)
+{
+	m_sizing = sizing;
+	if (width == 0 || height == 0) {
+		return;
+	}
+	if (width == m_width && height == m_height) {
+		// ̑傫ɖ߂ȂA蒼Kv͂Ȃ
+		m_hasPending = false;
+		return;
+	}
+	if (!m_hasPending || width != m_pendingWidth || height != m_pendingHeight) {
+		m_pendingWidth = width;
+		m_pendingHeight = height;
+		m_pendingTime = now;
+	}
+	m_hasPending = true;
+}
+
+bool ResizeDebouncer::Update(Clock::time_point now)
+{
+	if (!m_hasPending) {
+		return false;
+	}
+	// ő剻hbȌI͂fBhbO͎~܂Ă΂炭Ă
+	if (m_sizing && now - m_pendingTime < m_settleTime) {
+		return false;
+	}
+	m_width = m_pendingWidth;
+	m_height = m_pendingHeight;
+	m_hasPending = false;
+	return true;
+}
+}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace yuxx {
+namespace DirectX12 {
+// EBhȆ傫̕ωAXbv`F[蒼傫߂B
+// ghbOĂԂ WM_SIZE \̂ŁA傫 settleTime ̊
+// ςȂƂ(hbOIƂ)fA蒼ŏɂ
+class ResizeDebouncer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit ResizeDebouncer(Clock::duration settleTime = std::chrono::milliseconds(100));
+
+	// ̃Xbv`F[̑傫
+	void Reset(uint32_t width, uint32_t height);
+	// WM_SIZE 󂯎Bsizing ͘ghbOĂrȂ trueB
+	// ŏƂ(0 x 0)͖Ȃ傫̂܂܂ɂ
+	void OnResize(uint32_t width, uint32_t height, bool sizing, Clock::time_point now);
+	// fׂύXΑ傫i߂ true Ԃ
+	bool Update(Clock::time_point now);
+
+	uint32_t Width() const { return m_width; }
+	uint32_t Height() const { return m_height; }
+	bool HasPendingResize() const { return m_hasPending; }
+
+private:
+	Clock::duration m_settleTime;
+	uint32_t m_width = 0;
+	uint32_t m_height = 0;
+
+	// ܂fĂȂ傫ƁA󂯎
+	bool m_hasPending = false;
+	bool m_sizing = false;
+	uint32_t m_pendingWidth = 0;
+	uint32_t m_pendingHeight = 0;
+	Clock::time_point m_pendingTime;
+};
+}
+}
@@ -0,0 +1,119 @@
+#include "RootSignatureBuilder.h"
+
+#include "Helpers.h"
+
+using Microsoft::WRL::ComPtr;
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+ComPtr<ID3DBlob> SerializeRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc)
+{
+	ComPtr<ID3DBlob> rootSignatureBlob;
+	ComPtr<ID3D10Blob> errorBlob;
+	HRESULT result = D3D12SerializeRootSignature(
+		&desc,
+		D3D_ROOT_SIGNATURE_VERSION_1_0,
+		rootSignatureBlob.ReleaseAndGetAddressOf(),
+		errorBlob.ReleaseAndGetAddressOf()
+	);
+	if (FAILED(result)) {
+		if (errorBlob != nullptr) {
+			DebugOutputFormatString(
+				"D3D12SerializeRootSignature Error : %.*s\n",
+				static_cast<int>(errorBlob->GetBufferSize()),
+				static_cast<const char*>(errorBlob->GetBufferPointer())
+			);
+		} else {
+			DebugOutputFormatString("D3D12SerializeRootSignature Error : 0x%x\n", result);
+		}
+		return nullptr;
+	}
+	return rootSignatureBlob;
+}
+
+ComPtr<ID3DBlob> SerializeRootSignature(
+	uint32_t flags,
+	const RootParameterDescription* parameters,
+	size_t parameterCount,
+	const StaticSamplerDescription* samplers,
+	size_t samplerCount
+) {
+	std::vector<D3D12_DESCRIPTOR_RANGE> ranges(parameterCount);
+	std::vector<D3D12_ROOT_PARAMETER> rootParameters(parameterCount);
+	std::vector<D3D12_STATIC_SAMPLER_DESC> staticSamplers(samplerCount);
+	for (size_t i = 0; i < parameterCount; ++i) {
+		FillRootParameter(parameters[i], rootParameters[i], ranges[i]);
+	}
+	for (size_t i = 0; i < samplerCount; ++i) {
+		FillStaticSampler(samplers[i], staticSamplers[i]);
+	}
+	D3D12_ROOT_SIGNATURE_DESC desc{};
+	desc.Flags = static_cast<D3D12_ROOT_SIGNATURE_FLAGS>(flags);
+	desc.NumParameters = static_cast<UINT>(parameterCount);
+	desc.pParameters = parameterCount > 0 ? rootParameters.data() : nullptr;
+	desc.NumStaticSamplers = static_cast<UINT>(samplerCount);
+	desc.pStaticSamplers = samplerCount > 0 ? staticSamplers.data() : nullptr;
+	return SerializeRootSignature(desc);
+}
+
+ComPtr<ID3D12RootSignature> RootSignatureCache::GetOrCreate(
+	ID3D12Device* device,
+	uint32_t flags,
+	const RootParameterDescription* parameters,
+	size_t parameterCount,
+	const StaticSamplerDescription* samplers,
+	size_t samplerCount
+) {
+	const uint64_t hash = HashRootSignature(flags, parameters, parameterCount, samplers, samplerCount);
+	const auto found = Find(hash);
+	if (found != nullptr) {
+		return found;
+	}
+	return Create(device, hash, SerializeRootSignature(flags, parameters, parameterCount, samplers, samplerCount));
+}
+
+size_t RootSignatureCache::Size() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_rootSignatures.size();
+}
+
+ComPtr<ID3DBlob> RootSignatureCache::SerializedBlob(ID3D12RootSignature* rootSignature) const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (const auto& entry : m_rootSignatures) {
+		if (entry.second.rootSignature.Get() == rootSignature) {
+			return entry.second.serialized;
+		}
+	}
+	return nullptr;
+}
+
+ComPtr<ID3D12RootSignature> RootSignatureCache::Create(
+	ID3D12Device* device,
+	uint64_t hash,
+	const ComPtr<ID3DBlob>& serialized
+) {
+	if (serialized == nullptr) {
+		return nullptr;
+	}
+
+	ComPtr<ID3D12RootSignature> rootSignature;
+	const HRESULT result = device->CreateRootSignature(
+		0,
+		serialized->GetBufferPointer(),
+		serialized->GetBufferSize(),
+		IID_PPV_ARGS(rootSignature.GetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateRootSignature Error : 0x%x\n", result);
+		return nullptr;
+	}
+
+	// ʂ̃XbhɍĂ炻g
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_rootSignatures.emplace(hash, Entry{ rootSignature, serialized }).first->second.rootSignature;
+}
+}
+}
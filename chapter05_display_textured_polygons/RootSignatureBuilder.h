@@ -0,0 +1,170 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl.h>
+#include <array>
+#include <cfloat>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "RootSignatureDescription.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// Lq D3D12 ̒l̂܂܎
+static_assert(kRootTable == static_cast<uint32_t>(D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE), "RootParameterType mismatch");
+static_assert(kRootConstants == static_cast<uint32_t>(D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS), "RootParameterType mismatch");
+static_assert(kRootCbv == static_cast<uint32_t>(D3D12_ROOT_PARAMETER_TYPE_CBV), "RootParameterType mismatch");
+static_assert(kRootSrv == static_cast<uint32_t>(D3D12_ROOT_PARAMETER_TYPE_SRV), "RootParameterType mismatch");
+static_assert(kRootUav == static_cast<uint32_t>(D3D12_ROOT_PARAMETER_TYPE_UAV), "RootParameterType mismatch");
+static_assert(kRangeSrv == static_cast<uint32_t>(D3D12_DESCRIPTOR_RANGE_TYPE_SRV), "RootRangeType mismatch");
+static_assert(kRangeUav == static_cast<uint32_t>(D3D12_DESCRIPTOR_RANGE_TYPE_UAV), "RootRangeType mismatch");
+static_assert(kRangeCbv == static_cast<uint32_t>(D3D12_DESCRIPTOR_RANGE_TYPE_CBV), "RootRangeType mismatch");
+static_assert(kRangeSampler == static_cast<uint32_t>(D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER), "RootRangeType mismatch");
+static_assert(kVisibilityAll == static_cast<uint32_t>(D3D12_SHADER_VISIBILITY_ALL), "RootVisibility mismatch");
+static_assert(kVisibilityVertex == static_cast<uint32_t>(D3D12_SHADER_VISIBILITY_VERTEX), "RootVisibility mismatch");
+static_assert(kVisibilityPixel == static_cast<uint32_t>(D3D12_SHADER_VISIBILITY_PIXEL), "RootVisibility mismatch");
+
+// ---- D3D12 ̍\̂ւ̓WJBq[v͎g킸ALqƓ傫̔zɏ ----
+
+// e[ûƂ range 1̃WAparameter w
+inline void FillRootParameter(
+	const RootParameterDescription& source,
+	D3D12_ROOT_PARAMETER& parameter,
+	D3D12_DESCRIPTOR_RANGE& range
+) {
+	parameter.ParameterType = static_cast<D3D12_ROOT_PARAMETER_TYPE>(source.type);
+	parameter.ShaderVisibility = static_cast<D3D12_SHADER_VISIBILITY>(source.visibility);
+	switch (source.type) {
+	case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+		range.RangeType = static_cast<D3D12_DESCRIPTOR_RANGE_TYPE>(source.rangeType);
+		range.NumDescriptors = source.count;
+		range.BaseShaderRegister = source.shaderRegister;
+		range.RegisterSpace = source.registerSpace;
+		range.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+		parameter.DescriptorTable.NumDescriptorRanges = 1;
+		parameter.DescriptorTable.pDescriptorRanges = &range;
+		break;
+	case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+		parameter.Constants.ShaderRegister = source.shaderRegister;
+		parameter.Constants.RegisterSpace = source.registerSpace;
+		parameter.Constants.Num32BitValues = source.count;
+		break;
+	default:
+		parameter.Descriptor.ShaderRegister = source.shaderRegister;
+		parameter.Descriptor.RegisterSpace = source.registerSpace;
+		break;
+	}
+}
+
+inline void FillStaticSampler(const StaticSamplerDescription& source, D3D12_STATIC_SAMPLER_DESC& sampler)
+{
+	const auto addressMode = static_cast<D3D12_TEXTURE_ADDRESS_MODE>(source.addressMode);
+	sampler.Filter = static_cast<D3D12_FILTER>(source.filter);
+	sampler.AddressU = addressMode;
+	sampler.AddressV = addressMode;
+	sampler.AddressW = addressMode;
+	sampler.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+	sampler.BorderColor = D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK;
+	sampler.MinLOD = 0.0f;
+	sampler.MaxLOD = D3D12_FLOAT32_MAX;
+	sampler.ShaderRegister = source.shaderRegister;
+	sampler.ShaderVisibility = static_cast<D3D12_SHADER_VISIBILITY>(source.visibility);
+}
+
+template <size_t ParameterCount, size_t SamplerCount>
+class RootSignatureDesc
+{
+public:
+	explicit RootSignatureDesc(const RootSignatureDescription<ParameterCount, SamplerCount>& description)
+		: m_ranges{}, m_parameters{}, m_samplers{}, m_desc{}
+	{
+		for (size_t i = 0; i < ParameterCount; ++i) {
+			FillRootParameter(description.parameters[i], m_parameters[i], m_ranges[i]);
+		}
+		for (size_t i = 0; i < SamplerCount; ++i) {
+			FillStaticSampler(description.samplers[i], m_samplers[i]);
+		}
+		m_desc.Flags = static_cast<D3D12_ROOT_SIGNATURE_FLAGS>(description.flags);
+		m_desc.NumParameters = static_cast<UINT>(ParameterCount);
+		m_desc.pParameters = ParameterCount > 0 ? m_parameters.data() : nullptr;
+		m_desc.NumStaticSamplers = static_cast<UINT>(SamplerCount);
+		m_desc.pStaticSamplers = SamplerCount > 0 ? m_samplers.data() : nullptr;
+	}
+	// ̔zŵŃRs[Ȃ
+	RootSignatureDesc(const RootSignatureDesc&) = delete;
+	RootSignatureDesc& operator=(const RootSignatureDesc&) = delete;
+
+	const D3D12_ROOT_SIGNATURE_DESC& Get() const { return m_desc; }
+
+private:
+	std::array<D3D12_DESCRIPTOR_RANGE, ParameterCount> m_ranges;
+	std::array<D3D12_ROOT_PARAMETER, ParameterCount> m_parameters;
+	std::array<D3D12_STATIC_SAMPLER_DESC, SamplerCount> m_samplers;
+	D3D12_ROOT_SIGNATURE_DESC m_desc;
+};
+
+// o[W 1.0 ŃVACY(foCX͂Ȃ)Bs nullptr
+Microsoft::WRL::ComPtr<ID3DBlob> SerializeRootSignature(const D3D12_ROOT_SIGNATURE_DESC& desc);
+// sɑgݗĂLqp
+Microsoft::WRL::ComPtr<ID3DBlob> SerializeRootSignature(
+	uint32_t flags,
+	const RootParameterDescription* parameters,
+	size_t parameterCount,
+	const StaticSamplerDescription* samplers,
+	size_t samplerCount
+);
+
+// Lq̃[gVOl`1ɂ܂Ƃ߂BXbhĂł悢
+class RootSignatureCache
+{
+public:
+	template <size_t ParameterCount, size_t SamplerCount>
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> GetOrCreate(
+		ID3D12Device* device,
+		const RootSignatureDescription<ParameterCount, SamplerCount>& description
+	) {
+		const uint64_t hash = HashRootSignature(description);
+		const auto found = Find(hash);
+		if (found != nullptr) {
+			return found;
+		}
+		const RootSignatureDesc<ParameterCount, SamplerCount> desc(description);
+		return Create(device, hash, SerializeRootSignature(desc.Get()));
+	}
+
+	// sɑgݗĂLqp
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> GetOrCreate(
+		ID3D12Device* device,
+		uint32_t flags,
+		const RootParameterDescription* parameters,
+		size_t parameterCount,
+		const StaticSamplerDescription* samplers,
+		size_t samplerCount
+	);
+
+	size_t Size() const;
+	// ̃LbVō[gVOl`̃VACY(t[Lv`ɏo)BȂ nullptr
+	Microsoft::WRL::ComPtr<ID3DBlob> SerializedBlob(ID3D12RootSignature* rootSignature) const;
+
+private:
+	struct Entry
+	{
+		Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature;
+		Microsoft::WRL::ComPtr<ID3DBlob> serialized;
+	};
+
+	mutable std::mutex m_mutex;
+	std::map<uint64_t, Entry> m_rootSignatures;
+
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> Find(uint64_t hash) const;
+	// serialized  nullptr(VACYɎs)Ȃ nullptr
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> Create(
+		ID3D12Device* device,
+		uint64_t hash,
+		const Microsoft::WRL::ComPtr<ID3DBlob>& serialized
+	);
+};
+}
+}
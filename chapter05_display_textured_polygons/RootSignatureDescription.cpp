@@ -0,0 +1,57 @@
+#include "RootSignatureDescription.h"
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	char RegisterPrefix(uint32_t rangeType)
+	{
+		switch (rangeType) {
+		case kRangeSrv:
+			return 't';
+		case kRangeUav:
+			return 'u';
+		case kRangeSampler:
+			return 's';
+		default:
+			return 'b';
+		}
+	}
+
+	// "register(t0)"  "register(t0, space1)"
+	std::string RegisterBinding(char prefix, uint32_t shaderRegister, uint32_t registerSpace)
+	{
+		std::string binding = "register(";
+		binding += prefix;
+		binding += std::to_string(shaderRegister);
+		if (registerSpace != 0) {
+			binding += ", space" + std::to_string(registerSpace);
+		}
+		return binding + ")";
+	}
+}
+
+std::string HlslRegisterDeclaration(const RootParameterDescription& parameter)
+{
+	const std::string binding = RegisterBinding(
+		RegisterPrefix(parameter.rangeType),
+		parameter.shaderRegister,
+		parameter.registerSpace
+	);
+	if (parameter.type == kRootConstants) {
+		// [g萔 hlslType ̍\̂1 cbuffer ɂ
+		return std::string("cbuffer ") + parameter.hlslName + "Constants : " + binding + "\n{\n    " +
+			parameter.hlslType + " " + parameter.hlslName + ";\n};\n";
+	}
+	std::string declaration = std::string(parameter.hlslType) + " " + parameter.hlslName;
+	if (parameter.type == kRootTable && parameter.count > 1) {
+		declaration += "[" + std::to_string(parameter.count) + "]";
+	}
+	return declaration + " : " + binding + ";\n";
+}
+
+std::string HlslRegisterDeclaration(const StaticSamplerDescription& sampler)
+{
+	return std::string("SamplerState ") + sampler.hlslName + " : " + RegisterBinding('s', sampler.shaderRegister, 0) + ";\n";
+}
+}
+}
@@ -0,0 +1,233 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// [gVOl`̐錾ƁÃnbVEHLSL ̃WX^[錾B
+// D3D12 ɂ͈ˑȂ̂ŁAD3D12 ̂ȂłeXgłBD3D12 ̍\̂ւ̓WJ RootSignatureBuilder.h
+namespace yuxx {
+namespace DirectX12 {
+// D3D12_ROOT_PARAMETER_TYPEED3D12_DESCRIPTOR_RANGE_TYPEED3D12_SHADER_VISIBILITY Ȃǂ͒l̂܂ uint32_t ŎB
+// ȉ D3D12 ̃wb_[ȂŎgl(D3D12 ̒lƓł邱Ƃ RootSignatureBuilder.h Ŋm߂)
+enum RootParameterType : uint32_t {
+	kRootTable = 0,
+	kRootConstants = 1,
+	kRootCbv = 2,
+	kRootSrv = 3,
+	kRootUav = 4,
+};
+
+enum RootRangeType : uint32_t {
+	kRangeSrv = 0,
+	kRangeUav = 1,
+	kRangeCbv = 2,
+	kRangeSampler = 3,
+};
+
+enum RootVisibility : uint32_t {
+	kVisibilityAll = 0,
+	kVisibilityVertex = 1,
+	kVisibilityPixel = 5,
+};
+
+// [gp[^[1̐錾Be[u̓W1
+struct RootParameterDescription
+{
+	uint32_t type;
+	// e[ûƂ̃W̎
+	uint32_t rangeType;
+	uint32_t shaderRegister;
+	uint32_t registerSpace;
+	// e[uȂfBXNv^A[g萔Ȃ 32bit l̐
+	uint32_t count;
+	uint32_t visibility;
+	// HLSL ̐錾Ƃ̌^ƖO
+	const char* hlslType;
+	const char* hlslName;
+};
+
+struct StaticSamplerDescription
+{
+	// D3D12_FILTER
+	uint32_t filter;
+	// D3D12_TEXTURE_ADDRESS_MODE
+	uint32_t addressMode;
+	uint32_t shaderRegister;
+	uint32_t visibility;
+	const char* hlslName;
+};
+
+template <size_t ParameterCount, size_t SamplerCount>
+struct RootSignatureDescription
+{
+	// D3D12_ROOT_SIGNATURE_FLAGS
+	uint32_t flags;
+	std::array<RootParameterDescription, ParameterCount> parameters;
+	std::array<StaticSamplerDescription, SamplerCount> samplers;
+};
+
+// ---- 錾p̊֐Bǂ constexpr Ȃ̂ static ȋLq̓RpCɌ܂ ----
+
+constexpr RootParameterDescription DescriptorTable(
+	uint32_t rangeType,
+	const char* hlslType,
+	const char* hlslName,
+	uint32_t shaderRegister,
+	uint32_t count = 1,
+	uint32_t visibility = kVisibilityAll,
+	uint32_t registerSpace = 0
+) {
+	return { kRootTable, rangeType, shaderRegister, registerSpace, count, visibility, hlslType, hlslName };
+}
+
+constexpr RootParameterDescription RootConstants(
+	const char* hlslType,
+	const char* hlslName,
+	uint32_t shaderRegister,
+	uint32_t num32BitValues,
+	uint32_t visibility = kVisibilityAll,
+	uint32_t registerSpace = 0
+) {
+	return { kRootConstants, kRangeCbv, shaderRegister, registerSpace, num32BitValues, visibility, hlslType, hlslName };
+}
+
+// [gɒڒu CBV/SRV/UAV(type  D3D12_ROOT_PARAMETER_TYPE_CBV/SRV/UAV)
+constexpr RootParameterDescription RootDescriptor(
+	uint32_t type,
+	const char* hlslType,
+	const char* hlslName,
+	uint32_t shaderRegister,
+	uint32_t visibility = kVisibilityAll,
+	uint32_t registerSpace = 0
+) {
+	return {
+		type,
+		type == kRootSrv ? static_cast<uint32_t>(kRangeSrv)
+			: type == kRootUav ? static_cast<uint32_t>(kRangeUav)
+			: static_cast<uint32_t>(kRangeCbv),
+		shaderRegister,
+		registerSpace,
+		1,
+		visibility,
+		hlslType,
+		hlslName
+	};
+}
+
+constexpr StaticSamplerDescription StaticSampler(
+	const char* hlslName,
+	uint32_t filter,
+	uint32_t addressMode,
+	uint32_t shaderRegister,
+	uint32_t visibility = kVisibilityAll
+) {
+	return { filter, addressMode, shaderRegister, visibility, hlslName };
+}
+
+template <typename... Parameters>
+constexpr std::array<RootParameterDescription, sizeof...(Parameters)> RootParameters(Parameters... parameters)
+{
+	return { { parameters... } };
+}
+
+template <typename... Samplers>
+constexpr std::array<StaticSamplerDescription, sizeof...(Samplers)> StaticSamplers(Samplers... samplers)
+{
+	return { { samplers... } };
+}
+
+template <size_t ParameterCount, size_t SamplerCount>
+constexpr RootSignatureDescription<ParameterCount, SamplerCount> MakeRootSignatureDescription(
+	uint32_t flags,
+	const std::array<RootParameterDescription, ParameterCount>& parameters,
+	const std::array<StaticSamplerDescription, SamplerCount>& samplers
+) {
+	return { flags, parameters, samplers };
+}
+
+// ---- nbV(FNV-1a)BHLSL p̖O͊܂߂Ȃ ----
+
+constexpr uint64_t HashValue(uint64_t hash, uint64_t value)
+{
+	for (int i = 0; i < 8; ++i) {
+		hash ^= (value >> (i * 8)) & 0xff;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+constexpr uint64_t HashRootParameter(uint64_t hash, const RootParameterDescription& parameter)
+{
+	hash = HashValue(hash, parameter.type);
+	hash = HashValue(hash, parameter.rangeType);
+	hash = HashValue(hash, parameter.shaderRegister);
+	hash = HashValue(hash, parameter.registerSpace);
+	hash = HashValue(hash, parameter.count);
+	return HashValue(hash, parameter.visibility);
+}
+
+constexpr uint64_t HashStaticSampler(uint64_t hash, const StaticSamplerDescription& sampler)
+{
+	hash = HashValue(hash, sampler.filter);
+	hash = HashValue(hash, sampler.addressMode);
+	hash = HashValue(hash, sampler.shaderRegister);
+	return HashValue(hash, sampler.visibility);
+}
+
+constexpr uint64_t kRootSignatureHashBasis = 14695981039346656037ull;
+
+template <size_t ParameterCount, size_t SamplerCount>
+constexpr uint64_t HashRootSignature(const RootSignatureDescription<ParameterCount, SamplerCount>& description)
+{
+	uint64_t hash = HashValue(kRootSignatureHashBasis, description.flags);
+	hash = HashValue(hash, ParameterCount);
+	for (size_t i = 0; i < ParameterCount; ++i) {
+		hash = HashRootParameter(hash, description.parameters[i]);
+	}
+	hash = HashValue(hash, SamplerCount);
+	for (size_t i = 0; i < SamplerCount; ++i) {
+		hash = HashStaticSampler(hash, description.samplers[i]);
+	}
+	return hash;
+}
+
+// sɑgݗĂLq(VF[_[̃tNVȂ)pBeȂev[głƓlɂȂ
+constexpr uint64_t HashRootSignature(
+	uint32_t flags,
+	const RootParameterDescription* parameters,
+	size_t parameterCount,
+	const StaticSamplerDescription* samplers,
+	size_t samplerCount
+) {
+	uint64_t hash = HashValue(kRootSignatureHashBasis, flags);
+	hash = HashValue(hash, parameterCount);
+	for (size_t i = 0; i < parameterCount; ++i) {
+		hash = HashRootParameter(hash, parameters[i]);
+	}
+	hash = HashValue(hash, samplerCount);
+	for (size_t i = 0; i < samplerCount; ++i) {
+		hash = HashStaticSampler(hash, samplers[i]);
+	}
+	return hash;
+}
+
+// ---- Ή HLSL ̃WX^[錾 ----
+
+std::string HlslRegisterDeclaration(const RootParameterDescription& parameter);
+std::string HlslRegisterDeclaration(const StaticSamplerDescription& sampler);
+
+template <size_t ParameterCount, size_t SamplerCount>
+std::string GenerateHlslRegisters(const RootSignatureDescription<ParameterCount, SamplerCount>& description)
+{
+	std::string hlsl;
+	for (const RootParameterDescription& parameter : description.parameters) {
+		hlsl += HlslRegisterDeclaration(parameter);
+	}
+	for (const StaticSamplerDescription& sampler : description.samplers) {
+		hlsl += HlslRegisterDeclaration(sampler);
+	}
+	return hlsl;
+}
+}
+}
@@ -0,0 +1,213 @@
+#include "ShaderBindings.h"
+
+#include <algorithm>
+
+using Microsoft::WRL::ComPtr;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// D3D_REGISTER_COMPONENT_TYPE
+	constexpr uint32_t kComponentUint32 = 1;
+	constexpr uint32_t kComponentSint32 = 2;
+	constexpr uint32_t kComponentFloat32 = 3;
+
+	DXGI_FORMAT InputFormat(uint32_t componentType, uint8_t mask)
+	{
+		static const DXGI_FORMAT kFloatFormats[] = {
+			DXGI_FORMAT_R32_FLOAT, DXGI_FORMAT_R32G32_FLOAT, DXGI_FORMAT_R32G32B32_FLOAT, DXGI_FORMAT_R32G32B32A32_FLOAT,
+		};
+		static const DXGI_FORMAT kUintFormats[] = {
+			DXGI_FORMAT_R32_UINT, DXGI_FORMAT_R32G32_UINT, DXGI_FORMAT_R32G32B32_UINT, DXGI_FORMAT_R32G32B32A32_UINT,
+		};
+		static const DXGI_FORMAT kSintFormats[] = {
+			DXGI_FORMAT_R32_SINT, DXGI_FORMAT_R32G32_SINT, DXGI_FORMAT_R32G32B32_SINT, DXGI_FORMAT_R32G32B32A32_SINT,
+		};
+		// gĂ鐬͂΂̃rbg܂ŋl܂Ă(float3 Ȃ xyz)
+		int componentCount = 0;
+		for (int i = 0; i < 4; ++i) {
+			if (mask & (1 << i)) {
+				componentCount = i + 1;
+			}
+		}
+		if (componentCount == 0) {
+			return DXGI_FORMAT_UNKNOWN;
+		}
+		switch (componentType) {
+		case kComponentUint32:
+			return kUintFormats[componentCount - 1];
+		case kComponentSint32:
+			return kSintFormats[componentCount - 1];
+		case kComponentFloat32:
+			return kFloatFormats[componentCount - 1];
+		default:
+			return DXGI_FORMAT_UNKNOWN;
+		}
+	}
+
+	uint32_t RangeType(ShaderInputType type)
+	{
+		switch (type) {
+		case ShaderInputType::ConstantBuffer:
+			return kRangeCbv;
+		case ShaderInputType::TextureBuffer:
+		case ShaderInputType::Texture:
+		case ShaderInputType::Structured:
+		case ShaderInputType::ByteAddress:
+			return kRangeSrv;
+		case ShaderInputType::Sampler:
+			return kRangeSampler;
+		default:
+			return kRangeUav;
+		}
+	}
+
+	// tNV͎vf̌^܂ł͕Ȃ̂ŁAHLSL ̐錾ɂ͑܂Ȏނ
+	const char* HlslTypeName(ShaderInputType type)
+	{
+		switch (type) {
+		case ShaderInputType::ConstantBuffer:
+			return "cbuffer";
+		case ShaderInputType::TextureBuffer:
+			return "tbuffer";
+		case ShaderInputType::Texture:
+			return "Texture";
+		case ShaderInputType::Structured:
+			return "StructuredBuffer";
+		case ShaderInputType::ByteAddress:
+			return "ByteAddressBuffer";
+		case ShaderInputType::RWTyped:
+			return "RWTexture";
+		case ShaderInputType::RWByteAddress:
+			return "RWByteAddressBuffer";
+		default:
+			return "RWStructuredBuffer";
+		}
+	}
+}
+
+std::vector<D3D12_INPUT_ELEMENT_DESC> MakeInputLayout(const ShaderReflectionData& reflection)
+{
+	std::vector<D3D12_INPUT_ELEMENT_DESC> inputLayout;
+	for (const ShaderInputElement& input : reflection.inputs) {
+		if (input.systemValue != 0) {
+			continue;
+		}
+		D3D12_INPUT_ELEMENT_DESC element{};
+		element.SemanticName = input.semanticName.c_str();
+		element.SemanticIndex = input.semanticIndex;
+		element.Format = InputFormat(input.componentType, input.mask);
+		element.InputSlot = 0;
+		element.AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
+		element.InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+		element.InstanceDataStepRate = 0;
+		inputLayout.push_back(element);
+	}
+	return inputLayout;
+}
+
+void ReflectedRootSignature::Build(
+	std::initializer_list<Stage> stages,
+	D3D12_ROOT_SIGNATURE_FLAGS flags,
+	D3D12_FILTER filter,
+	D3D12_TEXTURE_ADDRESS_MODE addressMode
+) {
+	m_flags = flags;
+	m_parameters.clear();
+	m_samplers.clear();
+	m_names.clear();
+
+	for (const Stage& stage : stages) {
+		for (const ShaderResourceBinding& binding : stage.reflection->bindings) {
+			const uint32_t rangeType = RangeType(binding.type);
+			if (rangeType == kRangeSampler) {
+				// ÓITv[ space Ȃ̂ space 0 
+				const auto found = std::find_if(
+					m_samplers.begin(),
+					m_samplers.end(),
+					[&binding](const StaticSamplerDescription& sampler) { return sampler.shaderRegister == binding.bindPoint; }
+				);
+				if (found != m_samplers.end()) {
+					if (found->visibility != static_cast<uint32_t>(stage.visibility)) {
+						found->visibility = kVisibilityAll;
+					}
+					continue;
+				}
+				m_samplers.push_back(StaticSampler(StoreName(binding.name), filter, addressMode, binding.bindPoint, stage.visibility));
+				continue;
+			}
+
+			const auto found = std::find_if(
+				m_parameters.begin(),
+				m_parameters.end(),
+				[&binding, rangeType](const RootParameterDescription& parameter) {
+					return parameter.rangeType == rangeType &&
+						parameter.shaderRegister == binding.bindPoint &&
+						parameter.registerSpace == binding.space;
+				}
+			);
+			if (found != m_parameters.end()) {
+				if (found->visibility != static_cast<uint32_t>(stage.visibility)) {
+					found->visibility = kVisibilityAll;
+				}
+				continue;
+			}
+			m_parameters.push_back(DescriptorTable(
+				rangeType,
+				HlslTypeName(binding.type),
+				StoreName(binding.name),
+				binding.bindPoint,
+				binding.bindCount,
+				stage.visibility,
+				binding.space
+			));
+		}
+	}
+}
+
+int ReflectedRootSignature::ParameterIndex(const std::string& name) const
+{
+	for (size_t i = 0; i < m_parameters.size(); ++i) {
+		if (name == m_parameters[i].hlslName) {
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
+ComPtr<ID3D12RootSignature> ReflectedRootSignature::GetOrCreate(ID3D12Device* device, RootSignatureCache& cache) const
+{
+	return cache.GetOrCreate(
+		device,
+		m_flags,
+		m_parameters.data(),
+		m_parameters.size(),
+		m_samplers.data(),
+		m_samplers.size()
+	);
+}
+
+ComPtr<ID3DBlob> ReflectedRootSignature::Serialize() const
+{
+	return SerializeRootSignature(m_flags, m_parameters.data(), m_parameters.size(), m_samplers.data(), m_samplers.size());
+}
+
+std::string ReflectedRootSignature::GenerateHlslRegisters() const
+{
+	std::string hlsl;
+	for (const RootParameterDescription& parameter : m_parameters) {
+		hlsl += HlslRegisterDeclaration(parameter);
+	}
+	for (const StaticSamplerDescription& sampler : m_samplers) {
+		hlsl += HlslRegisterDeclaration(sampler);
+	}
+	return hlsl;
+}
+
+const char* ReflectedRootSignature::StoreName(const std::string& name)
+{
+	m_names.push_back(name);
+	return m_names.back().c_str();
+}
+}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <d3d12.h>
+#include <deque>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "DxbcReflection.h"
+#include "RootSignatureBuilder.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// _VF[_[̓̓VOl`̓CAEgBSV_VertexID Ȃǂ̃VXel͏B
+// vf̓Xbg 0 ɋl߂ĕׂ̂ŁA_\̂̃o[̓VF[_[̈ƓE^ɂ邱ƁB
+// SemanticName  reflection ̕ŵŁAreflection 蒷gȂ
+std::vector<D3D12_INPUT_ELEMENT_DESC> MakeInputLayout(const ShaderReflectionData& reflection);
+
+// eĩtNVʂgݗĂ[gVOl`̋LqB
+// SRVEUAVECBV 1fBXNv^e[uɂATv[͐ÓITv[ɂB
+// ̒iœWX^[gĂ΁Ai ALL ɂ1ɂ܂Ƃ߂
+class ReflectedRootSignature
+{
+public:
+	struct Stage
+	{
+		const ShaderReflectionData* reflection;
+		D3D12_SHADER_VISIBILITY visibility;
+	};
+
+	ReflectedRootSignature() = default;
+	// Lq m_names wĂ̂ŃRs[Ȃ
+	ReflectedRootSignature(const ReflectedRootSignature&) = delete;
+	ReflectedRootSignature& operator=(const ReflectedRootSignature&) = delete;
+
+	void Build(
+		std::initializer_list<Stage> stages,
+		D3D12_ROOT_SIGNATURE_FLAGS flags,
+		D3D12_FILTER filter,
+		D3D12_TEXTURE_ADDRESS_MODE addressMode
+	);
+
+	// VF[_[̖O烋[gp[^[̔ԍBȂ -1
+	int ParameterIndex(const std::string& name) const;
+
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> GetOrCreate(ID3D12Device* device, RootSignatureCache& cache) const;
+	// GetOrCreate ̂ƓVACYʁBs nullptr
+	Microsoft::WRL::ComPtr<ID3DBlob> Serialize() const;
+	// 錾Lqƌׂ悤
+	std::string GenerateHlslRegisters() const;
+
+private:
+	D3D12_ROOT_SIGNATURE_FLAGS m_flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+	std::vector<RootParameterDescription> m_parameters;
+	std::vector<StaticSamplerDescription> m_samplers;
+	// Lq hlslName wBdeque ȂǉĂȂ
+	std::deque<std::string> m_names;
+
+	const char* StoreName(const std::string& name);
+};
+}
+}
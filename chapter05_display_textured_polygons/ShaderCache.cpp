@@ -0,0 +1,165 @@
+#include "ShaderCache.h"
+
+#include <d3dcompiler.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Helpers.h"
+
+using Microsoft::WRL::ComPtr;
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// FNV-1a
+	uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	constexpr wchar_t kCacheDirectoryName[] = L"shader_cache";
+
+	// st@ĈfBNg shader_cacheBȂ΍ƃfBNg shader_cache
+	const std::wstring& CacheDirectory()
+	{
+		static const std::wstring directory = [] {
+			wchar_t modulePath[MAX_PATH] = {};
+			const DWORD length = GetModuleFileNameW(nullptr, modulePath, MAX_PATH);
+			if (length == 0 || length == MAX_PATH) {
+				return std::wstring(kCacheDirectoryName);
+			}
+			std::wstring path(modulePath, length);
+			const size_t separator = path.find_last_of(L"\\/");
+			if (separator == std::wstring::npos) {
+				return std::wstring(kCacheDirectoryName);
+			}
+			return path.substr(0, separator + 1) + kCacheDirectoryName;
+		}();
+		return directory;
+	}
+
+	// Gg[|Cg ASCII Ȃ̂ł̂܂܍L
+	std::wstring CachePath(const wchar_t* path, const char* entryPoint, const wchar_t* extension)
+	{
+		// ʂ̃fBNg̓Õ\[XƂԂȂ悤ɁApX1̖Oɂ
+		std::wstring name(path);
+		for (wchar_t& c : name) {
+			if (c == L'\\' || c == L'/' || c == L':') {
+				c = L'_';
+			}
+		}
+		return CacheDirectory() + L"\\" + name + L"." + std::wstring(entryPoint, entryPoint + std::strlen(entryPoint)) + extension;
+	}
+
+	bool ReadFileBytes(const std::wstring& path, std::vector<uint8_t>& bytes)
+	{
+		std::ifstream stream(path, std::ios::binary);
+		if (!stream) {
+			return false;
+		}
+		bytes.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		return true;
+	}
+}
+
+bool ComputeShaderCacheKey(
+	const wchar_t* path,
+	const char* entryPoint,
+	const char* target,
+	UINT flags,
+	uint64_t& key
+) {
+	std::vector<uint8_t> source;
+	if (!ReadFileBytes(path, source)) {
+		return false;
+	}
+
+	// #include "..." \[X̂fBNgT邽߁A\[XɃpXn
+	char sourceName[MAX_PATH] = {};
+	WideCharToMultiByte(CP_ACP, 0, path, -1, sourceName, MAX_PATH, nullptr, nullptr);
+
+	ComPtr<ID3D10Blob> preprocessed;
+	ComPtr<ID3D10Blob> errorBlob;
+	HRESULT result = D3DPreprocess(
+		source.data(),
+		source.size(),
+		sourceName,
+		nullptr,
+		D3D_COMPILE_STANDARD_FILE_INCLUDE,
+		preprocessed.ReleaseAndGetAddressOf(),
+		errorBlob.ReleaseAndGetAddressOf()
+	);
+	if (FAILED(result)) {
+		// G[̓e͂̂Ƃ̃RpCŏo
+		return false;
+	}
+
+	uint64_t hash = 14695981039346656037ull;
+	hash = HashBytes(hash, preprocessed->GetBufferPointer(), preprocessed->GetBufferSize());
+	hash = HashBytes(hash, entryPoint, std::strlen(entryPoint) + 1);
+	hash = HashBytes(hash, target, std::strlen(target) + 1);
+	key = HashBytes(hash, &flags, sizeof(flags));
+	return true;
+}
+
+bool LoadCachedShader(
+	const wchar_t* path,
+	const char* entryPoint,
+	uint64_t key,
+	ComPtr<ID3D10Blob>& blob,
+	ShaderReflectionData& reflection
+) {
+	// tNV̕ɃL[Ă̂ŁAɊm߂
+	std::vector<uint8_t> bytes;
+	if (!ReadFileBytes(CachePath(path, entryPoint, L".reflection"), bytes) ||
+		!DeserializeReflection(bytes, key, reflection)) {
+		return false;
+	}
+	HRESULT result = D3DReadFileToBlob(
+		CachePath(path, entryPoint, L".cso").c_str(),
+		blob.ReleaseAndGetAddressOf()
+	);
+	return SUCCEEDED(result);
+}
+
+bool StoreCachedShader(
+	const wchar_t* path,
+	const char* entryPoint,
+	uint64_t key,
+	ID3D10Blob* blob,
+	const ShaderReflectionData& reflection
+) {
+	if (!CreateDirectoryW(CacheDirectory().c_str(), nullptr)) {
+		const DWORD error = GetLastError();
+		if (error != ERROR_ALREADY_EXISTS) {
+			DebugOutputFormatString("CreateDirectoryW Error (%ls) : %lu\n", CacheDirectory().c_str(), error);
+			return false;
+		}
+	}
+
+	// oCgR[hĂL[BrŎsĂÂL[̂܂܎cȂ
+	const std::wstring reflectionPath = CachePath(path, entryPoint, L".reflection");
+	DeleteFileW(reflectionPath.c_str());
+
+	HRESULT result = D3DWriteBlobToFile(blob, CachePath(path, entryPoint, L".cso").c_str(), TRUE);
+	if (FAILED(result)) {
+		DebugOutputFormatString("D3DWriteBlobToFile Error : 0x%x\n", result);
+		return false;
+	}
+
+	const std::vector<uint8_t> bytes = SerializeReflection(reflection, key);
+	std::ofstream stream(reflectionPath, std::ios::binary | std::ios::trunc);
+	stream.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	return static_cast<bool>(stream);
+}
+}
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <Windows.h>
+#include <d3dcommon.h>
+#include <wrl.h>
+#include <cstdint>
+
+#include "DxbcReflection.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// RpCς݂̃oCgR[hƃtNVʂAst@Cׂ̗ shader_cache fBNg
+// <\[X>.<Gg[|Cg>.cso  <\[X>.<Gg[|Cg>.reflection ƂĒuB
+// \[X̃c[ɂ͏ȂB\[X̃pX̋؂ _ ɒu
+
+// O(#include ̓WJƃ}N̒u)\[XƁAGg[|CgE^[QbgEtOL[B
+// Rg󔒂̕ύXł̓L[ςȂBOɎs false
+bool ComputeShaderCacheKey(
+	const wchar_t* path,
+	const char* entryPoint,
+	const char* target,
+	UINT flags,
+	uint64_t& key
+);
+
+// L[vLbVΓǂ
+bool LoadCachedShader(
+	const wchar_t* path,
+	const char* entryPoint,
+	uint64_t key,
+	Microsoft::WRL::ComPtr<ID3D10Blob>& blob,
+	ShaderReflectionData& reflection
+);
+
+bool StoreCachedShader(
+	const wchar_t* path,
+	const char* entryPoint,
+	uint64_t key,
+	ID3D10Blob* blob,
+	const ShaderReflectionData& reflection
+);
+}
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace yuxx {
+namespace DirectX12 {
+// ރXbhƓǂݏoXbh1̂ƂɎgAbN̂ȂŒ蒷L[B
+// ő Capacity ܂œBT ̓ftHg\zƃ[uł΂悢
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+public:
+	SpscQueue() = default;
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	// ރXbhĂԁBςȂ false
+	bool TryPush(T value);
+	// ǂݏoXbhĂԁBȂ false
+	bool TryPop(T& value);
+
+	// Ă񂾎_̂悻̐(ǂ̃XbhłĂׂ)
+	size_t SizeApprox() const
+	{
+		return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+	}
+
+private:
+	// ݑƓǂݏöʒuʁX̃LbVCɒu
+	static constexpr size_t kCacheLineSize = 64;
+
+	// ǂݏoXVBݑ͖tǂƂǂ
+	std::atomic<size_t> m_head{ 0 };
+	size_t m_cachedTail = 0;
+	char m_headPadding[kCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+	// ݑXVBǂݏo͋󂩂ǂƂǂ
+	std::atomic<size_t> m_tail{ 0 };
+	size_t m_cachedHead = 0;
+	char m_tailPadding[kCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+	// lĂ(int Ȃǂ̂ƂA܂ĂȂvfǂ܂ȂƂ GCC ǂ -Wmaybe-uninitialized ɂȂ)
+	T m_items[Capacity]{};
+};
+
+template <typename T, size_t Capacity>
+bool SpscQueue<T, Capacity>::TryPush(T value)
+{
+	const size_t tail = m_tail.load(std::memory_order_relaxed);
+	if (tail - m_cachedHead == Capacity) {
+		// OɌʒuł͖tƂAǂݏöʒuǂݒ
+		m_cachedHead = m_head.load(std::memory_order_acquire);
+		if (tail - m_cachedHead == Capacity) {
+			return false;
+		}
+	}
+	m_items[tail % Capacity] = std::move(value);
+	m_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T, size_t Capacity>
+bool SpscQueue<T, Capacity>::TryPop(T& value)
+{
+	const size_t head = m_head.load(std::memory_order_relaxed);
+	if (head == m_cachedTail) {
+		m_cachedTail = m_tail.load(std::memory_order_acquire);
+		if (head == m_cachedTail) {
+			return false;
+		}
+	}
+	value = std::move(m_items[head % Capacity]);
+	m_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+}
+}
@@ -0,0 +1,122 @@
+#include "StartupTaskGraph.h"
+
+#include "Helpers.h"
+
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+StartupTaskGraph::TaskId StartupTaskGraph::Add(
+	const char* name,
+	std::function<bool()> function,
+	std::initializer_list<TaskId> dependencies,
+	bool mainThreadOnly
+) {
+	const TaskId id = m_tasks.size();
+	Task task;
+	task.name = name;
+	task.function = std::move(function);
+	task.dependencyCount = dependencies.size();
+	task.mainThreadOnly = mainThreadOnly;
+	m_tasks.push_back(std::move(task));
+
+	// ˑ͕K Add Ă̂ŏz͂łȂ
+	for (const TaskId dependency : dependencies) {
+		m_tasks[dependency].dependents.push_back(id);
+	}
+	return id;
+}
+
+bool StartupTaskGraph::Run(JobSystem& jobSystem)
+{
+	m_startTime = Clock::now();
+	m_failed = false;
+	m_remainingDependencies.reset(new std::atomic<size_t>[m_tasks.size()]);
+	for (TaskId id = 0; id < m_tasks.size(); ++id) {
+		m_tasks[id].succeeded = false;
+		m_remainingDependencies[id] = m_tasks[id].dependencyCount;
+	}
+
+	// ς񂾃^XNׂďI 0 ɂȂBsƂ͈ˑ^XNς܂Ȃ
+	JobCounter finished;
+	for (TaskId id = 0; id < m_tasks.size(); ++id) {
+		if (m_tasks[id].dependencyCount == 0) {
+			Schedule(id, jobSystem, finished);
+		}
+	}
+	jobSystem.Wait(finished);
+
+	m_totalMilliseconds = ElapsedMilliseconds();
+	return !m_failed;
+}
+
+void StartupTaskGraph::Schedule(TaskId id, JobSystem& jobSystem, JobCounter& finished)
+{
+	auto job = [this, id, &jobSystem, &finished]() {
+		Execute(id, jobSystem, finished);
+	};
+	if (m_tasks[id].mainThreadOnly) {
+		jobSystem.RunOnMainThread(job, &finished);
+	} else {
+		jobSystem.Run(job, &finished);
+	}
+}
+
+void StartupTaskGraph::Execute(TaskId id, JobSystem& jobSystem, JobCounter& finished)
+{
+	if (m_failed) {
+		return;
+	}
+
+	Task& task = m_tasks[id];
+	task.threadIndex = static_cast<unsigned int>(jobSystem.CurrentThreadIndex());
+	task.startMilliseconds = ElapsedMilliseconds();
+	task.succeeded = task.function();
+	task.endMilliseconds = ElapsedMilliseconds();
+
+	if (!task.succeeded) {
+		DebugOutputFormatString("%s failed.\n", task.name.c_str());
+		m_failed = true;
+		return;
+	}
+	for (const TaskId dependent : task.dependents) {
+		if (m_remainingDependencies[dependent].fetch_sub(1) == 1) {
+			Schedule(dependent, jobSystem, finished);
+		}
+	}
+}
+
+double StartupTaskGraph::ElapsedMilliseconds() const
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - m_startTime).count();
+}
+
+void StartupTaskGraph::Report() const
+{
+	DebugOutputFormatString("---- startup report ----\n");
+	double serialMilliseconds = 0.0;
+	for (const Task& task : m_tasks) {
+		if (!task.succeeded) {
+			DebugOutputFormatString("%-40s not completed\n", task.name.c_str());
+			continue;
+		}
+		const double duration = task.endMilliseconds - task.startMilliseconds;
+		serialMilliseconds += duration;
+		DebugOutputFormatString(
+			"%-40s thread %u  start %8.2f ms  took %8.2f ms\n",
+			task.name.c_str(),
+			task.threadIndex,
+			task.startMilliseconds,
+			duration
+		);
+	}
+	// ɎsĂꍇƂ̔r
+	DebugOutputFormatString(
+		"total %.2f ms (serial %.2f ms, x%.2f)\n",
+		m_totalMilliseconds,
+		serialMilliseconds,
+		m_totalMilliseconds > 0.0 ? serialMilliseconds / m_totalMilliseconds : 0.0
+	);
+}
+}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "JobSystem.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// ˑ֌Wɏ]ĕɎsAXebvƂ̎ԂL^
+class StartupTaskGraph
+{
+public:
+	using TaskId = size_t;
+
+	// mainThreadOnly ̃^XN̓WuVXẽCXbhłsȂ(EBhE֘AȂ)
+	TaskId Add(
+		const char* name,
+		std::function<bool()> function,
+		std::initializer_list<TaskId> dependencies = {},
+		bool mainThreadOnly = false
+	);
+	// jobSystem ̃[J[ŎsAI܂ő҂(CXbhĂ)B
+	// ǂꂩsA܂n܂ĂȂ^XN͎s false Ԃ
+	bool Run(JobSystem& jobSystem);
+	// eXebv̊JnƏvԂo͂
+	void Report() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Task
+	{
+		std::string name;
+		std::function<bool()> function;
+		std::vector<TaskId> dependents;
+		size_t dependencyCount = 0;
+		bool mainThreadOnly = false;
+		bool succeeded = false;
+		double startMilliseconds = 0.0;
+		double endMilliseconds = 0.0;
+		unsigned int threadIndex = 0;
+	};
+
+	std::vector<Task> m_tasks;
+	// ^XNƂ́A܂IĂȂˑ̐
+	std::unique_ptr<std::atomic<size_t>[]> m_remainingDependencies;
+	std::atomic<bool> m_failed{ false };
+	Clock::time_point m_startTime;
+	double m_totalMilliseconds = 0.0;
+
+	void Schedule(TaskId id, JobSystem& jobSystem, JobCounter& finished);
+	void Execute(TaskId id, JobSystem& jobSystem, JobCounter& finished);
+	double ElapsedMilliseconds() const;
+};
+}
+}
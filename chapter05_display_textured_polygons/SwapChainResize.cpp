@@ -0,0 +1,32 @@
+#include "SwapChainResize.h"
+
+#include <algorithm>
+
+namespace yuxx {
+namespace DirectX12 {
+bool RebuildSizeDependentTargets(SwapChainTargets& targets, uint32_t width, uint32_t height)
+{
+	if (width == 0 || height == 0) {
+		return true;
+	}
+	// obNobt@[⒆ԃ^[QbggR}h GPU ɎcĂȂ悤ɂĂ
+	if (!targets.FlushFrames()) {
+		return false;
+	}
+	targets.ReleaseBackBuffers();
+	if (!targets.ResizeBuffers(width, height)) {
+		return false;
+	}
+	if (!targets.CreateBackBufferViews()) {
+		return false;
+	}
+	return targets.ResizeRenderTargets(width, height);
+}
+
+void ScaledRenderSize(uint32_t width, uint32_t height, float scale, uint32_t& renderWidth, uint32_t& renderHeight)
+{
+	renderWidth = (std::max)(static_cast<uint32_t>(width * scale + 0.5f), 1u);
+	renderHeight = (std::max)(static_cast<uint32_t>(height * scale + 0.5f), 1u);
+}
+}
+}
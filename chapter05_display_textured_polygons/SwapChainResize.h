@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+
+namespace yuxx {
+namespace DirectX12 {
+// Xbv`F[ƁȂ傫ṓBDirectXManager(D3D12)ƃeXg
+class SwapChainTargets
+{
+public:
+	virtual ~SwapChainTargets() = default;
+
+	// ς񂾃t[ׂ GPU ŏI点(Present ҂Ăt[͑Ȏ傫ŏo)
+	virtual bool FlushFrames() = 0;
+	// obNobt@[ւ̎QƂׂĎBQƂcĂ ResizeBuffers s
+	virtual void ReleaseBackBuffers() = 0;
+	virtual bool ResizeBuffers(uint32_t width, uint32_t height) = 0;
+	// 蒼obNobt@[蒼ăr[
+	virtual bool CreateBackBufferViews() = 0;
+	// [xobt@[|XgvZX̒ԃ^[QbgȂǁAobNobt@[Ɠ傫̂
+	virtual bool ResizeRenderTargets(uint32_t width, uint32_t height) = 0;
+};
+
+// 傫̕ςXbv`F[ƁAɍ킹̂ɍ蒼BrŎs炻ł߂ falseB
+// 0 x 0(ŏ) ResizeBuffers EBhȆ傫gĂ܂̂ŁA true Ԃ
+bool RebuildSizeDependentTargets(SwapChainTargets& targets, uint32_t width, uint32_t height);
+
+// I𑜓x̔{ scale  width x height ̃^[Qbg̍ɕ`Ƃ̑傫Bǂ 1 ȏ
+void ScaledRenderSize(uint32_t width, uint32_t height, float scale, uint32_t& renderWidth, uint32_t& renderHeight);
+}
+}
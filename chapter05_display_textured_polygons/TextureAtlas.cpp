@@ -0,0 +1,198 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace yuxx {
+namespace DirectX12 {
+TextureAtlas::TextureAtlas(uint32_t width, uint32_t height, uint32_t padding)
+	: m_width(width), m_height(height), m_padding(padding)
+{
+	Clear();
+}
+
+void TextureAtlas::Clear()
+{
+	m_skyline.clear();
+	// ŏ͕ς̍0̒i1
+	m_skyline.push_back({ 0, 0, m_width });
+	m_usedArea = 0;
+}
+
+float TextureAtlas::Occupancy() const
+{
+	return static_cast<float>(m_usedArea) / (static_cast<float>(m_width) * m_height);
+}
+
+bool TextureAtlas::Fit(size_t nodeIndex, uint32_t width, uint32_t height, uint32_t& y) const
+{
+	const uint32_t x = m_skyline[nodeIndex].x;
+	if (x + width > m_width) {
+		return false;
+	}
+
+	// ̕E̒iāAԍȉɒu
+	int64_t widthLeft = width;
+	y = 0;
+	for (size_t i = nodeIndex; widthLeft > 0 && i < m_skyline.size(); ++i) {
+		y = (std::max)(y, m_skyline[i].y);
+		if (y + height > m_height) {
+			return false;
+		}
+		widthLeft -= m_skyline[i].width;
+	}
+	return true;
+}
+
+void TextureAtlas::AddSkylineLevel(size_t nodeIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	m_skyline.insert(m_skyline.begin() + nodeIndex, SkylineNode{ x, y + height, width });
+
+	// ViɉBꂽE̒i
+	for (size_t i = nodeIndex + 1; i < m_skyline.size();) {
+		const SkylineNode& previous = m_skyline[i - 1];
+		const uint32_t previousRight = previous.x + previous.width;
+		if (m_skyline[i].x >= previousRight) {
+			break;
+		}
+		const uint32_t shrink = previousRight - m_skyline[i].x;
+		if (m_skyline[i].width <= shrink) {
+			m_skyline.erase(m_skyline.begin() + i);
+			continue;
+		}
+		m_skyline[i].x += shrink;
+		m_skyline[i].width -= shrink;
+		break;
+	}
+
+	// ŗׂ荇i͂܂Ƃ߂
+	for (size_t i = 0; i + 1 < m_skyline.size();) {
+		if (m_skyline[i].y == m_skyline[i + 1].y) {
+			m_skyline[i].width += m_skyline[i + 1].width;
+			m_skyline.erase(m_skyline.begin() + i + 1);
+		} else {
+			++i;
+		}
+	}
+}
+
+bool TextureAtlas::Insert(uint32_t width, uint32_t height, AtlasRegion& region)
+{
+	// 傫0̉摜 UV K^[Ȃ
+	if (width == 0 || height == 0) {
+		return false;
+	}
+
+	const uint32_t paddedWidth = width + m_padding * 2;
+	const uint32_t paddedHeight = height + m_padding * 2;
+
+	// [ԒႭȂʒuIԁBȂi̕
+	uint32_t bestTop = (std::numeric_limits<uint32_t>::max)();
+	uint32_t bestWidth = (std::numeric_limits<uint32_t>::max)();
+	size_t bestIndex = m_skyline.size();
+	uint32_t bestY = 0;
+	for (size_t i = 0; i < m_skyline.size(); ++i) {
+		uint32_t y = 0;
+		if (!Fit(i, paddedWidth, paddedHeight, y)) {
+			continue;
+		}
+		const uint32_t top = y + paddedHeight;
+		if (top < bestTop || (top == bestTop && m_skyline[i].width < bestWidth)) {
+			bestTop = top;
+			bestWidth = m_skyline[i].width;
+			bestIndex = i;
+			bestY = y;
+		}
+	}
+	if (bestIndex == m_skyline.size()) {
+		return false;
+	}
+
+	const uint32_t x = m_skyline[bestIndex].x;
+	AddSkylineLevel(bestIndex, x, bestY, paddedWidth, paddedHeight);
+	m_usedArea += static_cast<uint64_t>(width) * height;
+
+	region.x = x + m_padding;
+	region.y = bestY + m_padding;
+	region.width = width;
+	region.height = height;
+	region.u0 = static_cast<float>(region.x) / m_width;
+	region.v0 = static_cast<float>(region.y) / m_height;
+	region.u1 = static_cast<float>(region.x + width) / m_width;
+	region.v1 = static_cast<float>(region.y + height) / m_height;
+	return true;
+}
+
+bool TextureAtlas::InsertBatch(
+	const std::vector<std::pair<uint32_t, uint32_t>>& sizes,
+	std::vector<AtlasRegion>& regions
+) {
+	// ̑傫ɋl߂
+	std::vector<size_t> order(sizes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&sizes](size_t a, size_t b) {
+		if (sizes[a].second != sizes[b].second) {
+			return sizes[a].second > sizes[b].second;
+		}
+		return sizes[a].first > sizes[b].first;
+	});
+
+	regions.resize(sizes.size());
+	for (const size_t i : order) {
+		if (!Insert(sizes[i].first, sizes[i].second, regions[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void RemapUv(const AtlasRegion& region, float& u, float& v)
+{
+	u = region.u0 + (region.u1 - region.u0) * u;
+	v = region.v0 + (region.v1 - region.v0) * v;
+}
+
+void BlitWithGutter(
+	uint8_t* atlasPixels,
+	size_t atlasRowPitch,
+	uint32_t atlasWidth,
+	uint32_t atlasHeight,
+	const uint8_t* sourcePixels,
+	size_t sourceRowPitch,
+	const AtlasRegion& region,
+	uint32_t padding
+) {
+	// L΂[̃sNZȂ
+	if (region.width == 0 || region.height == 0) {
+		return;
+	}
+
+	constexpr size_t kBytesPerPixel = 4;
+	const int64_t left = static_cast<int64_t>(region.x) - padding;
+	const int64_t right = (std::min)(static_cast<int64_t>(region.x + region.width + padding), static_cast<int64_t>(atlasWidth));
+	const int64_t top = static_cast<int64_t>(region.y) - padding;
+	const int64_t bottom = (std::min)(static_cast<int64_t>(region.y + region.height + padding), static_cast<int64_t>(atlasHeight));
+
+	for (int64_t y = (std::max)(top, int64_t(0)); y < bottom; ++y) {
+		// ㉺̃K^[͒[̍sJԂ
+		const int64_t sourceY = (std::min)((std::max)(y - region.y, int64_t(0)), int64_t(region.height - 1));
+		const uint8_t* sourceRow = sourcePixels + sourceY * sourceRowPitch;
+		uint8_t* atlasRow = atlasPixels + y * atlasRowPitch;
+
+		// g͂̂܂܃Rs[
+		std::memcpy(atlasRow + region.x * kBytesPerPixel, sourceRow, region.width * kBytesPerPixel);
+
+		// ẼK^[͒[̃sNZJԂ
+		for (int64_t x = (std::max)(left, int64_t(0)); x < region.x; ++x) {
+			std::memcpy(atlasRow + x * kBytesPerPixel, sourceRow, kBytesPerPixel);
+		}
+		const uint8_t* lastPixel = sourceRow + (region.width - 1) * kBytesPerPixel;
+		for (int64_t x = region.x + region.width; x < right; ++x) {
+			std::memcpy(atlasRow + x * kBytesPerPixel, lastPixel, kBytesPerPixel);
+		}
+	}
+}
+}
+}
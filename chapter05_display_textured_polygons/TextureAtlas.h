@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+// AgX1摜̗̈(K^[g)
+struct AtlasRegion
+{
+	uint32_t x, y, width, height;
+	// K UV `
+	float u0, v0, u1, v1;
+};
+
+// XJCC@(Bottom-Left)ŋ`l߂eNX`AgX
+// s1ǉ邱ƂA܂Ƃ߂ċl߂邱Ƃł
+class TextureAtlas
+{
+public:
+	// padding ̓~bv}bvłɂ܂Ȃ悤e摜̎͂ɋ󂯂K^[̃sNZ
+	TextureAtlas(uint32_t width, uint32_t height, uint32_t padding);
+
+	// 1ǉB肫ȂƂA0̂Ƃ false
+	bool Insert(uint32_t width, uint32_t height, AtlasRegion& region);
+	// ܂Ƃ߂ĒǉB̑傫ɋl߂̂ Insert JԂ薧xB
+	// regions  sizes ƓɕԁB1ł肫Ȃ false
+	bool InsertBatch(
+		const std::vector<std::pair<uint32_t, uint32_t>>& sizes,
+		std::vector<AtlasRegion>& regions
+	);
+	void Clear();
+
+	uint32_t Width() const { return m_width; }
+	uint32_t Height() const { return m_height; }
+	// l߂摜(K^[)̖ʐ / AgX̖ʐ
+	float Occupancy() const;
+
+private:
+	struct SkylineNode
+	{
+		uint32_t x, y, width;
+	};
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_padding;
+	uint64_t m_usedArea = 0;
+	std::vector<SkylineNode> m_skyline;
+
+	bool Fit(size_t nodeIndex, uint32_t width, uint32_t height, uint32_t& y) const;
+	void AddSkylineLevel(size_t nodeIndex, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+};
+
+//  UV(0`1)AgX UV ɕϊ
+void RemapUv(const AtlasRegion& region, float& u, float& v);
+
+// RGBA8 ̉摜 region ɃRs[A padding sNZɒ[̐FL΂B
+// region ̕0Ȃ牽Ȃ
+void BlitWithGutter(
+	uint8_t* atlasPixels,
+	size_t atlasRowPitch,
+	uint32_t atlasWidth,
+	uint32_t atlasHeight,
+	const uint8_t* sourcePixels,
+	size_t sourceRowPitch,
+	const AtlasRegion& region,
+	uint32_t padding
+);
+}
+}
@@ -0,0 +1,203 @@
+#include "TextureConversion.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// f̒ R, G, B, A oCgڂɂ邩(a  4 Ȃs)
+	struct ChannelOrder
+	{
+		uint32_t r;
+		uint32_t g;
+		uint32_t b;
+		uint32_t a;
+	};
+
+	ChannelOrder SourceChannelOrder(uint32_t sourceFormat)
+	{
+		switch (sourceFormat) {
+		case kSourceBgr8:
+			return { 2, 1, 0, 4 };
+		case kSourceRgba8:
+			return { 0, 1, 2, 3 };
+		case kSourceBgra8:
+			return { 2, 1, 0, 3 };
+		default:
+			return { 0, 1, 2, 4 };
+		}
+	}
+
+	uint32_t HalfSize(uint32_t size)
+	{
+		return (std::max)(size / 2, 1u);
+	}
+
+	const float* LoadClamped(const ConvertedImage& image, uint32_t x, uint32_t y)
+	{
+		x = (std::min)(x, image.width - 1);
+		y = (std::min)(y, image.height - 1);
+		return &image.pixels[(static_cast<size_t>(y) * image.width + x) * 4];
+	}
+}
+
+uint32_t SourceBytesPerPixel(uint32_t sourceFormat)
+{
+	return sourceFormat == kSourceRgb8 || sourceFormat == kSourceBgr8 ? 3 : 4;
+}
+
+uint32_t SourceRowPitch(uint32_t width, uint32_t sourceFormat)
+{
+	return (width * SourceBytesPerPixel(sourceFormat) + 3) & ~3u;
+}
+
+size_t SourceBufferSize(uint32_t width, uint32_t height, uint32_t sourceFormat)
+{
+	return static_cast<size_t>(SourceRowPitch(width, sourceFormat)) * height + 4;
+}
+
+uint32_t MipCount(uint32_t width, uint32_t height)
+{
+	uint32_t count = 1;
+	for (uint32_t size = (std::max)(width, height); size > 1; size /= 2) {
+		++count;
+	}
+	return count;
+}
+
+TextureConversionConstants MakeTextureConversionConstants(
+	uint32_t width,
+	uint32_t height,
+	uint32_t sourceFormat,
+	uint32_t flags
+) {
+	TextureConversionConstants constants{};
+	constants.width = width;
+	constants.height = height;
+	constants.sourceRowPitch = SourceRowPitch(width, sourceFormat);
+	constants.sourceFormat = sourceFormat;
+	constants.flags = flags;
+	return constants;
+}
+
+float SrgbToLinear(float value)
+{
+	return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+void PremultiplyRgba8(uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch)
+{
+	for (uint32_t y = 0; y < height; ++y) {
+		uint8_t* pixel = pixels + y * rowPitch;
+		for (uint32_t x = 0; x < width; ++x, pixel += 4) {
+			const uint32_t alpha = pixel[3];
+			// ľܓ c * a / 255
+			for (int channel = 0; channel < 3; ++channel) {
+				pixel[channel] = static_cast<uint8_t>((pixel[channel] * alpha + 127) / 255);
+			}
+		}
+	}
+}
+
+void PremultiplyRgba16(uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch)
+{
+	for (uint32_t y = 0; y < height; ++y) {
+		uint16_t* pixel = reinterpret_cast<uint16_t*>(pixels + y * rowPitch);
+		for (uint32_t x = 0; x < width; ++x, pixel += 4) {
+			const uint32_t alpha = pixel[3];
+			for (int channel = 0; channel < 3; ++channel) {
+				pixel[channel] = static_cast<uint16_t>((pixel[channel] * alpha + 32767) / 65535);
+			}
+		}
+	}
+}
+
+void ConvertTextureReference(
+	const uint8_t* source,
+	const TextureConversionConstants& constants,
+	ConvertedImage& destination
+) {
+	destination.width = constants.width;
+	destination.height = constants.height;
+	destination.pixels.resize(static_cast<size_t>(constants.width) * constants.height * 4);
+
+	const ChannelOrder order = SourceChannelOrder(constants.sourceFormat);
+	const uint32_t bytesPerPixel = SourceBytesPerPixel(constants.sourceFormat);
+	for (uint32_t y = 0; y < constants.height; ++y) {
+		const uint8_t* row = source + static_cast<size_t>(y) * constants.sourceRowPitch;
+		float* output = &destination.pixels[static_cast<size_t>(y) * constants.width * 4];
+		for (uint32_t x = 0; x < constants.width; ++x) {
+			const uint8_t* pixel = row + static_cast<size_t>(x) * bytesPerPixel;
+			float color[4] = {
+				pixel[order.r] / 255.0f,
+				pixel[order.g] / 255.0f,
+				pixel[order.b] / 255.0f,
+				order.a < bytesPerPixel ? pixel[order.a] / 255.0f : 1.0f,
+			};
+			for (int channel = 0; channel < 3; ++channel) {
+				if ((constants.flags & kConvertLinearize) != 0) {
+					color[channel] = SrgbToLinear(color[channel]);
+				}
+				if ((constants.flags & kConvertPremultiply) != 0) {
+					color[channel] *= color[3];
+				}
+			}
+			std::copy(color, color + 4, output + static_cast<size_t>(x) * 4);
+		}
+	}
+}
+
+void DownsampleReference(const ConvertedImage& source, ConvertedImage& destination)
+{
+	destination.width = HalfSize(source.width);
+	destination.height = HalfSize(source.height);
+	destination.pixels.resize(static_cast<size_t>(destination.width) * destination.height * 4);
+
+	for (uint32_t y = 0; y < destination.height; ++y) {
+		for (uint32_t x = 0; x < destination.width; ++x) {
+			const float* texels[4] = {
+				LoadClamped(source, x * 2, y * 2),
+				LoadClamped(source, x * 2 + 1, y * 2),
+				LoadClamped(source, x * 2, y * 2 + 1),
+				LoadClamped(source, x * 2 + 1, y * 2 + 1),
+			};
+			float* output = &destination.pixels[(static_cast<size_t>(y) * destination.width + x) * 4];
+			for (int channel = 0; channel < 4; ++channel) {
+				// VF[_[Ɠɑ
+				output[channel] =
+					((texels[0][channel] + texels[1][channel]) + (texels[2][channel] + texels[3][channel])) * 0.25f;
+			}
+		}
+	}
+}
+
+void GenerateMipsReference(std::vector<ConvertedImage>& mips)
+{
+	const uint32_t mipCount = MipCount(mips[0].width, mips[0].height);
+	mips.resize(mipCount);
+	for (uint32_t mip = 1; mip < mipCount; ++mip) {
+		DownsampleReference(mips[mip - 1], mips[mip]);
+	}
+}
+
+void QuantizeToUnorm8(ConvertedImage& image)
+{
+	for (float& value : image.pixels) {
+		value = std::floor((std::min)((std::max)(value, 0.0f), 1.0f) * 255.0f + 0.5f) / 255.0f;
+	}
+}
+
+float MaxDifference(const ConvertedImage& left, const ConvertedImage& right)
+{
+	if (left.width != right.width || left.height != right.height || left.pixels.size() != right.pixels.size()) {
+		return 2.0f;
+	}
+	float difference = 0.0f;
+	for (size_t i = 0; i < left.pixels.size(); ++i) {
+		difference = (std::max)(difference, std::fabs(left.pixels[i] - right.pixels[i]));
+	}
+	return difference;
+}
+}
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+// Abv[h摜̉f̕(TextureConversion.hlsl  kSource* Ɠl)
+enum TextureSourceFormat : uint32_t {
+	kSourceRgb8,
+	kSourceBgr8,
+	kSourceRgba8,
+	kSourceBgra8,
+};
+
+// ϊōs(TextureConversion.hlsl  kConvert* Ɠl)
+enum TextureConversionFlag : uint32_t {
+	// sRGB `ɂ
+	kConvertLinearize = 1,
+	// RGB  a |Ă(`ɂƂŊ|)
+	kConvertPremultiply = 2,
+};
+
+// TextureConversion.hlsl  TextureConversionConstants ƓCAEg([g萔œn)
+struct TextureConversionConstants
+{
+	//  mip ̑傫
+	uint32_t width;
+	uint32_t height;
+	// ConvertCS g
+	uint32_t sourceRowPitch;
+	uint32_t sourceFormat;
+	uint32_t flags;
+};
+
+// TextureConversion.hlsl  numthreads ƍ킹
+constexpr uint32_t kTextureConversionThreadGroupSize = 8;
+
+uint32_t SourceBytesPerPixel(uint32_t sourceFormat);
+// ByteAddressBuffer 4oCgPʂœǂނ̂ŁAs̐擪4oCgɑ
+uint32_t SourceRowPitch(uint32_t width, uint32_t sourceFormat);
+// 3oCg̉f͎4oCg܂Ƃ߂ēǂނ̂ŁAŌ̍š4oCgĂ
+size_t SourceBufferSize(uint32_t width, uint32_t height, uint32_t sourceFormat);
+// 1x1 ܂ł̃~bv̐
+uint32_t MipCount(uint32_t width, uint32_t height);
+
+TextureConversionConstants MakeTextureConversionConstants(
+	uint32_t width,
+	uint32_t height,
+	uint32_t sourceFormat,
+	uint32_t flags
+);
+
+float SrgbToLinear(float value);
+// CPU ŃAbv[h R8G8B8A8 ̉f RGB  a |(ConvertCS  kConvertPremultiply ƈႢA`ɂ͂Ȃ)
+void PremultiplyRgba8(uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch);
+// R16G16B16A16 ŁBpixels  2 oCgEɑĂ邱
+void PremultiplyRgba16(uint8_t* pixels, uint32_t width, uint32_t height, size_t rowPitch);
+
+// ϊeNX`1(RGBA  float ׂ)
+struct ConvertedImage
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector<float> pixels;
+};
+
+// eJ[l CPU ŁBGPU ̌ʂƓ˂킹邽߂ɎgB
+// vZ̏̓VF[_[ƑĂBݐ̃tH[}bg̊ۂ߂Č΁AGPU  pow ̐x̕Ĉv
+void ConvertTextureReference(
+	const uint8_t* source,
+	const TextureConversionConstants& constants,
+	ConvertedImage& destination
+);
+// DownsampleCS Ɠ 2x2 ̕ρB̑傫ł͍Ō̗(s)ǂ܂ȂB傫 1 ͓̕f2ǂ
+void DownsampleReference(const ConvertedImage& source, ConvertedImage& destination);
+// mips[0]  1x1 ܂łɏk
+void GenerateMipsReference(std::vector<ConvertedImage>& mips);
+// R8G8B8A8_UNORM ɏ񂾂Ƃ̊ۂ߂Č
+void QuantizeToUnorm8(ConvertedImage& image);
+// 2̍ő̍(傫Ⴆ 1 傫l)
+float MaxDifference(const ConvertedImage& left, const ConvertedImage& right);
+}
+}
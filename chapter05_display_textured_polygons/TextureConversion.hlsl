@@ -0,0 +1,98 @@
+// TextureConversion.h  TextureSourceFormat
+static const uint kSourceRgb8 = 0;
+static const uint kSourceBgr8 = 1;
+static const uint kSourceRgba8 = 2;
+static const uint kSourceBgra8 = 3;
+// TextureConversion.h  TextureConversionFlag
+static const uint kConvertLinearize = 1;
+static const uint kConvertPremultiply = 2;
+
+// [g萔œn(TextureConversion.h  TextureConversionConstants)
+cbuffer TextureConversionConstants : register(b0)
+{
+    //  mip ̑傫
+    uint2 outputSize;
+    // ConvertCS g
+    uint sourceRowPitch;
+    uint sourceFormat;
+    uint flags;
+};
+
+// fR[h܂܂̉f(s̐擪4oCgɑĂ)
+ByteAddressBuffer sourceBytes : register(t0);
+// DownsampleCS ǂ1ׂ mip
+Texture2D<float4> sourceMip : register(t1);
+RWTexture2D<float4> destination : register(u0);
+
+float3 SrgbToLinear(float3 color)
+{
+    float3 low = color / 12.92f;
+    float3 high = pow((color + 0.055f) / 1.055f, 2.4f);
+    // SM5 ł͎OZqvfƂɑI
+    return color <= 0.04045f ? low : high;
+}
+
+// address 4oCgǂށB4oCgɑĂȂΎ4oCgƌq
+uint LoadUnaligned(uint address)
+{
+    uint offset = address & 3;
+    uint2 words = sourceBytes.Load2(address - offset);
+    return offset == 0 ? words.x : (words.x >> (offset * 8)) | (words.y << (32 - offset * 8));
+}
+
+float4 UnpackPixel(uint pixel)
+{
+    float4 bytes = float4(pixel & 0xFF, (pixel >> 8) & 0xFF, (pixel >> 16) & 0xFF, pixel >> 24) / 255.0f;
+    switch (sourceFormat)
+    {
+    case kSourceBgr8:
+        return float4(bytes.zyx, 1.0f);
+    case kSourceRgba8:
+        return bytes;
+    case kSourceBgra8:
+        return bytes.zyxw;
+    default:
+        return float4(bytes.xyz, 1.0f);
+    }
+}
+
+// ̉f mip 0 ̌`ɂ
+[numthreads(8, 8, 1)]
+void ConvertCS(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    if (any(dispatchThreadId.xy >= outputSize))
+    {
+        return;
+    }
+    uint bytesPerPixel = sourceFormat == kSourceRgb8 || sourceFormat == kSourceBgr8 ? 3 : 4;
+    uint address = dispatchThreadId.y * sourceRowPitch + dispatchThreadId.x * bytesPerPixel;
+    float4 color = UnpackPixel(LoadUnaligned(address));
+    if (flags & kConvertLinearize)
+    {
+        color.rgb = SrgbToLinear(color.rgb);
+    }
+    if (flags & kConvertPremultiply)
+    {
+        color.rgb *= color.a;
+    }
+    destination[dispatchThreadId.xy] = color;
+}
+
+// 1ׂ mip  2x2 f̕ς
+[numthreads(8, 8, 1)]
+void DownsampleCS(uint3 dispatchThreadId : SV_DispatchThreadID)
+{
+    if (any(dispatchThreadId.xy >= outputSize))
+    {
+        return;
+    }
+    uint width;
+    uint height;
+    sourceMip.GetDimensions(width, height);
+    // ̑傫ł͍Ō̗(s)ǂ܂ȂB傫 1 ͓̕f2ǂ
+    int2 last = int2(width, height) - 1;
+    int2 position = int2(dispatchThreadId.xy) * 2;
+    float4 top = sourceMip.Load(int3(min(position, last), 0)) + sourceMip.Load(int3(min(position + int2(1, 0), last), 0));
+    float4 bottom = sourceMip.Load(int3(min(position + int2(0, 1), last), 0)) + sourceMip.Load(int3(min(position + int2(1, 1), last), 0));
+    destination[dispatchThreadId.xy] = (top + bottom) * 0.25f;
+}
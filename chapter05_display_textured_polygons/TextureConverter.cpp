@@ -0,0 +1,280 @@
+#include "TextureConverter.h"
+
+#include <algorithm>
+#include <vector>
+#include <d3dx12.h>
+
+#include "Helpers.h"
+
+using Microsoft::WRL::ComPtr;
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	// TextureConversion.hlsl ̃WX^[
+	constexpr auto kConversionRootSignature = MakeRootSignatureDescription(
+		D3D12_ROOT_SIGNATURE_FLAG_NONE,
+		RootParameters(
+			RootConstants("TextureConversionConstants", "conversion", 0, sizeof(TextureConversionConstants) / sizeof(uint32_t)),
+			RootDescriptor(D3D12_ROOT_PARAMETER_TYPE_SRV, "ByteAddressBuffer", "sourceBytes", 0),
+			DescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, "Texture2D<float4>", "sourceMip", 1),
+			DescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, "RWTexture2D<float4>", "destination", 0)
+		),
+		StaticSamplers()
+	);
+
+	// kConversionRootSignature ̕
+	enum ConversionRootParameter {
+		kConstantsParameter,
+		kSourceBytesParameter,
+		kSourceMipParameter,
+		kDestinationParameter,
+	};
+
+	// ϊ1񕪂̃fBXNv^̐(ǂ̑傫ł~bv D3D12_REQ_MIP_LEVELS i܂)
+	constexpr UINT kDescriptorsPerSlot = D3D12_REQ_MIP_LEVELS * 2;
+
+	UINT DispatchCount(UINT size)
+	{
+		return (size + kTextureConversionThreadGroupSize - 1) / kTextureConversionThreadGroupSize;
+	}
+}
+
+bool TextureConverter::Initialize(
+	ID3D12Device* device,
+	RootSignatureCache& rootSignatures,
+	ID3D10Blob* convertShader,
+	ID3D10Blob* downsampleShader
+) {
+	m_device = device;
+	m_descriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+	// ϊ̂тɍ蒼ƁAs̑O̕ϊgĂq[vĂ܂̂ōŏɍĂ
+	D3D12_DESCRIPTOR_HEAP_DESC heapDesc{};
+	heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+	heapDesc.NumDescriptors = kMaxPendingConversions * kDescriptorsPerSlot;
+	heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+	HRESULT result = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(m_descriptorHeap.ReleaseAndGetAddressOf()));
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateDescriptorHeap Error (for texture conversion): 0x%x\n", result);
+		return false;
+	}
+	m_nextSlot = 0;
+	m_slotBase = 0;
+
+	m_rootSignature = rootSignatures.GetOrCreate(device, kConversionRootSignature);
+	if (m_rootSignature == nullptr) {
+		return false;
+	}
+	return CreatePipelineState(convertShader, "ConvertCS", m_convertPipelineState) &&
+		CreatePipelineState(downsampleShader, "DownsampleCS", m_downsamplePipelineState);
+}
+
+bool TextureConverter::CreatePipelineState(
+	ID3D10Blob* shader,
+	const char* name,
+	ComPtr<ID3D12PipelineState>& pipelineState
+) {
+	D3D12_COMPUTE_PIPELINE_STATE_DESC computePipeline{};
+	computePipeline.pRootSignature = m_rootSignature.Get();
+	computePipeline.CS.pShaderBytecode = shader->GetBufferPointer();
+	computePipeline.CS.BytecodeLength = shader->GetBufferSize();
+	HRESULT result = m_device->CreateComputePipelineState(
+		&computePipeline,
+		IID_PPV_ARGS(pipelineState.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateComputePipelineState Error (%s): 0x%x\n", name, result);
+		return false;
+	}
+	return true;
+}
+
+DXGI_FORMAT TextureConverter::OutputFormat(uint32_t flags)
+{
+	return (flags & kConvertLinearize) != 0 ? DXGI_FORMAT_R16G16B16A16_FLOAT : DXGI_FORMAT_R8G8B8A8_UNORM;
+}
+
+bool TextureConverter::CreateViews(ID3D12Resource* texture, UINT mipCount)
+{
+	if (mipCount * 2 > kDescriptorsPerSlot) {
+		DebugOutputFormatString("Too many mips for texture conversion : %u\n", mipCount);
+		return false;
+	}
+	m_slotBase = (m_nextSlot % kMaxPendingConversions) * kDescriptorsPerSlot;
+	++m_nextSlot;
+
+	const DXGI_FORMAT format = texture->GetDesc().Format;
+	D3D12_CPU_DESCRIPTOR_HANDLE handle = m_descriptorHeap->GetCPUDescriptorHandleForHeapStart();
+	handle.ptr += static_cast<SIZE_T>(m_slotBase) * m_descriptorSize;
+	for (UINT mip = 0; mip < mipCount; ++mip) {
+		// DownsampleCS  GetDimensions  mip ̑傫Ԃ悤A1ĩr[ɂ
+		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+		srvDesc.Format = format;
+		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+		srvDesc.Texture2D.MostDetailedMip = mip;
+		srvDesc.Texture2D.MipLevels = 1;
+		m_device->CreateShaderResourceView(texture, &srvDesc, handle);
+		handle.ptr += m_descriptorSize;
+
+		D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc{};
+		uavDesc.Format = format;
+		uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+		uavDesc.Texture2D.MipSlice = mip;
+		m_device->CreateUnorderedAccessView(texture, nullptr, &uavDesc, handle);
+		handle.ptr += m_descriptorSize;
+	}
+	return true;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE TextureConverter::SrvHandle(UINT mip) const
+{
+	D3D12_GPU_DESCRIPTOR_HANDLE handle = m_descriptorHeap->GetGPUDescriptorHandleForHeapStart();
+	handle.ptr += static_cast<UINT64>(m_slotBase + mip * 2) * m_descriptorSize;
+	return handle;
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE TextureConverter::UavHandle(UINT mip) const
+{
+	D3D12_GPU_DESCRIPTOR_HANDLE handle = SrvHandle(mip);
+	handle.ptr += m_descriptorSize;
+	return handle;
+}
+
+bool TextureConverter::Convert(
+	const ImageSource& image,
+	uint32_t flags,
+	ID3D12GraphicsCommandList* commandList,
+	ComPtr<ID3D12Resource>& texture,
+	ComPtr<ID3D12Resource>& uploadBuffer
+) {
+	const UINT width = image.Width();
+	const UINT height = image.Height();
+	const TextureConversionConstants constants =
+		MakeTextureConversionConstants(width, height, image.SourceFormat(), flags);
+
+	// ԃobt@[͈xǂނȂ̂ŁÃq[vɎʂɂ̂܂ܓǂ
+	const size_t uploadSize = SourceBufferSize(width, height, image.SourceFormat());
+	const CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+	const CD3DX12_RESOURCE_DESC uploadDescription = CD3DX12_RESOURCE_DESC::Buffer(uploadSize);
+	HRESULT result = m_device->CreateCommittedResource(
+		&uploadHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&uploadDescription,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(uploadBuffer.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommittedResource Error (for texture conversion upload): 0x%x\n", result);
+		return false;
+	}
+
+	uint8_t* mapped = nullptr;
+	result = uploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mapped));
+	if (FAILED(result)) {
+		DebugOutputFormatString("Upload buffer map Error : 0x%x\n", result);
+		return false;
+	}
+	const bool decoded = image.CopyPixels(mapped, constants.sourceRowPitch, uploadSize);
+	uploadBuffer->Unmap(0, nullptr);
+	if (!decoded) {
+		return false;
+	}
+
+	const UINT mipCount = MipCount(width, height);
+	const CD3DX12_HEAP_PROPERTIES textureHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	const CD3DX12_RESOURCE_DESC textureDescription = CD3DX12_RESOURCE_DESC::Tex2D(
+		OutputFormat(flags),
+		width,
+		height,
+		1,
+		static_cast<UINT16>(mipCount),
+		1,
+		0,
+		D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
+	);
+	result = m_device->CreateCommittedResource(
+		&textureHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&textureDescription,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+		nullptr,
+		IID_PPV_ARGS(texture.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommittedResource Error (for converted texture): 0x%x\n", result);
+		return false;
+	}
+	if (!CreateViews(texture.Get(), mipCount)) {
+		return false;
+	}
+
+	ID3D12DescriptorHeap* heaps[] = { m_descriptorHeap.Get() };
+	commandList->SetDescriptorHeaps(1, heaps);
+	commandList->SetComputeRootSignature(m_rootSignature.Get());
+
+	// mip 0: ̉fǂŏށBsourceMip ͓ǂ܂ȂAe[u͖߂Ă
+	commandList->SetPipelineState(m_convertPipelineState.Get());
+	commandList->SetComputeRoot32BitConstants(
+		kConstantsParameter,
+		sizeof(TextureConversionConstants) / sizeof(uint32_t),
+		&constants,
+		0
+	);
+	commandList->SetComputeRootShaderResourceView(kSourceBytesParameter, uploadBuffer->GetGPUVirtualAddress());
+	commandList->SetComputeRootDescriptorTable(kSourceMipParameter, SrvHandle(0));
+	commandList->SetComputeRootDescriptorTable(kDestinationParameter, UavHandle(0));
+	commandList->Dispatch(DispatchCount(width), DispatchCount(height), 1);
+
+	// c mip: 1O mip ǂ߂悤ɂĂ甼ɏk߂
+	commandList->SetPipelineState(m_downsamplePipelineState.Get());
+	for (UINT mip = 1; mip < mipCount; ++mip) {
+		const auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+			texture.Get(),
+			D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+			mip - 1
+		);
+		commandList->ResourceBarrier(1, &barrier);
+
+		const UINT mipWidth = (std::max)(width >> mip, 1u);
+		const UINT mipHeight = (std::max)(height >> mip, 1u);
+		const TextureConversionConstants mipConstants =
+			MakeTextureConversionConstants(mipWidth, mipHeight, image.SourceFormat(), flags);
+		commandList->SetComputeRoot32BitConstants(
+			kConstantsParameter,
+			sizeof(TextureConversionConstants) / sizeof(uint32_t),
+			&mipConstants,
+			0
+		);
+		commandList->SetComputeRootDescriptorTable(kSourceMipParameter, SrvHandle(mip - 1));
+		commandList->SetComputeRootDescriptorTable(kDestinationParameter, UavHandle(mip));
+		commandList->Dispatch(DispatchCount(mipWidth), DispatchCount(mipHeight), 1);
+	}
+
+	// Rs[gL[ł PIXEL_SHADER_RESOURCE ɂłȂ̂ COMMON ɖ߂
+	std::vector<D3D12_RESOURCE_BARRIER> barriers;
+	for (UINT mip = 0; mip < mipCount; ++mip) {
+		barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(
+			texture.Get(),
+			mip + 1 < mipCount ? D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE : D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			D3D12_RESOURCE_STATE_COMMON,
+			mip
+		));
+	}
+	commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+
+	DebugOutputFormatString(
+		"Texture conversion recorded : %u x %u, %u mips, %llu bytes uploaded\n",
+		width,
+		height,
+		mipCount,
+		static_cast<unsigned long long>(uploadSize)
+	);
+	return true;
+}
+}
+}
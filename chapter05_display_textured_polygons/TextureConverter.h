@@ -0,0 +1,60 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl.h>
+#include <cstdint>
+
+#include "ImageDecoder.h"
+#include "RootSignatureBuilder.h"
+#include "TextureConversion.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// fR[h܂܂̉fRs[gVF[_[ŃeNX`̌`ɂA~bvB
+// CPU ͒ԃobt@[Ɍ̕т̂܂܏ŁAבւE`EZς݃At@Ek GPU ōs
+class TextureConverter
+{
+public:
+	//  GPU Ŏsɂłϊ̐
+	static constexpr UINT kMaxPendingConversions = 4;
+
+	bool Initialize(
+		ID3D12Device* device,
+		RootSignatureCache& rootSignatures,
+		ID3D10Blob* convertShader,
+		ID3D10Blob* downsampleShader
+	);
+
+	// `ɂƂ͈Â̊KׂȂ悤 16bit  float ɏ
+	static DXGI_FORMAT OutputFormat(uint32_t flags);
+
+	// image 𒆊ԃobt@[ɃfR[hAϊƃ~bv̍쐬 commandList(Rs[g)ɐςށB
+	// texture ͍Ō COMMON ɖ߂̂ŁA`L[ł͈Öقɏiēǂ߂B
+	// uploadBuffer  commandList ̎sI܂ŎcĂB
+	// fBXNv^͕ϊƂɏɎg񂷂̂ŁAkMaxPendingConversions O̕ϊ GPU ŏIĂĂԂ
+	bool Convert(
+		const ImageSource& image,
+		uint32_t flags,
+		ID3D12GraphicsCommandList* commandList,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& texture,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& uploadBuffer
+	);
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12Device> m_device;
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> m_rootSignature;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> m_convertPipelineState;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> m_downsamplePipelineState;
+	// ϊ1񕪂̘g kMaxPendingConversions ׂBg̒ mip Ƃ SRV, UAV ̏2
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_descriptorHeap;
+	UINT m_descriptorSize = 0;
+	// ̕ϊŎggƁA̕ϊŎgĂg̐擪̃fBXNv^
+	UINT m_nextSlot = 0;
+	UINT m_slotBase = 0;
+
+	bool CreatePipelineState(ID3D10Blob* shader, const char* name, Microsoft::WRL::ComPtr<ID3D12PipelineState>& pipelineState);
+	bool CreateViews(ID3D12Resource* texture, UINT mipCount);
+	D3D12_GPU_DESCRIPTOR_HANDLE SrvHandle(UINT mip) const;
+	D3D12_GPU_DESCRIPTOR_HANDLE UavHandle(UINT mip) const;
+};
+}
+}
@@ -0,0 +1,25 @@
+#include "TextureCopy.h"
+
+#include <cstring>
+
+namespace yuxx {
+namespace DirectX12 {
+void CopyRows(
+	uint8_t* destination,
+	size_t destinationRowPitch,
+	const uint8_t* source,
+	size_t sourceRowPitch,
+	size_t rowSize,
+	uint32_t rowCount
+) {
+	// ssb`Ȃ1ōς
+	if (destinationRowPitch == rowSize && sourceRowPitch == rowSize) {
+		std::memcpy(destination, source, rowSize * rowCount);
+		return;
+	}
+	for (uint32_t row = 0; row < rowCount; ++row) {
+		std::memcpy(destination + row * destinationRowPitch, source + row * sourceRowPitch, rowSize);
+	}
+}
+}
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace yuxx {
+namespace DirectX12 {
+// rowSize oCg̍s rowCount sAssb`lߑւăRs[B
+// Abv[hobt@[̃tbgvg(256 oCgE)Ɖ摜̍ssb`ႤƂɎg
+void CopyRows(
+	uint8_t* destination,
+	size_t destinationRowPitch,
+	const uint8_t* source,
+	size_t sourceRowPitch,
+	size_t rowSize,
+	uint32_t rowCount
+);
+}
+}
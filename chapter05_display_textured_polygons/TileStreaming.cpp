@@ -0,0 +1,289 @@
+#include "TileStreaming.h"
+
+#include <algorithm>
+
+namespace yuxx {
+namespace DirectX12 {
+TileLayout::TileLayout(uint32_t width, uint32_t height, uint32_t tileWidth, uint32_t tileHeight, uint32_t streamedMipCount) :
+	m_tileWidth(tileWidth),
+	m_tileHeight(tileHeight)
+{
+	for (uint32_t mip = 0; mip < streamedMipCount; ++mip) {
+		const uint32_t mipWidth = (std::max)(width >> mip, 1u);
+		const uint32_t mipHeight = (std::max)(height >> mip, 1u);
+		m_tilesX.push_back((mipWidth + tileWidth - 1) / tileWidth);
+		m_tilesY.push_back((mipHeight + tileHeight - 1) / tileHeight);
+		m_offsets.push_back(m_tileCount);
+		m_tileCount += static_cast<size_t>(m_tilesX.back()) * m_tilesY.back();
+	}
+}
+
+TileKey TileLayout::CoveringTile(uint32_t mip, uint32_t x0, uint32_t y0) const
+{
+	// [̂~bvł́A͂ݏoZŌ̃^CɊ񂹂
+	return MakeTileKey(mip, (std::min)(x0 >> mip, m_tilesX[mip] - 1), (std::min)(y0 >> mip, m_tilesY[mip] - 1));
+}
+
+TileFeedbackAggregator::TileFeedbackAggregator(const TileLayout& layout) :
+	m_layout(layout),
+	m_minMips(layout.TileCount()),
+	m_weights(layout.TileCount())
+{
+}
+
+void TileFeedbackAggregator::Aggregate(const uint32_t* feedback, std::vector<TileRequest>& requests)
+{
+	requests.clear();
+	const uint32_t mipCount = m_layout.StreamedMipCount();
+	if (feedback == nullptr || mipCount == 0) {
+		return;
+	}
+
+	// ~bv 0 ̓tB[hobN̂́BpbNꂽ~bvőZ͐Ȃ
+	const size_t cellCount = static_cast<size_t>(m_layout.TilesX(0)) * m_layout.TilesY(0);
+	for (size_t i = 0; i < cellCount; ++i) {
+		const bool requested = feedback[i] < mipCount;
+		m_minMips[i] = requested ? feedback[i] : kNoTileFeedback;
+		m_weights[i] = requested ? 1 : 0;
+	}
+	// 1ׂ~bv 2x2 ^CAłׂvƗv̐܂Ƃ߂
+	for (uint32_t mip = 1; mip < mipCount; ++mip) {
+		const size_t begin = m_layout.LinearIndex(mip, 0, 0);
+		const size_t end = begin + static_cast<size_t>(m_layout.TilesX(mip)) * m_layout.TilesY(mip);
+		std::fill(m_minMips.begin() + begin, m_minMips.begin() + end, kNoTileFeedback);
+		std::fill(m_weights.begin() + begin, m_weights.begin() + end, 0u);
+
+		const uint32_t lastX = m_layout.TilesX(mip) - 1;
+		const uint32_t lastY = m_layout.TilesY(mip) - 1;
+		for (uint32_t y = 0; y < m_layout.TilesY(mip - 1); ++y) {
+			const size_t child = m_layout.LinearIndex(mip - 1, 0, y);
+			const size_t parentRow = m_layout.LinearIndex(mip, 0, (std::min)(y / 2, lastY));
+			for (uint32_t x = 0; x < m_layout.TilesX(mip - 1); ++x) {
+				const size_t parent = parentRow + (std::min)(x / 2, lastX);
+				m_minMips[parent] = (std::min)(m_minMips[parent], m_minMips[child + x]);
+				m_weights[parent] += m_weights[child + x];
+			}
+		}
+	}
+
+	// e~bvׂ͂̂ǂݍ܂܂ł̑ɂȂ̂Őɓǂ
+	for (uint32_t mip = mipCount; mip-- > 0;) {
+		const size_t first = requests.size();
+		for (uint32_t y = 0; y < m_layout.TilesY(mip); ++y) {
+			const size_t row = m_layout.LinearIndex(mip, 0, y);
+			for (uint32_t x = 0; x < m_layout.TilesX(mip); ++x) {
+				if (m_minMips[row + x] <= mip) {
+					requests.push_back({ MakeTileKey(mip, x, y), m_weights[row + x] });
+				}
+			}
+		}
+		std::stable_sort(
+			requests.begin() + first,
+			requests.end(),
+			[](const TileRequest& left, const TileRequest& right) { return left.weight > right.weight; }
+		);
+	}
+}
+
+TileCache::TileCache(uint32_t slotCount)
+{
+	Reset(slotCount);
+}
+
+void TileCache::Reset(uint32_t slotCount)
+{
+	m_slots.assign(slotCount, Slot());
+	m_freeSlots.clear();
+	// ԍg
+	for (uint32_t slot = slotCount; slot-- > 0;) {
+		m_freeSlots.push_back(slot);
+	}
+	m_head = kInvalidSlot;
+	m_tail = kInvalidSlot;
+	m_slotByKey.clear();
+	m_slotByKey.reserve(slotCount);
+}
+
+uint32_t TileCache::Find(TileKey key) const
+{
+	const auto found = m_slotByKey.find(key);
+	return found != m_slotByKey.end() ? found->second : kInvalidSlot;
+}
+
+void TileCache::Touch(uint32_t slot, uint64_t frame)
+{
+	m_slots[slot].lastUsedFrame = frame;
+	if (slot != m_tail) {
+		Unlink(slot);
+		LinkBack(slot);
+	}
+}
+
+uint32_t TileCache::Allocate(TileKey key, uint64_t frame, bool& evicted, TileKey& evictedKey)
+{
+	evicted = false;
+	uint32_t slot = kInvalidSlot;
+	if (!m_freeSlots.empty()) {
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	} else {
+		// 擪łÂB̃t[ŎgĂȂAǂǂoȂ
+		if (m_head == kInvalidSlot || m_slots[m_head].lastUsedFrame >= frame) {
+			return kInvalidSlot;
+		}
+		slot = m_head;
+		Unlink(slot);
+		evicted = true;
+		evictedKey = m_slots[slot].key;
+		m_slotByKey.erase(evictedKey);
+	}
+
+	m_slots[slot].key = key;
+	m_slots[slot].lastUsedFrame = frame;
+	LinkBack(slot);
+	m_slotByKey.emplace(key, slot);
+	return slot;
+}
+
+void TileCache::Release(TileKey key)
+{
+	const auto found = m_slotByKey.find(key);
+	if (found == m_slotByKey.end()) {
+		return;
+	}
+	const uint32_t slot = found->second;
+	m_slotByKey.erase(found);
+	Unlink(slot);
+	m_freeSlots.push_back(slot);
+}
+
+void TileCache::Unlink(uint32_t slot)
+{
+	Slot& entry = m_slots[slot];
+	if (entry.previous != kInvalidSlot) {
+		m_slots[entry.previous].next = entry.next;
+	} else {
+		m_head = entry.next;
+	}
+	if (entry.next != kInvalidSlot) {
+		m_slots[entry.next].previous = entry.previous;
+	} else {
+		m_tail = entry.previous;
+	}
+	entry.previous = kInvalidSlot;
+	entry.next = kInvalidSlot;
+}
+
+void TileCache::LinkBack(uint32_t slot)
+{
+	Slot& entry = m_slots[slot];
+	entry.previous = m_tail;
+	entry.next = kInvalidSlot;
+	if (m_tail != kInvalidSlot) {
+		m_slots[m_tail].next = slot;
+	} else {
+		m_head = slot;
+	}
+	m_tail = slot;
+}
+
+TileStreamer::TileStreamer(const TileLayout& layout, const Settings& settings) :
+	m_layout(layout),
+	m_settings(settings),
+	m_aggregator(layout),
+	m_cache(settings.slotCount),
+	m_indirection(
+		static_cast<size_t>(layout.TilesX(0)) * layout.TilesY(0),
+		static_cast<uint8_t>(layout.StreamedMipCount())
+	)
+{
+}
+
+bool TileStreamer::Update(const uint32_t* feedback, uint64_t frame, std::vector<TileUpdate>& updates)
+{
+	updates.clear();
+	m_stats = Stats();
+	m_aggregator.Aggregate(feedback, m_requests);
+	m_stats.requestedTiles = static_cast<uint32_t>(m_requests.size());
+
+	// uĂ̂ɎgƂɂāÃt[ŗv^CǂoȂ悤ɂ
+	for (const TileRequest& request : m_requests) {
+		const uint32_t slot = m_cache.Find(request.key);
+		if (slot != TileCache::kInvalidSlot) {
+			m_cache.Touch(slot, frame);
+		}
+	}
+
+	bool indirectionChanged = m_indirectionPending;
+	m_indirectionPending = false;
+	for (const TileRequest& request : m_requests) {
+		if (updates.size() >= m_settings.maxUploadsPerFrame) {
+			break;
+		}
+		if (m_cache.Find(request.key) != TileCache::kInvalidSlot) {
+			continue;
+		}
+		TileUpdate update{};
+		update.key = request.key;
+		update.slot = m_cache.Allocate(request.key, frame, update.evicted, update.evictedKey);
+		if (update.slot == TileCache::kInvalidSlot) {
+			// XbgׂẴt[ŎgĂ
+			break;
+		}
+		updates.push_back(update);
+		if (update.evicted) {
+			UpdateIndirection(update.evictedKey);
+			++m_stats.evictedTiles;
+		}
+		UpdateIndirection(update.key);
+		indirectionChanged = true;
+	}
+	m_stats.uploadedTiles = static_cast<uint32_t>(updates.size());
+	m_stats.residentTiles = m_cache.ResidentCount();
+	return indirectionChanged;
+}
+
+void TileStreamer::CancelUpdates(const std::vector<TileUpdate>& updates)
+{
+	for (const TileUpdate& update : updates) {
+		m_cache.Release(update.key);
+	}
+	// SOĂ狁ߒ(Z𕢂^CĂ悢)
+	for (const TileUpdate& update : updates) {
+		UpdateIndirection(update.key);
+	}
+	m_indirectionPending = true;
+	m_stats.residentTiles = m_cache.ResidentCount();
+}
+
+void TileStreamer::UpdateIndirection(TileKey key)
+{
+	const uint32_t mip = TileKeyMip(key);
+	const uint32_t x = TileKeyX(key);
+	const uint32_t y = TileKeyY(key);
+	const uint32_t tilesX0 = m_layout.TilesX(0);
+	const uint32_t tilesY0 = m_layout.TilesY(0);
+	// Ō̃^ĆA͂ݏoZ
+	const uint32_t beginX = x << mip;
+	const uint32_t beginY = y << mip;
+	const uint32_t endX = x == m_layout.TilesX(mip) - 1 ? tilesX0 : (std::min)((x + 1) << mip, tilesX0);
+	const uint32_t endY = y == m_layout.TilesY(mip) - 1 ? tilesY0 : (std::min)((y + 1) << mip, tilesY0);
+	for (uint32_t y0 = beginY; y0 < endY; ++y0) {
+		for (uint32_t x0 = beginX; x0 < endX; ++x0) {
+			m_indirection[static_cast<size_t>(y0) * tilesX0 + x0] = ResidentMip(x0, y0);
+		}
+	}
+}
+
+uint8_t TileStreamer::ResidentMip(uint32_t x0, uint32_t y0) const
+{
+	// pbNꂽ~bvׂցAr؂ꂸɒuĂƂ܂ŉB
+	// gCjA1e~bvǂނ̂ŁAԂ~bv͎gȂ
+	uint32_t mip = m_layout.StreamedMipCount();
+	while (mip > 0 && m_cache.Find(m_layout.CoveringTile(mip - 1, x0, y0)) != TileCache::kInvalidSlot) {
+		--mip;
+	}
+	return static_cast<uint8_t>(mip);
+}
+}
+}
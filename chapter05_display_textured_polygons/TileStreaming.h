@@ -0,0 +1,186 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+// ^C1wlB~bv(4bit)Ey(14bit)Ex(14bit)l߂Ă
+using TileKey = uint32_t;
+
+inline TileKey MakeTileKey(uint32_t mip, uint32_t x, uint32_t y)
+{
+	return (mip << 28) | (y << 14) | x;
+}
+inline uint32_t TileKeyMip(TileKey key) { return key >> 28; }
+inline uint32_t TileKeyX(TileKey key) { return key & 0x3FFF; }
+inline uint32_t TileKeyY(TileKey key) { return (key >> 14) & 0x3FFF; }
+
+// tB[hobNłǂ̃~bvvȂZ
+constexpr uint32_t kNoTileFeedback = 0xFFFFFFFF;
+
+// ~bvƂ̃^C̕сB^C̃eNZ͂ǂ̃~bvłB
+// StreamedMipCount e~bv(D3D12 ̃pbNꂽ~bv)̓^CPʂň킸AɒuĂ
+class TileLayout
+{
+public:
+	TileLayout() = default;
+	TileLayout(uint32_t width, uint32_t height, uint32_t tileWidth, uint32_t tileHeight, uint32_t streamedMipCount);
+
+	uint32_t StreamedMipCount() const { return static_cast<uint32_t>(m_tilesX.size()); }
+	uint32_t TileWidth() const { return m_tileWidth; }
+	uint32_t TileHeight() const { return m_tileHeight; }
+	uint32_t TilesX(uint32_t mip) const { return m_tilesX[mip]; }
+	uint32_t TilesY(uint32_t mip) const { return m_tilesY[mip]; }
+	// ׂẴ~bṽ^C̐
+	size_t TileCount() const { return m_tileCount; }
+	// ~bv܂Œʂԍ
+	size_t LinearIndex(uint32_t mip, uint32_t x, uint32_t y) const
+	{
+		return m_offsets[mip] + static_cast<size_t>(y) * m_tilesX[mip] + x;
+	}
+	// ~bv 0 ̃^C(tB[hobNƊԐڎQƃe[ũZ)Amip ő^C
+	TileKey CoveringTile(uint32_t mip, uint32_t x0, uint32_t y0) const;
+
+private:
+	uint32_t m_tileWidth = 0;
+	uint32_t m_tileHeight = 0;
+	std::vector<uint32_t> m_tilesX;
+	std::vector<uint32_t> m_tilesY;
+	std::vector<size_t> m_offsets;
+	size_t m_tileCount = 0;
+};
+
+struct TileRequest
+{
+	TileKey key;
+	// ̃^CvtB[hobÑZ̐
+	uint32_t weight;
+};
+
+// GPU tB[hobN(~bv 0 ̃^CƂɁATvłׂ~bv)A
+// ǂݍނׂ^C̈ꗗɂ܂Ƃ߂Bׂ~bvvŹAe~bvvƂɂ
+class TileFeedbackAggregator
+{
+public:
+	TileFeedbackAggregator() = default;
+	explicit TileFeedbackAggregator(const TileLayout& layout);
+
+	// feedback  TilesX(0) x TilesY(0) B
+	// e~bv珇ɁA~bvł͗v̑ requests ɓ
+	void Aggregate(const uint32_t* feedback, std::vector<TileRequest>& requests);
+
+private:
+	TileLayout m_layout;
+	// ^CƂ́AĂZvłׂ~bvƁAvZ̐
+	std::vector<uint32_t> m_minMips;
+	std::vector<uint32_t> m_weights;
+};
+
+// Iȃ^C̒u(Xbg)AŋߎgĂȂɎg
+class TileCache
+{
+public:
+	static constexpr uint32_t kInvalidSlot = 0xFFFFFFFF;
+
+	explicit TileCache(uint32_t slotCount = 0);
+	void Reset(uint32_t slotCount);
+
+	// uĂ΃XbgAȂ kInvalidSlot
+	uint32_t Find(TileKey key) const;
+	// frame ŎgƂɂāAǂo̍Ōɉ
+	void Touch(uint32_t slot, uint64_t frame);
+	// key ɃXbg蓖ĂB󂫂Ȃ frame OɎgōłÂ̂ǂoA
+	// evicted  true ɂẴ^C evictedKey ɓBׂ frame ŎgĂ kInvalidSlot
+	uint32_t Allocate(TileKey key, uint64_t frame, bool& evicted, TileKey& evictedKey);
+	// key ̃Xbg󂫂ɖ߂BuĂȂΉȂ
+	void Release(TileKey key);
+
+	uint32_t SlotCount() const { return static_cast<uint32_t>(m_slots.size()); }
+	uint32_t ResidentCount() const { return static_cast<uint32_t>(m_slotByKey.size()); }
+
+private:
+	struct Slot
+	{
+		TileKey key = 0;
+		uint64_t lastUsedFrame = 0;
+		uint32_t previous = kInvalidSlot;
+		uint32_t next = kInvalidSlot;
+	};
+
+	std::vector<Slot> m_slots;
+	std::vector<uint32_t> m_freeSlots;
+	// gĂXbg̑oXgB擪łgĂȂ
+	uint32_t m_head = kInvalidSlot;
+	uint32_t m_tail = kInvalidSlot;
+	std::unordered_map<TileKey, uint32_t> m_slotByKey;
+
+	void Unlink(uint32_t slot);
+	void LinkBack(uint32_t slot);
+};
+
+// ǂݍރ^C1Bevicted Ȃ evictedKey ̃^COĂ slot  key u
+struct TileUpdate
+{
+	TileKey key;
+	uint32_t slot;
+	bool evicted;
+	TileKey evictedKey;
+};
+
+// tB[hobNAĂ^C܂̃XbgɓǂݍޏԂ߂B
+// ԐڎQƃe[uɂ́A~bv 0 ̃^CƂɍTvĂ悢łׂ~bv
+class TileStreamer
+{
+public:
+	struct Settings
+	{
+		// ^Cp̃q[vɒu^C̐(64KB ̃^CȂ 64MB)
+		uint32_t slotCount = 1024;
+		// 1t[œǂݍރ^C̏BfR[hƃRs[̎Ԃ}
+		uint32_t maxUploadsPerFrame = 16;
+	};
+
+	struct Stats
+	{
+		uint32_t requestedTiles = 0;
+		uint32_t residentTiles = 0;
+		uint32_t uploadedTiles = 0;
+		uint32_t evictedTiles = 0;
+	};
+
+	TileStreamer() = default;
+	TileStreamer(const TileLayout& layout, const Settings& settings);
+
+	// feedback ͑Õt[̂(Ȃ nullptr)Bǂݍރ^C updates ɓB
+	// ꂽ^C͒ûƂĈ̂ŁÃt[̕`܂ł GPU ɏނƁB
+	// ԐڎQƃe[uς true
+	bool Update(const uint32_t* feedback, uint64_t frame, std::vector<TileUpdate>& updates);
+	// Update ̂ƁÃt[Ń^CԐڎQƃe[u GPU ɏȂƂɌĂԁB
+	// updates ̃^CuĂȂƂɖ߂Bǂo^C͖߂Ȃ(}bv͂OĂ)B
+	// ԐڎQƃe[u͎ Update ŕςƂɂ
+	void CancelUpdates(const std::vector<TileUpdate>& updates);
+
+	const TileLayout& Layout() const { return m_layout; }
+	// TilesX(0) x TilesY(0) Bǂ̃^CȂ StreamedMipCount(pbNꂽ~bv)
+	const std::vector<uint8_t>& IndirectionTable() const { return m_indirection; }
+	const Stats& LastStats() const { return m_stats; }
+
+private:
+	TileLayout m_layout;
+	Settings m_settings;
+	TileFeedbackAggregator m_aggregator;
+	TileCache m_cache;
+	std::vector<TileRequest> m_requests;
+	std::vector<uint8_t> m_indirection;
+	// CancelUpdates ŕςԐڎQƃe[u܂ĂȂ
+	bool m_indirectionPending = false;
+	Stats m_stats;
+
+	// key ̃^CZ̊ԐڎQƂߒ
+	void UpdateIndirection(TileKey key);
+	uint8_t ResidentMip(uint32_t x0, uint32_t y0) const;
+};
+}
+}
@@ -0,0 +1,25 @@
+// ^CœǂݍރeNX`(tex \񃊃\[X̂Ƃ)B
+// Z̓~bv 0 ̃^C1ŁATileStreaming.h  TileStreamer Ɠ
+
+// ZƂ́Aǂݍݍς݂ŎgĂ悢łׂ~bv
+Texture2D<uint> tileIndirection : register(t1);
+// ZƂ́ATvłׂ~bvBt[Ƃ 0xffffffff ɖ߂ CPU ǂ
+RWTexture2D<uint> tileFeedback : register(u1);
+
+float4 SampleStreamed(float2 uv)
+{
+    uint2 cellCount;
+    tileIndirection.GetDimensions(cellCount.x, cellCount.y);
+    // Tv[ WRAP Ȃ̂ uv ܂ԂĂZ߂
+    const uint2 cell = min(uint2(frac(uv) * cellCount), cellCount - 1);
+
+    const float lod = tex.CalculateLevelOfDetail(samplerState, uv);
+    const uint wantedMip = (uint)max(floor(lod), 0.0f);
+    // Z̃sNZ͂قƂǓ~bvv̂ŁAƂAg~bNɏ
+    if (wantedMip < tileFeedback[cell]) {
+        InterlockedMin(tileFeedback[cell], wantedMip);
+    }
+
+    // ܂ǂݍłȂ^C͈AuĂe~bvőɂ
+    return tex.SampleLevel(samplerState, uv, max(lod, (float)tileIndirection[cell]));
+}
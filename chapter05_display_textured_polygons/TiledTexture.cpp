@@ -0,0 +1,624 @@
+#include "TiledTexture.h"
+
+#include <algorithm>
+#include <cstring>
+#include <d3dx12.h>
+
+#include "Helpers.h"
+#include "TextureCopy.h"
+
+using Microsoft::WRL::ComPtr;
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	D3D12_TILED_RESOURCE_COORDINATE TileCoordinate(TileKey key)
+	{
+		return CD3DX12_TILED_RESOURCE_COORDINATE(TileKeyX(key), TileKeyY(key), 0, TileKeyMip(key));
+	}
+}
+
+bool TiledTexture::Initialize(
+	ID3D12Device* device,
+	const ImageDecoder& decoder,
+	const wchar_t* path,
+	const TileStreamer::Settings& settings
+) {
+	m_device = device;
+	m_packedMipsMapped = false;
+	m_hasFeedback = false;
+
+	D3D12_FEATURE_DATA_D3D12_OPTIONS options{};
+	HRESULT result = device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options));
+	if (FAILED(result) || options.TiledResourcesTier < D3D12_TILED_RESOURCES_TIER_2) {
+		DebugOutputFormatString("Tiled resources tier 2 is not supported.\n");
+		return false;
+	}
+
+	ImageSource image;
+	if (!decoder.Open(path, image)) {
+		return false;
+	}
+	// \񃊃\[Xł1ӂ͕̏ςȂ̂ŁA摜͏k߂čłׂ~bvɂ
+	const double fit = (std::min)(
+		1.0,
+		static_cast<double>(D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION) / (std::max)(image.Width(), image.Height())
+	);
+	const UINT width = (std::max)(static_cast<UINT>(image.Width() * fit), 1u);
+	const UINT height = (std::max)(static_cast<UINT>(image.Height() * fit), 1u);
+	UINT mipCount = 1;
+	while (((std::max)(width, height) >> mipCount) != 0) {
+		++mipCount;
+	}
+
+	const CD3DX12_RESOURCE_DESC resourceDescription = CD3DX12_RESOURCE_DESC::Tex2D(
+		image.Format(),
+		width,
+		height,
+		1,
+		static_cast<UINT16>(mipCount),
+		1,
+		0,
+		D3D12_RESOURCE_FLAG_NONE,
+		D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE
+	);
+	result = device->CreateReservedResource(
+		&resourceDescription,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(m_texture.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateReservedResource Error : 0x%x\n", result);
+		return false;
+	}
+
+	UINT tileCount = 0;
+	UINT subresourceTilingCount = 0;
+	device->GetResourceTiling(
+		m_texture.Get(),
+		&tileCount,
+		&m_packedMipInfo,
+		&m_tileShape,
+		&subresourceTilingCount,
+		0,
+		nullptr
+	);
+	if (m_packedMipInfo.NumStandardMips == 0) {
+		DebugOutputFormatString("Texture is too small to stream : %u x %u\n", width, height);
+		return false;
+	}
+	m_slotCount = settings.slotCount;
+	m_streamer = TileStreamer(
+		TileLayout(width, height, m_tileShape.WidthInTexels, m_tileShape.HeightInTexels, m_packedMipInfo.NumStandardMips),
+		settings
+	);
+
+	if (!CreateMipSources(decoder, image, width, height, mipCount)) {
+		return false;
+	}
+
+	// ǂݍރ^C̃XbĝƂɁApbNꂽ~bv̕u
+	const CD3DX12_HEAP_DESC heapDescription(
+		static_cast<UINT64>(m_slotCount + m_packedMipInfo.NumTilesForPackedMips) * kTileSizeInBytes,
+		D3D12_HEAP_TYPE_DEFAULT,
+		0,
+		D3D12_HEAP_FLAG_DENY_BUFFERS | D3D12_HEAP_FLAG_DENY_RT_DS_TEXTURES
+	);
+	result = device->CreateHeap(&heapDescription, IID_PPV_ARGS(m_tileHeap.ReleaseAndGetAddressOf()));
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateHeap Error (for tiles): 0x%x\n", result);
+		return false;
+	}
+
+	// Abv[hq[v Map ܂܂ł悢
+	if (!CreateBuffer(
+			D3D12_HEAP_TYPE_UPLOAD,
+			static_cast<UINT64>(settings.maxUploadsPerFrame) * kTileSizeInBytes,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			m_tileUploadBuffer
+		)) {
+		return false;
+	}
+	result = m_tileUploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&m_tileUploadData));
+	if (FAILED(result)) {
+		DebugOutputFormatString("Tile upload buffer map Error : 0x%x\n", result);
+		return false;
+	}
+
+	// pbNꂽ~bv͏̂ŁAł܂Ƃ߂ăfR[hĂ
+	m_packedMipFootprints.resize(m_packedMipInfo.NumPackedMips);
+	if (m_packedMipInfo.NumPackedMips > 0) {
+		UINT64 uploadSize = 0;
+		device->GetCopyableFootprints(
+			&resourceDescription,
+			m_packedMipInfo.NumStandardMips,
+			m_packedMipInfo.NumPackedMips,
+			0,
+			m_packedMipFootprints.data(),
+			nullptr,
+			nullptr,
+			&uploadSize
+		);
+		if (!CreateBuffer(D3D12_HEAP_TYPE_UPLOAD, uploadSize, D3D12_RESOURCE_STATE_GENERIC_READ, m_packedMipUploadBuffer)) {
+			return false;
+		}
+		uint8_t* uploadData = nullptr;
+		result = m_packedMipUploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&uploadData));
+		if (FAILED(result)) {
+			DebugOutputFormatString("Packed mip upload buffer map Error : 0x%x\n", result);
+			return false;
+		}
+		bool decoded = true;
+		for (UINT i = 0; i < m_packedMipInfo.NumPackedMips && decoded; ++i) {
+			const D3D12_PLACED_SUBRESOURCE_FOOTPRINT& footprint = m_packedMipFootprints[i];
+			decoded = m_mipSources[m_packedMipInfo.NumStandardMips + i].CopyPixels(
+				uploadData + footprint.Offset,
+				footprint.Footprint.RowPitch,
+				static_cast<size_t>(uploadSize - footprint.Offset)
+			);
+		}
+		m_packedMipUploadBuffer->Unmap(0, nullptr);
+		if (!decoded) {
+			return false;
+		}
+	}
+
+	if (!CreateTableTextures()) {
+		return false;
+	}
+
+	DebugOutputFormatString(
+		"Tiled texture : %u x %u, %u mips (%u packed), tile %u x %u, %u slots\n",
+		width,
+		height,
+		mipCount,
+		static_cast<UINT>(m_packedMipInfo.NumPackedMips),
+		m_tileShape.WidthInTexels,
+		m_tileShape.HeightInTexels,
+		m_slotCount
+	);
+	return true;
+}
+
+bool TiledTexture::CreateMipSources(
+	const ImageDecoder& decoder,
+	const ImageSource& image,
+	UINT width,
+	UINT height,
+	UINT mipCount
+) {
+	// ǂ̃~bv̉摜k߂BfR[h̓^CǂނƂɕKvȔ͈͂s
+	m_mipSources.assign(mipCount, ImageSource());
+	for (UINT mip = 0; mip < mipCount; ++mip) {
+		const UINT mipWidth = (std::max)(width >> mip, 1u);
+		const UINT mipHeight = (std::max)(height >> mip, 1u);
+		if (mipWidth == image.Width() && mipHeight == image.Height()) {
+			m_mipSources[mip] = image;
+		} else if (!decoder.Scale(image, mipWidth, mipHeight, m_mipSources[mip])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool TiledTexture::CreateTableTextures()
+{
+	const TileLayout& layout = m_streamer.Layout();
+	const CD3DX12_HEAP_PROPERTIES heapProperties(D3D12_HEAP_TYPE_DEFAULT);
+
+	// ԐڎQƃe[u̓ZƂ 1 oCgBVF[_[͓ǂނ
+	const CD3DX12_RESOURCE_DESC indirectionDescription = CD3DX12_RESOURCE_DESC::Tex2D(
+		DXGI_FORMAT_R8_UINT,
+		layout.TilesX(0),
+		layout.TilesY(0),
+		1,
+		1
+	);
+	HRESULT result = m_device->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&indirectionDescription,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(m_indirectionTexture.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommittedResource Error (for tile indirection): 0x%x\n", result);
+		return false;
+	}
+	UINT64 indirectionUploadSize = 0;
+	m_device->GetCopyableFootprints(&indirectionDescription, 0, 1, 0, &m_indirectionFootprint, nullptr, nullptr, &indirectionUploadSize);
+	if (!CreateBuffer(
+			D3D12_HEAP_TYPE_UPLOAD,
+			indirectionUploadSize,
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			m_indirectionUploadBuffer
+		)) {
+		return false;
+	}
+
+	// tB[hobN̓sNZVF[_[ InterlockedMin ŏ
+	const CD3DX12_RESOURCE_DESC feedbackDescription = CD3DX12_RESOURCE_DESC::Tex2D(
+		DXGI_FORMAT_R32_UINT,
+		layout.TilesX(0),
+		layout.TilesY(0),
+		1,
+		1,
+		1,
+		0,
+		D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
+	);
+	result = m_device->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&feedbackDescription,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(m_feedbackTexture.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommittedResource Error (for tile feedback): 0x%x\n", result);
+		return false;
+	}
+	UINT64 feedbackSize = 0;
+	m_device->GetCopyableFootprints(&feedbackDescription, 0, 1, 0, &m_feedbackFootprint, nullptr, nullptr, &feedbackSize);
+	if (!CreateBuffer(D3D12_HEAP_TYPE_UPLOAD, feedbackSize, D3D12_RESOURCE_STATE_GENERIC_READ, m_feedbackClearBuffer) ||
+		!CreateBuffer(D3D12_HEAP_TYPE_READBACK, feedbackSize, D3D12_RESOURCE_STATE_COPY_DEST, m_feedbackReadbackBuffer)) {
+		return false;
+	}
+	void* clearData = nullptr;
+	result = m_feedbackClearBuffer->Map(0, nullptr, &clearData);
+	if (FAILED(result)) {
+		DebugOutputFormatString("Feedback clear buffer map Error : 0x%x\n", result);
+		return false;
+	}
+	// kNoTileFeedback Ŗ߂
+	std::memset(clearData, 0xFF, static_cast<size_t>(feedbackSize));
+	m_feedbackClearBuffer->Unmap(0, nullptr);
+
+	m_feedback.resize(static_cast<size_t>(layout.TilesX(0)) * layout.TilesY(0));
+	return true;
+}
+
+bool TiledTexture::CreateBuffer(
+	D3D12_HEAP_TYPE heapType,
+	UINT64 size,
+	D3D12_RESOURCE_STATES initialState,
+	ComPtr<ID3D12Resource>& buffer
+) const
+{
+	const CD3DX12_HEAP_PROPERTIES heapProperties(heapType);
+	const CD3DX12_RESOURCE_DESC resourceDescription = CD3DX12_RESOURCE_DESC::Buffer(size);
+	HRESULT result = m_device->CreateCommittedResource(
+		&heapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resourceDescription,
+		initialState,
+		nullptr,
+		IID_PPV_ARGS(buffer.ReleaseAndGetAddressOf())
+	);
+	if (FAILED(result)) {
+		DebugOutputFormatString("CreateCommittedResource Error (for tiled texture buffer): 0x%x\n", result);
+		return false;
+	}
+	return true;
+}
+
+void TiledTexture::CreateViews(D3D12_CPU_DESCRIPTOR_HANDLE firstDescriptor, UINT descriptorSize) const
+{
+	D3D12_CPU_DESCRIPTOR_HANDLE handle = firstDescriptor;
+
+	// ܂ǂݍłȂ~bv܂߂đŜBĂ悢~bv͊ԐڎQƃe[uŌ߂
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+	srvDesc.Format = m_texture->GetDesc().Format;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Texture2D.MipLevels = m_texture->GetDesc().MipLevels;
+	m_device->CreateShaderResourceView(m_texture.Get(), &srvDesc, handle);
+
+	handle.ptr += descriptorSize;
+	m_device->CreateShaderResourceView(m_indirectionTexture.Get(), nullptr, handle);
+
+	handle.ptr += descriptorSize;
+	m_device->CreateUnorderedAccessView(m_feedbackTexture.Get(), nullptr, nullptr, handle);
+}
+
+bool TiledTexture::Update(ID3D12CommandQueue* queue, ID3D12GraphicsCommandList* commandList, uint64_t frame)
+{
+	if (!m_packedMipsMapped) {
+		if (!MapPackedMips(queue, commandList)) {
+			return false;
+		}
+	} else if (m_hasFeedback && !ReadFeedback()) {
+		return false;
+	}
+
+	const bool indirectionChanged = m_streamer.Update(m_hasFeedback ? m_feedback.data() : nullptr, frame, m_updates);
+	if (!m_updates.empty()) {
+		MapTiles(queue);
+	}
+	if ((m_updates.empty() || UploadTiles(commandList)) && (!indirectionChanged || UploadIndirection(commandList))) {
+		return true;
+	}
+	// st[̃R}h͐ς܂Ɏ̂Ă̂ŁAނ͂^C͒uĂȂƂɖ߂B
+	// ԐڎQƃe[u͎ɐt[ő
+	m_streamer.CancelUpdates(m_updates);
+	return false;
+}
+
+bool TiledTexture::MapPackedMips(ID3D12CommandQueue* queue, ID3D12GraphicsCommandList* commandList)
+{
+	// pbNꂽ~bv̓^CPʂŃ}bvłȂ̂ŁA܂Ƃ߂ăXbǧɒu
+	if (m_packedMipInfo.NumPackedMips > 0) {
+		const D3D12_TILED_RESOURCE_COORDINATE coordinate = CD3DX12_TILED_RESOURCE_COORDINATE(
+			0,
+			0,
+			0,
+			m_packedMipInfo.NumStandardMips
+		);
+		D3D12_TILE_REGION_SIZE regionSize{};
+		regionSize.NumTiles = m_packedMipInfo.NumTilesForPackedMips;
+		const UINT heapRangeStart = m_slotCount;
+		const UINT rangeTileCount = m_packedMipInfo.NumTilesForPackedMips;
+		queue->UpdateTileMappings(
+			m_texture.Get(),
+			1,
+			&coordinate,
+			&regionSize,
+			m_tileHeap.Get(),
+			1,
+			nullptr,
+			&heapRangeStart,
+			&rangeTileCount,
+			D3D12_TILE_MAPPING_FLAG_NONE
+		);
+
+		for (UINT i = 0; i < m_packedMipInfo.NumPackedMips; ++i) {
+			const CD3DX12_TEXTURE_COPY_LOCATION destination(m_texture.Get(), m_packedMipInfo.NumStandardMips + i);
+			const CD3DX12_TEXTURE_COPY_LOCATION source(m_packedMipUploadBuffer.Get(), m_packedMipFootprints[i]);
+			commandList->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
+		}
+	}
+
+	// ԐڎQƃe[úupbNꂽ~bvvŎn߁AtB[hobN͏ԂŎn߂
+	if (!WriteIndirectionUpload()) {
+		return false;
+	}
+	const CD3DX12_TEXTURE_COPY_LOCATION indirectionDestination(m_indirectionTexture.Get(), 0);
+	const CD3DX12_TEXTURE_COPY_LOCATION indirectionSource(m_indirectionUploadBuffer.Get(), m_indirectionFootprint);
+	commandList->CopyTextureRegion(&indirectionDestination, 0, 0, 0, &indirectionSource, nullptr);
+	const CD3DX12_TEXTURE_COPY_LOCATION feedbackDestination(m_feedbackTexture.Get(), 0);
+	const CD3DX12_TEXTURE_COPY_LOCATION feedbackSource(m_feedbackClearBuffer.Get(), m_feedbackFootprint);
+	commandList->CopyTextureRegion(&feedbackDestination, 0, 0, 0, &feedbackSource, nullptr);
+
+	const D3D12_RESOURCE_BARRIER toShader[] = {
+		CD3DX12_RESOURCE_BARRIER::Transition(
+			m_texture.Get(),
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
+		),
+		CD3DX12_RESOURCE_BARRIER::Transition(
+			m_indirectionTexture.Get(),
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
+		),
+		CD3DX12_RESOURCE_BARRIER::Transition(
+			m_feedbackTexture.Get(),
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			D3D12_RESOURCE_STATE_UNORDERED_ACCESS
+		),
+	};
+	commandList->ResourceBarrier(_countof(toShader), toShader);
+
+	m_packedMipsMapped = true;
+	return true;
+}
+
+bool TiledTexture::ReadFeedback()
+{
+	const D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(m_feedbackReadbackBuffer->GetDesc().Width) };
+	uint8_t* readbackData = nullptr;
+	HRESULT result = m_feedbackReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&readbackData));
+	if (FAILED(result)) {
+		DebugOutputFormatString("Feedback readback buffer map Error : 0x%x\n", result);
+		return false;
+	}
+	const UINT cellsX = m_feedbackFootprint.Footprint.Width;
+	CopyRows(
+		reinterpret_cast<uint8_t*>(m_feedback.data()),
+		cellsX * sizeof(uint32_t),
+		readbackData + m_feedbackFootprint.Offset,
+		m_feedbackFootprint.Footprint.RowPitch,
+		cellsX * sizeof(uint32_t),
+		m_feedbackFootprint.Footprint.Height
+	);
+	const D3D12_RANGE writtenRange = { 0, 0 };
+	m_feedbackReadbackBuffer->Unmap(0, &writtenRange);
+	return true;
+}
+
+void TiledTexture::MapTiles(ID3D12CommandQueue* queue)
+{
+	std::vector<D3D12_TILED_RESOURCE_COORDINATE> coordinates;
+	coordinates.reserve(m_updates.size());
+	// 1^C̗̈ɂ(l NumTiles = 1)
+	const std::vector<D3D12_TILE_REGION_SIZE> regionSizes(m_updates.size(), CD3DX12_TILE_REGION_SIZE(1, FALSE, 0, 0, 0));
+
+	// ǂo^C̃}bvOB̃^CsNŹAԐڎQƃe[uőe~bvɉ
+	for (const TileUpdate& update : m_updates) {
+		if (update.evicted) {
+			coordinates.push_back(TileCoordinate(update.evictedKey));
+		}
+	}
+	if (!coordinates.empty()) {
+		const D3D12_TILE_RANGE_FLAGS nullRange = D3D12_TILE_RANGE_FLAG_NULL;
+		const UINT tileCount = static_cast<UINT>(coordinates.size());
+		queue->UpdateTileMappings(
+			m_texture.Get(),
+			tileCount,
+			coordinates.data(),
+			regionSizes.data(),
+			nullptr,
+			1,
+			&nullRange,
+			nullptr,
+			&tileCount,
+			D3D12_TILE_MAPPING_FLAG_NONE
+		);
+	}
+
+	// 蓖ĂXbgɃ}bv
+	coordinates.clear();
+	std::vector<UINT> heapRangeStarts;
+	heapRangeStarts.reserve(m_updates.size());
+	for (const TileUpdate& update : m_updates) {
+		coordinates.push_back(TileCoordinate(update.key));
+		heapRangeStarts.push_back(update.slot);
+	}
+	const std::vector<UINT> rangeTileCounts(m_updates.size(), 1);
+	queue->UpdateTileMappings(
+		m_texture.Get(),
+		static_cast<UINT>(coordinates.size()),
+		coordinates.data(),
+		regionSizes.data(),
+		m_tileHeap.Get(),
+		static_cast<UINT>(heapRangeStarts.size()),
+		nullptr,
+		heapRangeStarts.data(),
+		rangeTileCounts.data(),
+		D3D12_TILE_MAPPING_FLAG_NONE
+	);
+}
+
+bool TiledTexture::UploadTiles(ID3D12GraphicsCommandList* commandList)
+{
+	for (size_t i = 0; i < m_updates.size(); ++i) {
+		if (!DecodeTile(m_updates[i].key, m_tileUploadData + i * kTileSizeInBytes)) {
+			return false;
+		}
+	}
+
+	const CD3DX12_RESOURCE_BARRIER toCopy = CD3DX12_RESOURCE_BARRIER::Transition(
+		m_texture.Get(),
+		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+		D3D12_RESOURCE_STATE_COPY_DEST
+	);
+	commandList->ResourceBarrier(1, &toCopy);
+	const CD3DX12_TILE_REGION_SIZE regionSize(1, FALSE, 0, 0, 0);
+	for (size_t i = 0; i < m_updates.size(); ++i) {
+		const D3D12_TILED_RESOURCE_COORDINATE coordinate = TileCoordinate(m_updates[i].key);
+		commandList->CopyTiles(
+			m_texture.Get(),
+			&coordinate,
+			&regionSize,
+			m_tileUploadBuffer.Get(),
+			i * kTileSizeInBytes,
+			D3D12_TILE_COPY_FLAG_LINEAR_BUFFER_TO_SWIZZLED_TILED_RESOURCE
+		);
+	}
+	const CD3DX12_RESOURCE_BARRIER toShader = CD3DX12_RESOURCE_BARRIER::Transition(
+		m_texture.Get(),
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
+	);
+	commandList->ResourceBarrier(1, &toShader);
+	return true;
+}
+
+bool TiledTexture::DecodeTile(TileKey key, uint8_t* destination) const
+{
+	const ImageSource& source = m_mipSources[TileKeyMip(key)];
+	const UINT tileWidth = m_tileShape.WidthInTexels;
+	const UINT tileHeight = m_tileShape.HeightInTexels;
+	const UINT left = TileKeyX(key) * tileWidth;
+	const UINT top = TileKeyY(key) * tileHeight;
+	const UINT width = (std::min)(tileWidth, source.Width() - left);
+	const UINT height = (std::min)(tileHeight, source.Height() - top);
+	// 摜̉E[E[̃^ĆA͂ݏo 0 ɂ
+	if (width != tileWidth || height != tileHeight) {
+		std::memset(destination, 0, kTileSizeInBytes);
+	}
+	// CopyTiles ̐`obt@[́A^C̍sl߂ĕׂ
+	return source.CopyPixels(left, top, width, height, destination, tileWidth * kBytesPerTexel, kTileSizeInBytes);
+}
+
+bool TiledTexture::WriteIndirectionUpload()
+{
+	const std::vector<uint8_t>& table = m_streamer.IndirectionTable();
+	uint8_t* uploadData = nullptr;
+	HRESULT result = m_indirectionUploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&uploadData));
+	if (FAILED(result)) {
+		DebugOutputFormatString("Tile indirection upload buffer map Error : 0x%x\n", result);
+		return false;
+	}
+	CopyRows(
+		uploadData + m_indirectionFootprint.Offset,
+		m_indirectionFootprint.Footprint.RowPitch,
+		table.data(),
+		m_indirectionFootprint.Footprint.Width,
+		m_indirectionFootprint.Footprint.Width,
+		m_indirectionFootprint.Footprint.Height
+	);
+	m_indirectionUploadBuffer->Unmap(0, nullptr);
+	return true;
+}
+
+bool TiledTexture::UploadIndirection(ID3D12GraphicsCommandList* commandList)
+{
+	if (!WriteIndirectionUpload()) {
+		return false;
+	}
+
+	const CD3DX12_RESOURCE_BARRIER toCopy = CD3DX12_RESOURCE_BARRIER::Transition(
+		m_indirectionTexture.Get(),
+		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+		D3D12_RESOURCE_STATE_COPY_DEST
+	);
+	commandList->ResourceBarrier(1, &toCopy);
+	const CD3DX12_TEXTURE_COPY_LOCATION destination(m_indirectionTexture.Get(), 0);
+	const CD3DX12_TEXTURE_COPY_LOCATION source(m_indirectionUploadBuffer.Get(), m_indirectionFootprint);
+	commandList->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
+	const CD3DX12_RESOURCE_BARRIER toShader = CD3DX12_RESOURCE_BARRIER::Transition(
+		m_indirectionTexture.Get(),
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE
+	);
+	commandList->ResourceBarrier(1, &toShader);
+	return true;
+}
+
+void TiledTexture::ResolveFeedback(ID3D12GraphicsCommandList* commandList)
+{
+	const CD3DX12_RESOURCE_BARRIER toCopySource = CD3DX12_RESOURCE_BARRIER::Transition(
+		m_feedbackTexture.Get(),
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+		D3D12_RESOURCE_STATE_COPY_SOURCE
+	);
+	commandList->ResourceBarrier(1, &toCopySource);
+	const CD3DX12_TEXTURE_COPY_LOCATION readbackDestination(m_feedbackReadbackBuffer.Get(), m_feedbackFootprint);
+	const CD3DX12_TEXTURE_COPY_LOCATION feedbackSource(m_feedbackTexture.Get(), 0);
+	commandList->CopyTextureRegion(&readbackDestination, 0, 0, 0, &feedbackSource, nullptr);
+
+	// ̃t[̂߂ɏ
+	const CD3DX12_RESOURCE_BARRIER toCopyDest = CD3DX12_RESOURCE_BARRIER::Transition(
+		m_feedbackTexture.Get(),
+		D3D12_RESOURCE_STATE_COPY_SOURCE,
+		D3D12_RESOURCE_STATE_COPY_DEST
+	);
+	commandList->ResourceBarrier(1, &toCopyDest);
+	const CD3DX12_TEXTURE_COPY_LOCATION feedbackDestination(m_feedbackTexture.Get(), 0);
+	const CD3DX12_TEXTURE_COPY_LOCATION clearSource(m_feedbackClearBuffer.Get(), m_feedbackFootprint);
+	commandList->CopyTextureRegion(&feedbackDestination, 0, 0, 0, &clearSource, nullptr);
+	const CD3DX12_RESOURCE_BARRIER toUnorderedAccess = CD3DX12_RESOURCE_BARRIER::Transition(
+		m_feedbackTexture.Get(),
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS
+	);
+	commandList->ResourceBarrier(1, &toUnorderedAccess);
+
+	m_hasFeedback = true;
+}
+}
+}
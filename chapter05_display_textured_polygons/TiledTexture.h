@@ -0,0 +1,95 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl.h>
+#include <cstdint>
+#include <vector>
+
+#include "ImageDecoder.h"
+#include "TileStreaming.h"
+
+namespace yuxx {
+namespace DirectX12 {
+// 傫ȉ摜\񃊃\[XɒuA`Ō^C(64KB)fR[hăq[vɃ}bvB
+// VF[_[ TileStreaming.hlsli  SampleStreamed ňAtB[hobN
+class TiledTexture
+{
+public:
+	// \񃊃\[X(tex)EԐڎQƃe[u(tileIndirection)EtB[hobN(tileFeedback)̏
+	static constexpr UINT kDescriptorCount = 3;
+
+	// ^Ch\[X Tier 2 Kv(}bvĂȂ^Cǂނ 0 ɂȂ)
+	bool Initialize(
+		ID3D12Device* device,
+		const ImageDecoder& decoder,
+		const wchar_t* path,
+		const TileStreamer::Settings& settings
+	);
+	// kDescriptorCount ̘AfBXNv^Ƀr[
+	void CreateViews(D3D12_CPU_DESCRIPTOR_HANDLE firstDescriptor, UINT descriptorSize) const;
+
+	// t[̓ŁAÕt[ GPU ̊҂ĂĂԁB
+	// Õt[̃tB[hobN瑫Ȃ^C queue Ń}bvAރR}h commandList ɐς
+	bool Update(ID3D12CommandQueue* queue, ID3D12GraphicsCommandList* commandList, uint64_t frame);
+	// `̂ƂɐςށBtB[hobNǂݖ߂pobt@[ɎʂÃt[̂߂ɏ
+	void ResolveFeedback(ID3D12GraphicsCommandList* commandList);
+
+	ID3D12Resource* Resource() const { return m_texture.Get(); }
+	const TileStreamer& Streamer() const { return m_streamer; }
+
+private:
+	// eNZ1̃oCg(R8G8B8A8)ƁA^C1̃oCg
+	static constexpr UINT kBytesPerTexel = 4;
+	static constexpr UINT kTileSizeInBytes = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+
+	Microsoft::WRL::ComPtr<ID3D12Device> m_device;
+	// ~bvƂ̉摜Bׂ^CǂނƂfR[h
+	std::vector<ImageSource> m_mipSources;
+	D3D12_PACKED_MIP_INFO m_packedMipInfo = {};
+	D3D12_TILE_SHAPE m_tileShape = {};
+	uint32_t m_slotCount = 0;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_texture;
+	Microsoft::WRL::ComPtr<ID3D12Heap> m_tileHeap;
+	TileStreamer m_streamer;
+	std::vector<TileUpdate> m_updates;
+	// ŏ Update ŃpbNꂽ~bv}bvď
+	bool m_packedMipsMapped = false;
+
+	// 1t[̃^Cl߂Ēuԃobt@[BGPU ̊҂Ă珑̂1ő
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_tileUploadBuffer;
+	uint8_t* m_tileUploadData = nullptr;
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_packedMipUploadBuffer;
+	std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> m_packedMipFootprints;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_indirectionTexture;
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_indirectionUploadBuffer;
+	D3D12_PLACED_SUBRESOURCE_FOOTPRINT m_indirectionFootprint = {};
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_feedbackTexture;
+	// 0xffffffff Ŗ߂ĂAtB[hobNƂɃRs[
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_feedbackClearBuffer;
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_feedbackReadbackBuffer;
+	D3D12_PLACED_SUBRESOURCE_FOOTPRINT m_feedbackFootprint = {};
+	std::vector<uint32_t> m_feedback;
+	bool m_hasFeedback = false;
+
+	bool CreateMipSources(const ImageDecoder& decoder, const ImageSource& image, UINT width, UINT height, UINT mipCount);
+	bool CreateTableTextures();
+	bool CreateBuffer(
+		D3D12_HEAP_TYPE heapType,
+		UINT64 size,
+		D3D12_RESOURCE_STATES initialState,
+		Microsoft::WRL::ComPtr<ID3D12Resource>& buffer
+	) const;
+	bool MapPackedMips(ID3D12CommandQueue* queue, ID3D12GraphicsCommandList* commandList);
+	bool ReadFeedback();
+	void MapTiles(ID3D12CommandQueue* queue);
+	bool UploadTiles(ID3D12GraphicsCommandList* commandList);
+	// ԐڎQƃe[u𒆊ԃobt@[ɏ
+	bool WriteIndirectionUpload();
+	bool UploadIndirection(ID3D12GraphicsCommandList* commandList);
+	// key ̃^C1A摜͂ݏoƂ 0 ɂ destination ɃfR[h
+	bool DecodeTile(TileKey key, uint8_t* destination) const;
+};
+}
+}
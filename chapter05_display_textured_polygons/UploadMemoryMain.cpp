@@ -0,0 +1,229 @@
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "ImageCodec.h"
+#include "TextureCopy.h"
+
+using namespace yuxx::DirectX12;
+
+// eNX`Abv[hobt@[փfR[hƂ́As[ÑgpʂƃRs[oCg𑪂(Linux p)B
+// D3D12 ̃Abv[hobt@[̑ mmap ̈g
+namespace {
+	// D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+	constexpr size_t kFootprintPitchAlignment = 256;
+	constexpr size_t kBytesPerPixel = 4;
+#ifdef YUXX_SOURCE_DIR
+	const char* const kDefaultImagePaths[] = {
+		YUXX_SOURCE_DIR "/img/͌̋C.jpg",
+		YUXX_SOURCE_DIR "/img/VhE~[h.jpg",
+		YUXX_SOURCE_DIR "/img/be_logo.png",
+	};
+#else
+	const char* const kDefaultImagePaths[] = {
+		"img/͌̋C.jpg",
+		"img/VhE~[h.jpg",
+		"img/be_logo.png",
+	};
+#endif // YUXX_SOURCE_DIR
+
+	enum class UploadMode {
+		// ȑO LoadTexture ƓA摜ŜfR[hĂtbgvg̍ssb`ɋlߑւ
+		ScratchCopy,
+		// }bvAbv[hobt@[փtbgvg̍ssb`ŒڃfR[h
+		Direct,
+	};
+
+	struct UploadResult
+	{
+		bool succeeded;
+		// fR[hƃRs[ɏ񂾃oCg̍v
+		uint64_t copiedBytes;
+		// fR[hn߂Õs[N RSS ̑
+		uint64_t peakGrowthBytes;
+		double milliseconds;
+	};
+
+	// /proc/self/status ̒l(kB)oCgŕԂ
+	uint64_t ReadStatusBytes(const char* name)
+	{
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		const size_t nameLength = std::strlen(name);
+		while (std::getline(status, line)) {
+			if (line.compare(0, nameLength, name) == 0 && line.size() > nameLength && line[nameLength] == ':') {
+				return std::stoull(line.substr(nameLength + 1)) * 1024;
+			}
+		}
+		return 0;
+	}
+
+	// s[N RSS(VmHWM) RSS ɖ߂BłȂJ[lł false
+	bool ResetPeakRss()
+	{
+		std::ofstream clearRefs("/proc/self/clear_refs");
+		clearRefs << "5";
+		clearRefs.flush();
+		return static_cast<bool>(clearRefs);
+	}
+
+	UploadResult Upload(const std::vector<uint8_t>& file, UploadMode mode)
+	{
+		UploadResult result = {};
+		ImageInfo info;
+		if (!ReadImageInfo(file.data(), file.size(), info)) {
+			return result;
+		}
+		const size_t rowSize = static_cast<size_t>(info.width) * kBytesPerPixel;
+		const size_t footprintPitch = (rowSize + kFootprintPitchAlignment - 1) / kFootprintPitchAlignment * kFootprintPitchAlignment;
+		const size_t uploadSize = footprintPitch * info.height;
+
+		// Abv[hobt@[̑BG܂ł RSS ɓȂ
+		void* mapping = mmap(nullptr, uploadSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapping == MAP_FAILED) {
+			return result;
+		}
+		uint8_t* mapped = static_cast<uint8_t*>(mapping);
+
+		const uint64_t baseline = ReadStatusBytes("VmRSS");
+		const auto start = std::chrono::steady_clock::now();
+		if (mode == UploadMode::Direct) {
+			result.succeeded = DecodeImage(file.data(), file.size(), mapped, footprintPitch, uploadSize);
+			result.copiedBytes = static_cast<uint64_t>(rowSize) * info.height;
+		} else {
+			DecodedImage scratch;
+			result.succeeded = DecodeImage(file.data(), file.size(), 1, scratch);
+			if (result.succeeded) {
+				CopyRows(mapped, footprintPitch, scratch.pixels.data(), scratch.rowPitch, rowSize, info.height);
+			}
+			result.copiedBytes = static_cast<uint64_t>(rowSize) * info.height * 2;
+		}
+		const auto end = std::chrono::steady_clock::now();
+		result.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+		const uint64_t peak = ReadStatusBytes("VmHWM");
+		result.peakGrowthBytes = peak > baseline ? peak - baseline : 0;
+
+		munmap(mapping, uploadSize);
+		return result;
+	}
+
+	// 1񂲂Ƃ fork qvZXőBỎɊmۂĉ RSS ɎcĂƁAs[NႭo邽
+	bool MeasureInChild(const std::vector<uint8_t>& file, UploadMode mode, UploadResult& result)
+	{
+		int fds[2];
+		if (pipe(fds) != 0) {
+			return false;
+		}
+		const pid_t pid = fork();
+		if (pid < 0) {
+			close(fds[0]);
+			close(fds[1]);
+			return false;
+		}
+		if (pid == 0) {
+			close(fds[0]);
+			UploadResult childResult = {};
+			if (ResetPeakRss()) {
+				childResult = Upload(file, mode);
+			}
+			const ssize_t written = write(fds[1], &childResult, sizeof(childResult));
+			close(fds[1]);
+			_exit(written == sizeof(childResult) ? 0 : 1);
+		}
+		close(fds[1]);
+		const ssize_t readSize = read(fds[0], &result, sizeof(result));
+		close(fds[0]);
+		int status = 0;
+		waitpid(pid, &status, 0);
+		return readSize == sizeof(result) && WIFEXITED(status) && WEXITSTATUS(status) == 0 && result.succeeded;
+	}
+
+	void PrintUsage()
+	{
+		printf(
+			"usage: upload_memory_benchmark [--repeat <count>] [<image> ...]\n"
+			"  decodes each image into a fake mapped upload buffer, once through a scratch image\n"
+			"  and once directly, and prints the peak RSS growth and the bytes written\n"
+			"  --repeat  runs per mode; the smallest time and peak are printed (default: 5)\n"
+		);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int repeat = 5;
+	std::vector<std::string> paths;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+			repeat = (std::max)(std::atoi(argv[++i]), 1);
+		} else if (argv[i][0] == '-') {
+			PrintUsage();
+			return -1;
+		} else {
+			paths.push_back(argv[i]);
+		}
+	}
+	if (paths.empty()) {
+		paths.assign(std::begin(kDefaultImagePaths), std::end(kDefaultImagePaths));
+	}
+
+	printf("%-40s %-13s %14s %16s %10s\n", "image", "mode", "copied bytes", "peak RSS growth", "ms");
+	int exitCode = 0;
+	for (const std::string& path : paths) {
+		std::vector<uint8_t> file;
+		if (!ReadFileBytes(path, file)) {
+			printf("Failed to read %s\n", path.c_str());
+			exitCode = -1;
+			continue;
+		}
+		const std::string name = path.substr(path.find_last_of('/') + 1);
+		const struct
+		{
+			UploadMode mode;
+			const char* name;
+		} modes[] = {
+			{ UploadMode::ScratchCopy, "scratch_copy" },
+			{ UploadMode::Direct, "direct" },
+		};
+		for (const auto& mode : modes) {
+			UploadResult best = {};
+			bool measured = false;
+			for (int i = 0; i < repeat; ++i) {
+				UploadResult result = {};
+				if (!MeasureInChild(file, mode.mode, result)) {
+					continue;
+				}
+				if (!measured) {
+					best = result;
+				}
+				best.milliseconds = (std::min)(best.milliseconds, result.milliseconds);
+				best.peakGrowthBytes = (std::min)(best.peakGrowthBytes, result.peakGrowthBytes);
+				measured = true;
+			}
+			if (!measured) {
+				printf("%-40s %-13s failed (cannot decode, or /proc/self/clear_refs is not writable)\n", name.c_str(), mode.name);
+				exitCode = -1;
+				continue;
+			}
+			printf(
+				"%-40s %-13s %14llu %13.1f MB %10.2f\n",
+				name.c_str(),
+				mode.name,
+				static_cast<unsigned long long>(best.copiedBytes),
+				best.peakGrowthBytes / (1024.0 * 1024.0),
+				best.milliseconds
+			);
+		}
+	}
+	return exitCode;
+}
@@ -0,0 +1,69 @@
+#include "UploadRing.h"
+
+namespace yuxx {
+namespace DirectX12 {
+UploadRing::UploadRing(uint64_t capacity) :
+	m_capacity(capacity)
+{
+}
+
+uint64_t UploadRing::Allocate(uint64_t size, uint64_t alignment)
+{
+	if (size == 0 || size > m_capacity) {
+		return kInvalidOffset;
+	}
+	// Ȃ擪g(܂Ԃ炷)
+	if (m_usedBytes == 0) {
+		m_head = 0;
+		m_tail = 0;
+	} else if (m_head == m_tail) {
+		return kInvalidOffset;
+	}
+
+	const uint64_t aligned = (m_head + alignment - 1) & ~(alignment - 1);
+	uint64_t offset = kInvalidOffset;
+	uint64_t used = 0;
+	if (m_head >= m_tail) {
+		// 󂫂 [m_head, m_capacity)  [0, m_tail)
+		if (aligned <= m_capacity && m_capacity - aligned >= size) {
+			offset = aligned;
+			used = aligned - m_head + size;
+		} else if (size <= m_tail) {
+			offset = 0;
+			used = m_capacity - m_head + size;
+		}
+	} else if (aligned <= m_tail && m_tail - aligned >= size) {
+		// 󂫂 [m_head, m_tail)
+		offset = aligned;
+		used = aligned - m_head + size;
+	}
+	if (offset == kInvalidOffset) {
+		return kInvalidOffset;
+	}
+
+	m_head = offset + size;
+	m_usedBytes += used;
+	m_frameBytes += used;
+	return offset;
+}
+
+void UploadRing::EndFrame(uint64_t fenceValue)
+{
+	m_pendingFrames.push_back({ fenceValue, m_head, m_frameBytes });
+	m_frameBytes = 0;
+}
+
+void UploadRing::Retire(uint64_t completedFenceValue)
+{
+	while (!m_pendingFrames.empty() && m_pendingFrames.front().fenceValue <= completedFenceValue) {
+		const PendingFrame& frame = m_pendingFrames.front();
+		// ؂oȂt[ end ́AɂȂĐ擪ɖ߂ÖʒuȂ
+		if (frame.bytes != 0) {
+			m_tail = frame.end;
+			m_usedBytes -= frame.bytes;
+		}
+		m_pendingFrames.pop_front();
+	}
+}
+}
+}
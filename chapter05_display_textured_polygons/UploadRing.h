@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+
+namespace yuxx {
+namespace DirectX12 {
+// Abv[hq[ṽobt@[1A擪珇ɐ؂oĎg񂷃OB
+// ItZbgz邾 D3D12 ɂ͈ˑȂ(obt@[̍쐬 Map ͌Ăяo)B
+// t[̏I EndFrame ŃtFXltAGPU ̃tFXl܂Ői񂾂 Retire ł̕󂯂
+class UploadRing
+{
+public:
+	static constexpr uint64_t kInvalidOffset = ~0ull;
+
+	explicit UploadRing(uint64_t capacity = 0);
+
+	// alignment  2 ׂ̂B󂫂Ȃ kInvalidOffset(Ât[ Retire ΋)B
+	// I[Ɏ܂Ȃΐ擪ɖ߂AI[̎c͂̃t[̕Ƃċ󂭂܂ŎgȂ
+	uint64_t Allocate(uint64_t size, uint64_t alignment);
+	// ܂łɐ؂o fenceValue ̃t[̂̂ɂ
+	void EndFrame(uint64_t fenceValue);
+	// completedFenceValue ȉ̃tFXl̃t[gĂ󂯂
+	void Retire(uint64_t completedFenceValue);
+
+	uint64_t Capacity() const { return m_capacity; }
+	// gĂoCg(ACgƐ܂Ԃŋ󂯂܂)
+	uint64_t UsedBytes() const { return m_usedBytes; }
+
+private:
+	struct PendingFrame
+	{
+		uint64_t fenceValue;
+		// ̃t[̍Ō̐؂ȍI
+		uint64_t end;
+		uint64_t bytes;
+	};
+
+	uint64_t m_capacity;
+	// ɐ؂oʒuƁAgĂ钆ōłÂʒu
+	uint64_t m_head = 0;
+	uint64_t m_tail = 0;
+	uint64_t m_usedBytes = 0;
+	// ܂ EndFrame ĂȂ
+	uint64_t m_frameBytes = 0;
+	std::deque<PendingFrame> m_pendingFrames;
+};
+}
+}
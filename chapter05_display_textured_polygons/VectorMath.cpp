@@ -0,0 +1,90 @@
+#include "VectorMath.h"
+
+#include <cmath>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	Float3 Subtract(const Float3& a, const Float3& b)
+	{
+		return { a.x - b.x, a.y - b.y, a.z - b.z };
+	}
+
+	float Dot(const Float3& a, const Float3& b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	Float3 Cross(const Float3& a, const Float3& b)
+	{
+		return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+	}
+
+	Float3 Normalize(const Float3& v)
+	{
+		const float length = std::sqrt(Dot(v, v));
+		return length > 0.0f ? Float3{ v.x / length, v.y / length, v.z / length } : v;
+	}
+}
+
+Float4x4 IdentityMatrix()
+{
+	return { {
+		{ 1.0f, 0.0f, 0.0f, 0.0f },
+		{ 0.0f, 1.0f, 0.0f, 0.0f },
+		{ 0.0f, 0.0f, 1.0f, 0.0f },
+		{ 0.0f, 0.0f, 0.0f, 1.0f },
+	} };
+}
+
+Float4x4 MultiplyMatrix(const Float4x4& a, const Float4x4& b)
+{
+	Float4x4 result{};
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			for (int k = 0; k < 4; ++k) {
+				result.m[row][column] += a.m[row][k] * b.m[k][column];
+			}
+		}
+	}
+	return result;
+}
+
+Float4 TransformPoint(const Float3& point, const Float4x4& matrix)
+{
+	const float* m[4] = { matrix.m[0], matrix.m[1], matrix.m[2], matrix.m[3] };
+	return {
+		point.x * m[0][0] + point.y * m[1][0] + point.z * m[2][0] + m[3][0],
+		point.x * m[0][1] + point.y * m[1][1] + point.z * m[2][1] + m[3][1],
+		point.x * m[0][2] + point.y * m[1][2] + point.z * m[2][2] + m[3][2],
+		point.x * m[0][3] + point.y * m[1][3] + point.z * m[2][3] + m[3][3],
+	};
+}
+
+Float4x4 LookAtMatrixLH(const Float3& eye, const Float3& focus, const Float3& up)
+{
+	const Float3 zAxis = Normalize(Subtract(focus, eye));
+	const Float3 xAxis = Normalize(Cross(up, zAxis));
+	const Float3 yAxis = Cross(zAxis, xAxis);
+	return { {
+		{ xAxis.x, yAxis.x, zAxis.x, 0.0f },
+		{ xAxis.y, yAxis.y, zAxis.y, 0.0f },
+		{ xAxis.z, yAxis.z, zAxis.z, 0.0f },
+		{ -Dot(xAxis, eye), -Dot(yAxis, eye), -Dot(zAxis, eye), 1.0f },
+	} };
+}
+
+Float4x4 PerspectiveFovMatrixLH(float fovAngleY, float aspectRatio, float nearZ, float farZ)
+{
+	const float height = 1.0f / std::tan(fovAngleY * 0.5f);
+	const float width = height / aspectRatio;
+	const float range = farZ / (farZ - nearZ);
+	return { {
+		{ width, 0.0f, 0.0f, 0.0f },
+		{ 0.0f, height, 0.0f, 0.0f },
+		{ 0.0f, 0.0f, range, 1.0f },
+		{ 0.0f, 0.0f, -range * nearZ, 0.0f },
+	} };
+}
+}
+}
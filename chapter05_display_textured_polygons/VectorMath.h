@@ -0,0 +1,36 @@
+#pragma once
+
+namespace yuxx {
+namespace DirectX12 {
+// XM_PIDIV4 Ɠl
+constexpr float kPiDiv4 = 0.785398163f;
+
+// DirectXMath  XMFLOAT3 / XMFLOAT4 / XMFLOAT4X4 Ɠт̌^B
+// Windows ȊOłrhRA(JOt[pPbgȂ)͂g
+struct Float3
+{
+	float x, y, z;
+};
+
+struct Float4
+{
+	float x, y, z, w;
+};
+
+// sxNg`(v * M)BDirectXMath ƓAsړ4sڂɓ
+struct Float4x4
+{
+	float m[4][4];
+};
+
+Float4x4 IdentityMatrix();
+// a ɁAb Ɋ|ϊ(v * a * b)
+Float4x4 MultiplyMatrix(const Float4x4& a, const Float4x4& b);
+// (x, y, z, 1) * matrix
+Float4 TransformPoint(const Float3& point, const Float4x4& matrix);
+
+// XMMatrixLookAtLH / XMMatrixPerspectiveFovLH Ɠs
+Float4x4 LookAtMatrixLH(const Float3& eye, const Float3& focus, const Float3& up);
+Float4x4 PerspectiveFovMatrixLH(float fovAngleY, float aspectRatio, float nearZ, float farZ);
+}
+}
@@ -0,0 +1,72 @@
+#include "FileWatcher.h"
+
+#include <Windows.h>
+#include <vector>
+
+#include "Helpers.h"
+
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+namespace {
+	class Win32FileWatcher : public FileWatcher
+	{
+	public:
+		~Win32FileWatcher() override
+		{
+			for (const HANDLE handle : m_changeHandles) {
+				FindCloseChangeNotification(handle);
+			}
+		}
+
+		bool AddWatchDirectory(const PathString& directory) override
+		{
+			const HANDLE handle = FindFirstChangeNotificationW(
+				directory.c_str(),
+				// TufBNg͌Ȃ
+				false,
+				FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME
+			);
+			if (handle == INVALID_HANDLE_VALUE) {
+				DebugOutputFormatString("FindFirstChangeNotification Error : 0x%x\n", GetLastError());
+				return false;
+			}
+			m_changeHandles.push_back(handle);
+			return true;
+		}
+
+		bool ConsumeNotifications() override
+		{
+			bool notified = false;
+			for (const HANDLE handle : m_changeHandles) {
+				if (WaitForSingleObject(handle, 0) == WAIT_OBJECT_0) {
+					notified = true;
+					FindNextChangeNotification(handle);
+				}
+			}
+			return notified;
+		}
+
+	private:
+		std::vector<HANDLE> m_changeHandles;
+	};
+}
+
+std::unique_ptr<FileWatcher> CreateFileWatcher()
+{
+	return std::unique_ptr<FileWatcher>(new Win32FileWatcher());
+}
+
+bool GetFileLastWriteTime(const PathString& path, FileTimestamp& timestamp)
+{
+	WIN32_FILE_ATTRIBUTE_DATA attributes{};
+	if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &attributes)) {
+		return false;
+	}
+	timestamp = (static_cast<FileTimestamp>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+		attributes.ftLastWriteTime.dwLowDateTime;
+	return true;
+}
+}
+}
@@ -0,0 +1,136 @@
+#include "Win32Window.h"
+
+#include <tchar.h>
+
+#include "Helpers.h"
+
+using namespace yuxx::Debug;
+
+namespace yuxx {
+namespace DirectX12 {
+Win32Window::~Win32Window()
+{
+	if (m_hwnd != nullptr) {
+		DestroyWindow(m_hwnd);
+	}
+	if (m_windowClass.lpszClassName != nullptr) {
+		UnregisterClass(m_windowClass.lpszClassName, m_windowClass.hInstance);
+	}
+}
+
+bool Win32Window::Create(HINSTANCE hInstance, LPCTSTR title, int width, int height, EventHandler* handler)
+{
+	m_handler = handler;
+
+	m_windowClass.cbSize = sizeof(WNDCLASSEX);
+	m_windowClass.lpfnWndProc = WindowProcedure;
+	m_windowClass.lpszClassName = _T("DX12Sample");
+	m_windowClass.hInstance = hInstance;
+
+	RegisterClassEx(&m_windowClass);
+
+	RECT windowRect = { 0, 0, width, height };
+
+	AdjustWindowRect(&windowRect, WS_OVERLAPPEDWINDOW, false);
+
+	m_hwnd = CreateWindow(
+		m_windowClass.lpszClassName,
+		title,
+		WS_OVERLAPPEDWINDOW,
+		CW_USEDEFAULT,
+		CW_USEDEFAULT,
+		windowRect.right - windowRect.left,
+		windowRect.bottom - windowRect.top,
+		nullptr,
+		nullptr,
+		hInstance,
+		this
+	);
+	if (!m_hwnd) {
+		DebugOutputFormatString("CreateWindow Error : 0x%x\n", GetLastError());
+		return false;
+	}
+	m_clientWidth = width;
+	m_clientHeight = height;
+
+	return true;
+}
+
+void Win32Window::Show()
+{
+	ShowWindow(m_hwnd, SW_SHOW);
+}
+
+LRESULT CALLBACK Win32Window::WindowProcedure(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam)
+{
+	Win32Window* self = nullptr;
+	if (msg == WM_NCCREATE) {
+		CREATESTRUCT* pcs = reinterpret_cast<CREATESTRUCT*>(lparam);
+		self = static_cast<Win32Window*>(pcs->lpCreateParams);
+		SetWindowLongPtr(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(self));
+	} else {
+		self = reinterpret_cast<Win32Window*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+	}
+	switch (msg)
+	{
+	case WM_DESTROY:
+		if (self != nullptr) {
+			self->m_hwnd = nullptr;
+		}
+		PostQuitMessage(0);
+		return 0;
+
+	case WM_KEYDOWN:
+		if (self != nullptr && self->m_handler != nullptr) {
+			self->m_handler->OnKeyDown(static_cast<unsigned int>(wparam));
+		}
+		return DefWindowProc(hwnd, msg, wparam, lparam);
+
+	case WM_SIZE:
+		if (self != nullptr && wparam != SIZE_MINIMIZED) {
+			self->m_clientWidth = LOWORD(lparam);
+			self->m_clientHeight = HIWORD(lparam);
+			if (self->m_handler != nullptr && self->m_clientWidth != 0 && self->m_clientHeight != 0) {
+				self->m_handler->OnResize(self->m_clientWidth, self->m_clientHeight, self->m_sizing);
+			}
+		}
+		return 0;
+
+	case WM_ENTERSIZEMOVE:
+		if (self != nullptr) {
+			self->m_sizing = true;
+		}
+		return 0;
+
+	case WM_EXITSIZEMOVE:
+		// hbOɎ󂯎Ō̑傫AŊm肳
+		if (self != nullptr) {
+			self->m_sizing = false;
+			if (self->m_handler != nullptr && self->m_clientWidth != 0 && self->m_clientHeight != 0) {
+				self->m_handler->OnResize(self->m_clientWidth, self->m_clientHeight, false);
+			}
+		}
+		return 0;
+
+	default:
+		return DefWindowProc(hwnd, msg, wparam, lparam);
+	}
+}
+
+bool PumpWindowMessage()
+{
+	MSG msg = {};
+	if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+		TranslateMessage(&msg);
+		DispatchMessage(&msg);
+	}
+	return msg.message != WM_QUIT;
+}
+
+void WaitWindowMessage(unsigned int milliseconds)
+{
+	// MWMO_INPUTAVAILABLE ȂƁAłɃL[ɂ郁bZ[Wł͋NȂ
+	MsgWaitForMultipleObjectsEx(0, nullptr, milliseconds, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+}
+}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <Windows.h>
+
+namespace yuxx {
+namespace DirectX12 {
+// Win32 ̃EBhE1BEBhENX̓o^ WindowProcedure ɕ߁A
+// `摤ɂ̓L[͂Ȃǂ̃Cxgn
+class Win32Window
+{
+public:
+	class EventHandler
+	{
+	public:
+		virtual ~EventHandler() = default;
+		// virtualKey  VK_F9 Ȃǂ̉zL[R[h
+		virtual void OnKeyDown(unsigned int virtualKey) = 0;
+		// NCAg̈̑傫ςBsizing ͘ghbOĂrȂ trueB
+		// ŏƂ͌Ă΂Ȃ
+		virtual void OnResize(unsigned int width, unsigned int height, bool sizing) = 0;
+	};
+
+	Win32Window() = default;
+	Win32Window(const Win32Window&) = delete;
+	Win32Window& operator=(const Win32Window&) = delete;
+	~Win32Window();
+
+	// NCAg̈悪 width x height ɂȂEBhEBhandler  nullptr ł悢
+	bool Create(HINSTANCE hInstance, LPCTSTR title, int width, int height, EventHandler* handler);
+	void Show();
+
+	HWND Handle() const { return m_hwnd; }
+	unsigned int ClientWidth() const { return m_clientWidth; }
+	unsigned int ClientHeight() const { return m_clientHeight; }
+
+private:
+	WNDCLASSEX m_windowClass = {};
+	HWND m_hwnd = nullptr;
+	EventHandler* m_handler = nullptr;
+	unsigned int m_clientWidth = 0;
+	unsigned int m_clientHeight = 0;
+	// WM_ENTERSIZEMOVE  WM_EXITSIZEMOVE ܂ true
+	bool m_sizing = false;
+
+	static LRESULT CALLBACK WindowProcedure(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
+};
+
+// ܂Ă郁bZ[W1BWM_QUIT 󂯎 false
+bool PumpWindowMessage();
+// bZ[W邩 milliseconds ܂ő҂
+void WaitWindowMessage(unsigned int milliseconds);
+}
+}
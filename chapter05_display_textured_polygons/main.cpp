@@ -3,7 +3,10 @@
 #include <d3d12.h>
 #include <DirectXMath.h>
 
+#include <cstring>
+
 #include "DirectXManager.h"
+#include "Win32Window.h"
 
 #ifdef _DEBUG
 #include <iostream>
@@ -15,6 +18,17 @@ using namespace yuxx::DirectX12;
 constexpr unsigned int g_window_width = 1280;
 constexpr unsigned int g_window_height = 720;
 
+// R}hC option 邩(lȂ)
+bool HasOption(const char* option)
+{
+	for (int i = 1; i < __argc; ++i) {
+		if (strcmp(__argv[i], option) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
 #ifdef _DEBUG
 int main() {
 	HINSTANCE hInstance = GetModuleHandle(nullptr);
@@ -27,29 +41,58 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		return -1;
 	}
 
+	int exitCode = 0;
 	{
 		DirectXManager dxManager;
+		// --stream-texture ȂeNX`\񃊃\[XɒuA^Cǂݍ
+		if (HasOption("--stream-texture")) {
+			dxManager.EnableTextureStreaming();
+		}
+		// --gpu-texture-conversion ȂeNX`̕ϊ(sRGB `)ƃ~bv̍쐬 GPU ōs
+		if (HasOption("--gpu-texture-conversion")) {
+			dxManager.EnableGpuTextureConversion(kConvertLinearize);
+		}
+		// --depth-prepass ȂsȂ̂̐[xɕ`Ă{`悷
+		if (HasOption("--depth-prepass")) {
+			dxManager.EnableDepthPrePass();
+		}
+		// --occlusion-culling Ȃ CPU ŃJOƂɁAO̕sȂ̂ɉBꂽ̂`Ȃ
+		if (HasOption("--occlusion-culling")) {
+			dxManager.EnableOcclusionCulling();
+		}
+		// --gpu-driven ȂsȂ̂ GPU ŃJOAExecuteIndirect ŕ`
+		if (HasOption("--gpu-driven")) {
+			dxManager.EnableGpuDrivenRendering();
+		}
+		// --demo-scene Ȃlp`1̑ɁAsȎlp`ƔȎlp`d˂V[`
+		if (HasOption("--demo-scene")) {
+			dxManager.EnableDemoScene();
+		}
+		// --record-frame-times Ȃ瓮I𑜓x؂At[ GPU Ԃ frame_times.txt ɏo
+		if (HasOption("--record-frame-times")) {
+			dxManager.EnableFrameTimeRecording("frame_times.txt");
+		}
 		if (!dxManager.Initialize(hInstance, g_window_width, g_window_height)) {
 			return -2;
 		}
 
-		MSG msg = {};
-
-		while (true) {
-			if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
-				TranslateMessage(&msg);
-				DispatchMessage(&msg);
-			}
+		// --render-thread Ȃ烁bZ[W̏ƕ`ʂ̃Xbhōs
+		if (HasOption("--render-thread")) {
+			dxManager.StartRenderThread();
+		}
 
-			if (msg.message == WM_QUIT) {
+		// `Ɏs(foCXꂽƂȂ)
+		while (PumpWindowMessage()) {
+			if (!dxManager.Update()) {
+				exitCode = -3;
 				break;
 			}
-
-			dxManager.Render();
 		}
+		// WM_QUIT 󂯎A`Ăr̃t[IĂ~߂
+		dxManager.StopRenderThread();
 	}
 
 	CoUninitialize();
 	
-	return 0;
+	return exitCode;
 }
@@ -0,0 +1,197 @@
+#include "AdapterSelection.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// D3D_FEATURE_LEVEL  D3D_SHADER_MODEL ̒l
+	constexpr uint32_t kFeatureLevel11_0 = 0xb000;
+	constexpr uint32_t kFeatureLevel12_0 = 0xc000;
+	constexpr uint32_t kFeatureLevel12_1 = 0xc100;
+	constexpr uint32_t kShaderModel5_1 = 0x51;
+	constexpr uint32_t kShaderModel6_0 = 0x60;
+	constexpr uint32_t kShaderModel6_6 = 0x66;
+	constexpr uint64_t kMegabyte = 1ull << 20;
+	constexpr uint64_t kGigabyte = 1ull << 30;
+
+	AdapterCapabilities MakeAdapter(
+		const wchar_t* description,
+		uint32_t featureLevel,
+		uint32_t shaderModel,
+		uint32_t resourceBindingTier,
+		uint64_t dedicatedVideoMemory,
+		bool isSoftware = false
+	) {
+		AdapterCapabilities capabilities;
+		capabilities.description = description;
+		capabilities.featureLevel = featureLevel;
+		capabilities.shaderModel = shaderModel;
+		capabilities.resourceBindingTier = resourceBindingTier;
+		capabilities.dedicatedVideoMemory = dedicatedVideoMemory;
+		capabilities.isSoftware = isSoftware;
+		return capabilities;
+	}
+
+	// m[g PC ɂ悭A GPU ɗ񋓂ĊOt GPU  WARP \
+	std::vector<AdapterCapabilities> MakeLaptopAdapters()
+	{
+		return {
+			MakeAdapter(L"Intel(R) UHD Graphics 620", kFeatureLevel12_1, kShaderModel6_0, 3, 128 * kMegabyte),
+			MakeAdapter(L"NVIDIA GeForce RTX 3060 Laptop GPU", kFeatureLevel12_1, kShaderModel6_6, 3, 6 * kGigabyte),
+			MakeAdapter(L"Microsoft Basic Render Driver", kFeatureLevel12_1, kShaderModel6_6, 3, 0, true),
+		};
+	}
+
+	std::string TemporaryCachePath(const char* name)
+	{
+		return std::string("adapter_selection_test_") + name + ".bin";
+	}
+}
+
+TEST_CASE(AdapterSelection, PrefersTheDiscreteGpuOverTheIntegratedOne)
+{
+	CHECK_EQ(1, SelectBestAdapter(MakeLaptopAdapters(), AdapterPolicy()));
+}
+
+TEST_CASE(AdapterSelection, SkipsSoftwareAdaptersUnlessAllowed)
+{
+	const std::vector<AdapterCapabilities> adapters = {
+		MakeAdapter(L"Microsoft Basic Render Driver", kFeatureLevel12_1, kShaderModel6_6, 3, 0, true),
+	};
+	CHECK_EQ(-1, SelectBestAdapter(adapters, AdapterPolicy()));
+
+	AdapterPolicy policy;
+	policy.allowSoftware = true;
+	CHECK_EQ(0, SelectBestAdapter(adapters, policy));
+}
+
+TEST_CASE(AdapterSelection, RequiredDescriptionOverridesTheScore)
+{
+	// DX12_ADAPTER  WARP w肵Ƃ
+	AdapterPolicy policy;
+	policy.requiredDescription = L"Basic Render";
+	policy.allowSoftware = true;
+	CHECK_EQ(2, SelectBestAdapter(MakeLaptopAdapters(), policy));
+
+	policy.requiredDescription = L"Intel";
+	CHECK_EQ(0, SelectBestAdapter(MakeLaptopAdapters(), policy));
+
+	// 啶͋ʂ
+	policy.requiredDescription = L"intel";
+	CHECK_EQ(-1, SelectBestAdapter(MakeLaptopAdapters(), policy));
+}
+
+TEST_CASE(AdapterSelection, ReturnsMinusOneForNoCandidates)
+{
+	CHECK_EQ(-1, SelectBestAdapter(std::vector<AdapterCapabilities>(), AdapterPolicy()));
+}
+
+TEST_CASE(AdapterSelection, FeatureLevelOutranksEverythingElse)
+{
+	const std::vector<AdapterCapabilities> adapters = {
+		// Â VRAM ̑ GPU
+		MakeAdapter(L"Old", kFeatureLevel11_0, kShaderModel6_6, 3, 16 * kGigabyte),
+		MakeAdapter(L"New", kFeatureLevel12_0, kShaderModel5_1, 1, 512 * kMegabyte),
+	};
+	CHECK_EQ(1, SelectBestAdapter(adapters, AdapterPolicy()));
+}
+
+TEST_CASE(AdapterSelection, ShaderModelThenBindingTierThenVideoMemory)
+{
+	const AdapterCapabilities base = MakeAdapter(L"Base", kFeatureLevel12_0, kShaderModel6_0, 2, 4 * kGigabyte);
+	AdapterCapabilities higherShaderModel = base;
+	higherShaderModel.shaderModel = kShaderModel6_6;
+	higherShaderModel.resourceBindingTier = 1;
+	higherShaderModel.dedicatedVideoMemory = kGigabyte;
+	AdapterCapabilities higherTier = base;
+	higherTier.resourceBindingTier = 3;
+	higherTier.dedicatedVideoMemory = kGigabyte;
+	AdapterCapabilities moreMemory = base;
+	moreMemory.dedicatedVideoMemory = 8 * kGigabyte;
+
+	CHECK(ScoreAdapter(higherShaderModel) > ScoreAdapter(base));
+	CHECK(ScoreAdapter(higherShaderModel) > ScoreAdapter(higherTier));
+	CHECK(ScoreAdapter(higherTier) > ScoreAdapter(moreMemory));
+	CHECK(ScoreAdapter(moreMemory) > ScoreAdapter(base));
+}
+
+TEST_CASE(AdapterSelection, HugeVideoMemoryDoesNotSpillIntoHigherFields)
+{
+	// 20bit(1TB)𒴂 VRAM ͖OaAoCfBOeBA̍𕢂Ȃ
+	const AdapterCapabilities hugeMemory = MakeAdapter(L"Huge", kFeatureLevel12_0, kShaderModel6_0, 1, 1ull << 50);
+	const AdapterCapabilities higherTier = MakeAdapter(L"Tier", kFeatureLevel12_0, kShaderModel6_0, 2, kMegabyte);
+	CHECK(ScoreAdapter(higherTier) > ScoreAdapter(hugeMemory));
+
+	AdapterCapabilities justBelowLimit = hugeMemory;
+	justBelowLimit.dedicatedVideoMemory = ((1ull << 20) - 2) * kMegabyte;
+	CHECK(ScoreAdapter(hugeMemory) > ScoreAdapter(justBelowLimit));
+}
+
+TEST_CASE(AdapterSelection, TiesKeepTheFirstEnumeratedAdapter)
+{
+	//  GPU 2}Ă΁Aɗ񋓂ꂽ(fBXvĈȂĂ)
+	const std::vector<AdapterCapabilities> adapters = {
+		MakeAdapter(L"GPU A", kFeatureLevel12_1, kShaderModel6_6, 3, 8 * kGigabyte),
+		MakeAdapter(L"GPU B", kFeatureLevel12_1, kShaderModel6_6, 3, 8 * kGigabyte),
+	};
+	CHECK_EQ(0, SelectBestAdapter(adapters, AdapterPolicy()));
+}
+
+TEST_CASE(AdapterSelection, CacheRoundTrips)
+{
+	AdapterCapabilities saved = MakeLaptopAdapters()[1];
+	saved.luid = 0x0000000100001234ull;
+	saved.vendorId = 0x10de;
+	saved.deviceId = 0x2520;
+	const std::string path = TemporaryCachePath("round_trip");
+	REQUIRE(SaveAdapterCache(path.c_str(), saved));
+
+	AdapterCapabilities loaded;
+	REQUIRE(LoadAdapterCache(path.c_str(), loaded));
+	CHECK_EQ(saved.luid, loaded.luid);
+	CHECK_EQ(saved.vendorId, loaded.vendorId);
+	CHECK_EQ(saved.deviceId, loaded.deviceId);
+	CHECK_EQ(saved.dedicatedVideoMemory, loaded.dedicatedVideoMemory);
+	CHECK_EQ(saved.featureLevel, loaded.featureLevel);
+	CHECK_EQ(saved.resourceBindingTier, loaded.resourceBindingTier);
+	CHECK_EQ(saved.shaderModel, loaded.shaderModel);
+	CHECK_EQ(saved.isSoftware, loaded.isSoftware);
+	CHECK(saved.description == loaded.description);
+	CHECK_EQ(ScoreAdapter(saved), ScoreAdapter(loaded));
+	std::remove(path.c_str());
+}
+
+TEST_CASE(AdapterSelection, RejectsBrokenCaches)
+{
+	const std::string path = TemporaryCachePath("broken");
+	AdapterCapabilities loaded;
+	loaded.vendorId = 42;
+
+	std::remove(path.c_str());
+	CHECK(!LoadAdapterCache(path.c_str(), loaded));
+
+	// ʂ̌`̃t@C
+	std::ofstream(path, std::ios::binary) << "not an adapter cache";
+	CHECK(!LoadAdapterCache(path.c_str(), loaded));
+
+	// rŐ؂ꂽt@C
+	REQUIRE(SaveAdapterCache(path.c_str(), MakeLaptopAdapters()[0]));
+	std::string contents;
+	{
+		std::ifstream stream(path, std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	}
+	std::ofstream(path, std::ios::binary | std::ios::trunc).write(contents.data(), contents.size() - 3);
+	CHECK(!LoadAdapterCache(path.c_str(), loaded));
+
+	// sĂȂ
+	CHECK_EQ(42u, loaded.vendorId);
+	std::remove(path.c_str());
+}
@@ -0,0 +1,301 @@
+#include "Culling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// (0, 0, -60)  +z JBreversedZ ȂOƉ̐[xւˉeɂ
+	Float4x4 MakeViewProjection(bool reversedZ)
+	{
+		const float nearZ = reversedZ ? 100.0f : 1.0f;
+		const float farZ = reversedZ ? 1.0f : 100.0f;
+		return MultiplyMatrix(
+			LookAtMatrixLH({ 0.0f, 0.0f, -60.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }),
+			PerspectiveFovMatrixLH(kPiDiv4, 16.0f / 9.0f, nearZ, farZ)
+		);
+	}
+
+	AabbSoA MakeRandomAabbs(size_t count, unsigned int seed, float maxExtent = 2.0f)
+	{
+		AabbSoA aabbs;
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+		std::uniform_real_distribution<float> extent(0.1f, maxExtent);
+		for (size_t i = 0; i < count; ++i) {
+			aabbs.Add({ position(random), position(random), position(random) }, { extent(random), extent(random), extent(random) });
+		}
+		return aabbs;
+	}
+
+	Float3 CenterOf(const AabbSoA& aabbs, size_t i)
+	{
+		return { aabbs.centerX[i], aabbs.centerY[i], aabbs.centerZ[i] };
+	}
+
+	Float3 ExtentOf(const AabbSoA& aabbs, size_t i)
+	{
+		return { aabbs.extentX[i], aabbs.extentY[i], aabbs.extentZ[i] };
+	}
+
+	// AABB ̒ steps^3 ̓_𓙊ԊuɎ callback(_) ĂԁBcallback  true Ԃ炻ł߂
+	template <typename Callback>
+	bool AnySamplePoint(const Float3& center, const Float3& extent, int steps, Callback callback)
+	{
+		for (int z = 0; z < steps; ++z) {
+			for (int y = 0; y < steps; ++y) {
+				for (int x = 0; x < steps; ++x) {
+					const auto offset = [steps](int step, float size) { return size * (2.0f * step / (steps - 1) - 1.0f); };
+					const Float3 point = {
+						center.x + offset(x, extent.x),
+						center.y + offset(y, extent.y),
+						center.z + offset(z, extent.z),
+					};
+					if (callback(point)) {
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	bool IsInsideClipVolume(const Float3& point, const Float4x4& viewProjection)
+	{
+		const Float4 clip = TransformPoint(point, viewProjection);
+		return clip.w > 0.0f &&
+			std::fabs(clip.x) <= clip.w &&
+			std::fabs(clip.y) <= clip.w &&
+			clip.z >= 0.0f && clip.z <= clip.w;
+	}
+
+	// 6ʂ̔̂Ԃǂ(ȂO)
+	float FrustumMargin(const Frustum& frustum, const Float3& center, const Float3& extent)
+	{
+		float margin = 1.0e30f;
+		for (const Float4& plane : frustum.planes) {
+			const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+			const float radius = std::fabs(plane.x) * extent.x + std::fabs(plane.y) * extent.y + std::fabs(plane.z) * extent.z;
+			margin = (std::min)(margin, distance + radius);
+		}
+		return margin;
+	}
+
+	std::vector<bool> VisibleFlags(const std::vector<uint32_t>& indices, size_t visibleCount, size_t count)
+	{
+		std::vector<bool> flags(count, false);
+		for (size_t i = 0; i < visibleCount; ++i) {
+			flags[indices[i]] = true;
+		}
+		return flags;
+	}
+
+	// Jɐ΂(z ݂̌Ȃ AABB)ŉBA_ƂɌɌ邩𔻒肷V[
+	struct OcclusionScene
+	{
+		AabbSoA occluders;
+		AabbSoA occludees;
+	};
+
+	OcclusionScene MakeOcclusionScene(unsigned int seed)
+	{
+		OcclusionScene scene;
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> occluderPosition(-12.0f, 12.0f);
+		std::uniform_real_distribution<float> occluderDepth(-45.0f, -30.0f);
+		std::uniform_real_distribution<float> occluderSize(1.0f, 5.0f);
+		for (int i = 0; i < 24; ++i) {
+			scene.occluders.Add(
+				{ occluderPosition(random), occluderPosition(random), occluderDepth(random) },
+				{ occluderSize(random), occluderSize(random), 0.0f }
+			);
+		}
+		std::uniform_real_distribution<float> position(-15.0f, 15.0f);
+		std::uniform_real_distribution<float> depth(-40.0f, 10.0f);
+		std::uniform_real_distribution<float> extent(0.2f, 1.5f);
+		for (int i = 0; i < 3000; ++i) {
+			scene.occludees.Add({ position(random), position(random), depth(random) }, { extent(random), extent(random), extent(random) });
+		}
+		return scene;
+	}
+
+	// _ʂɓĂāAO(z )̔ɉBĂȂΌĂ
+	bool IsPointVisible(const OcclusionScene& scene, const Float3& point, const Float4x4& viewProjection)
+	{
+		if (!IsInsideClipVolume(point, viewProjection)) {
+			return false;
+		}
+		const Float4 clip = TransformPoint(point, viewProjection);
+		for (size_t i = 0; i < scene.occluders.Size(); ++i) {
+			const Float3 center = CenterOf(scene.occluders, i);
+			const Float3 extent = ExtentOf(scene.occluders, i);
+			if (center.z >= point.z) {
+				continue;
+			}
+			//  z Ȃ̂ŁA_Ɠ̎ʂʒuׂ
+			const Float4 lower = TransformPoint({ center.x - extent.x, center.y - extent.y, center.z }, viewProjection);
+			const Float4 upper = TransformPoint({ center.x + extent.x, center.y + extent.y, center.z }, viewProjection);
+			const float x = clip.x / clip.w;
+			const float y = clip.y / clip.w;
+			if (x >= lower.x / lower.w && x <= upper.x / upper.w && y >= lower.y / lower.w && y <= upper.y / upper.w) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	struct OcclusionCounts
+	{
+		// Ă̂ɉBꂽƂꂽ(`ꂸɌ)
+		size_t wronglyOccluded = 0;
+		// ʂ̒ɂāAǂ̓_BĂ
+		size_t hidden = 0;
+		// ̂IN[Wobt@[Ŏ̂Ăꂽ
+		size_t hiddenAndCulled = 0;
+	};
+
+	OcclusionCounts CountOcclusion(bool reversedZ)
+	{
+		const Float4x4 viewProjection = MakeViewProjection(reversedZ);
+		const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+		const OcclusionScene scene = MakeOcclusionScene(reversedZ ? 11 : 10);
+		OcclusionBuffer buffer(256, 144, reversedZ);
+		for (size_t i = 0; i < scene.occluders.Size(); ++i) {
+			buffer.RasterizeOccluder(frustum, CenterOf(scene.occluders, i), ExtentOf(scene.occluders, i));
+		}
+
+		OcclusionCounts counts;
+		for (size_t i = 0; i < scene.occludees.Size(); ++i) {
+			const Float3 center = CenterOf(scene.occludees, i);
+			const Float3 extent = ExtentOf(scene.occludees, i);
+			const bool occluded = buffer.IsOccluded(frustum, center, extent);
+			const bool visible = AnySamplePoint(center, extent, 7, [&](const Float3& point) {
+				return IsPointVisible(scene, point, viewProjection);
+			});
+			const bool onScreen = AnySamplePoint(center, extent, 7, [&](const Float3& point) {
+				return IsInsideClipVolume(point, viewProjection);
+			});
+			if (visible && occluded) {
+				++counts.wronglyOccluded;
+			}
+			if (onScreen && !visible) {
+				++counts.hidden;
+				counts.hiddenAndCulled += occluded ? 1 : 0;
+			}
+		}
+		return counts;
+	}
+}
+
+TEST_CASE(Culling, InstructionSetsAgree)
+{
+	// 4 ł 8 ł؂ȂɂāA[̏ʂ
+	const AabbSoA aabbs = MakeRandomAabbs(4099, 1);
+	const Frustum frustum = Frustum::FromViewProjection(MakeViewProjection(false));
+	std::vector<uint32_t> reference(aabbs.Size());
+	const size_t referenceCount = CullAabbs(frustum, aabbs, reference.data(), nullptr, CullingInstructionSet::Scalar);
+	const std::vector<bool> referenceFlags = VisibleFlags(reference, referenceCount, aabbs.Size());
+
+	const CullingInstructionSet instructionSets[] = {
+		CullingInstructionSet::Auto,
+		CullingInstructionSet::Sse2,
+		CullingInstructionSet::Avx2,
+	};
+	for (const CullingInstructionSet instructionSet : instructionSets) {
+		if (!IsCullingInstructionSetSupported(instructionSet)) {
+			continue;
+		}
+		std::vector<uint32_t> visible(aabbs.Size());
+		const size_t visibleCount = CullAabbs(frustum, aabbs, visible.data(), nullptr, instructionSet);
+		CHECK(std::is_sorted(visible.begin(), visible.begin() + visibleCount));
+		const std::vector<bool> flags = VisibleFlags(visible, visibleCount, aabbs.Size());
+		// FMA ͊ۂ߂1񏭂Ȃ̂ŁAʂɂ҂ڂĂ͈̂Ă悢
+		size_t mismatchCount = 0;
+		for (size_t i = 0; i < aabbs.Size(); ++i) {
+			if (flags[i] != referenceFlags[i] && std::fabs(FrustumMargin(frustum, CenterOf(aabbs, i), ExtentOf(aabbs, i))) > 1.0e-4f) {
+				++mismatchCount;
+			}
+		}
+		CHECK_EQ(0u, mismatchCount);
+	}
+}
+
+TEST_CASE(Culling, FrustumNeverDropsVisibleAabbs)
+{
+	const AabbSoA aabbs = MakeRandomAabbs(8192, 2);
+	const Float4x4 viewProjection = MakeViewProjection(false);
+	const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+	std::vector<uint32_t> visible(aabbs.Size());
+	const std::vector<bool> flags = VisibleFlags(visible, CullAabbs(frustum, aabbs, visible.data()), aabbs.Size());
+
+	size_t droppedCount = 0;
+	for (size_t i = 0; i < aabbs.Size(); ++i) {
+		const bool onScreen = AnySamplePoint(CenterOf(aabbs, i), ExtentOf(aabbs, i), 5, [&](const Float3& point) {
+			return IsInsideClipVolume(point, viewProjection);
+		});
+		droppedCount += onScreen && !flags[i] ? 1 : 0;
+	}
+	CHECK_EQ(0u, droppedCount);
+}
+
+TEST_CASE(Culling, FrustumFalsePositiveRate)
+{
+	// ʂƂ̔Ȃ̂ŁÅp̊Oɂ͎̂c邱ƂB傫߂ AABB ł̊
+	const AabbSoA aabbs = MakeRandomAabbs(8192, 3, 8.0f);
+	const Float4x4 viewProjection = MakeViewProjection(false);
+	const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+	std::vector<uint32_t> visible(aabbs.Size());
+	const size_t visibleCount = CullAabbs(frustum, aabbs, visible.data());
+	REQUIRE(visibleCount > 0);
+
+	size_t falsePositiveCount = 0;
+	for (size_t i = 0; i < visibleCount; ++i) {
+		const bool onScreen = AnySamplePoint(CenterOf(aabbs, visible[i]), ExtentOf(aabbs, visible[i]), 8, [&](const Float3& point) {
+			return IsInsideClipVolume(point, viewProjection);
+		});
+		falsePositiveCount += onScreen ? 0 : 1;
+	}
+	CHECK(static_cast<double>(falsePositiveCount) / visibleCount < 0.02);
+}
+
+TEST_CASE(Culling, OcclusionNeverHidesVisibleAabbs)
+{
+	const OcclusionCounts counts = CountOcclusion(false);
+	CHECK_EQ(0u, counts.wronglyOccluded);
+	// 𑜓xŕێIɓhԂ肱ڂABĂ̂̑唼͎̂Ă
+	REQUIRE(counts.hidden > 100);
+	CHECK(static_cast<double>(counts.hiddenAndCulled) / counts.hidden > 0.5);
+}
+
+TEST_CASE(Culling, OcclusionWithReversedZ)
+{
+	const OcclusionCounts counts = CountOcclusion(true);
+	CHECK_EQ(0u, counts.wronglyOccluded);
+	REQUIRE(counts.hidden > 100);
+	CHECK(static_cast<double>(counts.hiddenAndCulled) / counts.hidden > 0.5);
+}
+
+TEST_CASE(Culling, CullFrontToBackKeepsFrontmost)
+{
+	const Float4x4 viewProjection = MakeViewProjection(true);
+	const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+	AabbSoA boards;
+	// 0: Ȏ傫ȔA1: ̐^̏ȔA2: ɂꂽA3: 0 Ɠ[ŏdȂ
+	boards.Add({ 0.0f, 0.0f, -40.0f }, { 4.0f, 4.0f, 0.0f });
+	boards.Add({ 0.0f, 0.0f, -20.0f }, { 2.0f, 2.0f, 0.0f });
+	boards.Add({ 9.0f, 0.0f, -10.0f }, { 2.0f, 2.0f, 0.0f });
+	boards.Add({ 1.0f, 1.0f, -40.0f }, { 1.0f, 1.0f, 0.0f });
+
+	OcclusionBuffer buffer(256, 144, true);
+	uint32_t indices[] = { 0, 3, 1, 2 };
+	const size_t keptCount = buffer.CullFrontToBack(frustum, boards, indices, 4);
+	REQUIRE_EQ(3u, keptCount);
+	CHECK_EQ(0u, indices[0]);
+	CHECK_EQ(3u, indices[1]);
+	CHECK_EQ(2u, indices[2]);
+}
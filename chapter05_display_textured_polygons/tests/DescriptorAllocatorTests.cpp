@@ -0,0 +1,78 @@
+#include "DescriptorAllocator.h"
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	constexpr uint32_t kNoIndex = DescriptorAllocator::kInvalidIndex;
+}
+
+TEST_CASE(DescriptorAllocator, AllocatesFromTheFrontUntilFull)
+{
+	DescriptorAllocator allocator(8);
+	CHECK_EQ(0u, allocator.Allocate());
+	CHECK_EQ(1u, allocator.Allocate(3));
+	CHECK_EQ(4u, allocator.Allocate(4));
+	CHECK_EQ(0u, allocator.FreeCount());
+	CHECK_EQ(kNoIndex, allocator.Allocate());
+	CHECK_EQ(kNoIndex, allocator.Allocate(0));
+
+	DescriptorAllocator empty;
+	CHECK_EQ(kNoIndex, empty.Allocate());
+}
+
+TEST_CASE(DescriptorAllocator, FreedRangesAreJoined)
+{
+	DescriptorAllocator allocator(8);
+	for (uint32_t i = 0; i < 8; ++i) {
+		REQUIRE_EQ(i, allocator.Allocate());
+	}
+	allocator.Free(1);
+	allocator.Free(3);
+	allocator.Free(5);
+	CHECK_EQ(static_cast<size_t>(3), allocator.FreeRangeCount());
+	// 3 ɕĂ̂ 2 ͎Ȃ
+	CHECK_EQ(kNoIndex, allocator.Allocate(2));
+
+	// ƂȂEOƂȂEƂȂ
+	allocator.Free(0);
+	CHECK_EQ(static_cast<size_t>(3), allocator.FreeRangeCount());
+	allocator.Free(6);
+	CHECK_EQ(static_cast<size_t>(3), allocator.FreeRangeCount());
+	allocator.Free(2);
+	CHECK_EQ(static_cast<size_t>(2), allocator.FreeRangeCount());
+	allocator.Free(4);
+	CHECK_EQ(static_cast<size_t>(1), allocator.FreeRangeCount());
+	CHECK_EQ(7u, allocator.FreeCount());
+	CHECK_EQ(0u, allocator.Allocate(7));
+	CHECK_EQ(0u, allocator.FreeCount());
+}
+
+TEST_CASE(DescriptorAllocator, ReusesTheSmallestRangeThatFits)
+{
+	DescriptorAllocator allocator(16);
+	CHECK_EQ(0u, allocator.Allocate(4));
+	CHECK_EQ(4u, allocator.Allocate(2));
+	CHECK_EQ(6u, allocator.Allocate(4));
+	allocator.Free(0, 4);
+	allocator.Free(6, 4);
+	// 󂫂 0..4  6..16B܂钆ŏق
+	CHECK_EQ(6u, allocator.Allocate(5));
+	CHECK_EQ(0u, allocator.Allocate(3));
+	CHECK_EQ(3u, allocator.Allocate());
+	CHECK_EQ(11u, allocator.Allocate(5));
+	CHECK_EQ(0u, allocator.FreeCount());
+
+	// 擪ɋ߂ 3 ̋󂫂A傤ǎ܂ 2 ̋󂫂g
+	allocator.Reset(16);
+	CHECK_EQ(16u, allocator.FreeCount());
+	CHECK_EQ(0u, allocator.Allocate(3));
+	CHECK_EQ(3u, allocator.Allocate(1));
+	CHECK_EQ(4u, allocator.Allocate(2));
+	CHECK_EQ(6u, allocator.Allocate(10));
+	allocator.Free(0, 3);
+	allocator.Free(4, 2);
+	CHECK_EQ(4u, allocator.Allocate(2));
+	CHECK_EQ(0u, allocator.Allocate(2));
+}
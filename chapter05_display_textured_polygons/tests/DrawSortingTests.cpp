@@ -0,0 +1,91 @@
+#include "DrawSorting.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	//  32bit ͌̕т̔ԍȂ̂ŁAL[Ŝ std::sort Έɕׂ̂ƓɂȂ
+	std::vector<DrawSortKey> SortedReference(std::vector<DrawSortKey> keys)
+	{
+		std::sort(keys.begin(), keys.end());
+		return keys;
+	}
+
+	std::vector<DrawSortKey> MakeDepthKeys(size_t count, uint32_t seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_real_distribution<float> depth(-5.0f, 5.0f);
+		std::vector<DrawSortKey> keys(count);
+		for (size_t i = 0; i < count; ++i) {
+			keys[i] = MakeDrawSortKey(BackToFrontOrder(depth(random)), static_cast<uint32_t>(i));
+		}
+		return keys;
+	}
+}
+
+TEST_CASE(DrawSorting, RadixSortMatchesStdSort)
+{
+	for (const size_t count : { 0, 1, 2, 100, 40000 }) {
+		const std::vector<DrawSortKey> source = MakeDepthKeys(count, static_cast<uint32_t>(count));
+		std::vector<DrawSortKey> keys = source;
+		std::vector<DrawSortKey> scratch(count);
+		RadixSortDrawKeys(keys.data(), scratch.data(), keys.size());
+		CHECK(keys == SortedReference(source));
+	}
+}
+
+TEST_CASE(DrawSorting, ParallelRadixSortMatchesStdSort)
+{
+	JobSystem jobSystem;
+	// ɕׂ鐔ƁAԂɕĕׂ鐔̗
+	for (const size_t count : { 100, 40000, 300007 }) {
+		const std::vector<DrawSortKey> source = MakeDepthKeys(count, static_cast<uint32_t>(count));
+		std::vector<DrawSortKey> keys = source;
+		std::vector<DrawSortKey> scratch(count);
+		ParallelRadixSortDrawKeys(keys.data(), scratch.data(), keys.size(), jobSystem);
+		CHECK(keys == SortedReference(source));
+	}
+}
+
+TEST_CASE(DrawSorting, EqualOrdersKeepSubmissionOrder)
+{
+	// pCvC 4  x eNX` 64 œʂɏdȂ
+	std::mt19937 random(7);
+	std::vector<DrawSortKey> source(200000);
+	for (size_t i = 0; i < source.size(); ++i) {
+		source[i] = MakeDrawSortKey(OpaqueStateOrder(random() % 4, random() % 64), static_cast<uint32_t>(i));
+	}
+	std::vector<DrawSortKey> scratch(source.size());
+
+	std::vector<DrawSortKey> keys = source;
+	RadixSortDrawKeys(keys.data(), scratch.data(), keys.size());
+	CHECK(keys == SortedReference(source));
+
+	JobSystem jobSystem;
+	keys = source;
+	ParallelRadixSortDrawKeys(keys.data(), scratch.data(), keys.size(), jobSystem);
+	CHECK(keys == SortedReference(source));
+}
+
+TEST_CASE(DrawSorting, DepthSortBitsFollowFloatOrder)
+{
+	const float depths[] = { -3.0f, -0.5f, -0.0f, 0.0f, 0.25f, 7.0f };
+	for (size_t i = 0; i + 1 < sizeof(depths) / sizeof(depths[0]); ++i) {
+		CHECK(DepthSortBits(depths[i]) <= DepthSortBits(depths[i + 1]));
+	}
+}
+
+TEST_CASE(DrawSorting, OpaqueOrderGroupsByStateThenFrontToBack)
+{
+	// reversed-Z Ȃ̂Ő[x傫قǎO
+	CHECK(OpaqueDrawOrder(1, 2, 0.9f) < OpaqueDrawOrder(1, 2, 0.1f));
+	// ԂႦ΁A[xɂ炸Ԃŕ
+	CHECK(OpaqueDrawOrder(1, 2, 0.1f) < OpaqueDrawOrder(1, 3, 0.9f));
+	CHECK(OpaqueDrawOrder(1, 255, 0.1f) < OpaqueDrawOrder(2, 0, 0.9f));
+	CHECK(BackToFrontOrder(0.1f) < BackToFrontOrder(0.9f));
+}
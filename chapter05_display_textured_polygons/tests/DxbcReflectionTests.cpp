@@ -0,0 +1,274 @@
+#include "DxbcReflection.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+// tests/data  *.cso ͎̃VF[_[ fxc ŃRpĆBR}h tests/data/compile_fixtures.bat ɂB
+//   basic_vs_5_0.cso     BasicVertexShader.hlsl  BasicVS (vs_5_0)
+//   basic_ps_5_0.cso     BasicPixelShader.hlsl  BasicPS (ps_5_0)
+//   streamed_ps_5_1.cso  BasicPixelShader.hlsl  StreamedPS (ps_5_1B蓖Ă space t)
+// ܃`FbNCĂ̂ compile_fixtures.bat ܂sĂ炸Afxc Rei[̌`
+// (RDEF, ISGN, OSGN ̏̃`N)ɍ킹Ďőg񂾂́BVF[_[̃R[h(SHEX)͓ǂ܂Ȃ̂œĂȂ
+namespace {
+	// D3D_NAME_POSITION
+	constexpr uint32_t kSystemValuePosition = 1;
+	constexpr uint32_t kComponentFloat32 = 3;
+
+	std::vector<uint8_t> LoadFixture(const char* name)
+	{
+		std::ifstream stream(Test::SourcePath(std::string("tests/data/") + name), std::ios::binary);
+		REQUIRE(static_cast<bool>(stream));
+		return std::vector<uint8_t>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	}
+
+	ShaderReflectionData Parse(const std::vector<uint8_t>& bytes)
+	{
+		ShaderReflectionData reflection;
+		REQUIRE(ParseDxbc(bytes.data(), bytes.size(), reflection));
+		return reflection;
+	}
+
+	// index Ԗڂ̃`N̐擪(FourCC ̈ʒu)
+	uint32_t ChunkOffset(const std::vector<uint8_t>& bytes, uint32_t index)
+	{
+		uint32_t offset = 0;
+		std::memcpy(&offset, bytes.data() + 32 + index * sizeof(uint32_t), sizeof(offset));
+		return offset;
+	}
+
+	void WriteUint32(std::vector<uint8_t>& bytes, size_t offset, uint32_t value)
+	{
+		std::memcpy(bytes.data() + offset, &value, sizeof(value));
+	}
+
+	// Rei[̃`N(FourCC Ƒ傫܂)Ɏo
+	std::vector<std::vector<uint8_t>> SplitChunks(const std::vector<uint8_t>& bytes)
+	{
+		uint32_t chunkCount = 0;
+		std::memcpy(&chunkCount, bytes.data() + 28, sizeof(chunkCount));
+		std::vector<std::vector<uint8_t>> chunks;
+		for (uint32_t i = 0; i < chunkCount; ++i) {
+			const uint32_t offset = ChunkOffset(bytes, i);
+			uint32_t size = 0;
+			std::memcpy(&size, bytes.data() + offset + 4, sizeof(size));
+			chunks.emplace_back(bytes.begin() + offset, bytes.begin() + offset + 8 + size);
+		}
+		return chunks;
+	}
+
+	// g 0 ̃`N
+	std::vector<uint8_t> MakeChunk(const char* fourCc, uint32_t size)
+	{
+		std::vector<uint8_t> chunk(8 + size, 0);
+		std::memcpy(chunk.data(), fourCc, 4);
+		WriteUint32(chunk, 4, size);
+		return chunk;
+	}
+
+	// `NׂăRei[ɂB`FbNT͓ǂ܂Ȃ̂ 0 ̂܂
+	std::vector<uint8_t> BuildContainer(const std::vector<std::vector<uint8_t>>& chunks)
+	{
+		const size_t headerSize = 32 + chunks.size() * sizeof(uint32_t);
+		std::vector<uint8_t> bytes(headerSize, 0);
+		std::memcpy(bytes.data(), "DXBC", 4);
+		WriteUint32(bytes, 20, 1);
+		WriteUint32(bytes, 28, static_cast<uint32_t>(chunks.size()));
+		for (size_t i = 0; i < chunks.size(); ++i) {
+			WriteUint32(bytes, 32 + i * sizeof(uint32_t), static_cast<uint32_t>(bytes.size()));
+			bytes.insert(bytes.end(), chunks[i].begin(), chunks[i].end());
+		}
+		WriteUint32(bytes, 24, static_cast<uint32_t>(bytes.size()));
+		return bytes;
+	}
+}
+
+TEST_CASE(DxbcReflection, ReadsTheVertexShaderInputSignature)
+{
+	const ShaderReflectionData reflection = Parse(LoadFixture("basic_vs_5_0.cso"));
+	REQUIRE_EQ(static_cast<size_t>(2), reflection.inputs.size());
+	CHECK_EQ(std::string("POSITION"), reflection.inputs[0].semanticName);
+	CHECK_EQ(0u, reflection.inputs[0].semanticIndex);
+	CHECK_EQ(0u, reflection.inputs[0].systemValue);
+	CHECK_EQ(kComponentFloat32, reflection.inputs[0].componentType);
+	CHECK_EQ(0u, reflection.inputs[0].registerIndex);
+	CHECK_EQ(static_cast<uint8_t>(0x7), reflection.inputs[0].mask);
+	CHECK_EQ(std::string("TEXCOORD"), reflection.inputs[1].semanticName);
+	CHECK_EQ(1u, reflection.inputs[1].registerIndex);
+	CHECK_EQ(static_cast<uint8_t>(0x3), reflection.inputs[1].mask);
+	// _VF[_[̓\[XgȂ
+	CHECK(reflection.bindings.empty());
+}
+
+TEST_CASE(DxbcReflection, ReadsPixelShaderBindings)
+{
+	const ShaderReflectionData reflection = Parse(LoadFixture("basic_ps_5_0.cso"));
+	REQUIRE_EQ(static_cast<size_t>(2), reflection.inputs.size());
+	CHECK_EQ(std::string("SV_POSITION"), reflection.inputs[0].semanticName);
+	CHECK_EQ(kSystemValuePosition, reflection.inputs[0].systemValue);
+
+	REQUIRE_EQ(static_cast<size_t>(2), reflection.bindings.size());
+	CHECK_EQ(std::string("samplerState"), reflection.bindings[0].name);
+	CHECK(reflection.bindings[0].type == ShaderInputType::Sampler);
+	CHECK_EQ(0u, reflection.bindings[0].bindPoint);
+	CHECK_EQ(std::string("tex"), reflection.bindings[1].name);
+	CHECK(reflection.bindings[1].type == ShaderInputType::Texture);
+	CHECK_EQ(0u, reflection.bindings[1].bindPoint);
+	CHECK_EQ(1u, reflection.bindings[1].bindCount);
+	CHECK_EQ(0u, reflection.bindings[1].space);
+}
+
+TEST_CASE(DxbcReflection, ReadsShaderModel51BindingsWithSpace)
+{
+	const ShaderReflectionData reflection = Parse(LoadFixture("streamed_ps_5_1.cso"));
+	// 5.1 1 40 oCgB傫ԈႦ2ڈȍ~̖O
+	REQUIRE_EQ(static_cast<size_t>(4), reflection.bindings.size());
+	CHECK_EQ(std::string("tex"), reflection.bindings[1].name);
+	CHECK_EQ(std::string("tileIndirection"), reflection.bindings[2].name);
+	CHECK(reflection.bindings[2].type == ShaderInputType::Texture);
+	CHECK_EQ(1u, reflection.bindings[2].bindPoint);
+	CHECK_EQ(std::string("tileFeedback"), reflection.bindings[3].name);
+	CHECK(reflection.bindings[3].type == ShaderInputType::RWTyped);
+	CHECK_EQ(1u, reflection.bindings[3].bindPoint);
+	CHECK_EQ(0u, reflection.bindings[3].space);
+}
+
+TEST_CASE(DxbcReflection, SkipsChunksItDoesNotRead)
+{
+	// fxc ̏o͂ɂ̓VF[_[̃R[h(SHEX)ⓝv(STAT)A/Zi ȂfobOB
+	// őg fixture ɂ͂Ȃ̂ŁAĂʂɂȂ邱Ƃm߂
+	const std::vector<uint8_t> original = LoadFixture("streamed_ps_5_1.cso");
+	const ShaderReflectionData expected = Parse(original);
+	const std::vector<std::vector<uint8_t>> chunks = SplitChunks(original);
+	REQUIRE_EQ(static_cast<size_t>(3), chunks.size());
+
+	// fxc ̕(RDEF, ISGN, OSGN, SHEX, STAT)ƁAǂރ`Nɂ
+	const std::vector<std::vector<uint8_t>> layouts[] = {
+		{ chunks[0], chunks[1], chunks[2], MakeChunk("SHEX", 64), MakeChunk("STAT", 148) },
+		{ MakeChunk("SDBG", 36), MakeChunk("SHEX", 64), chunks[2], chunks[1], chunks[0] },
+	};
+	for (const auto& layout : layouts) {
+		const ShaderReflectionData reflection = Parse(BuildContainer(layout));
+		REQUIRE_EQ(expected.inputs.size(), reflection.inputs.size());
+		for (size_t i = 0; i < expected.inputs.size(); ++i) {
+			CHECK_EQ(expected.inputs[i].semanticName, reflection.inputs[i].semanticName);
+			CHECK_EQ(expected.inputs[i].mask, reflection.inputs[i].mask);
+		}
+		REQUIRE_EQ(expected.bindings.size(), reflection.bindings.size());
+		for (size_t i = 0; i < expected.bindings.size(); ++i) {
+			CHECK_EQ(expected.bindings[i].name, reflection.bindings[i].name);
+			CHECK_EQ(expected.bindings[i].bindPoint, reflection.bindings[i].bindPoint);
+			CHECK_EQ(expected.bindings[i].space, reflection.bindings[i].space);
+		}
+	}
+}
+
+TEST_CASE(DxbcReflection, RejectsTruncatedContainers)
+{
+	const char* fixtures[] = { "basic_vs_5_0.cso", "basic_ps_5_0.cso", "streamed_ps_5_1.cso" };
+	for (const char* fixture : fixtures) {
+		const std::vector<uint8_t> bytes = LoadFixture(fixture);
+		for (size_t size = 0; size < bytes.size(); ++size) {
+			// ؂ꂽǂ܂Ȃ悤ɁA傤ǂ̑傫̗̈Ɏʂ
+			const std::vector<uint8_t> truncated(bytes.begin(), bytes.begin() + size);
+			ShaderReflectionData reflection;
+			CHECK(!ParseDxbc(truncated.data(), truncated.size(), reflection));
+		}
+	}
+}
+
+TEST_CASE(DxbcReflection, RejectsCorruptChunks)
+{
+	const std::vector<uint8_t> original = LoadFixture("basic_ps_5_0.cso");
+	ShaderReflectionData reflection;
+
+	std::vector<uint8_t> bytes = original;
+	bytes[0] = 'X';
+	CHECK(!ParseDxbc(bytes.data(), bytes.size(), reflection));
+
+	// DXIL ɂ RDEF Ȃ
+	bytes = original;
+	std::memcpy(bytes.data() + ChunkOffset(bytes, 0), "DXIL", 4);
+	CHECK(!ParseDxbc(bytes.data(), bytes.size(), reflection));
+
+	// `NRei[̊O܂őĂ
+	bytes = original;
+	WriteUint32(bytes, ChunkOffset(bytes, 1) + 4, 0x10000);
+	CHECK(!ParseDxbc(bytes.data(), bytes.size(), reflection));
+
+	// 蓖Ă̐`NɎ܂Ȃ
+	bytes = original;
+	WriteUint32(bytes, ChunkOffset(bytes, 0) + 8 + 8, 0x01000000);
+	CHECK(!ParseDxbc(bytes.data(), bytes.size(), reflection));
+
+	// O`N̊OwĂ
+	bytes = original;
+	uint32_t bindingOffset = 0;
+	std::memcpy(&bindingOffset, bytes.data() + ChunkOffset(bytes, 0) + 8 + 12, sizeof(bindingOffset));
+	WriteUint32(bytes, ChunkOffset(bytes, 0) + 8 + bindingOffset, 0xFFFF);
+	CHECK(!ParseDxbc(bytes.data(), bytes.size(), reflection));
+
+	// sĂo͂͏Ȃ
+	reflection = Parse(original);
+	CHECK(!ParseDxbc(bytes.data(), bytes.size(), reflection));
+	CHECK_EQ(static_cast<size_t>(2), reflection.bindings.size());
+}
+
+TEST_CASE(DxbcReflection, CacheRoundTripsAndChecksTheKey)
+{
+	const ShaderReflectionData reflection = Parse(LoadFixture("streamed_ps_5_1.cso"));
+	const std::vector<uint8_t> bytes = SerializeReflection(reflection, 0x1234);
+
+	ShaderReflectionData loaded;
+	REQUIRE(DeserializeReflection(bytes, 0x1234, loaded));
+	REQUIRE_EQ(reflection.inputs.size(), loaded.inputs.size());
+	for (size_t i = 0; i < reflection.inputs.size(); ++i) {
+		CHECK_EQ(reflection.inputs[i].semanticName, loaded.inputs[i].semanticName);
+		CHECK_EQ(reflection.inputs[i].systemValue, loaded.inputs[i].systemValue);
+		CHECK_EQ(reflection.inputs[i].mask, loaded.inputs[i].mask);
+	}
+	REQUIRE_EQ(reflection.bindings.size(), loaded.bindings.size());
+	for (size_t i = 0; i < reflection.bindings.size(); ++i) {
+		CHECK_EQ(reflection.bindings[i].name, loaded.bindings[i].name);
+		CHECK(reflection.bindings[i].type == loaded.bindings[i].type);
+		CHECK_EQ(reflection.bindings[i].bindPoint, loaded.bindings[i].bindPoint);
+		CHECK_EQ(reflection.bindings[i].space, loaded.bindings[i].space);
+	}
+
+	// \[Xς(L[Ⴄ)ƂÃt@C͎gȂ
+	CHECK(!DeserializeReflection(bytes, 0x1235, loaded));
+	for (size_t size = 0; size < bytes.size(); ++size) {
+		CHECK(!DeserializeReflection(std::vector<uint8_t>(bytes.begin(), bytes.begin() + size), 0x1234, loaded));
+	}
+}
+
+TEST_CASE(DxbcReflection, ReadsRootSignatureParameterTypes)
+{
+	// e[uE[g萔E[g CBV 3Bp[^[̒g͓ǂ܂Ȃ̂ 0 ̂܂
+	std::vector<uint8_t> rootSignature = MakeChunk("RTS0", 24 + 3 * 12);
+	const uint32_t header[] = { 1, 3, 24, 0, 60, 0 };
+	std::memcpy(rootSignature.data() + 8, header, sizeof(header));
+	WriteUint32(rootSignature, 8 + 24 + 12, 1);
+	WriteUint32(rootSignature, 8 + 24 + 24, 2);
+	const std::vector<uint8_t> bytes = BuildContainer({ MakeChunk("STAT", 16), rootSignature });
+
+	std::vector<uint32_t> types;
+	REQUIRE(ParseRootSignatureParameters(bytes.data(), bytes.size(), types));
+	REQUIRE_EQ(static_cast<size_t>(3), types.size());
+	CHECK_EQ(0u, types[0]);
+	CHECK_EQ(1u, types[1]);
+	CHECK_EQ(2u, types[2]);
+
+	// RTS0 ̂ȂRei[(VF[_[)ErŐ؂ꂽ́Ep[^[`N͂ݏo
+	CHECK(!ParseRootSignatureParameters(bytes.data(), bytes.size() - 1, types));
+	const std::vector<uint8_t> shader = LoadFixture("basic_ps_5_0.cso");
+	CHECK(!ParseRootSignatureParameters(shader.data(), shader.size(), types));
+	WriteUint32(rootSignature, 8 + 4, 4);
+	const std::vector<uint8_t> overrun = BuildContainer({ rootSignature });
+	CHECK(!ParseRootSignatureParameters(overrun.data(), overrun.size(), types));
+	CHECK_EQ(static_cast<size_t>(3), types.size());
+}
@@ -0,0 +1,173 @@
+#include "DynamicResolution.h"
+
+#include <cmath>
+#include <sstream>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// {ςĂk܂Ȃ(|XgvZX̓͂̓ǂݏoA𑜓xɂȂ)̊
+	constexpr double kFixedCostFraction = 0.1;
+	// GPU Ԃ FramePipeline ̃Xbg߂ĂƂɓǂނ̂ŁAt[̐xē͂
+	constexpr size_t kMeasurementLatency = 3;
+
+	std::vector<double> LoadTrace(const char* name)
+	{
+		std::vector<double> trace;
+		REQUIRE(LoadFrameTimeTrace(Test::SourcePath(std::string("tests/data/") + name), trace));
+		return trace;
+	}
+
+	// { 1 ł̎ fullMilliseconds Ac scale {ŕ`Ƃ̎Ԃɂ
+	double ScaledMilliseconds(double fullMilliseconds, float scale)
+	{
+		return fullMilliseconds * (kFixedCostFraction + (1.0 - kFixedCostFraction) * scale * scale);
+	}
+
+	struct Simulation
+	{
+		std::vector<float> scales;
+		std::vector<double> milliseconds;
+	};
+
+	// L^̊et[̂Ƃ̔{ŕ`ƂɂāAlatency t[xŃRg[[ɓn
+	Simulation Simulate(
+		const std::vector<double>& trace,
+		DynamicResolutionController& controller,
+		size_t latency = kMeasurementLatency
+	) {
+		Simulation simulation;
+		for (size_t frame = 0; frame < trace.size(); ++frame) {
+			const float scale = controller.Scale();
+			simulation.scales.push_back(scale);
+			simulation.milliseconds.push_back(ScaledMilliseconds(trace[frame], scale));
+			if (frame >= latency) {
+				controller.Update(simulation.milliseconds[frame - latency]);
+			}
+		}
+		return simulation;
+	}
+
+	// [begin, end) ̒ŁA end ܂ŕςڕW tolerance ȓɎ܂葱ŏ̃t[B܂Ȃ end
+	size_t SettleFrame(
+		const Simulation& simulation,
+		size_t begin,
+		size_t end,
+		double targetMilliseconds,
+		double tolerance
+	) {
+		// 1t[Ƃ̂΂ł͂ȂA8t[̕ςŌ
+		const size_t window = 8;
+		size_t settled = end;
+		for (size_t frame = end; frame-- > begin + window;) {
+			double sum = 0.0;
+			for (size_t i = frame - window; i < frame; ++i) {
+				sum += simulation.milliseconds[i];
+			}
+			if (std::abs(sum / window - targetMilliseconds) > targetMilliseconds * tolerance) {
+				break;
+			}
+			settled = frame - window;
+		}
+		return settled;
+	}
+
+	float MinScale(const Simulation& simulation, size_t begin, size_t end)
+	{
+		float scale = 1.0f;
+		for (size_t frame = begin; frame < end; ++frame) {
+			scale = (std::min)(scale, simulation.scales[frame]);
+		}
+		return scale;
+	}
+
+	float MaxScale(const Simulation& simulation, size_t begin, size_t end)
+	{
+		float scale = 0.0f;
+		for (size_t frame = begin; frame < end; ++frame) {
+			scale = (std::max)(scale, simulation.scales[frame]);
+		}
+		return scale;
+	}
+}
+
+TEST_CASE(DynamicResolution, LightTraceStaysAtFullResolution)
+{
+	const std::vector<double> trace = LoadTrace("frame_times_light.txt");
+	DynamicResolutionController controller;
+	const Simulation simulation = Simulate(trace, controller);
+	CHECK_EQ(1.0f, MinScale(simulation, 0, trace.size()));
+}
+
+TEST_CASE(DynamicResolution, LoadStepConvergesAndRecovers)
+{
+	const std::vector<double> trace = LoadTrace("frame_times_load_step.txt");
+	REQUIRE_EQ(static_cast<size_t>(900), trace.size());
+	const DynamicResolutionController::Settings settings;
+
+	for (size_t latency = 1; latency <= kMeasurementLatency; ++latency) {
+		DynamicResolutionController controller(settings);
+		const Simulation simulation = Simulate(trace, controller, latency);
+
+		// dʂɓĂ 1 b(60 t[)ȓɁAڕW 10% ȓɎ܂葱
+		const size_t settled = SettleFrame(simulation, 300, 600, settings.targetMilliseconds, 0.1);
+		CHECK(settled < 360);
+		// Ƃ͌v̂΂xɂAl傫邱ƂȂ
+		const float steadyMin = MinScale(simulation, 400, 600);
+		CHECK(MaxScale(simulation, 400, 600) - steadyMin < 0.04f);
+		CHECK(MinScale(simulation, 300, 400) > steadyMin - 0.03f);
+		CHECK(steadyMin > settings.minScale);
+
+		// yʂɖ߂A1 bȓɑS𑜓xɖ߂
+		CHECK_EQ(settings.maxScale, simulation.scales[660]);
+		CHECK_EQ(settings.maxScale, MinScale(simulation, 660, trace.size()));
+	}
+}
+
+TEST_CASE(DynamicResolution, SingleFrameSpikesBarelyMoveTheScale)
+{
+	const std::vector<double> trace = LoadTrace("frame_times_spikes.txt");
+	DynamicResolutionController controller;
+	const Simulation simulation = Simulate(trace, controller);
+	// 1t[̈ő傫Ȃ(1t[̏)
+	CHECK(MinScale(simulation, 0, trace.size()) >= 0.9f);
+	// ̍Ԃɂ͑S𑜓xɖ߂
+	CHECK_EQ(1.0f, simulation.scales[trace.size() - 1]);
+}
+
+TEST_CASE(DynamicResolution, ClampsToMinScaleWhenTheTargetIsOutOfReach)
+{
+	const std::vector<double> trace(300, 80.0);
+	DynamicResolutionController controller;
+	const Simulation simulation = Simulate(trace, controller);
+	CHECK_EQ(0.5f, simulation.scales[150]);
+	CHECK_EQ(0.5f, MinScale(simulation, 0, trace.size()));
+
+	// tĂԂɗ߂̂Ȃ̂ŁAyȂ΂ɏグn߂
+	const float before = controller.Scale();
+	for (int frame = 0; frame < 10; ++frame) {
+		controller.Update(5.0);
+	}
+	CHECK(controller.Scale() > before + 0.1f);
+}
+
+TEST_CASE(DynamicResolution, ReadsFrameTimeTraces)
+{
+	std::vector<double> milliseconds;
+	std::istringstream trace("# comment\n12.5\r\n\n  13 # after value\r\n");
+	REQUIRE(ReadFrameTimeTrace(trace, milliseconds));
+	REQUIRE_EQ(static_cast<size_t>(2), milliseconds.size());
+	CHECK_NEAR(12.5, milliseconds[0], 1e-12);
+	CHECK_NEAR(13.0, milliseconds[1], 1e-12);
+
+	std::istringstream broken("12.5\nabc\n");
+	CHECK(!ReadFrameTimeTrace(broken, milliseconds));
+	std::istringstream twoValues("12.5 13.0\n");
+	CHECK(!ReadFrameTimeTrace(twoValues, milliseconds));
+	std::istringstream negative("-1\n");
+	CHECK(!ReadFrameTimeTrace(negative, milliseconds));
+	std::istringstream empty("# nothing\n");
+	CHECK(!ReadFrameTimeTrace(empty, milliseconds));
+}
@@ -0,0 +1,224 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "JobSystem.h"
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// mۂ͈ [begin, end)
+	using Range = std::pair<uintptr_t, uintptr_t>;
+
+	// ׂ͈͂āAׂǂdȂĂ鐔𐔂
+	size_t CountOverlaps(std::vector<Range> ranges)
+	{
+		std::sort(ranges.begin(), ranges.end());
+		size_t overlapCount = 0;
+		for (size_t i = 1; i < ranges.size(); ++i) {
+			overlapCount += ranges[i].first < ranges[i - 1].second ? 1 : 0;
+		}
+		return overlapCount;
+	}
+
+	// mۂ̈XbhƔԍŌ܂lŖ߂āAƂŕĂȂm߂
+	uint8_t FillValue(size_t thread, size_t index)
+	{
+		return static_cast<uint8_t>(thread * 31 + index * 7 + 1);
+	}
+}
+
+TEST_CASE(FrameArena, AlignmentAndStats)
+{
+	FrameArena arena(4096);
+	const size_t alignments[] = { 1, 2, 4, 8, 16, 64, 256 };
+	uint64_t allocatedBytes = 0;
+	for (size_t i = 0; i < 100; ++i) {
+		const size_t alignment = alignments[i % 7];
+		const size_t size = 1 + i * 3;
+		void* pointer = arena.Allocate(size, alignment);
+		CHECK_EQ(0u, reinterpret_cast<uintptr_t>(pointer) % alignment);
+		allocatedBytes += size;
+	}
+	arena.Reset();
+	CHECK_EQ(100u, arena.LastFrameStats().allocationCount);
+	CHECK_EQ(allocatedBytes, arena.LastFrameStats().allocatedBytes);
+	CHECK(arena.LastFrameStats().chunkCount >= 1);
+
+	// mۂȂt[ 0
+	arena.Reset();
+	CHECK_EQ(0u, arena.LastFrameStats().allocationCount);
+	CHECK_EQ(0u, arena.LastFrameStats().chunkCount);
+}
+
+TEST_CASE(FrameArena, LargeAllocationsKeepTheCurrentChunk)
+{
+	FrameArena arena(4096);
+	uint8_t* small = static_cast<uint8_t*>(arena.Allocate(16, 16));
+	// `N傫̂͐pɊmۂÃ`N̑͂̂܂܎g
+	uint8_t* large = static_cast<uint8_t*>(arena.Allocate(100000, 64));
+	uint8_t* next = static_cast<uint8_t*>(arena.Allocate(16, 16));
+	CHECK_EQ(0u, reinterpret_cast<uintptr_t>(large) % 64);
+	CHECK(next == small + 16);
+	std::fill(large, large + 100000, static_cast<uint8_t>(0x5A));
+	arena.Reset();
+	CHECK_EQ(2u, arena.LastFrameStats().chunkCount);
+	CHECK(arena.LastFrameStats().reservedBytes >= 4096u + 100000u);
+
+	// ʏ̃`N͎g񂷂̂ŁAmۂĂꏊɂȂ
+	CHECK(arena.Allocate(16, 16) == small);
+	arena.Reset();
+}
+
+TEST_CASE(FrameArena, FrameVectorGrowsInsideTheArena)
+{
+	FrameArena arena;
+	{
+		FrameVector<uint64_t> values{ FrameAllocator<uint64_t>(arena) };
+		for (uint64_t i = 0; i < 10000; ++i) {
+			values.push_back(i * i);
+		}
+		uint64_t wrongCount = 0;
+		for (uint64_t i = 0; i < 10000; ++i) {
+			wrongCount += values[i] != i * i ? 1 : 0;
+		}
+		CHECK_EQ(0u, wrongCount);
+		CHECK(FrameAllocator<uint32_t>(arena) == values.get_allocator());
+	}
+	arena.Reset();
+	CHECK(arena.LastFrameStats().allocationCount > 1);
+	CHECK(arena.LastFrameStats().allocatedBytes >= 10000 * sizeof(uint64_t));
+}
+
+TEST_CASE(FrameArena, ManyArenasOnOneThread)
+{
+	// XbhƂ̃J[\̐葽A[i݂ɎgĂAʁẌ̗ɂȂ
+	constexpr size_t kArenaCount = 9;
+	std::vector<std::unique_ptr<FrameArena>> arenas;
+	for (size_t i = 0; i < kArenaCount; ++i) {
+		arenas.emplace_back(new FrameArena(4096));
+	}
+	std::vector<Range> ranges;
+	for (size_t round = 0; round < 50; ++round) {
+		for (size_t i = 0; i < kArenaCount; ++i) {
+			const uintptr_t begin = reinterpret_cast<uintptr_t>(arenas[i]->Allocate(48, 16));
+			ranges.push_back({ begin, begin + 48 });
+		}
+	}
+	CHECK_EQ(0u, CountOverlaps(ranges));
+	for (const std::unique_ptr<FrameArena>& arena : arenas) {
+		arena->Reset();
+		CHECK_EQ(50u, arena->LastFrameStats().allocationCount);
+	}
+}
+
+TEST_CASE(FrameArena, ThreadsNeverShareMemory)
+{
+	constexpr size_t kThreadCount = 8;
+	constexpr size_t kAllocationCount = 5000;
+	FrameArena arena(16 * 1024);
+	std::vector<std::vector<Range>> ranges(kThreadCount);
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < kThreadCount; ++t) {
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < kAllocationCount; ++i) {
+				// Ƃǂ`N 1/4 𒴂傫
+				const size_t size = i % 97 == 0 ? 6000 : 8 + (i * 13 + t) % 120;
+				uint8_t* pointer = static_cast<uint8_t*>(arena.Allocate(size, 8));
+				std::fill(pointer, pointer + size, FillValue(t, i));
+				ranges[t].push_back({ reinterpret_cast<uintptr_t>(pointer), reinterpret_cast<uintptr_t>(pointer) + size });
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	// ̃Xbhɏ㏑ĂȂ
+	size_t corruptedCount = 0;
+	std::vector<Range> allRanges;
+	for (size_t t = 0; t < kThreadCount; ++t) {
+		for (size_t i = 0; i < kAllocationCount; ++i) {
+			const Range& range = ranges[t][i];
+			const uint8_t* pointer = reinterpret_cast<const uint8_t*>(range.first);
+			const uint8_t expected = FillValue(t, i);
+			corruptedCount += std::all_of(pointer, pointer + (range.second - range.first), [=](uint8_t value) { return value == expected; }) ? 0 : 1;
+			allRanges.push_back(range);
+		}
+	}
+	CHECK_EQ(0u, corruptedCount);
+	CHECK_EQ(0u, CountOverlaps(allRanges));
+
+	arena.Reset();
+	CHECK_EQ(kThreadCount * kAllocationCount, arena.LastFrameStats().allocationCount);
+}
+
+TEST_CASE(FrameArena, ResetBetweenFramesOnWorkerThreads)
+{
+	// [J[͍ςȂŁAt[Ƃ Reset B[J[̃J[\͑O̐̂܂܎cĂ
+	constexpr size_t kFrameCount = 200;
+	constexpr size_t kJobCount = 64;
+	constexpr size_t kAllocationsPerJob = 100;
+	JobSystem::Options options;
+	options.workerCount = (std::max)(std::thread::hardware_concurrency(), 4u);
+	JobSystem jobSystem(options);
+	FrameArena arena(8 * 1024);
+
+	size_t corruptedFrameCount = 0;
+	size_t wrongStatsFrameCount = 0;
+	std::vector<std::vector<Range>> ranges(kJobCount);
+	for (size_t frame = 0; frame < kFrameCount; ++frame) {
+		jobSystem.ParallelFor(kJobCount, 1, [&](size_t begin, size_t end) {
+			for (size_t job = begin; job < end; ++job) {
+				ranges[job].clear();
+				for (size_t i = 0; i < kAllocationsPerJob; ++i) {
+					const size_t size = 16 + (frame + job + i) % 64;
+					uint8_t* pointer = static_cast<uint8_t*>(arena.Allocate(size, 16));
+					std::fill(pointer, pointer + size, FillValue(job, frame + i));
+					ranges[job].push_back({ reinterpret_cast<uintptr_t>(pointer), reinterpret_cast<uintptr_t>(pointer) + size });
+				}
+			}
+		});
+
+		std::vector<Range> allRanges;
+		bool corrupted = false;
+		uint64_t allocatedBytes = 0;
+		for (size_t job = 0; job < kJobCount; ++job) {
+			for (size_t i = 0; i < kAllocationsPerJob; ++i) {
+				const Range& range = ranges[job][i];
+				allocatedBytes += range.second - range.first;
+				const uint8_t* pointer = reinterpret_cast<const uint8_t*>(range.first);
+				const uint8_t expected = FillValue(job, frame + i);
+				corrupted |= !std::all_of(pointer, pointer + (range.second - range.first), [=](uint8_t value) { return value == expected; });
+				allRanges.push_back(range);
+			}
+		}
+		corruptedFrameCount += corrupted || CountOverlaps(allRanges) != 0 ? 1 : 0;
+
+		// Wv͂̃t[̕ŁAÕt[̃ubNȂ
+		arena.Reset();
+		const FrameArena::Stats& stats = arena.LastFrameStats();
+		wrongStatsFrameCount += stats.allocationCount != kJobCount * kAllocationsPerJob || stats.allocatedBytes != allocatedBytes ? 1 : 0;
+	}
+	CHECK_EQ(0u, corruptedFrameCount);
+	CHECK_EQ(0u, wrongStatsFrameCount);
+}
+
+#ifdef _DEBUG
+TEST_CASE(FrameArena, DebugPoisoning)
+{
+	FrameArena arena(4096);
+	uint8_t* pointer = static_cast<uint8_t*>(arena.Allocate(64, 16));
+	CHECK(std::all_of(pointer, pointer + 64, [](uint8_t value) { return value == 0xCD; }));
+	std::fill(pointer, pointer + 64, static_cast<uint8_t>(0));
+	arena.Reset();
+	// ̂Ă`N͂܂Ă̂œǂ߂
+	CHECK(std::all_of(pointer, pointer + 64, [](uint8_t value) { return value == 0xDD; }));
+}
+#endif // _DEBUG
@@ -0,0 +1,66 @@
+#include "FrameCapture.h"
+
+#include <vector>
+
+#include "NullCommandRecorder.h"
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	constexpr uint32_t kDrawCount = 100;
+
+	std::vector<uint8_t> CaptureSyntheticFrame()
+	{
+		CaptureRecorder capture(nullptr);
+		CreateSyntheticScene(capture);
+		RecordSyntheticFrame(capture, kDrawCount);
+		return capture.Bytes();
+	}
+}
+
+TEST_CASE(FrameCapture, SameCallsProduceSameBytes)
+{
+	CHECK(CaptureSyntheticFrame() == CaptureSyntheticFrame());
+}
+
+TEST_CASE(FrameCapture, ReplayIntoValidatingNullRecorder)
+{
+	const std::vector<uint8_t> bytes = CaptureSyntheticFrame();
+	NullCommandRecorder recorder(true);
+	ReplayReport report;
+	REQUIRE(ReplayCapture(bytes, recorder, report));
+	CHECK_EQ(0u, recorder.ErrorCount());
+	CHECK_EQ(static_cast<uint64_t>(kDrawCount), recorder.Stats(CaptureCommand::DrawIndexedInstanced).count);
+	CHECK_EQ(1u, recorder.Stats(CaptureCommand::ClearDepth).count);
+	CHECK_EQ(report.commandCount, recorder.TotalCalls());
+}
+
+TEST_CASE(FrameCapture, CaptureThroughInnerMatchesDirectRecording)
+{
+	// ȂnłAĂяo󂯎
+	NullCommandRecorder direct;
+	CreateSyntheticScene(direct);
+	RecordSyntheticFrame(direct, kDrawCount);
+
+	NullCommandRecorder inner;
+	CaptureRecorder capture(&inner);
+	CreateSyntheticScene(capture);
+	RecordSyntheticFrame(capture, kDrawCount);
+
+	CHECK_EQ(direct.TotalCalls(), inner.TotalCalls());
+	CHECK_EQ(direct.TotalBytes(), inner.TotalBytes());
+}
+
+TEST_CASE(FrameCapture, TruncatedCaptureIsRejected)
+{
+	std::vector<uint8_t> bytes = CaptureSyntheticFrame();
+	bytes.resize(bytes.size() - 3);
+	NullCommandRecorder recorder;
+	ReplayReport report;
+	CHECK(!ReplayCapture(bytes, recorder, report));
+
+	std::vector<uint8_t> wrongMagic = CaptureSyntheticFrame();
+	wrongMagic[0] ^= 0xff;
+	CHECK(!ReplayCapture(wrongMagic, recorder, report));
+}
@@ -0,0 +1,217 @@
+#include "FramePipeline.h"
+
+#include "QueueTimelineSimulator.h"
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	using Work = QueueTimelineSimulator::Work;
+	using Event = QueueTimelineSimulator::Event;
+
+	QueueTimelineSimulator::Durations MakeDurations(double graphics, double postProcess, double present)
+	{
+		QueueTimelineSimulator::Durations durations;
+		durations.graphics = graphics;
+		durations.postProcess = postProcess;
+		durations.present = present;
+		return durations;
+	}
+
+	// frameCount t[i߂āAŌ Flush BL^ cpuMilliseconds 邱Ƃɂ
+	void RunFrames(FramePipeline& pipeline, QueueTimelineSimulator& simulator, uint64_t frameCount, double cpuMilliseconds)
+	{
+		for (uint64_t frame = 0; frame < frameCount; ++frame) {
+			bool reused = false;
+			const uint32_t slot = pipeline.BeginFrame(reused);
+			CHECK_EQ(static_cast<uint32_t>(frame % pipeline.FramesInFlight()), slot);
+			CHECK_EQ(frame >= pipeline.FramesInFlight(), reused);
+			simulator.AdvanceCpu(cpuMilliseconds);
+			REQUIRE(pipeline.EndFrame());
+		}
+		REQUIRE(pipeline.Flush());
+	}
+
+	// t[̏̏ƁAXbgg񂷂ƂɑÕt[ƏdȂȂƂm߂
+	void CheckDependencies(const QueueTimelineSimulator& simulator, uint32_t framesInFlight, uint64_t frameCount)
+	{
+		CHECK_EQ(0u, simulator.InvalidWaitCount());
+		for (uint64_t frame = 0; frame < frameCount; ++frame) {
+			const Event* graphics = simulator.Find(Work::Graphics, frame);
+			const Event* postProcess = simulator.Find(Work::PostProcess, frame);
+			const Event* present = simulator.Find(Work::Present, frame);
+			REQUIRE(graphics != nullptr && postProcess != nullptr && present != nullptr);
+			CHECK(graphics->slot == postProcess->slot && postProcess->slot == present->slot);
+			// HDR ^[Qbg`IĂ|XgvZXAo͂łĂ Present 
+			CHECK(postProcess->startTime >= graphics->endTime);
+			CHECK(present->startTime >= postProcess->endTime);
+			if (frame > 0) {
+				CHECK(present->startTime >= simulator.Find(Work::Present, frame - 1)->endTime);
+			}
+
+			// Xbg̎̃t[́Ãt[ Present IĂL^n߂
+			const Event* next = simulator.Find(Work::Graphics, frame + framesInFlight);
+			if (next != nullptr) {
+				CHECK_EQ(graphics->slot, next->slot);
+				CHECK(next->submitTime >= present->endTime);
+				CHECK(next->startTime >= postProcess->endTime);
+			}
+		}
+	}
+
+	bool Overlaps(const Event& a, const Event& b)
+	{
+		return a.startTime < b.endTime && b.startTime < a.endTime;
+	}
+}
+
+TEST_CASE(FramePipeline, PostProcessOverlapsTheNextFramesGraphics)
+{
+	QueueTimelineSimulator simulator(MakeDurations(10.0, 6.0, 0.5));
+	FramePipeline pipeline(simulator, 2);
+	RunFrames(pipeline, simulator, 20, 1.0);
+	CheckDependencies(simulator, 2, 20);
+
+	for (uint64_t frame = 2; frame + 1 < 20; ++frame) {
+		CHECK(Overlaps(*simulator.Find(Work::PostProcess, frame), *simulator.Find(Work::Graphics, frame + 1)));
+	}
+}
+
+TEST_CASE(FramePipeline, RespectsDependenciesForAnyNumberOfFramesInFlight)
+{
+	const QueueTimelineSimulator::Durations cases[] = {
+		// GPU dE|XgvZXdECPU d( cpuMilliseconds)
+		MakeDurations(10.0, 4.0, 0.5),
+		MakeDurations(3.0, 12.0, 0.5),
+		MakeDurations(1.0, 1.0, 0.1),
+	};
+	for (uint32_t framesInFlight = 2; framesInFlight <= 4; ++framesInFlight) {
+		for (const auto& durations : cases) {
+			QueueTimelineSimulator simulator(durations);
+			FramePipeline pipeline(simulator, framesInFlight);
+			RunFrames(pipeline, simulator, 30, 5.0);
+			CheckDependencies(simulator, framesInFlight, 30);
+		}
+	}
+}
+
+TEST_CASE(FramePipeline, FrameTimeIsBoundByTheSlowerQueue)
+{
+	// `L[͕` Present  10.5msARs[gL[ 8msBȂ 18.5ms 
+	QueueTimelineSimulator simulator(MakeDurations(10.0, 8.0, 0.5));
+	FramePipeline pipeline(simulator, 3);
+	RunFrames(pipeline, simulator, 40, 1.0);
+
+	// Ō Present  Flush Őςނ̂ŁAr̋Ԃő
+	const double interval = (simulator.Find(Work::Present, 30)->endTime - simulator.Find(Work::Present, 10)->endTime) / 20.0;
+	CHECK_NEAR(10.5, interval, 0.01);
+
+	// 2 XbgƁAL^ĂԂ͕`L[
+	QueueTimelineSimulator twoSlots(MakeDurations(10.0, 8.0, 0.5));
+	FramePipeline twoSlotsPipeline(twoSlots, 2);
+	RunFrames(twoSlotsPipeline, twoSlots, 40, 1.0);
+	const double twoSlotsInterval = (twoSlots.Find(Work::Present, 30)->endTime - twoSlots.Find(Work::Present, 10)->endTime) / 20.0;
+	CHECK(twoSlotsInterval > interval);
+	CHECK(twoSlotsInterval < 18.5);
+
+	// |XgvZXd΂Ō܂
+	QueueTimelineSimulator postProcessBound(MakeDurations(4.0, 9.0, 0.5));
+	FramePipeline postProcessBoundPipeline(postProcessBound, 3);
+	RunFrames(postProcessBoundPipeline, postProcessBound, 40, 1.0);
+	const double postProcessInterval =
+		(postProcessBound.Find(Work::Present, 30)->endTime - postProcessBound.Find(Work::Present, 10)->endTime) / 20.0;
+	CHECK_NEAR(9.0, postProcessInterval, 0.01);
+}
+
+TEST_CASE(FramePipeline, CpuOnlyWaitsWhenItRunsOutOfSlots)
+{
+	// CPU ̕x΁AXbg҂Ƃ͂Ȃ
+	QueueTimelineSimulator cpuBound(MakeDurations(2.0, 2.0, 0.5));
+	FramePipeline cpuBoundPipeline(cpuBound, 3);
+	RunFrames(cpuBoundPipeline, cpuBound, 20, 8.0);
+	CHECK_NEAR(8.0 * 20, cpuBound.CpuTime() - cpuBound.CpuWaitTime(), 1e-9);
+	// Ō Flush ő҂
+	CHECK(cpuBound.CpuWaitTime() < 8.0);
+
+	// GPU ̕x΁ACPU  framesInFlight t[ɂ͐i܂Ȃ
+	QueueTimelineSimulator gpuBound(MakeDurations(10.0, 2.0, 0.5));
+	FramePipeline gpuBoundPipeline(gpuBound, 3);
+	for (uint64_t frame = 0; frame < 20; ++frame) {
+		bool reused = false;
+		gpuBoundPipeline.BeginFrame(reused);
+		if (frame >= 3) {
+			// frame - 3  Present I܂ő҂Ă
+			CHECK(gpuBound.CpuTime() >= gpuBound.Find(Work::Present, frame - 3)->endTime);
+		}
+		gpuBound.AdvanceCpu(1.0);
+		REQUIRE(gpuBoundPipeline.EndFrame());
+	}
+	CHECK(gpuBound.CpuWaitTime() > 0.0);
+}
+
+TEST_CASE(FramePipeline, PresentsOneFrameLateAndFlushPresentsTheRest)
+{
+	QueueTimelineSimulator simulator(MakeDurations(1.0, 1.0, 0.5));
+	FramePipeline pipeline(simulator, 2);
+	bool reused = false;
+
+	pipeline.BeginFrame(reused);
+	REQUIRE(pipeline.EndFrame());
+	CHECK(simulator.Find(Work::Present, 0) == nullptr);
+
+	pipeline.BeginFrame(reused);
+	REQUIRE(pipeline.EndFrame());
+	// t[ 1 ̕`ς񂾂ƂɃt[ 0  Present 
+	const Event* present = simulator.Find(Work::Present, 0);
+	REQUIRE(present != nullptr);
+	CHECK(present->fenceValue > simulator.Find(Work::Graphics, 1)->fenceValue);
+	CHECK(simulator.Find(Work::Present, 1) == nullptr);
+
+	REQUIRE(pipeline.Flush());
+	REQUIRE(simulator.Find(Work::Present, 1) != nullptr);
+	CHECK(simulator.CpuTime() >= simulator.Find(Work::Present, 1)->endTime);
+	CHECK(simulator.CpuTime() >= simulator.Find(Work::PostProcess, 1)->endTime);
+
+	// Ȃ Flush Ăς܂Ȃ
+	const size_t eventCount = simulator.Events().size();
+	REQUIRE(pipeline.Flush());
+	CHECK_EQ(eventCount, simulator.Events().size());
+}
+
+TEST_CASE(FramePipeline, WaitForDirectQueueLeavesThePresentPending)
+{
+	QueueTimelineSimulator simulator(MakeDurations(4.0, 6.0, 0.5));
+	FramePipeline pipeline(simulator, 3);
+	bool reused = false;
+	for (int frame = 0; frame < 2; ++frame) {
+		pipeline.BeginFrame(reused);
+		REQUIRE(pipeline.EndFrame());
+	}
+	pipeline.WaitForDirectQueue();
+	// t[ 1 ̕`ƃt[ 0  Present ͏IĂ邪At[ 1 ̃|XgvZX͑҂Ȃ
+	CHECK(simulator.CpuTime() >= simulator.Find(Work::Graphics, 1)->endTime);
+	CHECK(simulator.CpuTime() >= simulator.Find(Work::Present, 0)->endTime);
+	CHECK(simulator.CpuTime() < simulator.Find(Work::PostProcess, 1)->endTime);
+	CHECK(simulator.Find(Work::Present, 1) == nullptr);
+}
+
+TEST_CASE(FramePipeline, BeginFrameWithoutEndFrameKeepsTheSlot)
+{
+	QueueTimelineSimulator simulator(MakeDurations(1.0, 1.0, 0.5));
+	FramePipeline pipeline(simulator, 2);
+	bool reused = false;
+	CHECK_EQ(0u, pipeline.BeginFrame(reused));
+	// L^ɎsĂ߂
+	CHECK_EQ(0u, pipeline.BeginFrame(reused));
+	REQUIRE(pipeline.EndFrame());
+	CHECK_EQ(1u, pipeline.BeginFrame(reused));
+}
+
+TEST_CASE(FramePipeline, NeedsAtLeastTwoSlots)
+{
+	QueueTimelineSimulator simulator(MakeDurations(1.0, 1.0, 0.5));
+	FramePipeline pipeline(simulator, 1);
+	CHECK_EQ(2u, pipeline.FramesInFlight());
+	RunFrames(pipeline, simulator, 10, 0.5);
+	CheckDependencies(simulator, 2, 10);
+}
@@ -0,0 +1,299 @@
+#include "HotReload.h"
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#endif // __linux__
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	using Clock = HotReloader::Clock;
+	using Assets = std::set<HotReloadAssetId>;
+
+	PathString Path(const std::string& path)
+	{
+		return PathString(path.begin(), path.end());
+	}
+
+	// ̃t@CBۑ邽тɎi߂
+	class FakeFileSource : public FileSource
+	{
+	public:
+		void Write(const std::string& path, const std::string& text)
+		{
+			File& file = m_files[Path(path)];
+			file.text = text;
+			file.lastWriteTime = ++m_clock;
+		}
+		void Remove(const std::string& path)
+		{
+			m_files.erase(Path(path));
+		}
+
+		bool GetLastWriteTime(const PathString& path, FileTimestamp& timestamp) const override
+		{
+			const auto file = m_files.find(path);
+			if (file == m_files.end()) {
+				return false;
+			}
+			timestamp = file->second.lastWriteTime;
+			return true;
+		}
+		bool ReadText(const PathString& path, std::string& text) const override
+		{
+			const auto file = m_files.find(path);
+			if (file == m_files.end()) {
+				return false;
+			}
+			text = file->second.text;
+			return true;
+		}
+
+	private:
+		struct File
+		{
+			std::string text;
+			FileTimestamp lastWriteTime;
+		};
+		std::map<PathString, File> m_files;
+		FileTimestamp m_clock = 0;
+	};
+
+	// *pendingNotifications  0 łȂΒʒmƂɂ
+	class FakeFileWatcher : public FileWatcher
+	{
+	public:
+		explicit FakeFileWatcher(int* pendingNotifications) : m_pendingNotifications(pendingNotifications) {}
+
+		bool AddWatchDirectory(const PathString&) override { return true; }
+		bool ConsumeNotifications() override
+		{
+			const bool notified = *m_pendingNotifications > 0;
+			*m_pendingNotifications = 0;
+			return notified;
+		}
+
+	private:
+		int* m_pendingNotifications;
+	};
+
+	enum : HotReloadAssetId {
+		kVertexShader,
+		kPixelShader,
+		kTexture,
+	};
+
+	void WriteShaders(FakeFileSource& files)
+	{
+		files.Write("shaders/Vertex.hlsl", "#include \"Common.hlsli\"\nfloat4 main() : SV_POSITION { return 0; }\n");
+		files.Write("shaders/Pixel.hlsl", "#include \"Common.hlsli\"\n#include \"lib/Lighting.hlsli\"\n");
+		files.Write("shaders/Common.hlsli", "cbuffer Scene : register(b0) { float4x4 mat; };\n");
+		files.Write("shaders/lib/Lighting.hlsli", "#include \"Brdf.hlsli\"\n");
+		files.Write("shaders/lib/Brdf.hlsli", "float D() { return 1; }\n");
+	}
+}
+
+TEST_CASE(HotReload, TracksNestedIncludesRelativeToTheIncludingFile)
+{
+	FakeFileSource files;
+	WriteShaders(files);
+	DependencyTracker tracker;
+	tracker.RegisterAsset(kVertexShader, Path("shaders/Vertex.hlsl"), true, files);
+	tracker.RegisterAsset(kPixelShader, Path("shaders/Pixel.hlsl"), true, files);
+
+	CHECK(tracker.Dependents(Path("shaders/Common.hlsli")) == Assets({ kVertexShader, kPixelShader }));
+	CHECK(tracker.Dependents(Path("shaders/lib/Brdf.hlsli")) == Assets({ kPixelShader }));
+	CHECK(tracker.Dependents(Path("shaders/Brdf.hlsli")).empty());
+	CHECK(tracker.CollectChanges(files, true).empty());
+
+	//  include ̕ύXŁAgVF[_[ς
+	files.Write("shaders/lib/Brdf.hlsli", "float D() { return 2; }\n");
+	CHECK(tracker.CollectChanges(files, true) == Assets({ kPixelShader }));
+	CHECK(tracker.CollectChanges(files, true).empty());
+
+	// Lwb_[̕ύXŗς
+	files.Write("shaders/Common.hlsli", "cbuffer Scene : register(b1) { float4x4 mat; };\n");
+	CHECK(tracker.CollectChanges(files, true) == Assets({ kVertexShader, kPixelShader }));
+}
+
+TEST_CASE(HotReload, FollowsIncludesOnlyWhenAsked)
+{
+	FakeFileSource files;
+	WriteShaders(files);
+	files.Write("img/texture.png", "#include \"Common.hlsli\"");
+	DependencyTracker tracker;
+	tracker.RegisterAsset(kTexture, Path("img/texture.png"), false, files);
+
+	CHECK(tracker.Dependents(Path("img/texture.png")) == Assets({ kTexture }));
+	CHECK(tracker.Dependents(Path("img/Common.hlsli")).empty());
+}
+
+TEST_CASE(HotReload, SurvivesIncludeCycles)
+{
+	FakeFileSource files;
+	files.Write("A.hlsl", "#include \"B.hlsli\"\n");
+	files.Write("B.hlsli", "#include \"C.hlsli\"\n");
+	files.Write("C.hlsli", "#include \"B.hlsli\"\n#include \"A.hlsl\"\n");
+	DependencyTracker tracker;
+	tracker.RegisterAsset(kPixelShader, Path("A.hlsl"), true, files);
+
+	CHECK(tracker.Dependents(Path("C.hlsli")) == Assets({ kPixelShader }));
+	files.Write("C.hlsli", "#include \"B.hlsli\"\n");
+	CHECK(tracker.CollectChanges(files, true) == Assets({ kPixelShader }));
+	CHECK(tracker.Dependents(Path("C.hlsli")) == Assets({ kPixelShader }));
+}
+
+TEST_CASE(HotReload, ReparsesIncludesOfChangedAssets)
+{
+	FakeFileSource files;
+	WriteShaders(files);
+	DependencyTracker tracker;
+	tracker.RegisterAsset(kVertexShader, Path("shaders/Vertex.hlsl"), true, files);
+
+	// include tւƁAOt@C͊ĎOAt@CĎ
+	files.Write("shaders/Vertex.hlsl", "#include \"lib/Brdf.hlsli\"\n");
+	CHECK(tracker.CollectChanges(files, true) == Assets({ kVertexShader }));
+	CHECK(tracker.Dependents(Path("shaders/Common.hlsli")).empty());
+	CHECK(tracker.Dependents(Path("shaders/lib/Brdf.hlsli")) == Assets({ kVertexShader }));
+
+	files.Write("shaders/Common.hlsli", "// changed\n");
+	CHECK(tracker.CollectChanges(files, true).empty());
+	files.Write("shaders/lib/Brdf.hlsli", "// changed\n");
+	CHECK(tracker.CollectChanges(files, true) == Assets({ kVertexShader }));
+}
+
+TEST_CASE(HotReload, PicksUpIncludesCreatedLater)
+{
+	FakeFileSource files;
+	files.Write("Pixel.hlsl", "#include \"Missing.hlsli\"\n");
+	DependencyTracker tracker;
+	tracker.RegisterAsset(kPixelShader, Path("Pixel.hlsl"), true, files);
+
+	// ƂƂȂt@ĆAȂĂ҂ɂȂ(łƂɒʒm)
+	CHECK(tracker.CollectChanges(files, true).empty());
+	CHECK(!tracker.HasPendingFiles());
+
+	files.Write("Missing.hlsli", "float4 c;\n");
+	CHECK(tracker.CollectChanges(files, true) == Assets({ kPixelShader }));
+}
+
+TEST_CASE(HotReload, RetriesFilesWhoseTimestampCouldNotBeRead)
+{
+	FakeFileSource files;
+	WriteShaders(files);
+	int notifications = 0;
+	HotReloader reloader(std::unique_ptr<FileWatcher>(new FakeFileWatcher(&notifications)), files, Clock::duration::zero());
+	reloader.RegisterAsset(kVertexShader, Path("shaders/Vertex.hlsl"), true);
+	const Clock::time_point start;
+
+	// ۑ̓r(ď)ɒʒm󂯎
+	files.Remove("shaders/Common.hlsli");
+	++notifications;
+	CHECK(reloader.Poll(start).empty());
+
+	// ʒm͂ȂA҂ɂȂĂt@C͒גĕύXE
+	files.Write("shaders/Common.hlsli", "// saved\n");
+	CHECK(reloader.Poll(start + std::chrono::milliseconds(1)) == Assets({ kVertexShader }));
+	CHECK(reloader.Poll(start + std::chrono::milliseconds(2)).empty());
+}
+
+TEST_CASE(HotReload, IgnoresNotificationsForUnrelatedFiles)
+{
+	FakeFileSource files;
+	WriteShaders(files);
+	int notifications = 0;
+	HotReloader reloader(std::unique_ptr<FileWatcher>(new FakeFileWatcher(&notifications)), files, Clock::duration::zero());
+	reloader.RegisterAsset(kVertexShader, Path("shaders/Vertex.hlsl"), true);
+
+	files.Write("shaders/Unrelated.hlsl", "");
+	++notifications;
+	CHECK(reloader.Poll(Clock::time_point()).empty());
+}
+
+TEST_CASE(HotReload, SchedulerWaitsForChangesToSettle)
+{
+	ReloadScheduler scheduler(std::chrono::milliseconds(100));
+	const Clock::time_point start;
+
+	scheduler.OnChanged({ kVertexShader }, start);
+	CHECK(scheduler.Update(start + std::chrono::milliseconds(50)).empty());
+	// ĕۑƑ҂
+	scheduler.OnChanged({ kVertexShader, kPixelShader }, start + std::chrono::milliseconds(80));
+	CHECK(scheduler.Update(start + std::chrono::milliseconds(120)).empty());
+	CHECK(scheduler.HasPendingAssets());
+	CHECK(scheduler.Update(start + std::chrono::milliseconds(180)) == Assets({ kVertexShader, kPixelShader }));
+	CHECK(!scheduler.HasPendingAssets());
+	CHECK(scheduler.Update(start + std::chrono::milliseconds(500)).empty());
+}
+
+TEST_CASE(HotReload, CoalescesBurstsOfSavesIntoOneReload)
+{
+	FakeFileSource files;
+	WriteShaders(files);
+	int notifications = 0;
+	HotReloader reloader(std::unique_ptr<FileWatcher>(new FakeFileWatcher(&notifications)), files, std::chrono::milliseconds(100));
+	reloader.RegisterAsset(kVertexShader, Path("shaders/Vertex.hlsl"), true);
+	reloader.RegisterAsset(kPixelShader, Path("shaders/Pixel.hlsl"), true);
+	const Clock::time_point start;
+
+	int reloads = 0;
+	for (int frame = 0; frame < 30; ++frame) {
+		const Clock::time_point now = start + std::chrono::milliseconds(16 * frame);
+		// ŏ 5 t[͖t[ۑ
+		if (frame < 5) {
+			files.Write("shaders/Common.hlsli", "// save " + std::to_string(frame) + "\n");
+			++notifications;
+		}
+		const Assets ready = reloader.Poll(now);
+		if (!ready.empty()) {
+			++reloads;
+			CHECK(ready == Assets({ kVertexShader, kPixelShader }));
+			// Ō̕ۑ(t[ 4 = 64ms) 100ms Ă
+			CHECK(now - start >= std::chrono::milliseconds(164));
+		}
+	}
+	CHECK_EQ(1, reloads);
+}
+
+#ifdef __linux__
+TEST_CASE(HotReload, InotifyWatcherReportsWrites)
+{
+	char directoryTemplate[] = "/tmp/yuxx_hot_reload_XXXXXX";
+	REQUIRE(mkdtemp(directoryTemplate) != nullptr);
+	const std::string directory = directoryTemplate;
+	const std::string path = directory + "/Shader.hlsl";
+	std::ofstream(path) << "float4 a;\n";
+
+	const DiskFileSource files;
+	HotReloader reloader(CreateFileWatcher(), files, Clock::duration::zero());
+	REQUIRE(reloader.AddWatchDirectory(directory));
+	reloader.RegisterAsset(kPixelShader, path, true);
+	CHECK(reloader.Poll(Clock::now()).empty());
+
+	// ̕\et@CVXełς悤ɁA𖾎Iɐi߂
+	struct stat status;
+	REQUIRE(stat(path.c_str(), &status) == 0);
+	std::ofstream(path) << "float4 b;\n";
+	timespec times[2] = { status.st_atim, status.st_mtim };
+	times[1].tv_sec += 1;
+	REQUIRE(utimensat(AT_FDCWD, path.c_str(), times, 0) == 0);
+	CHECK(reloader.Poll(Clock::now()) == Assets({ kPixelShader }));
+	CHECK(reloader.Poll(Clock::now()).empty());
+
+	std::remove(path.c_str());
+	rmdir(directory.c_str());
+}
+#endif // __linux__
@@ -0,0 +1,598 @@
+#include "ImageCodec.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <jpeglib.h>
+#include <png.h>
+
+#include "JobSystem.h"
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+// ÕfR[_[ libjpeg / libpng Ɠ˂킹BCMake ŗƂrh
+namespace {
+	constexpr size_t kBytesPerPixel = 4;
+
+	// ܂悤 16 ̔{łȂ傫ɂ
+	constexpr uint32_t kWidth = 173;
+	constexpr uint32_t kHeight = 91;
+
+	// Ȃ߂炩Ȗ͗lɎG𑫂 RGBB炷 DCT ̊ۂ߂̍oȂ
+	std::vector<uint8_t> MakeRgbPattern(uint32_t width, uint32_t height)
+	{
+		std::mt19937 random(42);
+		std::uniform_int_distribution<int> noise(-24, 24);
+		std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+		for (uint32_t y = 0; y < height; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				uint8_t* pixel = pixels.data() + (static_cast<size_t>(y) * width + x) * 3;
+				const int values[3] = {
+					static_cast<int>(x * 255 / width),
+					static_cast<int>(y * 255 / height),
+					(x / 8 + y / 8) % 2 == 0 ? 200 : 40,
+				};
+				for (int c = 0; c < 3; ++c) {
+					pixel[c] = static_cast<uint8_t>((std::min)((std::max)(values[c] + noise(random), 0), 255));
+				}
+			}
+		}
+		return pixels;
+	}
+
+	struct JpegSettings
+	{
+		int components = 3;
+		// Px̕W{W(F 1x1)B2x2 Ȃ 4:2:0
+		int horizontalSampling = 2;
+		int verticalSampling = 2;
+		unsigned int restartInterval = 0;
+		bool progressive = false;
+		// APP1 ɓ EXIF("Exif\0\0" )
+		std::vector<uint8_t> exif;
+	};
+
+	std::vector<uint8_t> EncodeJpeg(const std::vector<uint8_t>& rgb, uint32_t width, uint32_t height, const JpegSettings& settings)
+	{
+		jpeg_compress_struct compress;
+		jpeg_error_mgr error;
+		compress.err = jpeg_std_error(&error);
+		jpeg_create_compress(&compress);
+		unsigned char* buffer = nullptr;
+		unsigned long bufferSize = 0;
+		jpeg_mem_dest(&compress, &buffer, &bufferSize);
+
+		compress.image_width = width;
+		compress.image_height = height;
+		compress.input_components = 3;
+		compress.in_color_space = JCS_RGB;
+		jpeg_set_defaults(&compress);
+		jpeg_set_quality(&compress, 85, TRUE);
+		if (settings.components == 1) {
+			jpeg_set_colorspace(&compress, JCS_GRAYSCALE);
+		} else {
+			compress.comp_info[0].h_samp_factor = settings.horizontalSampling;
+			compress.comp_info[0].v_samp_factor = settings.verticalSampling;
+		}
+		compress.restart_interval = settings.restartInterval;
+		if (settings.progressive) {
+			jpeg_simple_progression(&compress);
+		}
+
+		jpeg_start_compress(&compress, TRUE);
+		if (!settings.exif.empty()) {
+			jpeg_write_marker(&compress, JPEG_APP0 + 1, settings.exif.data(), static_cast<unsigned int>(settings.exif.size()));
+		}
+		while (compress.next_scanline < height) {
+			JSAMPROW row = const_cast<JSAMPROW>(rgb.data() + static_cast<size_t>(compress.next_scanline) * width * 3);
+			jpeg_write_scanlines(&compress, &row, 1);
+		}
+		jpeg_finish_compress(&compress);
+		jpeg_destroy_compress(&compress);
+
+		std::vector<uint8_t> jpeg(buffer, buffer + bufferSize);
+		free(buffer);
+		return jpeg;
+	}
+
+	// libjpeg ̊(JDCT_ISLOWEȂ߂炩ȈL΂) RGBA ɃfR[h
+	DecodedImage DecodeWithLibjpeg(const std::vector<uint8_t>& jpeg)
+	{
+		jpeg_decompress_struct decompress;
+		jpeg_error_mgr error;
+		decompress.err = jpeg_std_error(&error);
+		jpeg_create_decompress(&decompress);
+		jpeg_mem_src(&decompress, jpeg.data(), static_cast<unsigned long>(jpeg.size()));
+		jpeg_read_header(&decompress, TRUE);
+		decompress.out_color_space = JCS_RGB;
+		jpeg_start_decompress(&decompress);
+
+		DecodedImage image;
+		image.width = decompress.output_width;
+		image.height = decompress.output_height;
+		image.rowPitch = static_cast<size_t>(image.width) * kBytesPerPixel;
+		image.pixels.resize(image.rowPitch * image.height);
+		std::vector<uint8_t> row(static_cast<size_t>(image.width) * 3);
+		while (decompress.output_scanline < decompress.output_height) {
+			uint8_t* out = image.pixels.data() + decompress.output_scanline * image.rowPitch;
+			JSAMPROW rowPointer = row.data();
+			jpeg_read_scanlines(&decompress, &rowPointer, 1);
+			for (uint32_t x = 0; x < image.width; ++x) {
+				std::memcpy(out + x * kBytesPerPixel, row.data() + x * 3, 3);
+				out[x * kBytesPerPixel + 3] = 255;
+			}
+		}
+		jpeg_finish_decompress(&decompress);
+		jpeg_destroy_decompress(&decompress);
+		return image;
+	}
+
+	struct PngSettings
+	{
+		int colorType = PNG_COLOR_TYPE_RGB;
+		int bitDepth = 8;
+		bool interlaced = false;
+		bool transparency = false;
+		bool srgbChunk = false;
+		// 0 Ȃ gAMA `NȂ
+		png_fixed_point gamma = 0;
+	};
+
+	// Tv̒l͗ŁAsƂɃtB^[̎ނς
+	std::vector<uint8_t> EncodePng(uint32_t width, uint32_t height, const PngSettings& settings)
+	{
+		std::vector<uint8_t> output;
+		png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		png_infop info = png_create_info_struct(png);
+		png_set_write_fn(png, &output, [](png_structp png, png_bytep data, png_size_t size) {
+			std::vector<uint8_t>& output = *static_cast<std::vector<uint8_t>*>(png_get_io_ptr(png));
+			output.insert(output.end(), data, data + size);
+		}, nullptr);
+		png_set_IHDR(
+			png,
+			info,
+			width,
+			height,
+			settings.bitDepth,
+			settings.colorType,
+			settings.interlaced ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE,
+			PNG_COMPRESSION_TYPE_DEFAULT,
+			PNG_FILTER_TYPE_DEFAULT
+		);
+		png_set_filter(png, PNG_FILTER_TYPE_BASE, PNG_ALL_FILTERS);
+
+		std::mt19937 random(static_cast<uint32_t>(settings.colorType * 100 + settings.bitDepth));
+		const int paletteSize = 1 << (std::min)(settings.bitDepth, 8);
+		if (settings.colorType == PNG_COLOR_TYPE_PALETTE) {
+			std::vector<png_color> palette(paletteSize);
+			std::vector<png_byte> alpha(paletteSize);
+			for (int i = 0; i < paletteSize; ++i) {
+				palette[i] = { static_cast<png_byte>(random()), static_cast<png_byte>(random()), static_cast<png_byte>(random()) };
+				alpha[i] = static_cast<png_byte>(random());
+			}
+			png_set_PLTE(png, info, palette.data(), paletteSize);
+			if (settings.transparency) {
+				png_set_tRNS(png, info, alpha.data(), paletteSize / 2, nullptr);
+			}
+		} else if (settings.transparency) {
+			png_color_16 key = {};
+			key.gray = 1;
+			key.red = 1;
+			key.green = 2;
+			key.blue = 3;
+			png_set_tRNS(png, info, nullptr, 0, &key);
+		}
+		if (settings.srgbChunk) {
+			png_set_sRGB(png, info, PNG_sRGB_INTENT_PERCEPTUAL);
+		}
+		if (settings.gamma != 0) {
+			png_set_gAMA_fixed(png, info, settings.gamma);
+		}
+		png_write_info(png, info);
+
+		const size_t rowSize = png_get_rowbytes(png, info);
+		std::vector<uint8_t> rows(rowSize * height);
+		// Ȃ߂炩ȕƗ̕āAkɒvƒZvo悤ɂ
+		for (size_t i = 0; i < rows.size(); ++i) {
+			rows[i] = (i / 64) % 3 == 0 ? static_cast<uint8_t>(i / 7) : static_cast<uint8_t>(random());
+		}
+		// ߐFɓl
+		if (settings.transparency && settings.colorType != PNG_COLOR_TYPE_PALETTE) {
+			const int bytesPerSample = settings.bitDepth == 16 ? 2 : 1;
+			const int channels = settings.colorType == PNG_COLOR_TYPE_RGB ? 3 : 1;
+			for (uint32_t y = 0; y < height; y += 3) {
+				uint8_t* pixel = rows.data() + y * rowSize;
+				for (int c = 0; c < channels && settings.bitDepth >= 8; ++c) {
+					pixel[c * bytesPerSample] = 0;
+					pixel[c * bytesPerSample + bytesPerSample - 1] = static_cast<uint8_t>(c + 1);
+				}
+				if (settings.bitDepth < 8) {
+					pixel[0] = static_cast<uint8_t>(1 << (8 - settings.bitDepth));
+				}
+			}
+		}
+		std::vector<png_bytep> rowPointers(height);
+		for (uint32_t y = 0; y < height; ++y) {
+			rowPointers[y] = rows.data() + y * rowSize;
+		}
+		png_write_image(png, rowPointers.data());
+		png_write_end(png, nullptr);
+		png_destroy_write_struct(&png, &info);
+		return output;
+	}
+
+	// libpng ̕ϊ RGBA e8bit ɂB16bit ͏ 8bitA1/2/4bit ̃O[ 0`255 ɈL΂
+	DecodedImage DecodeWithLibpng(const std::vector<uint8_t>& data)
+	{
+		struct Reader
+		{
+			const std::vector<uint8_t>* data;
+			size_t position;
+		};
+		Reader reader = { &data, 0 };
+		png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		png_infop info = png_create_info_struct(png);
+		png_set_read_fn(png, &reader, [](png_structp png, png_bytep out, png_size_t size) {
+			Reader& reader = *static_cast<Reader*>(png_get_io_ptr(png));
+			std::memcpy(out, reader.data->data() + reader.position, size);
+			reader.position += size;
+		});
+		png_read_info(png, info);
+		png_set_expand(png);
+		png_set_strip_16(png);
+		png_set_gray_to_rgb(png);
+		png_set_filler(png, 0xFF, PNG_FILLER_AFTER);
+		png_set_interlace_handling(png);
+		png_read_update_info(png, info);
+
+		DecodedImage image;
+		image.width = png_get_image_width(png, info);
+		image.height = png_get_image_height(png, info);
+		image.rowPitch = png_get_rowbytes(png, info);
+		image.pixels.resize(image.rowPitch * image.height);
+		std::vector<png_bytep> rowPointers(image.height);
+		for (uint32_t y = 0; y < image.height; ++y) {
+			rowPointers[y] = image.pixels.data() + y * image.rowPitch;
+		}
+		png_read_image(png, rowPointers.data());
+		png_read_end(png, nullptr);
+		png_destroy_read_struct(&png, &info, nullptr);
+		return image;
+	}
+
+	// fƂ̍̍ő
+	int MaxDifference(const DecodedImage& expected, const DecodedImage& actual)
+	{
+		if (expected.width != actual.width || expected.height != actual.height) {
+			return 256;
+		}
+		int maxDifference = 0;
+		for (uint32_t y = 0; y < expected.height; ++y) {
+			const uint8_t* expectedRow = expected.pixels.data() + y * expected.rowPitch;
+			const uint8_t* actualRow = actual.pixels.data() + y * actual.rowPitch;
+			for (size_t x = 0; x < expected.width * kBytesPerPixel; ++x) {
+				maxDifference = (std::max)(maxDifference, std::abs(expectedRow[x] - actualRow[x]));
+			}
+		}
+		return maxDifference;
+	}
+
+	bool Decode(const std::vector<uint8_t>& data, DecodedImage& image, JobSystem* jobSystem = nullptr)
+	{
+		return DecodeImage(data.data(), data.size(), 1, image, jobSystem);
+	}
+
+	// IFD0  Exif IFD wA ColorSpace(0xA001)gGfBA EXIF
+	std::vector<uint8_t> MakeExif(uint16_t colorSpace)
+	{
+		const uint8_t exif[] = {
+			'E', 'x', 'i', 'f', 0, 0,
+			'I', 'I', 0x2A, 0, 8, 0, 0, 0,
+			// IFD0: ExifIFDPointer(LONG)= 26
+			1, 0, 0x69, 0x87, 4, 0, 1, 0, 0, 0, 26, 0, 0, 0, 0, 0, 0, 0,
+			// Exif IFD: ColorSpace(SHORT)
+			1, 0, 0x01, 0xA0, 3, 0, 1, 0, 0, 0,
+			static_cast<uint8_t>(colorSpace), static_cast<uint8_t>(colorSpace >> 8), 0, 0, 0, 0, 0, 0,
+		};
+		return std::vector<uint8_t>(exif, exif + sizeof(exif));
+	}
+
+	bool SameImage(const DecodedImage& a, const DecodedImage& b)
+	{
+		return a.width == b.width && a.height == b.height && a.rowPitch == b.rowPitch && a.pixels == b.pixels;
+	}
+}
+
+TEST_CASE(ImageCodec, JpegMatchesLibjpegForEachSampling)
+{
+	const std::vector<uint8_t> rgb = MakeRgbPattern(kWidth, kHeight);
+	struct Case
+	{
+		const char* name;
+		JpegSettings settings;
+	};
+	const Case cases[] = {
+		{ "4:4:4", { 3, 1, 1, 0, false } },
+		{ "4:2:2", { 3, 2, 1, 0, false } },
+		{ "4:2:0", { 3, 2, 2, 0, false } },
+		{ "4:4:0", { 3, 1, 2, 0, false } },
+		{ "gray", { 1, 1, 1, 0, false } },
+	};
+	for (const Case& testCase : cases) {
+		const std::vector<uint8_t> jpeg = EncodeJpeg(rgb, kWidth, kHeight, testCase.settings);
+		ImageInfo info;
+		REQUIRE(ReadImageInfo(jpeg.data(), jpeg.size(), info));
+		CHECK(info.type == ImageFileType::Jpeg);
+		CHECK_EQ(kWidth, info.width);
+		CHECK_EQ(kHeight, info.height);
+
+		DecodedImage image;
+		REQUIRE(Decode(jpeg, image));
+		// libjpeg ƓZȂ̂ňv͂
+		CHECK_EQ(std::string(testCase.name) + " 0", std::string(testCase.name) + " " + std::to_string(MaxDifference(DecodeWithLibjpeg(jpeg), image)));
+	}
+}
+
+TEST_CASE(ImageCodec, JpegRestartIntervalsDecodeInParallel)
+{
+	const std::vector<uint8_t> rgb = MakeRgbPattern(kWidth * 3, kHeight * 3);
+	JobSystem jobSystem;
+	// Ԃ MCU ̐s̓rŐ؂̂ƁAŌ̋ԂZȂ
+	const unsigned int intervals[] = { 1, 3, 7, 64 };
+	for (unsigned int restartInterval : intervals) {
+		JpegSettings settings;
+		settings.restartInterval = restartInterval;
+		const std::vector<uint8_t> jpeg = EncodeJpeg(rgb, kWidth * 3, kHeight * 3, settings);
+
+		DecodedImage serial;
+		DecodedImage parallel;
+		REQUIRE(Decode(jpeg, serial));
+		REQUIRE(Decode(jpeg, parallel, &jobSystem));
+		CHECK(SameImage(serial, parallel));
+		CHECK_EQ(0, MaxDifference(DecodeWithLibjpeg(jpeg), serial));
+	}
+}
+
+TEST_CASE(ImageCodec, JpegParallelRowsMatchSerial)
+{
+	// X^[g}[J[ȂƂ́At DCT ƐFϊɂ
+	const std::vector<uint8_t> rgb = MakeRgbPattern(kWidth * 4, kHeight * 4);
+	JobSystem jobSystem;
+	const std::vector<uint8_t> jpeg = EncodeJpeg(rgb, kWidth * 4, kHeight * 4, JpegSettings());
+	DecodedImage serial;
+	DecodedImage parallel;
+	REQUIRE(Decode(jpeg, serial));
+	REQUIRE(Decode(jpeg, parallel, &jobSystem));
+	CHECK(SameImage(serial, parallel));
+}
+
+TEST_CASE(ImageCodec, JpegRepositoryImagesMatchLibjpeg)
+{
+	const char* paths[] = {
+		"img/͌̋C.jpg",
+		"img/VhE~[h.jpg",
+		"img/eBt@.jpg",
+	};
+	JobSystem jobSystem;
+	for (const char* path : paths) {
+		std::vector<uint8_t> jpeg;
+		REQUIRE(ReadFileBytes(Test::SourcePath(path), jpeg));
+		DecodedImage image;
+		REQUIRE(Decode(jpeg, image, &jobSystem));
+		CHECK_EQ(0, MaxDifference(DecodeWithLibjpeg(jpeg), image));
+	}
+}
+
+TEST_CASE(ImageCodec, ProgressiveJpegIsLeftToTheFallback)
+{
+	JpegSettings settings;
+	settings.progressive = true;
+	const std::vector<uint8_t> jpeg = EncodeJpeg(MakeRgbPattern(32, 32), 32, 32, settings);
+	ImageInfo info;
+	CHECK(!ReadImageInfo(jpeg.data(), jpeg.size(), info));
+	DecodedImage image;
+	CHECK(!Decode(jpeg, image));
+}
+
+TEST_CASE(ImageCodec, PngMatchesLibpngForEveryFormat)
+{
+	struct Format
+	{
+		int colorType;
+		int bitDepth;
+	};
+	const Format formats[] = {
+		{ PNG_COLOR_TYPE_GRAY, 1 },
+		{ PNG_COLOR_TYPE_GRAY, 2 },
+		{ PNG_COLOR_TYPE_GRAY, 4 },
+		{ PNG_COLOR_TYPE_GRAY, 8 },
+		{ PNG_COLOR_TYPE_GRAY, 16 },
+		{ PNG_COLOR_TYPE_GRAY_ALPHA, 8 },
+		{ PNG_COLOR_TYPE_GRAY_ALPHA, 16 },
+		{ PNG_COLOR_TYPE_RGB, 8 },
+		{ PNG_COLOR_TYPE_RGB, 16 },
+		{ PNG_COLOR_TYPE_PALETTE, 1 },
+		{ PNG_COLOR_TYPE_PALETTE, 2 },
+		{ PNG_COLOR_TYPE_PALETTE, 4 },
+		{ PNG_COLOR_TYPE_PALETTE, 8 },
+		{ PNG_COLOR_TYPE_RGB_ALPHA, 8 },
+		{ PNG_COLOR_TYPE_RGB_ALPHA, 16 },
+	};
+	for (const Format& format : formats) {
+		for (int variant = 0; variant < 4; ++variant) {
+			PngSettings settings;
+			settings.colorType = format.colorType;
+			settings.bitDepth = format.bitDepth;
+			settings.interlaced = (variant & 1) != 0;
+			// ߐFĂ̂̓At@̂Ȃ`
+			settings.transparency = (variant & 2) != 0 && (format.colorType & PNG_COLOR_MASK_ALPHA) == 0;
+			// C^[[X̏pXɂȂ傫
+			const uint32_t width = variant == 3 ? 5 : kWidth;
+			const uint32_t height = variant == 3 ? 3 : kHeight;
+			const std::vector<uint8_t> png = EncodePng(width, height, settings);
+
+			ImageInfo info;
+			REQUIRE(ReadImageInfo(png.data(), png.size(), info));
+			CHECK(info.type == ImageFileType::Png);
+			DecodedImage image;
+			REQUIRE(Decode(png, image));
+			const std::string name = "type " + std::to_string(format.colorType) + " depth " + std::to_string(format.bitDepth) + " variant " + std::to_string(variant);
+			CHECK_EQ(name + " 0", name + " " + std::to_string(MaxDifference(DecodeWithLibpng(png), image)));
+		}
+	}
+}
+
+TEST_CASE(ImageCodec, PngRepositoryImageMatchesLibpng)
+{
+	std::vector<uint8_t> png;
+	REQUIRE(ReadFileBytes(Test::SourcePath("img/be_logo.png"), png));
+	DecodedImage image;
+	REQUIRE(Decode(png, image));
+	CHECK_EQ(0, MaxDifference(DecodeWithLibpng(png), image));
+}
+
+TEST_CASE(ImageCodec, DecodesIntoPaddedRows)
+{
+	// eNX`̃Abv[hł͍ssb` 256 oCgɑݐ֒ڃfR[h
+	const std::vector<uint8_t> jpeg = EncodeJpeg(MakeRgbPattern(kWidth, kHeight), kWidth, kHeight, JpegSettings());
+	DecodedImage tight;
+	DecodedImage padded;
+	REQUIRE(Decode(jpeg, tight));
+	REQUIRE(DecodeImage(jpeg.data(), jpeg.size(), 256, padded));
+	CHECK_EQ(0u, padded.rowPitch % 256);
+	CHECK_EQ(0, MaxDifference(tight, padded));
+
+	// ݐ悪Ȃ΃fR[hȂ
+	std::vector<uint8_t> small(tight.pixels.size() - 1);
+	CHECK(!DecodeImage(jpeg.data(), jpeg.size(), small.data(), tight.rowPitch, small.size()));
+}
+
+TEST_CASE(ImageCodec, RejectsTruncatedAndCorruptData)
+{
+	JpegSettings restartSettings;
+	restartSettings.restartInterval = 4;
+	const std::vector<uint8_t> files[] = {
+		EncodeJpeg(MakeRgbPattern(kWidth, kHeight), kWidth, kHeight, JpegSettings()),
+		EncodeJpeg(MakeRgbPattern(kWidth, kHeight), kWidth, kHeight, restartSettings),
+		EncodePng(kWidth, kHeight, PngSettings()),
+	};
+	for (const std::vector<uint8_t>& file : files) {
+		// rŐ؂ꂽ͎̂sɂ(Ō̐oCg EOI / IEND Ȃ̂ŁAOŐ؂)
+		size_t acceptedCount = 0;
+		for (size_t size = 0; size + 16 < file.size(); size += 1 + size / 8) {
+			const std::vector<uint8_t> truncated(file.begin(), file.begin() + size);
+			DecodedImage image;
+			acceptedCount += Decode(truncated, image) ? 1 : 0;
+		}
+		CHECK_EQ(0u, acceptedCount);
+
+		// ꂽf[^͎sĂȂĂ悢A͈͊OǂݏȂ(Tj^CU[tŊm߂)
+		std::mt19937 random(7);
+		for (int trial = 0; trial < 200; ++trial) {
+			std::vector<uint8_t> corrupt = file;
+			for (int i = 0; i < 4; ++i) {
+				corrupt[random() % corrupt.size()] = static_cast<uint8_t>(random());
+			}
+			DecodedImage image;
+			Decode(corrupt, image);
+		}
+	}
+
+	const uint8_t unknown[16] = { 'G', 'I', 'F', '8', '9', 'a' };
+	ImageInfo info;
+	CHECK(!ReadImageInfo(unknown, sizeof(unknown), info));
+	CHECK(info.type == ImageFileType::Unknown);
+}
+
+TEST_CASE(ImageCodec, ScaleAveragesCoveredArea)
+{
+	DecodedImage source;
+	source.width = 4;
+	source.height = 2;
+	source.rowPitch = 4 * kBytesPerPixel;
+	source.pixels.resize(source.rowPitch * source.height);
+	for (size_t i = 0; i < source.pixels.size(); ++i) {
+		source.pixels[i] = static_cast<uint8_t>(i * 8);
+	}
+
+	// ɂ 2x2 ̕
+	DecodedImage half;
+	ScaleRgba8(source, 2, 1, half);
+	REQUIRE_EQ(2u, half.width);
+	REQUIRE_EQ(1u, half.height);
+	for (size_t x = 0; x < 2; ++x) {
+		for (size_t c = 0; c < kBytesPerPixel; ++c) {
+			const int sum = source.pixels[x * 8 + c] + source.pixels[x * 8 + 4 + c] +
+				source.pixels[16 + x * 8 + c] + source.pixels[16 + x * 8 + 4 + c];
+			CHECK_EQ((sum + 2) / 4, static_cast<int>(half.pixels[x * 4 + c]));
+		}
+	}
+
+	// 3  1 dȂkłAlȐF͕ςȂ
+	DecodedImage flat;
+	flat.width = 7;
+	flat.height = 5;
+	flat.rowPitch = 7 * kBytesPerPixel;
+	flat.pixels.assign(flat.rowPitch * flat.height, 77);
+	DecodedImage scaled;
+	ScaleRgba8(flat, 3, 2, scaled);
+	CHECK(std::all_of(scaled.pixels.begin(), scaled.pixels.end(), [](uint8_t value) { return value == 77; }));
+}
+
+TEST_CASE(ImageCodec, ReportsColorSpaceAndBitDepth)
+{
+	const std::vector<uint8_t> rgb = MakeRgbPattern(32, 16);
+	ImageInfo info;
+
+	// JPEG  EXIF  ColorSpace  1 ̂Ƃ sRGB
+	JpegSettings settings;
+	std::vector<uint8_t> jpeg = EncodeJpeg(rgb, 32, 16, settings);
+	REQUIRE(ReadImageInfo(jpeg.data(), jpeg.size(), info));
+	CHECK(!info.srgb);
+	CHECK_EQ(8u, info.bitDepth);
+	settings.exif = MakeExif(1);
+	jpeg = EncodeJpeg(rgb, 32, 16, settings);
+	REQUIRE(ReadImageInfo(jpeg.data(), jpeg.size(), info));
+	CHECK(info.srgb);
+	// 0xFFFF ́urv
+	settings.exif = MakeExif(0xFFFF);
+	jpeg = EncodeJpeg(rgb, 32, 16, settings);
+	REQUIRE(ReadImageInfo(jpeg.data(), jpeg.size(), info));
+	CHECK(!info.srgb);
+	// vObVuŎÕfR[_[ǂ߂ȂĂAWIC œǂނƂ̂߂ɔł
+	settings.exif = MakeExif(1);
+	settings.progressive = true;
+	jpeg = EncodeJpeg(rgb, 32, 16, settings);
+	CHECK(HasSrgbColorSpace(jpeg.data(), jpeg.size()));
+
+	// PNG  sRGB `NAK} 1/2.2(45455)
+	PngSettings pngSettings;
+	std::vector<uint8_t> png = EncodePng(32, 16, pngSettings);
+	REQUIRE(ReadImageInfo(png.data(), png.size(), info));
+	CHECK(!info.srgb);
+	pngSettings.srgbChunk = true;
+	png = EncodePng(32, 16, pngSettings);
+	REQUIRE(ReadImageInfo(png.data(), png.size(), info));
+	CHECK(info.srgb);
+	pngSettings.srgbChunk = false;
+	pngSettings.gamma = 45455;
+	png = EncodePng(32, 16, pngSettings);
+	REQUIRE(ReadImageInfo(png.data(), png.size(), info));
+	CHECK(info.srgb);
+	pngSettings.gamma = 100000;
+	png = EncodePng(32, 16, pngSettings);
+	REQUIRE(ReadImageInfo(png.data(), png.size(), info));
+	CHECK(!info.srgb);
+
+	// 16bit  PNG  OpenTexture  WIC  R16G16B16A16 ̂܂ܓǂ
+	pngSettings.gamma = 0;
+	pngSettings.bitDepth = 16;
+	png = EncodePng(32, 16, pngSettings);
+	REQUIRE(ReadImageInfo(png.data(), png.size(), info));
+	CHECK_EQ(16u, info.bitDepth);
+}
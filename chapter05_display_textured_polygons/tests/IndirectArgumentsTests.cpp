@@ -0,0 +1,128 @@
+#include "IndirectArguments.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// IndirectCull.hlsl  CullCS ̂܂܏ʂ́B
+	// GPU ǂނ̂Ɠl߂f[^(PackedAabb  CullConstants)Ĕ肷
+	std::vector<DrawIndexedArguments> RunCullCs(
+		uint32_t threadGroupCount,
+		const CullConstants& constants,
+		const std::vector<PackedAabb>& bounds,
+		const std::vector<DrawIndexedArguments>& drawArguments
+	) {
+		std::vector<DrawIndexedArguments> visibleArguments;
+		for (uint32_t index = 0; index < threadGroupCount * kCullThreadGroupSize; ++index) {
+			if (index >= constants.drawCount) {
+				continue;
+			}
+			const PackedAabb& aabb = bounds[index];
+			bool visible = true;
+			for (const Float4& plane : constants.planes) {
+				const float distance = plane.x * aabb.center[0] + plane.y * aabb.center[1] + plane.z * aabb.center[2] + plane.w;
+				const float radius = std::fabs(plane.x) * aabb.extent[0] + std::fabs(plane.y) * aabb.extent[1] + std::fabs(plane.z) * aabb.extent[2];
+				if (distance + radius < 0.0f) {
+					visible = false;
+					break;
+				}
+			}
+			if (visible) {
+				visibleArguments.push_back(drawArguments[index]);
+			}
+		}
+		return visibleArguments;
+	}
+
+	// GPU ͋l߂鏇Ԃ܂Ȃ̂ŁAׂOɕׂ
+	void SortArguments(std::vector<DrawIndexedArguments>& arguments)
+	{
+		std::sort(arguments.begin(), arguments.end(), [](const DrawIndexedArguments& a, const DrawIndexedArguments& b) {
+			return std::tie(a.startIndexLocation, a.baseVertexLocation) < std::tie(b.startIndexLocation, b.baseVertexLocation);
+		});
+	}
+
+	bool SameArguments(const DrawIndexedArguments& a, const DrawIndexedArguments& b)
+	{
+		return a.indexCountPerInstance == b.indexCountPerInstance
+			&& a.instanceCount == b.instanceCount
+			&& a.startIndexLocation == b.startIndexLocation
+			&& a.baseVertexLocation == b.baseVertexLocation
+			&& a.startInstanceLocation == b.startInstanceLocation;
+	}
+}
+
+TEST_CASE(IndirectArguments, LayoutMatchesShader)
+{
+	// HLSL  StructuredBuffer ̗vfƃ[g萔̕
+	CHECK_EQ(24u, sizeof(PackedAabb));
+	CHECK_EQ(12u, offsetof(PackedAabb, extent));
+	CHECK_EQ(20u, sizeof(DrawIndexedArguments));
+	CHECK_EQ(12u, offsetof(DrawIndexedArguments, baseVertexLocation));
+	CHECK_EQ(25u * sizeof(uint32_t), sizeof(CullConstants));
+	CHECK_EQ(96u, offsetof(CullConstants, drawCount));
+}
+
+TEST_CASE(IndirectArguments, ThreadGroupsCoverEveryDraw)
+{
+	CHECK_EQ(0u, CullThreadGroupCount(0));
+	CHECK_EQ(1u, CullThreadGroupCount(1));
+	CHECK_EQ(1u, CullThreadGroupCount(kCullThreadGroupSize));
+	CHECK_EQ(2u, CullThreadGroupCount(kCullThreadGroupSize + 1));
+}
+
+TEST_CASE(IndirectArguments, ReferenceMatchesPackedArguments)
+{
+	const Float4x4 viewProjection = MultiplyMatrix(
+		LookAtMatrixLH({ 0.0f, 0.0f, -60.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }),
+		PerspectiveFovMatrixLH(kPiDiv4, 16.0f / 9.0f, 1.0f, 100.0f)
+	);
+	const Frustum frustum = Frustum::FromViewProjection(viewProjection);
+
+	// O[v̒[o鐔܂߂Ď
+	for (const uint32_t drawCount : { 0u, 1u, 63u, 64u, 65u, 5000u }) {
+		std::mt19937 random(drawCount);
+		std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+		std::uniform_real_distribution<float> extent(0.1f, 4.0f);
+		AabbSoA aabbs;
+		std::vector<DrawIndexedArguments> drawArguments;
+		for (uint32_t i = 0; i < drawCount; ++i) {
+			aabbs.Add({ position(random), position(random), position(random) }, { extent(random), extent(random), extent(random) });
+			drawArguments.push_back({ 6, 1, i * 6, static_cast<int32_t>(i * 4), 0 });
+		}
+
+		std::vector<PackedAabb> bounds(drawCount);
+		PackAabbs(aabbs, bounds.data());
+		std::vector<DrawIndexedArguments> gpuArguments = RunCullCs(
+			CullThreadGroupCount(drawCount),
+			MakeCullConstants(frustum, drawCount),
+			bounds,
+			drawArguments
+		);
+
+		std::vector<DrawIndexedArguments> cpuArguments(drawCount);
+		cpuArguments.resize(CullDrawArguments(frustum, aabbs, drawArguments.data(), cpuArguments.data()));
+
+		REQUIRE_EQ(gpuArguments.size(), cpuArguments.size());
+		SortArguments(gpuArguments);
+		SortArguments(cpuArguments);
+		size_t mismatchCount = 0;
+		for (size_t i = 0; i < cpuArguments.size(); ++i) {
+			mismatchCount += SameArguments(gpuArguments[i], cpuArguments[i]) ? 0 : 1;
+		}
+		CHECK_EQ(0u, mismatchCount);
+		// ScS肵ĂΔׂӖȂ
+		if (drawCount == 5000) {
+			CHECK(cpuArguments.size() > 100);
+			CHECK(cpuArguments.size() < drawCount);
+		}
+	}
+}
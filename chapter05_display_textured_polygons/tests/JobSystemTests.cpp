@@ -0,0 +1,237 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// 1RÅł荇N悤A[J[̓RA葽߂ɂ
+	JobSystem::Options StressOptions()
+	{
+		JobSystem::Options options;
+		options.workerCount = (std::max)(std::thread::hardware_concurrency(), 4u);
+		return options;
+	}
+
+	long ForkJoinSum(JobSystem& jobSystem, int depth)
+	{
+		if (depth == 0) {
+			return 1;
+		}
+		long left = 0;
+		JobCounter counter;
+		jobSystem.Run([&]() { left = ForkJoinSum(jobSystem, depth - 1); }, &counter);
+		const long right = ForkJoinSum(jobSystem, depth - 1);
+		jobSystem.Wait(counter);
+		return left + right;
+	}
+}
+
+TEST_CASE(JobSystem, ForkJoinFromInsideJobs)
+{
+	JobSystem jobSystem(StressOptions());
+	for (int round = 0; round < 20; ++round) {
+		CHECK_EQ(1L << 12, ForkJoinSum(jobSystem, 12));
+	}
+}
+
+TEST_CASE(JobSystem, NestedParallelForVisitsEveryIndexOnce)
+{
+	constexpr size_t kOuterCount = 64;
+	constexpr size_t kInnerCount = 1024;
+	JobSystem jobSystem(StressOptions());
+	std::unique_ptr<std::atomic<uint32_t>[]> visits(new std::atomic<uint32_t>[kOuterCount * kInnerCount]);
+	for (size_t i = 0; i < kOuterCount * kInnerCount; ++i) {
+		visits[i] = 0;
+	}
+
+	jobSystem.ParallelFor(kOuterCount, 1, [&](size_t outerBegin, size_t outerEnd) {
+		for (size_t outer = outerBegin; outer < outerEnd; ++outer) {
+			// [J[̒炳ɕđ҂
+			jobSystem.ParallelFor(kInnerCount, 16, [&](size_t begin, size_t end) {
+				for (size_t inner = begin; inner < end; ++inner) {
+					visits[outer * kInnerCount + inner].fetch_add(1, std::memory_order_relaxed);
+				}
+			});
+		}
+	});
+
+	size_t wrongCount = 0;
+	for (size_t i = 0; i < kOuterCount * kInnerCount; ++i) {
+		wrongCount += visits[i] != 1 ? 1 : 0;
+	}
+	CHECK_EQ(0u, wrongCount);
+}
+
+TEST_CASE(JobSystem, ContinuationChainRunsInOrder)
+{
+	constexpr size_t kChainLength = 2000;
+	JobSystem jobSystem(StressOptions());
+	std::vector<std::unique_ptr<JobCounter>> counters;
+	for (size_t i = 0; i < kChainLength; ++i) {
+		counters.emplace_back(new JobCounter());
+	}
+
+	// i Ԗڂ i - 1 ԖڂIĂς܂BԂ order ɔтo
+	std::vector<size_t> order;
+	order.reserve(kChainLength);
+	jobSystem.Run([&]() { order.push_back(0); }, counters[0].get());
+	for (size_t i = 1; i < kChainLength; ++i) {
+		jobSystem.RunAfter(*counters[i - 1], [&order, i]() { order.push_back(i); }, counters[i].get());
+	}
+	jobSystem.Wait(*counters.back());
+	// ŌオIĂĂAr̃JE^[̏I܂Ă邱ƂB
+	// jOɂ͂ǂ Wait ő҂
+	for (const std::unique_ptr<JobCounter>& counter : counters) {
+		jobSystem.Wait(*counter);
+	}
+
+	REQUIRE_EQ(kChainLength, order.size());
+	for (size_t i = 0; i < kChainLength; ++i) {
+		CHECK_EQ(i, order[i]);
+	}
+}
+
+TEST_CASE(JobSystem, ContinuationWaitsForEveryDependency)
+{
+	constexpr int kJobCount = 256;
+	JobSystem jobSystem(StressOptions());
+	for (int round = 0; round < 50; ++round) {
+		std::atomic<int> finished{ 0 };
+		int seenByContinuation = -1;
+		JobCounter dependency;
+		JobCounter done;
+		for (int i = 0; i < kJobCount; ++i) {
+			jobSystem.Run([&]() { finished.fetch_add(1); }, &dependency);
+		}
+		jobSystem.RunAfter(dependency, [&]() { seenByContinuation = finished.load(); }, &done);
+		jobSystem.Wait(done);
+		CHECK_EQ(kJobCount, seenByContinuation);
+	}
+}
+
+TEST_CASE(JobSystem, CounterCanBeDestroyedRightAfterWait)
+{
+	// Wait ߂Ɏ̂ĂJE^[AI RunAfter ̐ςݒGȂƁB
+	// -DYUXX_SANITIZER=address / thread ŃrhƁAGĂΕ񍐂
+	JobSystem jobSystem(StressOptions());
+	std::atomic<int> continuationCount{ 0 };
+	JobCounter continuations;
+	for (int i = 0; i < 20000; ++i) {
+		std::unique_ptr<JobCounter> counter(new JobCounter());
+		jobSystem.Run([]() {}, counter.get());
+		jobSystem.RunAfter(*counter, [&]() { continuationCount.fetch_add(1); }, &continuations);
+		jobSystem.Wait(*counter);
+		counter.reset();
+	}
+	jobSystem.Wait(continuations);
+	CHECK_EQ(20000, continuationCount.load());
+}
+
+TEST_CASE(JobSystem, MainThreadJobsRunOnlyOnMainThread)
+{
+	JobSystem jobSystem(StressOptions());
+	const std::thread::id mainThread = std::this_thread::get_id();
+	std::atomic<int> wrongThreadCount{ 0 };
+	std::atomic<int> mainThreadJobCount{ 0 };
+	JobCounter counter;
+	// [J[̒烁CXbh̃Wuς
+	jobSystem.ParallelFor(512, 1, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			jobSystem.RunOnMainThread([&]() {
+				if (std::this_thread::get_id() != mainThread || jobSystem.CurrentThreadIndex() != 0) {
+					wrongThreadCount.fetch_add(1);
+				}
+				mainThreadJobCount.fetch_add(1);
+			}, &counter);
+		}
+	});
+	jobSystem.Wait(counter);
+	CHECK_EQ(512, mainThreadJobCount.load());
+	CHECK_EQ(0, wrongThreadCount.load());
+}
+
+TEST_CASE(JobSystem, NestedJobSystemRestoresMainThread)
+{
+	JobSystem outer(StressOptions());
+	{
+		JobSystem::Options options;
+		options.workerCount = 1;
+		JobSystem inner(options);
+		CHECK_EQ(-1, outer.CurrentThreadIndex());
+		CHECK_EQ(0, inner.CurrentThreadIndex());
+	}
+	CHECK_EQ(0, outer.CurrentThreadIndex());
+}
+
+TEST_CASE(JobSystem, PinnedThreadsStillRunJobs)
+{
+	JobSystem::Options options = StressOptions();
+	options.pinThreads = true;
+	JobSystem jobSystem(options);
+	CHECK_EQ(1L << 10, ForkJoinSum(jobSystem, 10));
+}
+
+TEST_CASE(JobSystem, StolenItemsAreTakenExactlyOnce)
+{
+	constexpr int kItemCount = 200000;
+	constexpr int kThiefCount = 3;
+	WorkStealingDeque<int> deque(1024);
+	std::vector<int> items(kItemCount);
+	std::unique_ptr<std::atomic<int>[]> taken(new std::atomic<int>[kItemCount]);
+	for (int i = 0; i < kItemCount; ++i) {
+		items[i] = i;
+		taken[i] = 0;
+	}
+
+	std::atomic<bool> producing{ true };
+	std::vector<std::thread> thieves;
+	for (int t = 0; t < kThiefCount; ++t) {
+		thieves.emplace_back([&]() {
+			while (true) {
+				if (int* item = deque.Steal()) {
+					taken[*item].fetch_add(1);
+					continue;
+				}
+				// 傪ςݏIƂ͋ɂȂĂ
+				if (!producing.load()) {
+					return;
+				}
+				std::this_thread::yield();
+			}
+		});
+	}
+
+	// ͐ς݂ȂAƂǂło
+	for (int i = 0; i < kItemCount; ++i) {
+		while (!deque.Push(&items[i])) {
+			if (int* item = deque.Pop()) {
+				taken[*item].fetch_add(1);
+			}
+		}
+		if (i % 3 == 0) {
+			if (int* item = deque.Pop()) {
+				taken[*item].fetch_add(1);
+			}
+		}
+	}
+	while (int* item = deque.Pop()) {
+		taken[*item].fetch_add(1);
+	}
+	producing = false;
+	for (std::thread& thief : thieves) {
+		thief.join();
+	}
+
+	int wrongCount = 0;
+	for (int i = 0; i < kItemCount; ++i) {
+		wrongCount += taken[i] != 1 ? 1 : 0;
+	}
+	CHECK_EQ(0, wrongCount);
+}
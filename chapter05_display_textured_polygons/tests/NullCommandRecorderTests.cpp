@@ -0,0 +1,140 @@
+#include "NullCommandRecorder.h"
+
+#include <string>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// CreateSyntheticScene IuWFNg̔ԍ(NullCommandRecorder.cpp Ɠ)
+	constexpr RecorderObjectId kVertexBuffer = 1;
+	constexpr RecorderObjectId kIndexBuffer = 2;
+	constexpr RecorderObjectId kTexture = 3;
+	constexpr RecorderObjectId kRootSignature = 5;
+	constexpr RecorderObjectId kPipelineState = 6;
+	// D3D_PRIMITIVE_TOPOLOGY_TRIANGLELISTEDXGI_FORMAT_R16_UINT
+	constexpr uint32_t kTriangleList = 4;
+	constexpr uint32_t kIndexFormatR16Uint = 57;
+
+	// V[Ƃ́A؂ recorder
+	void CreateScene(NullCommandRecorder& recorder)
+	{
+		CreateSyntheticScene(recorder);
+		REQUIRE_EQ(0u, recorder.ErrorCount());
+		recorder.ResetStats();
+	}
+
+	// `ɕKvȐݒ̂ApCvCƃeNX`ȊO
+	void SetDrawState(NullCommandRecorder& recorder)
+	{
+		recorder.SetGraphicsRootSignature(kRootSignature);
+		recorder.SetViewport({ 0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f });
+		recorder.SetScissorRect({ 0, 0, 1280, 720 });
+		recorder.SetPrimitiveTopology(kTriangleList);
+		recorder.SetVertexBuffer(kVertexBuffer, 80, 20);
+		recorder.SetIndexBuffer(kIndexBuffer, 12, kIndexFormatR16Uint);
+	}
+
+	// ŏ̃G[ call Ŏn܂Ă邩
+	bool FirstErrorFrom(const NullCommandRecorder& recorder, const std::string& call)
+	{
+		return !recorder.Errors().empty() && recorder.Errors()[0].compare(0, call.size(), call) == 0;
+	}
+}
+
+TEST_CASE(NullCommandRecorder, SyntheticFrameIsValid)
+{
+	NullCommandRecorder recorder(true);
+	CreateScene(recorder);
+	RecordSyntheticFrame(recorder, 200);
+	recorder.Finish();
+	CHECK_EQ(0u, recorder.ErrorCount());
+	CHECK_EQ(200u, recorder.Stats(CaptureCommand::DrawIndexedInstanced).count);
+}
+
+TEST_CASE(NullCommandRecorder, RootParameterOutOfRangeIsReported)
+{
+	// V[̃[gVOl`̓e[u1
+	NullCommandRecorder recorder(true);
+	CreateScene(recorder);
+	recorder.BeginFrame();
+	SetDrawState(recorder);
+	recorder.SetPipelineState(kPipelineState);
+	recorder.SetGraphicsRootTexture(0, kTexture);
+	CHECK_EQ(0u, recorder.ErrorCount());
+	recorder.SetGraphicsRootTexture(1, kTexture);
+	CHECK_EQ(1u, recorder.ErrorCount());
+	CHECK(FirstErrorFrom(recorder, "SetGraphicsRootTexture"));
+
+	// [gVOl`ݒ肷O͂ǂ̔ԍgȂ
+	recorder.ResetStats();
+	recorder.EndFrame();
+	recorder.BeginFrame();
+	recorder.SetGraphicsRootTexture(0, kTexture);
+	CHECK_EQ(1u, recorder.ErrorCount());
+	recorder.EndFrame();
+}
+
+TEST_CASE(NullCommandRecorder, RootSignatureMustBeSerialized)
+{
+	NullCommandRecorder recorder(true);
+	const std::vector<uint8_t> garbage(64);
+	CHECK(!recorder.CreateRootSignature(kRootSignature, garbage.data(), garbage.size()));
+	CHECK_EQ(1u, recorder.ErrorCount());
+	CHECK(FirstErrorFrom(recorder, "CreateRootSignature"));
+}
+
+TEST_CASE(NullCommandRecorder, DrawWithoutPipelineStateIsReported)
+{
+	NullCommandRecorder recorder(true);
+	CreateScene(recorder);
+	recorder.BeginFrame();
+	SetDrawState(recorder);
+	recorder.SetGraphicsRootTexture(0, kTexture);
+	recorder.DrawIndexedInstanced(6, 1, 0, 0, 0);
+	CHECK_EQ(1u, recorder.ErrorCount());
+	CHECK(FirstErrorFrom(recorder, "DrawIndexedInstanced"));
+
+	// ݒ肷ΒʂBݒ̓t[܂ňpȂ
+	recorder.SetPipelineState(kPipelineState);
+	recorder.DrawIndexedInstanced(6, 1, 0, 0, 0);
+	CHECK_EQ(1u, recorder.ErrorCount());
+	recorder.EndFrame();
+	recorder.BeginFrame();
+	SetDrawState(recorder);
+	recorder.DrawIndexedInstanced(6, 1, 0, 0, 0);
+	CHECK_EQ(2u, recorder.ErrorCount());
+	recorder.EndFrame();
+}
+
+TEST_CASE(NullCommandRecorder, UnclosedFrameIsReported)
+{
+	// Ȃ܂܎s
+	NullCommandRecorder recorder(true);
+	CreateScene(recorder);
+	recorder.BeginFrame();
+	recorder.Finish();
+	CHECK_EQ(1u, recorder.ErrorCount());
+	CHECK(FirstErrorFrom(recorder, "Finish"));
+
+	// Ȃ܂܎̃t[n߂
+	recorder.ResetStats();
+	recorder.BeginFrame();
+	CHECK_EQ(1u, recorder.ErrorCount());
+	CHECK(FirstErrorFrom(recorder, "BeginFrame"));
+	recorder.EndFrame();
+	recorder.Finish();
+	CHECK_EQ(1u, recorder.ErrorCount());
+}
+
+TEST_CASE(NullCommandRecorder, ValidationIsOffByDefault)
+{
+	NullCommandRecorder recorder;
+	recorder.BeginFrame();
+	recorder.SetGraphicsRootTexture(7, kTexture);
+	recorder.DrawIndexedInstanced(6, 1, 0, 0, 0);
+	recorder.Finish();
+	CHECK_EQ(0u, recorder.ErrorCount());
+	CHECK_EQ(3u, recorder.TotalCalls());
+}
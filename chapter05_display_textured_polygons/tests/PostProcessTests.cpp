@@ -0,0 +1,238 @@
+#include "PostProcessReference.h"
+
+#include <cmath>
+#include <limits>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// 1.0 g[}bv(ACES) sRGB ɂlB(2.51 + 0.03) / (2.43 + 0.59 + 0.14)  1 / 2.4 悵ċ߂
+	constexpr float kTonemappedOne = 0.9082305f;
+	// PostProcess.hlsl  kBlurWeights
+	constexpr float kBlurWeights[5] = { 0.2270270270f, 0.1945945946f, 0.1216216216f, 0.0540540541f, 0.0162162162f };
+
+	PostProcessImage MakeImage(uint32_t width, uint32_t height, float value)
+	{
+		PostProcessImage image;
+		image.width = width;
+		image.height = height;
+		image.pixels.assign(static_cast<size_t>(width) * height, Float4{ value, value, value, 1.0f });
+		return image;
+	}
+
+	void SetPixel(PostProcessImage& image, uint32_t x, uint32_t y, float value)
+	{
+		image.pixels[static_cast<size_t>(y) * image.width + x] = { value, value, value, 1.0f };
+	}
+
+	const Float4& Pixel(const PostProcessImage& image, uint32_t x, uint32_t y)
+	{
+		return image.pixels[static_cast<size_t>(y) * image.width + x];
+	}
+
+	PostProcessConstants MakeConstants(const PostProcessImage& image, const PostProcessSettings& settings, uint32_t blurDirection = 0)
+	{
+		return MakePostProcessConstants(image.width, image.height, settings, blurDirection, 1.0f, 1.0f);
+	}
+
+	// RGB ׂ valueAa  1 
+	void CheckAllPixels(const PostProcessImage& image, float value, float tolerance)
+	{
+		for (const Float4& pixel : image.pixels) {
+			CHECK_NEAR(value, pixel.x, tolerance);
+			CHECK_NEAR(value, pixel.y, tolerance);
+			CHECK_NEAR(value, pixel.z, tolerance);
+			CHECK_EQ(1.0f, pixel.w);
+		}
+	}
+}
+
+TEST_CASE(PostProcess, TonemapAppliesAcesAndSrgb)
+{
+	PostProcessSettings settings;
+	settings.bloom = false;
+	const PostProcessImage black = MakeImage(4, 4, 0.0f);
+	PostProcessImage output;
+
+	const PostProcessImage one = MakeImage(4, 4, 1.0f);
+	TonemapReference(one, black, MakeConstants(one, settings), output);
+	CheckAllPixels(output, kTonemappedOne, 1e-5f);
+
+	// 0  0 ̂܂܁A邷l 1 ɒt
+	TonemapReference(black, black, MakeConstants(black, settings), output);
+	CheckAllPixels(output, 0.0f, 1e-6f);
+	const PostProcessImage bright = MakeImage(4, 4, 100.0f);
+	TonemapReference(bright, black, MakeConstants(bright, settings), output);
+	CheckAllPixels(output, 1.0f, 1e-6f);
+}
+
+TEST_CASE(PostProcess, TonemapAddsBloomAndExposureBeforeTheCurve)
+{
+	const PostProcessImage half = MakeImage(4, 4, 0.5f);
+	const PostProcessImage black = MakeImage(2, 2, 0.0f);
+	PostProcessImage output;
+
+	// 0.5 Io 2 {ɂ 1.0 ƓɂȂ
+	PostProcessSettings settings;
+	settings.bloom = false;
+	settings.exposure = 2.0f;
+	TonemapReference(half, black, MakeConstants(half, settings), output);
+	CheckAllPixels(output, kTonemappedOne, 1e-5f);
+
+	// 0.5  1.0 ̃u[ 0.5 őĂ 1.0 ɂȂBu[͔̑傫łŜɍLēǂ
+	settings.bloom = true;
+	settings.bloomIntensity = 0.5f;
+	settings.exposure = 1.0f;
+	const PostProcessImage bloom = MakeImage(2, 2, 1.0f);
+	TonemapReference(half, bloom, MakeConstants(half, settings), output);
+	CheckAllPixels(output, kTonemappedOne, 1e-5f);
+
+	// u[؂Ƌ 0 ɂȂ
+	settings.bloom = false;
+	TonemapReference(half, bloom, MakeConstants(half, settings), output);
+	CHECK(Pixel(output, 0, 0).x < kTonemappedOne - 0.1f);
+}
+
+TEST_CASE(PostProcess, TonemapScalesTheRenderedRegionToTheOutput)
+{
+	// I𑜓xō 4x4 ɕ`BOɂ͑Õt[̖邢fcĂ
+	PostProcessImage hdr = MakeImage(8, 8, 100.0f);
+	for (uint32_t y = 0; y < 4; ++y) {
+		for (uint32_t x = 0; x < 4; ++x) {
+			SetPixel(hdr, x, y, 1.0f);
+		}
+	}
+	PostProcessSettings settings;
+	settings.bloom = false;
+	const PostProcessConstants constants = MakePostProcessConstants(8, 8, settings, 0, 0.5f, 0.5f);
+	PostProcessImage output;
+	TonemapReference(hdr, MakeImage(4, 4, 0.0f), constants, output);
+	REQUIRE_EQ(8u, output.width);
+	REQUIRE_EQ(8u, output.height);
+	// `͈͂̊Oǂ܂Ȃ
+	CheckAllPixels(output, kTonemappedOne, 1e-5f);
+}
+
+TEST_CASE(PostProcess, BloomExtractKeepsTheExcessOverTheThreshold)
+{
+	PostProcessImage hdr = MakeImage(2, 2, 0.0f);
+	SetPixel(hdr, 0, 0, 0.5f);
+	SetPixel(hdr, 1, 0, 1.0f);
+	SetPixel(hdr, 0, 1, 1.5f);
+	SetPixel(hdr, 1, 1, 3.0f);
+	PostProcessSettings settings;
+	settings.bloomThreshold = 1.0f;
+	PostProcessImage bloom;
+	// 傫ɒo΁Aef̒S傤Ǔǂ
+	BloomExtractReference(hdr, MakeConstants(hdr, settings), bloom);
+	REQUIRE_EQ(static_cast<size_t>(4), bloom.pixels.size());
+	CHECK_EQ(0.0f, Pixel(bloom, 0, 0).x);
+	CHECK_EQ(0.0f, Pixel(bloom, 1, 0).x);
+	CHECK_EQ(0.5f, Pixel(bloom, 0, 1).x);
+	CHECK_EQ(2.0f, Pixel(bloom, 1, 1).y);
+	CHECK_EQ(1.0f, Pixel(bloom, 1, 1).w);
+
+	// ̑傫ł 2x2 ̕(1.5)臒l
+	const PostProcessConstants half = MakePostProcessConstants(1, 1, settings, 0, 1.0f, 1.0f);
+	BloomExtractReference(hdr, half, bloom);
+	REQUIRE_EQ(static_cast<size_t>(1), bloom.pixels.size());
+	CHECK_NEAR(0.5f, Pixel(bloom, 0, 0).z, 1e-6f);
+}
+
+TEST_CASE(PostProcess, BlurSpreadsAnImpulseByTheWeights)
+{
+	PostProcessImage impulse = MakeImage(11, 1, 0.0f);
+	SetPixel(impulse, 5, 0, 1.0f);
+	const PostProcessSettings settings;
+	PostProcessImage blurred;
+
+	BlurReference(impulse, MakeConstants(impulse, settings, 0), blurred);
+	float sum = 0.0f;
+	for (uint32_t x = 0; x < 11; ++x) {
+		const int distance = x > 5 ? static_cast<int>(x) - 5 : 5 - static_cast<int>(x);
+		const float expected = distance < 5 ? kBlurWeights[distance] : 0.0f;
+		CHECK_NEAR(expected, Pixel(blurred, x, 0).x, 1e-7f);
+		sum += Pixel(blurred, x, 0).x;
+	}
+	// d݂̍v 1 Ȃ̂Ŗ邳͕ςȂ
+	CHECK_NEAR(1.0f, sum, 1e-6f);
+
+	// c͍ 1 ̉摜ł͒[œfǂݑ̂ŁÂ܂܎c
+	BlurReference(impulse, MakeConstants(impulse, settings, 1), blurred);
+	CHECK_NEAR(1.0f, Pixel(blurred, 5, 0).x, 1e-6f);
+	CHECK_EQ(0.0f, Pixel(blurred, 4, 0).x);
+
+	// lȉ摜͒[łςȂ
+	const PostProcessImage flat = MakeImage(3, 7, 0.25f);
+	BlurReference(flat, MakeConstants(flat, settings, 1), blurred);
+	CheckAllPixels(blurred, 0.25f, 1e-6f);
+}
+
+TEST_CASE(PostProcess, SharpenStaysWithinTheNeighborhood)
+{
+	// c̒iBV[vɂĂ̍ŏEő𒴂Ȃ(MOȂ)
+	PostProcessImage edge = MakeImage(6, 3, 0.2f);
+	for (uint32_t y = 0; y < 3; ++y) {
+		for (uint32_t x = 3; x < 6; ++x) {
+			SetPixel(edge, x, y, 0.8f);
+		}
+	}
+	PostProcessSettings settings;
+	settings.sharpness = 1.0f;
+	PostProcessImage sharpened;
+	SharpenReference(edge, MakeConstants(edge, settings), sharpened);
+	for (const Float4& pixel : sharpened.pixels) {
+		CHECK(pixel.x >= 0.2f && pixel.x <= 0.8f);
+	}
+	// i痣ꂽfƁAi̗͕ςȂ(ߖT͈̔͂Ɏ߂)
+	CHECK_EQ(0.2f, Pixel(sharpened, 0, 1).x);
+	CHECK_EQ(0.2f, Pixel(sharpened, 2, 1).x);
+	CHECK_EQ(0.8f, Pixel(sharpened, 3, 1).x);
+}
+
+TEST_CASE(PostProcess, FullChainOnAFlatImage)
+{
+	// 臒l傤ǂ̈lȉ摜: u[ 0AFXAA ƃV[v͉Ȃ
+	const PostProcessImage hdr = MakeImage(17, 9, 1.0f);
+	const PostProcessSettings settings;
+	PostProcessImage output;
+	RunPostProcessReference(hdr, settings, hdr.width, hdr.height, output);
+	REQUIRE_EQ(17u, output.width);
+	REQUIRE_EQ(9u, output.height);
+	// R8G8B8A8_UNORM Ɋۂ߂l(0.9082 * 255 = 231.6)
+	CheckAllPixels(output, 232.0f / 255.0f, 1e-6f);
+}
+
+TEST_CASE(PostProcess, QuantizesLikeTheIntermediateFormats)
+{
+	PostProcessImage image;
+	image.width = 4;
+	image.height = 1;
+	image.pixels = {
+		{ 1.0f / 3.0f, 1.0f, 65519.0f, 65520.0f },
+		{ 1.0e-8f, 3.0e-8f, -2.0f, 0.0f },
+		{ 0.5f, -1.0f, 2.0f, 1.0f / 255.0f },
+		{ 0.0f, 0.0f, 0.0f, 0.0f },
+	};
+	PostProcessImage half = image;
+	QuantizeToHalf(half);
+	CHECK_EQ(0.333251953125f, half.pixels[0].x);
+	CHECK_EQ(1.0f, half.pixels[0].y);
+	// half ̍ől 65504 Ɋۂ܂邩AĖɂȂ
+	CHECK_EQ(65504.0f, half.pixels[0].z);
+	CHECK_EQ(std::numeric_limits<float>::infinity(), half.pixels[0].w);
+	// 񐳋K 2^-24 P
+	CHECK_EQ(0.0f, half.pixels[1].x);
+	CHECK_EQ(5.9604644775390625e-8f, half.pixels[1].y);
+	CHECK_EQ(-2.0f, half.pixels[1].z);
+
+	PostProcessImage unorm = image;
+	QuantizeToUnorm8(unorm);
+	// 127.5 ͋ 128 Ɋۂ߂
+	CHECK_EQ(128.0f / 255.0f, unorm.pixels[2].x);
+	CHECK_EQ(0.0f, unorm.pixels[2].y);
+	CHECK_EQ(1.0f, unorm.pixels[2].z);
+	CHECK_EQ(1.0f / 255.0f, unorm.pixels[2].w);
+}
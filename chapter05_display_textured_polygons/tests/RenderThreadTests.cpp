@@ -0,0 +1,281 @@
+#include "RenderThread.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "SpscQueue.h"
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// `XbhŋNƂ̋L^BStop ŕ`Xbh҂Ăǂ
+	struct RenderEvent
+	{
+		bool isCommand;
+		uint64_t frameIndex;
+	};
+
+	// pPbg󂭂܂ő҂Ă瑗
+	void SubmitFrame(RenderThread& renderThread, uint64_t frameIndex)
+	{
+		FramePacket* packet = nullptr;
+		while ((packet = renderThread.BeginFramePacket()) == nullptr) {
+			std::this_thread::yield();
+		}
+		packet->frameIndex = frameIndex;
+		renderThread.SubmitFramePacket(packet);
+	}
+
+	void WaitForRenderedFrames(const RenderThread& renderThread, uint64_t frameCount)
+	{
+		while (renderThread.RenderedFrameCount() < frameCount) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+TEST_CASE(RenderThread, SpscQueueFullAndEmpty)
+{
+	SpscQueue<int, 4> queue;
+	int value = -1;
+	CHECK(!queue.TryPop(value));
+	// ĂꂽɏoĂ
+	for (int round = 0; round < 10; ++round) {
+		for (int i = 0; i < 4; ++i) {
+			REQUIRE(queue.TryPush(round * 4 + i));
+		}
+		CHECK(!queue.TryPush(-1));
+		CHECK_EQ(4u, queue.SizeApprox());
+		for (int i = 0; i < 4; ++i) {
+			REQUIRE(queue.TryPop(value));
+			CHECK_EQ(round * 4 + i, value);
+		}
+		CHECK(!queue.TryPop(value));
+	}
+}
+
+TEST_CASE(RenderThread, SpscQueueHandsOffInOrder)
+{
+	// ȃL[ 20000 nAtƋxs
+	constexpr uint32_t kValueCount = 20000;
+	SpscQueue<std::unique_ptr<uint32_t>, 16> queue;
+	std::vector<uint32_t> received;
+	received.reserve(kValueCount);
+	std::thread consumer([&]() {
+		std::unique_ptr<uint32_t> value;
+		while (received.size() < kValueCount) {
+			if (queue.TryPop(value)) {
+				received.push_back(*value);
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	});
+	for (uint32_t i = 0; i < kValueCount;) {
+		if (queue.TryPush(std::unique_ptr<uint32_t>(new uint32_t(i)))) {
+			++i;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+	consumer.join();
+
+	REQUIRE_EQ(static_cast<size_t>(kValueCount), received.size());
+	uint32_t wrongCount = 0;
+	for (uint32_t i = 0; i < kValueCount; ++i) {
+		wrongCount += received[i] != i ? 1 : 0;
+	}
+	CHECK_EQ(0u, wrongCount);
+}
+
+TEST_CASE(RenderThread, OnlyTwoPacketsAreOutstanding)
+{
+	RenderThread renderThread;
+	// `Xbh𓮂ÓA2炻ȏ͏Ȃ
+	FramePacket* first = renderThread.BeginFramePacket();
+	FramePacket* second = renderThread.BeginFramePacket();
+	REQUIRE(first != nullptr);
+	REQUIRE(second != nullptr);
+	CHECK(first != second);
+	CHECK(renderThread.BeginFramePacket() == nullptr);
+	renderThread.SubmitFramePacket(first);
+	renderThread.SubmitFramePacket(second);
+	CHECK(renderThread.BeginFramePacket() == nullptr);
+
+	renderThread.Start([](const FramePacket&) { return true; }, [](const RenderCommand&) {});
+	WaitForRenderedFrames(renderThread, 2);
+	renderThread.Stop();
+	CHECK(renderThread.BeginFramePacket() != nullptr);
+}
+
+TEST_CASE(RenderThread, FramesAreRenderedInOrder)
+{
+	constexpr uint64_t kFrameCount = 2000;
+	RenderThread renderThread;
+	std::vector<uint64_t> rendered;
+	rendered.reserve(kFrameCount);
+	renderThread.Start(
+		[&](const FramePacket& packet) {
+			rendered.push_back(packet.frameIndex);
+			return true;
+		},
+		[](const RenderCommand&) {}
+	);
+	for (uint64_t frame = 0; frame < kFrameCount; ++frame) {
+		SubmitFrame(renderThread, frame);
+	}
+	WaitForRenderedFrames(renderThread, kFrameCount);
+	renderThread.Stop();
+
+	REQUIRE_EQ(static_cast<size_t>(kFrameCount), rendered.size());
+	uint64_t wrongCount = 0;
+	for (uint64_t i = 0; i < kFrameCount; ++i) {
+		wrongCount += rendered[i] != i ? 1 : 0;
+	}
+	CHECK_EQ(0u, wrongCount);
+}
+
+TEST_CASE(RenderThread, CommandsRunBeforeTheNextPacket)
+{
+	constexpr uint64_t kFrameCount = 500;
+	RenderThread renderThread;
+	std::vector<RenderEvent> events;
+	renderThread.Start(
+		[&](const FramePacket& packet) {
+			events.push_back({ false, packet.frameIndex });
+			return true;
+		},
+		[&](const RenderCommand&) { events.push_back({ true, 0 }); }
+	);
+	// 3t[Ƃɗv1ĂpPbg𑗂
+	for (uint64_t frame = 0; frame < kFrameCount; ++frame) {
+		if (frame % 3 == 0) {
+			REQUIRE(renderThread.PostCommand({ RenderCommand::kCaptureFrame }));
+		}
+		SubmitFrame(renderThread, frame);
+	}
+	WaitForRenderedFrames(renderThread, kFrameCount);
+	renderThread.Stop();
+
+	// t[ f `OɁAf ȑOɑvׂďĂ
+	uint64_t commandCount = 0;
+	uint64_t lateCount = 0;
+	for (const RenderEvent& event : events) {
+		if (event.isCommand) {
+			++commandCount;
+		} else if (commandCount < event.frameIndex / 3 + 1) {
+			++lateCount;
+		}
+	}
+	CHECK_EQ((kFrameCount + 2) / 3, commandCount);
+	CHECK_EQ(0u, lateCount);
+}
+
+TEST_CASE(RenderThread, CommandQueueRejectsWhenFull)
+{
+	RenderThread renderThread;
+	for (size_t i = 0; i < RenderThread::kCommandCapacity; ++i) {
+		REQUIRE(renderThread.PostCommand({ RenderCommand::kCaptureFrame }));
+	}
+	CHECK(!renderThread.PostCommand({ RenderCommand::kCaptureFrame }));
+}
+
+TEST_CASE(RenderThread, StopReturnsPendingPacketsAndCanRestart)
+{
+	RenderThread renderThread;
+	// ~߂OɌĂłȂ
+	renderThread.Stop();
+	CHECK(!renderThread.IsRunning());
+
+	std::atomic<bool> drawing{ false };
+	std::atomic<bool> release{ false };
+	std::atomic<uint64_t> renderedIndex{ 0 };
+	renderThread.Start([&](const FramePacket& packet) {
+		// 1t[ڂŎ~߂ĂA2t[ڂ`Ȃ܂܎c
+		drawing = true;
+		while (!release.load()) {
+			std::this_thread::yield();
+		}
+		renderedIndex = packet.frameIndex;
+		return true;
+	}, [](const RenderCommand&) {});
+	SubmitFrame(renderThread, 1);
+	SubmitFrame(renderThread, 2);
+	REQUIRE(renderThread.PostCommand({ RenderCommand::kCaptureFrame }));
+	while (!drawing.load()) {
+		std::this_thread::yield();
+	}
+	// Stop ~߂鍇}ô҂Ă1t[ڂI点B
+	// }x2t[ڂ`邪Aǂłȉ͐藧
+	std::thread stopper([&]() { renderThread.Stop(); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	release = true;
+	stopper.join();
+
+	CHECK(!renderThread.IsRunning());
+	const uint64_t renderedBeforeStop = renderThread.RenderedFrameCount();
+	CHECK(renderedBeforeStop == 1 || renderedBeforeStop == 2);
+	CHECK_EQ(renderedBeforeStop, renderedIndex.load());
+	// `ȂpPbg߂鑤ɖ߂Ă
+	FramePacket* first = renderThread.BeginFramePacket();
+	FramePacket* second = renderThread.BeginFramePacket();
+	REQUIRE(first != nullptr);
+	REQUIRE(second != nullptr);
+
+	// Α`B~߂OɎcĂv͎̂ĂĂ
+	std::atomic<int> commandCount{ 0 };
+	first->frameIndex = 3;
+	second->frameIndex = 4;
+	renderThread.SubmitFramePacket(first);
+	renderThread.SubmitFramePacket(second);
+	renderThread.Start(
+		[&](const FramePacket& packet) {
+			renderedIndex = packet.frameIndex;
+			return true;
+		},
+		[&](const RenderCommand&) { commandCount.fetch_add(1); }
+	);
+	WaitForRenderedFrames(renderThread, renderedBeforeStop + 2);
+	renderThread.Stop();
+	CHECK_EQ(renderedBeforeStop + 2, renderThread.RenderedFrameCount());
+	CHECK_EQ(4u, renderedIndex.load());
+	CHECK_EQ(0, commandCount.load());
+}
+
+TEST_CASE(RenderThread, StopsRenderingAfterAFailedFrame)
+{
+	RenderThread renderThread;
+	std::vector<uint64_t> rendered;
+	renderThread.Start(
+		[&](const FramePacket& packet) {
+			rendered.push_back(packet.frameIndex);
+			// 2t[ڂŎs
+			return packet.frameIndex != 2;
+		},
+		[](const RenderCommand&) {}
+	);
+	CHECK(!renderThread.Failed());
+	SubmitFrame(renderThread, 1);
+	SubmitFrame(renderThread, 2);
+	while (!renderThread.Failed()) {
+		std::this_thread::yield();
+	}
+	// sƂɑpPbg͕`Ȃ
+	SubmitFrame(renderThread, 3);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	renderThread.Stop();
+	CHECK_EQ(1u, renderThread.RenderedFrameCount());
+	REQUIRE_EQ(static_cast<size_t>(2), rendered.size());
+	CHECK_EQ(2u, rendered[1]);
+
+	// Ύs͏
+	renderThread.Start([](const FramePacket&) { return true; }, [](const RenderCommand&) {});
+	CHECK(!renderThread.Failed());
+	SubmitFrame(renderThread, 4);
+	WaitForRenderedFrames(renderThread, 2);
+	renderThread.Stop();
+}
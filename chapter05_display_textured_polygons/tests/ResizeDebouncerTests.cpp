@@ -0,0 +1,108 @@
+#include "ResizeDebouncer.h"
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	using Clock = ResizeDebouncer::Clock;
+
+	// v͐i߂AeXgŌ߂n
+	Clock::time_point At(int milliseconds)
+	{
+		return Clock::time_point() + std::chrono::milliseconds(milliseconds);
+	}
+
+	ResizeDebouncer MakeDebouncer()
+	{
+		ResizeDebouncer debouncer(std::chrono::milliseconds(100));
+		debouncer.Reset(1280, 720);
+		return debouncer;
+	}
+}
+
+TEST_CASE(ResizeDebouncer, DraggingWaitsUntilTheSizeSettles)
+{
+	ResizeDebouncer debouncer = MakeDebouncer();
+	// 16ms Ƃ WM_SIZE Ԃ́A傫ςȂ
+	for (int i = 0; i < 10; ++i) {
+		debouncer.OnResize(1280 + 10 * (i + 1), 720, true, At(16 * i));
+		CHECK(!debouncer.Update(At(16 * i + 1)));
+		CHECK_EQ(1280u, debouncer.Width());
+	}
+	// Ō WM_SIZE(144ms) 100ms ܂ł͑҂
+	CHECK(!debouncer.Update(At(243)));
+	CHECK(debouncer.HasPendingResize());
+	CHECK(debouncer.Update(At(244)));
+	CHECK_EQ(1380u, debouncer.Width());
+	CHECK_EQ(720u, debouncer.Height());
+	CHECK(!debouncer.HasPendingResize());
+	// fƂ͉Ȃ
+	CHECK(!debouncer.Update(At(1000)));
+}
+
+TEST_CASE(ResizeDebouncer, SameSizeDuringADragDoesNotRestartTheWait)
+{
+	ResizeDebouncer debouncer = MakeDebouncer();
+	debouncer.OnResize(1000, 600, true, At(0));
+	// }EX~߂ĂĂ WM_SIZE ͗
+	debouncer.OnResize(1000, 600, true, At(50));
+	debouncer.OnResize(1000, 600, true, At(90));
+	CHECK(debouncer.Update(At(100)));
+	CHECK_EQ(1000u, debouncer.Width());
+	CHECK_EQ(600u, debouncer.Height());
+}
+
+TEST_CASE(ResizeDebouncer, EndOfDragAndMaximizeApplyImmediately)
+{
+	ResizeDebouncer debouncer = MakeDebouncer();
+	debouncer.OnResize(1100, 650, true, At(0));
+	CHECK(!debouncer.Update(At(10)));
+	// hbOI(WM_EXITSIZEMOVE)
+	debouncer.OnResize(1100, 650, false, At(20));
+	CHECK(debouncer.Update(At(20)));
+	CHECK_EQ(1100u, debouncer.Width());
+
+	// ő剻̓hbOł͂Ȃ
+	debouncer.OnResize(1920, 1080, false, At(500));
+	CHECK(debouncer.Update(At(500)));
+	CHECK_EQ(1920u, debouncer.Width());
+	CHECK_EQ(1080u, debouncer.Height());
+}
+
+TEST_CASE(ResizeDebouncer, ReturningToTheCurrentSizeCancels)
+{
+	ResizeDebouncer debouncer = MakeDebouncer();
+	debouncer.OnResize(1300, 720, true, At(0));
+	debouncer.OnResize(1280, 720, true, At(30));
+	CHECK(!debouncer.HasPendingResize());
+	CHECK(!debouncer.Update(At(1000)));
+	CHECK_EQ(1280u, debouncer.Width());
+}
+
+TEST_CASE(ResizeDebouncer, MinimizeKeepsTheSize)
+{
+	ResizeDebouncer debouncer = MakeDebouncer();
+	debouncer.OnResize(0, 0, false, At(0));
+	CHECK(!debouncer.Update(At(0)));
+	CHECK_EQ(1280u, debouncer.Width());
+	CHECK_EQ(720u, debouncer.Height());
+
+	// ŏ̑OɎ󂯎Ă傫͎c
+	debouncer.OnResize(1024, 768, true, At(100));
+	debouncer.OnResize(0, 0, false, At(150));
+	CHECK(debouncer.Update(At(150)));
+	CHECK_EQ(1024u, debouncer.Width());
+	CHECK_EQ(768u, debouncer.Height());
+}
+
+TEST_CASE(ResizeDebouncer, ResetDropsThePendingSize)
+{
+	ResizeDebouncer debouncer = MakeDebouncer();
+	debouncer.OnResize(800, 600, true, At(0));
+	debouncer.Reset(640, 480);
+	CHECK(!debouncer.HasPendingResize());
+	CHECK(!debouncer.Update(At(1000)));
+	CHECK_EQ(640u, debouncer.Width());
+	CHECK_EQ(480u, debouncer.Height());
+}
@@ -0,0 +1,162 @@
+#include "RootSignatureBuilder.h"
+
+#include <cstring>
+
+#include "IndirectDraw.h"
+#include "ShaderBindings.h"
+#include "TestRunner.h"
+
+using Microsoft::WRL::ComPtr;
+using namespace yuxx::DirectX12;
+
+// r_[őgݗĂ[gVOl`AȑO DirectXManager.cpp ɎŏĂLq
+// oCgɃVACY邱Ƃm߂BD3D12SerializeRootSignature ̓foCXȂœ
+namespace {
+	// ȑO InitializeGraphicsPipeline({̎lp`p)ƓLqVACY
+	ComPtr<ID3DBlob> SerializeHandWrittenBasic(D3D12_FILTER filter)
+	{
+		D3D12_DESCRIPTOR_RANGE descriptorRange{};
+		descriptorRange.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+		descriptorRange.NumDescriptors = 1;
+		descriptorRange.BaseShaderRegister = 0;
+		descriptorRange.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+		D3D12_ROOT_PARAMETER rootParameter{};
+		rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+		rootParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+		rootParameter.DescriptorTable.pDescriptorRanges = &descriptorRange;
+		rootParameter.DescriptorTable.NumDescriptorRanges = 1;
+
+		D3D12_STATIC_SAMPLER_DESC samplerDesc{};
+		samplerDesc.Filter = filter;
+		samplerDesc.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+		samplerDesc.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+		samplerDesc.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+		samplerDesc.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+		samplerDesc.BorderColor = D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK;
+		samplerDesc.MinLOD = 0.0f;
+		samplerDesc.MaxLOD = D3D12_FLOAT32_MAX;
+		samplerDesc.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+		D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc{};
+		rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+		rootSignatureDesc.pParameters = &rootParameter;
+		rootSignatureDesc.NumParameters = 1;
+		rootSignatureDesc.pStaticSamplers = &samplerDesc;
+		rootSignatureDesc.NumStaticSamplers = 1;
+		return SerializeRootSignature(rootSignatureDesc);
+	}
+
+	// ȑO InitializeCulling ƓLqVACY
+	ComPtr<ID3DBlob> SerializeHandWrittenCull()
+	{
+		D3D12_ROOT_PARAMETER rootParameters[5] = {};
+		rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+		rootParameters[0].Constants.ShaderRegister = 0;
+		rootParameters[0].Constants.Num32BitValues = sizeof(CullConstants) / sizeof(uint32_t);
+		rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+		rootParameters[1].Descriptor.ShaderRegister = 0;
+		rootParameters[2].ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+		rootParameters[2].Descriptor.ShaderRegister = 1;
+		rootParameters[3].ParameterType = D3D12_ROOT_PARAMETER_TYPE_UAV;
+		rootParameters[3].Descriptor.ShaderRegister = 0;
+		rootParameters[4].ParameterType = D3D12_ROOT_PARAMETER_TYPE_UAV;
+		rootParameters[4].Descriptor.ShaderRegister = 1;
+		for (auto& rootParameter : rootParameters) {
+			rootParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+		}
+
+		D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc{};
+		rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+		rootSignatureDesc.pParameters = rootParameters;
+		rootSignatureDesc.NumParameters = _countof(rootParameters);
+		return SerializeRootSignature(rootSignatureDesc);
+	}
+
+	bool SameBytes(const ComPtr<ID3DBlob>& a, const ComPtr<ID3DBlob>& b)
+	{
+		return a->GetBufferSize() == b->GetBufferSize() &&
+			std::memcmp(a->GetBufferPointer(), b->GetBufferPointer(), a->GetBufferSize()) == 0;
+	}
+
+	// BasicVertexShader.hlsl  BasicPixelShader.hlsl  fxc ŃRpCƂ̃tNVƓ蓖
+	ShaderReflectionData BasicPixelShaderReflection()
+	{
+		ShaderReflectionData reflection;
+		ShaderResourceBinding sampler;
+		sampler.name = "samplerState";
+		sampler.type = ShaderInputType::Sampler;
+		reflection.bindings.push_back(sampler);
+		ShaderResourceBinding texture;
+		texture.name = "tex";
+		texture.type = ShaderInputType::Texture;
+		reflection.bindings.push_back(texture);
+		return reflection;
+	}
+}
+
+TEST_CASE(RootSignatureBuilder, DeclaredBasicLayoutMatchesTheHandWrittenBlob)
+{
+	const D3D12_FILTER filters[] = { D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_FILTER_MIN_MAG_MIP_POINT };
+	for (const D3D12_FILTER filter : filters) {
+		const auto description = MakeRootSignatureDescription(
+			D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT,
+			RootParameters(
+				DescriptorTable(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, "Texture2D<float4>", "tex", 0, 1, D3D12_SHADER_VISIBILITY_PIXEL)
+			),
+			StaticSamplers(
+				StaticSampler("samplerState", filter, D3D12_TEXTURE_ADDRESS_MODE_WRAP, 0, D3D12_SHADER_VISIBILITY_PIXEL)
+			)
+		);
+		const RootSignatureDesc<1, 1> desc(description);
+		const ComPtr<ID3DBlob> built = SerializeRootSignature(desc.Get());
+		const ComPtr<ID3DBlob> handWritten = SerializeHandWrittenBasic(filter);
+		REQUIRE(built != nullptr && handWritten != nullptr);
+		CHECK(SameBytes(handWritten, built));
+	}
+}
+
+TEST_CASE(RootSignatureBuilder, ReflectedBasicLayoutMatchesTheHandWrittenBlob)
+{
+	// _VF[_[̓\[XgȂ
+	const ShaderReflectionData vertexShader;
+	const ShaderReflectionData pixelShader = BasicPixelShaderReflection();
+	const D3D12_FILTER filters[] = { D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_FILTER_MIN_MAG_MIP_POINT };
+	for (const D3D12_FILTER filter : filters) {
+		ReflectedRootSignature reflected;
+		reflected.Build(
+			{
+				{ &vertexShader, D3D12_SHADER_VISIBILITY_VERTEX },
+				{ &pixelShader, D3D12_SHADER_VISIBILITY_PIXEL },
+			},
+			D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT,
+			filter,
+			D3D12_TEXTURE_ADDRESS_MODE_WRAP
+		);
+		CHECK_EQ(0, reflected.ParameterIndex("tex"));
+		const ComPtr<ID3DBlob> built = reflected.Serialize();
+		const ComPtr<ID3DBlob> handWritten = SerializeHandWrittenBasic(filter);
+		REQUIRE(built != nullptr && handWritten != nullptr);
+		CHECK(SameBytes(handWritten, built));
+	}
+}
+
+TEST_CASE(RootSignatureBuilder, CullLayoutMatchesTheHandWrittenBlob)
+{
+	const RootSignatureDesc<5, 0> desc(kCullRootSignature);
+	const ComPtr<ID3DBlob> built = SerializeRootSignature(desc.Get());
+	const ComPtr<ID3DBlob> handWritten = SerializeHandWrittenCull();
+	REQUIRE(built != nullptr && handWritten != nullptr);
+	CHECK(SameBytes(handWritten, built));
+
+	// sɑgݗĂoH(LbV GetOrCreate g)ɂȂ
+	const ComPtr<ID3DBlob> runtime = SerializeRootSignature(
+		kCullRootSignature.flags,
+		kCullRootSignature.parameters.data(),
+		kCullRootSignature.parameters.size(),
+		nullptr,
+		0
+	);
+	REQUIRE(runtime != nullptr);
+	CHECK(SameBytes(handWritten, runtime));
+}
@@ -0,0 +1,140 @@
+#include "RootSignatureDescription.h"
+
+#include <string>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+// D3D12 ɈˑȂ(nbV HLSL ̐錾)BD3D12 ̍\̂ƓoCgɂȂ邩 RootSignatureBuilderTests Ŋm߂
+namespace {
+	// D3D12_FILTER_MIN_MAG_MIP_POINTED3D12_FILTER_MIN_MAG_MIP_LINEAR
+	constexpr uint32_t kFilterPoint = 0x0;
+	constexpr uint32_t kFilterLinear = 0x15;
+	// D3D12_TEXTURE_ADDRESS_MODE_WRAPED3D12_TEXTURE_ADDRESS_MODE_CLAMP
+	constexpr uint32_t kAddressWrap = 1;
+	constexpr uint32_t kAddressClamp = 3;
+	// D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT
+	constexpr uint32_t kAllowInputLayout = 0x1;
+
+	constexpr auto kDescription = MakeRootSignatureDescription(
+		kAllowInputLayout,
+		RootParameters(
+			RootConstants("CullConstants", "cull", 0, 4),
+			DescriptorTable(kRangeSrv, "Texture2D<float4>", "tex", 0, 1, kVisibilityPixel),
+			RootDescriptor(kRootUav, "RWByteAddressBuffer", "visibleCount", 1)
+		),
+		StaticSamplers(
+			StaticSampler("samplerState", kFilterLinear, kAddressWrap, 0, kVisibilityPixel)
+		)
+	);
+	// nbV̓RpCɌ܂
+	static_assert(HashRootSignature(kDescription) != kRootSignatureHashBasis, "HashRootSignature must be constexpr");
+
+	uint64_t RuntimeHash(const RootParameterDescription* parameters, size_t parameterCount, const StaticSamplerDescription* samplers, size_t samplerCount)
+	{
+		return HashRootSignature(kAllowInputLayout, parameters, parameterCount, samplers, samplerCount);
+	}
+
+	// kDescription  parameters[1] ւƂ̃nbV
+	uint64_t HashWithTable(const RootParameterDescription& table)
+	{
+		RootParameterDescription parameters[3] = { kDescription.parameters[0], table, kDescription.parameters[2] };
+		return RuntimeHash(parameters, 3, kDescription.samplers.data(), 1);
+	}
+
+	uint64_t HashWithSampler(const StaticSamplerDescription& sampler)
+	{
+		return RuntimeHash(kDescription.parameters.data(), 3, &sampler, 1);
+	}
+}
+
+TEST_CASE(RootSignatureDescription, TemplateAndRuntimeHashesMatch)
+{
+	// tNVgݗĂLq static ȋLqLbṼGg[ɂȂ
+	const uint64_t declared = HashRootSignature(kDescription);
+	CHECK_EQ(declared, RuntimeHash(kDescription.parameters.data(), 3, kDescription.samplers.data(), 1));
+
+	constexpr auto noSamplers = MakeRootSignatureDescription(
+		kAllowInputLayout,
+		RootParameters(DescriptorTable(kRangeSrv, "Texture2D<float4>", "tex", 0)),
+		StaticSamplers()
+	);
+	CHECK_EQ(HashRootSignature(noSamplers), RuntimeHash(noSamplers.parameters.data(), 1, nullptr, 0));
+	CHECK(HashRootSignature(noSamplers) != declared);
+
+	// HLSL p̖O̓nbVɓȂ
+	const RootParameterDescription renamed = DescriptorTable(kRangeSrv, "Texture2D<float>", "other", 0, 1, kVisibilityPixel);
+	CHECK_EQ(declared, HashWithTable(renamed));
+	const StaticSamplerDescription renamedSampler = StaticSampler("other", kFilterLinear, kAddressWrap, 0, kVisibilityPixel);
+	CHECK_EQ(declared, HashWithSampler(renamedSampler));
+}
+
+TEST_CASE(RootSignatureDescription, HashChangesWithRegisterSpaceAndVisibility)
+{
+	const uint64_t declared = HashRootSignature(kDescription);
+	const uint64_t hashes[] = {
+		declared,
+		HashWithTable(DescriptorTable(kRangeSrv, "Texture2D<float4>", "tex", 1, 1, kVisibilityPixel)),
+		HashWithTable(DescriptorTable(kRangeSrv, "Texture2D<float4>", "tex", 0, 1, kVisibilityPixel, 1)),
+		HashWithTable(DescriptorTable(kRangeSrv, "Texture2D<float4>", "tex", 0, 1, kVisibilityAll)),
+		HashWithTable(DescriptorTable(kRangeSrv, "Texture2D<float4>", "tex", 0, 1, kVisibilityVertex)),
+		HashWithTable(DescriptorTable(kRangeSrv, "Texture2D<float4>", "tex", 0, 2, kVisibilityPixel)),
+		HashWithTable(DescriptorTable(kRangeUav, "Texture2D<float4>", "tex", 0, 1, kVisibilityPixel)),
+		HashWithTable(RootDescriptor(kRootSrv, "Texture2D<float4>", "tex", 0, kVisibilityPixel)),
+		HashWithSampler(StaticSampler("samplerState", kFilterLinear, kAddressWrap, 1, kVisibilityPixel)),
+		HashWithSampler(StaticSampler("samplerState", kFilterLinear, kAddressWrap, 0, kVisibilityAll)),
+		HashWithSampler(StaticSampler("samplerState", kFilterPoint, kAddressWrap, 0, kVisibilityPixel)),
+		HashWithSampler(StaticSampler("samplerState", kFilterLinear, kAddressClamp, 0, kVisibilityPixel)),
+		HashRootSignature(0, kDescription.parameters.data(), 3, kDescription.samplers.data(), 1),
+	};
+	const size_t count = sizeof(hashes) / sizeof(hashes[0]);
+	for (size_t i = 0; i < count; ++i) {
+		for (size_t j = i + 1; j < count; ++j) {
+			CHECK(hashes[i] != hashes[j]);
+		}
+	}
+}
+
+TEST_CASE(RootSignatureDescription, HlslDeclarationPerParameterType)
+{
+	CHECK_EQ(std::string("Texture2D<float4> tex : register(t0);\n"),
+		HlslRegisterDeclaration(DescriptorTable(kRangeSrv, "Texture2D<float4>", "tex", 0)));
+	// fBXNv^ΔzAspace  0 łȂ space 
+	CHECK_EQ(std::string("Texture2D<float4> textures[4] : register(t2, space1);\n"),
+		HlslRegisterDeclaration(DescriptorTable(kRangeSrv, "Texture2D<float4>", "textures", 2, 4, kVisibilityPixel, 1)));
+	CHECK_EQ(std::string("RWTexture2D<float4> destination : register(u3);\n"),
+		HlslRegisterDeclaration(DescriptorTable(kRangeUav, "RWTexture2D<float4>", "destination", 3)));
+	CHECK_EQ(std::string("cbuffer scene : register(b1);\n"),
+		HlslRegisterDeclaration(DescriptorTable(kRangeCbv, "cbuffer", "scene", 1)));
+	CHECK_EQ(std::string("SamplerState samplers[2] : register(s0);\n"),
+		HlslRegisterDeclaration(DescriptorTable(kRangeSampler, "SamplerState", "samplers", 0, 2)));
+
+	// [g萔 hlslType 1 cbuffer ɂȂ
+	CHECK_EQ(std::string("cbuffer cullConstants : register(b0, space2)\n{\n    CullConstants cull;\n};\n"),
+		HlslRegisterDeclaration(RootConstants("CullConstants", "cull", 0, 4, kVisibilityAll, 2)));
+
+	// [gɒڒufBXNv^͔zɂȂȂ
+	CHECK_EQ(std::string("StructuredBuffer<Aabb> bounds : register(t5);\n"),
+		HlslRegisterDeclaration(RootDescriptor(kRootSrv, "StructuredBuffer<Aabb>", "bounds", 5)));
+	CHECK_EQ(std::string("RWByteAddressBuffer visibleCount : register(u1);\n"),
+		HlslRegisterDeclaration(RootDescriptor(kRootUav, "RWByteAddressBuffer", "visibleCount", 1)));
+	CHECK_EQ(std::string("ConstantBuffer<Scene> scene : register(b2, space1);\n"),
+		HlslRegisterDeclaration(RootDescriptor(kRootCbv, "ConstantBuffer<Scene>", "scene", 2, kVisibilityAll, 1)));
+
+	CHECK_EQ(std::string("SamplerState samplerState : register(s3);\n"),
+		HlslRegisterDeclaration(StaticSampler("samplerState", kFilterLinear, kAddressWrap, 3)));
+}
+
+TEST_CASE(RootSignatureDescription, GeneratedHlslListsParametersThenSamplers)
+{
+	CHECK_EQ(
+		std::string(
+			"cbuffer cullConstants : register(b0)\n{\n    CullConstants cull;\n};\n"
+			"Texture2D<float4> tex : register(t0);\n"
+			"RWByteAddressBuffer visibleCount : register(u1);\n"
+			"SamplerState samplerState : register(s0);\n"
+		),
+		GenerateHlslRegisters(kDescription)
+	);
+}
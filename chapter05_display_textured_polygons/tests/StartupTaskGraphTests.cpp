@@ -0,0 +1,142 @@
+#include "StartupTaskGraph.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	JobSystem::Options WorkerOptions()
+	{
+		JobSystem::Options options;
+		options.workerCount = 3;
+		return options;
+	}
+
+	// I id L^
+	class CompletionLog
+	{
+	public:
+		std::function<bool()> Step(int id, bool succeeds = true)
+		{
+			return [this, id, succeeds]() {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_order.push_back(id);
+				return succeeds;
+			};
+		}
+		// L^ĂȂ -1
+		int Position(int id) const
+		{
+			for (size_t i = 0; i < m_order.size(); ++i) {
+				if (m_order[i] == id) {
+					return static_cast<int>(i);
+				}
+			}
+			return -1;
+		}
+		size_t Count() const { return m_order.size(); }
+
+	private:
+		std::mutex m_mutex;
+		std::vector<int> m_order;
+	};
+}
+
+TEST_CASE(StartupTaskGraph, RunsStepsAfterTheirDependencies)
+{
+	JobSystem jobSystem(WorkerOptions());
+	for (int round = 0; round < 50; ++round) {
+		CompletionLog log;
+		StartupTaskGraph startup;
+		const auto factory = startup.Add("factory", log.Step(0));
+		const auto device = startup.Add("device", log.Step(1), { factory });
+		const auto shaders = startup.Add("shaders", log.Step(2));
+		startup.Add("pipeline", log.Step(3), { device, shaders });
+		const auto texture = startup.Add("texture", log.Step(4), { device });
+		startup.Add("srv", log.Step(5), { texture });
+
+		REQUIRE(startup.Run(jobSystem));
+		REQUIRE_EQ(size_t(6), log.Count());
+		CHECK(log.Position(0) < log.Position(1));
+		CHECK(log.Position(1) < log.Position(3));
+		CHECK(log.Position(2) < log.Position(3));
+		CHECK(log.Position(1) < log.Position(4));
+		CHECK(log.Position(4) < log.Position(5));
+	}
+}
+
+TEST_CASE(StartupTaskGraph, RunsMainThreadStepsOnTheMainThread)
+{
+	JobSystem jobSystem(WorkerOptions());
+	std::atomic<int> windowThread{ -1 };
+	std::atomic<int> swapChainThread{ -1 };
+	StartupTaskGraph startup;
+	const auto device = startup.Add("device", []() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		return true;
+	});
+	const auto window = startup.Add("window", [&]() {
+		windowThread = jobSystem.CurrentThreadIndex();
+		return true;
+	}, {}, true);
+	// [J[ŏIˑ悩ς܂ĂACXbhŎs
+	startup.Add("swapChain", [&]() {
+		swapChainThread = jobSystem.CurrentThreadIndex();
+		return true;
+	}, { window, device }, true);
+
+	REQUIRE(startup.Run(jobSystem));
+	CHECK_EQ(0, windowThread.load());
+	CHECK_EQ(0, swapChainThread.load());
+}
+
+TEST_CASE(StartupTaskGraph, SkipsDependentsOfAFailedStep)
+{
+	JobSystem jobSystem(WorkerOptions());
+	CompletionLog log;
+	StartupTaskGraph startup;
+	const auto adapter = startup.Add("adapter", log.Step(0, false));
+	const auto device = startup.Add("device", log.Step(1), { adapter });
+	startup.Add("pipeline", log.Step(2), { device });
+
+	CHECK(!startup.Run(jobSystem));
+	CHECK_EQ(size_t(1), log.Count());
+	CHECK_EQ(-1, log.Position(1));
+	CHECK_EQ(-1, log.Position(2));
+}
+
+TEST_CASE(StartupTaskGraph, CanRunAgain)
+{
+	JobSystem jobSystem(WorkerOptions());
+	std::atomic<int> runs{ 0 };
+	StartupTaskGraph startup;
+	const auto first = startup.Add("first", [&]() { ++runs; return true; });
+	startup.Add("second", [&]() { ++runs; return true; }, { first });
+
+	REQUIRE(startup.Run(jobSystem));
+	REQUIRE(startup.Run(jobSystem));
+	CHECK_EQ(4, runs.load());
+}
+
+TEST_CASE(StartupTaskGraph, OverlapsIndependentSteps)
+{
+	// 3{̓Ɨ 20ms ̃Xebv́A 60ms \I(邾Ȃ̂1RAłdȂ)
+	JobSystem jobSystem(WorkerOptions());
+	StartupTaskGraph startup;
+	for (int i = 0; i < 3; ++i) {
+		startup.Add("sleep", []() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			return true;
+		});
+	}
+	const auto start = std::chrono::steady_clock::now();
+	REQUIRE(startup.Run(jobSystem));
+	const auto elapsed = std::chrono::steady_clock::now() - start;
+	CHECK(elapsed < std::chrono::milliseconds(50));
+}
@@ -0,0 +1,213 @@
+#include "SwapChainResize.h"
+
+#include <string>
+#include <vector>
+
+#include "NullCommandRecorder.h"
+#include "ResizeDebouncer.h"
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// DirectXManager ̑B`̑傫 NullCommandRecorder ɓ`A
+	// DXGI ƓAobNobt@[܂܂ ResizeBuffers ͎s
+	class FakeSwapChain : public SwapChainTargets
+	{
+	public:
+		FakeSwapChain(NullCommandRecorder& recorder, uint32_t width, uint32_t height) :
+			m_recorder(recorder),
+			m_width(width),
+			m_height(height)
+		{
+			m_recorder.SetRenderTargetSize(width, height);
+		}
+
+		bool FlushFrames() override
+		{
+			m_calls.push_back("FlushFrames");
+			m_pendingFrames = 0;
+			return m_failingCall != "FlushFrames";
+		}
+
+		void ReleaseBackBuffers() override
+		{
+			m_calls.push_back("ReleaseBackBuffers");
+			m_backBuffersHeld = false;
+			m_recorder.SetRenderTargetSize(0, 0);
+		}
+
+		bool ResizeBuffers(uint32_t width, uint32_t height) override
+		{
+			m_calls.push_back("ResizeBuffers");
+			if (m_backBuffersHeld || m_pendingFrames != 0 || m_failingCall == "ResizeBuffers") {
+				return false;
+			}
+			m_width = width;
+			m_height = height;
+			return true;
+		}
+
+		bool CreateBackBufferViews() override
+		{
+			m_calls.push_back("CreateBackBufferViews");
+			if (m_failingCall == "CreateBackBufferViews") {
+				return false;
+			}
+			m_backBuffersHeld = true;
+			return true;
+		}
+
+		bool ResizeRenderTargets(uint32_t width, uint32_t height) override
+		{
+			m_calls.push_back("ResizeRenderTargets");
+			if (m_failingCall == "ResizeRenderTargets") {
+				return false;
+			}
+			m_targetWidth = width;
+			m_targetHeight = height;
+			m_recorder.SetRenderTargetSize(width, height);
+			return true;
+		}
+
+		// `1t[L^Đς񂾂Ƃɂ
+		void RecordFrame(float scale)
+		{
+			uint32_t renderWidth = 0;
+			uint32_t renderHeight = 0;
+			ScaledRenderSize(m_targetWidth, m_targetHeight, scale, renderWidth, renderHeight);
+			const float clearColor[] = { 1.0f, 1.0f, 0.0f, 1.0f };
+			m_recorder.BeginFrame();
+			m_recorder.ClearRenderTarget(clearColor);
+			m_recorder.SetViewport({ 0.0f, 0.0f, static_cast<float>(renderWidth), static_cast<float>(renderHeight), 0.0f, 1.0f });
+			m_recorder.SetScissorRect({ 0, 0, static_cast<int32_t>(renderWidth), static_cast<int32_t>(renderHeight) });
+			m_recorder.EndFrame();
+			++m_pendingFrames;
+		}
+
+		void FailAt(const std::string& call) { m_failingCall = call; }
+		const std::vector<std::string>& Calls() const { return m_calls; }
+		void ClearCalls() { m_calls.clear(); }
+		uint32_t Width() const { return m_width; }
+		uint32_t Height() const { return m_height; }
+
+	private:
+		NullCommandRecorder& m_recorder;
+		std::vector<std::string> m_calls;
+		std::string m_failingCall;
+		uint32_t m_width;
+		uint32_t m_height;
+		uint32_t m_targetWidth = m_width;
+		uint32_t m_targetHeight = m_height;
+		bool m_backBuffersHeld = true;
+		uint32_t m_pendingFrames = 0;
+	};
+}
+
+TEST_CASE(SwapChainResize, RebuildsInOrder)
+{
+	NullCommandRecorder recorder(true);
+	FakeSwapChain swapChain(recorder, 1280, 720);
+	swapChain.RecordFrame(1.0f);
+	swapChain.RecordFrame(1.0f);
+
+	REQUIRE(RebuildSizeDependentTargets(swapChain, 800, 600));
+	const std::vector<std::string> expected = {
+		"FlushFrames", "ReleaseBackBuffers", "ResizeBuffers", "CreateBackBufferViews", "ResizeRenderTargets",
+	};
+	CHECK(expected == swapChain.Calls());
+	CHECK_EQ(800u, swapChain.Width());
+	CHECK_EQ(600u, swapChain.Height());
+
+	// 蒼Ƃ̃t[͐V傫ŋL^
+	swapChain.RecordFrame(1.0f);
+	swapChain.RecordFrame(0.5f);
+	CHECK_EQ(0u, recorder.ErrorCount());
+}
+
+TEST_CASE(SwapChainResize, StopsAtTheFirstFailure)
+{
+	const std::vector<std::string> steps = {
+		"FlushFrames", "ResizeBuffers", "CreateBackBufferViews", "ResizeRenderTargets",
+	};
+	for (const std::string& failing : steps) {
+		NullCommandRecorder recorder(true);
+		FakeSwapChain swapChain(recorder, 1280, 720);
+		swapChain.FailAt(failing);
+		CHECK(!RebuildSizeDependentTargets(swapChain, 800, 600));
+		REQUIRE(!swapChain.Calls().empty());
+		CHECK_EQ(failing, swapChain.Calls().back());
+	}
+}
+
+TEST_CASE(SwapChainResize, MinimizedWindowIsLeftAlone)
+{
+	NullCommandRecorder recorder(true);
+	FakeSwapChain swapChain(recorder, 1280, 720);
+	CHECK(RebuildSizeDependentTargets(swapChain, 0, 0));
+	CHECK(RebuildSizeDependentTargets(swapChain, 800, 0));
+	CHECK(swapChain.Calls().empty());
+	CHECK_EQ(1280u, swapChain.Width());
+}
+
+TEST_CASE(SwapChainResize, FramesRecordedAgainstTheOldSizeAreReported)
+{
+	// 蒼ĂrA蒼Ȏ傫ŋL^ NullCommandRecorder 
+	NullCommandRecorder recorder(true);
+	recorder.SetRenderTargetSize(0, 0);
+	recorder.BeginFrame();
+	recorder.EndFrame();
+	CHECK_EQ(1u, recorder.ErrorCount());
+
+	recorder.ResetStats();
+	recorder.SetRenderTargetSize(800, 600);
+	recorder.BeginFrame();
+	recorder.SetViewport({ 0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f });
+	recorder.SetScissorRect({ 0, 0, 1280, 720 });
+	recorder.EndFrame();
+	CHECK_EQ(2u, recorder.ErrorCount());
+}
+
+TEST_CASE(SwapChainResize, DebouncedDragRebuildsOnce)
+{
+	// OnResize t[pPbgA`摤ł̍蒼܂łA߂ė
+	using Clock = ResizeDebouncer::Clock;
+	NullCommandRecorder recorder(true);
+	FakeSwapChain swapChain(recorder, 1280, 720);
+	ResizeDebouncer debouncer(std::chrono::milliseconds(100));
+	debouncer.Reset(1280, 720);
+
+	uint32_t rebuildCount = 0;
+	for (int frame = 0; frame < 40; ++frame) {
+		const Clock::time_point now = Clock::time_point() + std::chrono::milliseconds(16 * frame);
+		// ŏ 10 t[͘ghbOĂ
+		if (frame < 10) {
+			debouncer.OnResize(1280 - 20 * (frame + 1), 720 - 10 * (frame + 1), true, now);
+		}
+		debouncer.Update(now);
+		if (debouncer.Width() != swapChain.Width() || debouncer.Height() != swapChain.Height()) {
+			REQUIRE(RebuildSizeDependentTargets(swapChain, debouncer.Width(), debouncer.Height()));
+			++rebuildCount;
+		}
+		swapChain.RecordFrame(frame % 2 == 0 ? 1.0f : 0.75f);
+	}
+	CHECK_EQ(1u, rebuildCount);
+	CHECK_EQ(1080u, swapChain.Width());
+	CHECK_EQ(620u, swapChain.Height());
+	CHECK_EQ(0u, recorder.ErrorCount());
+}
+
+TEST_CASE(SwapChainResize, ScaledRenderSizeRoundsAndStaysPositive)
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	ScaledRenderSize(1280, 720, 1.0f, width, height);
+	CHECK_EQ(1280u, width);
+	CHECK_EQ(720u, height);
+	ScaledRenderSize(1281, 721, 0.5f, width, height);
+	CHECK_EQ(641u, width);
+	CHECK_EQ(361u, height);
+	ScaledRenderSize(1, 1, 0.5f, width, height);
+	CHECK_EQ(1u, width);
+	CHECK_EQ(1u, height);
+}
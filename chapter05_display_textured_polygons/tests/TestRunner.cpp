@@ -0,0 +1,97 @@
+#include "TestRunner.h"
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <vector>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace Test {
+namespace {
+	struct TestCase
+	{
+		const char* suite;
+		const char* name;
+		TestFunction function;
+	};
+
+	// ÓȈԂɈˑȂ悤A֐̒ō
+	std::vector<TestCase>& TestCases()
+	{
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+
+	int g_failureCount = 0;
+}
+
+Registrar::Registrar(const char* suite, const char* name, TestFunction function)
+{
+	TestCases().push_back({ suite, name, function });
+}
+
+void Fail(const char* file, int line, const std::string& message, bool fatal)
+{
+	printf("%s(%d): failed: %s\n", file, line, message.c_str());
+	++g_failureCount;
+	if (fatal) {
+		throw FatalFailure();
+	}
+}
+
+std::string SourcePath(const std::string& relativePath)
+{
+#ifdef YUXX_SOURCE_DIR
+	return std::string(YUXX_SOURCE_DIR) + "/" + relativePath;
+#else
+	return relativePath;
+#endif // YUXX_SOURCE_DIR
+}
+
+int RunTests(const std::string& suite)
+{
+	int testCount = 0;
+	int failedTestCount = 0;
+	for (const TestCase& testCase : TestCases()) {
+		if (!suite.empty() && suite != testCase.suite) {
+			continue;
+		}
+		++testCount;
+		printf("[ RUN      ] %s.%s\n", testCase.suite, testCase.name);
+		fflush(stdout);
+
+		const int failureCount = g_failureCount;
+		const auto start = std::chrono::steady_clock::now();
+		try {
+			testCase.function();
+		} catch (const FatalFailure&) {
+		} catch (const std::exception& exception) {
+			Fail(testCase.suite, 0, std::string("unexpected exception: ") + exception.what(), false);
+		}
+		const double milliseconds =
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		const bool failed = g_failureCount != failureCount;
+		if (failed) {
+			++failedTestCount;
+		}
+		printf("[ %8s ] %s.%s (%.1f ms)\n", failed ? "FAILED" : "OK", testCase.suite, testCase.name, milliseconds);
+	}
+
+	if (testCount == 0) {
+		printf("No tests in suite '%s'\n", suite.c_str());
+		return 1;
+	}
+	printf("%d tests, %d failed\n", testCount, failedTestCount);
+	return failedTestCount == 0 ? 0 : 1;
+}
+}
+}
+}
+
+// core_tests [XC[g]
+int main(int argc, char** argv)
+{
+	return yuxx::DirectX12::Test::RunTests(argc > 1 ? argv[1] : "");
+}
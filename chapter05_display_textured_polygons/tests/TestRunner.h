@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace yuxx {
+namespace DirectX12 {
+namespace Test {
+// RÃeXg̓o^ƎsBD3D12 ɂÕCuɂˑȂB
+// eXg TEST_CASE(XC[g, O) ŏAXC[gƂ ctest 1ڂɂȂ
+using TestFunction = void (*)();
+
+class Registrar
+{
+public:
+	Registrar(const char* suite, const char* name, TestFunction function);
+};
+
+// REQUIRE sƂɓÃeXgł؂
+struct FatalFailure
+{
+};
+
+void Fail(const char* file, int line, const std::string& message, bool fatal);
+
+// \[Xc[(CMakeLists.txt ̂ꏊ)̑΃pXAeXg𓮂ꏊJpXɂ
+std::string SourcePath(const std::string& relativePath);
+
+template <typename T>
+std::string ToString(const T& value)
+{
+	std::ostringstream stream;
+	stream << value;
+	return stream.str();
+}
+inline std::string ToString(uint8_t value) { return ToString(static_cast<unsigned int>(value)); }
+inline std::string ToString(int8_t value) { return ToString(static_cast<int>(value)); }
+
+template <typename Expected, typename Actual>
+void CheckEqual(
+	const char* file,
+	int line,
+	const char* expression,
+	const Expected& expected,
+	const Actual& actual,
+	bool fatal
+) {
+	if (!(expected == actual)) {
+		Fail(file, line, std::string(expression) + " (expected " + ToString(expected) + ", actual " + ToString(actual) + ")", fatal);
+	}
+}
+
+// suite Ȃ炷ׂẴeXgAłȂ΂̃XC[g𓮂Bs 1
+int RunTests(const std::string& suite);
+}
+}
+}
+
+#define TEST_CASE(suite, name) \
+	static void suite##_##name(); \
+	static const ::yuxx::DirectX12::Test::Registrar suite##_##name##_registrar(#suite, #name, &suite##_##name); \
+	static void suite##_##name()
+
+#define CHECK(expression) \
+	do { \
+		if (!(expression)) { \
+			::yuxx::DirectX12::Test::Fail(__FILE__, __LINE__, #expression, false); \
+		} \
+	} while (false)
+#define REQUIRE(expression) \
+	do { \
+		if (!(expression)) { \
+			::yuxx::DirectX12::Test::Fail(__FILE__, __LINE__, #expression, true); \
+		} \
+	} while (false)
+#define CHECK_EQ(expected, actual) \
+	::yuxx::DirectX12::Test::CheckEqual(__FILE__, __LINE__, #expected " == " #actual, (expected), (actual), false)
+#define REQUIRE_EQ(expected, actual) \
+	::yuxx::DirectX12::Test::CheckEqual(__FILE__, __LINE__, #expected " == " #actual, (expected), (actual), true)
+#define CHECK_NEAR(expected, actual, tolerance) \
+	do { \
+		const double testExpected = (expected); \
+		const double testActual = (actual); \
+		if (!(testActual >= testExpected - (tolerance) && testActual <= testExpected + (tolerance))) { \
+			::yuxx::DirectX12::Test::Fail( \
+				__FILE__, \
+				__LINE__, \
+				#actual " ~ " #expected " (expected " + ::yuxx::DirectX12::Test::ToString(testExpected) + \
+					", actual " + ::yuxx::DirectX12::Test::ToString(testActual) + ")", \
+				false \
+			); \
+		} \
+	} while (false)
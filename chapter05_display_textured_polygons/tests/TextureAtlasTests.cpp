@@ -0,0 +1,186 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	using Sizes = std::vector<std::pair<uint32_t, uint32_t>>;
+
+	// 16`128 sNZ̉摜Aʐς̍vAgX coverage {𒴂܂ō
+	Sizes MakeRandomSizes(uint32_t atlasSize, float coverage, unsigned int seed)
+	{
+		std::mt19937 random(seed);
+		std::uniform_int_distribution<uint32_t> size(16, 128);
+		Sizes sizes;
+		uint64_t area = 0;
+		while (area < coverage * atlasSize * atlasSize) {
+			const uint32_t width = size(random);
+			const uint32_t height = size(random);
+			sizes.emplace_back(width, height);
+			area += static_cast<uint64_t>(width) * height;
+		}
+		return sizes;
+	}
+
+	// K^[܂߂`ǂdȂ炸AAgX͂ݏoĂȂ
+	bool IsValidPacking(const std::vector<AtlasRegion>& regions, uint32_t atlasSize, uint32_t padding)
+	{
+		// K^[܂߂ [left, right) x [top, bottom)
+		struct Rect
+		{
+			int64_t left, top, right, bottom;
+		};
+		std::vector<Rect> rects;
+		for (const AtlasRegion& region : regions) {
+			rects.push_back({
+				static_cast<int64_t>(region.x) - padding,
+				static_cast<int64_t>(region.y) - padding,
+				static_cast<int64_t>(region.x) + region.width + padding,
+				static_cast<int64_t>(region.y) + region.height + padding
+			});
+		}
+		for (size_t i = 0; i < rects.size(); ++i) {
+			const Rect& a = rects[i];
+			if (a.left < 0 || a.top < 0 || a.right > atlasSize || a.bottom > atlasSize) {
+				return false;
+			}
+			for (size_t j = i + 1; j < rects.size(); ++j) {
+				const Rect& b = rects[j];
+				if (a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	uint32_t PixelAt(const std::vector<uint8_t>& pixels, size_t rowPitch, uint32_t x, uint32_t y)
+	{
+		uint32_t pixel = 0;
+		std::memcpy(&pixel, pixels.data() + y * rowPitch + x * 4, sizeof(pixel));
+		return pixel;
+	}
+}
+
+TEST_CASE(TextureAtlas, BatchPacksDensely)
+{
+	constexpr uint32_t kAtlasSize = 1024;
+	for (unsigned int seed = 1; seed <= 3; ++seed) {
+		// 摜̖ʐς̍vAgX 85% Ă肫
+		const Sizes sizes = MakeRandomSizes(kAtlasSize, 0.85f, seed);
+		TextureAtlas atlas(kAtlasSize, kAtlasSize, 0);
+		std::vector<AtlasRegion> regions;
+		REQUIRE(atlas.InsertBatch(sizes, regions));
+		CHECK(atlas.Occupancy() >= 0.85f);
+		CHECK(IsValidPacking(regions, kAtlasSize, 0));
+
+		// 1ƂAȂ̂΂ȂĂ 80% ͖܂
+		TextureAtlas sequential(kAtlasSize, kAtlasSize, 0);
+		const Sizes moreSizes = MakeRandomSizes(kAtlasSize, 1.2f, seed);
+		AtlasRegion region;
+		size_t rejectedCount = 0;
+		for (const auto& size : moreSizes) {
+			rejectedCount += sequential.Insert(size.first, size.second, region) ? 0 : 1;
+		}
+		CHECK(rejectedCount > 0);
+		CHECK(sequential.Occupancy() > 0.8f);
+	}
+}
+
+TEST_CASE(TextureAtlas, PaddingKeepsGuttersApart)
+{
+	constexpr uint32_t kAtlasSize = 1024;
+	constexpr uint32_t kPadding = 4;
+	const Sizes sizes = MakeRandomSizes(kAtlasSize, 0.6f, 7);
+	TextureAtlas atlas(kAtlasSize, kAtlasSize, kPadding);
+	std::vector<AtlasRegion> regions;
+	REQUIRE(atlas.InsertBatch(sizes, regions));
+	REQUIRE_EQ(sizes.size(), regions.size());
+	CHECK(IsValidPacking(regions, kAtlasSize, kPadding));
+	// regions  sizes Ɠɕ
+	size_t wrongSizeCount = 0;
+	for (size_t i = 0; i < sizes.size(); ++i) {
+		wrongSizeCount += regions[i].width != sizes[i].first || regions[i].height != sizes[i].second ? 1 : 0;
+	}
+	CHECK_EQ(0u, wrongSizeCount);
+
+	// UV ̓AgX̑傫Ŋ
+	float u = 1.0f;
+	float v = 0.0f;
+	RemapUv(regions[0], u, v);
+	CHECK_NEAR(static_cast<float>(regions[0].x + regions[0].width) / kAtlasSize, u, 1e-6f);
+	CHECK_NEAR(static_cast<float>(regions[0].y) / kAtlasSize, v, 1e-6f);
+}
+
+TEST_CASE(TextureAtlas, RejectsEmptyAndOversizedImages)
+{
+	TextureAtlas atlas(256, 256, 2);
+	AtlasRegion region;
+	CHECK(!atlas.Insert(0, 16, region));
+	CHECK(!atlas.Insert(16, 0, region));
+	// K^[܂߂ƓȂ
+	CHECK(!atlas.Insert(254, 16, region));
+	CHECK(atlas.Insert(252, 16, region));
+	CHECK_NEAR(252.0 * 16 / (256 * 256), atlas.Occupancy(), 1e-6);
+}
+
+TEST_CASE(TextureAtlas, BlitExtendsEdgesIntoGutter)
+{
+	constexpr uint32_t kAtlasSize = 16;
+	constexpr uint32_t kPadding = 2;
+	const size_t atlasPitch = kAtlasSize * 4;
+	std::vector<uint8_t> atlasPixels(atlasPitch * kAtlasSize, 0);
+
+	// 3x2 ̉摜BsNZƂɈႤlɂĂ
+	constexpr uint32_t kWidth = 3;
+	constexpr uint32_t kHeight = 2;
+	std::vector<uint8_t> image(kWidth * kHeight * 4);
+	for (size_t i = 0; i < image.size(); ++i) {
+		image[i] = static_cast<uint8_t>(i + 1);
+	}
+	std::vector<uint8_t> imageCopy = image;
+	const auto imagePixel = [&](uint32_t x, uint32_t y) { return PixelAt(imageCopy, kWidth * 4, x, y); };
+
+	TextureAtlas atlas(kAtlasSize, kAtlasSize, kPadding);
+	AtlasRegion region;
+	REQUIRE(atlas.Insert(kWidth, kHeight, region));
+	BlitWithGutter(atlasPixels.data(), atlasPitch, kAtlasSize, kAtlasSize, image.data(), kWidth * 4, region, kPadding);
+
+	size_t wrongCount = 0;
+	for (uint32_t y = region.y - kPadding; y < region.y + kHeight + kPadding; ++y) {
+		for (uint32_t x = region.x - kPadding; x < region.x + kWidth + kPadding; ++x) {
+			// K^[͈ԋ߂[̃sNZƓ
+			const uint32_t sourceX = x < region.x ? 0 : (std::min)(x - region.x, kWidth - 1);
+			const uint32_t sourceY = y < region.y ? 0 : (std::min)(y - region.y, kHeight - 1);
+			wrongCount += PixelAt(atlasPixels, atlasPitch, x, y) != imagePixel(sourceX, sourceY) ? 1 : 0;
+		}
+	}
+	CHECK_EQ(0u, wrongCount);
+	// K^[̊O͏Ȃ
+	CHECK_EQ(0u, PixelAt(atlasPixels, atlasPitch, region.x + kWidth + kPadding, region.y));
+	CHECK_EQ(0u, PixelAt(atlasPixels, atlasPitch, region.x, region.y + kHeight + kPadding));
+}
+
+TEST_CASE(TextureAtlas, BlitSkipsEmptyRegions)
+{
+	constexpr uint32_t kAtlasSize = 8;
+	std::vector<uint8_t> atlasPixels(kAtlasSize * kAtlasSize * 4, 0);
+	const uint8_t pixel[4] = { 1, 2, 3, 4 };
+	// 0łA[̃sNZTɔ͈͊Oǂ܂Ȃ
+	const AtlasRegion emptyRegions[] = {
+		{ 2, 2, 0, 3, 0.0f, 0.0f, 0.0f, 0.0f },
+		{ 2, 2, 3, 0, 0.0f, 0.0f, 0.0f, 0.0f },
+	};
+	for (const AtlasRegion& region : emptyRegions) {
+		BlitWithGutter(atlasPixels.data(), kAtlasSize * 4, kAtlasSize, kAtlasSize, pixel, 4, region, 2);
+	}
+	CHECK(std::all_of(atlasPixels.begin(), atlasPixels.end(), [](uint8_t value) { return value == 0; }));
+}
@@ -0,0 +1,242 @@
+#include "TextureConversion.h"
+
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// s̋lߕBϊœǂł܂Βlɏo
+	constexpr uint8_t kPadding = 0xEE;
+
+	// fƂɈႤoCgׂ摜Bš̋lߕ kPadding ɂ
+	std::vector<uint8_t> MakeSource(uint32_t width, uint32_t height, uint32_t sourceFormat)
+	{
+		const uint32_t bytesPerPixel = SourceBytesPerPixel(sourceFormat);
+		const uint32_t rowPitch = SourceRowPitch(width, sourceFormat);
+		std::vector<uint8_t> source(SourceBufferSize(width, height, sourceFormat), kPadding);
+		for (uint32_t y = 0; y < height; ++y) {
+			for (uint32_t x = 0; x < width * bytesPerPixel; ++x) {
+				source[static_cast<size_t>(y) * rowPitch + x] = static_cast<uint8_t>(y * 64 + x * 5 + 1);
+			}
+		}
+		return source;
+	}
+
+	const float* Pixel(const ConvertedImage& image, uint32_t x, uint32_t y)
+	{
+		return &image.pixels[(static_cast<size_t>(y) * image.width + x) * 4];
+	}
+
+	// Ԃ value Aق 0Aa  1 ̉摜
+	ConvertedImage MakeImage(uint32_t width, uint32_t height, float (*value)(uint32_t x, uint32_t y))
+	{
+		ConvertedImage image;
+		image.width = width;
+		image.height = height;
+		image.pixels.assign(static_cast<size_t>(width) * height * 4, 0.0f);
+		for (uint32_t y = 0; y < height; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				float* pixel = &image.pixels[(static_cast<size_t>(y) * width + x) * 4];
+				pixel[0] = value(x, y);
+				pixel[3] = 1.0f;
+			}
+		}
+		return image;
+	}
+
+	void CheckSize(const ConvertedImage& image, uint32_t width, uint32_t height)
+	{
+		CHECK_EQ(width, image.width);
+		CHECK_EQ(height, image.height);
+		CHECK_EQ(static_cast<size_t>(width) * height * 4, image.pixels.size());
+	}
+}
+
+TEST_CASE(TextureConversion, SourceRowsAreAlignedToFourBytes)
+{
+	// 3oCg̉f͍s4oCgɑAŌ4oCgǂ݂镪𑫂
+	CHECK_EQ(4u, SourceRowPitch(1, kSourceBgr8));
+	CHECK_EQ(12u, SourceRowPitch(3, kSourceBgr8));
+	CHECK_EQ(12u, SourceRowPitch(4, kSourceBgr8));
+	CHECK_EQ(16u, SourceRowPitch(5, kSourceRgb8));
+	CHECK_EQ(20u, SourceRowPitch(5, kSourceRgba8));
+	CHECK_EQ(static_cast<size_t>(12 * 2 + 4), SourceBufferSize(3, 2, kSourceBgr8));
+
+	const TextureConversionConstants constants = MakeTextureConversionConstants(7, 3, kSourceBgr8, kConvertLinearize);
+	CHECK_EQ(7u, constants.width);
+	CHECK_EQ(3u, constants.height);
+	CHECK_EQ(24u, constants.sourceRowPitch);
+	CHECK_EQ(static_cast<uint32_t>(kSourceBgr8), constants.sourceFormat);
+	CHECK_EQ(static_cast<uint32_t>(kConvertLinearize), constants.flags);
+}
+
+TEST_CASE(TextureConversion, Bgr8ToRgba8SwapsChannelsAndSkipsPadding)
+{
+	//  3  9 oCgȂ̂ŁAsƂ 3 oCg̋lߕ
+	const uint32_t width = 3;
+	const uint32_t height = 2;
+	const std::vector<uint8_t> source = MakeSource(width, height, kSourceBgr8);
+	ConvertedImage converted;
+	ConvertTextureReference(source.data(), MakeTextureConversionConstants(width, height, kSourceBgr8, 0), converted);
+	CheckSize(converted, width, height);
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			const uint8_t* bgr = &source[static_cast<size_t>(y) * 12 + x * 3];
+			const float* rgba = Pixel(converted, x, y);
+			CHECK_EQ(bgr[2] / 255.0f, rgba[0]);
+			CHECK_EQ(bgr[1] / 255.0f, rgba[1]);
+			CHECK_EQ(bgr[0] / 255.0f, rgba[2]);
+			CHECK_EQ(1.0f, rgba[3]);
+		}
+	}
+	for (const float value : converted.pixels) {
+		CHECK(value != kPadding / 255.0f);
+	}
+}
+
+TEST_CASE(TextureConversion, ReadsEveryChannelOrder)
+{
+	// 1x1 ̉f { 10, 20, 30, 40 } ꂼ̕тƂēǂ
+	const uint8_t source[8] = { 10, 20, 30, 40, kPadding, kPadding, kPadding, kPadding };
+	struct Case
+	{
+		uint32_t format;
+		uint8_t r;
+		uint8_t g;
+		uint8_t b;
+		float a;
+	};
+	const Case cases[] = {
+		{ kSourceRgb8, 10, 20, 30, 1.0f },
+		{ kSourceBgr8, 30, 20, 10, 1.0f },
+		{ kSourceRgba8, 10, 20, 30, 40 / 255.0f },
+		{ kSourceBgra8, 30, 20, 10, 40 / 255.0f },
+	};
+	for (const Case& c : cases) {
+		ConvertedImage converted;
+		ConvertTextureReference(source, MakeTextureConversionConstants(1, 1, c.format, 0), converted);
+		CheckSize(converted, 1, 1);
+		CHECK_EQ(c.r / 255.0f, converted.pixels[0]);
+		CHECK_EQ(c.g / 255.0f, converted.pixels[1]);
+		CHECK_EQ(c.b / 255.0f, converted.pixels[2]);
+		CHECK_EQ(c.a, converted.pixels[3]);
+	}
+}
+
+TEST_CASE(TextureConversion, LinearizesBeforePremultiplying)
+{
+	// BGRA: EEԂ̊DFBa ͐`ɂȂ
+	const uint8_t source[12 + 4] = {
+		255, 255, 255, 51,
+		0, 0, 0, 255,
+		188, 188, 188, 255,
+	};
+	ConvertedImage converted;
+	ConvertTextureReference(source, MakeTextureConversionConstants(3, 1, kSourceBgra8, kConvertLinearize | kConvertPremultiply), converted);
+	CHECK_EQ(51 / 255.0f, Pixel(converted, 0, 0)[0]);
+	CHECK_EQ(51 / 255.0f, Pixel(converted, 0, 0)[3]);
+	CHECK_EQ(0.0f, Pixel(converted, 1, 0)[1]);
+	// sRGB  188 ͐` 0.5 炢
+	CHECK_NEAR(0.5029f, Pixel(converted, 2, 0)[2], 1e-4f);
+	CHECK_EQ(SrgbToLinear(188 / 255.0f), Pixel(converted, 2, 0)[2]);
+}
+
+TEST_CASE(TextureConversion, MipCountGoesDownToOnePixel)
+{
+	CHECK_EQ(1u, MipCount(1, 1));
+	CHECK_EQ(2u, MipCount(2, 2));
+	// 5  2  1
+	CHECK_EQ(3u, MipCount(5, 3));
+	CHECK_EQ(3u, MipCount(6, 3));
+	CHECK_EQ(3u, MipCount(7, 1));
+	// 9  4  2  1
+	CHECK_EQ(4u, MipCount(1, 9));
+	CHECK_EQ(10u, MipCount(640, 360));
+	CHECK_EQ(11u, MipCount(1024, 1));
+}
+
+TEST_CASE(TextureConversion, DownsampleDropsTheLastOddColumnAndRow)
+{
+	// 5x3  2x1Bx = 4 ̗ y = 2 ̍s͓ǂ܂Ȃ
+	const ConvertedImage source = MakeImage(5, 3, [](uint32_t x, uint32_t y) { return static_cast<float>(y * 5 + x); });
+	ConvertedImage half;
+	DownsampleReference(source, half);
+	CheckSize(half, 2, 1);
+	// (0 + 1 + 5 + 6) / 4  (2 + 3 + 7 + 8) / 4
+	CHECK_EQ(3.0f, Pixel(half, 0, 0)[0]);
+	CHECK_EQ(5.0f, Pixel(half, 1, 0)[0]);
+	CHECK_EQ(0.0f, Pixel(half, 0, 0)[1]);
+	CHECK_EQ(1.0f, Pixel(half, 1, 0)[3]);
+}
+
+TEST_CASE(TextureConversion, NonPowerOfTwoMipChain)
+{
+	std::vector<ConvertedImage> mips(1);
+	mips[0] = MakeImage(6, 3, [](uint32_t x, uint32_t y) { return static_cast<float>(y * 10 + x); });
+	GenerateMipsReference(mips);
+	REQUIRE_EQ(static_cast<size_t>(3), mips.size());
+	CheckSize(mips[1], 3, 1);
+	CheckSize(mips[2], 1, 1);
+	// (0 + 1 + 10 + 11) / 4 ȂǁBy = 2 ̍s͓ǂ܂Ȃ
+	CHECK_EQ(5.5f, Pixel(mips[1], 0, 0)[0]);
+	CHECK_EQ(7.5f, Pixel(mips[1], 1, 0)[0]);
+	CHECK_EQ(9.5f, Pixel(mips[1], 2, 0)[0]);
+	//  1 ͓s2ǂށBx = 2 ̗͓ǂ܂Ȃ
+	CHECK_EQ(6.5f, Pixel(mips[2], 0, 0)[0]);
+	CHECK_EQ(1.0f, Pixel(mips[2], 0, 0)[3]);
+}
+
+TEST_CASE(TextureConversion, OneByNMipChains)
+{
+	// 1x5  1x2  1x1B 1 ͓2ǂނ̂ŏc̕ςɂȂ
+	std::vector<ConvertedImage> tall(1);
+	tall[0] = MakeImage(1, 5, [](uint32_t, uint32_t y) { return static_cast<float>(y); });
+	GenerateMipsReference(tall);
+	REQUIRE_EQ(static_cast<size_t>(3), tall.size());
+	CheckSize(tall[1], 1, 2);
+	CheckSize(tall[2], 1, 1);
+	CHECK_EQ(0.5f, Pixel(tall[1], 0, 0)[0]);
+	CHECK_EQ(2.5f, Pixel(tall[1], 0, 1)[0]);
+	CHECK_EQ(1.5f, Pixel(tall[2], 0, 0)[0]);
+
+	// 4x1  2x1  1x1
+	std::vector<ConvertedImage> wide(1);
+	wide[0] = MakeImage(4, 1, [](uint32_t x, uint32_t) { return static_cast<float>(x * 2); });
+	GenerateMipsReference(wide);
+	REQUIRE_EQ(static_cast<size_t>(3), wide.size());
+	CheckSize(wide[1], 2, 1);
+	CheckSize(wide[2], 1, 1);
+	CHECK_EQ(1.0f, Pixel(wide[1], 0, 0)[0]);
+	CHECK_EQ(5.0f, Pixel(wide[1], 1, 0)[0]);
+	CHECK_EQ(3.0f, Pixel(wide[2], 0, 0)[0]);
+
+	// 1x1 ͂̂܂
+	std::vector<ConvertedImage> single(1);
+	single[0] = MakeImage(1, 1, [](uint32_t, uint32_t) { return 0.25f; });
+	GenerateMipsReference(single);
+	REQUIRE_EQ(static_cast<size_t>(1), single.size());
+	CHECK_EQ(0.25f, Pixel(single[0], 0, 0)[0]);
+}
+
+TEST_CASE(TextureConversion, ConvertedBgrImageThroughTheMipChain)
+{
+	// 3x3  BGR ̂܂ܕϊă~bvB2x2 ̕ς 4 ̉fVF[_[Ɠɑ
+	const std::vector<uint8_t> source = MakeSource(3, 3, kSourceBgr8);
+	std::vector<ConvertedImage> mips(1);
+	ConvertTextureReference(source.data(), MakeTextureConversionConstants(3, 3, kSourceBgr8, 0), mips[0]);
+	GenerateMipsReference(mips);
+	REQUIRE_EQ(static_cast<size_t>(2), mips.size());
+	CheckSize(mips[1], 1, 1);
+	for (int channel = 0; channel < 4; ++channel) {
+		const float expected =
+			((Pixel(mips[0], 0, 0)[channel] + Pixel(mips[0], 1, 0)[channel]) +
+				(Pixel(mips[0], 0, 1)[channel] + Pixel(mips[0], 1, 1)[channel])) * 0.25f;
+		CHECK_EQ(expected, Pixel(mips[1], 0, 0)[channel]);
+	}
+	// Ԃ͉f3oCg(oCgʒu i ̒l y * 64 + i * 5 + 1)
+	CHECK_EQ(11 / 255.0f, Pixel(mips[0], 0, 0)[0]);
+	CHECK_EQ(1 / 255.0f, Pixel(mips[0], 0, 0)[2]);
+	CHECK_EQ((64 + 5 * 5 + 1) / 255.0f, Pixel(mips[0], 1, 1)[0]);
+}
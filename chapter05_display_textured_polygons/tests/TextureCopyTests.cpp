@@ -0,0 +1,40 @@
+#include "TextureCopy.h"
+
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+TEST_CASE(TextureCopy, RepacksRowsIntoFootprintPitch)
+{
+	// 3 sNZ x 4 oCg̍s 256 oCg̃sb`ɋlߑւ
+	constexpr size_t kRowSize = 12;
+	constexpr size_t kFootprintPitch = 256;
+	constexpr uint32_t kRowCount = 5;
+	std::vector<uint8_t> source(kRowSize * kRowCount);
+	for (size_t i = 0; i < source.size(); ++i) {
+		source[i] = static_cast<uint8_t>(i);
+	}
+	std::vector<uint8_t> destination(kFootprintPitch * kRowCount, 0xcd);
+
+	CopyRows(destination.data(), kFootprintPitch, source.data(), kRowSize, kRowSize, kRowCount);
+
+	for (uint32_t row = 0; row < kRowCount; ++row) {
+		for (size_t x = 0; x < kFootprintPitch; ++x) {
+			const uint8_t expected = x < kRowSize ? source[row * kRowSize + x] : 0xcd;
+			CHECK_EQ(expected, destination[row * kFootprintPitch + x]);
+		}
+	}
+}
+
+TEST_CASE(TextureCopy, SamePitchCopiesWholeImage)
+{
+	std::vector<uint8_t> source(256 * 3);
+	for (size_t i = 0; i < source.size(); ++i) {
+		source[i] = static_cast<uint8_t>(i * 7);
+	}
+	std::vector<uint8_t> destination(source.size());
+	CopyRows(destination.data(), 256, source.data(), 256, 256, 3);
+	CHECK(destination == source);
+}
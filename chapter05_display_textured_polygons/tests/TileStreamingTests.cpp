@@ -0,0 +1,294 @@
+#include "TileStreaming.h"
+
+#include <vector>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	// CHECK_EQ ͎QƂŎ󂯂̂ŁANX static constexpr o[𒼐ړn C++14 ł͒`
+	constexpr uint32_t kNoSlot = TileCache::kInvalidSlot;
+
+	// 512x512  128x128 ̃^CɂB~bv 0  4x4A~bv 1  2x2A~bv 2  1x1
+	TileLayout SquareLayout()
+	{
+		return TileLayout(512, 512, 128, 128, 3);
+	}
+
+	// ǂ̃ZvĂȂtB[hobN
+	std::vector<uint32_t> EmptyFeedback(const TileLayout& layout)
+	{
+		return std::vector<uint32_t>(static_cast<size_t>(layout.TilesX(0)) * layout.TilesY(0), kNoTileFeedback);
+	}
+
+	void SetFeedback(const TileLayout& layout, std::vector<uint32_t>& feedback, uint32_t x, uint32_t y, uint32_t mip)
+	{
+		feedback[static_cast<size_t>(y) * layout.TilesX(0) + x] = mip;
+	}
+
+	void CheckRequest(const TileRequest& request, uint32_t mip, uint32_t x, uint32_t y, uint32_t weight)
+	{
+		CHECK_EQ(MakeTileKey(mip, x, y), request.key);
+		CHECK_EQ(weight, request.weight);
+	}
+
+	uint32_t Allocate(TileCache& cache, TileKey key, uint64_t frame)
+	{
+		bool evicted = false;
+		TileKey evictedKey = 0;
+		const uint32_t slot = cache.Allocate(key, frame, evicted, evictedKey);
+		CHECK(!evicted);
+		return slot;
+	}
+
+	// 󂫂ȂƂɒǂoĊ蓖ĂBǂo^CԂ
+	TileKey AllocateEvicting(TileCache& cache, TileKey key, uint64_t frame, uint32_t& slot)
+	{
+		bool evicted = false;
+		TileKey evictedKey = 0;
+		slot = cache.Allocate(key, frame, evicted, evictedKey);
+		CHECK(evicted);
+		return evictedKey;
+	}
+
+	uint8_t Indirection(const TileStreamer& streamer, uint32_t x, uint32_t y)
+	{
+		return streamer.IndirectionTable()[static_cast<size_t>(y) * streamer.Layout().TilesX(0) + x];
+	}
+}
+
+TEST_CASE(TileStreaming, CacheEvictsTheLeastRecentlyUsedTile)
+{
+	const TileKey a = MakeTileKey(0, 0, 0);
+	const TileKey b = MakeTileKey(0, 1, 0);
+	const TileKey c = MakeTileKey(0, 2, 0);
+	TileCache cache(3);
+	// 󂢂Ă邤͏ԍg
+	CHECK_EQ(0u, Allocate(cache, a, 1));
+	CHECK_EQ(1u, Allocate(cache, b, 2));
+	CHECK_EQ(2u, Allocate(cache, c, 3));
+	CHECK_EQ(3u, cache.ResidentCount());
+
+	// a gƁAłÂ̂ bA c ɂȂ
+	cache.Touch(cache.Find(a), 4);
+	uint32_t slot = TileCache::kInvalidSlot;
+	CHECK_EQ(b, AllocateEvicting(cache, MakeTileKey(1, 0, 0), 5, slot));
+	CHECK_EQ(1u, slot);
+	CHECK_EQ(c, AllocateEvicting(cache, MakeTileKey(1, 1, 0), 5, slot));
+	CHECK_EQ(2u, slot);
+	CHECK_EQ(a, AllocateEvicting(cache, MakeTileKey(1, 0, 1), 5, slot));
+	CHECK_EQ(0u, slot);
+	CHECK_EQ(kNoSlot, cache.Find(a));
+	CHECK_EQ(kNoSlot, cache.Find(b));
+	CHECK_EQ(kNoSlot, cache.Find(c));
+	CHECK_EQ(3u, cache.ResidentCount());
+
+	// ǂ̃t[ŎgĂ̂ŒǂoȂ
+	bool evicted = true;
+	TileKey evictedKey = 0;
+	CHECK_EQ(kNoSlot, cache.Allocate(MakeTileKey(2, 0, 0), 5, evicted, evictedKey));
+	CHECK(!evicted);
+	CHECK_EQ(kNoSlot, cache.Find(MakeTileKey(2, 0, 0)));
+}
+
+TEST_CASE(TileStreaming, CacheReleaseFreesTheSlot)
+{
+	const TileKey a = MakeTileKey(0, 0, 0);
+	const TileKey b = MakeTileKey(0, 1, 0);
+	TileCache cache(2);
+	Allocate(cache, a, 1);
+	const uint32_t slotB = Allocate(cache, b, 1);
+	cache.Release(b);
+	CHECK_EQ(kNoSlot, cache.Find(b));
+	CHECK_EQ(1u, cache.ResidentCount());
+	// uĂȂ^C͉Ȃ
+	cache.Release(b);
+	CHECK_EQ(1u, cache.ResidentCount());
+
+	// 󂢂Xbg͒ǂoɎgBa ͓t[ŎgĂĂc
+	CHECK_EQ(slotB, Allocate(cache, MakeTileKey(0, 2, 0), 1));
+	CHECK_EQ(0u, cache.Find(a));
+
+	// OXbg͒ǂoOĂ
+	cache.Release(a);
+	uint32_t slot = TileCache::kInvalidSlot;
+	Allocate(cache, MakeTileKey(0, 3, 0), 2);
+	CHECK_EQ(MakeTileKey(0, 2, 0), AllocateEvicting(cache, MakeTileKey(0, 0, 1), 3, slot));
+	CHECK_EQ(slotB, slot);
+}
+
+TEST_CASE(TileStreaming, AggregatesDuplicateAndOutOfRangeFeedback)
+{
+	const TileLayout layout = SquareLayout();
+	TileFeedbackAggregator aggregator(layout);
+	std::vector<TileRequest> requests;
+
+	//  2x2 ̃Z~bv 1 ̃^Cv(1̓~bv 0 ܂)B
+	// ~bv̐(3)ȏ̒ĺApbNꂽ~bvő̂ŐȂ
+	std::vector<uint32_t> feedback = EmptyFeedback(layout);
+	SetFeedback(layout, feedback, 0, 0, 0);
+	SetFeedback(layout, feedback, 1, 0, 1);
+	SetFeedback(layout, feedback, 0, 1, 1);
+	SetFeedback(layout, feedback, 1, 1, 2);
+	SetFeedback(layout, feedback, 2, 2, 3);
+	SetFeedback(layout, feedback, 3, 3, 200);
+	aggregator.Aggregate(feedback.data(), requests);
+	// e~bvBdZ1̗vɂ܂Ƃ߁AZ̐d݂ɂ
+	REQUIRE_EQ(static_cast<size_t>(3), requests.size());
+	CheckRequest(requests[0], 2, 0, 0, 4);
+	CheckRequest(requests[1], 1, 0, 0, 4);
+	CheckRequest(requests[2], 0, 0, 0, 1);
+
+	// ~bvł͗v̑
+	feedback = EmptyFeedback(layout);
+	SetFeedback(layout, feedback, 0, 0, 1);
+	SetFeedback(layout, feedback, 2, 0, 1);
+	SetFeedback(layout, feedback, 3, 0, 1);
+	SetFeedback(layout, feedback, 2, 1, 1);
+	aggregator.Aggregate(feedback.data(), requests);
+	REQUIRE_EQ(static_cast<size_t>(3), requests.size());
+	CheckRequest(requests[0], 2, 0, 0, 4);
+	CheckRequest(requests[1], 1, 1, 0, 3);
+	CheckRequest(requests[2], 1, 0, 0, 1);
+
+	// vĂȂA܂̓tB[hobN܂Ȃ
+	feedback = EmptyFeedback(layout);
+	aggregator.Aggregate(feedback.data(), requests);
+	CHECK(requests.empty());
+	aggregator.Aggregate(nullptr, requests);
+	CHECK(requests.empty());
+}
+
+TEST_CASE(TileStreaming, AggregatesEdgeTilesOfNonPowerOfTwoLayouts)
+{
+	// 640x384: ~bv 0  5x3A~bv 1(320x192) 3x2A~bv 2(160x96) 2x1
+	const TileLayout layout(640, 384, 128, 128, 3);
+	REQUIRE_EQ(5u, layout.TilesX(0));
+	REQUIRE_EQ(3u, layout.TilesY(0));
+	REQUIRE_EQ(3u, layout.TilesX(1));
+	REQUIRE_EQ(2u, layout.TilesY(1));
+	REQUIRE_EQ(2u, layout.TilesX(2));
+	REQUIRE_EQ(1u, layout.TilesY(2));
+	TileFeedbackAggregator aggregator(layout);
+	std::vector<TileRequest> requests;
+
+	// ẼŹA͂ݏoŌ̃^CɊ񂹂
+	std::vector<uint32_t> feedback = EmptyFeedback(layout);
+	SetFeedback(layout, feedback, 4, 2, 1);
+	aggregator.Aggregate(feedback.data(), requests);
+	REQUIRE_EQ(static_cast<size_t>(2), requests.size());
+	CheckRequest(requests[0], 2, 1, 0, 1);
+	CheckRequest(requests[1], 1, 2, 1, 1);
+	CHECK_EQ(MakeTileKey(1, 2, 1), layout.CoveringTile(1, 4, 2));
+}
+
+TEST_CASE(TileStreaming, UploadsAreCappedPerFrame)
+{
+	const TileLayout layout = SquareLayout();
+	TileStreamer::Settings settings;
+	settings.slotCount = 64;
+	settings.maxUploadsPerFrame = 2;
+	TileStreamer streamer(layout, settings);
+
+	// ׂẴZ~bv 0 v: 1 + 4 + 16 
+	std::vector<uint32_t> feedback(16, 0);
+	std::vector<TileUpdate> updates;
+	CHECK(streamer.Update(feedback.data(), 1, updates));
+	REQUIRE_EQ(static_cast<size_t>(2), updates.size());
+	CHECK_EQ(MakeTileKey(2, 0, 0), updates[0].key);
+	CHECK_EQ(TileKeyMip(updates[1].key), 1u);
+	CHECK_EQ(21u, streamer.LastStats().requestedTiles);
+	CHECK_EQ(2u, streamer.LastStats().uploadedTiles);
+	CHECK_EQ(2u, streamer.LastStats().residentTiles);
+
+	// ̃t[́A܂uĂȂ̂瑱
+	uint32_t frame = 2;
+	size_t uploaded = 2;
+	while (streamer.Update(feedback.data(), frame++, updates)) {
+		CHECK(updates.size() <= settings.maxUploadsPerFrame);
+		for (const TileUpdate& update : updates) {
+			CHECK(!update.evicted);
+		}
+		uploaded += updates.size();
+	}
+	CHECK_EQ(static_cast<size_t>(21), uploaded);
+	CHECK(updates.empty());
+	// t[ 1`11  2 (Ō 1 )ǂ݁A12 œǂނ̂ȂȂ
+	CHECK_EQ(13u, frame);
+	for (uint32_t y = 0; y < 4; ++y) {
+		for (uint32_t x = 0; x < 4; ++x) {
+			CHECK_EQ(static_cast<uint8_t>(0), Indirection(streamer, x, y));
+		}
+	}
+}
+
+TEST_CASE(TileStreaming, UploadsStopWhenEverySlotIsInUse)
+{
+	const TileLayout layout = SquareLayout();
+	TileStreamer::Settings settings;
+	settings.slotCount = 4;
+	settings.maxUploadsPerFrame = 16;
+	TileStreamer streamer(layout, settings);
+
+	// Xbg̐葽vĂÃt[Ŏg^C͒ǂoȂ
+	std::vector<uint32_t> feedback(16, 0);
+	std::vector<TileUpdate> updates;
+	CHECK(streamer.Update(feedback.data(), 1, updates));
+	CHECK_EQ(static_cast<size_t>(4), updates.size());
+	for (const TileUpdate& update : updates) {
+		CHECK(!update.evicted);
+	}
+	CHECK(!streamer.Update(feedback.data(), 1, updates));
+	CHECK(updates.empty());
+	CHECK_EQ(4u, streamer.LastStats().residentTiles);
+}
+
+TEST_CASE(TileStreaming, CancelledUpdatesAreNotResident)
+{
+	const TileLayout layout = SquareLayout();
+	TileStreamer::Settings settings;
+	settings.slotCount = 2;
+	settings.maxUploadsPerFrame = 16;
+	TileStreamer streamer(layout, settings);
+	std::vector<TileUpdate> updates;
+
+	// ̃Z~bv 1 v: ~bv 2 ƍ̃~bv 1 u
+	std::vector<uint32_t> feedback = EmptyFeedback(layout);
+	SetFeedback(layout, feedback, 0, 0, 1);
+	CHECK(streamer.Update(feedback.data(), 1, updates));
+	REQUIRE_EQ(static_cast<size_t>(2), updates.size());
+	CHECK_EQ(static_cast<uint8_t>(1), Indirection(streamer, 0, 0));
+	CHECK_EQ(static_cast<uint8_t>(2), Indirection(streamer, 3, 3));
+
+	// ̃t[͉ẼZB̃~bv 1 ǂoĉẼ~bv 1 u
+	feedback = EmptyFeedback(layout);
+	SetFeedback(layout, feedback, 3, 3, 1);
+	CHECK(streamer.Update(feedback.data(), 2, updates));
+	REQUIRE_EQ(static_cast<size_t>(1), updates.size());
+	CHECK_EQ(MakeTileKey(1, 1, 1), updates[0].key);
+	CHECK(updates[0].evicted);
+	CHECK_EQ(MakeTileKey(1, 0, 0), updates[0].evictedKey);
+	CHECK_EQ(static_cast<uint8_t>(1), Indirection(streamer, 3, 3));
+
+	// UpdateTileMappings ⏑݂ɎsBẼ~bv 1 ͒uĂȂƂɖ߂A
+	// ǂõ~bv 1 ߂Ȃ(}bv͂OĂ)
+	streamer.CancelUpdates(updates);
+	CHECK_EQ(1u, streamer.LastStats().residentTiles);
+	CHECK_EQ(static_cast<uint8_t>(2), Indirection(streamer, 0, 0));
+	CHECK_EQ(static_cast<uint8_t>(2), Indirection(streamer, 3, 3));
+	CHECK_EQ(static_cast<uint8_t>(2), Indirection(streamer, 2, 2));
+
+	// ȂԐڎQƃe[úAǂݍނ̂ȂĂ Update ő
+	CHECK(streamer.Update(nullptr, 3, updates));
+	CHECK(updates.empty());
+	CHECK(!streamer.Update(nullptr, 4, updates));
+
+	// v΋󂢂XbgɒuBǂo͂Ȃ
+	CHECK(streamer.Update(feedback.data(), 5, updates));
+	REQUIRE_EQ(static_cast<size_t>(1), updates.size());
+	CHECK_EQ(MakeTileKey(1, 1, 1), updates[0].key);
+	CHECK(!updates[0].evicted);
+	CHECK_EQ(static_cast<uint8_t>(1), Indirection(streamer, 3, 3));
+	CHECK_EQ(2u, streamer.LastStats().residentTiles);
+}
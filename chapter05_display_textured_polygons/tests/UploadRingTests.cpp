@@ -0,0 +1,102 @@
+#include "UploadRing.h"
+
+#include <algorithm>
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	constexpr uint64_t kNoOffset = UploadRing::kInvalidOffset;
+}
+
+TEST_CASE(UploadRing, AllocatesInOrderWithAlignment)
+{
+	UploadRing ring(1024);
+	CHECK_EQ(0u, ring.Allocate(10, 1));
+	// 10  256 ɑB邽߂ɋ󂯂gĂ镪ɓ
+	CHECK_EQ(256u, ring.Allocate(100, 256));
+	CHECK_EQ(356u, ring.UsedBytes());
+	CHECK_EQ(356u, ring.Allocate(4, 4));
+	CHECK_EQ(kNoOffset, ring.Allocate(0, 1));
+	CHECK_EQ(kNoOffset, ring.Allocate(1025, 1));
+}
+
+TEST_CASE(UploadRing, FullUntilTheFrameIsRetired)
+{
+	UploadRing ring(1024);
+	CHECK_EQ(0u, ring.Allocate(512, 256));
+	ring.EndFrame(1);
+	CHECK_EQ(512u, ring.Allocate(512, 256));
+	ring.EndFrame(2);
+	// GPU ǂ̃t[IĂȂ
+	CHECK_EQ(kNoOffset, ring.Allocate(1, 1));
+	ring.Retire(0);
+	CHECK_EQ(kNoOffset, ring.Allocate(1, 1));
+
+	// t[ 1 ̕
+	ring.Retire(1);
+	CHECK_EQ(512u, ring.UsedBytes());
+	CHECK_EQ(0u, ring.Allocate(256, 256));
+	CHECK_EQ(256u, ring.Allocate(256, 256));
+	CHECK_EQ(kNoOffset, ring.Allocate(1, 1));
+}
+
+TEST_CASE(UploadRing, WrapsToTheStartWhenTheEndIsTooSmall)
+{
+	UploadRing ring(1024);
+	CHECK_EQ(0u, ring.Allocate(400, 1));
+	ring.EndFrame(1);
+	CHECK_EQ(400u, ring.Allocate(400, 1));
+	ring.EndFrame(2);
+	ring.Retire(1);
+
+	// I[ 224 cĂȂ̂Ő擪ɖ߂Bc 224 t[ 3 gĂ镪ɂȂ
+	CHECK_EQ(0u, ring.Allocate(300, 1));
+	CHECK_EQ(400u + 224u + 300u, ring.UsedBytes());
+	// 擪̋󂫂 300..400 
+	CHECK_EQ(kNoOffset, ring.Allocate(101, 1));
+	CHECK_EQ(300u, ring.Allocate(100, 1));
+	ring.EndFrame(3);
+
+	ring.Retire(2);
+	CHECK_EQ(224u + 400u, ring.UsedBytes());
+	ring.Retire(3);
+	CHECK_EQ(0u, ring.UsedBytes());
+}
+
+TEST_CASE(UploadRing, EmptyFramesDoNotMoveTheTail)
+{
+	UploadRing ring(1024);
+	CHECK_EQ(0u, ring.Allocate(600, 1));
+	ring.EndFrame(1);
+	// ؂oȂt[
+	ring.EndFrame(2);
+	ring.Retire(1);
+	// ɂȂ̂Ő擪Bt[ 2 󂯂ĂA܎gĂ镪͏Ȃ
+	CHECK_EQ(0u, ring.Allocate(700, 1));
+	ring.Retire(2);
+	CHECK_EQ(700u, ring.UsedBytes());
+	CHECK_EQ(kNoOffset, ring.Allocate(400, 1));
+	CHECK_EQ(700u, ring.Allocate(300, 1));
+}
+
+TEST_CASE(UploadRing, SteadyStateWithFramesInFlight)
+{
+	// 2 t[ GPU ɐς񂾂܂܁At[ 3 񂸂؂o
+	UploadRing ring(8192);
+	uint64_t maxUsed = 0;
+	for (uint64_t frame = 1; frame <= 100; ++frame) {
+		if (frame > 2) {
+			ring.Retire(frame - 2);
+		}
+		for (int i = 0; i < 3; ++i) {
+			REQUIRE(ring.Allocate(300, 256) != kNoOffset);
+		}
+		ring.EndFrame(frame);
+		maxUsed = (std::max)(maxUsed, ring.UsedBytes());
+	}
+	CHECK(maxUsed <= ring.Capacity());
+	ring.Retire(100);
+	CHECK_EQ(0u, ring.UsedBytes());
+}
@@ -0,0 +1,50 @@
+#include "VectorMath.h"
+
+#include "TestRunner.h"
+
+using namespace yuxx::DirectX12;
+
+namespace {
+	Float3 Project(const Float3& point, const Float4x4& viewProjection)
+	{
+		const Float4 clip = TransformPoint(point, viewProjection);
+		return { clip.x / clip.w, clip.y / clip.w, clip.z / clip.w };
+	}
+}
+
+TEST_CASE(VectorMath, IdentityLeavesPointUnchanged)
+{
+	const Float4 point = TransformPoint({ 1.0f, -2.0f, 3.0f }, IdentityMatrix());
+	CHECK_EQ(1.0f, point.x);
+	CHECK_EQ(-2.0f, point.y);
+	CHECK_EQ(3.0f, point.z);
+	CHECK_EQ(1.0f, point.w);
+}
+
+TEST_CASE(VectorMath, TranslationIsInFourthRow)
+{
+	Float4x4 translation = IdentityMatrix();
+	translation.m[3][0] = 5.0f;
+	const Float4x4 scale = { { { 2.0f, 0, 0, 0 }, { 0, 2.0f, 0, 0 }, { 0, 0, 2.0f, 0 }, { 0, 0, 0, 1.0f } } };
+	// g債Ă畽sړ
+	const Float4 point = TransformPoint({ 1.0f, 1.0f, 1.0f }, MultiplyMatrix(scale, translation));
+	CHECK_EQ(7.0f, point.x);
+	CHECK_EQ(2.0f, point.y);
+}
+
+TEST_CASE(VectorMath, PerspectiveMapsNearAndFarToZeroAndOne)
+{
+	const Float4x4 viewProjection = MultiplyMatrix(
+		LookAtMatrixLH({ 0.0f, 0.0f, -10.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }),
+		PerspectiveFovMatrixLH(kPiDiv4, 1.0f, 1.0f, 100.0f)
+	);
+	// J z = -10  +z Ă
+	CHECK_NEAR(0.0, Project({ 0.0f, 0.0f, -9.0f }, viewProjection).z, 1e-5);
+	CHECK_NEAR(1.0, Project({ 0.0f, 0.0f, 90.0f }, viewProjection).z, 1e-5);
+	// c̎p 45 x̔̕ NDC ̏[ɂȂ
+	const Float3 top = Project({ 0.0f, 10.0f * 0.41421356f, 0.0f }, viewProjection);
+	CHECK_NEAR(1.0, top.y, 1e-4);
+	CHECK_NEAR(0.0, top.x, 1e-6);
+	// nȂ̂ +x ͉E
+	CHECK(Project({ 1.0f, 0.0f, 0.0f }, viewProjection).x > 0.0f);
+}
@@ -0,0 +1,8 @@
+@echo off
+rem tests/data  *.cso  fxc ō蒼B
+rem chapter05_display_textured_polygons ŁAfxc(Windows SDK) PATH ɂR}hvvgsB
+rem /Od /Zi  DirectXManager.cpp  kShaderCompileFlags(D3DCOMPILE_SKIP_OPTIMIZATION | D3DCOMPILE_DEBUG)Ɠ
+setlocal
+fxc /nologo /Od /Zi /T vs_5_0 /E BasicVS /Fo tests\data\basic_vs_5_0.cso BasicVertexShader.hlsl || exit /b 1
+fxc /nologo /Od /Zi /T ps_5_0 /E BasicPS /Fo tests\data\basic_ps_5_0.cso BasicPixelShader.hlsl || exit /b 1
+fxc /nologo /Od /Zi /T ps_5_1 /E StreamedPS /Fo tests\data\streamed_ps_5_1.cso BasicPixelShader.hlsl || exit /b 1